@@ -36,21 +36,54 @@
 #define __FM_FM_ALOS_EVENT_QUEUE_H
 
 
+/* Number of log2 buckets in the event queue depth and latency histograms */
+#define FM_EVENT_QUEUE_HISTOGRAM_SIZE   16
+
+
 /**************************************************/
 /** \ingroup intTypeStruct
  *
- *  Encapsulates a thread-safe event queue.
+ *  One slot of an event queue ring.
+ **************************************************/
+typedef struct _fm_eventQueueSlot
+{
+    /** Ring position the slot is ready for: the position itself when the
+     *  slot is free for a producer, the position plus one when it holds
+     *  the event posted at that position. */
+    volatile fm_uint32 sequence;
+
+    /** The event held by the slot. */
+    fm_event *         event;
+
+} fm_eventQueueSlot;
+
+
+/**************************************************/
+/** \ingroup intTypeStruct
+ *
+ *  Encapsulates a thread-safe event queue. The queue is a bounded
+ *  lock-free ring: any number of threads may post events, but only the
+ *  thread owning the queue may get or peek them.
  **************************************************/
 typedef struct _fm_eventQueue
 {
-    /** The heart of the queue is a doubly-linked list */
-    fm_dlist eventQueue;
+    /** The heart of the queue is a ring of ringMask + 1 slots, a power
+     *  of two no smaller than max. */
+    fm_eventQueueSlot *ring;
+
+    /** Mask converting a ring position into a slot index. */
+    fm_uint32          ringMask;
+
+    /** Next ring position to be claimed by a producer. */
+    volatile fm_uint32 tail;
 
-    /** lock for both queue read and write access */
-    fm_lock  accessLock;
+    /** Next ring position to be read. Only used by the consumer. */
+    fm_uint32          head;
 
-    /** size for convenience */
-    fm_int   size;
+    /** Number of events posted and not yet read, including the events
+     *  being posted. Producers reserve their entry here first, so that
+     *  the queue never holds more than max events. */
+    volatile fm_int    size;
 
     /** total number of allowed events */
     fm_int   max;
@@ -68,22 +101,67 @@ typedef struct _fm_eventQueue
     fm_float minTime;
     fm_float maxTime;
 
+    /** Queue depth seen by posted events, bucket n counting depths in
+     *  [2^n, 2^(n+1)). */
+    fm_uint  depthHistogram[FM_EVENT_QUEUE_HISTOGRAM_SIZE];
+
+    /** Time spent in the queue by popped events, bucket n counting times
+     *  in [2^n, 2^(n+1)) microseconds. Only filled in when the queue
+     *  timestamps events (ENABLE_EVENTQ_TIMESTAMP). */
+    fm_uint  latencyHistogram[FM_EVENT_QUEUE_HISTOGRAM_SIZE];
+
 } fm_eventQueue;
 
 
+/**************************************************/
+/** \ingroup intTypeStruct
+ *
+ *  Encapsulates a lock-free stack of event blocks, used as the free event
+ *  pool. Each event pushed on the stack must have a unique poolIndex
+ *  below max.
+ **************************************************/
+typedef struct _fm_eventStack
+{
+    /** Top of the stack: a tag bumped by every update in the upper 32
+     *  bits, to detect an ABA race, and the pool index plus one of the
+     *  top event in the lower 32 bits, 0 if the stack is empty. */
+    volatile fm_uint64 top;
+
+    /** Events by pool index. */
+    fm_event **        events;
+
+    /** Pool index plus one of the event below each event, 0 for the
+     *  bottom of the stack. */
+    volatile fm_uint32 *next;
+
+    /** Number of events on the stack. */
+    volatile fm_int    size;
+
+    /** total number of events in the pool */
+    fm_int             max;
+
+    /** Lowest number of events seen on the stack, for debugging. */
+    fm_int             minSize;
+
+    /** stack name, for debugging */
+    fm_text            name;
+
+} fm_eventStack;
+
+
 /* (non-blocking) initializes the queue, should be only done once */
 fm_status fmEventQueueInitialize(fm_eventQueue *q, int maxSize, fm_text qName);
 
 
-/* (blocking) enqueue an event at current + timeDelta time */
+/* (non-blocking) enqueue an event, from any thread */
 fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event);
 
 
-/* (blocking) get the next event whose timestamp has expired */
+/* (non-blocking) get the next event, from the owning thread only */
 fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr);
 
 
-/* (non-blocking) peek the next event */
+/* (non-blocking) peek the next event, from the owning thread only */
 fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr);
 
 
@@ -94,9 +172,27 @@ fm_status fmEventQueueDestroy(fm_eventQueue *q);
 /* (non-blocking) returns the number of entries currently in the queue */
 fm_status fmEventQueueCount(fm_eventQueue *q, fm_int *eventCount);
 
-/* (blocking) remove event node from the queue */
-fm_status fmEventQueueRemove(fm_eventQueue *q,
-                             fm_event *eventPtr);
+
+/* (non-blocking) initializes an event stack, should be only done once */
+fm_status fmEventStackInitialize(fm_eventStack *stack,
+                                 fm_int         maxSize,
+                                 fm_text        name);
+
+
+/* (non-blocking) pushes an event on the stack */
+fm_status fmEventStackPush(fm_eventStack *stack, fm_event *event);
+
+
+/* (non-blocking) pops the event on top of the stack */
+fm_status fmEventStackPop(fm_eventStack *stack, fm_event **eventPtr);
+
+
+/* (non-blocking) returns the number of events on the stack */
+fm_status fmEventStackCount(fm_eventStack *stack, fm_int *eventCount);
+
+
+/* (non-blocking) cleans up the stack */
+fm_status fmEventStackDestroy(fm_eventStack *stack);
 
 
 #endif /* __FM_FM_ALOS_EVENT_QUEUE_H */
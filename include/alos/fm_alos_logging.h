@@ -163,6 +163,14 @@ enum _fm_loggingAttr
      *  as specified by ''fmSetLoggingType''. */
     FM_LOG_ATTR_LOG_FILENAME,
 
+    /** Type fm_bool: Whether messages are written by a drainer thread, as
+     *  set by ''fmSetLoggingAsync''. */
+    FM_LOG_ATTR_ASYNC,
+
+    /** Type fm_uint64: Number of messages dropped in asynchronous mode
+     *  because the logging thread's ring was full. */
+    FM_LOG_ATTR_ASYNC_DROPPED,
+
     /** UNPUBLISHED: For internal use only. */
     FM_LOG_ATTRIBUTE_MAX
 
@@ -873,6 +881,21 @@ fm_status fmGetLoggingCategoryConfig( fm_uint64            categoryMask,
                                       fm_int              *maxObjectId,
                                       fm_bool             *legacyLoggingOn );
 
+fm_status fmSetLoggingAsync(fm_bool enable);
+fm_status fmFlushLogging(void);
+void fmDbgDumpAsyncLogging(void);
+
+fm_bool fmLogCallSiteEnabled(fm_uint32 * siteState,
+                             fm_uint64   categories,
+                             fm_uint64   logLevel,
+                             fm_bool     legacy,
+                             const char *srcFile,
+                             const char *srcFunction);
+fm_status fmDbgBenchmarkLogging(fm_int iterations);
+
+/* Points to the logging configuration generation; see FM_LOG_FUNC. */
+extern volatile fm_uint32 *fmLogCallSiteGeneration;
+
 #if defined(FM_ALOS_FAULT_INJECTION_POINTS) && (FM_ALOS_FAULT_INJECTION_POINTS==FM_ENABLED)
 
 fm_status fmActivateFaultInjectionPoint(const char *functionName,
@@ -999,6 +1022,11 @@ fm_status fmFaultInjection(const char *functionName);
  *  function entry and exit logging macros to be compiled out, improving
  *  CPU performance, while not disabling the entire logging system.
  *                                                                      \lb\lb
+ *  Each call site caches whether its category and level are enabled and
+ *  passes its file and function filters. The cache is refreshed when the
+ *  logging configuration changes, so a disabled call site costs one
+ *  comparison and its arguments are not evaluated.
+ *                                                                      \lb\lb
  * cat is a bit mask that specifies the categories to which the message being
  * generated belongs (see ''Log Categories'').
  *                                                                      \lb\lb
@@ -1011,9 +1039,17 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_FUNCTION_LOGGING
 #define FM_LOG_FUNC(cat, level, ...)  { }
 #else
-#define FM_LOG_FUNC(cat, level, ...)                \
-   fmLogMessage((cat), (level), __FILE__,           \
-                __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_FUNC(cat, level, ...)                                    \
+    {                                                                   \
+        static fm_uint32 fmLogSiteState;                                \
+        if ( ( fmLogSiteState != (*fmLogCallSiteGeneration << 1) ) &&   \
+             fmLogCallSiteEnabled(&fmLogSiteState, (cat), (level),      \
+                                  TRUE, __FILE__, __func__) )           \
+        {                                                               \
+            fmLogMessage((cat), (level), __FILE__,                      \
+                         __func__, __LINE__, __VA_ARGS__ );             \
+        }                                                               \
+    }
 #endif
 
 /***************************************************************************/
@@ -1039,9 +1075,17 @@ fm_status fmFaultInjection(const char *functionName);
 #ifndef FM_ALOS_FUNCTION_LOGGING
 #define FM_LOG_FUNC_V2(cat, level, objectId, ...)  { }
 #else
-#define FM_LOG_FUNC_V2(cat, level, objectId, ...)           \
-   fmLogMessageV2((cat), (level), (objectId), __FILE__,     \
-                  __func__, __LINE__, __VA_ARGS__ )
+#define FM_LOG_FUNC_V2(cat, level, objectId, ...)                       \
+    {                                                                   \
+        static fm_uint32 fmLogSiteState;                                \
+        if ( ( fmLogSiteState != (*fmLogCallSiteGeneration << 1) ) &&   \
+             fmLogCallSiteEnabled(&fmLogSiteState, (cat), (level),      \
+                                  FALSE, __FILE__, __func__) )          \
+        {                                                               \
+            fmLogMessageV2((cat), (level), (objectId), __FILE__,        \
+                           __func__, __LINE__, __VA_ARGS__ );           \
+        }                                                               \
+    }
 #endif
 
 
@@ -119,6 +119,8 @@ void fmSubTimestamps(const fm_timestamp *t1,
 
 fm_status fmGetTime(fm_timestamp *tvp);
 
+fm_status fmGetThreadCpuTime(fm_timestamp *ts);
+
 fm_status fmGetTimeRes(fm_timestamp *tr);
 
 /* delay for some time */
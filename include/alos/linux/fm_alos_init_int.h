@@ -69,6 +69,10 @@ typedef struct _fm_rootAlos
     fm10000_property    fm10000_property;
 #endif
 
+    /* Hash indexes of the property table by key and by TLV type. */
+    fm_uint16           propertyKeyIndex[FM_PROPERTY_INDEX_SIZE];
+    fm_uint16           propertyTlvIndex[FM_PROPERTY_INDEX_SIZE];
+
     /* Mask of non-switch-specific locks that have a precedence. */
     fm_lockPrecedence   nonSwitchLockPrecs;
 
@@ -86,6 +86,10 @@ typedef struct
     fm_char              fileFilter[FM_LOG_MAX_FILTER_LEN];
     fm_loggingObjIdRange range[64];
 
+    /* Bumped whenever the settings above change, invalidating the enable
+     * state cached by each FM_LOG_FUNC call site. Never zero. */
+    volatile fm_uint32   callSiteGeneration;
+
     /* protects access to the logging destination */
     void *               accessLock;
 
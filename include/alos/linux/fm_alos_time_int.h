@@ -39,6 +39,28 @@ typedef struct _fm_timer fm_timer;
 typedef struct _fm_timerTask fm_timerTask;
 
 
+/* geometry of the hierarchical timing wheel of each timer task: each level
+ * has FM_TIMER_WHEEL_SLOTS slots and each slot of a level covers all the
+ * slots of the level below it. */
+#define FM_TIMER_WHEEL_LEVELS       4
+#define FM_TIMER_WHEEL_SLOT_BITS    6
+#define FM_TIMER_WHEEL_SLOTS        (1 << FM_TIMER_WHEEL_SLOT_BITS)
+#define FM_TIMER_WHEEL_SLOT_MASK    (FM_TIMER_WHEEL_SLOTS - 1)
+
+/* number of ticks covered by the whole timing wheel */
+#define FM_TIMER_WHEEL_RANGE        \
+    (1ULL << (FM_TIMER_WHEEL_SLOT_BITS * FM_TIMER_WHEEL_LEVELS))
+
+
+/* definition of a timing wheel slot */
+typedef struct _fm_timerWheelSlot
+{
+    /* linked list of the active timers hashed to this slot */
+    FM_DLL_DEFINE_LIST( _fm_timer, firstTimer, lastTimer );
+
+} fm_timerWheelSlot;
+
+
 /* definition of the internal timer structure */
 struct _fm_timer
 {
@@ -78,9 +100,28 @@ struct _fm_timer
     /* existing timers linked list node */
     FM_DLL_DEFINE_NODE( _fm_timer, nextTimer, prevTimer );
 
-    /* active timers linked list node */
+    /* active timers linked list node, links the timer into its wheel slot */
     FM_DLL_DEFINE_NODE( _fm_timer, nextActiveTimer, prevActiveTimer );
 
+    /* expired timers linked list node */
+    FM_DLL_DEFINE_NODE( _fm_timer, nextExpiredTimer, prevExpiredTimer );
+
+    /* wheel slot holding this timer, NULL if not in the wheel */
+    fm_timerWheelSlot *wheelSlot;
+
+    /* wheel level of wheelSlot */
+    fm_int         wheelLevel;
+
+    /* wheel tick at which the timer expires */
+    fm_uint64      expiryTick;
+
+    /* TRUE if the timer is in the list of expired timers waiting for its
+     * callback to be invoked */
+    fm_bool        expired;
+
+    /* the expiration time of the repetition waiting for its callback */
+    fm_timestamp   expiredEnd;
+
 };
 
 
@@ -117,8 +158,48 @@ struct _fm_timerTask
     /* linked list of existing timers */
     FM_DLL_DEFINE_LIST( _fm_timer, firstTimer, lastTimer );
 
-    /* linked list of active timers */
-    FM_DLL_DEFINE_LIST( _fm_timer, firstActiveTimer, lastActiveTimer );
+    /* hierarchical timing wheel holding the active timers */
+    fm_timerWheelSlot wheel[FM_TIMER_WHEEL_LEVELS][FM_TIMER_WHEEL_SLOTS];
+
+    /* one bit per non-empty slot of each wheel level */
+    fm_uint64        wheelOccupancy[FM_TIMER_WHEEL_LEVELS];
+
+    /* number of timers in each wheel level */
+    fm_int           wheelCount[FM_TIMER_WHEEL_LEVELS];
+
+    /* absolute time of wheel tick 0 */
+    fm_timestamp     wheelBase;
+
+    /* duration of a wheel tick, in microseconds */
+    fm_uint64        tickUsec;
+
+    /* next wheel tick to be processed */
+    fm_uint64        wheelTick;
+
+    /* wheel tick the event-driven task is sleeping until, ~0 if the task
+     * is sleeping until woken up */
+    fm_uint64        wakeTick;
+
+    /* absolute time matching wakeTick */
+    fm_timestamp     wakeTime;
+
+    /* linked list of expired timers waiting for their callback */
+    FM_DLL_DEFINE_LIST( _fm_timer, firstExpiredTimer, lastExpiredTimer );
+
+    /* number of callbacks invoked */
+    fm_uint64        nrExpirations;
+
+    /* number of batches of expired timers, one per processed tick with at
+     * least one expiration */
+    fm_uint64        nrBatches;
+
+    /* largest number of timers expired in a single tick */
+    fm_int           maxBatchSize;
+
+    /* sum and maximum of the delay between the expiration time of a timer
+     * and the invocation of its callback, in microseconds */
+    fm_uint64        totalLateness;
+    fm_uint64        maxLateness;
 
 };
 
@@ -2637,6 +2637,23 @@ typedef struct _fm_aclCompilerStats
     /** Last minslice used by the combined ingress and egress ACLs. */
     fm_uint     lastMinSliceUsed;
 
+    /** Number of ACLs compiled from their rules. On a full compilation
+     *  this is every ACL in the image; on an incremental compilation
+     *  (see ''FM_ACL_COMPILE_FLAG_INCREMENTAL'') it is only the ACLs
+     *  that changed since the last ''fmApplyACL''. */
+    fm_uint     aclsCompiled;
+
+    /** Number of ACLs taken unchanged from the applied image by an
+     *  incremental compilation. */
+    fm_uint     aclsReused;
+
+    /** Time taken by the compilation, in microseconds. */
+    fm_uint64   compileTime;
+
+    /** Approximate amount of memory, in bytes, held by the compiled
+     *  ACL image. */
+    fm_uint64   imageSize;
+
 } fm_aclCompilerStats;
 
 
@@ -3116,6 +3133,25 @@ typedef struct _fm_aclRuleSliceUsage
  *  \chips  FM6000, FM10000 */
 #define FM_ACL_COMPILE_FLAG_TRY_ALLOC               (1 << 7)
 
+/** The compiler will build the new ACL image by starting from the image
+ *  currently applied to the hardware and recompiling only the ACLs whose
+ *  rules were added or deleted since the last call to ''fmApplyACL''. The
+ *  condition keys, scenario selection and slice position of all the other
+ *  ACLs are kept as is, so the compilation time is proportional to the
+ *  amount of change rather than to the size of the whole configuration.
+ *                                                                      \lb\lb
+ *  The compiler silently falls back on a full compilation when the
+ *  changes can't be handled incrementally, for example when the
+ *  attributes or ports of an already applied ACL were modified, when ACL
+ *  instances are in use or when the FFU slice allocation was changed. The
+ *  aclsCompiled and aclsReused fields of ''fm_aclCompilerStats'' tell which
+ *  way the image was built. This flag is ignored with
+ *  ''FM_ACL_COMPILE_FLAG_NON_DISRUPTIVE'' and
+ *  ''FM_ACL_COMPILE_FLAG_TRY_ALLOC''.
+ *  
+ *  \chips  FM10000 */
+#define FM_ACL_COMPILE_FLAG_INCREMENTAL             (1 << 9)
+
 /** @} (end of Doxygen group) */
 
 /* Placeholders for unimplemented flags - don't include in API document: */
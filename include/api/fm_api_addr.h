@@ -349,6 +349,66 @@ typedef struct _fm_flushParams
 } fm_flushParams;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ *  Describes a change to one MA Table entry. Used
+ *  by ''fmGetAddressTableChanges''.
+ **************************************************/
+typedef struct _fm_macTableChange
+{
+    /** The MA Table index of the entry.
+     *
+     *  \chips  FM10000 */
+    fm_int             index;
+
+    /** TRUE if the index holds a valid entry, FALSE if the entry that
+     *  was at this index has been removed.
+     *
+     *  \chips  FM10000 */
+    fm_bool            valid;
+
+    /** The current contents of the entry. Only meaningful if valid is
+     *  TRUE.
+     *
+     *  \chips  FM10000 */
+    fm_macAddressEntry entry;
+
+} fm_macTableChange;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Iterator over a point-in-time copy of the MA
+ *  Table. Used by ''fmCreateAddressTableIterator'',
+ *  ''fmGetAddressTableIteratorNext'' and
+ *  ''fmDeleteAddressTableIterator''.
+ *                                              \lb\lb
+ *  Structure members that are documented as "for
+ *  internal use only" should not be accessed
+ *  directly by the application.
+ **************************************************/
+typedef struct _fm_macTableIterator
+{
+    /** For internal use only. */
+    fm_int    sw;
+
+    /** For internal use only. */
+    void *    snapshot;
+
+    /** For internal use only. */
+    fm_int    nextIndex;
+
+    /** Read-only: the MA Table epoch at which the copy was taken. May be
+     *  passed to ''fmGetAddressTableChanges'' to retrieve the changes
+     *  made since. */
+    fm_uint64 epoch;
+
+    /** Read-only: the number of valid entries in the copy. */
+    fm_int    numEntries;
+
+} fm_macTableIterator;
+
+
 /**************************************************/
 /** \ingroup typeStruct
  *  MAC security statistics. Used by
@@ -439,6 +499,19 @@ fm_status fmFlushVlanAddresses(fm_int sw, fm_uint vlan);
 fm_status fmFlushPortVlanAddresses(fm_int sw, fm_uint port, fm_int vlan);
 fm_status fmFlushAddresses(fm_int sw, fm_flushMode mode, fm_flushParams params);
 
+fm_status fmGetAddressTableChanges(fm_int             sw,
+                                   fm_uint64 *        epoch,
+                                   fm_int *           nChanges,
+                                   fm_macTableChange *changes,
+                                   fm_int             maxChanges);
+
+fm_status fmCreateAddressTableIterator(fm_int sw, fm_macTableIterator *iter);
+fm_status fmGetAddressTableIteratorNext(fm_macTableIterator *iter,
+                                        fm_int *             nEntries,
+                                        fm_macAddressEntry * entries,
+                                        fm_int               maxEntries);
+fm_status fmDeleteAddressTableIterator(fm_macTableIterator *iter);
+
 fm_status fmGetAddressTableAttribute(fm_int sw, fm_int attr, void *value);
 fm_status fmSetAddressTableAttribute(fm_int sw, fm_int attr, void *value);
 
@@ -447,6 +520,10 @@ fm_status fmResetSecurityStats(fm_int sw);
 
 fm_status fmDbgDumpMACTablePurgeStats(fm_int sw);
 fm_status fmDbgResetMACTablePurgeStats(fm_int sw);
+fm_status fmDbgBenchmarkMACTableFlush(fm_int sw,
+                                      fm_int numPorts,
+                                      fm_int numVlans,
+                                      fm_int iterations);
 
 
 #endif /* __FM_FM_API_ADDR_H */
@@ -1116,6 +1116,33 @@ enum _fm_switchAttr
      *  \chips  FM10000 */
     FM_SWITCH_NVM_MAC,
 
+    /** Type ''fm_packetTxClassConfig'': The scheduling configuration of
+     *  one class of the CPU transmit packet queue. The txClass field of
+     *  the structure selects the class and must be set by the caller.
+     *                                                                  \lb\lb
+     *  Frames sent by the application are sorted into the classes listed
+     *  in ''fm_packetTxClass''. Each class has its own queue, which grows
+     *  on demand up to maxDepth frames and then applies its drop policy.
+     *  Classes with a weight of 0 are served in strict priority order
+     *  ahead of the weighted classes, which share the remaining transmit
+     *  opportunities in proportion to their weights.
+     *                                                                  \lb\lb
+     *  The default is a strict priority CONTROL class, and NETWORK and
+     *  BULK classes weighted 3:1, all of them holding up to
+     *  api.platform.pktTxClassMaxDepth frames and rejecting frames with
+     *  FM_ERR_TX_PACKET_QUEUE_FULL when full.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_PACKET_TX_CLASS_CONFIG,
+
+    /** Type ''fm_packetTxClassStats'': The counters of one class of the
+     *  CPU transmit packet queue. The txClass field of the structure
+     *  selects the class and must be set by the caller. This attribute is
+     *  read-only.
+     *
+     *  \chips  FM10000 */
+    FM_SWITCH_PACKET_TX_CLASS_STATS,
+
     /** UNPUBLISHED: For internal use only. */
     FM_SWITCH_ATTRIBUTE_MAX
 
@@ -8918,6 +8945,133 @@ typedef struct _fm_nvmMac
 } fm_nvmMac;
 
 
+/**************************************************/
+/** \ingroup typeEnum
+ * Classes of the CPU transmit packet queue, used
+ * with the ''FM_SWITCH_PACKET_TX_CLASS_CONFIG''
+ * and ''FM_SWITCH_PACKET_TX_CLASS_STATS'' switch
+ * attributes. Frames are classified by their
+ * destination MAC address and Ethernet type.
+ **************************************************/
+typedef enum
+{
+    /** Link and bridge control protocols: frames sent to the IEEE
+     *  reserved addresses 01-80-C2-00-00-0X, such as STP, LACP and LLDP,
+     *  and slow protocol and LLDP frames. */
+    FM_PACKET_TX_CLASS_CONTROL = 0,
+
+    /** Address resolution: ARP and ICMPv6 frames. */
+    FM_PACKET_TX_CLASS_NETWORK,
+
+    /** All other frames. */
+    FM_PACKET_TX_CLASS_BULK,
+
+    /** UNPUBLISHED: For internal use only. */
+    FM_PACKET_TX_CLASS_MAX
+
+} fm_packetTxClass;
+
+
+/**************************************************/
+/** \ingroup typeEnum
+ * Drop policies of a CPU transmit packet queue
+ * class, applied when a frame is sent while the
+ * class queue holds its maximum depth.
+ **************************************************/
+typedef enum
+{
+    /** The send function returns FM_ERR_TX_PACKET_QUEUE_FULL and the
+     *  frame buffer remains owned by the caller. */
+    FM_PACKET_TX_DROP_REJECT = 0,
+
+    /** The frame is discarded and its buffer freed, and the send function
+     *  returns FM_OK. */
+    FM_PACKET_TX_DROP_DISCARD,
+
+    /** UNPUBLISHED: For internal use only. */
+    FM_PACKET_TX_DROP_MAX
+
+} fm_packetTxDropPolicy;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Used as the argument type for the
+ *  ''FM_SWITCH_PACKET_TX_CLASS_CONFIG'' switch attribute.
+ **************************************************/
+typedef struct _fm_packetTxClassConfig
+{
+    /** The class to operate on (see ''fm_packetTxClass''). */
+    fm_packetTxClass      txClass;
+
+    /** The maximum number of frames queued in the class, in the range
+     *  1..FM_PACKET_TX_CLASS_MAX_DEPTH. */
+    fm_int                maxDepth;
+
+    /** The scheduling weight of the class, in the range
+     *  0..FM_PACKET_TX_CLASS_MAX_WEIGHT. 0 gives the class strict
+     *  priority over the weighted classes. */
+    fm_int                weight;
+
+    /** The policy applied when the class is full. */
+    fm_packetTxDropPolicy dropPolicy;
+
+} fm_packetTxClassConfig;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ *  Used as the argument type for the
+ *  ''FM_SWITCH_PACKET_TX_CLASS_STATS'' switch attribute.
+ **************************************************/
+typedef struct _fm_packetTxClassStats
+{
+    /** The class to retrieve the counters of (see ''fm_packetTxClass''). */
+    fm_packetTxClass txClass;
+
+    /** Number of frames accepted into the class queue. A frame sent to
+     *  several ports counts once per port. */
+    fm_uint64        enqueued;
+
+    /** Number of send requests refused or discarded because the class
+     *  queue was full. */
+    fm_uint64        dropped;
+
+    /** Number of frames handed to the CPU port driver. */
+    fm_uint64        dequeued;
+
+    /** Sum of the queueing latencies of the dequeued frames, in
+     *  microseconds. */
+    fm_uint64        latencyTotal;
+
+    /** Largest queueing latency of a dequeued frame, in microseconds. */
+    fm_uint64        latencyMax;
+
+    /** Number of frames currently queued in the class. */
+    fm_int           depth;
+
+    /** Largest number of frames queued in the class at one time. */
+    fm_int           highWater;
+
+} fm_packetTxClassStats;
+
+
+/****************************************************************/
+/** \ingroup constSystem
+ *  The maximum value of the maxDepth field of
+ *  ''fm_packetTxClassConfig''.
+ ****************************************************************/
+#define FM_PACKET_TX_CLASS_MAX_DEPTH    65535
+
+
+/****************************************************************/
+/** \ingroup constSystem
+ *  The maximum value of the weight field of
+ *  ''fm_packetTxClassConfig''.
+ ****************************************************************/
+#define FM_PACKET_TX_CLASS_MAX_WEIGHT   255
+
+
 /****************************************************************/
 /** \ingroup constSystem 
  *  The maximum number of reserved MAC addresses that may be
@@ -100,6 +100,11 @@ typedef struct _fm_buffer
      *  member. Node in the buffer queue in which this buffer is present.*/
     fm_dlist_node   *bufferQueueNode;
 
+    /** Private data used by the API. The application should not touch this
+     *  member. Number of owners sharing this buffer in addition to the
+     *  first one, 0 if the buffer is not shared. */
+    fm_int     shareCount;
+
 } fm_buffer;
 
 
@@ -131,6 +136,10 @@ fm_status fmAddBuffer(fm_buffer *frame, fm_buffer *buf);
 /* helper for duplicating */
 fm_buffer *fmDuplicateBufferChain(fm_int sw, fm_buffer *srcFrame);
 
+/* share a chain between several owners, and get a private copy of one */
+fm_status fmShareBufferChain(fm_int sw, fm_buffer *bufChain, fm_int numShares);
+fm_buffer *fmUnshareBufferChain(fm_int sw, fm_buffer *bufChain);
+
 /* Dequeue frame from the buffer queue corresponding to rcvPktEvent*/
 fm_status fmFreeBufferQueueNode(int sw, fm_eventPktRecv *rcvPktEvent);
 
@@ -1362,8 +1362,8 @@ struct _fm_event
     /** Queue in which this event is present. Null if not in any queue. */
     fm_eventQueue    *q;
 
-    /** Node in the event queue containing this event. */
-    fm_dlist_node    *node;
+    /** Index of the event in the free event pool. */
+    fm_int           poolIndex;
 
     /** Union of event information payloads for different event types. */
     fm_eventPayload  info;
@@ -482,7 +482,9 @@ typedef struct _fm_schedulerConfig
  * responsible for disposing of the ''fm_buffer''
  * chain pointed to by the ''fm_eventPktRecv'' pkt member.
  * Disposal may be accomplished by calling ''fmFreeBufferChain''
- * with pkt as the argument.
+ * with pkt as the argument. A packet delivered to several
+ * processes is shared between them and must not be modified
+ * unless the process has called ''fmSetProcessPacketWritable''.
  **************************************************/
 typedef void (*fm_eventHandler)(fm_int event, fm_int sw, void *ptr);
 
@@ -506,6 +508,9 @@ fm_status fmGetSwitchState(fm_int sw, fm_bool *state);
 /* gets the state of the given switch */
 fm_status fmGetSwitchStateExt(fm_int sw, fm_switchState *state);
 
+/* saves the register cache image used by a warm restart of the switch */
+fm_status fmSaveWarmRestartImage(fm_int sw);
+
 /* sets the event handler used for upper layer notification */
 fm_status fmSetEventHandler(fm_eventHandler fPtr);
 
@@ -513,6 +518,9 @@ fm_status fmSetEventHandler(fm_eventHandler fPtr);
 /* sets which events are delivered to the current process */
 fm_status fmSetProcessEventMask(fm_uint32 mask);
 
+/* declares whether the current process's event handler modifies packets */
+fm_status fmSetProcessPacketWritable(fm_bool writable);
+
 
 /* retrieves information about the state of a switch */
 fm_status fmGetSwitchInfo(fm_int sw, fm_switchInfo *info);
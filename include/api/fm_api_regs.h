@@ -63,6 +63,54 @@ typedef struct _fm_scatterGatherListEntry
 } fm_scatterGatherListEntry;
 
 
+/**************************************************/
+/** \ingroup typeEnum
+ * Operation performed by an entry of a register
+ * transaction.
+ **************************************************/
+typedef enum
+{
+    /** Read the entry's registers into its data array. */
+    FM_REG_TXN_READ = 0,
+
+    /** Write the entry's data array to its registers. */
+    FM_REG_TXN_WRITE,
+
+} fm_regTransactionOp;
+
+
+/**************************************************/
+/** \ingroup typeStruct
+ * fm_regTransactionEntry describes one contiguous
+ * register read or write within a register
+ * transaction committed by ''fmCommitRegTransaction''.
+ * Entries are executed in array order.
+ **************************************************/
+typedef struct _fm_regTransactionEntry
+{
+    /** Whether this entry reads or writes. */
+    fm_regTransactionOp op;
+
+    /** Starting register address to read/write. */
+    fm_uint32           addr;
+
+    /** Number of words to read/write. */
+    fm_uint32           count;
+
+    /** Array of count words, that the read data is written into
+     *  or the write data is taken from. */
+    fm_uint32 *         data;
+
+} fm_regTransactionEntry;
+
+
+/** Register transaction flag: do not take the platform register access
+ *  lock. Only valid for registers that are written by a single thread,
+ *  where the caller guarantees that no other access can interleave.
+ *  \ingroup constRegTransaction */
+#define FM_REG_TXN_FLAG_LOCKLESS    (1U << 0)
+
+
 
 /* reads a single 32-bit integer */
 fm_status fmReadUINT32(fm_int sw, fm_uint reg, fm_uint32 *ptr);
@@ -136,6 +184,13 @@ fm_status fmWriteScatterGather(fm_int                           sw,
                                fm_scatterGatherListEntry *      sgList);
 
 
+/* executes a list of reads and writes as a single register transaction */
+fm_status fmCommitRegTransaction(fm_int                  sw,
+                                 fm_int                  nEntries,
+                                 fm_regTransactionEntry *entries,
+                                 fm_uint32               flags);
+
+
 /* writes a single 32-bit integer through I2C */
 fm_status fmI2cWriteUINT32(fm_int sw, fm_uint reg, fm_uint32 value);
 
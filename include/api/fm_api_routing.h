@@ -943,6 +943,7 @@ fm_bool fmDbgConvertStringToIPAddress(const fm_char *ipString,
                                       fm_ipAddr *    ipAddr);
 fm_status fmDbgDumpRouteLookupTrees(fm_int sw, fm_int vrid);
 fm_status fmDbgDumpRouteForIP(fm_int sw, fm_int vrid, fm_text ipAddr);
+fm_status fmDbgBenchmarkRouteLookup(fm_int sw, fm_int vrid, fm_int iterations);
 fm_status fmDbgValidateRouteTables(fm_int sw);
 void fmDbgTestRouteMask(fm_char *               route,
                         fm_int                  prefix,
@@ -1584,6 +1584,41 @@ typedef struct _fm_portCounters
 } fm_portCounters;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ * Per-port traffic rates returned by ''fmGetPortCounterRates''.
+ *                                                                      \lb\lb
+ * Rates are derived by the statistics collector thread from two
+ * consecutive sweeps of the port counters (see the
+ * ''api.statsCollector.period'' API property). They are 0 until two
+ * sweeps have completed, and for the interval during which
+ * ''fmResetPortCounters'' was called on the port.
+ **************************************************/
+typedef struct _fm_portCounterRates
+{
+    /** Received frames per second (unicast, multicast and broadcast). */
+    fm_uint64 rxFramesPerSec;
+
+    /** Received bits per second, in valid frames. */
+    fm_uint64 rxBitsPerSec;
+
+    /** Transmitted frames per second (unicast, multicast and broadcast). */
+    fm_uint64 txFramesPerSec;
+
+    /** Transmitted bits per second. */
+    fm_uint64 txBitsPerSec;
+
+    /** Length, in microseconds, of the interval over which the rates were
+     *  computed. 0 if no rate is available yet. */
+    fm_uint64 interval;
+
+    /** Time, in microseconds, at which the most recent sweep started. Uses
+     *  the same time base as the timestamp member of ''fm_portCounters''. */
+    fm_uint64 timestamp;
+
+} fm_portCounterRates;
+
+
 /**************************************************/
 /** \ingroup typeStruct
  * Per VLAN statistics
@@ -1697,6 +1732,7 @@ typedef struct _fm_switchCounters
 
 fm_status fmGetPortCounters(fm_int sw, fm_int port, fm_portCounters *cnt);
 fm_status fmResetPortCounters(fm_int sw, fm_int port);
+fm_status fmGetPortCounterRates(fm_int sw, fm_int port, fm_portCounterRates *rates);
 fm_status fmGetVLANCounters(fm_int sw, fm_int vlan, fm_vlanCounters *cnt);
 fm_status fmResetVLANCounters(fm_int sw, fm_int vlan);
 fm_status fmAllocateVLANCounters(fm_int sw, fm_int vlan);
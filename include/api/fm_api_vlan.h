@@ -45,6 +45,12 @@
 #define FM_MAX_VLAN      4096
 
 
+/** Used as the stpState member of an ''fm_vlanPortConfig'' entry to leave
+ *  the spanning tree state of the port unchanged.
+ *  \ingroup constSystem */
+#define FM_VLAN_PORT_STP_STATE_UNCHANGED  -1
+
+
 /*****************************************************************************
  * Types
  *****************************************************************************/
@@ -125,6 +131,37 @@ typedef enum
 } fm_vlanSelect;
 
 
+/**************************************************/
+/** \ingroup typeStruct
+ *  Used as an argument to ''fmSetVlanPortConfigList''.
+ *  Describes the membership, egress tagging and
+ *  spanning tree state of one port in one VLAN.
+ **************************************************/
+typedef struct _fm_vlanPortConfig
+{
+    /** The VLAN number on which to operate. */
+    fm_uint16 vlanID;
+
+    /** The logical port on which to operate. May be the CPU interface
+     *  port or a LAG. */
+    fm_int    port;
+
+    /** TRUE to make the port a member of the VLAN, FALSE to remove it
+     *  from the VLAN. */
+    fm_bool   member;
+
+    /** TRUE to tag frames egressing the port. Ignored when member is
+     *  FALSE. */
+    fm_bool   tag;
+
+    /** The spanning tree state (see ''Spanning Tree States'') to set, or
+     *  ''FM_VLAN_PORT_STP_STATE_UNCHANGED'' to leave the state as is. May
+     *  not be set for the CPU interface port. */
+    fm_int    stpState;
+
+} fm_vlanPortConfig;
+
+
 /*****************************************************************************
  * Function prototypes
  *****************************************************************************/
@@ -206,6 +243,10 @@ fm_status fmSetVlanPortListState(fm_int    sw,
                                  fm_int *  portList,
                                  fm_int    state);
 
+fm_status fmSetVlanPortConfigList(fm_int              sw,
+                                  fm_int              numEntries,
+                                  fm_vlanPortConfig * configList);
+
 
 /* attribute setting for VLAN settings */
 fm_status fmGetVlanAttribute(fm_int    sw,
@@ -247,6 +288,9 @@ fm_status fmGetSVlanFromPortCVlan(fm_int    sw,
                                   fm_int *  sVlan);
 
 fm_status fmDbgDumpCVlanCounter(fm_int sw);
+fm_status fmDbgBenchmarkVlanProvisioning(fm_int sw,
+                                         fm_int firstVlan,
+                                         fm_int numVlans);
 
 
 #endif /* __FM_FM_API_VLAN_H */
@@ -115,10 +115,8 @@ typedef enum
 #define fm10000CheckFlushRequest                fmCommonCheckFlushRequest
 #define fm10000DeleteAddressPre                 fmCommonDeleteAddressPre
 #define fm10000DeleteAllAddresses               fmCommonDeleteAllAddresses
-#define fm10000DumpPurgeStats                   fmCommonDumpPurgeStats
 #define fm10000FindAndInvalidateAddress         fmCommonFindAndInvalidateAddr
 #define fm10000FreeAddrTableData                fmCommonFreeAddrTableCache
-#define fm10000ResetPurgeStats                  fmCommonResetPurgeStats
 #define fm10000UpdateMATable                    fmCommonUpdateMATable
 
 /**************************************************
@@ -147,6 +145,12 @@ fm_status fm10000CalcAddrHash(fm_macaddr  macAddr,
                               fm_uint32   hashMode,
                               fm_uint16 * hashes);
 
+fm_status fm10000CalcAddrHashBatch(fm_int             numKeys,
+                                   const fm_macaddr * macAddrs,
+                                   const fm_uint16 *  fids,
+                                   fm_uint32          hashMode,
+                                   fm_uint16 *        hashes);
+
 fm_status fm10000CheckVlanMembership(fm_int    sw,
                                      fm_uint16 vlanID,
                                      fm_int    port);
@@ -157,6 +161,16 @@ fm_status fm10000ComputeAddressIndex(fm_int     sw,
                                      fm_uint16  vlanID2,
                                      fm_uint16 *indexes);
 
+fm_status fm10000ComputeAddressIndexBatch(fm_int             sw,
+                                          fm_int             numKeys,
+                                          const fm_macaddr * macAddrs,
+                                          const fm_uint16 *  vlanIDs,
+                                          fm_uint16 *        indexes);
+
+fm_status fm10000DbgBenchmarkAddrHash(fm_int sw,
+                                      fm_int numKeys,
+                                      fm_int iterations);
+
 fm_status fm10000ConvertEntryToWords(fm_int                   sw,
                                      fm_internalMacAddrEntry *entry,
                                      fm_uint32 *              words);
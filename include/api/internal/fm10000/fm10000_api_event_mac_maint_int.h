@@ -45,6 +45,8 @@
  **************************************************/
 
 fm_uint64 fm10000GetAgingTimer(void);
+void fm10000DumpUsedTableSweepStats(fm_int sw);
+void fm10000ResetUsedTableSweepStats(fm_int sw);
 
 
 /**************************************************
@@ -60,6 +62,8 @@ fm_status fm10000TCNInterruptHandler(fm_int sw, fm_uint32 events);
  **************************************************/
 
 fm_status fm10000HandlePurgeRequest(fm_int sw);
+fm_status fm10000DumpPurgeStats(fm_int sw);
+fm_status fm10000ResetPurgeStats(fm_int sw);
 
 
 #endif /* __FM_FM10000_API_EVENT_MAC_MAINT_INT_H */
@@ -38,6 +38,99 @@
 /* sbus divider for the EPL ring SBus: set to 78,125 Mhz (= SerDes RefClk/2) */
 #define FM10000_SBUS_EPL_RING_DIVIDER   0x01
 
+/* SBus rings, index of the per-ring SBus state of the switch */
+#define FM10000_SBUS_RING_EPL           0
+#define FM10000_SBUS_RING_PCIE          1
+#define FM10000_SBUS_NUM_RINGS          2
+
+/* number of commands batched by callers of ''fm10000SbusExecute'' that
+ * stream a large number of writes, such as SPICO image uploads */
+#define FM10000_SBUS_MAX_BATCH          64
+
+
+/* SBus command types of an ''fm10000_sbusCmd'' */
+typedef enum
+{
+    /* read sbusReg into result */
+    FM10000_SBUS_CMD_READ = 0,
+
+    /* write data to sbusReg */
+    FM10000_SBUS_CMD_WRITE,
+
+    /* read sbusReg into result, then write back the bits of data
+     * selected by mask, the other bits being kept */
+    FM10000_SBUS_CMD_RMW,
+
+    /* reset the device at sbusAddr */
+    FM10000_SBUS_CMD_RESET,
+
+} fm10000_sbusCmdType;
+
+
+struct _fm10000_sbusCmd;
+
+/* Called by ''fm10000SbusExecute'' when a command completes. It is called
+ * with the ring locked and must not issue SBus requests itself. */
+typedef void (*fm10000_sbusCallback)(fm_int                   sw,
+                                     struct _fm10000_sbusCmd *cmd);
+
+
+/* SBus command executed by ''fm10000SbusExecute'' */
+typedef struct _fm10000_sbusCmd
+{
+    /* command type */
+    fm10000_sbusCmdType  type;
+
+    /* TRUE for the EPL ring, FALSE for the PCIE ring */
+    fm_bool              eplRing;
+
+    /* SBus device address and register */
+    fm_uint              sbusAddr;
+    fm_uint              sbusReg;
+
+    /* data to write */
+    fm_uint32            data;
+
+    /* bits of data written by a read-modify-write command */
+    fm_uint32            mask;
+
+    /* value read by a read or read-modify-write command */
+    fm_uint32            result;
+
+    /* optional completion callback and its argument */
+    fm10000_sbusCallback callback;
+    void *               cookie;
+
+    /* completion status of the command */
+    fm_status            status;
+
+} fm10000_sbusCmd;
+
+
+/* SBus statistics of one ring */
+typedef struct _fm10000_sbusStats
+{
+    /* number of commands executed, a read-modify-write counting as one */
+    fm_uint64   nrCommands;
+
+    /* number of commands that failed or were not executed */
+    fm_uint64   nrErrors;
+
+    /* number of batches that had commands for this ring */
+    fm_uint64   nrBatches;
+
+    /* total and maximum time in microseconds from issuing a command
+     * to its completion */
+    fm_uint64   totalLatency;
+    fm_uint64   maxLatency;
+
+    /* total and maximum number of commands queued on the ring by a batch */
+    fm_uint64   totalQueueDepth;
+    fm_uint64   maxQueueDepth;
+
+} fm10000_sbusStats;
+
+
 
 /*****************************************************************************
  * Global Variables
@@ -66,5 +159,12 @@ fm_status fm10000SbusReset(fm_int    sw,
                            fm_bool   eplRing);
 fm_status fm10000SbusSbmReset(fm_int    sw,
                               fm_bool   eplRing);
+fm_status fm10000SbusExecute(fm_int           sw,
+                             fm10000_sbusCmd *cmds,
+                             fm_int           nrCmds);
+fm_status fm10000SbusAllocateResources(fm_int sw);
+fm_status fm10000SbusFreeResources(fm_int sw);
+fm_status fm10000DbgDumpSbusStats(fm_int sw);
+fm_status fm10000DbgResetSbusStats(fm_int sw);
 #endif  /* __FM_FM10000_API_SBUS_INT_H */
 
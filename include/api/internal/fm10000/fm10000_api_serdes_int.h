@@ -483,6 +483,10 @@ typedef enum
 #define FM10000_SERDES_DFE_SM_HISTORY_SIZE  16
 #define FM10000_SERDES_DFE_SM_RECORD_SIZE   sizeof(int)
 
+/* Number of indications to the serdes state machine a DFE event may leave
+ * pending, see fm10000_laneDfe */
+#define FM10000_SERDES_DFE_MAX_PENDING_IND  4
+
 
 #define FM10000_SERDES_PWRUP_INTR_MASK            \
     ( (1U << FM10000_SERDES_IP_b_TxRdy)      |    \
@@ -668,6 +672,17 @@ struct  _fm10000_laneDfe
 
     fm10000_dfeSmEventInfo      eventInfo;
 
+    /* Caller lock of the DFE state machine events. It nests inside the
+     * switch state lock, so tuning timeouts run without the state lock
+     * and the lanes are tuned in parallel */
+    fm_lock                     lock;
+
+    /* Indications to the serdes state machine raised by a DFE event
+     * notified without the state lock. They are sent, in order, once the
+     * state lock is held. Protected by lock */
+    fm_int                      pendingInd[FM10000_SERDES_DFE_MAX_PENDING_IND];
+    fm_int                      numPendingInd;
+
 
 
 
@@ -35,6 +35,91 @@
 #ifndef __FM_FM10000_API_STATS_INT_H
 #define __FM_FM10000_API_STATS_INT_H
 
+#define FM10000_NB_RX_STATS_BANKS           FM10000_RX_STATS_BANK_ENTRIES_1
+#define FM10000_BINS_PER_RX_STATS_BANK      16
+#define FM10000_WORDS_PER_RX_STATS_COUNTER  FM10000_RX_STATS_BANK_WIDTH
+
+
+/* Counter state of one cardinal port, as maintained by the statistics
+ * collector. */
+typedef struct _fm10000_portStatsState
+{
+    /* Logical and physical port numbers */
+    fm_int          logPort;
+    fm_int          physPort;
+
+    /* Values read from the hardware by the current sweep */
+    fm_portCounters hwRead;
+
+    /* Values read from the hardware by the previous sweep */
+    fm_portCounters lastRead;
+
+    /* Counts accumulated since the last reset, on 64 bits */
+    fm_portCounters total;
+
+    /* RX bank bins read by the current sweep (frame + byte counts) */
+    fm_uint32       rxBank[FM10000_NB_RX_STATS_BANKS]
+                          [FM10000_BINS_PER_RX_STATS_BANK]
+                          [FM10000_WORDS_PER_RX_STATS_COUNTER];
+
+    /* Whether the port parsed L3 headers during the current sweep */
+    fm_bool         validIpStats;
+
+    /* Number of times the port counters have been reset */
+    fm_uint32       resetCount;
+
+} fm10000_portStatsState;
+
+
+/* Published counters and rates of one cardinal port. */
+typedef struct _fm10000_portStatsSnapshot
+{
+    fm_portCounters     counters;
+
+    fm_portCounterRates rates;
+
+    /* Value of resetCount in fm10000_portStatsState when swept */
+    fm_uint32           resetCount;
+
+} fm10000_portStatsSnapshot;
+
+
+/* State of the statistics collector, which periodically sweeps the
+ * counters of all cardinal ports and publishes them in a double-buffered
+ * snapshot. */
+typedef struct _fm10000_statsCollector
+{
+    /* Serializes sweeps with port counter resets */
+    fm_lock                     lock;
+
+    /* Protects the index of the published snapshot, held by readers
+     * while they copy from it */
+    fm_lock                     snapshotLock;
+
+    /* Number of entries in ports and in each snapshot, indexed by
+     * cardinal port index */
+    fm_int                      numPorts;
+
+    fm10000_portStatsState *    ports;
+
+    fm10000_portStatsSnapshot * snapshot[2];
+
+    /* Index of the published snapshot, -1 before the first sweep */
+    fm_int                      published;
+
+    /* Scatter-gather list covering the counters of all ports */
+    fm_scatterGatherListEntry * sgList;
+
+    fm_int                      sgListSize;
+
+    /* Number of sweeps and duration of the last one (usec) */
+    fm_uint64                   numSweeps;
+
+    fm_uint64                   lastSweepTime;
+
+} fm10000_statsCollector;
+
+
 fm_status fm10000ResetPortCounters(fm_int sw,
                                    fm_int port);
 
@@ -53,6 +138,14 @@ fm_status fm10000GetCountersInitMode(fm_int sw, fm_uint32 *mode);
 
 fm_status fm10000InitCounters(fm_int sw);
 
+fm_status fm10000FreeCounters(fm_int sw);
+
+fm_status fm10000CollectPortCounters(fm_int sw);
+
+fm_status fm10000GetPortCounterRates(fm_int               sw,
+                                     fm_int               port,
+                                     fm_portCounterRates *rates);
+
 fm_status fm10000SetStatsFrameAdjustment(fm_int sw,
                                          fm_int physPort,
                                          fm_int nbBytes);
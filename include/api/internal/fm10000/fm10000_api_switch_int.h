@@ -41,6 +41,75 @@
 /* Min NMV version that supports SOFT_RESET locking */
 #define NVM_PCIE_RECOVERY_VER               0x122
 
+/* MA_USED_TABLE sweeper diagnostic statistics. */
+typedef struct _fm10000_usedTableSweepStats
+{
+    /* Number of completed passes over MA_USED_TABLE. */
+    fm_uint64   numSweeps;
+
+    /* Thread CPU time, in microseconds, spent on the pass in progress,
+     * on the last completed pass, and the maximum and total over all
+     * completed passes. */
+    fm_uint64   currentSweepCpuUsec;
+    fm_uint64   lastSweepCpuUsec;
+    fm_uint64   maxSweepCpuUsec;
+    fm_uint64   totalSweepCpuUsec;
+
+    /* Number of entries found used, aged from YOUNG to OLD, and
+     * expired by completed passes. */
+    fm_uint64   numYoung;
+    fm_uint64   numOld;
+    fm_uint64   numExpired;
+
+} fm10000_usedTableSweepStats;
+
+/* Maximum number of steps in the switch boot sequence. */
+#define FM10000_BOOT_MAX_STEPS              32
+
+/* Timing of one step of the last switch boot. */
+typedef struct _fm10000_bootStepTime
+{
+    /* Start and end of the step, in microseconds from the start of
+     * the boot. */
+    fm_uint64   startUsec;
+    fm_uint64   endUsec;
+
+    /* Boot worker that ran the step, -1 for the booting thread. */
+    fm_int      worker;
+
+    /* Completion status of the step. */
+    fm_status   status;
+
+    /* TRUE once the step has been started, and once it has completed. */
+    fm_bool     started;
+    fm_bool     done;
+
+    /* TRUE if the step was skipped by a warm restart. */
+    fm_bool     skipped;
+
+} fm10000_bootStepTime;
+
+/* Timeline of the last switch boot, see fm10000DbgDumpBootTimeline. */
+typedef struct _fm10000_bootTimeline
+{
+    /* Start of the boot. */
+    fm_timestamp            start;
+
+    /* Number of steps in the boot sequence. */
+    fm_int                  nrSteps;
+
+    /* Timing of each step, indexed like the boot sequence. */
+    fm10000_bootStepTime    step[FM10000_BOOT_MAX_STEPS];
+
+    /* Duration of the boot in microseconds and its status. */
+    fm_uint64               totalUsec;
+    fm_status               status;
+
+    /* TRUE if the switch was warm restarted, without a reset. */
+    fm_bool                 warmRestart;
+
+} fm10000_bootTimeline;
+
 typedef struct _fm10000_switch
 {
     /**************************************************
@@ -161,6 +230,15 @@ typedef struct _fm10000_switch
     /* Indicates if the SPICO build supports KR or not*/
     fm_bool                     serdesSupportsKR;
 
+    /* Locks serializing the SBus commands of each ring, see
+     * FM10000_SBUS_RING_xxx. They replace the register lock for
+     * SBus accesses, so the two rings run in parallel and other
+     * register accesses are not held off while a command runs */
+    fm_lock                     sbusLock[FM10000_SBUS_NUM_RINGS];
+
+    /* SBus statistics of each ring, protected by sbusLock */
+    fm10000_sbusStats           sbusStats[FM10000_SBUS_NUM_RINGS];
+
     /* pointer to an array of pointers to the arrays that
      * will hold the error samples when plotting the eye
      * diagram. */
@@ -225,6 +303,9 @@ typedef struct _fm10000_switch
     fm_uint64                   usedTableAgingTime;
     fm_uint64                   usedTableExpiryTime;
 
+    /* MA_USED_TABLE sweeper statistics. */
+    fm10000_usedTableSweepStats usedTableSweepStats;
+
     /* Whether the API should automatically create logical ports for
      * remote glorts. */
     fm_bool                     createRemoteLogicalPorts;
@@ -411,6 +492,18 @@ typedef struct _fm10000_switch
     /* Drop frames received by user part on unknown port */
     fm_bool                     dropPacketUnknownPort;
 
+    /**************************************************
+     * Information related to statistics.
+     **************************************************/
+    /* Statistics collector state, NULL when the collector is disabled */
+    fm10000_statsCollector *    statsCollector;
+
+    /**************************************************
+     * Information related to the switch boot.
+     **************************************************/
+    /* Timeline of the last boot */
+    fm10000_bootTimeline        bootTimeline;
+
 
 } fm10000_switch;
 
@@ -470,7 +563,9 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr);
 fm_status fm10000InitSwitch(fm_switch *switchPtr);
 fm_status fm10000InterruptHandler(fm_switch *switchPtr);
 fm_status fm10000PostBootSwitch(fm_int sw);
+fm_status fm10000DbgDumpBootTimeline(fm_int sw);
 fm_status fm10000SetSwitchState(fm_int sw, fm_bool state);
+fm_status fm10000SaveWarmRestartImage(fm_int sw);
 fm_status fm10000IdentifySwitch(fm_int            sw,
                                 fm_switchFamily * family,
                                 fm_switchModel *  model,
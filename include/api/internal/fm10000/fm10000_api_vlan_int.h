@@ -113,6 +113,9 @@ fm_status fm10000DeleteVlanPortList(fm_int    sw,
                                     fm_uint16 vlanID,
                                     fm_int    numPorts,
                                     fm_int *  portList);
+fm_status fm10000SetVlanPortConfigList(fm_int              sw,
+                                       fm_int              numEntries,
+                                       fm_vlanPortConfig * configList);
 fm_status fm10000GetVlanAttribute(fm_int    sw,
                                   fm_uint16 vlanID,
                                   fm_int    attr,
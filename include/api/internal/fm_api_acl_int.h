@@ -142,6 +142,10 @@ typedef struct
     /* Tree which contains removed rules between apply */
     fm_tree     removedRules;
 
+    /* TRUE if the ACL was created or had its attributes or ports modified
+     * since the last apply. */
+    fm_bool     modified;
+
     /* Type of the ACL. This is necessary on SWAG because we can't only
      * rely on the numberOfPorts[] since it is possible to not have any ports
      * on a specific switch even if the ACL defines some on other switches. */
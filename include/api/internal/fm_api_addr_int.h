@@ -238,7 +238,9 @@ typedef struct _fm_internalMacAddrEntry
     /* MAC Address. */
     fm_macaddr macAddress;
 
-    /* Aging counter, used for soft aging. */
+    /* Aging counter, used for soft aging. On FM10000 this is the aging
+     * timer when the entry was learned; subsequent use is tracked in
+     * switchPtr->maTableAgingTime. */
     fm_uint64  agingCounter;
 
     /* Dirty bits (WAITING, DIRTY, POSTED, RECORDED - FM6000 only) */
@@ -269,6 +271,95 @@ typedef struct _fm_internalMacAddrEntry
 } fm_internalMacAddrEntry;
 
 
+/* Number of MA Table entries covered by each change-tracking bucket. */
+#define FM_MA_TABLE_BUCKET_SIZE         32
+
+
+/* A point-in-time copy of the MA Table cache. The copy is shared by all
+ * readers until the table next changes. */
+typedef struct _fm_maTableSnapshot
+{
+    /* Number of readers holding the snapshot, plus one while it is the
+     * switch's current snapshot. Protected by the L2 lock. */
+    fm_int                   refCount;
+
+    /* Value of maTableEpoch when the copy was taken. */
+    fm_uint64                epoch;
+
+    /* Number of valid entries in the copy. */
+    fm_int                   numValid;
+
+    /* Copy of the MA Table cache, macTableSize entries. */
+    fm_internalMacAddrEntry *entries;
+
+    /* Copy of maTableBucketEpoch, one element per bucket. */
+    fm_uint64 *              bucketEpoch;
+
+} fm_maTableSnapshot;
+
+
+/**************************************************
+ * Secondary indexes over the MA Table cache. Each
+ * index groups the valid entries into doubly linked
+ * lists by key, so that purges can visit only the
+ * entries that might match.
+ **************************************************/
+typedef enum
+{
+    /* Entries by logical port, hashed into FM_MA_INDEX_PORT_LISTS lists. */
+    FM_MA_INDEX_PORT = 0,
+
+    /* Entries by VLAN (or FID), one list per VLAN. */
+    FM_MA_INDEX_VLAN,
+
+    /* Entries whose state is FM_MAC_ENTRY_STATE_EXPIRED, a single list. */
+    FM_MA_INDEX_EXPIRED,
+
+    /* UPDATE THIS VALUE WHEN ADDING NEW INDEX TYPES */
+    FM_MA_INDEX_MAX
+
+} fm_maTableIndexType;
+
+
+/* Number of port lists. Must be a power of two. */
+#define FM_MA_INDEX_PORT_LISTS          4096
+
+
+/* Index links for a single MA Table entry. */
+typedef struct _fm_maTableIndexNode
+{
+    /* List on which the entry is linked for each index type, or -1 if
+     * the entry is not linked. */
+    fm_int32 list[FM_MA_INDEX_MAX];
+
+    /* Next and previous entries on each list, or -1. */
+    fm_int32 next[FM_MA_INDEX_MAX];
+    fm_int32 prev[FM_MA_INDEX_MAX];
+
+} fm_maTableIndexNode;
+
+
+typedef struct _fm_maTableIndex
+{
+    /* Number of MA Table entries covered by the index. */
+    fm_int               numEntries;
+
+    /* Links for each entry, numEntries elements. NULL if the index has
+     * not been allocated. */
+    fm_maTableIndexNode *nodes;
+
+    /* Number of lists of each index type. */
+    fm_int               numLists[FM_MA_INDEX_MAX];
+
+    /* First entry on each list, or -1 if the list is empty. */
+    fm_int32 *           head[FM_MA_INDEX_MAX];
+
+    /* Number of entries on each list. */
+    fm_int32 *           count[FM_MA_INDEX_MAX];
+
+} fm_maTableIndex;
+
+
 /* This alias is provided for some legacy regression tests. It should not
  * be used anymore. All references should be to fm_internalMacAddrEntry. */
 typedef fm_internalMacAddrEntry fm_internal_mac_addr_entry;
@@ -362,6 +453,26 @@ fm_status fmCommonGetAddressTable(fm_int              sw,
 
 fm_status fmCommonAllocAddrTableCache(fm_switch *switchPtr);
 fm_status fmCommonFreeAddrTableCache(fm_switch *switchPtr);
+void fmResetAddrTableTracking(fm_switch *switchPtr);
+void fmMarkAddrTableEntry(fm_int sw, fm_uint32 index);
+fm_status fmAllocAddrTableIndex(fm_maTableIndex *maIndex, fm_int numEntries);
+void fmFreeAddrTableIndex(fm_maTableIndex *maIndex);
+void fmResetAddrTableIndex(fm_maTableIndex *maIndex);
+void fmUpdateAddrTableIndex(fm_maTableIndex *         maIndex,
+                            fm_int                    entryIndex,
+                            fm_internalMacAddrEntry * entry);
+fm_int fmGetAddrTableIndexList(fm_maTableIndexType type, fm_int key);
+fm_int fmGetAddrTableIndexCount(fm_maTableIndex *   maIndex,
+                                fm_maTableIndexType type,
+                                fm_int              key);
+fm_int fmGetAddrTableIndexFirst(fm_maTableIndex *   maIndex,
+                                fm_maTableIndexType type,
+                                fm_int              key);
+fm_int fmGetAddrTableIndexNext(fm_maTableIndex *   maIndex,
+                               fm_maTableIndexType type,
+                               fm_int              entryIndex);
+fm_status fmAcquireAddrTableSnapshot(fm_int sw, fm_maTableSnapshot **snapshotPtr);
+void fmReleaseAddrTableSnapshot(fm_int sw, fm_maTableSnapshot *snapshot);
 fm_status fmCommonDeleteAddressPre(fm_int sw, fm_macAddressEntry *entry);
 fm_status fmCommonDeleteAllAddresses(fm_int sw, fm_bool dynamicOnly);
 
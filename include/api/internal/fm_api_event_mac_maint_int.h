@@ -246,6 +246,13 @@ typedef struct _fm_maPurgeStats
      * to be executed. */
     fm_uint32   numCompletedWithMorePending;
 
+    /* Number of completed purges that examined only the entries on the
+     * MA Table port, VLAN or expired lists, instead of the whole table. */
+    fm_uint32   numCompletedIndexed;
+
+    /* Number of MA Table entries examined by completed purges. */
+    fm_uint64   numEntriesExamined;
+
     /* Number of port-specific entries on the purge list (i.e. not including 
      * the maPurgeGlobalListEntry) that were allocated. */
     fm_uint32   numEntriesAllocated;
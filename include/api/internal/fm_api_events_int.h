@@ -48,6 +48,23 @@ typedef struct _fm_localDelivery
 } fm_localDelivery;
 
 
+/* Immutable copy of the local delivery list. A new snapshot is published
+ * whenever the list changes, so that events can be distributed without
+ * taking the list lock. */
+typedef struct _fm_localDeliverySnapshot
+{
+    /* next snapshot waiting to be reclaimed, once this one is retired */
+    struct _fm_localDeliverySnapshot *nextRetired;
+
+    /* number of entries in delivery */
+    fm_uint                           count;
+
+    /* copy of the local delivery list entries */
+    fm_localDelivery                  delivery[];
+
+} fm_localDeliverySnapshot;
+
+
 /* event handler for dispatching events to the stack */
 void *fmGlobalEventHandler(void *args);
 
@@ -68,6 +85,10 @@ void fmDistributeEvent(fm_event *event);
 
 /* Remove event handler */
 fm_status fmRemoveEventHandler(fm_localDelivery ** delivery);
+fm_status fmDbgPacketFanOutTest(fm_int sw, fm_int numSubscribers, fm_bool writable);
+
+/* Publish the local delivery list after it changed */
+fm_status fmPublishLocalDeliverySnapshot(void);
 
 /* Switch-Specific Event Handler */
 typedef void (*fm_switchEventHandler)(fm_event *event);
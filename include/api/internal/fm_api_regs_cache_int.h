@@ -97,6 +97,11 @@ typedef struct _fm_cachedRegs
     /**  Number of elements in the set in each dimension. */
     fm_uint32          nElements[FM_REGS_CACHE_MAX_INDICES];
 
+    /** Whether the hardware updates this register set on its own. The
+     *  cached contents of a volatile set are refreshed from the hardware
+     *  on a warm restart instead of being written back to it. */
+    fm_bool            isVolatile;
+
 } fm_cachedRegs;
 
 
@@ -146,6 +151,30 @@ typedef struct _fm_registerSGListEntry
 } fm_registerSGListEntry;
 
 
+/******************************************************************/
+/** Statistics returned by fmRegCacheRestoreImage, describing how
+ *  much of the hardware had to be rewritten on a warm restart.
+ ******************************************************************/
+typedef struct _fm_regCacheRestoreStats
+{
+    /** Number of register sets restored from the image. */
+    fm_int      nRegSets;
+
+    /** Number of register entries compared against the hardware. */
+    fm_uint32   nEntries;
+
+    /** Number of register entries that differed from the image. */
+    fm_uint32   nDiffering;
+
+    /** Number of hardware write operations issued to reconcile them. */
+    fm_uint32   nWrites;
+
+    /** Time taken by the restore, in microseconds. */
+    fm_uint64   usec;
+
+} fm_regCacheRestoreStats;
+
+
 /******************************************************************/
 /** This enum is used by all methods that allow to read/write the
  *  keyValid local cache bit array. Each value  represents one of
@@ -406,10 +435,20 @@ fm_status fmRegCacheComputeChecksum(fm_int                sw,
                                     fm_int                nEntries,
                                     fm_uint32 *           checksum);
 
+fm_status fmRegCacheSaveImage(fm_int sw, const fm_char *fileName);
+
+fm_status fmRegCacheCheckImage(fm_int sw, const fm_char *fileName);
+
+fm_status fmRegCacheRestoreImage(fm_int                    sw,
+                                 const fm_char *           fileName,
+                                 fm_regCacheRestoreStats * stats);
+
 fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
                                  const fm_cachedRegs * regSet,
                                  const fm_uint32 *     indices,
                                  fm_int                nEntries);
 
+fm_status fmDbgTestRegCacheImage(fm_int sw, const fm_char *fileName);
+
 #endif /* __FM_FM_API_REGS_CACHE_INT_H */
 
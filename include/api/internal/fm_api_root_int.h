@@ -103,6 +103,9 @@ typedef struct _fm_rootApi
     /* Routing Maintenance Thread */
     fm_thread           routingMaintenanceTask;
 
+    /* Statistics Collector Thread */
+    fm_thread           statsCollectorTask;
+
     /* semaphore to trigger packet reception */
     fm_semaphore        packetReceiveSemaphore;
 
@@ -133,8 +136,8 @@ typedef struct _fm_rootApi
     /**************************************************
      * fm_api_event_mgmt.c
      **************************************************/
-    /* the free event queue */
-    fm_eventQueue       fmEventFreeQueue;
+    /* the free event stack */
+    fm_eventStack       fmEventFreeStack;
 
     /* the semaphore used for throttling low priority events */
     fm_semaphore        fmLowPriorityEventSem;
@@ -179,12 +182,24 @@ typedef struct _fm_rootApi
     /* lock for the above list and count */
     fm_lock             localDeliveryLock;
 
+    /* immutable copy of the list used to distribute events, replaced
+     * under the above lock whenever the list changes */
+    struct _fm_localDeliverySnapshot * volatile localDeliverySnapshot;
+
+    /* replaced snapshots, freed by the event distributor */
+    struct _fm_localDeliverySnapshot *localDeliveryRetired;
+
     /* semaphore to start the global event handler thread */
     fm_semaphore        startGlobalEventHandler;
 
     /* Pointer to MAC hashing table that must be shared between processes */
     fm_int *            l2lHashTable;
 
+    /* Contribution of each byte value at each byte position of the MAC
+     * hash key to the MAC table hash, 8 x 256 entries. Shared between
+     * processes like l2lHashTable. */
+    fm_uint16 *         l2lHashByteTable;
+
 } fm_rootApi;
 
 extern FM_GLOBAL_DECL fm_rootApi *fmRootApi;
@@ -218,6 +218,7 @@ typedef struct
 fm_status fmAllocateCounterDataStructures(fm_switch *swState);
 fm_status fmInitCounters(fm_int sw);
 fm_status fmFreeCounterDataStructures(fm_switch *swState);
+void *fmStatsCollectorTask(void *args);
 
 
 #endif /* __FM_FM_API_STAT_INT_H */
@@ -371,6 +371,7 @@ struct _fm_switch
     fm_customTree               ecmpRouteTree;
     fm_bool                     supportRoutingLookups;
     fm_customTree *             routeLookupTrees;
+    fm_lpmTrie *                routeLookupLpm;
 
 
     fm_int *                    virtualRouterIds;
@@ -486,6 +487,36 @@ struct _fm_switch
     /* MAC Table cache */
     fm_internalMacAddrEntry *   maTable;
 
+    /* Number of maTable entries whose state is not INVALID. */
+    fm_int                      maTableValidCount;
+
+    /* Incremented each time an maTable entry changes. */
+    fm_uint64                   maTableEpoch;
+
+    /* maTableEpoch at the last change to each FM_MA_TABLE_BUCKET_SIZE
+     * entry bucket of maTable. */
+    fm_uint64 *                 maTableBucketEpoch;
+
+    /* One bit per maTable entry, set if the entry is counted in
+     * maTableValidCount. */
+    fm_bitArray                 maTableValidEntries;
+
+    /* Per-port, per-VLAN and expired entry lists over maTable,
+     * maintained by fmMarkAddrTableEntry. */
+    fm_maTableIndex             maTableIndex;
+
+    /* Aging fields of maTable, kept in parallel arrays so that aging
+     * sweeps need not touch the full entries. maTableAgingState mirrors
+     * maTable[i].state and is maintained by fmMarkAddrTableEntry.
+     * maTableAgingTime holds the low 32 bits of the aging timer when
+     * the entry was learned or last found used, and is maintained by
+     * the aging code. */
+    fm_byte *                   maTableAgingState;
+    fm_uint32 *                 maTableAgingTime;
+
+    /* Most recent copy of maTable, shared by readers. */
+    fm_maTableSnapshot *        maTableSnapshot;
+
     /* VLAN Table */
     fm_vlanEntry *              vidTable;
     fm_uint16                   reservedVlan;
@@ -705,6 +736,7 @@ struct _fm_switch
     fm_status                   (*PostBootSwitch)(fm_int sw);
     fm_status                   (*FreeResources)(fm_int sw);
     fm_status                   (*SetSwitchState)(fm_int sw, fm_bool state);
+    fm_status                   (*SaveWarmRestartImage)(fm_int sw);
 #if 0
     fm_status                   (*GetSwitchState)(fm_int sw, fm_bool *state);
 #endif
@@ -1197,6 +1229,13 @@ struct _fm_switch
                                      fm_int vcid);
     fm_status   (*GetSwitchCounters)(fm_int             sw, 
                                      fm_switchCounters *counters);
+    fm_status   (*GetPortCounterRates)(fm_int               sw,
+                                       fm_int               port,
+                                       fm_portCounterRates *rates);
+
+    /* The Stats Collector Task calls this function once per period to
+     * sweep the counters of all ports. May be NULL. */
+    fm_status   (*CollectPortCounters)(fm_int sw);
 
     /**************************************************
      * Vlan Support
@@ -1260,6 +1299,9 @@ struct _fm_switch
                                         fm_int    numPorts,
                                         fm_int *  portList,
                                         fm_int    state);
+    fm_status   (*SetVlanPortConfigList)(fm_int              sw,
+                                         fm_int              numEntries,
+                                         fm_vlanPortConfig * configList);
 
     /* functions to manage customer VLANs for provider bridging */
     fm_status   (*AddCVlan)(fm_int      sw,
@@ -2813,6 +2855,27 @@ struct _fm_switch
                                      fm_int                     nEntries,
                                      fm_scatterGatherListEntry *sgList);
 
+    /** \desc       Optional: Execute a list of register reads and writes
+     *              as one transaction, taking the platform register access
+     *              lock at most once. If not initialized by the platform
+     *              layer, ''ReadUINT32Mult'' and ''WriteUINT32Mult'' will
+     *              be used for each entry instead.
+     *
+     *  \param[in]  sw is the switch on which to operate.
+     *
+     *  \param[in]  nEntries is the number of entries in the transaction.
+     *
+     *  \param[in]  entries points to the transaction entries, which are
+     *              executed in order.
+     *
+     *  \param[in]  flags is a bit mask of FM_REG_TXN_FLAG_* values.
+     *
+     *  \return     FM_OK if successful.   */
+    fm_status  (*CommitRegTransaction)(fm_int                  sw,
+                                       fm_int                  nEntries,
+                                       fm_regTransactionEntry *entries,
+                                       fm_uint32               flags);
+
     /* Optional: Write a value to a single 32-bit wide register via I2C for
      * diagnostic purposes only. Platforms that provide only I2C access
      * to the switch should initialize WriteUINT32 to point to a function
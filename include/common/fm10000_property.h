@@ -561,6 +561,17 @@
 #define FM_AAT_API_FM10000_ALLOW_KRPCAL_ON_EEE      FM_API_ATTR_BOOL
 #define FM_AAD_API_FM10000_ALLOW_KRPCAL_ON_EEE      FALSE
 
+/* Register cache image used for a warm restart, saved by the application
+ * with fmSaveWarmRestartImage before a planned restart of the API process.
+ * If the switch is still out of reset and the image is valid, the boot
+ * skips the switch reset and restores the register cache from the image
+ * instead of reading it from the hardware. Empty to always cold boot.
+ * The switch is also cold booted as long as some boot steps cannot yet
+ * reconcile their state with the restored cache. */
+#define FM_AAK_API_FM10000_WARM_RESTART_IMAGE       "api.FM10000.warmRestartImage"
+#define FM_AAT_API_FM10000_WARM_RESTART_IMAGE       FM_API_ATTR_TEXT
+#define FM_AAD_API_FM10000_WARM_RESTART_IMAGE       ""
+
 /************************************************************************
  ****                                                                ****
  ****              END UNDOCUMENTED API PROPERTIES                   ****
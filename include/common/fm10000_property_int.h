@@ -212,6 +212,9 @@ typedef struct _fm10000_property
     /* Allow Kr PCAL on EEE */
     fm_bool allowKrPcalOnEee;
 
+    /* Register cache image for a warm restart */
+    fm_char warmRestartImage[FM_API_ATTR_TEXT_MAX_LENGTH];
+
 } fm10000_property;
 
 #endif /* __FM_FM10000_PROPERTY_INT_H */
@@ -58,6 +58,7 @@
 #include <common/fm_tree.h>
 #include <common/fm_dlist.h>
 #include <common/fm_bitarray.h>
+#include <common/fm_lpm.h>
 #include <common/fm_bitfield.h>
 #include <common/fm_crc32.h>
 #include <common/fm_property.h>
@@ -34,8 +34,23 @@
 #ifndef __FM_FM_CRC32_H
 #define __FM_FM_CRC32_H
 
+/* Initial value of a running CRC-32 or CRC-32C register. */
+#define FM_CRC32_INIT               0xffffffffU
+
+struct _fm_buffer;
+
 fm_uint32 fmCrc32(fm_byte *buf, fm_int len);
 fm_uint32 fmCrc32Math(fm_byte *buf, fm_int len);
 fm_uint32 fmCrc32C(fm_byte *buf, fm_int len);
 
+fm_uint32 fmCrc32Update(fm_uint32 crc, fm_byte *buf, fm_int len);
+fm_uint32 fmCrc32CUpdate(fm_uint32 crc, fm_byte *buf, fm_int len);
+fm_uint32 fmCrc32BufferUpdate(fm_uint32          crc,
+                              struct _fm_buffer *buffer,
+                              fm_int             offset,
+                              fm_int             len);
+fm_uint32 fmCrc32Buffer(struct _fm_buffer *buffer, fm_int offset, fm_int len);
+
+fm_status fmDbgBenchmarkCrc32(fm_int iterations);
+
 #endif /* __FM_FM_CRC32_H */
@@ -58,7 +58,9 @@ enum
     FM_LOCK_PREC_PARITY,                    /* switchExt->parityLock */
     FM_LOCK_PREC_CRM,                       /* swstate->crmLock */
     FM_LOCK_PREC_MTABLE,                    /* swstate->mtableLock */
+    FM_LOCK_PREC_STATS,                     /* switchExt->statsCollector->lock */
     FM_LOCK_PREC_STATE_LOCK,                /* swstate->stateLock */
+    FM_LOCK_PREC_SERDES_DFE,                /* laneExt->dfeExt.lock */
     FM_LOCK_PREC_MIRROR,                    /* swstate->mirrorLock */
     FM_LOCK_PREC_TRIGGERS,                  /* swstate->triggerLock */
     FM_LOCK_PREC_FFU,                       /* switchExt->ffuAtomicAccessLock */
@@ -0,0 +1,102 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:           fm_lpm.h
+ * Creation Date:  October 17, 2026
+ * Description:    Multibit trie for longest-prefix-match lookups.
+ *
+ * Copyright (c) 2015 - 2026, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef __FM_FM_LPM_H
+#define __FM_FM_LPM_H
+
+
+/* Number of key bits consumed by each level of the trie. */
+#define FM_LPM_STRIDE           8
+
+/* Number of slots in each trie node. */
+#define FM_LPM_NODE_SLOTS       (1 << FM_LPM_STRIDE)
+
+/* Maximum key length supported, in bits (enough for an IPv6 address). */
+#define FM_LPM_MAX_KEY_BITS     128
+
+/* Maximum key length supported, in bytes. */
+#define FM_LPM_MAX_KEY_BYTES    (FM_LPM_MAX_KEY_BITS / 8)
+
+
+/* private types */
+
+struct _fm_lpmNode;
+typedef struct _fm_lpmNode    fm_lpmNode;
+
+
+/**************************************************/
+/** \ingroup intLpm
+ *  A longest-prefix-match table implemented as a
+ *  multibit trie with a fixed stride of 
+ *  FM_LPM_STRIDE bits. Each prefix is expanded
+ *  into the slots of the node at which it ends, so
+ *  that a lookup visits at most one node per 
+ *  stride regardless of the number of prefixes
+ *  stored. Keys are byte arrays in network order
+ *  (most significant byte first).
+ **************************************************/
+typedef struct _fm_lpmTrie
+{
+    /** Key length in bits, as given to fmLpmInit. */
+    fm_int      keyBits;
+
+    /** Key length in bytes, which is also the maximum trie depth. */
+    fm_int      keyBytes;
+
+    /** Root node, NULL if the trie is empty. */
+    fm_lpmNode *root;
+
+    /** Read-only: number of prefixes stored in the trie. */
+    fm_int      numPrefixes;
+
+    /** Read-only: number of nodes allocated by the trie. */
+    fm_int      numNodes;
+
+} fm_lpmTrie;
+
+
+fm_status fmLpmInit(fm_lpmTrie *trie, fm_int keyBits);
+void fmLpmDestroy(fm_lpmTrie *trie);
+fm_status fmLpmInsert(fm_lpmTrie *   trie,
+                      const fm_byte *key,
+                      fm_int         prefixLength,
+                      void *         value);
+fm_status fmLpmRemove(fm_lpmTrie *trie, const fm_byte *key, fm_int prefixLength);
+fm_status fmLpmLookup(const fm_lpmTrie *trie,
+                      const fm_byte *   key,
+                      void **           value,
+                      fm_int *          prefixLength);
+
+
+#endif /* __FM_FM_LPM_H */
@@ -424,6 +424,7 @@ typedef enum
 /* -------- Add new UNDOCUMENTED api properties below this line! -------- */
 
 #define FM_AAK_DEBUG_BOOT_INTERRUPT_HANDLER         "debug.boot.interruptHandler.disable"
+#define FM_AAT_DEBUG_BOOT_INTERRUPT_HANDLER         FM_API_ATTR_BOOL
 #define FM_AAD_DEBUG_BOOT_INTERRUPT_HANDLER         FALSE
 
 /* Enable the MAC table maintenance thread. Should be adjusted at boot time or
@@ -444,6 +445,14 @@ typedef enum
 #define FM_AAT_API_FAST_MAINTENANCE_PERIOD          FM_API_ATTR_INT
 #define FM_AAD_API_FAST_MAINTENANCE_PERIOD          20000000
 
+/* Period (in ms) at which the statistics collector thread sweeps the
+ * counters of all ports. When non-zero, ''fmGetPortCounters'' returns the
+ * last collected snapshot instead of reading the hardware. Defaults to 0,
+ * which disables the collector. Only taken into account at initialization. */
+#define FM_AAK_API_STATS_COLLECTOR_PERIOD           "api.statsCollector.period"
+#define FM_AAT_API_STATS_COLLECTOR_PERIOD           FM_API_ATTR_INT
+#define FM_AAD_API_STATS_COLLECTOR_PERIOD           0
+
 /* Disable the physical port GLORT LAG Filtering. */
 #define FM_AAK_API_STRICT_GLORT_PHYSICAL            "api.strict.glortPhysical"
 #define FM_AAT_API_STRICT_GLORT_PHYSICAL            FM_API_ATTR_BOOL
@@ -582,6 +591,39 @@ typedef enum
 #define FM_AAT_API_PLATFORM_PKT_INTERFACE       FM_API_ATTR_TEXT
 #define FM_AAD_API_PLATFORM_PKT_INTERFACE       "raw"
 
+/* Maximum number of frames received by a single recvmmsg call of the raw
+ * packet socket interface. 1 receives one frame per system call. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_RX_BATCH "api.platform.rawSocket.rxBatchSize"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_RX_BATCH FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_RX_BATCH 32
+
+/* Maximum number of frames sent by a single sendmmsg call of the raw
+ * packet socket interface. 1 sends one frame per system call. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_TX_BATCH "api.platform.rawSocket.txBatchSize"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_TX_BATCH FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_TX_BATCH 32
+
+/* Whether the raw packet socket interface uses memory-mapped TPACKET_V3
+ * receive and transmit rings. Received frames are then passed to the API
+ * in place instead of being copied into the buffer pool. Falls back to
+ * recvmmsg / sendmmsg if the rings cannot be set up. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_MMAP_RING "api.platform.rawSocket.mmapRing"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_MMAP_RING FM_API_ATTR_BOOL
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_MMAP_RING FALSE
+
+/* Number of 256KB blocks in each of the memory-mapped receive and transmit
+ * rings of the raw packet socket interface. */
+#define FM_AAK_API_PLATFORM_RAW_SOCKET_RING_BLOCKS "api.platform.rawSocket.ringBlocks"
+#define FM_AAT_API_PLATFORM_RAW_SOCKET_RING_BLOCKS FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_RAW_SOCKET_RING_BLOCKS 16
+
+/* Maximum number of frames queued in each class of the CPU transmit packet
+ * queue. The class queues grow on demand up to this depth. Can be changed
+ * per class with the FM_SWITCH_PACKET_TX_CLASS_CONFIG switch attribute. */
+#define FM_AAK_API_PLATFORM_PKT_TX_CLASS_DEPTH  "api.platform.pktTxClassMaxDepth"
+#define FM_AAT_API_PLATFORM_PKT_TX_CLASS_DEPTH  FM_API_ATTR_INT
+#define FM_AAD_API_PLATFORM_PKT_TX_CLASS_DEPTH  1024
+
 /* Specifies the multi-switch topology to use for a multi-node/multi-switch
  * white model platform. Default is empty, meaning single node/single switch
  * environment. */
@@ -782,6 +824,11 @@ fm_status fmGetApiProperty(fm_text        key,
                            fm_apiAttrType attrType,
                            void *         value);
 
+fm_status fmGetApiPropertyFirst(fm_text *firstKey, fm_apiAttrType *attrType);
+fm_status fmGetApiPropertyNext(fm_text         startKey,
+                               fm_text *       nextKey,
+                               fm_apiAttrType *attrType);
+
 
 /* Shortcuts for getting properties of a given type. */
 fm_int fmGetIntApiProperty(fm_text key, fm_int defaultValue);
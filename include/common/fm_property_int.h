@@ -35,6 +35,14 @@
 #define __FM_FM_PROPERTY_INT_H
 
 
+/* Number of slots in each of the property hash indexes. Must be a power
+ * of two comfortably larger than the number of API properties. */
+#define FM_PROPERTY_INDEX_SIZE      512
+
+/* Marks an unused slot of a property hash index. */
+#define FM_PROPERTY_INDEX_EMPTY     0xFFFF
+
+
 typedef struct _fm_property
 {
 
@@ -155,6 +163,9 @@ typedef struct _fm_property
     /* Fast maintenance thread period */
     fm_int  fastMaintenancePer;
 
+    /* Statistics collector thread period (ms), 0 when disabled */
+    fm_int  statsCollectorPer;
+
     /* Disable the physical port GLORT LAG Filtering */
     fm_bool strictGlotPhysical;
 
@@ -218,6 +229,21 @@ typedef struct _fm_property
     /* Method of receiving or injecting a packet into the fabric */
     fm_char pktInterface[32];
 
+    /* Maximum number of frames per raw packet socket receive call */
+    fm_int  rawSocketRxBatchSize;
+
+    /* Maximum number of frames per raw packet socket send call */
+    fm_int  rawSocketTxBatchSize;
+
+    /* Use memory-mapped rings on the raw packet socket */
+    fm_bool rawSocketMmapRing;
+
+    /* Number of blocks in each raw packet socket ring */
+    fm_int  rawSocketRingBlocks;
+
+    /* Maximum number of frames queued in each CPU transmit class */
+    fm_int  pktTxClassMaxDepth;
+
     /* Multi-switch topology to use for a multi-node/multi-switch white model platform*/
     fm_char modelTopologyName[16];
 
@@ -239,4 +239,11 @@ fm_status fmClearStateTransitionHistory( fm_smHandle handle );
 fm_status fmChangeStateTransitionHistorySize( fm_smHandle handle,
                                               fm_int      historySize );
 
+/* Declaration of a function to benchmark the event rate on lane state
+ * machines */
+fm_status fmDbgBenchmarkStateMachine( fm_int sw,
+                                      fm_int nrLanes,
+                                      fm_int nrWorkers,
+                                      fm_int iterations );
+
 #endif /* __FM_FM_STATE_MACHINE_H */
@@ -1158,6 +1158,7 @@ void fmDbgEventQueueCreated(fm_eventQueue *inQueue);
 void fmDbgEventQueueDestroyed(fm_eventQueue *inQueue);
 void fmDbgEventQueueEventPopped(fm_eventQueue *inQueue, fm_event *event);
 void fmDbgEventQueueDump(void);
+void fmDbgEventQueueDumpHistograms(void);
 
 
 /* Switch insertion/removal debug API
@@ -34,6 +34,33 @@
 #ifndef __FM_FM_BUFFER_STD_ALLOC_H
 #define __FM_FM_BUFFER_STD_ALLOC_H
 
+/* Maximum number of registered buffer views */
+#define FM_MAX_BUFFER_VIEWS     4
+
+/* Releases the reference a buffer holds on view memory. Called with the
+ * buffer lock held when a buffer whose data points into the view is freed;
+ * it may unregister the view. */
+typedef void (*fm_bufferViewReleaseFunc)(void *cookie, fm_uint32 *data);
+
+/* A region of externally owned memory that buffers may point into, such as
+ * a memory-mapped packet ring, instead of carrying a copy of the data. Views
+ * are local to the process that registers them. */
+typedef struct
+{
+    /* First byte of the region, NULL if the entry is unused */
+    fm_byte *                base;
+
+    /* Size of the region in bytes */
+    fm_uint64                size;
+
+    /* Function called when a buffer pointing into the region is freed */
+    fm_bufferViewReleaseFunc release;
+
+    /* Argument passed to the release function */
+    void *                   cookie;
+
+} fm_bufferView;
+
 /* manages the circular list of buffers */
 typedef struct
 {
@@ -73,6 +100,11 @@ fm_status fmPlatformInitBuffers(fm_uint32 *bufferMemoryPool);
 fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool, fm_int numBuffers);
 fm_buffer *fmPlatformAllocateBufferV2(fm_bufferType type);
 fm_status fmPlatformGetAvailableBuffersV2(fm_bufferType type, fm_int *count);
+fm_status fmPlatformRegisterBufferView(fm_byte *                base,
+                                       fm_uint64                size,
+                                       fm_bufferViewReleaseFunc release,
+                                       void *                   cookie);
+fm_status fmPlatformUnregisterBufferView(fm_byte *base);
 
 
 #endif /* __FM_FM_BUFFER_STD_ALLOC_H */
@@ -38,6 +38,16 @@
 #define FM_MAX_FDS_NUM                            1024
 #define FM_FDS_POLL_TIMEOUT_USEC                  1000
 
+/* Number of packet entries the TX scheduler moves from the class queues
+ * into the dispatch queue at a time, unless the caller asks for more. This
+ * bounds how long a strict priority frame waits behind queued bulk frames. */
+#define FM_PACKET_TX_DISPATCH_DEPTH               16
+
+/* Default scheduling weights of the TX classes, 0 is strict priority */
+#define FM_PACKET_TX_CONTROL_WEIGHT               0
+#define FM_PACKET_TX_NETWORK_WEIGHT               3
+#define FM_PACKET_TX_BULK_WEIGHT                  1
+
 /* holds a packet entry */
 typedef struct _fm_packetEntry
 {
@@ -71,11 +81,73 @@ typedef struct _fm_packetEntry
      *  of ports, the last packet entry will have this field set to TRUE. */
     fm_bool         freePacketBuffer;
 
+    /* The TX class the packet was queued in */
+    fm_int          txClass;
+
+    /* When the packet was queued, to measure the queueing latency */
+    fm_timestamp    enqueueTime;
+
 } fm_packetEntry;
 
 
+/* holds the packets queued in one TX class */
+typedef struct _fm_packetClassQueue
+{
+    /**************************************************
+     * Circular buffer of numEntries packet entries,
+     * following the same push/pull convention as
+     * fm_packetQueue. The buffer is allocated with
+     * FM_PACKET_QUEUE_SIZE entries and doubles, up to
+     * maxDepth + 1 entries, whenever a sender finds it
+     * full. It shrinks back once it has been drained.
+     **************************************************/
+    fm_packetEntry *entries;
+    fm_uint         numEntries;
+    fm_uint         pushIndex;
+    fm_uint         pullIndex;
+
+    /* The fm_packetTxClass this queue holds */
+    fm_int          txClass;
+
+    /* Scheduling configuration, see fm_packetTxClassConfig */
+    fm_int          maxDepth;
+    fm_int          weight;
+    fm_int          dropPolicy;
+
+    /* Remaining weighted round robin credit, in packets. Only used by
+     * the scheduler, under the fm_packetQueue lock. */
+    fm_int          credit;
+
+    /* Counters, see fm_packetTxClassStats. The enqueued count doubles as
+     * the mark used to roll back a partially queued send. */
+    fm_uint64       enqueued;
+    fm_uint64       dropped;
+    fm_uint64       dequeued;
+    fm_uint64       latencyTotal;
+    fm_uint64       latencyMax;
+    fm_int          highWater;
+
+    /* Serializes the senders of this class with the scheduler */
+    pthread_mutex_t mutex;
+
+} fm_packetClassQueue;
+
+
 typedef struct _fm_packetQueue
 {
+    /**************************************************
+     * Senders queue packets in one of the TX class
+     * queues, selected by fmPacketQueueSelectClass.
+     * The scheduler moves them into packetQueueList,
+     * strict priority classes first and the weighted
+     * classes in weighted round robin order, and the
+     * platform transmit function drains it.
+     **************************************************/
+    fm_packetClassQueue classQueue[FM_PACKET_TX_CLASS_MAX];
+
+    /* Number of entries the scheduler keeps in packetQueueList */
+    fm_int         dispatchDepth;
+
     /* holds the current send queue of packets in a circular buffer */
     fm_packetEntry packetQueueList[FM_PACKET_QUEUE_SIZE];
 
@@ -98,6 +170,7 @@ typedef struct _fm_packetQueue
 
     fm_int         switchNum;
 
+    /* Serializes the transmit function and the scheduler */
     pthread_mutex_t mutex;
 
 } fm_packetQueue;
@@ -206,15 +279,36 @@ fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw);
 fm_status fmPacketQueueFree(fm_int sw);
 void      fmPacketQueueLock(fm_packetQueue *queue);
 void      fmPacketQueueUnlock(fm_packetQueue *queue);
-fm_status fmPacketQueueUpdate(fm_packetQueue *queue);
-
-fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
-                               fm_buffer *      packet,
-                               fm_int           packetLength,
-                               fm_islTag *      islTag,
-                               fm_islTagFormat  islTagFormat,
-                               fm_bool          suppressVlanTag,
-                               fm_bool          freeBuffer);
+fm_int    fmPacketQueueSchedule(fm_packetQueue *queue, fm_int depth);
+void      fmPacketQueueAdvance(fm_packetQueue *queue);
+
+fm_packetClassQueue *fmPacketQueueSelectClass(fm_packetQueue *queue,
+                                              fm_buffer *     packet);
+void      fmPacketClassQueueLock(fm_packetClassQueue *queue);
+void      fmPacketClassQueueUnlock(fm_packetClassQueue *queue);
+fm_status fmPacketQueueReserve(fm_packetClassQueue *queue,
+                               fm_packetEntry **    entry);
+fm_status fmPacketQueueUpdate(fm_packetClassQueue *queue);
+void      fmPacketQueueRollback(fm_packetClassQueue *queue, fm_uint64 mark);
+fm_status fmPacketQueueApplyDropPolicy(fm_int               sw,
+                                       fm_packetClassQueue *queue,
+                                       fm_buffer *          packet,
+                                       fm_status            err);
+
+fm_status fmPacketQueueEnqueue(fm_packetClassQueue *queue,
+                               fm_buffer *          packet,
+                               fm_int               packetLength,
+                               fm_islTag *          islTag,
+                               fm_islTagFormat      islTagFormat,
+                               fm_bool              suppressVlanTag,
+                               fm_bool              freeBuffer);
+
+fm_status fmGenericPacketGetTxClassAttribute(fm_int sw,
+                                             fm_int attr,
+                                             void * value);
+fm_status fmGenericPacketSetTxClassAttribute(fm_int sw,
+                                             fm_int attr,
+                                             void * value);
 
 fm_status fmPacketReceiveEnqueue(fm_int sw, fm_event *event,
                                  fm_switchEventHandler selfTestEventHandler);
@@ -48,5 +48,11 @@ fm_status fmRawPacketSocketDestroy(fm_int sw);
 fm_bool fmIsRawPacketSocketDeviceOperational(fm_int   sw,
                                              fm_bool *isRawSocket,
                                              fm_int * mtu);
+void fmDbgDumpRawPacketSocketStats(fm_int sw);
+fm_status fmDbgRawPacketSocketBenchmark(fm_text txIface,
+                                        fm_text rxIface,
+                                        fm_int  numFrames,
+                                        fm_int  frameSize,
+                                        fm_int  batchSize);
 
 #endif /* __FM_FM_GENERIC_RAWSOCKET_H */
@@ -123,6 +123,20 @@
         fm10000GenericSendPacketISL(sw, islTag, islTagFormat, pkt)
 #endif
 
+/* Can be overridden in platform_defines.h for platforms with their own
+ * transmit queue. */
+#ifndef FM_FM10000_GET_PACKET_TX_CLASS_ATTR
+#define FM_FM10000_GET_PACKET_TX_CLASS_ATTR(sw, attr, value)                \
+        fmGenericPacketGetTxClassAttribute(sw, attr, value)
+#endif
+
+/* Can be overridden in platform_defines.h for platforms with their own
+ * transmit queue. */
+#ifndef FM_FM10000_SET_PACKET_TX_CLASS_ATTR
+#define FM_FM10000_SET_PACKET_TX_CLASS_ATTR(sw, attr, value)                \
+        fmGenericPacketSetTxClassAttribute(sw, attr, value)
+#endif
+
 /* Can be overridden in platform_defines.h */
 #ifndef FM_PLATFORM_GET_HARDWARE_LAG_GLORT_RANGE
 #ifdef FM_SUPPORT_FM10000
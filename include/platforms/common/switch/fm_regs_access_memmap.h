@@ -64,5 +64,15 @@ fm_status fmPlatformMaskCSR(fm_int    sw,
                             fm_uint   reg,
                             fm_uint32 mask,
                             fm_bool   on);
+fm_status fmPlatformReadCSRScatterGather(fm_int                     sw,
+                                         fm_int                     nEntries,
+                                         fm_scatterGatherListEntry *sgList);
+fm_status fmPlatformWriteCSRScatterGather(fm_int                     sw,
+                                          fm_int                     nEntries,
+                                          fm_scatterGatherListEntry *sgList);
+fm_status fmPlatformCommitCSRTransaction(fm_int                  sw,
+                                         fm_int                  nEntries,
+                                         fm_regTransactionEntry *entries,
+                                         fm_uint32               flags);
 
 #endif  /* __FM_REGS_ACCESS_MEMMAP_H */
@@ -82,7 +82,9 @@ typedef enum _fm_platformSwitchType
 /*****************************************************************************
  * Customer-Configurable ALOS Constants
  *****************************************************************************/
-#define FM_ALOS_INTERNAL_MAX_LOCKS          256
+/* Leaves room for the SerDes-DFE lock of each of the 69 lanes of every
+ * switch */
+#define FM_ALOS_INTERNAL_MAX_LOCKS          (256 + 72 * FM_MAX_NUM_FOCALPOINTS)
 #define FM_ALOS_INTERNAL_MAX_DBG_RW_LOCKS   64
 #define FM_ALOS_INTERNAL_MAX_SEMAPHORES     1000
 #define FM_ALOS_INTERNAL_DYN_LOAD_LIBS      2
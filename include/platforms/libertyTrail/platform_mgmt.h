@@ -62,6 +62,10 @@ typedef struct
     /* Number of retries to read EEPROM again */
     fm_int eepromReadRetries;
 
+    /* Tag of the EEPROM read queued to the I2C worker, 0 if none. Reset
+     * when the module changes, so that a stale read is discarded. */
+    fm_uint32 eepromReadTag;
+
     /* Copy of the EEPROM content */
     fm_byte eeprom[XCVR_EEPROM_CACHE_SIZE];
 
@@ -97,6 +101,7 @@ fm_status fmPlatformMgmtConfigSfppXcvrAutoNeg(fm_int sw,
                                               fm_bool enable);
 fm_status fmPlatformMgmtEnableXcvr(fm_int sw, fm_int port, fm_bool enable);
 fm_status fmPlatformMgmtDumpPort(fm_int sw, fm_int port);
+fm_status fmPlatformMgmtDumpI2cStats(fm_int sw);
 
 fm_status fmPlatformMgmtEnableCableAutoDetection(fm_int  sw, 
                                                  fm_int  port, 
@@ -134,6 +134,35 @@ typedef struct
     /* Name of raw packet socket interface  */
     fm_char                 ifaceName[IF_NAMESIZE];
 
+    /* Interface index of the raw packet socket interface */
+    fm_int                  ifaceIndex;
+
+    /* Running state and MTU of the raw packet socket interface. These are
+     * cached and refreshed on link events instead of being queried from
+     * the device for every packet. Both are protected by ifaceStateLock,
+     * since the receive thread updates them while senders read them. */
+    fm_bool                 ifaceRunning;
+    fm_int                  ifaceMtu;
+    fm_lock                 ifaceStateLock;
+
+    /* Netlink socket delivering link events for the raw packet socket
+     * interface, -1 if link events are not available */
+    fm_int                  linkEventSocket;
+
+    /* Maximum number of frames per recvmmsg / sendmmsg call */
+    fm_int                  rawRxBatchSize;
+    fm_int                  rawTxBatchSize;
+
+    /* Raw packet socket system call and frame counters */
+    fm_uint64               rawRxSyscalls;
+    fm_uint64               rawRxPackets;
+    fm_uint64               rawTxSyscalls;
+    fm_uint64               rawTxPackets;
+
+    /* Memory-mapped rings of the raw packet socket, NULL if frames are
+     * copied with recvmmsg / sendmmsg */
+    struct _fm_rawSocketRing *rawRing;
+
     /**************************************************
      * Memory mapping
      **************************************************/
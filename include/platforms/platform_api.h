@@ -189,6 +189,7 @@ fm_status fmPlatformGetSwitchPartNumber(fm_int sw, fm_switchPartNum *spn);
 fm_status fmPlatformGetAvailableBuffers(fm_int *count);
 fm_buffer *fmPlatformAllocateBuffer(void);
 fm_status fmPlatformFreeBuffer(fm_buffer *buf);
+fm_bool fmPlatformBufferChainHasView(fm_buffer *chain);
 
 
 /**************************************************
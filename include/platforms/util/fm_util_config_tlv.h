@@ -149,6 +149,12 @@
 #define FM_TVL_API_SERDES_VALIDATE_TIMER            0x103c
 #define FM_TVL_API_SERDES_ACTION_UP_ALLOWED         0x103d
 #define FM_TLV_API_HNI_FLOW_ENTRIES_PER_VF          0x103e
+#define FM_TLV_API_RAW_SOCKET_RX_BATCH              0x103f
+#define FM_TLV_API_RAW_SOCKET_TX_BATCH              0x1040
+#define FM_TLV_API_RAW_SOCKET_MMAP_RING             0x1041
+#define FM_TLV_API_RAW_SOCKET_RING_BLOCKS           0x1042
+#define FM_TLV_API_PKT_TX_CLASS_DEPTH               0x1043
+#define FM_TLV_API_STATS_COLLECTOR_PER              0x1044
 
 
 /* FM10K properties */
@@ -219,6 +225,7 @@
 #define FM_TLV_FM10K_EEE_SPICO_INTR                 0x2816 
 #define FM_TLV_FM10K_USE_ALTERNATE_SPICO_FW         0x2817 
 #define FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE            0x2818 
+#define FM_TLV_FM10K_WARM_RESTART_IMAGE             0x2819
 
 
 /* Liberty Trail platform properties */
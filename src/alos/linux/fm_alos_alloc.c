@@ -88,6 +88,71 @@
 
 #endif  /* FM_HAVE_VALGRIND */
 
+/* Per-thread magazines hand out and take back objects without taking the
+ * shared memory mutex. They are disabled when the allocator is being
+ * instrumented, since both instrumentation schemes need to see every
+ * allocation and deallocation. */
+#if MEMORY_DEBUG_CALLER || defined(FM_HAVE_VALGRIND)
+#define FM_ALLOC_USE_MAGAZINES        FALSE
+#else
+#define FM_ALLOC_USE_MAGAZINES        TRUE
+#endif
+
+/* Largest bucket size (including the object header) whose bucket is found
+ * through the direct size class index rather than by walking the sorted
+ * bucket list. */
+#define FM_ALLOC_INDEXED_MAX_SIZE     4096
+
+/* Number of size classes covered by the direct index (one per 8 bytes) */
+#define FM_ALLOC_NUM_SIZE_CLASSES     (FM_ALLOC_INDEXED_MAX_SIZE / 8)
+
+/* Largest bucket size (including the object header) cached in per-thread
+ * magazines. */
+#define FM_ALLOC_MAGAZINE_MAX_SIZE    512
+
+/* Number of size classes which have per-thread magazines */
+#define FM_ALLOC_NUM_MAGAZINES        (FM_ALLOC_MAGAZINE_MAX_SIZE / 8)
+
+/* Maximum number of objects held in a single magazine */
+#define FM_ALLOC_MAGAZINE_DEPTH       32
+
+/* Number of objects moved between a magazine and its shared bucket when
+ * the magazine is refilled or flushed. */
+#define FM_ALLOC_MAGAZINE_BATCH       (FM_ALLOC_MAGAZINE_DEPTH / 2)
+
+/* Maps a bucket size (a non-zero multiple of 8) to its size class */
+#define SIZE_CLASS(size)              ( ( (size) >> 3 ) - 1 )
+
+/* Per size class statistics, kept in shared memory and only updated while
+ * holding the shared memory mutex. */
+typedef struct _fm_allocClassStats
+{
+    /* Allocations satisfied by a thread magazine without taking the mutex */
+    fm_uint64 magazineHits;
+
+    /* Frees absorbed by a thread magazine without taking the mutex */
+    fm_uint64 magazineFrees;
+
+    /* Number of batch refills of a thread magazine from the shared bucket */
+    fm_uint64 refills;
+
+    /* Number of batch returns from a thread magazine to the shared bucket */
+    fm_uint64 flushes;
+
+    /* Allocations and frees that went straight to the shared bucket */
+    fm_uint64 lockedAllocs;
+    fm_uint64 lockedFrees;
+
+    /* Number of times the shared memory mutex was already held by someone
+     * else when an allocation or free of this size class needed it */
+    fm_uint64 contended;
+
+    /* Objects currently held in thread magazines, as of the last time
+     * each thread synchronized its counters */
+    fm_int64  cached;
+
+} fm_allocClassStats;
+
 /* Holds free objects of a particular size */
 typedef struct _fm_memoryBucket
 {
@@ -174,6 +239,18 @@ typedef struct _fm_sharedHeader
      * arbitrary pointers. */
     fm_rootInfo *    roots;
 
+    /* Direct index of the buckets for small objects, by size class.
+     * Entries are NULL until the bucket is created by GetBucket. */
+    fm_memoryBucket *bucketIndex[FM_ALLOC_NUM_SIZE_CLASSES];
+
+    /* Allocator statistics for each indexed size class */
+    fm_allocClassStats classStats[FM_ALLOC_NUM_SIZE_CLASSES];
+
+    /* Total acquisitions of "mutex" from fmAlloc/fmFree, and how many of
+     * them found the mutex already held */
+    fm_uint64        lockAcquisitions;
+    fm_uint64        lockContentions;
+
 } fm_sharedHeader;
 
 
@@ -194,6 +271,43 @@ typedef struct _fm_objectHeader
 } fm_objectHeader;
 
 
+#if FM_ALLOC_USE_MAGAZINES
+/* Per-thread cache of free objects for one size class. The magazine lives
+ * in process-local memory but the objects it holds are in shared memory,
+ * so they remain valid in every process. */
+typedef struct _fm_allocMagazine
+{
+    /* Number of valid entries in objects */
+    fm_uint  count;
+
+    /* Allocations and frees served since the counters were last folded
+     * into the shared statistics */
+    fm_uint  pendingHits;
+    fm_uint  pendingFrees;
+
+    /* Requested size remainder bits not yet folded into the bucket's
+     * allocationRemainderBitmask */
+    fm_byte  pendingRemainderBitmask;
+
+    /* Free objects, used as a stack */
+    void *   objects[FM_ALLOC_MAGAZINE_DEPTH];
+
+} fm_allocMagazine;
+
+
+/* The set of magazines owned by one thread */
+typedef struct _fm_allocThreadCache
+{
+    /* Fork generation in which this cache was created; a child process
+     * must not use objects that its parent may still hand out */
+    fm_uint          forkGeneration;
+
+    fm_allocMagazine magazines[FM_ALLOC_NUM_MAGAZINES];
+
+} fm_allocThreadCache;
+#endif
+
+
 #if MEMORY_DEBUG_CALLER
 typedef struct _fm_callerInfo
 {
@@ -234,6 +348,19 @@ typedef struct _fm_callerInfo
 /* Process local variable indicating whether the process created the SHM */
 fm_bool processCreatedSHM = FALSE;
 
+#if FM_ALLOC_USE_MAGAZINES
+/* Thread local storage key for the per-thread magazines */
+static pthread_key_t  threadCacheKey;
+static pthread_once_t threadCacheOnce = PTHREAD_ONCE_INIT;
+static fm_bool        threadCacheKeyValid = FALSE;
+
+/* Set once the process has started to exit and its magazines are flushed */
+static volatile fm_bool threadCachesShutdown = FALSE;
+
+/* Incremented in the child after every fork */
+static volatile fm_uint forkGeneration = 0;
+#endif
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -329,6 +456,27 @@ static fm_memoryBucket *GetBucket(fm_sharedHeader *hdr, fm_uint size)
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "hdr=%p size=%d\n",
                  (void *) hdr, size);
 
+    /**************************************************
+     * Small sizes are found through the size class
+     * index. Only fall back to the list walk when the
+     * bucket doesn't exist yet.
+     **************************************************/
+    if (size <= FM_ALLOC_INDEXED_MAX_SIZE)
+    {
+        bucket = hdr->bucketIndex[SIZE_CLASS(size)];
+
+        if (bucket != NULL)
+        {
+            if (bucket->signature != BUCKET_SIGNATURE)
+            {
+                MemoryCorruptionWarning();
+                bucket = NULL;
+            }
+
+            goto ABORT;
+        }
+    }
+
     while ( ( *ptr != NULL ) && ( (*ptr)->size < size ) )
     {
         if ( (*ptr)->signature != BUCKET_SIGNATURE )
@@ -368,6 +516,11 @@ static fm_memoryBucket *GetBucket(fm_sharedHeader *hdr, fm_uint size)
         *ptr = bucket;
     }
 
+    if (size <= FM_ALLOC_INDEXED_MAX_SIZE)
+    {
+        hdr->bucketIndex[SIZE_CLASS(size)] = bucket;
+    }
+
 ABORT:
     FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
                  "Exiting... (bucket=%p)\n", (void *) bucket);
@@ -415,6 +568,41 @@ static void LockMutex(fm_sharedHeader *hdr)
 
 
 
+/*****************************************************************************/
+/** LockMutexCounted
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Lock the shared memory on behalf of fmAlloc or fmFree,
+ *                  recording whether another thread or process was
+ *                  holding it at the time.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \return          TRUE if the mutex was contended.
+ * \return          FALSE if it was acquired immediately.
+ *
+ *****************************************************************************/
+static fm_bool LockMutexCounted(fm_sharedHeader *hdr)
+{
+    fm_bool contended;
+
+    contended = ( pthread_mutex_trylock( &(hdr->mutex) ) != 0 );
+
+    if (contended)
+    {
+        LockMutex(hdr);
+        hdr->lockContentions++;
+    }
+
+    hdr->lockAcquisitions++;
+
+    return contended;
+
+}   /* end LockMutexCounted */
+
+
+
+
 /*****************************************************************************/
 /** UnlockMutex
  * \ingroup intAlosAlloc
@@ -525,6 +713,384 @@ static void UnlockRootMutex(fm_sharedHeader *hdr)
 
 
 
+#if FM_ALLOC_USE_MAGAZINES
+/*****************************************************************************/
+/** SyncMagazineStats
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Fold a magazine's lockless counters into the shared
+ *                  per size class statistics.
+ *
+ * \note            The caller must hold the shared memory mutex.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       bucket is the bucket the magazine caches objects for.
+ *
+ * \param[in,out]   magazine points to the magazine.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SyncMagazineStats(fm_sharedHeader * hdr,
+                              fm_memoryBucket * bucket,
+                              fm_allocMagazine *magazine)
+{
+    fm_allocClassStats *stats = &hdr->classStats[SIZE_CLASS(bucket->size)];
+
+    stats->magazineHits  += magazine->pendingHits;
+    stats->magazineFrees += magazine->pendingFrees;
+    stats->cached        += (fm_int64) magazine->pendingFrees -
+                            (fm_int64) magazine->pendingHits;
+
+    bucket->allocationRemainderBitmask |= magazine->pendingRemainderBitmask;
+
+    magazine->pendingHits             = 0;
+    magazine->pendingFrees            = 0;
+    magazine->pendingRemainderBitmask = 0;
+
+}   /* end SyncMagazineStats */
+
+
+
+
+/*****************************************************************************/
+/** FlushMagazine
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return objects from a thread magazine to the free list
+ *                  of the shared bucket.
+ *
+ * \note            The caller must hold the shared memory mutex.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       size is the bucket size served by the magazine.
+ *
+ * \param[in,out]   magazine points to the magazine.
+ *
+ * \param[in]       numObjects is the number of objects to return.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FlushMagazine(fm_sharedHeader * hdr,
+                          fm_uint           size,
+                          fm_allocMagazine *magazine,
+                          fm_uint           numObjects)
+{
+    fm_memoryBucket *bucket;
+    void *           obj;
+    fm_uint          i;
+
+    bucket = hdr->bucketIndex[SIZE_CLASS(size)];
+
+    if ( (bucket == NULL) || (bucket->signature != BUCKET_SIGNATURE) )
+    {
+        MemoryCorruptionWarning();
+        return;
+    }
+
+    SyncMagazineStats(hdr, bucket, magazine);
+
+    if (numObjects > magazine->count)
+    {
+        numObjects = magazine->count;
+    }
+
+    for (i = 0 ; i < numObjects ; i++)
+    {
+        obj              = magazine->objects[--magazine->count];
+        *(void **) obj   = bucket->freeList;
+        bucket->freeList = obj;
+    }
+
+    hdr->classStats[SIZE_CLASS(size)].flushes++;
+    hdr->classStats[SIZE_CLASS(size)].cached -= numObjects;
+
+}   /* end FlushMagazine */
+
+
+
+
+/*****************************************************************************/
+/** RefillMagazine
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Move a batch of objects from the shared bucket into an
+ *                  empty thread magazine, carving new objects out of the
+ *                  never-allocated space if the bucket's free list runs
+ *                  dry.
+ *
+ * \note            The caller must hold the shared memory mutex.
+ *
+ * \param[in]       hdr points to the shared memory header.
+ *
+ * \param[in]       bucket is the bucket to refill from.
+ *
+ * \param[in,out]   magazine points to the magazine.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RefillMagazine(fm_sharedHeader * hdr,
+                           fm_memoryBucket * bucket,
+                           fm_allocMagazine *magazine)
+{
+    fm_objectHeader *objHdr;
+    unsigned char *  ptr;
+    void *           obj;
+    fm_uint          numObjects;
+
+    SyncMagazineStats(hdr, bucket, magazine);
+
+    for (numObjects = 0 ; numObjects < FM_ALLOC_MAGAZINE_BATCH ; numObjects++)
+    {
+        obj = bucket->freeList;
+
+        if (obj != NULL)
+        {
+            bucket->freeList = *(void **) obj;
+        }
+        else
+        {
+            ptr = hdr->freeSpace;
+
+            if ( (void *) (ptr + (fm_uintptr)bucket->size) >
+                 (void *) ((fm_uintptr)FM_SHARED_MEMORY_ADDR +
+                           (fm_uintptr)FM_SHARED_MEMORY_SIZE) )
+            {
+                /* Out of space */
+                break;
+            }
+
+            objHdr           = (fm_objectHeader *) ptr;
+            objHdr->myBucket = bucket;
+            obj              = ptr + sizeof(fm_objectHeader);
+            hdr->freeSpace   = ptr + bucket->size;
+        }
+
+        magazine->objects[magazine->count++] = obj;
+    }
+
+    hdr->classStats[SIZE_CLASS(bucket->size)].refills++;
+    hdr->classStats[SIZE_CLASS(bucket->size)].cached += numObjects;
+
+}   /* end RefillMagazine */
+
+
+
+
+/*****************************************************************************/
+/** DestroyThreadCache
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return all objects held in a thread's magazines to the
+ *                  shared buckets. Called on thread exit as a result of
+ *                  having registered this function with pthread_key_create.
+ *
+ * \param[in]       value is the thread's fm_allocThreadCache.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DestroyThreadCache(void *value)
+{
+    fm_allocThreadCache *cache = value;
+    fm_sharedHeader *    hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
+    fm_allocMagazine *   magazine;
+    fm_memoryBucket *    bucket;
+    fm_uint              i;
+
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    if (cache->forkGeneration == forkGeneration)
+    {
+        LockMutex(hdr);
+
+        for (i = 0 ; i < FM_ALLOC_NUM_MAGAZINES ; i++)
+        {
+            magazine = &cache->magazines[i];
+            bucket   = hdr->bucketIndex[i];
+
+            if (bucket == NULL)
+            {
+                continue;
+            }
+
+            if (magazine->count > 0)
+            {
+                FlushMagazine(hdr, bucket->size, magazine, magazine->count);
+            }
+            else
+            {
+                SyncMagazineStats(hdr, bucket, magazine);
+            }
+        }
+
+        UnlockMutex(hdr);
+    }
+
+    free(cache);
+
+}   /* end DestroyThreadCache */
+
+
+
+
+/*****************************************************************************/
+/** ThreadCacheAfterFork
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Invalidate the magazines inherited by a child process.
+ *                  The objects they hold are still owned by the parent's
+ *                  thread, so the child simply forgets them.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ThreadCacheAfterFork(void)
+{
+    forkGeneration++;
+
+}   /* end ThreadCacheAfterFork */
+
+
+
+
+/*****************************************************************************/
+/** ShutdownThreadCaches
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Flush the magazines of the thread that exits the process.
+ *                  Thread specific destructors do not run for the thread
+ *                  calling exit (normally the main thread), so without this
+ *                  its cached objects would never be returned to the shared
+ *                  buckets. Magazines are disabled afterwards, so frees made
+ *                  by later exit handlers go straight to the buckets.
+ *                  Registered with atexit.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ShutdownThreadCaches(void)
+{
+    fm_allocThreadCache *cache;
+
+    threadCachesShutdown = TRUE;
+
+    cache = pthread_getspecific(threadCacheKey);
+
+    if (cache != NULL)
+    {
+        pthread_setspecific(threadCacheKey, NULL);
+        DestroyThreadCache(cache);
+    }
+
+}   /* end ShutdownThreadCaches */
+
+
+
+
+/*****************************************************************************/
+/** CreateThreadCacheKey
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Create the thread local storage key for the magazines.
+ *                  Called once per process.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CreateThreadCacheKey(void)
+{
+    if (pthread_key_create(&threadCacheKey, DestroyThreadCache) == 0)
+    {
+        pthread_atfork(NULL, NULL, ThreadCacheAfterFork);
+        atexit(ShutdownThreadCaches);
+        threadCacheKeyValid = TRUE;
+    }
+
+}   /* end CreateThreadCacheKey */
+
+
+
+
+/*****************************************************************************/
+/** GetMagazine
+ * \ingroup intAlosAlloc
+ *
+ * \desc            Return the calling thread's magazine for the given
+ *                  bucket size, creating the thread's cache if needed.
+ *
+ * \param[in]       size is the bucket size (including the object header).
+ *
+ * \return          Pointer to the magazine, or NULL if objects of this size
+ *                  are not cached per thread.
+ *
+ *****************************************************************************/
+static fm_allocMagazine *GetMagazine(fm_uint size)
+{
+    fm_allocThreadCache *cache;
+
+    if (size > FM_ALLOC_MAGAZINE_MAX_SIZE)
+    {
+        return NULL;
+    }
+
+    pthread_once(&threadCacheOnce, CreateThreadCacheKey);
+
+    if (!threadCacheKeyValid || threadCachesShutdown)
+    {
+        return NULL;
+    }
+
+    cache = pthread_getspecific(threadCacheKey);
+
+    if ( (cache != NULL) && (cache->forkGeneration != forkGeneration) )
+    {
+        /* Inherited across fork; the objects belong to the parent. */
+        FM_CLEAR(*cache);
+        cache->forkGeneration = forkGeneration;
+    }
+
+    if (cache == NULL)
+    {
+        /* Process-local, so use the system allocator. */
+        cache = calloc( 1, sizeof(fm_allocThreadCache) );
+
+        if (cache == NULL)
+        {
+            return NULL;
+        }
+
+        cache->forkGeneration = forkGeneration;
+
+        if (pthread_setspecific(threadCacheKey, cache) != 0)
+        {
+            free(cache);
+            return NULL;
+        }
+    }
+
+    return &cache->magazines[SIZE_CLASS(size)];
+
+}   /* end GetMagazine */
+
+
+
+
+#endif  /* FM_ALLOC_USE_MAGAZINES */
+
 #if MEMORY_DEBUG_CALLER
 static void DeleteCallerInfo(void *p)
 {
@@ -565,6 +1131,7 @@ void *fmAlloc(fm_uint size)
     fm_uint          unroundedSize;
     unsigned char *  ptr;
     void *           newObject = NULL;
+    fm_bool          contended;
 
 #ifdef FM_HAVE_VALGRIND
     fm_memoryBucket *it;
@@ -577,6 +1144,10 @@ void *fmAlloc(fm_uint size)
 #endif
 #endif
 
+#if FM_ALLOC_USE_MAGAZINES
+    fm_allocMagazine *magazine;
+#endif
+
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "size=%d\n", size);
 
     if (size == 0)
@@ -593,18 +1164,75 @@ void *fmAlloc(fm_uint size)
                            FM_SHARED_MEMORY_SIZE);
     }
 
-    LockMutex(hdr);
+    originalSize  = size;
+    size         += sizeof(fm_objectHeader);
+    unroundedSize = size;
+    size          = ROUND_UP(size);
+
+#if FM_ALLOC_USE_MAGAZINES
+    /**************************************************
+     * Small objects come from the calling thread's
+     * magazine when it has one available, without
+     * touching the shared memory mutex.
+     **************************************************/
+    magazine = GetMagazine(size);
+
+    if (magazine != NULL)
+    {
+        if (magazine->count > 0)
+        {
+            newObject = magazine->objects[--magazine->count];
+            magazine->pendingHits++;
+            magazine->pendingRemainderBitmask |= 1 << (size - unroundedSize);
+
+            FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
+                         "Exiting... (object=%p)\n", newObject);
+
+            return newObject;
+        }
+
+        contended = LockMutexCounted(hdr);
+
+        bucket = GetBucket(hdr, size);
+
+        if (bucket != NULL)
+        {
+            hdr->classStats[SIZE_CLASS(size)].contended += contended;
+
+            RefillMagazine(hdr, bucket, magazine);
+
+            if (magazine->count > 0)
+            {
+                newObject = magazine->objects[--magazine->count];
+                bucket->allocationRemainderBitmask |=
+                    1 << (size - unroundedSize);
+                hdr->classStats[SIZE_CLASS(size)].cached--;
+            }
+        }
+
+        UnlockMutex(hdr);
+
+        FM_LOG_DEBUG(FM_LOG_CAT_ALOS,
+                     "Exiting... (object=%p)\n", newObject);
+
+        return newObject;
+    }
+#endif
+
+    contended = LockMutexCounted(hdr);
 
 #ifdef FM_HAVE_VALGRIND
     /* Temporarily whitelist access to the memory bucket linked list. */
     FM_VALGRIND_MAKE_BUCKET_MEM_DEFINED(hdr, it);
 #endif
 
-    originalSize  = size;
-    size         += sizeof(fm_objectHeader);
-    unroundedSize = size;
-    size          = ROUND_UP(size);
-    bucket        = GetBucket(hdr, size);
+    bucket = GetBucket(hdr, size);
+
+    if ( (bucket != NULL) && (size <= FM_ALLOC_INDEXED_MAX_SIZE) )
+    {
+        hdr->classStats[SIZE_CLASS(size)].lockedAllocs++;
+        hdr->classStats[SIZE_CLASS(size)].contended += contended;
+    }
 
     if (bucket != NULL)
     {
@@ -729,6 +1357,11 @@ void fmFree(void *obj)
     fm_objectHeader *objHdr;
     fm_sharedHeader *hdr = (fm_sharedHeader *) FM_SHARED_MEMORY_ADDR;
     unsigned char *  ptr;
+    fm_bool          contended;
+
+#if FM_ALLOC_USE_MAGAZINES
+    fm_allocMagazine *magazine;
+#endif
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "object=%p\n", obj);
 
@@ -749,7 +1382,40 @@ void fmFree(void *obj)
     }
     else
     {
-        LockMutex(hdr);
+#if FM_ALLOC_USE_MAGAZINES
+        /**************************************************
+         * Small objects go back to the calling thread's
+         * magazine. Only a full magazine needs the shared
+         * memory mutex, to return half of it to the bucket.
+         **************************************************/
+        objHdr = (fm_objectHeader *) ( (unsigned char *) obj -
+                                       sizeof(fm_objectHeader) );
+        bucket = objHdr->myBucket;
+
+        if ( IN_SHARED_MEMORY(bucket) &&
+             (bucket->signature == BUCKET_SIGNATURE) &&
+             ( ( magazine = GetMagazine(bucket->size) ) != NULL ) )
+        {
+            if (magazine->count >= FM_ALLOC_MAGAZINE_DEPTH)
+            {
+                contended = LockMutexCounted(hdr);
+                hdr->classStats[SIZE_CLASS(bucket->size)].contended +=
+                    contended;
+                FlushMagazine(hdr,
+                              bucket->size,
+                              magazine,
+                              FM_ALLOC_MAGAZINE_BATCH);
+                UnlockMutex(hdr);
+            }
+
+            magazine->objects[magazine->count++] = obj;
+            magazine->pendingFrees++;
+
+            return;
+        }
+#endif
+
+        contended = LockMutexCounted(hdr);
 
         ptr = obj;
         ptr -= sizeof(fm_objectHeader);
@@ -772,6 +1438,13 @@ void fmFree(void *obj)
         {
             *(void **) obj   = bucket->freeList;
             bucket->freeList = obj;
+
+            if (bucket->size <= FM_ALLOC_INDEXED_MAX_SIZE)
+            {
+                hdr->classStats[SIZE_CLASS(bucket->size)].lockedFrees++;
+                hdr->classStats[SIZE_CLASS(bucket->size)].contended +=
+                    contended;
+            }
 #if MEMORY_DEBUG_CALLER
             objHdr->caller = NULL;
 #if DBG_FULL_CALLER_DEPTH
@@ -832,8 +1505,12 @@ void fmDbgDumpAllocStats(void)
     fm_uint          freed = 0;
     fm_uint          managed;
     fm_uint          bucketSpace;
+    fm_uint          cached = 0;
     fm_rootInfo *    rootInfo;
     FILE *           f;
+    fm_allocClassStats *stats;
+    fm_uint64        hits;
+    fm_uint64        requests;
 
 #ifdef FM_HAVE_VALGRIND
     fm_memoryBucket *it;
@@ -989,6 +1666,21 @@ void fmDbgDumpAllocStats(void)
 
         used = total - unused;
 
+        if (bucket->size <= FM_ALLOC_INDEXED_MAX_SIZE)
+        {
+            stats = &hdr->classStats[SIZE_CLASS(bucket->size)];
+
+            if ( (stats->cached > 0) && ( (fm_uint) stats->cached <= used ) )
+            {
+                used   -= (fm_uint) stats->cached;
+                cached += (fm_uint) stats->cached * size;
+            }
+        }
+        else
+        {
+            stats = NULL;
+        }
+
         buf     = requested;
         bufSize = sizeof(requested);
         *buf    = 0;
@@ -1019,6 +1711,30 @@ void fmDbgDumpAllocStats(void)
         FM_LOG_PRINT("Bucket size %u: %u used/%u total (Requested sizes: %s)\n",
                      size, used, total, requested);
 
+        if (stats != NULL)
+        {
+            hits     = stats->magazineHits;
+            requests = stats->magazineHits + stats->refills +
+                       stats->lockedAllocs;
+
+            FM_LOG_PRINT("    magazine: %lld cached, %llu/%llu alloc hits "
+                         "(%llu%%), %llu free hits, %llu refills, "
+                         "%llu flushes\n",
+                         (long long) stats->cached,
+                         (unsigned long long) hits,
+                         (unsigned long long) requests,
+                         (unsigned long long) ( requests ? (hits * 100) / requests
+                                                         : 0 ),
+                         (unsigned long long) stats->magazineFrees,
+                         (unsigned long long) stats->refills,
+                         (unsigned long long) stats->flushes);
+            FM_LOG_PRINT("    shared:   %llu allocs, %llu frees, "
+                         "%llu contended\n",
+                         (unsigned long long) stats->lockedAllocs,
+                         (unsigned long long) stats->lockedFrees,
+                         (unsigned long long) stats->contended);
+        }
+
 #if MEMORY_DEBUG_CALLER
         fmTreeIterInit(&ti, &treeOfCallers);
 
@@ -1073,11 +1789,15 @@ void fmDbgDumpAllocStats(void)
 
     FM_LOG_PRINT("\n");
     FM_LOG_PRINT("Currently allocated: %u bytes\n",
-                 managed - freed - overhead - bucketSpace);
+                 managed - freed - cached - overhead - bucketSpace);
     FM_LOG_PRINT("Free but previously allocated: %u bytes\n", freed);
+    FM_LOG_PRINT("Free in thread magazines: %u bytes\n", cached);
     FM_LOG_PRINT("Overhead: %u bytes\n", overhead);
     FM_LOG_PRINT("BucketSpace: %u bytes\n", bucketSpace);
     FM_LOG_PRINT("Never allocated: %u bytes\n", FM_SHARED_MEMORY_SIZE - managed);
+    FM_LOG_PRINT("Mutex acquisitions: %llu (%llu contended)\n",
+                 (unsigned long long) hdr->lockAcquisitions,
+                 (unsigned long long) hdr->lockContentions);
     FM_LOG_PRINT("\n");
 
     buf     = requested;
@@ -1294,6 +2014,16 @@ void fmGetAllocatedMemorySize(fm_uint32 *allocMemory)
         size     = bucket->size - sizeof(fm_objectHeader);
         freeList = bucket->freeList;
 
+        /**************************************************
+         * Objects parked in thread magazines are free too
+         **************************************************/
+        if ( (bucket->size <= FM_ALLOC_INDEXED_MAX_SIZE) &&
+             (hdr->classStats[SIZE_CLASS(bucket->size)].cached > 0) )
+        {
+            freed += (fm_uint) hdr->classStats[SIZE_CLASS(bucket->size)].cached
+                     * size;
+        }
+
         /**************************************************
          * Count the amount of free space on this bucket's freelist
          **************************************************/
@@ -1810,6 +2540,13 @@ fm_status fmMemInitialize(void)
         hdr->bucketBucket.next     = NULL;
         hdr->buckets               = &(hdr->bucketBucket);
 
+        FM_CLEAR(hdr->bucketIndex);
+        FM_CLEAR(hdr->classStats);
+        hdr->bucketIndex[SIZE_CLASS(hdr->bucketBucket.size)] =
+            &(hdr->bucketBucket);
+        hdr->lockAcquisitions = 0;
+        hdr->lockContentions  = 0;
+
         offset = sizeof(fm_sharedHeader);
 
         while ( ( ( offset + sizeof(fm_objectHeader) ) & 7 ) != 0 )
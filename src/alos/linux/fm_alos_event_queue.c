@@ -37,6 +37,12 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Packing of the event stack top */
+#define STACK_TOP_INDEX(top)        ( (fm_uint32) ( (top) & 0xFFFFFFFF ) )
+#define STACK_TOP_TAG(top)          ( (fm_uint32) ( (top) >> 32 ) )
+#define STACK_TOP(tag, index)       ( ( ( (fm_uint64) (tag) ) << 32 ) | \
+                                      (fm_uint64) (index) )
+
 
 /*****************************************************************************
  * Global Variables
@@ -58,6 +64,70 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** HistogramBucket
+ * \ingroup intAlosEvent
+ *
+ * \desc            Returns the log2 histogram bucket of a sample.
+ *
+ * \param[in]       value is the sample.
+ *
+ * \return          The bucket, the last one for all the samples beyond the
+ *                  histogram range.
+ *
+ *****************************************************************************/
+static fm_int HistogramBucket(fm_uint value)
+{
+    fm_int bucket;
+
+    for (bucket = 0 ;
+         (value > 1) && (bucket < FM_EVENT_QUEUE_HISTOGRAM_SIZE - 1) ;
+         bucket++)
+    {
+        value >>= 1;
+    }
+
+    return bucket;
+
+}   /* end HistogramBucket */
+
+
+
+
+/*****************************************************************************/
+/** UpdatePostStats
+ * \ingroup intAlosEvent
+ *
+ * \desc            Updates the debug counters of a queue for a posted event.
+ *                  May be called concurrently by several producers.
+ *
+ * \param[in]       q is the pointer to the event queue.
+ *
+ * \param[in]       depth is the queue depth including the posted event.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UpdatePostStats(fm_eventQueue *q, fm_int depth)
+{
+    fm_int maxSize;
+
+    __sync_fetch_and_add(&q->totalEventsPosted, 1);
+    __sync_fetch_and_add(&q->depthHistogram[HistogramBucket(depth)], 1);
+
+    maxSize = q->maxSize;
+
+    while ( (depth > maxSize) &&
+            !__sync_bool_compare_and_swap(&q->maxSize, maxSize, depth) )
+    {
+        maxSize = q->maxSize;
+    }
+
+}   /* end UpdatePostStats */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -83,29 +153,42 @@
 fm_status fmEventQueueInitialize(fm_eventQueue *q, int maxSize, fm_text qName)
 {
     fm_status err;
-    fm_bool   lockInit;
+    fm_uint32 ringSize;
+    fm_uint32 i;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS,
                  "queue=%p maxSize=%d name=%s\n",
                  (void *) q, maxSize, qName);
 
-    if (q == NULL)
+    if ( (q == NULL) || (maxSize <= 0) || (maxSize > 0x40000000) )
     {
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
     FM_CLEAR(*q);
 
-    lockInit = FALSE;
+    for (ringSize = 1 ; ringSize < (fm_uint32) maxSize ; ringSize <<= 1)
+    {
+    }
 
-    fmDListInit(&q->eventQueue);
+    q->ring = fmAlloc( ringSize * sizeof(fm_eventQueueSlot) );
 
-    err = fmCreateLock(qName, &q->accessLock);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS, err);
-    lockInit = TRUE;
+    if (q->ring == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
 
-    q->max  = maxSize;
-    q->name = fmStringDuplicate(qName);
+    /* Every slot starts out free for the first lap of the ring */
+    for (i = 0 ; i < ringSize ; i++)
+    {
+        q->ring[i].sequence = i;
+        q->ring[i].event    = NULL;
+    }
+
+    q->ringMask = ringSize - 1;
+    q->max      = maxSize;
+    q->name     = fmStringDuplicate(qName);
 
     if (q->name == NULL)
     {
@@ -125,9 +208,9 @@ ABORT:
         fmFree(q->name);
     }
 
-    if (lockInit)
+    if (q->ring)
     {
-        fmDeleteLock(&q->accessLock);
+        fmFree(q->ring);
     }
 
     FM_CLEAR(*q);
@@ -143,7 +226,8 @@ ABORT:
 /** fmEventQueueAdd
  * \ingroup intAlosEvent
  *
- * \desc            (blocking) enqueue an event
+ * \desc            (non-blocking) enqueue an event. May be called by any
+ *                  number of threads concurrently.
  *
  * \param[in]       q is the pointer to the event queue
  *
@@ -154,55 +238,56 @@ ABORT:
  *****************************************************************************/
 fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
 {
-    fm_status      err, rerr = FM_OK;
-    fm_dlist_node *eventNode; 
+    fm_eventQueueSlot *slot;
+    fm_uint32          pos;
+    fm_int             depth;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p event=%p\n",
                  (void *) q, (void *) event);
 
-    if (q->size == q->max)
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_EVENT_QUEUE_FULL);
-    }
+    /**************************************************
+     * Reserve an entry first. Since the consumer only
+     * gives an entry back after releasing its slot,
+     * the slot at the position we claim below is
+     * always free, or about to be.
+     **************************************************/
+
+    depth = __sync_add_and_fetch(&q->size, 1);
 
-    /* Timeout not implememented, so we block forever if we deadlock */
-    if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
+    if (depth > q->max)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+        __sync_fetch_and_sub(&q->size, 1);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_EVENT_QUEUE_FULL);
     }
 
 #ifdef ENABLE_EVENTQ_TIMESTAMP
     /* Don't enable by default, slow down packet delivery */
     if (fmGetTime(&event->postedTimestamp) != 0)
     {
-        rerr = FM_ERR_BAD_GETTIME;
+        __sync_fetch_and_sub(&q->size, 1);
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_BAD_GETTIME);
     }
-    else
 #endif
-    {
-        if ( ( err = fmDListInsertEndV2(&q->eventQueue, 
-                                        event, 
-                                        &eventNode) ) == FM_OK )
-        {
-            q->totalEventsPosted++;
-            q->size++;
-            q->maxSize = q->size > q->maxSize ? q->size : q->maxSize; 
 
-            event->q = q;
-            event->node = eventNode; 
-        }
-        else
-        {
-            rerr = err;
-        }
-    }
+    pos  = __sync_fetch_and_add(&q->tail, 1);
+    slot = &q->ring[pos & q->ringMask];
 
-    if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
+    while (slot->sequence != pos)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+        fmYield();
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_ALOS, rerr);
+    event->q    = q;
+    slot->event = event;
+
+    /* The event must be visible before the slot is marked full */
+    __sync_synchronize();
+
+    slot->sequence = pos + 1;
+
+    UpdatePostStats(q, depth);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
 }   /* end fmEventQueueAdd */
 
@@ -213,7 +298,11 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
 /** fmEventQueueGet
  * \ingroup intAlosEvent
  *
- * \desc            (blocking) get the next event
+ * \desc            (non-blocking) get the next event. Must only be called
+ *                  by the thread owning the queue.
+ *
+ * \note            An event whose post is still in progress is not seen.
+ *                  The poster wakes the owner up once the post completes.
  *
  * \param[in]       q is the pointer to the event queue
  *
@@ -224,8 +313,9 @@ fm_status fmEventQueueAdd(fm_eventQueue *q, fm_event *event)
  *****************************************************************************/
 fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
 {
-    fm_status err;
-    fm_event *ev;
+    fm_eventQueueSlot *slot;
+    fm_uint32          pos;
+    fm_event *         ev;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p event=%p\n",
                  (void *) q, (void *) eventPtr);
@@ -235,57 +325,46 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
-    /* Timeout not implememented, so we block forever if we deadlock */
-    if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-    }
+    pos  = q->head;
+    slot = &q->ring[pos & q->ringMask];
 
-    ev = (fm_event *) fmDListRemove(&q->eventQueue, q->eventQueue.head);
-
-    if (ev)
+    if (slot->sequence != pos + 1)
     {
-        /* record the time of its removal before notifying debug. */
-#ifdef ENABLE_EVENTQ_TIMESTAMP
-        fmGetTime(&ev->poppedTimestamp);
-#endif
-
-        *eventPtr = ev;
-        q->size--;
-#ifdef ENABLE_EVENTQ_TIMESTAMP
-        fmDbgEventQueueEventPopped(q, ev);
-#endif
-
-        ev->q    = NULL;
-        ev->node = NULL;
-    }
-    else
-    {
-        *eventPtr = NULL;
-
         /**************************************************
          * The event queue is empty, this an error condiion 
-         * Release the event queue access lock then increase 
-         * the appropriate diagnostic counter, which requires 
-         * the debug lock to be taken 
+         * Increase the appropriate diagnostic counter,
+         * which requires the debug lock to be taken 
          ***************************************************/
 
-        err = fmReleaseLock(&q->accessLock);
+        *eventPtr = NULL;
 
         fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_NO_EVENTS_AVAILABLE, 1);
 
-        if ( err != FM_OK )
-        {
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-        }
-
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NO_EVENTS_AVAILABLE);
     }
 
-    if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-    }
+    /* Don't read the event before the slot is seen full */
+    __sync_synchronize();
+
+    ev          = slot->event;
+    slot->event = NULL;
+
+    /* Hand the slot over to the producers of the next lap of the ring */
+    __sync_synchronize();
+
+    slot->sequence = pos + q->ringMask + 1;
+    q->head        = pos + 1;
+
+    __sync_fetch_and_sub(&q->size, 1);
+
+    /* record the time of its removal before notifying debug. */
+#ifdef ENABLE_EVENTQ_TIMESTAMP
+    fmGetTime(&ev->poppedTimestamp);
+    fmDbgEventQueueEventPopped(q, ev);
+#endif
+
+    ev->q     = NULL;
+    *eventPtr = ev;
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
@@ -298,7 +377,8 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
 /** fmEventQueuePeek
  * \ingroup intAlosEvent
  *
- * \desc            peek the next event
+ * \desc            peek the next event. Must only be called by the thread
+ *                  owning the queue.
  *
  * \param[in]       q is the pointer to the event queue
  *
@@ -309,8 +389,8 @@ fm_status fmEventQueueGet(fm_eventQueue *q, fm_event **eventPtr)
  *****************************************************************************/
 fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr)
 {
-    fm_status err;
-    fm_event *ev;
+    fm_eventQueueSlot *slot;
+    fm_uint32          pos;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p event=%p\n",
                  (void *) q, (void *) eventPtr);
@@ -320,33 +400,18 @@ fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr)
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
-    /* Timeout not implememented, so we block forever if we deadlock */
-    if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-    }
+    pos  = q->head;
+    slot = &q->ring[pos & q->ringMask];
 
-    if (q->eventQueue.head)
-    {
-        ev        = (fm_event *) q->eventQueue.head->data;
-        *eventPtr = ev;
-    }
-    else
+    if (slot->sequence != pos + 1)
     {
         *eventPtr = NULL;
-
-        if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
-        {
-            FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-        }
-
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NO_EVENTS_AVAILABLE);
     }
 
-    if ( ( err = fmReleaseLock(&q->accessLock) ) != FM_OK )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-    }
+    __sync_synchronize();
+
+    *eventPtr = slot->event;
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
@@ -368,22 +433,16 @@ fm_status fmEventQueuePeek(fm_eventQueue *q, fm_event **eventPtr)
  *****************************************************************************/
 fm_status fmEventQueueDestroy(fm_eventQueue *q)
 {
-    fm_status err;
-
     FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p\n", (void *) q);
 
     /* Notify debug system first */
     fmDbgEventQueueDestroyed(q);
 
-    if ( ( err = fmDeleteLock(&q->accessLock) ) != FM_OK )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
-    }
-
     fmFree(q->name);
     q->name = NULL;
 
-    fmDListFree(&q->eventQueue);
+    fmFree(q->ring);
+    q->ring = NULL;
 
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
 
@@ -421,65 +480,266 @@ fm_status fmEventQueueCount(fm_eventQueue *q, fm_int *eventCount)
 
 
 /*****************************************************************************/
-/** fmEventQueueRemove
+/** fmEventStackInitialize
  * \ingroup intAlosEvent
  *
- * \desc            (blocking) Remove the event from the queue
+ * \desc            (non-blocking) initializes an empty event stack
  *
- * \param[in]       q is the pointer to the event queue
+ * \note            should be only done once
+ *
+ * \param[in]       stack is the pointer to the event stack to initialize
+ *
+ * \param[in]       maxSize is the number of events in the pool, the events
+ *                  pushed on the stack having pool indexes 0 to maxSize - 1
  *
- * \param[in]       eventPtr is the pointer to event to be removed.
+ * \param[in]       name is the name of the stack, for debugging purposes
  *
  * \return          Status code
  *
  *****************************************************************************/
-fm_status fmEventQueueRemove(fm_eventQueue *q, 
-                             fm_event *eventPtr)
+fm_status fmEventStackInitialize(fm_eventStack *stack,
+                                 fm_int         maxSize,
+                                 fm_text        name)
 {
-    fm_status      err;
-    fm_event      *ev;
-    fm_dlist_node *eventNode;
+    fm_status err;
 
-    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "queue=%p eventPtr=%p\n",
-                 (void *) q, (void *)eventPtr);
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS,
+                 "stack=%p maxSize=%d name=%s\n",
+                 (void *) stack, maxSize, name);
 
-    if (eventPtr == NULL || q == NULL)
+    if ( (stack == NULL) || (maxSize <= 0) )
     {
         FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
     }
 
+    FM_CLEAR(*stack);
+
+    stack->events = fmAlloc( maxSize * sizeof(fm_event *) );
+    stack->next   = fmAlloc( maxSize * sizeof(fm_uint32) );
+    stack->name   = fmStringDuplicate(name);
 
-    if ( ( err = fmCaptureLock(&q->accessLock, FM_WAIT_FOREVER) ) != FM_OK )
+    if ( (stack->events == NULL) ||
+         (stack->next == NULL) ||
+         (stack->name == NULL) )
     {
-        FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
     }
-    
-    eventNode = eventPtr->node;
-    
-    if (eventNode == NULL || eventPtr->q != q)
-    {
-        err = FM_ERR_NO_MORE;
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ALOS, err);
-    } 
 
-    ev = (fm_event *) fmDListRemove(&q->eventQueue, eventNode);
-    if (ev)
+    FM_MEMSET_S(stack->events,
+                maxSize * sizeof(fm_event *),
+                0,
+                maxSize * sizeof(fm_event *));
+    FM_MEMSET_S( (void *) stack->next,
+                 maxSize * sizeof(fm_uint32),
+                 0,
+                 maxSize * sizeof(fm_uint32) );
+
+    stack->max     = maxSize;
+    stack->minSize = maxSize;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+ABORT:
+
+    if (stack->events)
     {
-        q->size--;
-        ev->node = NULL;
-        ev->q    = NULL;
+        fmFree(stack->events);
     }
-    else
+
+    if (stack->next)
     {
-        err = FM_ERR_NO_EVENTS_AVAILABLE; 
+        fmFree( (void *) stack->next );
     }
 
-ABORT:
-    if ( fmReleaseLock(&q->accessLock) != FM_OK )
+    if (stack->name)
     {
-        FM_LOG_FATAL(FM_LOG_CAT_ALOS, "Releasing event queue lock failed\n");
+        fmFree(stack->name);
     }
 
+    FM_CLEAR(*stack);
+
     FM_LOG_EXIT(FM_LOG_CAT_ALOS, err);
 
-}   /* end fmEventQueueRemove */
+}   /* end fmEventStackInitialize */
+
+
+
+
+/*****************************************************************************/
+/** fmEventStackPush
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) pushes an event on the stack. May be
+ *                  called by any number of threads concurrently.
+ *
+ * \param[in]       stack is the pointer to the event stack
+ *
+ * \param[in]       event is the pointer to the event, whose poolIndex
+ *                  identifies it within the stack
+ *
+ * \return          Status code
+ *
+ *****************************************************************************/
+fm_status fmEventStackPush(fm_eventStack *stack, fm_event *event)
+{
+    fm_uint64 top;
+    fm_uint32 index;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "stack=%p event=%p\n",
+                 (void *) stack, (void *) event);
+
+    if ( (event == NULL) ||
+         (event->poolIndex < 0) ||
+         (event->poolIndex >= stack->max) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    index = (fm_uint32) event->poolIndex;
+
+    stack->events[index] = event;
+
+    do
+    {
+        top = stack->top;
+        stack->next[index] = STACK_TOP_INDEX(top);
+    }
+    while ( !__sync_bool_compare_and_swap(&stack->top,
+                                          top,
+                                          STACK_TOP(STACK_TOP_TAG(top) + 1,
+                                                    index + 1)) );
+
+    __sync_fetch_and_add(&stack->size, 1);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmEventStackPush */
+
+
+
+
+/*****************************************************************************/
+/** fmEventStackPop
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) pops the event on top of the stack. May be
+ *                  called by any number of threads concurrently.
+ *
+ * \param[in]       stack is the pointer to the event stack
+ *
+ * \param[out]      eventPtr is a pointer to storage for the event pointer
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_EVENTS_AVAILABLE if the stack is empty.
+ *
+ *****************************************************************************/
+fm_status fmEventStackPop(fm_eventStack *stack, fm_event **eventPtr)
+{
+    fm_uint64 top;
+    fm_uint32 index;
+    fm_int    size;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "stack=%p event=%p\n",
+                 (void *) stack, (void *) eventPtr);
+
+    if (eventPtr == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /**************************************************
+     * The next link read here may be stale if another
+     * thread pops and pushes the top event meanwhile,
+     * but the tag then no longer matches and the swap
+     * fails.
+     **************************************************/
+
+    do
+    {
+        top   = stack->top;
+        index = STACK_TOP_INDEX(top);
+
+        if (index == 0)
+        {
+            *eventPtr = NULL;
+
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_NO_EVENTS_AVAILABLE, 1);
+
+            FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_ERR_NO_EVENTS_AVAILABLE);
+        }
+    }
+    while ( !__sync_bool_compare_and_swap(&stack->top,
+                                          top,
+                                          STACK_TOP(STACK_TOP_TAG(top) + 1,
+                                                    stack->next[index - 1])) );
+
+    size = __sync_sub_and_fetch(&stack->size, 1);
+
+    if (size < stack->minSize)
+    {
+        stack->minSize = size;
+    }
+
+    *eventPtr = stack->events[index - 1];
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmEventStackPop */
+
+
+
+
+/*****************************************************************************/
+/** fmEventStackCount
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) returns the number of events currently
+ *                  on the stack
+ *
+ * \param[in]       stack is the pointer to the event stack
+ *
+ * \param[in]       eventCount points to where the count should be stored
+ *
+ * \return          Status code
+ *
+ *****************************************************************************/
+fm_status fmEventStackCount(fm_eventStack *stack, fm_int *eventCount)
+{
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "stack=%p count=%p\n",
+                 (void *) stack, (void *) eventCount);
+
+    *eventCount = stack->size;
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmEventStackCount */
+
+
+
+
+/*****************************************************************************/
+/** fmEventStackDestroy
+ * \ingroup intAlosEvent
+ *
+ * \desc            (non-blocking) cleans up the stack. The events themselves
+ *                  are owned by the caller.
+ *
+ * \param[in]       stack is the pointer to the event stack
+ *
+ * \return          Status code
+ *
+ *****************************************************************************/
+fm_status fmEventStackDestroy(fm_eventStack *stack)
+{
+    FM_LOG_ENTRY(FM_LOG_CAT_ALOS, "stack=%p\n", (void *) stack);
+
+    fmFree(stack->events);
+    fmFree( (void *) stack->next );
+    fmFree(stack->name);
+
+    FM_CLEAR(*stack);
+
+    FM_LOG_EXIT(FM_LOG_CAT_ALOS, FM_OK);
+
+}   /* end fmEventStackDestroy */
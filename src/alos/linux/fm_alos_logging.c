@@ -43,20 +43,195 @@
 #define GET_LOGGING_STATE() \
     ((fmRootAlos) ? &fmRootAlos->fmLoggingState : NULL);
 
+/* Size in bytes of each thread's asynchronous logging ring. Must be a
+ * power of two. */
+#define FM_LOG_ASYNC_RING_SIZE      65536
+
+/* Largest record, including its header and copied string arguments. */
+#define FM_LOG_ASYNC_MAX_RECORD     1024
+
+/* Maximum number of threads with a ring. Further threads log in place. */
+#define FM_LOG_ASYNC_MAX_RINGS      256
+
+/* Interval at which the drainer thread empties the rings. */
+#define FM_LOG_ASYNC_DRAIN_NSEC     10000000
+
+/* Length of a formatted deferred message. */
+#define FM_LOG_ASYNC_MAX_TEXT       1024
+
+/* Appended to a deferred message that had to be cut. */
+#define FM_LOG_ASYNC_CUT_MARK       "...\n"
+
+/* String argument slot length marking a NULL pointer. */
+#define FM_LOG_ASYNC_NULL_STRING    0xffffffffU
+
+/* Length modifiers of a printf conversion. */
+typedef enum
+{
+    LOG_ARG_LEN_NONE = 0,
+    LOG_ARG_LEN_HH,
+    LOG_ARG_LEN_H,
+    LOG_ARG_LEN_L,
+    LOG_ARG_LEN_LL,
+    LOG_ARG_LEN_J,
+    LOG_ARG_LEN_Z,
+    LOG_ARG_LEN_T,
+    LOG_ARG_LEN_LONG_DOUBLE,
+
+} fm_logArgLength;
+
+/* One printf conversion specification, as parsed from a format string. */
+typedef struct
+{
+    /* Points to the flag characters following the '%'. */
+    const char *    flags;
+    fm_int          numFlags;
+
+    /* Literal width and precision digits, or '*' markers. */
+    const char *    width;
+    fm_int          widthLen;
+    fm_bool         widthArg;
+
+    const char *    precision;
+    fm_int          precisionLen;
+    fm_bool         hasPrecision;
+    fm_bool         precisionArg;
+
+    fm_logArgLength length;
+
+    /* The conversion character, e.g. 'd' or 's'. */
+    fm_char         conversion;
+
+} fm_logConversion;
+
+/* Header of a deferred log message. The arguments follow it as 8-byte
+ * slots; a string argument is a length slot followed by its bytes, padded
+ * to 8 bytes. */
+typedef struct
+{
+    /* Size of the record in bytes, including this header, a multiple of
+     * 8. Zero marks the unused tail of the ring before it wraps. */
+    fm_uint32    size;
+
+    fm_uint32    srcLine;
+    fm_uint64    logLevel;
+
+    /* The call site. The format is NULL if the message could not be
+     * deferred and the record holds it already formatted. */
+    const char * format;
+    const char * srcFile;
+    const char * srcFunction;
+
+    fm_timestamp timestamp;
+
+} fm_logRecord;
+
+/* A single-producer, single-consumer ring of deferred log messages. The
+ * owning thread appends at tail, the drainer consumes from head. Both
+ * count bytes and only ever increase. */
+typedef struct _fm_logRing
+{
+    fm_byte *            data;
+
+    volatile fm_uint64   head;
+    volatile fm_uint64   tail;
+
+    /* Updated by the owning thread only. */
+    fm_uint64            numRecords;
+    fm_uint64            numDropped;
+    fm_uint64            highWater;
+
+    /* Drops already reported in the log by the drainer. */
+    fm_uint64            numDropsReported;
+
+    void *               threadId;
+    fm_char              threadName[64];
+
+    /* Set when the owning thread exits; the ring is freed once drained. */
+    volatile fm_bool     orphaned;
+
+    /* Value of asyncLogging.forkGeneration when the ring was created. */
+    fm_uint              forkGeneration;
+
+    struct _fm_logRing * next;
+
+} fm_logRing;
+
+/* Process-local state of the asynchronous logging backend. */
+typedef struct
+{
+    /* Set once the locks and thread key below are initialized. */
+    fm_bool           initialized;
+
+    /* Serializes fmSetLoggingAsync. */
+    pthread_mutex_t   controlLock;
+
+    /* Whether messages are deferred to the drainer thread. */
+    volatile fm_bool  active;
+
+    /* Asks the drainer thread to exit. */
+    volatile fm_bool  stopRequested;
+
+    fm_thread         drainer;
+    pthread_t         drainerHandle;
+
+    /* Wakes the drainer before its interval expires. */
+    pthread_mutex_t   wakeLock;
+    pthread_cond_t    wakeCond;
+
+    /* Serializes the consumers of the rings. */
+    pthread_mutex_t   drainLock;
+
+    /* Protects the insertion and removal of rings. */
+    pthread_mutex_t   ringListLock;
+    fm_logRing *      rings;
+    fm_int            numRings;
+
+    pthread_key_t     ringKey;
+    fm_bool           ringKeyValid;
+    fm_uint           forkGeneration;
+
+    /* Totals for rings that have been freed, and for messages written in
+     * place because the thread could not get a ring. */
+    fm_uint64         retiredRecords;
+    fm_uint64         retiredDropped;
+    fm_uint64         numNoRing;
+
+    /* Messages that did not fit in a record and were cut. */
+    fm_uint64         numTruncated;
+
+    /* Drainer activity. */
+    fm_uint64         numDrains;
+    fm_uint64         numDrained;
+
+} fm_asyncLoggingState;
+
 
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
 
+/* Generation seen by call sites until this process finds the logging state.
+ * It never matches a cached call site state, so such call sites always
+ * defer to fmLogMessage. */
+static volatile fm_uint32 noCallSiteGeneration = 1;
+
+volatile fm_uint32 *fmLogCallSiteGeneration = &noCallSiteGeneration;
+
 /*****************************************************************************
  * Local Variables
  *****************************************************************************/
 
+/* The rings and drainer are per process, not in the shared root. */
+static fm_asyncLoggingState asyncLogging;
+static pthread_once_t       asyncLoggingOnce = PTHREAD_ONCE_INIT;
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
 
 static fm_bool ApplyLoggingFilter(const char *haystack, const char *needle);
+static void InvalidateLogCallSites(fm_loggingState *ls);
 static fm_status LogMessage( fm_uint64   filteredCategoryMask,
                              fm_uint64   category,
                              fm_uint64   logLevel,
@@ -124,33 +299,72 @@ static fm_bool ApplyLoggingFilter(const char *haystack, const char *needle)
 
 
 /*****************************************************************************/
-/** LogMessage
+/** InvalidateLogCallSites
  * \ingroup intLogging
  *
- * \desc            Internal version of ''fmLogMessage'' and ''fmLogMessageV2''
- * 
- * \param[in]       filteredCategoryMask is the bitmask representing enabled
- *                  logging categories when this function is invoked from
- *                  ''fmLogMessageV2'' or is the bitmask representing enabled 
- *                  categories for which legacy logging is enabled when invoked
- *                  from ''fmLogMessage''.
- * 
- * \param[in]       categories is a bitmask of category flags (see
- *                  ''Log Categories'') which indicate which categories this
- *                  log message belongs to.
+ * \desc            Makes every FM_LOG_FUNC call site, in every process,
+ *                  recompute whether it is enabled. Called after changing
+ *                  any setting that enters into that decision.
  *
- * \param[in]       logLevel is a bitmask of level flags (see
- *                  ''Log Levels'') which indicate which log levels this
- *                  log message belongs to.
+ * \param[in]       ls points to the logging state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void InvalidateLogCallSites(fm_loggingState *ls)
+{
+    fm_uint32 generation;
+
+    /* The new settings must be visible before the new generation. */
+    __sync_synchronize();
+
+    generation = ls->callSiteGeneration + 1;
+
+    if (generation == 0)
+    {
+        generation = 1;
+    }
+
+    ls->callSiteGeneration = generation;
+
+}   /* end InvalidateLogCallSites */
+
+
+
+
+/*****************************************************************************/
+/** WriteLogMessage
+ * \ingroup intLogging
+ *
+ * \desc            Writes one log message, with the preamble selected by
+ *                  the verbosity mask, to the logging destination.
+ *
+ * \note            The caller must hold the logging access lock, if the
+ *                  logging subsystem is initialized.
+ *
+ * \param[in]       ls points to the logging state, or NULL if the logging
+ *                  subsystem is not initialized.
+ *
+ * \param[in]       logType is the logging destination.
+ *
+ * \param[in]       verbosityMask selects the preamble components.
+ *
+ * \param[in]       logLevel is the log level of the message.
+ *
+ * \param[in]       msgTime points to the time at which the message was
+ *                  logged, or NULL to use the current time.
+ *
+ * \param[in]       threadName is the name of the thread that logged the
+ *                  message, or NULL to use the current thread ID.
  *
  * \param[in]       srcFile is the name of the source code file generating
- *                  the log message. Usually invoked as __FILE__.
+ *                  the log message.
  *
  * \param[in]       srcFunction is the name of the source code function
- *                  generating the log message. Usually invoked as __func__.
+ *                  generating the log message.
  *
  * \param[in]       srcLine is the source code line number generating the
- *                  log message. Usually invoked as __LINE__.
+ *                  log message.
  *
  * \param[in]       format is the printf-style format.
  *
@@ -159,531 +373,2280 @@ static fm_bool ApplyLoggingFilter(const char *haystack, const char *needle)
  * \return          FM_OK if successful.
  *
  *****************************************************************************/
-static fm_status LogMessage( fm_uint64   filteredCategoryMask,
-                             fm_uint64   categories,
-                             fm_uint64   logLevel,
-                             const char *srcFile,
-                             const char *srcFunction,
-                             fm_uint32   srcLine,
-                             const char *format,
-                             va_list     ap)
+static fm_status WriteLogMessage(fm_loggingState *   ls,
+                                 fm_loggingType      logType,
+                                 fm_uint32           verbosityMask,
+                                 fm_uint64           logLevel,
+                                 const fm_timestamp *msgTime,
+                                 fm_text             threadName,
+                                 const char *        srcFile,
+                                 const char *        srcFunction,
+                                 fm_uint32           srcLine,
+                                 const char *        format,
+                                 va_list             ap)
 {
-    fm_loggingState *ls = GET_LOGGING_STATE();
-    fm_loggingType   logType;
-    fm_bool          enabled;
     fm_char          dateStr[64];
     fm_char          timeStampStr[64];
     fm_timestamp     ts;
-    fm_text          threadName = NULL;
     fm_char          threadStr[64];
     FILE *           log;
     fm_char          logLevelStr[64];
     fm_char          callBackStr[1024];
-    fm_uint64        levelMask;
-    fm_text          functionFilter;
-    fm_text          fileFilter;
-    fm_uint32        verbosityMask;
-    fm_bool          filter;
     fm_text          levelStr;
-    fm_bool          bypassFilter = FALSE;
-    int              posixErr;
-    fm_bool          isMasterProcess = TRUE; 
-    fm_status        status; 
+    time_t           seconds;
+    fm_bool          isMasterProcess = TRUE;
+    fm_status        status;
 
-    if ( LOG_INITIALIZED(ls) )
-    {
-        levelMask      = ls->levelMask;
-        logType        = ls->logType;
-        enabled        = ls->enabled;
-        functionFilter = ls->functionFilter;
-        fileFilter     = ls->fileFilter;
-        verbosityMask  = ls->verbosityMask;
-    }
-    else
+    /**************************************************
+     * Identify the log level at which this log message
+     * was generated.
+     **************************************************/
+     
+    if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
     {
-        /* use defaults if the logging facility is not initialized */
-        levelMask    = FM_LOG_LEVEL_FATAL |
-                       FM_LOG_LEVEL_ERROR |
-                       FM_LOG_LEVEL_WARNING;
-        logType        = FM_LOG_TYPE_CONSOLE;
-        enabled        = TRUE;
-        functionFilter = NULL;
-        fileFilter     = NULL;
-        verbosityMask  = ~0;
+        switch (logLevel)
+        {
+            case FM_LOG_LEVEL_FUNC_ENTRY:
+            case FM_LOG_LEVEL_FUNC_ENTRY_API:
+            case FM_LOG_LEVEL_FUNC_ENTRY_VERBOSE:
+            case FM_LOG_LEVEL_FUNC_ENTRY_API_VERBOSE:
+                levelStr = "ENTRY";
+                break;
+                
+            case FM_LOG_LEVEL_FUNC_EXIT:
+            case FM_LOG_LEVEL_FUNC_EXIT_API:
+            case FM_LOG_LEVEL_FUNC_EXIT_VERBOSE:
+            case FM_LOG_LEVEL_FUNC_EXIT_API_VERBOSE:
+                levelStr = "EXIT";
+                break;
+                
+            case FM_LOG_LEVEL_WARNING:
+                levelStr = "WARNING";
+                break;
+            
+            case FM_LOG_LEVEL_ERROR:
+                levelStr = "ERROR";
+                break;
+                
+            case FM_LOG_LEVEL_FATAL:
+                levelStr = "FATAL";
+                break;
+                
+            case FM_LOG_LEVEL_INFO:
+                levelStr = "INFO";
+                break;
+                
+            case FM_LOG_LEVEL_DEBUG:
+            case FM_LOG_LEVEL_DEBUG_VERBOSE:
+                levelStr = "DEBUG";
+                break;
+                
+            case FM_LOG_LEVEL_PRINT:
+                levelStr = "PRINT";
+                break;
+                
+            case FM_LOG_LEVEL_DEBUG2:
+                levelStr = "DEBUG2";
+                break;
+                
+            case FM_LOG_LEVEL_DEBUG3:
+                levelStr = "DEBUG3";
+                break;
+                
+            case FM_LOG_LEVEL_ASSERT:
+                levelStr = "ASSERT";
+                break;
+                
+            default:
+                levelStr = "UNKNOWN_LVL";
+                break;
+                
+        }   /* end switch (logLevel) */
+        
+        FM_SNPRINTF_S(logLevelStr, sizeof(logLevelStr), "%s", levelStr);
     }
 
-    if (logLevel & FM_LOG_LEVEL_DEFAULT )
+    if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
     {
-        /**************************************************
-         * Make sure FM_LOG_PRINT shows up unconditionally
-         * and unadorned and that error messages aren't 
-         * inadvertently suppressed 
-         **************************************************/
-        
-        if ( logLevel & FM_LOG_LEVEL_PRINT )
+        if (msgTime == NULL)
         {
-            verbosityMask         = 0;
-            categories            = FM_LOG_CAT_LOGGING;
+            fmGetFormattedTime(dateStr);
         }
+        else
+        {
+            /* Same format as fmGetFormattedTime, for the message time. */
+            seconds = (time_t) msgTime->sec;
 
-        enabled               = TRUE;
-        levelMask             = logLevel;
-        filteredCategoryMask  = FM_LOG_CAT_ALL;
-        bypassFilter          = TRUE;
+            if ( ctime_r(&seconds, dateStr) != NULL )
+            {
+                *(dateStr + strlen(dateStr) - 1) = 0;
+            }
+            else
+            {
+                dateStr[0] = '\0';
+            }
+        }
     }
 
-    /**************************************************
-     * Generate log output if the log level is set to
-     * the print unconditionally, or if the logging
-     * system is enabled and we have a category and
-     * level match.
-     **************************************************/
-
-    if ( enabled &&
-         (filteredCategoryMask & categories) != 0 &&
-         ( (levelMask & logLevel) == logLevel ) )
+    if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
     {
-
-        if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+        if (msgTime == NULL)
         {
-            /* Get the thread name before taking the access lock, to avoid
-             * possible lock inversion. */
-            threadName = fmGetCurrentThreadName();
+            fmGetTime(&ts);
         }
-
-        if ( LOG_INITIALIZED(ls) )
+        else
         {
-            posixErr = pthread_mutex_lock( (pthread_mutex_t *) ls->accessLock );
-            if (posixErr != 0)
-            {
-                FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_ERR_UNABLE_TO_LOCK);
-            }
+            ts = *msgTime;
         }
 
-        /* check secondary filters */
-        filter = TRUE;
+        FM_SNPRINTF_S(timeStampStr, sizeof(logLevelStr),
+                      "%u.%04u",
+                      ts.sec,
+                      ts.usec / 100);
+    }
 
-        if (!bypassFilter)
+
+    if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+    {
+        if (threadName == NULL)
         {
-            if (filter && functionFilter && *functionFilter)
-            {
-                filter = ApplyLoggingFilter(functionFilter, srcFunction);
-            }
-    
-            if (filter && fileFilter && *fileFilter)
-            {
-                filter = ApplyLoggingFilter(fileFilter, srcFile);
-            }
+            FM_SNPRINTF_S( threadStr,
+                           sizeof(threadStr),
+                           "<%p>",
+                           fmGetCurrentThreadId() );
+            threadName = threadStr;
         }
-        
-        if (filter)
-        {
-            /**************************************************
-             * Identify the log level at which this log message
-             * was generated.
-             **************************************************/
-             
-            if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
-            {
-                switch (logLevel)
-                {
-                    case FM_LOG_LEVEL_FUNC_ENTRY:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_API:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_VERBOSE:
-                    case FM_LOG_LEVEL_FUNC_ENTRY_API_VERBOSE:
-                        levelStr = "ENTRY";
-                        break;
-                        
-                    case FM_LOG_LEVEL_FUNC_EXIT:
-                    case FM_LOG_LEVEL_FUNC_EXIT_API:
-                    case FM_LOG_LEVEL_FUNC_EXIT_VERBOSE:
-                    case FM_LOG_LEVEL_FUNC_EXIT_API_VERBOSE:
-                        levelStr = "EXIT";
-                        break;
-                        
-                    case FM_LOG_LEVEL_WARNING:
-                        levelStr = "WARNING";
-                        break;
-                    
-                    case FM_LOG_LEVEL_ERROR:
-                        levelStr = "ERROR";
-                        break;
-                        
-                    case FM_LOG_LEVEL_FATAL:
-                        levelStr = "FATAL";
-                        break;
-                        
-                    case FM_LOG_LEVEL_INFO:
-                        levelStr = "INFO";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG:
-                    case FM_LOG_LEVEL_DEBUG_VERBOSE:
-                        levelStr = "DEBUG";
-                        break;
-                        
-                    case FM_LOG_LEVEL_PRINT:
-                        levelStr = "PRINT";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG2:
-                        levelStr = "DEBUG2";
-                        break;
-                        
-                    case FM_LOG_LEVEL_DEBUG3:
-                        levelStr = "DEBUG3";
-                        break;
-                        
-                    case FM_LOG_LEVEL_ASSERT:
-                        levelStr = "ASSERT";
-                        break;
-                        
-                    default:
-                        levelStr = "UNKNOWN_LVL";
-                        break;
-                        
-                }   /* end switch (logLevel) */
-                
-                FM_SNPRINTF_S(logLevelStr, sizeof(logLevelStr), "%s", levelStr);
-            }
+    }
+    else
+    {
+        threadStr[0] = '\0';
+        threadName = threadStr;
+    }
+
+    switch (logType)
+    {
+        case FM_LOG_TYPE_CONSOLE:
 
             if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
             {
-                fmGetFormattedTime(dateStr);
+                FM_PRINTF_S("%s:", dateStr);
             }
 
             if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
             {
-                fmGetTime(&ts);
-                FM_SNPRINTF_S(timeStampStr, sizeof(logLevelStr),
-                              "%u.%04u",
-                              ts.sec,
-                              ts.usec / 100);
+                FM_PRINTF_S("%s:", timeStampStr);
             }
 
+            if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
+            {
+                FM_PRINTF_S("%s:", logLevelStr);
+            }
 
             if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
             {
-                if (threadName == NULL)
-                {
-                    FM_SNPRINTF_S( threadStr,
-                                   sizeof(threadStr),
-                                   "<%p>",
-                                   fmGetCurrentThreadId() );
-                    threadName = threadStr;
-                }
+                FM_PRINTF_S("%s:", threadName);
             }
-            else
+
+            if (verbosityMask & FM_LOG_VERBOSITY_FILE)
             {
-                threadStr[0] = '\0';
-                threadName = threadStr;
+                FM_PRINTF_S("%s:", srcFile);
             }
 
-            switch (logType)
+            if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
             {
-                case FM_LOG_TYPE_CONSOLE:
+                FM_PRINTF_S("%s:", srcFunction);
+            }
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
-                    {
-                        FM_PRINTF_S("%s:", dateStr);
-                    }
+            if (verbosityMask & FM_LOG_VERBOSITY_LINE)
+            {
+                FM_PRINTF_S("%d:", srcLine);
+            }
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
-                    {
-                        FM_PRINTF_S("%s:", timeStampStr);
-                    }
+            FM_VPRINTF_S(format, ap);
+            fflush(stdout);
+            break;
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
-                    {
-                        FM_PRINTF_S("%s:", logLevelStr);
-                    }
+        case FM_LOG_TYPE_FILE:
+            log = fopen(ls->logFileName, "at");
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
-                    {
-                        FM_PRINTF_S("%s:", threadName);
+            if (log)
+            {
+                if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
+                {
+                    FM_FPRINTF_S(log, "%s:", dateStr);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
+                {
+                    FM_FPRINTF_S(log, "%s:", timeStampStr);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
+                {
+                    FM_FPRINTF_S(log, "%s:", logLevelStr);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+                {
+                    FM_FPRINTF_S(log, "%s:", threadName);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_FILE)
+                {
+                    FM_FPRINTF_S(log, "%s:", srcFile);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
+                {
+                    FM_FPRINTF_S(log, "%s:", srcFunction);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_LINE)
+                {
+                    FM_FPRINTF_S(log, "%d:", srcLine);
+                }
+
+                FM_VFPRINTF_S(log, format, ap);
+                fclose(log);
+            }
+            else
+            {
+                /* Unable to open log file. */
+                FM_LOG_ERROR(FM_LOG_CAT_LOGGING,
+                             "Unable to open logfile %s for appending",
+                             ls->logFileName);
+
+            }   /* end if (log) */
+
+            break;
+
+        case FM_LOG_TYPE_MEMBUF:
+            {
+                fm_int lineLen;
+                fm_int elemLen;
+                lineLen = 0;
+
+                if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(ls->logBuffer[ls->currentPos],
+                                                  FM_LOG_MAX_LINE_SIZE,
+                                                  "%s:",
+                                                  dateStr) ) > 0 )
+                    {
+                        lineLen += elemLen;
                     }
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_FILE)
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(ls->logBuffer[ls->currentPos],
+                                                  FM_LOG_MAX_LINE_SIZE,
+                                                  "%s:",
+                                                  timeStampStr) ) > 0 )
                     {
-                        FM_PRINTF_S("%s:", srcFile);
+                        lineLen += elemLen;
                     }
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
+                }
+
+                if ( (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL) &&
+                     lineLen < FM_LOG_MAX_LINE_SIZE )
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                                  FM_LOG_MAX_LINE_SIZE - lineLen,
+                                                  "%s:",
+                                                  logLevelStr) ) > 0 )
                     {
-                        FM_PRINTF_S("%s:", srcFunction);
+                        lineLen += elemLen;
                     }
 
-                    if (verbosityMask & FM_LOG_VERBOSITY_LINE)
+                }
+
+                if ( (verbosityMask & FM_LOG_VERBOSITY_THREAD) &&
+                     lineLen < FM_LOG_MAX_LINE_SIZE )
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                                  FM_LOG_MAX_LINE_SIZE - lineLen,
+                                                  "%s:",
+                                                  threadName) ) > 0 )
                     {
-                        FM_PRINTF_S("%d:", srcLine);
+                        lineLen += elemLen;
                     }
 
-                    FM_VPRINTF_S(format, ap);
-                    fflush(stdout);
-                    break;
+                }
+
+                if ( (verbosityMask & FM_LOG_VERBOSITY_FILE) &&
+                     lineLen < FM_LOG_MAX_LINE_SIZE )
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                                  FM_LOG_MAX_LINE_SIZE - lineLen,
+                                                  "%s:",
+                                                  srcFile) ) > 0 )
+                    {
+                        lineLen += elemLen;
+                    }
 
-                case FM_LOG_TYPE_FILE:
-                    log = fopen(ls->logFileName, "at");
+                }
 
-                    if (log)
+                if ( (verbosityMask & FM_LOG_VERBOSITY_FUNC) &&
+                     lineLen < FM_LOG_MAX_LINE_SIZE )
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                                  FM_LOG_MAX_LINE_SIZE - lineLen,
+                                                  "%s:",
+                                                  srcFunction) ) > 0 )
                     {
-                        if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
-                        {
-                            FM_FPRINTF_S(log, "%s:", dateStr);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
-                        {
-                            FM_FPRINTF_S(log, "%s:", timeStampStr);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
-                        {
-                            FM_FPRINTF_S(log, "%s:", logLevelStr);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
-                        {
-                            FM_FPRINTF_S(log, "%s:", threadName);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_FILE)
-                        {
-                            FM_FPRINTF_S(log, "%s:", srcFile);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
-                        {
-                            FM_FPRINTF_S(log, "%s:", srcFunction);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_LINE)
-                        {
-                            FM_FPRINTF_S(log, "%d:", srcLine);
-                        }
-
-                        FM_VFPRINTF_S(log, format, ap);
-                        fclose(log);
+                        lineLen += elemLen;
                     }
-                    else
+
+                }
+
+                if ( (verbosityMask & FM_LOG_VERBOSITY_LINE) &&
+                     lineLen < FM_LOG_MAX_LINE_SIZE )
+                {
+                    if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                                  FM_LOG_MAX_LINE_SIZE - lineLen,
+                                                  "%d:",
+                                                  srcLine) ) > 0 )
                     {
-                        /* Unable to open log file. */
-                        FM_LOG_ERROR(FM_LOG_CAT_LOGGING,
-                                     "Unable to open logfile %s for appending",
-                                     ls->logFileName);
+                        lineLen += elemLen;
+                    }
 
-                    }   /* end if (log) */
+                }
 
-                    break;
+                if (lineLen < FM_LOG_MAX_LINE_SIZE)
+                {
+                    FM_VSNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
+                                   FM_LOG_MAX_LINE_SIZE - lineLen,
+                                   format,
+                                   ap);
+                }
+
+                if (++ls->currentPos >= FM_LOG_MAX_LINES)
+                {
+                    ls->currentPos = 0;
+
+                    FM_LOG_INFO(FM_LOG_CAT_LOGGING,
+                                "-- Log Buffer Wrapped --\n");
+                }
+
+                break;
+            }
+
+        case FM_LOG_TYPE_CALLBACK:
+
+            status = fmIsMasterProcess(&isMasterProcess);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_LOGGING,status);
+
+            if (ls->fmLogCallback && isMasterProcess)
+            {
+                if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  dateStr);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  timeStampStr);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  logLevelStr);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  threadName);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_FILE)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  srcFile);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%s:",
+                                  srcFunction);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                if (verbosityMask & FM_LOG_VERBOSITY_LINE)
+                {
+                    FM_SNPRINTF_S(callBackStr,
+                                  sizeof(callBackStr),
+                                  "%d:",
+                                  srcLine);
+                    ls->fmLogCallback(callBackStr,
+                                      ls->fmLogCookie1,
+                                      ls->fmLogCookie2);
+                }
+
+                FM_VSNPRINTF_S(callBackStr, sizeof(callBackStr), format, ap);
+                ls->fmLogCallback(callBackStr,
+                                  ls->fmLogCookie1,
+                                  ls->fmLogCookie2);
+
+            }   /* end if (ls->fmLogCallback) */
+
+            break;
+
+    }   /* end switch (logType) */
+
+    return FM_OK;
+
+}   /* end WriteLogMessage */
+
+
+
+
+/*****************************************************************************/
+/** ParseLogConversion
+ * \ingroup intLogging
+ *
+ * \desc            Parses one printf conversion specification.
+ *
+ * \param[in,out]   format points to the format pointer, which must point
+ *                  just past the '%'. On success it is advanced past the
+ *                  conversion character.
+ *
+ * \param[out]      conv points to caller-allocated storage where this
+ *                  function places the parsed specification.
+ *
+ * \return          TRUE if the conversion can be deferred.
+ * \return          FALSE if it is malformed or uses a wide character or
+ *                  other unsupported conversion.
+ *
+ *****************************************************************************/
+static fm_bool ParseLogConversion(const char **format, fm_logConversion *conv)
+{
+    const char *p = *format;
+
+    FM_CLEAR(*conv);
+
+    conv->flags = p;
+    while ( (*p != '\0') && (strchr("-+ #0'", *p) != NULL) )
+    {
+        p++;
+    }
+    conv->numFlags = p - conv->flags;
+
+    if (*p == '*')
+    {
+        conv->widthArg = TRUE;
+        p++;
+    }
+    else
+    {
+        conv->width = p;
+        while ( (*p >= '0') && (*p <= '9') )
+        {
+            p++;
+        }
+        conv->widthLen = p - conv->width;
+    }
+
+    if (*p == '.')
+    {
+        conv->hasPrecision = TRUE;
+        p++;
+
+        if (*p == '*')
+        {
+            conv->precisionArg = TRUE;
+            p++;
+        }
+        else
+        {
+            conv->precision = p;
+            while ( (*p >= '0') && (*p <= '9') )
+            {
+                p++;
+            }
+            conv->precisionLen = p - conv->precision;
+        }
+    }
+
+    /* Keeps the rebuilt specification within a small buffer. */
+    if ( (conv->numFlags > 4) ||
+         (conv->widthLen > 4) ||
+         (conv->precisionLen > 4) )
+    {
+        return FALSE;
+    }
+
+    switch (*p)
+    {
+        case 'h':
+            p++;
+            conv->length = LOG_ARG_LEN_H;
+            if (*p == 'h')
+            {
+                p++;
+                conv->length = LOG_ARG_LEN_HH;
+            }
+            break;
+
+        case 'l':
+            p++;
+            conv->length = LOG_ARG_LEN_L;
+            if (*p == 'l')
+            {
+                p++;
+                conv->length = LOG_ARG_LEN_LL;
+            }
+            break;
+
+        case 'q':
+            p++;
+            conv->length = LOG_ARG_LEN_LL;
+            break;
+
+        case 'j':
+            p++;
+            conv->length = LOG_ARG_LEN_J;
+            break;
+
+        case 'z':
+            p++;
+            conv->length = LOG_ARG_LEN_Z;
+            break;
+
+        case 't':
+            p++;
+            conv->length = LOG_ARG_LEN_T;
+            break;
+
+        case 'L':
+            p++;
+            conv->length = LOG_ARG_LEN_LONG_DOUBLE;
+            break;
+
+        default:
+            break;
+    }
+
+    conv->conversion = *p;
+
+    switch (conv->conversion)
+    {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'n':
+            if (conv->length == LOG_ARG_LEN_LONG_DOUBLE)
+            {
+                return FALSE;
+            }
+            break;
+
+        case 'c':
+        case 's':
+        case 'p':
+            if (conv->length != LOG_ARG_LEN_NONE)
+            {
+                return FALSE;
+            }
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if ( (conv->length != LOG_ARG_LEN_NONE) &&
+                 (conv->length != LOG_ARG_LEN_L) &&
+                 (conv->length != LOG_ARG_LEN_LONG_DOUBLE) )
+            {
+                return FALSE;
+            }
+            break;
+
+        default:
+            return FALSE;
+    }
+
+    *format = p + 1;
+
+    return TRUE;
+
+}   /* end ParseLogConversion */
+
+
+
+
+/*****************************************************************************/
+/** EncodeLogArguments
+ * \ingroup intLogging
+ *
+ * \desc            Copies the arguments of a log message into the argument
+ *                  area of a deferred record, as directed by the format.
+ *                  Strings are copied, since the caller's buffers may not
+ *                  outlive the call.
+ *
+ * \param[in]       format is the printf-style format.
+ *
+ * \param[in,out]   ap points to the argument list, which is consumed.
+ *
+ * \param[out]      args points to the argument area of the record.
+ *
+ * \param[in]       maxSize is the size in bytes of the argument area.
+ *
+ * \return          The number of bytes used, a multiple of 8.
+ * \return          -1 if the message cannot be deferred.
+ *
+ *****************************************************************************/
+static fm_int EncodeLogArguments(const char *format,
+                                 va_list *   ap,
+                                 fm_byte *   args,
+                                 fm_int      maxSize)
+{
+    fm_logConversion conv;
+    fm_uint64 *      slot;
+    fm_int           size;
+    fm_int           needed;
+    const char *     str;
+    fm_int           len;
+    union
+    {
+        double       d;
+        fm_uint64    u;
+    } value;
+
+    size = 0;
+
+    while (*format != '\0')
+    {
+        if (*format++ != '%')
+        {
+            continue;
+        }
+
+        if (*format == '%')
+        {
+            format++;
+            continue;
+        }
+
+        if ( !ParseLogConversion(&format, &conv) )
+        {
+            return -1;
+        }
+
+        needed = 8 * (1 + (conv.widthArg ? 1 : 0) +
+                      (conv.precisionArg ? 1 : 0));
+
+        if (size + needed > maxSize)
+        {
+            return -1;
+        }
+
+        slot = (fm_uint64 *) (args + size);
+
+        if (conv.widthArg)
+        {
+            *slot++ = (fm_uint64) (fm_int64) va_arg(*ap, int);
+            size   += 8;
+        }
+
+        if (conv.precisionArg)
+        {
+            *slot++ = (fm_uint64) (fm_int64) va_arg(*ap, int);
+            size   += 8;
+        }
+
+        switch (conv.conversion)
+        {
+            case 'd':
+            case 'i':
+                switch (conv.length)
+                {
+                    case LOG_ARG_LEN_L:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, long);
+                        break;
+
+                    case LOG_ARG_LEN_LL:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, long long);
+                        break;
+
+                    case LOG_ARG_LEN_J:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, intmax_t);
+                        break;
+
+                    case LOG_ARG_LEN_Z:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, ssize_t);
+                        break;
+
+                    case LOG_ARG_LEN_T:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, ptrdiff_t);
+                        break;
+
+                    default:
+                        *slot = (fm_uint64) (fm_int64) va_arg(*ap, int);
+                        break;
+                }
+                size += 8;
+                break;
+
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                switch (conv.length)
+                {
+                    case LOG_ARG_LEN_L:
+                        *slot = va_arg(*ap, unsigned long);
+                        break;
+
+                    case LOG_ARG_LEN_LL:
+                        *slot = va_arg(*ap, unsigned long long);
+                        break;
+
+                    case LOG_ARG_LEN_J:
+                        *slot = va_arg(*ap, uintmax_t);
+                        break;
+
+                    case LOG_ARG_LEN_Z:
+                        *slot = va_arg(*ap, size_t);
+                        break;
+
+                    case LOG_ARG_LEN_T:
+                        *slot = (fm_uint64) va_arg(*ap, ptrdiff_t);
+                        break;
+
+                    default:
+                        *slot = va_arg(*ap, unsigned int);
+                        break;
+                }
+                size += 8;
+                break;
+
+            case 'c':
+                *slot = (fm_uint64) (fm_int64) va_arg(*ap, int);
+                size += 8;
+                break;
+
+            case 'p':
+                *slot = (fm_uint64) (uintptr_t) va_arg(*ap, void *);
+                size += 8;
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                if (conv.length == LOG_ARG_LEN_LONG_DOUBLE)
+                {
+                    value.d = (double) va_arg(*ap, long double);
+                }
+                else
+                {
+                    value.d = va_arg(*ap, double);
+                }
+                *slot = value.u;
+                size += 8;
+                break;
+
+            case 's':
+                str = va_arg(*ap, const char *);
+
+                if (str == NULL)
+                {
+                    *slot = FM_LOG_ASYNC_NULL_STRING;
+                    size += 8;
+                    break;
+                }
+
+                /* Strings are copied whole; one that doesn't fit has
+                 * the message formatted in place instead. */
+                if (size + 8 >= maxSize)
+                {
+                    return -1;
+                }
+
+                len = (fm_int) FM_STRNLEN_S(str, maxSize - size - 8 + 1);
+
+                if (size + 8 + len > maxSize)
+                {
+                    return -1;
+                }
+
+                *slot = len;
+                FM_MEMCPY_S(slot + 1, maxSize - size - 8, str, len);
+                size += 8 + ( (len + 7) & ~7 );
+                break;
+
+            case 'n':
+                /* Nothing is stored through a deferred %n. */
+                (void) va_arg(*ap, void *);
+                break;
+
+            default:
+                return -1;
+        }
+
+        if (size > maxSize)
+        {
+            return -1;
+        }
+    }
+
+    return size;
+
+}   /* end EncodeLogArguments */
+
+
+
+
+/*****************************************************************************/
+/** ReadLogSlot
+ * \ingroup intLogging
+ *
+ * \desc            Reads the next argument slot of a deferred record.
+ *
+ * \param[in,out]   args points to the argument pointer, which is advanced.
+ *
+ * \param[in]       end points just past the record.
+ *
+ * \param[out]      value receives the slot.
+ *
+ * \return          TRUE if a slot was read, FALSE at the end of the record.
+ *
+ *****************************************************************************/
+static fm_bool ReadLogSlot(const fm_byte **args,
+                           const fm_byte * end,
+                           fm_uint64 *     value)
+{
+    if (*args + 8 > end)
+    {
+        return FALSE;
+    }
+
+    *value = *( (const fm_uint64 *) *args );
+    *args += 8;
+
+    return TRUE;
+
+}   /* end ReadLogSlot */
+
+
+
+
+/*****************************************************************************/
+/** FormatLogRecord
+ * \ingroup intLogging
+ *
+ * \desc            Formats the message of a deferred record, converting
+ *                  each stored argument with its own conversion
+ *                  specification.
+ *
+ * \param[in]       record points to the record.
+ *
+ * \param[out]      text points to caller-allocated storage for the message.
+ *
+ * \param[in]       size is the size of text in bytes.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FormatLogRecord(const fm_logRecord *record,
+                            fm_char *           text,
+                            fm_int              size)
+{
+    const fm_byte *  args;
+    const fm_byte *  end;
+    const char *     format;
+    fm_logConversion conv;
+    fm_char          spec[32];
+    fm_char          str[FM_LOG_ASYNC_MAX_RECORD + 1];
+    fm_uint64        slot = 0;
+    fm_uint64        len;
+    fm_int           pos;
+    fm_int           n;
+    fm_int           written;
+    fm_bool          cut = FALSE;
+    union
+    {
+        double       d;
+        fm_uint64    u;
+    } value;
+
+    args = (const fm_byte *) (record + 1);
+    end  = (const fm_byte *) record + record->size;
+    pos  = 0;
+
+    if (record->format == NULL)
+    {
+        /* Formatted when it was logged. */
+        if ( ReadLogSlot(&args, end, &len) )
+        {
+            len = (len < (fm_uint64) (end - args)) ? len : (fm_uint64) (end - args);
+            len = (len < (fm_uint64) (size - 1)) ? len : (fm_uint64) (size - 1);
+            FM_MEMCPY_S(text, size, args, len);
+            pos = (fm_int) len;
+        }
+
+        text[pos] = '\0';
+        return;
+    }
+
+    format = record->format;
+
+    while ( (*format != '\0') && (pos < size - 1) )
+    {
+        if (*format != '%')
+        {
+            text[pos++] = *format++;
+            continue;
+        }
+
+        format++;
+
+        if (*format == '%')
+        {
+            text[pos++] = '%';
+            format++;
+            continue;
+        }
+
+        if ( !ParseLogConversion(&format, &conv) )
+        {
+            break;
+        }
+
+        /* Rebuild the specification, with any '*' resolved. */
+        n         = 0;
+        spec[n++] = '%';
+
+        FM_MEMCPY_S(&spec[n], sizeof(spec) - n, conv.flags, conv.numFlags);
+        n += conv.numFlags;
+
+        if (conv.widthArg)
+        {
+            if ( !ReadLogSlot(&args, end, &slot) )
+            {
+                break;
+            }
+            n += FM_SNPRINTF_S(&spec[n], sizeof(spec) - n, "%d", (fm_int) slot);
+        }
+        else
+        {
+            FM_MEMCPY_S(&spec[n], sizeof(spec) - n, conv.width, conv.widthLen);
+            n += conv.widthLen;
+        }
+
+        if (conv.hasPrecision)
+        {
+            spec[n++] = '.';
+
+            if (conv.precisionArg)
+            {
+                if ( !ReadLogSlot(&args, end, &slot) )
+                {
+                    break;
+                }
+                n += FM_SNPRINTF_S(&spec[n],
+                                   sizeof(spec) - n,
+                                   "%d",
+                                   (fm_int) slot);
+            }
+            else
+            {
+                FM_MEMCPY_S(&spec[n],
+                            sizeof(spec) - n,
+                            conv.precision,
+                            conv.precisionLen);
+                n += conv.precisionLen;
+            }
+        }
+
+        if ( (conv.conversion != 'n') && !ReadLogSlot(&args, end, &slot) )
+        {
+            break;
+        }
+
+        switch (conv.length)
+        {
+            case LOG_ARG_LEN_HH:
+                spec[n++] = 'h';
+                spec[n++] = 'h';
+                break;
+
+            case LOG_ARG_LEN_H:
+                spec[n++] = 'h';
+                break;
+
+            case LOG_ARG_LEN_L:
+                spec[n++] = 'l';
+                break;
+
+            case LOG_ARG_LEN_LL:
+                spec[n++] = 'l';
+                spec[n++] = 'l';
+                break;
+
+            case LOG_ARG_LEN_J:
+                spec[n++] = 'j';
+                break;
+
+            case LOG_ARG_LEN_Z:
+                spec[n++] = 'z';
+                break;
+
+            case LOG_ARG_LEN_T:
+                spec[n++] = 't';
+                break;
+
+            default:
+                /* Floating point values are stored as double. */
+                break;
+        }
+
+        spec[n++] = conv.conversion;
+        spec[n]   = '\0';
+
+        written = 0;
+
+        switch (conv.conversion)
+        {
+            case 'd':
+            case 'i':
+                switch (conv.length)
+                {
+                    case LOG_ARG_LEN_L:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (long) slot);
+                        break;
+
+                    case LOG_ARG_LEN_LL:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (long long) slot);
+                        break;
+
+                    case LOG_ARG_LEN_J:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (intmax_t) slot);
+                        break;
+
+                    case LOG_ARG_LEN_Z:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (ssize_t) slot);
+                        break;
+
+                    case LOG_ARG_LEN_T:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (ptrdiff_t) slot);
+                        break;
+
+                    default:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (int) slot);
+                        break;
+                }
+                break;
+
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                switch (conv.length)
+                {
+                    case LOG_ARG_LEN_L:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (unsigned long) slot);
+                        break;
+
+                    case LOG_ARG_LEN_LL:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (unsigned long long) slot);
+                        break;
+
+                    case LOG_ARG_LEN_J:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (uintmax_t) slot);
+                        break;
+
+                    case LOG_ARG_LEN_Z:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (size_t) slot);
+                        break;
+
+                    case LOG_ARG_LEN_T:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (ptrdiff_t) slot);
+                        break;
+
+                    default:
+                        written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                                (unsigned int) slot);
+                        break;
+                }
+                break;
+
+            case 'c':
+                written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                        (int) slot);
+                break;
+
+            case 'p':
+                written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                        (void *) (uintptr_t) slot);
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                value.u = slot;
+                written = FM_SNPRINTF_S(&text[pos], size - pos, spec, value.d);
+                break;
+
+            case 's':
+                if (slot == FM_LOG_ASYNC_NULL_STRING)
+                {
+                    written = FM_SNPRINTF_S(&text[pos], size - pos, spec,
+                                            "(null)");
+                    break;
+                }
+
+                len = (slot < (fm_uint64) (end - args)) ?
+                      slot : (fm_uint64) (end - args);
+
+                FM_MEMCPY_S(str, sizeof(str), args, len);
+                str[len] = '\0';
+                args    += (len + 7) & ~7;
+
+                written = FM_SNPRINTF_S(&text[pos], size - pos, spec, str);
+                break;
+
+            default:
+                break;
+        }
+
+        if (written >= size - pos)
+        {
+            pos = size - 1;
+            cut = TRUE;
+        }
+        else if (written > 0)
+        {
+            pos += written;
+        }
+    }
+
+    /* Mark a message that did not fit in the text buffer */
+    if ( (*format != '\0') && (pos >= size - 1) )
+    {
+        cut = TRUE;
+    }
+
+    if ( cut && (size > (fm_int) sizeof(FM_LOG_ASYNC_CUT_MARK)) )
+    {
+        pos = size - sizeof(FM_LOG_ASYNC_CUT_MARK);
+        FM_MEMCPY_S(&text[pos],
+                    size - pos,
+                    FM_LOG_ASYNC_CUT_MARK,
+                    sizeof(FM_LOG_ASYNC_CUT_MARK) - 1);
+        pos += sizeof(FM_LOG_ASYNC_CUT_MARK) - 1;
+        __sync_fetch_and_add(&asyncLogging.numTruncated, 1);
+    }
+
+    text[pos] = '\0';
+
+}   /* end FormatLogRecord */
+
+
+
+
+/*****************************************************************************/
+/** DestroyLogRing
+ * \ingroup intLogging
+ *
+ * \desc            Marks a thread's ring as orphaned when the thread exits,
+ *                  so that the drainer frees it once it is empty. Called
+ *                  as a result of having registered this function with
+ *                  pthread_key_create.
+ *
+ * \param[in]       value is the thread's fm_logRing.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DestroyLogRing(void *value)
+{
+    fm_logRing *ring = value;
+
+    if ( (ring != NULL) && (ring->forkGeneration == asyncLogging.forkGeneration) )
+    {
+        ring->orphaned = TRUE;
+    }
+
+}   /* end DestroyLogRing */
+
+
+
+
+/*****************************************************************************/
+/** AsyncLoggingAfterFork
+ * \ingroup intLogging
+ *
+ * \desc            Resets the asynchronous logging state in a child
+ *                  process. The drainer thread does not exist in the child,
+ *                  so the child logs in place until it enables asynchronous
+ *                  logging itself. The parent's rings are abandoned.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AsyncLoggingAfterFork(void)
+{
+    asyncLogging.active        = FALSE;
+    asyncLogging.stopRequested = FALSE;
+    asyncLogging.rings         = NULL;
+    asyncLogging.numRings      = 0;
+    asyncLogging.forkGeneration++;
+
+    pthread_mutex_init(&asyncLogging.controlLock, NULL);
+    pthread_mutex_init(&asyncLogging.wakeLock, NULL);
+    pthread_cond_init(&asyncLogging.wakeCond, NULL);
+    pthread_mutex_init(&asyncLogging.drainLock, NULL);
+    pthread_mutex_init(&asyncLogging.ringListLock, NULL);
+
+}   /* end AsyncLoggingAfterFork */
+
+
+
+
+/*****************************************************************************/
+/** InitAsyncLogging
+ * \ingroup intLogging
+ *
+ * \desc            Initializes the process-local asynchronous logging
+ *                  state. Called once per process.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void InitAsyncLogging(void)
+{
+    pthread_mutex_init(&asyncLogging.controlLock, NULL);
+    pthread_mutex_init(&asyncLogging.wakeLock, NULL);
+    pthread_cond_init(&asyncLogging.wakeCond, NULL);
+    pthread_mutex_init(&asyncLogging.drainLock, NULL);
+    pthread_mutex_init(&asyncLogging.ringListLock, NULL);
+
+    if (pthread_key_create(&asyncLogging.ringKey, DestroyLogRing) == 0)
+    {
+        pthread_atfork(NULL, NULL, AsyncLoggingAfterFork);
+        asyncLogging.ringKeyValid = TRUE;
+    }
+
+    asyncLogging.initialized = TRUE;
+
+}   /* end InitAsyncLogging */
+
+
+
+
+/*****************************************************************************/
+/** GetLogRing
+ * \ingroup intLogging
+ *
+ * \desc            Returns the calling thread's ring, creating it on the
+ *                  thread's first deferred message.
+ *
+ * \note            This function must not log.
+ *
+ * \param           None.
+ *
+ * \return          Pointer to the ring, or NULL if the thread cannot have
+ *                  one.
+ *
+ *****************************************************************************/
+static fm_logRing *GetLogRing(void)
+{
+    fm_logRing *ring;
+    fm_text     threadName;
+
+    if (!asyncLogging.ringKeyValid)
+    {
+        return NULL;
+    }
+
+    ring = pthread_getspecific(asyncLogging.ringKey);
+
+    if ( (ring != NULL) && (ring->forkGeneration == asyncLogging.forkGeneration) )
+    {
+        return ring;
+    }
+
+    /* A ring inherited across fork belongs to the parent; replace it. */
+
+    if (asyncLogging.numRings >= FM_LOG_ASYNC_MAX_RINGS)
+    {
+        return NULL;
+    }
+
+    /* Process-local, so use the system allocator. */
+    ring = calloc( 1, sizeof(fm_logRing) );
+    if (ring == NULL)
+    {
+        return NULL;
+    }
+
+    ring->data = malloc(FM_LOG_ASYNC_RING_SIZE);
+    if (ring->data == NULL)
+    {
+        free(ring);
+        return NULL;
+    }
+
+    ring->threadId       = fmGetCurrentThreadId();
+    ring->forkGeneration = asyncLogging.forkGeneration;
+
+    /* Resolved once here rather than for every message. */
+    threadName = fmGetCurrentThreadName();
+
+    if (threadName != NULL)
+    {
+        fmStringCopy(ring->threadName, threadName, sizeof(ring->threadName));
+    }
+    else
+    {
+        FM_SNPRINTF_S(ring->threadName,
+                      sizeof(ring->threadName),
+                      "<%p>",
+                      ring->threadId);
+    }
+
+    pthread_mutex_lock(&asyncLogging.ringListLock);
+
+    if (asyncLogging.numRings >= FM_LOG_ASYNC_MAX_RINGS)
+    {
+        pthread_mutex_unlock(&asyncLogging.ringListLock);
+        free(ring->data);
+        free(ring);
+        return NULL;
+    }
+
+    /* The drainer walks the list without the lock, so the ring must be
+     * complete before it becomes reachable. */
+    ring->next = asyncLogging.rings;
+    __sync_synchronize();
+    asyncLogging.rings = ring;
+    asyncLogging.numRings++;
+
+    pthread_mutex_unlock(&asyncLogging.ringListLock);
+
+    if (pthread_setspecific(asyncLogging.ringKey, ring) != 0)
+    {
+        ring->orphaned = TRUE;
+        return NULL;
+    }
+
+    return ring;
+
+}   /* end GetLogRing */
+
+
+
+
+/*****************************************************************************/
+/** CaptureLogMessage
+ * \ingroup intLogging
+ *
+ * \desc            Appends a message to the calling thread's ring. The
+ *                  message is stored as its call site, timestamp and raw
+ *                  arguments; no formatting is done and no lock is taken.
+ *                  A message whose format cannot be deferred is formatted
+ *                  here and stored as text.
+ *
+ * \param[in]       logLevel is the log level of the message.
+ *
+ * \param[in]       srcFile is the name of the source code file generating
+ *                  the log message.
+ *
+ * \param[in]       srcFunction is the name of the source code function
+ *                  generating the log message.
+ *
+ * \param[in]       srcLine is the source code line number generating the
+ *                  log message.
+ *
+ * \param[in]       format is the printf-style format.
+ *
+ * \param[in]       ap is the printf var-args argument list. It is not
+ *                  consumed.
+ *
+ * \return          TRUE if the message was taken care of, including when
+ *                  it was dropped because the ring was full.
+ * \return          FALSE if the thread has no ring and the caller must
+ *                  write the message itself.
+ *
+ *****************************************************************************/
+static fm_bool CaptureLogMessage(fm_uint64   logLevel,
+                                 const char *srcFile,
+                                 const char *srcFunction,
+                                 fm_uint32   srcLine,
+                                 const char *format,
+                                 va_list     ap)
+{
+    fm_uint64     buffer[FM_LOG_ASYNC_MAX_RECORD / sizeof(fm_uint64)];
+    fm_logRecord *record;
+    fm_byte *     args;
+    fm_int        maxArgs;
+    fm_int        argSize;
+    fm_int        len;
+    fm_logRing *  ring;
+    va_list       argsCopy;
+    fm_uint64     tail;
+    fm_uint64     used;
+    fm_uint64     offset;
+    fm_uint64     pad;
+
+    ring = GetLogRing();
+
+    if (ring == NULL)
+    {
+        __sync_fetch_and_add(&asyncLogging.numNoRing, 1);
+        return FALSE;
+    }
+
+    record  = (fm_logRecord *) buffer;
+    args    = (fm_byte *) (record + 1);
+    maxArgs = sizeof(buffer) - sizeof(fm_logRecord);
+
+    va_copy(argsCopy, ap);
+    argSize = EncodeLogArguments(format, &argsCopy, args, maxArgs);
+    va_end(argsCopy);
+
+    if (argSize >= 0)
+    {
+        record->format = format;
+    }
+    else
+    {
+        va_copy(argsCopy, ap);
+        len = FM_VSNPRINTF_S( (fm_char *) (args + 8),
+                              maxArgs - 8,
+                              format,
+                              argsCopy );
+        va_end(argsCopy);
+
+        if (len < 0)
+        {
+            len = 0;
+        }
+        else if (len > maxArgs - 9)
+        {
+            /* Mark the message as cut, it is longer than a record */
+            len = maxArgs - 9;
+            FM_MEMCPY_S( (fm_char *) (args + 8) + len - 
+                             (sizeof(FM_LOG_ASYNC_CUT_MARK) - 1),
+                         sizeof(FM_LOG_ASYNC_CUT_MARK) - 1,
+                         FM_LOG_ASYNC_CUT_MARK,
+                         sizeof(FM_LOG_ASYNC_CUT_MARK) - 1 );
+            __sync_fetch_and_add(&asyncLogging.numTruncated, 1);
+        }
+
+        *( (fm_uint64 *) args ) = len;
+        argSize        = 8 + ( (len + 7) & ~7 );
+        record->format = NULL;
+    }
+
+    record->size        = sizeof(fm_logRecord) + argSize;
+    record->srcLine     = srcLine;
+    record->logLevel    = logLevel;
+    record->srcFile     = srcFile;
+    record->srcFunction = srcFunction;
+    fmGetTime(&record->timestamp);
+
+    /**************************************************
+     * Append the record. A record never straddles the
+     * end of the ring; the unused tail is marked with
+     * a zero-size header and skipped by the drainer.
+     **************************************************/
+
+    tail   = ring->tail;
+    used   = tail - ring->head;
+    offset = tail & (FM_LOG_ASYNC_RING_SIZE - 1);
+    pad    = (offset + record->size > FM_LOG_ASYNC_RING_SIZE) ?
+             (FM_LOG_ASYNC_RING_SIZE - offset) : 0;
+
+    if (used + pad + record->size > FM_LOG_ASYNC_RING_SIZE)
+    {
+        ring->numDropped++;
+        return TRUE;
+    }
+
+    if (pad != 0)
+    {
+        ( (fm_logRecord *) (ring->data + offset) )->size = 0;
+    }
+
+    FM_MEMCPY_S(ring->data + ( (tail + pad) & (FM_LOG_ASYNC_RING_SIZE - 1) ),
+                record->size,
+                record,
+                record->size);
+
+    __sync_synchronize();
+    ring->tail = tail + pad + record->size;
+    ring->numRecords++;
+
+    used += pad + record->size;
+
+    if (used > ring->highWater)
+    {
+        ring->highWater = used;
+    }
+
+    /* Wake the drainer early when the ring crosses half full. */
+    if ( (used > FM_LOG_ASYNC_RING_SIZE / 2) &&
+         (used - pad - record->size <= FM_LOG_ASYNC_RING_SIZE / 2) )
+    {
+        pthread_cond_signal(&asyncLogging.wakeCond);
+    }
+
+    return TRUE;
+
+}   /* end CaptureLogMessage */
+
+
+
+
+/*****************************************************************************/
+/** WriteDeferredMessage
+ * \ingroup intLogging
+ *
+ * \desc            Writes a message on behalf of the thread that logged
+ *                  it, with the preamble taken from its record.
+ *
+ * \note            The caller must hold the logging access lock.
+ *
+ * \param[in]       ls points to the logging state.
+ *
+ * \param[in]       record points to the record of the message.
+ *
+ * \param[in]       threadName is the name of the logging thread.
+ *
+ * \param[in]       format is the printf-style format.
+ *
+ * \param[in]       ... is the printf var-args argument list.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status WriteDeferredMessage(fm_loggingState *   ls,
+                                      const fm_logRecord *record,
+                                      fm_text             threadName,
+                                      const char *        format,
+                                      ...)
+{
+    fm_status status;
+    va_list   ap;
+
+    va_start(ap, format);
+    status = WriteLogMessage(ls,
+                             ls->logType,
+                             ls->verbosityMask,
+                             record->logLevel,
+                             &record->timestamp,
+                             threadName,
+                             record->srcFile,
+                             record->srcFunction,
+                             record->srcLine,
+                             format,
+                             ap);
+    va_end(ap);
+
+    return status;
+
+}   /* end WriteDeferredMessage */
+
+
+
+
+/*****************************************************************************/
+/** DrainLogRing
+ * \ingroup intLogging
+ *
+ * \desc            Formats and writes the messages held in one ring, and
+ *                  reports any messages the ring has dropped since the
+ *                  last call.
+ *
+ * \note            The caller must hold asyncLogging.drainLock.
+ *
+ * \param[in]       ls points to the logging state.
+ *
+ * \param[in]       ring points to the ring.
+ *
+ * \return          The number of messages consumed.
+ *
+ *****************************************************************************/
+static fm_int DrainLogRing(fm_loggingState *ls, fm_logRing *ring)
+{
+    fm_logRecord *record;
+    fm_logRecord  dropRecord;
+    fm_char       text[FM_LOG_ASYNC_MAX_TEXT];
+    fm_uint64     head;
+    fm_uint64     tail;
+    fm_uint64     offset;
+    fm_uint64     dropped;
+    fm_bool       filter;
+    fm_int        numConsumed;
+
+    numConsumed = 0;
+    head        = ring->head;
+    tail        = ring->tail;
+    __sync_synchronize();
+
+    while (head != tail)
+    {
+        offset = head & (FM_LOG_ASYNC_RING_SIZE - 1);
+        record = (fm_logRecord *) (ring->data + offset);
+
+        if (record->size == 0)
+        {
+            head += FM_LOG_ASYNC_RING_SIZE - offset;
+            continue;
+        }
+
+        /* Format outside the access lock. */
+        FormatLogRecord(record, text, sizeof(text));
+
+        pthread_mutex_lock( (pthread_mutex_t *) ls->accessLock );
+
+        filter = TRUE;
+
+        if (ls->functionFilter[0] != '\0')
+        {
+            filter = ApplyLoggingFilter(ls->functionFilter,
+                                        record->srcFunction);
+        }
+
+        if (filter && (ls->fileFilter[0] != '\0') )
+        {
+            filter = ApplyLoggingFilter(ls->fileFilter, record->srcFile);
+        }
+
+        if (filter)
+        {
+            WriteDeferredMessage(ls, record, ring->threadName, "%s", text);
+        }
+
+        pthread_mutex_unlock( (pthread_mutex_t *) ls->accessLock );
+
+        head += record->size;
+        numConsumed++;
+
+        /* Hand the space back to the producer. */
+        __sync_synchronize();
+        ring->head = head;
+    }
+
+    ring->head = head;
+
+    dropped = ring->numDropped;
+
+    if (dropped != ring->numDropsReported)
+    {
+        FM_CLEAR(dropRecord);
+        dropRecord.logLevel    = FM_LOG_LEVEL_WARNING;
+        dropRecord.srcFile     = __FILE__;
+        dropRecord.srcFunction = __func__;
+        dropRecord.srcLine     = __LINE__;
+        fmGetTime(&dropRecord.timestamp);
+
+        pthread_mutex_lock( (pthread_mutex_t *) ls->accessLock );
+        WriteDeferredMessage(ls,
+                             &dropRecord,
+                             ring->threadName,
+                             "%" FM_FORMAT_64 "u log messages dropped\n",
+                             dropped - ring->numDropsReported);
+        pthread_mutex_unlock( (pthread_mutex_t *) ls->accessLock );
+
+        ring->numDropsReported = dropped;
+    }
+
+    return numConsumed;
+
+}   /* end DrainLogRing */
+
+
+
+
+/*****************************************************************************/
+/** RemoveLogRing
+ * \ingroup intLogging
+ *
+ * \desc            Unlinks and frees the ring of a thread that has exited.
+ *
+ * \note            The caller must hold asyncLogging.drainLock, and the
+ *                  ring must be empty.
+ *
+ * \param[in]       ring points to the ring.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void RemoveLogRing(fm_logRing *ring)
+{
+    fm_logRing **link;
+
+    pthread_mutex_lock(&asyncLogging.ringListLock);
+
+    for (link = &asyncLogging.rings ; *link != NULL ; link = &(*link)->next)
+    {
+        if (*link == ring)
+        {
+            *link = ring->next;
+            asyncLogging.numRings--;
+            asyncLogging.retiredRecords += ring->numRecords;
+            asyncLogging.retiredDropped += ring->numDropped;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&asyncLogging.ringListLock);
+
+    free(ring->data);
+    free(ring);
+
+}   /* end RemoveLogRing */
+
+
+
+
+/*****************************************************************************/
+/** DrainLogRings
+ * \ingroup intLogging
+ *
+ * \desc            Writes out the messages held in all rings, and frees
+ *                  the rings of threads that have exited.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DrainLogRings(void)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_logRing *     ring;
+    fm_logRing *     next;
+    fm_int           numConsumed;
+
+    if ( !asyncLogging.initialized || !LOG_INITIALIZED(ls) )
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&asyncLogging.drainLock);
+
+    numConsumed = 0;
+
+    for (ring = asyncLogging.rings ; ring != NULL ; ring = next)
+    {
+        next = ring->next;
+
+        numConsumed += DrainLogRing(ls, ring);
+
+        if ( ring->orphaned && (ring->head == ring->tail) )
+        {
+            RemoveLogRing(ring);
+        }
+    }
+
+    asyncLogging.numDrains++;
+    asyncLogging.numDrained += numConsumed;
+
+    pthread_mutex_unlock(&asyncLogging.drainLock);
+
+}   /* end DrainLogRings */
+
+
+
+
+/*****************************************************************************/
+/** FlushThreadLogRing
+ * \ingroup intLogging
+ *
+ * \desc            Writes out the calling thread's deferred messages, if
+ *                  any, so that a message it writes in place does not
+ *                  overtake them.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FlushThreadLogRing(void)
+{
+    fm_logRing *ring;
+
+    if (!asyncLogging.ringKeyValid)
+    {
+        return;
+    }
+
+    ring = pthread_getspecific(asyncLogging.ringKey);
+
+    if ( (ring != NULL) &&
+         (ring->forkGeneration == asyncLogging.forkGeneration) &&
+         (ring->head != ring->tail) )
+    {
+        DrainLogRings();
+    }
+
+}   /* end FlushThreadLogRing */
+
+
+
+
+/*****************************************************************************/
+/** AsyncLoggingThread
+ * \ingroup intLogging
+ *
+ * \desc            Drainer thread of the asynchronous logging backend. It
+ *                  empties the rings every FM_LOG_ASYNC_DRAIN_NSEC, or
+ *                  sooner when a ring fills past half.
+ *
+ * \param[in]       args contains the thread handle.
+ *
+ * \return          NULL.
+ *
+ *****************************************************************************/
+static void *AsyncLoggingThread(void *args)
+{
+    fm_thread *     thread;
+    struct timespec deadline;
+
+    thread = FM_GET_THREAD_HANDLE(args);
+
+    while (!asyncLogging.stopRequested)
+    {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += FM_LOG_ASYNC_DRAIN_NSEC;
+
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        pthread_mutex_lock(&asyncLogging.wakeLock);
+
+        if (!asyncLogging.stopRequested)
+        {
+            pthread_cond_timedwait(&asyncLogging.wakeCond,
+                                   &asyncLogging.wakeLock,
+                                   &deadline);
+        }
+
+        pthread_mutex_unlock(&asyncLogging.wakeLock);
+
+        DrainLogRings();
+    }
+
+    fmExitThread(thread);
+
+    return NULL;
+
+}   /* end AsyncLoggingThread */
+
+
+
+
+/*****************************************************************************/
+/** GetAsyncLoggingDrops
+ * \ingroup intLogging
+ *
+ * \desc            Returns the number of messages dropped because a ring
+ *                  was full, over all threads of this process.
+ *
+ * \param           None.
+ *
+ * \return          The number of dropped messages.
+ *
+ *****************************************************************************/
+static fm_uint64 GetAsyncLoggingDrops(void)
+{
+    fm_logRing *ring;
+    fm_uint64   dropped;
+
+    if (!asyncLogging.initialized)
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&asyncLogging.drainLock);
+
+    dropped = asyncLogging.retiredDropped;
+
+    for (ring = asyncLogging.rings ; ring != NULL ; ring = ring->next)
+    {
+        dropped += ring->numDropped;
+    }
+
+    pthread_mutex_unlock(&asyncLogging.drainLock);
+
+    return dropped;
+
+}   /* end GetAsyncLoggingDrops */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkEmptyFunction
+ * \ingroup intLogging
+ *
+ * \desc            Baseline for ''fmDbgBenchmarkLogging'': a function with
+ *                  no logging.
+ *
+ * \param[in]       arg is ignored.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+static fm_status BenchmarkEmptyFunction(fm_int arg)
+{
+    FM_NOT_USED(arg);
+
+    return FM_OK;
+
+}   /* end BenchmarkEmptyFunction */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkCachedFunction
+ * \ingroup intLogging
+ *
+ * \desc            Function with entry and exit logging through the
+ *                  cached call sites of FM_LOG_ENTRY and FM_LOG_EXIT.
+ *
+ * \param[in]       arg is logged on entry.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+static fm_status BenchmarkCachedFunction(fm_int arg)
+{
+    FM_LOG_ENTRY(FM_LOG_CAT_LOGGING, "arg=%d\n", arg);
+
+    FM_NOT_USED(arg);
+
+    FM_LOG_EXIT(FM_LOG_CAT_LOGGING, FM_OK);
+
+}   /* end BenchmarkCachedFunction */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkUncachedFunction
+ * \ingroup intLogging
+ *
+ * \desc            Function with entry and exit logging through direct
+ *                  calls to ''fmLogMessage'', as FM_LOG_ENTRY and
+ *                  FM_LOG_EXIT expand to without the call site cache.
+ *
+ * \param[in]       arg is logged on entry.
+ *
+ * \return          FM_OK.
+ *
+ *****************************************************************************/
+static fm_status BenchmarkUncachedFunction(fm_int arg)
+{
+    fmLogMessage(FM_LOG_CAT_LOGGING,
+                 FM_LOG_LEVEL_FUNC_ENTRY,
+                 __FILE__,
+                 __func__,
+                 __LINE__,
+                 "Entering... arg=%d\n",
+                 arg);
+
+    fmLogMessage(FM_LOG_CAT_LOGGING,
+                 FM_LOG_LEVEL_FUNC_EXIT,
+                 __FILE__,
+                 __func__,
+                 __LINE__,
+                 "Exit Status %d (%s)\n",
+                 FM_OK,
+                 fmErrorMsg(FM_OK));
+
+    return FM_OK;
+
+}   /* end BenchmarkUncachedFunction */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkApiFunction
+ * \ingroup intLogging
+ *
+ * \desc            Calls a published function that logs its entry and exit
+ *                  with FM_LOG_ENTRY_API and FM_LOG_EXIT_API.
+ *
+ * \param[in]       arg is ignored.
+ *
+ * \return          The status of ''fmGetLoggingAttribute''.
+ *
+ *****************************************************************************/
+static fm_status BenchmarkApiFunction(fm_int arg)
+{
+    fm_bool enabled;
+
+    FM_NOT_USED(arg);
+
+    return fmGetLoggingAttribute(FM_LOG_ATTR_ENABLED,
+                                 sizeof(enabled),
+                                 &enabled);
+
+}   /* end BenchmarkApiFunction */
+
+
+
+
+/*****************************************************************************/
+/** LogMessage
+ * \ingroup intLogging
+ *
+ * \desc            Internal version of ''fmLogMessage'' and ''fmLogMessageV2''
+ * 
+ * \param[in]       filteredCategoryMask is the bitmask representing enabled
+ *                  logging categories when this function is invoked from
+ *                  ''fmLogMessageV2'' or is the bitmask representing enabled 
+ *                  categories for which legacy logging is enabled when invoked
+ *                  from ''fmLogMessage''.
+ * 
+ * \param[in]       categories is a bitmask of category flags (see
+ *                  ''Log Categories'') which indicate which categories this
+ *                  log message belongs to.
+ *
+ * \param[in]       logLevel is a bitmask of level flags (see
+ *                  ''Log Levels'') which indicate which log levels this
+ *                  log message belongs to.
+ *
+ * \param[in]       srcFile is the name of the source code file generating
+ *                  the log message. Usually invoked as __FILE__.
+ *
+ * \param[in]       srcFunction is the name of the source code function
+ *                  generating the log message. Usually invoked as __func__.
+ *
+ * \param[in]       srcLine is the source code line number generating the
+ *                  log message. Usually invoked as __LINE__.
+ *
+ * \param[in]       format is the printf-style format.
+ *
+ * \param[in]       ap is the printf var-args argument list.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status LogMessage( fm_uint64   filteredCategoryMask,
+                             fm_uint64   categories,
+                             fm_uint64   logLevel,
+                             const char *srcFile,
+                             const char *srcFunction,
+                             fm_uint32   srcLine,
+                             const char *format,
+                             va_list     ap)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_loggingType   logType;
+    fm_bool          enabled;
+    fm_text          threadName = NULL;
+    fm_uint64        levelMask;
+    fm_text          functionFilter;
+    fm_text          fileFilter;
+    fm_uint32        verbosityMask;
+    fm_bool          filter;
+    fm_bool          bypassFilter = FALSE;
+    int              posixErr;
+    fm_status        status = FM_OK;
+
+    if ( LOG_INITIALIZED(ls) )
+    {
+        levelMask      = ls->levelMask;
+        logType        = ls->logType;
+        enabled        = ls->enabled;
+        functionFilter = ls->functionFilter;
+        fileFilter     = ls->fileFilter;
+        verbosityMask  = ls->verbosityMask;
+    }
+    else
+    {
+        /* use defaults if the logging facility is not initialized */
+        levelMask    = FM_LOG_LEVEL_FATAL |
+                       FM_LOG_LEVEL_ERROR |
+                       FM_LOG_LEVEL_WARNING;
+        logType        = FM_LOG_TYPE_CONSOLE;
+        enabled        = TRUE;
+        functionFilter = NULL;
+        fileFilter     = NULL;
+        verbosityMask  = ~0;
+    }
+
+    if (logLevel & FM_LOG_LEVEL_DEFAULT )
+    {
+        /**************************************************
+         * Make sure FM_LOG_PRINT shows up unconditionally
+         * and unadorned and that error messages aren't 
+         * inadvertently suppressed 
+         **************************************************/
+        
+        if ( logLevel & FM_LOG_LEVEL_PRINT )
+        {
+            verbosityMask         = 0;
+            categories            = FM_LOG_CAT_LOGGING;
+        }
+
+        enabled               = TRUE;
+        levelMask             = logLevel;
+        filteredCategoryMask  = FM_LOG_CAT_ALL;
+        bypassFilter          = TRUE;
+    }
+
+    /**************************************************
+     * Generate log output if the log level is set to
+     * the print unconditionally, or if the logging
+     * system is enabled and we have a category and
+     * level match.
+     **************************************************/
 
-                case FM_LOG_TYPE_MEMBUF:
-                    {
-                        fm_int lineLen;
-                        fm_int elemLen;
-                        lineLen = 0;
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(ls->logBuffer[ls->currentPos],
-                                                          FM_LOG_MAX_LINE_SIZE,
-                                                          "%s:",
-                                                          dateStr) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(ls->logBuffer[ls->currentPos],
-                                                          FM_LOG_MAX_LINE_SIZE,
-                                                          "%s:",
-                                                          timeStampStr) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
-
-                        if ( (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL) &&
-                             lineLen < FM_LOG_MAX_LINE_SIZE )
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                                          FM_LOG_MAX_LINE_SIZE - lineLen,
-                                                          "%s:",
-                                                          logLevelStr) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
-
-                        if ( (verbosityMask & FM_LOG_VERBOSITY_THREAD) &&
-                             lineLen < FM_LOG_MAX_LINE_SIZE )
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                                          FM_LOG_MAX_LINE_SIZE - lineLen,
-                                                          "%s:",
-                                                          threadName) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
-
-                        if ( (verbosityMask & FM_LOG_VERBOSITY_FILE) &&
-                             lineLen < FM_LOG_MAX_LINE_SIZE )
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                                          FM_LOG_MAX_LINE_SIZE - lineLen,
-                                                          "%s:",
-                                                          srcFile) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
-
-                        if ( (verbosityMask & FM_LOG_VERBOSITY_FUNC) &&
-                             lineLen < FM_LOG_MAX_LINE_SIZE )
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                                          FM_LOG_MAX_LINE_SIZE - lineLen,
-                                                          "%s:",
-                                                          srcFunction) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
-
-                        }
- 
-                        if ( (verbosityMask & FM_LOG_VERBOSITY_LINE) &&
-                             lineLen < FM_LOG_MAX_LINE_SIZE )
-                        {
-                            if ( (elemLen = FM_SNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                                          FM_LOG_MAX_LINE_SIZE - lineLen,
-                                                          "%d:",
-                                                          srcLine) ) > 0 )
-                            {
-                                lineLen += elemLen;
-                            }
- 
-                        }
- 
-                        if (lineLen < FM_LOG_MAX_LINE_SIZE)
-                        {
-                            FM_VSNPRINTF_S(&ls->logBuffer[ls->currentPos][lineLen],
-                                           FM_LOG_MAX_LINE_SIZE - lineLen,
-                                           format,
-                                           ap);
-                        }
-
-                        if (++ls->currentPos >= FM_LOG_MAX_LINES)
-                        {
-                            ls->currentPos = 0;
-
-                            FM_LOG_INFO(FM_LOG_CAT_LOGGING,
-                                        "-- Log Buffer Wrapped --\n");
-                        }
+    if ( enabled &&
+         (filteredCategoryMask & categories) != 0 &&
+         ( (levelMask & logLevel) == logLevel ) )
+    {
 
-                        break;
-                    }
+        /**************************************************
+         * In asynchronous mode, record the message in this
+         * thread's ring and leave the formatting, the
+         * secondary filters and the output to the drainer
+         * thread. Messages that bypass the filters (errors
+         * and FM_LOG_PRINT) are always written in place,
+         * after the thread's deferred messages.
+         **************************************************/
 
-                case FM_LOG_TYPE_CALLBACK:
+        if ( asyncLogging.active && LOG_INITIALIZED(ls) )
+        {
+            if (bypassFilter)
+            {
+                FlushThreadLogRing();
+            }
+            else if ( CaptureLogMessage(logLevel,
+                                        srcFile,
+                                        srcFunction,
+                                        srcLine,
+                                        format,
+                                        ap) )
+            {
+                return FM_OK;
+            }
+        }
 
-                    status = fmIsMasterProcess(&isMasterProcess);
-                    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_LOGGING,status);
+        if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
+        {
+            /* Get the thread name before taking the access lock, to avoid
+             * possible lock inversion. */
+            threadName = fmGetCurrentThreadName();
+        }
 
-                    if (ls->fmLogCallback && isMasterProcess)
-                    {
-                        if (verbosityMask & FM_LOG_VERBOSITY_DATE_TIME)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          dateStr);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_TIMESTAMP)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          timeStampStr);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_LOG_LEVEL)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          logLevelStr);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_THREAD)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          threadName);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_FILE)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          srcFile);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_FUNC)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%s:",
-                                          srcFunction);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        if (verbosityMask & FM_LOG_VERBOSITY_LINE)
-                        {
-                            FM_SNPRINTF_S(callBackStr,
-                                          sizeof(callBackStr),
-                                          "%d:",
-                                          srcLine);
-                            ls->fmLogCallback(callBackStr,
-                                              ls->fmLogCookie1,
-                                              ls->fmLogCookie2);
-                        }
-
-                        FM_VSNPRINTF_S(callBackStr, sizeof(callBackStr), format, ap);
-                        ls->fmLogCallback(callBackStr,
-                                          ls->fmLogCookie1,
-                                          ls->fmLogCookie2);
-
-                    }   /* end if (ls->fmLogCallback) */
+        if ( LOG_INITIALIZED(ls) )
+        {
+            posixErr = pthread_mutex_lock( (pthread_mutex_t *) ls->accessLock );
+            if (posixErr != 0)
+            {
+                FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_ERR_UNABLE_TO_LOCK);
+            }
+        }
 
-                    break;
+        /* check secondary filters */
+        filter = TRUE;
 
-            }   /* end switch (logType) */
+        if (!bypassFilter)
+        {
+            if (filter && functionFilter && *functionFilter)
+            {
+                filter = ApplyLoggingFilter(functionFilter, srcFunction);
+            }
+    
+            if (filter && fileFilter && *fileFilter)
+            {
+                filter = ApplyLoggingFilter(fileFilter, srcFile);
+            }
+        }
+        
+        if (filter)
+        {
+            status = WriteLogMessage(ls,
+                                     logType,
+                                     verbosityMask,
+                                     logLevel,
+                                     NULL,
+                                     threadName,
+                                     srcFile,
+                                     srcFunction,
+                                     srcLine,
+                                     format,
+                                     ap);
 
         }   /* end if (filter) */
 
@@ -699,9 +2662,9 @@ static fm_status LogMessage( fm_uint64   filteredCategoryMask,
 
     }
 
-    return FM_OK;
+    return status;
 
-}   /* end fmLogMessage */
+}   /* end LogMessage */
 
 
 
@@ -754,6 +2717,8 @@ fm_status fmAlosLoggingInit(void)
     ls->functionFilter[0] = 0;
     ls->fileFilter[0] = 0;
 
+    ls->callSiteGeneration = 1;
+
     if ( pthread_mutexattr_init(&attr) )
     {
         FM_LOG_EXIT(FM_LOG_CAT_LOGGING, FM_ERR_LOCK_INIT);
@@ -822,6 +2787,7 @@ fm_status fmLoggingEnable()
     }
 
     ls->enabled = TRUE;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -855,6 +2821,7 @@ fm_status fmLoggingDisable()
     }
 
     ls->enabled = FALSE;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -1099,6 +3066,7 @@ fm_status fmEnableLoggingCategory(fm_uint64 categories)
     }
 
     ls->categoryMask |= categories;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -1135,6 +3103,7 @@ fm_status fmDisableLoggingCategory(fm_uint64 categories)
     }
 
     ls->categoryMask &= ~categories;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -1171,6 +3140,7 @@ fm_status fmEnableLoggingLevel(fm_uint64 levels)
     }
 
     ls->levelMask |= levels;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -1207,6 +3177,7 @@ fm_status fmDisableLoggingLevel(fm_uint64 levels)
     }
 
     ls->levelMask &= ~levels;
+    InvalidateLogCallSites(ls);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
@@ -1287,6 +3258,8 @@ fm_status fmSetLoggingFilter(fm_uint64   categoryMask,
         ls->fileFilter[0] = 0;
     }
 
+    InvalidateLogCallSites(ls);
+
     posixErr = pthread_mutex_unlock( (pthread_mutex_t *) ls->accessLock );
     if (posixErr != 0)
     {
@@ -1425,6 +3398,9 @@ fm_status fmLogBufferDump(void *    threadID,
         return FM_ERR_UNINITIALIZED;
     }
 
+    /* Write out deferred messages so that the buffer is complete. */
+    DrainLogRings();
+
     if (threadID)
     {
         FM_SNPRINTF_S(idTmp, sizeof(idTmp), "<%p", threadID);
@@ -1511,6 +3487,9 @@ fm_status fmGetLogBuffer(fm_text buffer, fm_int size)
         return FM_ERR_UNINITIALIZED;
     }
 
+    /* Write out deferred messages so that the buffer is complete. */
+    DrainLogRings();
+
     position = ls->currentPos;
 
     cursor = buffer;
@@ -1623,6 +3602,14 @@ fm_status fmGetLoggingAttribute(fm_int  attr,
             fmStringCopy( (char *) value, ls->logFileName, size );
             break;
 
+        case FM_LOG_ATTR_ASYNC:
+            *( (fm_bool *) value ) = asyncLogging.active;
+            break;
+
+        case FM_LOG_ATTR_ASYNC_DROPPED:
+            *( (fm_uint64 *) value ) = GetAsyncLoggingDrops();
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
@@ -1675,6 +3662,8 @@ fm_status fmResetLogging(void)
     ls->functionFilter[0] = 0;
     ls->fileFilter[0] = 0;
 
+    InvalidateLogCallSites(ls);
+
     FM_LOG_EXIT_API(FM_LOG_CAT_LOGGING, FM_OK);
 
 }   /* end fmResetLogging */
@@ -1943,6 +3932,104 @@ fm_status fmLogMessageV2( fm_uint64   category,
 
 
 
+/*****************************************************************************/
+/** fmLogCallSiteEnabled
+ * \ingroup intLogging
+ *
+ * \desc            Decides whether an FM_LOG_FUNC call site is enabled and
+ *                  caches the decision in the call site. Called by the
+ *                  macro only when the cached decision is not a current
+ *                  "disabled".
+ *
+ * \param[in,out]   siteState points to the call site's cached state: the
+ *                  configuration generation shifted left by one, with the
+ *                  enabled flag in bit 0.
+ *
+ * \param[in]       categories is the category mask of the call site.
+ *
+ * \param[in]       logLevel is the log level of the call site.
+ *
+ * \param[in]       legacy is TRUE for ''fmLogMessage'' call sites, which are
+ *                  also subject to the legacy logging mask, and FALSE for
+ *                  ''fmLogMessageV2'' call sites, which log against their
+ *                  lowest category only.
+ *
+ * \param[in]       srcFile is the source file of the call site.
+ *
+ * \param[in]       srcFunction is the function of the call site.
+ *
+ * \return          TRUE if the message should be passed to the logging
+ *                  function.
+ *
+ *****************************************************************************/
+fm_bool fmLogCallSiteEnabled(fm_uint32 * siteState,
+                             fm_uint64   categories,
+                             fm_uint64   logLevel,
+                             fm_bool     legacy,
+                             const char *srcFile,
+                             const char *srcFunction)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_uint32        generation;
+    fm_uint64        categoryMask;
+    fm_bool          enabled;
+
+    /* Leave the defaults to the logging function and cache nothing. */
+    if ( !LOG_INITIALIZED(ls) || (logLevel & FM_LOG_LEVEL_DEFAULT) )
+    {
+        return TRUE;
+    }
+
+    if (fmLogCallSiteGeneration != &ls->callSiteGeneration)
+    {
+        fmLogCallSiteGeneration = &ls->callSiteGeneration;
+    }
+
+    generation = ls->callSiteGeneration;
+
+    if ( *siteState == ( (generation << 1) | 1 ) )
+    {
+        return TRUE;
+    }
+
+    /* Read the settings after the generation, so that a concurrent change
+     * leaves a stale generation in the cache rather than a stale state. */
+    __sync_synchronize();
+
+    categoryMask = ls->categoryMask;
+
+    if (legacy)
+    {
+        categoryMask &= ls->legacyLoggingMask;
+    }
+    else
+    {
+        categories &= -categories;
+    }
+
+    enabled = ls->enabled &&
+              ( (categoryMask & categories) != 0 ) &&
+              ( (ls->levelMask & logLevel) == logLevel );
+
+    if ( enabled && (ls->functionFilter[0] != '\0') )
+    {
+        enabled = ApplyLoggingFilter(ls->functionFilter, srcFunction);
+    }
+
+    if ( enabled && (ls->fileFilter[0] != '\0') )
+    {
+        enabled = ApplyLoggingFilter(ls->fileFilter, srcFile);
+    }
+
+    *siteState = (generation << 1) | (enabled ? 1 : 0);
+
+    return enabled;
+
+}   /* end fmLogCallSiteEnabled */
+
+
+
+
 /*****************************************************************************/
 /** fmSetLoggingCategoryConfig
  * \ingroup alosLog
@@ -2030,6 +4117,8 @@ fm_status fmSetLoggingCategoryConfig( fm_uint64           categoryMask,
     {
         ls->legacyLoggingMask &= ~(FM_LITERAL_U64(1) << category);
     }
+
+    InvalidateLogCallSites(ls);
      
     return FM_OK;
 
@@ -2138,6 +4227,354 @@ fm_status fmGetLoggingCategoryConfig( fm_uint64            categoryMask,
 
 
 
+/*****************************************************************************/
+/** fmSetLoggingAsync
+ * \ingroup alosLog
+ *
+ * \desc            Enables or disables asynchronous logging for this
+ *                  process. When enabled, a message that passes the
+ *                  category and level checks is stored, unformatted, in a
+ *                  ring belonging to the logging thread, and is formatted,
+ *                  filtered and written by a drainer thread. The logging
+ *                  thread takes no lock. Error-level and FM_LOG_PRINT
+ *                  messages are still written in place.
+ *                                                                      \lb\lb
+ *                  A thread whose ring is full drops its messages; the
+ *                  drainer reports how many were lost.
+ *                                                                      \lb\lb
+ *                  A deferred message, including its copied string
+ *                  arguments, is limited to about 1 KB. A longer message
+ *                  is cut and ends with "...", and is counted in the
+ *                  ''fmDbgDumpAsyncLogging'' output. Messages written in
+ *                  place are not limited.
+ *
+ * \note            In asynchronous mode the format, the source file name
+ *                  and the function name are referenced, not copied, and
+ *                  must remain valid until the message is written. This
+ *                  holds for string literals and __FILE__/__func__.
+ *                  Call ''fmFlushLogging'' or disable asynchronous logging
+ *                  before the process exits, or pending messages are lost.
+ *
+ * \param[in]       enable is TRUE to defer messages, FALSE to write them in
+ *                  place. Disabling writes out all pending messages.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the logging subsystem has not been
+ *                  initialized.
+ * \return          FM_FAIL if the drainer thread could not be created.
+ *
+ *****************************************************************************/
+fm_status fmSetLoggingAsync(fm_bool enable)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_status        err = FM_OK;
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    pthread_once(&asyncLoggingOnce, InitAsyncLogging);
+
+    if (!asyncLogging.ringKeyValid)
+    {
+        return FM_FAIL;
+    }
+
+    pthread_mutex_lock(&asyncLogging.controlLock);
+
+    if (enable && !asyncLogging.active)
+    {
+        asyncLogging.stopRequested = FALSE;
+
+        err = fmCreateThread("Log Drainer",
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             AsyncLoggingThread,
+                             NULL,
+                             &asyncLogging.drainer);
+
+        if (err == FM_OK)
+        {
+            /* fmExitThread frees the fm_thread handle, so keep a copy for
+             * pthread_join. */
+            asyncLogging.drainerHandle = *( (pthread_t *) asyncLogging.drainer.handle );
+            asyncLogging.active        = TRUE;
+        }
+    }
+    else if (!enable && asyncLogging.active)
+    {
+        asyncLogging.active = FALSE;
+
+        pthread_mutex_lock(&asyncLogging.wakeLock);
+        asyncLogging.stopRequested = TRUE;
+        pthread_cond_signal(&asyncLogging.wakeCond);
+        pthread_mutex_unlock(&asyncLogging.wakeLock);
+
+        pthread_join(asyncLogging.drainerHandle, NULL);
+
+        /* Catch messages deferred while the drainer was exiting. */
+        DrainLogRings();
+    }
+
+    pthread_mutex_unlock(&asyncLogging.controlLock);
+
+    return err;
+
+}   /* end fmSetLoggingAsync */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushLogging
+ * \ingroup alosLog
+ *
+ * \desc            Writes out all messages held by the asynchronous logging
+ *                  backend, in the calling thread. Has no effect when
+ *                  asynchronous logging has never been enabled.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNINITIALIZED if the logging subsystem has not been
+ *                  initialized.
+ *
+ *****************************************************************************/
+fm_status fmFlushLogging(void)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+    DrainLogRings();
+
+    return FM_OK;
+
+}   /* end fmFlushLogging */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpAsyncLogging
+ * \ingroup diagMisc
+ *
+ * \desc            Displays the state of the asynchronous logging backend
+ *                  and the occupancy and drop counts of each thread's ring.
+ *
+ * \param           None.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgDumpAsyncLogging(void)
+{
+    typedef struct
+    {
+        fm_char   threadName[64];
+        fm_uint64 numRecords;
+        fm_uint64 numDropped;
+        fm_uint64 used;
+        fm_uint64 highWater;
+        fm_bool   orphaned;
+
+    } ringSnapshot;
+
+    ringSnapshot snapshot[FM_LOG_ASYNC_MAX_RINGS];
+    fm_logRing * ring;
+    fm_int       numRings;
+    fm_int       i;
+    fm_uint64    retiredRecords;
+    fm_uint64    retiredDropped;
+    fm_uint64    numDrains;
+    fm_uint64    numDrained;
+
+    FM_LOG_PRINT("Asynchronous logging: %s\n",
+                 asyncLogging.active ? "enabled" : "disabled");
+
+    if (!asyncLogging.initialized)
+    {
+        return;
+    }
+
+    /**************************************************
+     * Copy the counters first; printing may itself
+     * drain the rings.
+     **************************************************/
+
+    pthread_mutex_lock(&asyncLogging.drainLock);
+
+    numRings = 0;
+
+    for (ring = asyncLogging.rings ;
+         (ring != NULL) && (numRings < FM_LOG_ASYNC_MAX_RINGS) ;
+         ring = ring->next)
+    {
+        fmStringCopy(snapshot[numRings].threadName,
+                     ring->threadName,
+                     sizeof(snapshot[numRings].threadName));
+        snapshot[numRings].numRecords = ring->numRecords;
+        snapshot[numRings].numDropped = ring->numDropped;
+        snapshot[numRings].used       = ring->tail - ring->head;
+        snapshot[numRings].highWater  = ring->highWater;
+        snapshot[numRings].orphaned   = ring->orphaned;
+        numRings++;
+    }
+
+    retiredRecords = asyncLogging.retiredRecords;
+    retiredDropped = asyncLogging.retiredDropped;
+    numDrains      = asyncLogging.numDrains;
+    numDrained     = asyncLogging.numDrained;
+
+    pthread_mutex_unlock(&asyncLogging.drainLock);
+
+    FM_LOG_PRINT("  Ring size %d bytes, %d rings, %" FM_FORMAT_64 "u drains, "
+                 "%" FM_FORMAT_64 "u messages written\n",
+                 FM_LOG_ASYNC_RING_SIZE,
+                 numRings,
+                 numDrains,
+                 numDrained);
+    FM_LOG_PRINT("  Exited threads: %" FM_FORMAT_64 "u messages, "
+                 "%" FM_FORMAT_64 "u dropped\n",
+                 retiredRecords,
+                 retiredDropped);
+    FM_LOG_PRINT("  Written in place for lack of a ring: %" FM_FORMAT_64 "u\n",
+                 asyncLogging.numNoRing);
+    FM_LOG_PRINT("  Cut for exceeding %d bytes: %" FM_FORMAT_64 "u\n",
+                 FM_LOG_ASYNC_MAX_RECORD,
+                 asyncLogging.numTruncated);
+
+    FM_LOG_PRINT("\n  %-24s %12s %10s %8s %8s\n",
+                 "Thread", "Messages", "Dropped", "Used", "Peak");
+
+    for (i = 0 ; i < numRings ; i++)
+    {
+        FM_LOG_PRINT("  %-24s %12" FM_FORMAT_64 "u %10" FM_FORMAT_64 "u "
+                     "%8" FM_FORMAT_64 "u %8" FM_FORMAT_64 "u%s\n",
+                     snapshot[i].threadName,
+                     snapshot[i].numRecords,
+                     snapshot[i].numDropped,
+                     snapshot[i].used,
+                     snapshot[i].highWater,
+                     snapshot[i].orphaned ? " (exited)" : "");
+    }
+
+}   /* end fmDbgDumpAsyncLogging */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgBenchmarkLogging
+ * \ingroup intDiag
+ *
+ * \desc            Times the cost of function entry and exit logging under
+ *                  the current logging configuration. Compares a function
+ *                  without logging, one using the cached FM_LOG_ENTRY and
+ *                  FM_LOG_EXIT call sites, one calling ''fmLogMessage''
+ *                  directly, and a published API function.
+ *                                                                      \lb\lb
+ *                  Run it with the function entry and exit levels disabled
+ *                  to measure the overhead of logging that is compiled in
+ *                  but turned off.
+ *
+ * \param[in]       iterations is the number of calls to time per function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if iterations is not positive.
+ * \return          FM_ERR_UNINITIALIZED if the logging subsystem has not been
+ *                  initialized.
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkLogging(fm_int iterations)
+{
+    fm_loggingState *ls = GET_LOGGING_STATE();
+    fm_status        (* volatile func)(fm_int);
+    fm_timestamp     start;
+    fm_timestamp     end;
+    fm_timestamp     elapsed;
+    fm_uint64        nsec;
+    fm_status        status;
+    fm_int           i;
+    fm_int           j;
+
+    static const struct
+    {
+        fm_text   name;
+        fm_status (*func)(fm_int);
+
+    } benchmarks[] =
+    {
+        { "no logging",              BenchmarkEmptyFunction    },
+        { "cached entry/exit",       BenchmarkCachedFunction   },
+        { "fmLogMessage entry/exit", BenchmarkUncachedFunction },
+        { "fmGetLoggingAttribute",   BenchmarkApiFunction      },
+    };
+
+    if (iterations <= 0)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( !LOG_INITIALIZED(ls) )
+    {
+        return FM_ERR_UNINITIALIZED;
+    }
+
+#ifdef FM_ALOS_FUNCTION_LOGGING
+    FM_LOG_PRINT("Logging benchmark: %d iterations, function logging "
+                 "compiled in, entry/exit levels %s\n",
+                 iterations,
+                 (ls->enabled &&
+                  (ls->levelMask & (FM_LOG_LEVEL_FUNC_ENTRY |
+                                    FM_LOG_LEVEL_FUNC_EXIT))) ?
+                 "enabled" : "disabled");
+#else
+    FM_LOG_PRINT("Logging benchmark: %d iterations, function logging "
+                 "compiled out\n",
+                 iterations);
+#endif
+
+    FM_LOG_PRINT("\n%-24s %12s\n", "Function", "ns/call");
+
+    status = FM_OK;
+
+    for (j = 0 ; j < (fm_int) FM_NENTRIES(benchmarks) ; j++)
+    {
+        /* Called through a volatile pointer so it is not inlined. */
+        func = benchmarks[j].func;
+
+        /* The first call fills the call site caches. */
+        status |= func(0);
+
+        fmGetTime(&start);
+
+        for (i = 0 ; i < iterations ; i++)
+        {
+            status |= func(i);
+        }
+
+        fmGetTime(&end);
+        fmSubTimestamps(&end, &start, &elapsed);
+
+        nsec = (elapsed.sec * 1000000 + elapsed.usec) * 1000;
+
+        FM_LOG_PRINT("%-24s %8" FM_FORMAT_64 "u.%02" FM_FORMAT_64 "u\n",
+                     benchmarks[j].name,
+                     nsec / iterations,
+                     (nsec * 100 / iterations) % 100);
+    }
+
+    return (status == FM_OK) ? FM_OK : FM_FAIL;
+
+}   /* end fmDbgBenchmarkLogging */
+
+
+
+
 #if defined(FM_ALOS_FAULT_INJECTION_POINTS) && (FM_ALOS_FAULT_INJECTION_POINTS)
 
 /*****************************************************************************/
@@ -40,6 +40,10 @@
 #define NANOSECS_PER_SECOND     1000000000L
 #define TIMER_MAGIC_NUMBER      0xA87FCA3B
 
+/* duration of a wheel tick for event-driven timer tasks, in microseconds.
+ * Periodic timer tasks tick once per period. */
+#define TIMER_WHEEL_TICK_USEC   100
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -66,9 +70,24 @@ static fm_status CreateTimerCondition( void **cond );
 static fm_status DeleteTimerCondition( void *cond );
 static fm_status WakeupTimerTask( fm_timerTask *task );
 static fm_status SuspendTimerTask( fm_timerTask *task, fm_timestamp *timeout );
+static fm_uint64 TimestampToTick( fm_timerTask *task, 
+                                  fm_timestamp *ts, 
+                                  fm_bool       roundUp );
+static void      TickToTimestamp( fm_timerTask *task, 
+                                  fm_uint64     tick, 
+                                  fm_timestamp *ts );
+static void      InsertTimerInWheel( fm_timerTask *task, fm_timer *timer );
+static void      RemoveTimerFromWheel( fm_timerTask *task, fm_timer *timer );
+static void      CascadeWheelLevel( fm_timerTask *task, fm_int level );
+static fm_bool   GetNextWheelTick( fm_timerTask *task, fm_uint64 *tick );
+static fm_int    ProcessWheelTick( fm_timerTask *task );
+static fm_status ProcessActiveTimers( fm_timerTask *task, 
+                                      fm_timestamp *now,
+                                      fm_bool      *lockTaken );
 static fm_status AddActiveTimerToTask( fm_timerTask *task, fm_timer *timer );
 static fm_status StopTimer( fm_timer *timer );
 static void      PrintDbgRuler( void );
+static void      PrintDbgTimer( fm_timer *timer );
 
 /*****************************************************************************
  * Local Functions
@@ -173,14 +192,14 @@ static void *PeriodicTimerLoop( void *args )
     fm_timestamp  next;
     fm_status     status;
     fm_bool       timerLockTaken = FALSE;
-    fm_timer      *timer;
 
     /* grab arguments */
     thisThread =  FM_GET_THREAD_HANDLE( args );
     task       =  FM_GET_THREAD_PARAM( fm_timerTask, args );
 
-    /* schedule the first check one period from now */
-    fmGetTime( &next );
+    /* schedule the first check one period, i.e. one wheel tick, from the
+       start of the wheel */
+    next = task->wheelBase;
     fmAddTimestamps( &next, &task->period );
 
     /* signal that the initialization is complete */
@@ -202,55 +221,8 @@ static void *PeriodicTimerLoop( void *args )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
         timerLockTaken = TRUE;
 
-        timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        while ( timer && fmCompareTimestamps( &next, &timer->end ) >= 0 )
-        {
-            /* remove the timer only if no longer active, i.e.
-               if this was the last or only repetition, otherwise
-               put it back in the list of active timers but in
-               the right position */
-
-            FM_DLL_REMOVE_NODE( task, 
-                                firstActiveTimer,
-                                lastActiveTimer,
-                                timer,
-                                nextActiveTimer,
-                                prevActiveTimer );
-
-            /* is this the last repetition? */
-            timer->nrRepetitionsSoFar++;
-            if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
-                 ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
-            {
-                /* yes, this timer is no longer active */
-                timer->running = FALSE;
-            }
-            else
-            {
-                /* no, compute the next expiraration date and
-                   add the timer back in the active timer list
-                   for this task */
-                timer->start = timer->end;
-                fmAddTimestamps( &timer->end, &timer->timeout );
-                AddActiveTimerToTask( task, timer );
-            }
-
-            /* execute the callback, but release the lock temporarily
-               to prevent lock inversion problems */
-            status = fmReleaseLock( &task->lock );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-            timerLockTaken = FALSE;
-
-            /* ignore the return code, we can't give up for a caller error */
-            timer->callback( timer->arg );
-
-            /* grab the lock again and move on to the next active timer */
-            status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-            timerLockTaken = TRUE;
-
-            timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        }
+        status = ProcessActiveTimers( task, &next, &timerLockTaken );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
 
         status = fmReleaseLock( &task->lock );
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
@@ -297,7 +269,7 @@ static void *EventDrivenTimerLoop( void *args )
     fm_timestamp   *timeout;
     fm_timestamp   curTime;
     fm_status      status;
-    fm_timer       *timer;
+    fm_uint64      nextTick;
     fm_bool        timerLockTaken = FALSE;
     fm_timerTask   *task;
 
@@ -328,21 +300,13 @@ static void *EventDrivenTimerLoop( void *args )
         }
 
         /******************************************************
-         * Here's where we need to process the list of 
-         * timers handled by this thread. There are two cases: 
-         *  
-         * Case 1:
-         *  The timeout was NULL (infinite wait) or hasn't 
-         *  expired yet. That means we've been woken up by one
-         *  of these functions: fmStartTimer(), fmStopTimer()
-         *  or fmDeleteTimer(). In those cases we simply need
-         *  to check if there is a new timeout (indicating
-         *  the head of the list has changed) and suspend again
-         *  
-         * Case 2: 
-         *  The timeout has expired. In that case we need to 
-         *  process all the expired timers before suspending 
-         *  again. 
+         * Here's where we need to process the timing wheel
+         * of this thread. Whether the timeout has expired or
+         * we've been woken up by fmStartTimer() for an
+         * earlier timer or by fmDeleteTimerTask(), all the
+         * ticks up to the current time are processed, then
+         * we suspend again until the next tick holding
+         * timers.
          ******************************************************/
 
         status = fmGetTime( &curTime );
@@ -353,73 +317,22 @@ static void *EventDrivenTimerLoop( void *args )
                          "ERROR: fmGetTime: status = %d\n", status);
         }
 
-        timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        if ( timeout == NULL || fmCompareTimestamps( &curTime, timeout ) < 0 )
+        status = ProcessActiveTimers( task, &curTime, &timerLockTaken );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+
+        /* next cycle: wake up at the next tick holding timers. if the
+           wheel is empty then we'll block until signalled otherwise */
+        if ( GetNextWheelTick( task, &nextTick ) )
         {
-            /* Case 1 */
-            timeout = ( (timer != NULL) ? &timer->end : NULL );
-            continue;
+            task->wakeTick = nextTick;
+            TickToTimestamp( task, nextTick, &task->wakeTime );
+            timeout = &task->wakeTime;
         }
         else
         {
-            /* Case 2  */
-            while ( timer && fmCompareTimestamps( &curTime, &timer->end ) >= 0 ) 
-            {
-                /* remove the timer only if no longer active, i.e.
-                   if this was the last or only repetition, otherwise
-                   put it back in the list of active timers but in
-                   the right position */
-
-                FM_DLL_REMOVE_NODE( task, 
-                                    firstActiveTimer,
-                                    lastActiveTimer,
-                                    timer,
-                                    nextActiveTimer,
-                                    prevActiveTimer );
-
-                /* is this the last repetition? */
-                timer->nrRepetitionsSoFar++;
-                if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
-                     ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
-                {
-                    /* yes, this timer is no longer active */
-                    timer->running = FALSE;
-                }
-                else
-                {
-                    /* no, compute the next expiraration date and
-                       add the timer back in the active timer list
-                       for this task */
-                    timer->start = timer->end;
-                    fmAddTimestamps( &timer->end, &timer->timeout );
-                    AddActiveTimerToTask( task, timer );
-                }
-
-                /* execute the callback, but release the lock temporarily
-                   to prevent lock inversion problems */
-                status = fmReleaseLock( &task->lock );
-                FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-                timerLockTaken = FALSE;
-
-                /* ignore the return code, we can't give up for a caller error */
-                timer->callback( timer->arg );
-
-                /* grab the lock again and move on to the next active timer */
-                status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
-                FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-                timerLockTaken = TRUE;
-
-                /* check next timer now */
-                timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-
-            }   /* end while ( timer && ... ) */
-
-            /* next cycle: next timeout belongs to the  head of the active
-               timer list associated with this timer task. if the list is
-               empty then we'll block until signalled otherwise */
-            timeout = ( (timer != NULL) ? &timer->end : NULL );
-
-        }  /* end else  (i.e. one or more timers have expired ) */
+            task->wakeTick = ~0ULL;
+            timeout = NULL;
+        }
 
     }   /* end while (TRUE) i.e. timer thread main loop */
 
@@ -674,54 +587,575 @@ static fm_status SuspendTimerTask( fm_timerTask *task, fm_timestamp *timeout )
 
 
 /*****************************************************************************/
-/** AddActiveTimerToTask
+/** TimestampToTick
+ * \ingroup intTimer
+ *
+ * \desc            Converts an absolute time into a tick of the timing wheel
+ *                  of a given timer task.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       ts is the pointer to the absolute time to convert.
+ * 
+ * \param[in]       roundUp is TRUE to return the first tick starting at or
+ *                  after ts, FALSE to return the tick ts falls in.
+ *
+ * \return          The wheel tick.
+ * 
+ *****************************************************************************/
+static fm_uint64 TimestampToTick( fm_timerTask *task, 
+                                  fm_timestamp *ts, 
+                                  fm_bool       roundUp )
+{
+    fm_timestamp delta;
+    fm_uint64    usec;
+
+    if ( fmCompareTimestamps( ts, &task->wheelBase ) <= 0 )
+    {
+        return 0;
+    }
+
+    fmSubTimestamps( ts, &task->wheelBase, &delta );
+    usec = delta.sec * 1000000 + delta.usec;
+
+    if ( roundUp )
+    {
+        usec += task->tickUsec - 1;
+    }
+
+    return ( usec / task->tickUsec );
+
+}   /* end TimestampToTick */
+
+
+
+
+/*****************************************************************************/
+/** TickToTimestamp
+ * \ingroup intTimer
+ *
+ * \desc            Converts a tick of the timing wheel of a given timer task
+ *                  into the absolute time at which the tick starts.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       tick is the wheel tick to convert.
+ * 
+ * \param[out]      ts is the pointer to a caller-allocated area where this
+ *                  function will return the absolute time.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void TickToTimestamp( fm_timerTask *task, 
+                             fm_uint64     tick, 
+                             fm_timestamp *ts )
+{
+    fm_timestamp delta;
+    fm_uint64    usec;
+
+    usec       = tick * task->tickUsec;
+    delta.sec  = usec / 1000000;
+    delta.usec = usec % 1000000;
+
+    *ts = task->wheelBase;
+    fmAddTimestamps( ts, &delta );
+
+}   /* end TickToTimestamp */
+
+
+
+
+/*****************************************************************************/
+/** InsertTimerInWheel
  * \ingroup intTimer
  *
- * \desc            Adds a timer to the sorted list of active timers
- *                  associated with a given timer task. The list is sorted
- *                  based on the timer's expiration time, with the earliest
- *                  being the first in the list.
+ * \desc            Hashes an active timer into the slot of the timing wheel
+ *                  matching its expiration tick. Timers expiring within
+ *                  FM_TIMER_WHEEL_SLOTS ticks go in level 0, the others in
+ *                  the level whose slots span their distance from the
+ *                  current tick. Timers already past their expiration go in
+ *                  the slot of the current tick.
  * 
  * \param[in]       task is the pointer to the timer task data structure.
  * 
  * \param[in]       timer is the pointer to the timer data structure.
  *
- * \return          FM_OK if successful.
+ * \return          None.
  * 
  *****************************************************************************/
-static fm_status AddActiveTimerToTask( fm_timerTask *task, fm_timer *timer )
+static void InsertTimerInWheel( fm_timerTask *task, fm_timer *timer )
+{
+    fm_uint64          expiry;
+    fm_uint64          delta;
+    fm_int             level;
+    fm_int             slot;
+    fm_timerWheelSlot *wheelSlot;
+
+    expiry = timer->expiryTick;
+    if ( expiry < task->wheelTick )
+    {
+        expiry = task->wheelTick;
+    }
+
+    /* timers beyond the range of the wheel go in the farthest slot and are
+       hashed again from their actual expiration tick when cascaded */
+    delta = expiry - task->wheelTick;
+    if ( delta >= FM_TIMER_WHEEL_RANGE )
+    {
+        delta  = FM_TIMER_WHEEL_RANGE - 1;
+        expiry = task->wheelTick + delta;
+    }
+
+    level = 0;
+    while ( delta >= ( 1ULL << ( (level + 1) * FM_TIMER_WHEEL_SLOT_BITS ) ) )
+    {
+        level++;
+    }
+
+    slot = (fm_int) ( ( expiry >> (level * FM_TIMER_WHEEL_SLOT_BITS) ) & 
+                      FM_TIMER_WHEEL_SLOT_MASK );
+
+    wheelSlot = &task->wheel[level][slot];
+    FM_DLL_INSERT_LAST( wheelSlot,
+                        firstTimer,
+                        lastTimer,
+                        timer,
+                        nextActiveTimer,
+                        prevActiveTimer );
+
+    timer->wheelSlot  = wheelSlot;
+    timer->wheelLevel = level;
+    task->wheelOccupancy[level] |= ( 1ULL << slot );
+    task->wheelCount[level]++;
+
+}   /* end InsertTimerInWheel */
+
+
+
+
+/*****************************************************************************/
+/** RemoveTimerFromWheel
+ * \ingroup intTimer
+ *
+ * \desc            Removes a timer from the timing wheel slot it is hashed
+ *                  to, if any.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       timer is the pointer to the timer data structure.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void RemoveTimerFromWheel( fm_timerTask *task, fm_timer *timer )
+{
+    fm_timerWheelSlot *wheelSlot;
+    fm_int             level;
+    fm_int             slot;
+
+    wheelSlot = timer->wheelSlot;
+    if ( wheelSlot == NULL )
+    {
+        return;
+    }
+
+    FM_DLL_REMOVE_NODE( wheelSlot,
+                        firstTimer,
+                        lastTimer,
+                        timer,
+                        nextActiveTimer,
+                        prevActiveTimer );
+
+    level = timer->wheelLevel;
+    slot  = (fm_int) ( wheelSlot - &task->wheel[level][0] );
+
+    if ( FM_DLL_GET_FIRST( wheelSlot, firstTimer ) == NULL )
+    {
+        task->wheelOccupancy[level] &= ~( 1ULL << slot );
+    }
+    task->wheelCount[level]--;
+
+    timer->wheelSlot = NULL;
+
+}   /* end RemoveTimerFromWheel */
+
+
+
+
+/*****************************************************************************/
+/** CascadeWheelLevel
+ * \ingroup intTimer
+ *
+ * \desc            Moves the timers of the slot of a given wheel level that
+ *                  covers the current tick down to the lower levels.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  taken, when the current tick is the first tick covered by
+ *                  the slot.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       level is the wheel level to cascade.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void CascadeWheelLevel( fm_timerTask *task, fm_int level )
+{
+    fm_timerWheelSlot *wheelSlot;
+    fm_timer          *timer;
+    fm_timer          *nextTimer;
+    fm_int             slot;
+
+    slot = (fm_int) ( ( task->wheelTick >> (level * FM_TIMER_WHEEL_SLOT_BITS) ) &
+                      FM_TIMER_WHEEL_SLOT_MASK );
+    wheelSlot = &task->wheel[level][slot];
+
+    /* detach the whole slot first, timers beyond the range of the wheel
+       may be hashed back into it */
+    timer = FM_DLL_GET_FIRST( wheelSlot, firstTimer );
+    FM_DLL_INIT_LIST( wheelSlot, firstTimer, lastTimer );
+    task->wheelOccupancy[level] &= ~( 1ULL << slot );
+
+    while ( timer != NULL )
+    {
+        nextTimer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
+
+        task->wheelCount[level]--;
+        timer->wheelSlot = NULL;
+        InsertTimerInWheel( task, timer );
+
+        timer = nextTimer;
+    }
+
+}   /* end CascadeWheelLevel */
+
+
+
+
+/*****************************************************************************/
+/** GetNextWheelTick
+ * \ingroup intTimer
+ *
+ * \desc            Finds the first tick, at or after the current one, at which
+ *                  the timing wheel has a non-empty slot to expire or to
+ *                  cascade.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[out]      tick is a pointer to a caller-allocated area where this
+ *                  function will return the tick.
+ *
+ * \return          TRUE if the wheel holds at least one timer.
+ * \return          FALSE if the wheel is empty.
+ * 
+ *****************************************************************************/
+static fm_bool GetNextWheelTick( fm_timerTask *task, fm_uint64 *tick )
 {
-    fm_timer  *activeTimer;
-    fm_timer  *prevActiveTimer;
+    fm_uint64 occupancy;
+    fm_uint64 block;
+    fm_uint64 candidate;
+    fm_int    level;
+    fm_int    shift;
+    fm_int    current;
+    fm_bool   found;
+
+    found = FALSE;
+    *tick = ~0ULL;
 
-    /* scan the list of active timers */
-    prevActiveTimer = NULL;
-    activeTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-    while ( ( activeTimer != NULL ) &&
-            ( fmCompareTimestamps( &timer->end, &activeTimer->end ) > 0 ) ) 
+    for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
     {
-        prevActiveTimer = activeTimer;
-        activeTimer = FM_DLL_GET_NEXT( activeTimer, nextActiveTimer );
+        occupancy = task->wheelOccupancy[level];
+        if ( occupancy == 0 )
+        {
+            continue;
+        }
+
+        /* the first block of this level processed at or after the current
+           tick, slots are processed in order from there on */
+        shift   = level * FM_TIMER_WHEEL_SLOT_BITS;
+        block   = ( task->wheelTick + (1ULL << shift) - 1 ) >> shift;
+        current = (fm_int) ( block & FM_TIMER_WHEEL_SLOT_MASK );
+
+        if ( current != 0 )
+        {
+            occupancy = ( occupancy >> current ) | 
+                        ( occupancy << (FM_TIMER_WHEEL_SLOTS - current) );
+        }
+
+        candidate = ( block + ffsll( (long long) occupancy ) - 1 ) << shift;
+        if ( candidate < *tick )
+        {
+            *tick = candidate;
+        }
+        found = TRUE;
     }
 
-    /* check list consistency */
-    if ( activeTimer == NULL)
+    return found;
+
+}   /* end GetNextWheelTick */
+
+
+
+
+/*****************************************************************************/
+/** ProcessWheelTick
+ * \ingroup intTimer
+ *
+ * \desc            Processes the current tick of the timing wheel: cascades
+ *                  the higher levels when the tick starts one of their
+ *                  slots, then moves the timers of the tick's level 0 slot
+ *                  to the list of expired timers as a single batch.
+ *                  Repeating timers are re-armed for their next repetition.
+ *                  The current tick is advanced unless a repetition is
+ *                  already due, in which case it goes out in the next batch
+ *                  for the same tick.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  taken.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ *
+ * \return          The number of timers expired.
+ * 
+ *****************************************************************************/
+static fm_int ProcessWheelTick( fm_timerTask *task )
+{
+    fm_timerWheelSlot *wheelSlot;
+    fm_timer          *timer;
+    fm_timer          *nextTimer;
+    fm_int             level;
+    fm_int             slot;
+    fm_int             batchSize;
+
+    slot = (fm_int) ( task->wheelTick & FM_TIMER_WHEEL_SLOT_MASK );
+
+    /* cascade the lower levels first so that the timers cascaded from the
+       higher levels are not cascaded twice */
+    if ( slot == 0 )
     {
-        if ( task->lastActiveTimer != prevActiveTimer )
+        for ( level = 1 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
         {
-            FM_LOG_DEBUG( FM_LOG_CAT_ALOS_TIME, 
-                          "Invalid list of active timers (fixed)\n");
-            task->lastActiveTimer = prevActiveTimer;
+            CascadeWheelLevel( task, level );
+
+            if ( ( ( task->wheelTick >> (level * FM_TIMER_WHEEL_SLOT_BITS) ) & 
+                   FM_TIMER_WHEEL_SLOT_MASK ) != 0 )
+            {
+                break;
+            }
         }
     }
 
-    FM_DLL_INSERT_BEFORE( task, 
-                          firstActiveTimer, 
-                          lastActiveTimer, 
-                          activeTimer,
-                          nextActiveTimer,
-                          prevActiveTimer,
-                          timer );
+    /* detach the whole slot, re-armed timers already due land back in it */
+    wheelSlot = &task->wheel[0][slot];
+    timer     = FM_DLL_GET_FIRST( wheelSlot, firstTimer );
+    FM_DLL_INIT_LIST( wheelSlot, firstTimer, lastTimer );
+    task->wheelOccupancy[0] &= ~( 1ULL << slot );
+
+    batchSize = 0;
+    while ( timer != NULL )
+    {
+        nextTimer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
+
+        task->wheelCount[0]--;
+        timer->wheelSlot  = NULL;
+        timer->expiredEnd = timer->end;
+
+        /* is this the last repetition? */
+        timer->nrRepetitionsSoFar++;
+        if ( ( timer->nrRepetitions != FM_TIMER_REPEAT_FOREVER   ) && 
+             ( timer->nrRepetitionsSoFar >= timer->nrRepetitions ) )
+        {
+            /* yes, this timer is no longer active */
+            timer->running = FALSE;
+        }
+        else
+        {
+            /* no, compute the next expiraration date and
+               add the timer back in the wheel */
+            timer->start = timer->end;
+            fmAddTimestamps( &timer->end, &timer->timeout );
+
+            /* a zero or sub-tick timeout, or a callback running late, would
+               re-arm the timer in the tick being processed, spinning on it
+               or firing a burst of missed periods; skip to the next tick */
+            if ( TimestampToTick( task, &timer->end, TRUE ) <= task->wheelTick )
+            {
+                TickToTimestamp( task, task->wheelTick + 1, &timer->end );
+            }
+            AddActiveTimerToTask( task, timer );
+        }
+
+        if ( !timer->expired )
+        {
+            FM_DLL_INSERT_LAST( task,
+                                firstExpiredTimer,
+                                lastExpiredTimer,
+                                timer,
+                                nextExpiredTimer,
+                                prevExpiredTimer );
+            timer->expired = TRUE;
+        }
+
+        batchSize++;
+        timer = nextTimer;
+    }
+
+    if ( FM_DLL_GET_FIRST( wheelSlot, firstTimer ) == NULL )
+    {
+        task->wheelTick++;
+    }
+
+    if ( batchSize > 0 )
+    {
+        task->nrBatches++;
+        if ( batchSize > task->maxBatchSize )
+        {
+            task->maxBatchSize = batchSize;
+        }
+    }
+
+    return batchSize;
+
+}   /* end ProcessWheelTick */
+
+
+
+
+/*****************************************************************************/
+/** ProcessActiveTimers
+ * \ingroup intTimer
+ *
+ * \desc            Advances the timing wheel of a timer task up to a given
+ *                  time, invoking the callbacks of the expired timers one
+ *                  tick's batch at a time. Ticks without any timer to expire
+ *                  or cascade are skipped.
+ * 
+ * \note            This function must be called with the timer task's lock
+ *                  taken. The lock is released while each callback runs.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       now is the pointer to the time up to which timers are
+ *                  expired.
+ * 
+ * \param[in,out]   lockTaken points to the caller's flag tracking whether
+ *                  the timer task's lock is held, updated if an error
+ *                  leaves it released.
+ *
+ * \return          FM_OK if successful.
+ * 
+ *****************************************************************************/
+static fm_status ProcessActiveTimers( fm_timerTask *task, 
+                                      fm_timestamp *now,
+                                      fm_bool      *lockTaken )
+{
+    fm_status         status;
+    fm_uint64         nowTick;
+    fm_uint64         nextTick;
+    fm_uint64         lateness;
+    fm_timestamp      curTime;
+    fm_timestamp      delta;
+    fm_timer         *timer;
+    fm_timerCallback  callback;
+    void             *arg;
+
+    status  = FM_OK;
+    nowTick = TimestampToTick( task, now, FALSE );
+
+    while ( task->wheelTick <= nowTick )
+    {
+        if ( !GetNextWheelTick( task, &nextTick ) )
+        {
+            task->wheelTick = nowTick + 1;
+            break;
+        }
+
+        if ( nextTick > task->wheelTick )
+        {
+            task->wheelTick = ( nextTick <= nowTick ) ? nextTick : nowTick + 1;
+            continue;
+        }
+
+        ProcessWheelTick( task );
+
+        /* dispatch the batch, a timer stopped in the meanwhile is no longer
+           in the list */
+        timer = FM_DLL_GET_FIRST( task, firstExpiredTimer );
+        while ( timer != NULL )
+        {
+            FM_DLL_REMOVE_NODE( task,
+                                firstExpiredTimer,
+                                lastExpiredTimer,
+                                timer,
+                                nextExpiredTimer,
+                                prevExpiredTimer );
+            timer->expired = FALSE;
+
+            callback = timer->callback;
+            arg      = timer->arg;
+
+            fmGetTime( &curTime );
+            lateness = 0;
+            if ( fmCompareTimestamps( &curTime, &timer->expiredEnd ) > 0 )
+            {
+                fmSubTimestamps( &curTime, &timer->expiredEnd, &delta );
+                lateness = delta.sec * 1000000 + delta.usec;
+            }
+            task->nrExpirations++;
+            task->totalLateness += lateness;
+            if ( lateness > task->maxLateness )
+            {
+                task->maxLateness = lateness;
+            }
+
+            /* execute the callback, but release the lock temporarily
+               to prevent lock inversion problems */
+            status = fmReleaseLock( &task->lock );
+            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+            *lockTaken = FALSE;
+
+            /* ignore the return code, we can't give up for a caller error */
+            callback( arg );
+
+            /* grab the lock again and move on to the next expired timer */
+            status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
+            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+            *lockTaken = TRUE;
+
+            timer = FM_DLL_GET_FIRST( task, firstExpiredTimer );
+        }
+    }
+
+ABORT:
+    return status;
+
+}   /* end ProcessActiveTimers */
+
+
+
+
+/*****************************************************************************/
+/** AddActiveTimerToTask
+ * \ingroup intTimer
+ *
+ * \desc            Adds a timer to the timing wheel of the timer task it is
+ *                  associated with, based on the timer's expiration time.
+ *                  A timer never expires before its expiration time, i.e.
+ *                  the expiration time is rounded up to the next wheel tick.
+ * 
+ * \param[in]       task is the pointer to the timer task data structure.
+ * 
+ * \param[in]       timer is the pointer to the timer data structure.
+ *
+ * \return          FM_OK if successful.
+ * 
+ *****************************************************************************/
+static fm_status AddActiveTimerToTask( fm_timerTask *task, fm_timer *timer )
+{
+    timer->expiryTick = TimestampToTick( task, &timer->end, TRUE );
+    InsertTimerInWheel( task, timer );
 
     return FM_OK;
 
@@ -749,54 +1183,32 @@ static fm_status StopTimer( fm_timer *timer )
     fm_timerTask *task;
     fm_bool       timerLockTaken = FALSE;
     fm_status     status;
-    fm_timer     *oldFirstActiveTimer;
-    fm_timer     *pTimer;
 
     task = timer->task;
-    oldFirstActiveTimer = NULL;
 
     status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
     FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
     timerLockTaken = TRUE;
 
+    /* remove it from the timing wheel */
+    RemoveTimerFromWheel( task, timer );
 
-    /* verify that the timer is in the active timers list, then remove it */
-    pTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-
-    while ( pTimer != NULL ) 
+    /* if it expired but its callback hasn't been invoked yet, drop it */
+    if ( timer->expired )
     {
-        if ( pTimer == timer )
-        {
-            /* Peek at the head of the list, we may need to know if this was the
-               first active timer */
-            oldFirstActiveTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-
-            /* remove it from the list of active timers */
-            FM_DLL_REMOVE_NODE( task,
-                                firstActiveTimer,
-                                lastActiveTimer,
-                                timer,
-                                nextActiveTimer,
-                                prevActiveTimer );
-            break;
-        }
-
-        pTimer = FM_DLL_GET_NEXT( pTimer, nextActiveTimer );
+        FM_DLL_REMOVE_NODE( task,
+                            firstExpiredTimer,
+                            lastExpiredTimer,
+                            timer,
+                            nextExpiredTimer,
+                            prevExpiredTimer );
+        timer->expired = FALSE;
     }
 
     timer->running = FALSE;
 
-    /* For an event-driven timer task, signal the condition to the main loop */
-    if ( task->mode == FM_TIMER_TASK_MODE_EVENT_DRIVEN )
-    {
-        /* we do it only if it's the first active timer in the list */
-        if ( oldFirstActiveTimer == timer )
-        {
-            /* wakeup the timer task, so that it can process the new timer event */
-            status = WakeupTimerTask( task );
-            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
-        }
-    }
+    /* An event-driven timer task doesn't need to be woken up, at worst it
+       will find nothing to expire at its next wakeup */
 
     status = FM_OK;
 
@@ -832,6 +1244,64 @@ static void PrintDbgRuler( void )
 
 
 
+/*****************************************************************************/
+/** PrintDbgTimer
+ * \ingroup intTimer
+ *
+ * \desc            Displays one row of the formatted output of
+ *                  ''fmDbgDumpTimers''
+ * 
+ * \param[in]       timer is the pointer to the timer data structure.
+ *
+ * \return          None.
+ * 
+ *****************************************************************************/
+static void PrintDbgTimer( fm_timer *timer )
+{
+    fm_char auxStr[70];
+
+    FM_LOG_PRINT( "|%-16s", timer->name );
+    FM_LOG_PRINT( "|%-7s", 
+                  (timer->running ? 
+                   "Active" : 
+                   "Idle") );
+    if ( timer->running )
+    {
+        FM_LOG_PRINT("|%-11d", timer->nrRepetitionsSoFar );
+        if ( timer->nrRepetitions == FM_TIMER_REPEAT_FOREVER )
+        {
+            FM_LOG_PRINT("|%-12s", "INF");
+        }
+        else
+        {
+            FM_LOG_PRINT("|%-12d", timer->nrRepetitions );
+        }
+        FM_SPRINTF_S( auxStr,
+                      sizeof(auxStr),
+                      "|%llu.%03llus",
+                      timer->start.sec, 
+                      timer->start.usec/1000 );
+        FM_LOG_PRINT("%-19s", auxStr );
+        FM_SPRINTF_S( auxStr,
+                      sizeof(auxStr),
+                      "|%llu.%03llus",
+                      timer->end.sec, 
+                      timer->end.usec/1000 );
+        FM_LOG_PRINT("%-19s|\n", auxStr);
+    }
+    else
+    {
+        FM_LOG_PRINT("|%-11s", "N/A");
+        FM_LOG_PRINT("|%-12s", "N/A");
+        FM_LOG_PRINT("|%-18s", "N/A");
+        FM_LOG_PRINT("|%-18s|\n", "N/A");
+    }
+
+}   /* end PrintDbgTimer */
+
+
+
+
 /*****************************************************************************/
 /** CleanupAllTimers
  * \ingroup intTimer
@@ -859,15 +1329,19 @@ static fm_status CleanupAllTimers( fm_timerTask *task )
         /* save the next pointer */
         nextTimer = FM_DLL_GET_NEXT( timer, nextTimer );
         
-        /* if active, remove it from the list of active timers */
-        if ( timer->running )
+        /* if active, remove it from the timing wheel */
+        RemoveTimerFromWheel( task, timer );
+
+        /* and from the list of expired timers */
+        if ( timer->expired )
         {
             FM_DLL_REMOVE_NODE( task,
-                                firstActiveTimer,
-                                lastActiveTimer,
+                                firstExpiredTimer,
+                                lastExpiredTimer,
                                 timer,
-                                nextActiveTimer,
-                                prevActiveTimer );
+                                nextExpiredTimer,
+                                prevExpiredTimer );
+            timer->expired = FALSE;
         }
 
         /* remove it from the list of instantiated timers */
@@ -1028,6 +1502,39 @@ fm_status fmGetTime(fm_timestamp *ts)
 
 
 
+/*****************************************************************************/
+/** fmGetThreadCpuTime
+ * \ingroup alosTime
+ *
+ * \desc            Get the CPU time consumed by the calling thread, in
+ *                  seconds and microseconds.
+ *
+ * \param[out]      ts points to a caller-allocated fm_timestamp structure
+ *                  where this function should place the CPU time.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if not successful.
+ *
+ *****************************************************************************/
+fm_status fmGetThreadCpuTime(fm_timestamp *ts)
+{
+    struct timespec tv;
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tv) != 0)
+    {
+        return FM_FAIL;
+    }
+
+    ts->sec  = tv.tv_sec;
+    ts->usec = tv.tv_nsec/1000;
+
+    return FM_OK;
+
+}   /* end fmGetThreadCpuTime */
+
+
+
+
 /*****************************************************************************/
 /** fmGetFormattedTime
  * \ingroup intAlosTime
@@ -1469,8 +1976,23 @@ fm_status fmCreateTimerTask( fm_text           taskName,
     if ( mode == FM_TIMER_TASK_MODE_PERIODIC )
     {
         task->period   = *period;
+        task->tickUsec = period->sec * 1000000 + period->usec;
+    }
+    else
+    {
+        task->tickUsec = TIMER_WHEEL_TICK_USEC;
+    }
+
+    if ( task->tickUsec == 0 )
+    {
+        task->tickUsec = 1;
     }
 
+    /* the timing wheel starts now, empty */
+    status = fmGetTime( &task->wheelBase );
+    FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+    task->wakeTick = ~0ULL;
+
     /* create the lock for this task */
     FM_SPRINTF_S( auxName, 32, "%sLock", taskName );
     status = fmCreateLock( auxName, &task->lock );
@@ -1814,8 +2336,8 @@ fm_status fmDeleteTimer( fm_timerHandle handle )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
     }
 
-    /* stop the timer if it's running */
-    if ( timer->running == TRUE )
+    /* stop the timer if it's running or waiting for its callback */
+    if ( timer->running == TRUE || timer->expired == TRUE )
     {
         StopTimer( timer );
     }
@@ -1885,7 +2407,6 @@ fm_status fmStartTimer( fm_timerHandle    handle,
 {
     fm_status      status;
     fm_timer      *timer;
-    fm_timer      *firstActiveTimer;
     fm_timerTask  *task;
     fm_timestamp   curTime;
     fm_bool        timerLockTaken = FALSE;
@@ -1915,7 +2436,7 @@ fm_status fmStartTimer( fm_timerHandle    handle,
     }
                                 
     /* if the timer is already running, stop it then proceed */
-    if ( timer->running == TRUE )
+    if ( timer->running == TRUE || timer->expired == TRUE )
     {
         StopTimer( timer );
     }
@@ -1949,16 +2470,15 @@ fm_status fmStartTimer( fm_timerHandle    handle,
     timer->end                = curTime;
     fmAddTimestamps( &timer->end, &timer->timeout );
 
-    /* add it to the list of active timers for this timer task */
+    /* add it to the timing wheel of this timer task */
     status = AddActiveTimerToTask( task, timer );
     FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
 
     /* For an event-driven timer task, signal the condition to the main loop */
     if ( task->mode == FM_TIMER_TASK_MODE_EVENT_DRIVEN )
     {
-        /* we do it only if it's the first active timer in hte list */
-        firstActiveTimer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-        if ( firstActiveTimer == timer )
+        /* we do it only if it expires before the task's next wakeup */
+        if ( timer->expiryTick < task->wakeTick )
         {
             /* wakeup the timer task, so that it can process the new timer event */
             status = WakeupTimerTask( task );
@@ -2013,9 +2533,9 @@ fm_status fmStopTimer( fm_timerHandle handle )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
     }
 
-    /* stop the timer if it's running */
-    /* exit gracefully otherwise      */
-    if ( timer->running )
+    /* stop the timer if it's running or waiting for its callback */
+    /* exit gracefully otherwise                                  */
+    if ( timer->running || timer->expired )
     {
         status = StopTimer( timer );
     }
@@ -2201,7 +2721,9 @@ ABORT:
 /** fmDbgDumpTimers
  * \ingroup intTimer
  *
- * \desc            Dumps debug information about all existing timers.
+ * \desc            Dumps debug information about all existing timers,
+ *                  followed by the occupancy of each level of the timing
+ *                  wheel and how late the timer callbacks were invoked.
  * 
  * \param[in]       onlyActive: when set to TRUE, this function will display
  *                  only active timers, otherwise it will display all timers
@@ -2219,6 +2741,9 @@ fm_status fmDbgDumpTimers( fm_bool onlyActive )
     fm_timer     *timer;
     fm_int        i;
     fm_int        timerCount;
+    fm_int        level;
+    fm_int        slot;
+    fm_int        slotCount;
     fm_char       auxStr[70];
 
     /* make sure the initialization sequence has been completed */
@@ -2258,6 +2783,10 @@ fm_status fmDbgDumpTimers( fm_bool onlyActive )
             FM_LOG_PRINT("|EXPIRATION TIME   |\n");
             PrintDbgRuler();
 
+            /* the timer task updates the lists and the wheel counters */
+            status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
+            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+
             timerCount = 0;
             timer = FM_DLL_GET_FIRST( task, firstTimer );
             while ( timer != NULL )
@@ -2265,45 +2794,9 @@ fm_status fmDbgDumpTimers( fm_bool onlyActive )
 
                 if ( !onlyActive || timer->running )
                 {
-                    FM_LOG_PRINT( "|%-16s", timer->name );
-                    FM_LOG_PRINT( "|%-7s", 
-                                  (timer->running ? 
-                                   "Active" : 
-                                   "Idle") );
-                    if ( timer->running )
-                    {
-                        FM_LOG_PRINT("|%-11d", timer->nrRepetitionsSoFar );
-                        if ( timer->nrRepetitions == FM_TIMER_REPEAT_FOREVER )
-                        {
-                            FM_LOG_PRINT("|%-12s", "INF");
-                        }
-                        else
-                        {
-                            FM_LOG_PRINT("|%-12d", timer->nrRepetitions );
-                        }
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->start.sec, 
-                                      timer->start.usec/1000 );
-                        FM_LOG_PRINT("%-19s", auxStr );
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->end.sec, 
-                                      timer->end.usec/1000 );
-                        FM_LOG_PRINT("%-19s|\n", auxStr);
-                    }
-                    else
-                    {
-                        FM_LOG_PRINT("|%-11s", "N/A");
-                        FM_LOG_PRINT("|%-12s", "N/A");
-                        FM_LOG_PRINT("|%-18s", "N/A");
-                        FM_LOG_PRINT("|%-18s|\n", "N/A");
-                    }
+                    PrintDbgTimer( timer );
                     timerCount++;
-
-                }   /* end if ( !onlyActive | ... ) */
+                }
 
                 timer = FM_DLL_GET_NEXT( timer, nextTimer );
 
@@ -2318,6 +2811,42 @@ fm_status fmDbgDumpTimers( fm_bool onlyActive )
             }
             PrintDbgRuler();
 
+            /* timing wheel occupancy */
+            FM_LOG_PRINT("\nTiming wheel: tick %llu usec, current tick %llu\n",
+                         task->tickUsec,
+                         task->wheelTick );
+            FM_LOG_PRINT("  LEVEL  TICKS/SLOT  SLOTS USED  TIMERS\n");
+            for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
+            {
+                slotCount = 0;
+                for ( slot = 0 ; slot < FM_TIMER_WHEEL_SLOTS ; slot++ )
+                {
+                    if ( task->wheelOccupancy[level] & ( 1ULL << slot ) )
+                    {
+                        slotCount++;
+                    }
+                }
+                FM_LOG_PRINT("  %-5d  %-10llu  %2d/%-7d  %d\n",
+                             level,
+                             1ULL << (level * FM_TIMER_WHEEL_SLOT_BITS),
+                             slotCount,
+                             FM_TIMER_WHEEL_SLOTS,
+                             task->wheelCount[level] );
+            }
+
+            /* expiration batches and lateness */
+            FM_LOG_PRINT("Expirations: %llu in %llu batches, "
+                         "max batch size %d\n",
+                         task->nrExpirations,
+                         task->nrBatches,
+                         task->maxBatchSize );
+            FM_LOG_PRINT("Lateness: avg %llu usec, max %llu usec\n",
+                         ( task->nrExpirations ? 
+                           task->totalLateness / task->nrExpirations : 0 ),
+                         task->maxLateness );
+
+            fmReleaseLock( &task->lock );
+
             FM_LOG_PRINT("\n");
 
         }   /* end if ( task->used ) */
@@ -2340,7 +2869,7 @@ ABORT:
  * \ingroup intTimer
  *
  * \desc            Dumps debug information about all existing timers in the
- *                  active list.
+ *                  timing wheel, level by level.
  * 
  * \return          FM_OK if successful.
  * \return          FM_ERR_UNINITIALIZED if the ALOS root object hasn't been
@@ -2354,6 +2883,9 @@ fm_status fmDbgDumpActiveTimerList(void)
     fm_timer     *timer;
     fm_int        i;
     fm_int        timerCount;
+    fm_int        level;
+    fm_int        slot;
+    fm_int        offset;
     fm_timestamp  curTime;
     fm_char       auxStr[70];
 
@@ -2375,7 +2907,7 @@ fm_status fmDbgDumpActiveTimerList(void)
             FM_LOG_PRINT("\n+====================================================================+");
             FM_SPRINTF_S( auxStr, 
                           sizeof(auxStr), 
-                          " %sTimers for Timer Task '%s'Active ",
+                          " Active Timers for Timer Task '%s'",
                           task->thread->name );
             FM_LOG_PRINT( "\n|%-68s|\n", auxStr );
             status = fmGetTime( &curTime );
@@ -2400,56 +2932,35 @@ fm_status fmDbgDumpActiveTimerList(void)
             FM_LOG_PRINT("|EXPIRATION TIME   |\n");
             PrintDbgRuler();
 
+            /* the timer task moves timers between the wheel slots */
+            status = fmCaptureLock( &task->lock, FM_WAIT_FOREVER );
+            FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_ALOS_TIME, status );
+
+            /* walk each level of the timing wheel from the slot of the
+             * current tick, so that the nearest expirations come first */
             timerCount = 0;
-            timer = FM_DLL_GET_FIRST( task, firstActiveTimer );
-            while ( timer != NULL )
+            for ( level = 0 ; level < FM_TIMER_WHEEL_LEVELS ; level++ )
             {
-
-                /* if ( 1 ) */
+                for ( offset = 0 ; offset < FM_TIMER_WHEEL_SLOTS ; offset++ )
                 {
-                    FM_LOG_PRINT( "|%-16s", timer->name );
-                    FM_LOG_PRINT( "|%-7s", 
-                                  (timer->running ? 
-                                   "Active" : 
-                                   "Idle") );
-                    if ( timer->running )
-                    {
-                        FM_LOG_PRINT("|%-11d", timer->nrRepetitionsSoFar );
-                        if ( timer->nrRepetitions == FM_TIMER_REPEAT_FOREVER )
-                        {
-                            FM_LOG_PRINT("|%-12s", "INF");
-                        }
-                        else
-                        {
-                            FM_LOG_PRINT("|%-12d", timer->nrRepetitions );
-                        }
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->start.sec, 
-                                      timer->start.usec/1000 );
-                        FM_LOG_PRINT("%-19s", auxStr );
-                        FM_SPRINTF_S( auxStr,
-                                      sizeof(auxStr),
-                                      "|%llu.%03llus",
-                                      timer->end.sec, 
-                                      timer->end.usec/1000 );
-                        FM_LOG_PRINT("%-19s|\n", auxStr);
-                    }
-                    else
+                    slot = (fm_int) ( ( ( task->wheelTick >> 
+                                          (level * FM_TIMER_WHEEL_SLOT_BITS) ) +
+                                        offset ) &
+                                      FM_TIMER_WHEEL_SLOT_MASK );
+
+                    timer = FM_DLL_GET_FIRST( &task->wheel[level][slot], 
+                                              firstTimer );
+                    while ( timer != NULL )
                     {
-                        FM_LOG_PRINT("|%-11s", "N/A");
-                        FM_LOG_PRINT("|%-12s", "N/A");
-                        FM_LOG_PRINT("|%-18s", "N/A");
-                        FM_LOG_PRINT("|%-18s|\n", "N/A");
-                    }
-                    timerCount++;
+                        PrintDbgTimer( timer );
+                        timerCount++;
 
+                        timer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
+                    }
                 }
+            }
 
-                timer = FM_DLL_GET_NEXT( timer, nextActiveTimer );
-
-            }   /* end while ( timer != NULL ) */
+            fmReleaseLock( &task->lock );
 
             if ( timerCount == 0 )
             {
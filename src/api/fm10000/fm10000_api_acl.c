@@ -2340,6 +2340,8 @@ static void FillCompileStats(fm_fm10000CompiledAcls *cacls)
 
     FM_CLEAR(cacls->compilerStats);
 
+    cacls->compilerStats.imageSize = sizeof(fm_fm10000CompiledAcls);
+
     /* Update the policers stats */
     for (i = 0 ; i < FM_FM10000_POLICER_BANK_MAX ; i++)
     {
@@ -2382,6 +2384,10 @@ static void FillCompileStats(fm_fm10000CompiledAcls *cacls)
         {
             firstSlice = compiledAcl->sliceInfo.keyStart;
         }
+
+        cacls->compilerStats.imageSize +=
+            sizeof(fm_fm10000CompiledAcl) +
+            fmTreeSize(&compiledAcl->rules) * sizeof(fm_fm10000CompiledAclRule);
     }
 
     if (lastSlice >= 0)
@@ -2414,6 +2420,10 @@ static void FillCompileStats(fm_fm10000CompiledAcls *cacls)
         {
             firstSlice = compiledAcl->sliceInfo.keyStart;
         }
+
+        cacls->compilerStats.imageSize +=
+            sizeof(fm_fm10000CompiledAcl) +
+            fmTreeSize(&compiledAcl->rules) * sizeof(fm_fm10000CompiledAclRule);
     }
 
     if (lastSlice >= 0)
@@ -2493,11 +2503,222 @@ static void FormatCompileStats(fm_aclCompilerStats* cstats,
                                (cstats->rulesSkipped != 1) ? "s" : "");
     }
 
+    if (cstats->aclsCompiled || cstats->aclsReused)
+    {
+        fm10000FormatAclStatus(errReport,
+                               FALSE,
+                               "Compiled %u ACL%s and reused %u from the "
+                               "applied image.\n",
+                               cstats->aclsCompiled,
+                               (cstats->aclsCompiled != 1) ? "s" : "",
+                               cstats->aclsReused);
+    }
+
+    fm10000FormatAclStatus(errReport,
+                           FALSE,
+                           "Compilation took %" FM_FORMAT_64 "u usec, "
+                           "image uses %" FM_FORMAT_64 "u bytes.\n",
+                           cstats->compileTime,
+                           cstats->imageSize);
+
 }   /* end FormatCompileStats */
 
 
 
 
+/*****************************************************************************/
+/** GetElapsedTime
+ * \ingroup intAcl
+ *
+ * \desc            Returns the time elapsed since a given start time.
+ *
+ * \param[in]       start points to the start time.
+ *
+ * \return          The elapsed time in microseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 GetElapsedTime(const fm_timestamp *start)
+{
+    fm_timestamp now;
+    fm_timestamp elapsed;
+
+    fmGetTime(&now);
+    fmSubTimestamps(&now, start, &elapsed);
+
+    return (elapsed.sec * 1000000) + elapsed.usec;
+
+}   /* end GetElapsedTime */
+
+
+
+
+/*****************************************************************************/
+/** IncrementalCompile
+ * \ingroup intAcl
+ *
+ * \desc            Builds a new compiled ACL image by replaying the rules
+ *                  added and deleted since the last apply on top of a copy
+ *                  of the applied image. Only the ACLs that changed are
+ *                  recompiled; all the others keep their condition keys,
+ *                  scenario selection and slice position.
+ *
+ * \note            The changes are replayed using the non disruptive
+ *                  machinery in virtual mode, so nothing is written to the
+ *                  hardware.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      caclsPtr points to caller-allocated storage where this
+ *                  function will place the new compiled ACL image.
+ *
+ * \param[out]      numCompiled points to caller-allocated storage where this
+ *                  function will place the number of ACLs that changed.
+ *
+ * \param[out]      numReused points to caller-allocated storage where this
+ *                  function will place the number of ACLs taken unchanged
+ *                  from the applied image.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the changes can't be compiled
+ *                  incrementally and a full compilation is needed.
+ * \return          FM_ERR_ACL_COMPILE if the applied image can't be cloned.
+ *
+ *****************************************************************************/
+static fm_status IncrementalCompile(fm_int                   sw,
+                                    fm_fm10000CompiledAcls **caclsPtr,
+                                    fm_uint *                numCompiled,
+                                    fm_uint *                numReused)
+{
+    fm_status err = FM_OK;
+    fm_switch *switchPtr = GET_SWITCH_PTR(sw);
+    fm10000_switch *switchExt = (fm10000_switch *) switchPtr->extension;
+    fm_fm10000CompiledAcls *aacls;
+    fm_fm10000CompiledAcls *compiledClone = NULL;
+    fm_aclInfo *info;
+    fm_acl *acl;
+    fm_treeIterator itAcl;
+    fm_uint64 aclNumber;
+    void *nextValue;
+    fm_bool changed;
+    fm_bool applied;
+    fm_int firstAclSlice;
+    fm_int lastAclSlice;
+    fm_uint32 sliceMask;
+    fm_int i;
+
+    *caclsPtr = NULL;
+    *numCompiled = 0;
+    *numReused = 0;
+
+    info = &switchPtr->aclInfo;
+    aacls = switchExt->appliedAcls;
+
+    if (aacls == NULL)
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    /* The applied image must fit in the FFU slices currently given to the
+     * ACLs, otherwise the slice allocation changed since the last apply. */
+    err = fmGetFFUSliceRange(sw, &firstAclSlice, &lastAclSlice);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+
+    if ( (firstAclSlice < 0) ||
+         (lastAclSlice >= FM10000_FFU_SLICE_VALID_ENTRIES) )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    sliceMask = 0;
+    for (i = firstAclSlice ; i <= lastAclSlice ; i++)
+    {
+        sliceMask |= (1U << i);
+    }
+
+    if ( (aacls->sliceValid | aacls->actionValid) & ~sliceMask )
+    {
+        err = FM_ERR_UNSUPPORTED;
+        goto ABORT;
+    }
+
+    /**************************************************
+     * Find the ACLs that changed since the last apply
+     * and make sure each change can be replayed.
+     **************************************************/
+    for (fmTreeIterInit(&itAcl, &info->acls) ;
+         (err = fmTreeIterNext(&itAcl, &aclNumber, &nextValue)) == FM_OK ; )
+    {
+        acl = (fm_acl *) nextValue;
+
+        changed = ( acl->modified ||
+                    fmTreeSize(&acl->addedRules) ||
+                    fmTreeSize(&acl->removedRules) );
+
+        applied =
+            ( (fmTreeFind(&aacls->ingressAcl,
+                          FM_ACL_GET_MASTER_KEY(aclNumber),
+                          &nextValue) == FM_OK) ||
+              (fmTreeFind(&aacls->egressAcl,
+                          aclNumber,
+                          &nextValue) == FM_OK) );
+
+        if (!changed)
+        {
+            if (applied)
+            {
+                (*numReused)++;
+            }
+            continue;
+        }
+
+        /* Internal ACLs are compiled on their own, attribute and port
+         * changes are not tracked rule by rule and instances are not
+         * supported by the non disruptive machinery. */
+        if ( acl->internal ||
+             (acl->modified && applied) ||
+             (acl->instance != FM_ACL_NO_INSTANCE) )
+        {
+            err = FM_ERR_UNSUPPORTED;
+            goto ABORT;
+        }
+
+        (*numCompiled)++;
+    }
+    if (err != FM_ERR_NO_MORE)
+    {
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
+    }
+
+    compiledClone = CloneCompiledAcls(sw, aacls);
+    if (compiledClone == NULL)
+    {
+        err = FM_ERR_ACL_COMPILE;
+        goto ABORT;
+    }
+
+    err = fm10000NonDisruptCompile(sw, compiledClone, -1, FALSE);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    compiledClone->valid = TRUE;
+    *caclsPtr = compiledClone;
+    compiledClone = NULL;
+
+ABORT:
+
+    FreeCompiledAclsStruct(compiledClone);
+
+    return err;
+
+}   /* end IncrementalCompile */
+
+
+
+
 /*****************************************************************************/
 /** AddAclRouteElement
  * \ingroup intAcl
@@ -6373,6 +6594,9 @@ fm_status fm10000ACLCompile(fm_int    sw,
     fm_bool strictCount;
     fm_int internalAcl;
     fm_bool egressAcl;
+    fm_timestamp startTime;
+    fm_uint aclsCompiled = 0;
+    fm_uint aclsReused = 0;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ACL,
                  "sw = %d, "
@@ -6386,6 +6610,8 @@ fm_status fm10000ACLCompile(fm_int    sw,
                  flags,
                  (void*) value);
 
+    fmGetTime(&startTime);
+
     FM_CLEAR(abstractKey);
 
     fm10000InitAclErrorReporter(&errReport, statusText, statusTextLength);
@@ -6439,6 +6665,8 @@ fm_status fm10000ACLCompile(fm_int    sw,
             if (err == FM_OK)
             {
                 FillCompileStats(compiledClone);
+                compiledClone->compilerStats.compileTime =
+                    GetElapsedTime(&startTime);
 
                 /**************************************************
                 * Print statistics on success, such as the number
@@ -6475,6 +6703,26 @@ fm_status fm10000ACLCompile(fm_int    sw,
         FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
     }
 
+    /* Only recompile the ACLs that changed since the last apply if
+     * requested, falling back on a full compilation when not possible. */
+    if ( (flags & FM_ACL_COMPILE_FLAG_INCREMENTAL) &&
+         !(flags & FM_ACL_COMPILE_FLAG_TRY_ALLOC) )
+    {
+        err = IncrementalCompile(sw, &caclsRetry, &aclsCompiled, &aclsReused);
+        if (err == FM_OK)
+        {
+            goto COMPILED;
+        }
+
+        FM_LOG_DEBUG(FM_LOG_CAT_ACL,
+                     "Incremental compilation not possible (%s), "
+                     "compiling all ACLs\n",
+                     fmErrorMsg(err));
+
+        aclsCompiled = 0;
+        aclsReused = 0;
+    }
+
     /* If non disruptive failed, try compiling it from scratch */
     caclsRetry = (fm_fm10000CompiledAcls *)
         fmAlloc( sizeof(fm_fm10000CompiledAcls) );
@@ -6536,6 +6784,7 @@ fm_status fm10000ACLCompile(fm_int    sw,
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ACL, err);
         }
         FM_CLEAR(*compiledAcl);
+        aclsCompiled++;
 
         compiledAcl->aclParts = 0;
         compiledAcl->firstAclPart = TRUE;
@@ -7301,6 +7550,8 @@ fm_status fm10000ACLCompile(fm_int    sw,
     }
     err = FM_OK;
 
+COMPILED:
+
     if (errReport.numErrors > 0)
     {
         /* Not supposed to be here, this error must have been caught previously. */
@@ -7316,6 +7567,9 @@ fm_status fm10000ACLCompile(fm_int    sw,
         }
 
         FillCompileStats(caclsRetry);
+        caclsRetry->compilerStats.aclsCompiled = aclsCompiled;
+        caclsRetry->compilerStats.aclsReused = aclsReused;
+        caclsRetry->compilerStats.compileTime = GetElapsedTime(&startTime);
 
         /**************************************************
          * Print statistics on success, such as the number
@@ -7824,6 +8078,12 @@ ABORT:
             fmTreeDestroy(&acl->removedRules, NULL);
             fmTreeInit(&acl->removedRules);
         }
+
+        /* The applied image now reflects the ACL attributes and ports. */
+        if (err == FM_OK)
+        {
+            acl->modified = FALSE;
+        }
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_ACL, err);
@@ -40,6 +40,15 @@
 #define L2L_HASH_TABLE_SIZE             256
 #define MAX_UINT_VALUE                  4294967295
 
+/* Number of bytes in the MAC hash key, and hash bits per bank. */
+#define L2L_HASH_KEY_BYTES              8
+#define L2L_HASH_BITS                   12
+
+/* Forms the 60-bit MAC hash key from a MAC address and FID. */
+#define L2L_HASH_KEY(macAddr, fid)                                   \
+    ( ( ( (fm_uint64) (fid) & 0xfff ) << 48 ) |                      \
+      ( (fm_uint64) (macAddr) & FM_LITERAL_U64(0xffffffffffff) ) )
+
 
 /*****************************************************************************
  * Global Variables
@@ -50,6 +59,23 @@
  * Local Variables
  *****************************************************************************/
 
+/* Bit i of each MAC hash is the parity of the key masked with magic[i]. */
+static const fm_uint64 l2lHashMagic[L2L_HASH_BITS] =
+{
+    FM_LITERAL_U64(0xA8682B5EC57B5532),
+    FM_LITERAL_U64(0x54015762C2EDE43F),
+    FM_LITERAL_U64(0xA802AEC585DBC87F),
+    FM_LITERAL_U64(0x54D45C5443ACDEA4),
+    FM_LITERAL_U64(0xA9A8B8A88759BD48),
+    FM_LITERAL_U64(0x5780708E46A834CB),
+    FM_LITERAL_U64(0xAF00E11C8D506997),
+    FM_LITERAL_U64(0x5AD0C3E652BB9D74),
+    FM_LITERAL_U64(0xC694D9EA73382DC0),
+    FM_LITERAL_U64(0x89F8B20BAE6B15DB),
+    FM_LITERAL_U64(0x172065C814CD65ED),
+    FM_LITERAL_U64(0x2E40CB90299ACBDB)
+};
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -61,8 +87,145 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** CalcAddrHashBitwise
+ * \ingroup intAddr
+ *
+ * \desc            Computes the hash values of a MAC hash key one bit at a
+ *                  time, folding byte parities through l2lHashTable. This
+ *                  is the reference definition of the hash, used to build
+ *                  l2lHashByteTable.
+ *
+ * \param[in]       key is the MAC hash key (see L2L_HASH_KEY).
+ *
+ * \param[in]       hashMode specifies whether to use standard hash mode (0)
+ *                  or associative hash mode (1).
+ *
+ * \param[out]      hashes points to an array of FM10000_MAC_ADDR_BANK_COUNT
+ *                  elements in which this function will store the hash
+ *                  values.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CalcAddrHashBitwise(fm_uint64   key,
+                                fm_uint32   hashMode,
+                                fm_uint16 * hashes)
+{
+    fm_int    i;
+    fm_int    j;
+    fm_int    setId;
+    fm_bool   parity;
+    fm_uint   hash;
+    fm_uint64 temp;
+
+    /* Compute hashes for 4 sets. */
+    for (setId = 0 ; setId < FM10000_MAC_ADDR_BANK_COUNT ; ++setId)
+    {
+        hash = 0;
+ 
+        for (i = 0 ; i < L2L_HASH_BITS ; i++)
+        {
+            /* Use magic to only use some bits. */
+            temp = key & l2lHashMagic[i];
+ 
+            /* Compute parity across 8 bytes. */
+            parity = 0;
+            for (j = 0 ; j < L2L_HASH_KEY_BYTES ; j++) 
+            {
+                parity ^= fmRootApi->l2lHashTable[temp & 0xff];
+                temp >>= 8;
+            }
+ 
+            /* Set hash bit if count is odd. */
+            if (parity == 1)
+            {
+                hash |= (1 << i);
+            }
+ 
+        }   /* end for (i = 0 ; i < L2L_HASH_BITS ; i++) */
+       
+        /* Save this hash index. */
+        hashes[setId] = (fm_uint16) hash;
+        
+        /* Rotate key for next set. */
+        if (hashMode == 0)
+        {    
+            key = (key >> 8) | (key << 56);
+        }
+
+    }   /* end for (setId = 0 ; setId < FM10000_MAC_ADDR_BANK_COUNT ; ++setId) */
+
+}   /* end CalcAddrHashBitwise */
+
+
+
+
+/*****************************************************************************/
+/** CalcAddrHashFromTable
+ * \ingroup intAddr
+ *
+ * \desc            Computes the hash values of a MAC hash key using
+ *                  l2lHashByteTable. The hash is linear over GF(2), so each
+ *                  hash is the XOR of the contributions of the key's bytes
+ *                  at their positions. Rotating the key by one byte for the
+ *                  next set is equivalent to looking up each byte at the
+ *                  previous position.
+ *
+ * \param[in]       byteTable points to l2lHashByteTable.
+ *
+ * \param[in]       key is the MAC hash key (see L2L_HASH_KEY).
+ *
+ * \param[in]       hashMode specifies whether to use standard hash mode (0)
+ *                  or associative hash mode (1).
+ *
+ * \param[out]      hashes points to an array of FM10000_MAC_ADDR_BANK_COUNT
+ *                  elements in which this function will store the hash
+ *                  values.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CalcAddrHashFromTable(const fm_uint16 * byteTable,
+                                  fm_uint64         key,
+                                  fm_uint32         hashMode,
+                                  fm_uint16 *       hashes)
+{
+    fm_byte   keyBytes[L2L_HASH_KEY_BYTES];
+    fm_uint16 hash;
+    fm_int    setId;
+    fm_int    pos;
+
+    for (pos = 0 ; pos < L2L_HASH_KEY_BYTES ; pos++)
+    {
+        keyBytes[pos] = (fm_byte) (key >> (8 * pos));
+    }
+
+    for (setId = 0 ; setId < FM10000_MAC_ADDR_BANK_COUNT ; ++setId)
+    {
+        if (hashMode != 0 && setId > 0)
+        {
+            /* Associative mode uses the same hash for every set. */
+            hashes[setId] = hashes[0];
+            continue;
+        }
+
+        hash = 0;
+
+        for (pos = 0 ; pos < L2L_HASH_KEY_BYTES ; pos++)
+        {
+            hash ^= byteTable[pos * L2L_HASH_TABLE_SIZE +
+                              keyBytes[(pos + setId) % L2L_HASH_KEY_BYTES]];
+        }
+
+        hashes[setId] = hash;
+    }
+
+}   /* end CalcAddrHashFromTable */
+
+
+
 
-    
 /*****************************************************************************/
 /** FindBestIndex
  * \ingroup intAddr
@@ -449,52 +612,6 @@ ABORT:
 
 
 
-/*****************************************************************************/
-/** ResetUsedEntry
- * \ingroup intAddr
- *
- * \desc            Resets the entry in the MA_USED_TABLE for the specified
- *                  MA_TABLE entry.
- *
- * \param[in]       sw is the switch number.
- *
- * \param[in]       index is the index of the MA Table entry whose USED table
- *                  entry is to be reset.
- *
- * \return          FM_OK if successful.
- *
- *****************************************************************************/
-static fm_status ResetUsedEntry(fm_int sw, fm_uint32 index)
-{
-    fm_switch * switchPtr;
-    fm_status   status;
-    fm_uint32   usedIndex;
-    fm_uint32   usedValue;
-
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ADDR, "sw=%d index=%u\n", sw, index);
-
-    switchPtr = GET_SWITCH_PTR(sw);
-
-    usedIndex = index / 32;
-    usedValue = 1 << (index % 32);
-
-    FM_LOG_DEBUG(FM_LOG_CAT_ADDR,
-                 "usedIndex=%u usedValue=%08x\n",
-                 usedIndex,
-                 usedValue);
-
-    /* Clear SMAC USED bit. */
-    status = switchPtr->WriteUINT32(sw,
-                                    FM10000_MA_USED_TABLE(1, usedIndex),
-                                    usedValue);
-
-    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ADDR, status);
-
-}   /* end ResetUsedEntry */
-
-
-
-
 /*****************************************************************************/
 /** ValidateAddressFields
  * \ingroup intAddr
@@ -902,6 +1019,13 @@ fm_status fm10000AddMacTableEntry(fm_int               sw,
      **************************************************/
 
     switchPtr->maTable[hashIndex] = newEntry;
+    fmMarkAddrTableEntry(sw, hashIndex);
+
+    if (switchPtr->maTableAgingTime != NULL)
+    {
+        switchPtr->maTableAgingTime[hashIndex] =
+            (fm_uint32) newEntry.agingCounter;
+    }
     
     /**************************************************
      * Write new entry to hardware.
@@ -1178,73 +1302,85 @@ fm_status fm10000CalcAddrHash(fm_macaddr  macAddr,
                               fm_uint32   hashMode,
                               fm_uint16 * hashes)
 {
-    static const fm_uint64 magic[] =
-    {
-        FM_LITERAL_U64(0xA8682B5EC57B5532),
-        FM_LITERAL_U64(0x54015762C2EDE43F),
-        FM_LITERAL_U64(0xA802AEC585DBC87F),
-        FM_LITERAL_U64(0x54D45C5443ACDEA4),
-        FM_LITERAL_U64(0xA9A8B8A88759BD48),
-        FM_LITERAL_U64(0x5780708E46A834CB),
-        FM_LITERAL_U64(0xAF00E11C8D506997),
-        FM_LITERAL_U64(0x5AD0C3E652BB9D74),
-        FM_LITERAL_U64(0xC694D9EA73382DC0),
-        FM_LITERAL_U64(0x89F8B20BAE6B15DB),
-        FM_LITERAL_U64(0x172065C814CD65ED),
-        FM_LITERAL_U64(0x2E40CB90299ACBDB)
-    };
-
     fm_uint64 key;
-    fm_int    i;
-    fm_int    j;
-    fm_int    setId;
-    fm_bool   parity;
-    fm_uint   hash;
-    fm_uint64 temp;
 
-    key =  ( ( (fm_uint64) fid & 0xfff) << 48 ) |
-           ( ( (fm_uint64) macAddr & 0xffffffffffff ) );
- 
-    /* Compute hashes for 4 sets. */
-    for (setId = 0 ; setId < FM10000_MAC_ADDR_BANK_COUNT ; ++setId)
+    key = L2L_HASH_KEY(macAddr, fid);
+
+    if (fmRootApi->l2lHashByteTable != NULL)
     {
-        hash = 0;
+        CalcAddrHashFromTable(fmRootApi->l2lHashByteTable,
+                              key,
+                              hashMode,
+                              hashes);
+    }
+    else
+    {
+        CalcAddrHashBitwise(key, hashMode, hashes);
+    }
  
-        for (i = 0 ; i < 12 ; i++)
+    return FM_OK;
+
+}   /* end fm10000CalcAddrHash */
+
+
+
+
+/*****************************************************************************/
+/** fm10000CalcAddrHashBatch
+ * \ingroup intAddr
+ *
+ * \desc            Computes the hash table indexes for a number of MAC
+ *                  address and FID pairs. Equivalent to calling
+ *                  ''fm10000CalcAddrHash'' for each pair.
+ *
+ * \param[in]       numKeys is the number of pairs to hash.
+ *
+ * \param[in]       macAddrs points to an array of numKeys MAC addresses.
+ *
+ * \param[in]       fids points to an array of numKeys FID values.
+ *
+ * \param[in]       hashMode specifies whether to use standard hash mode (0)
+ *                  or associative hash mode (1).
+ *
+ * \param[out]      hashes points to an array of numKeys *
+ *                  FM10000_MAC_ADDR_BANK_COUNT elements in which this
+ *                  function will store the hash values, one group of
+ *                  FM10000_MAC_ADDR_BANK_COUNT per pair.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000CalcAddrHashBatch(fm_int             numKeys,
+                                   const fm_macaddr * macAddrs,
+                                   const fm_uint16 *  fids,
+                                   fm_uint32          hashMode,
+                                   fm_uint16 *        hashes)
+{
+    const fm_uint16 *byteTable;
+    fm_int           i;
+
+    byteTable = fmRootApi->l2lHashByteTable;
+
+    for (i = 0 ; i < numKeys ; i++)
+    {
+        if (byteTable != NULL)
         {
-            /* Use magic to only use some bits. */
-            temp = key & magic[i];
- 
-            /* Compute parity across 8 bytes. */
-            parity = 0;
-            for (j = 0 ; j < 8 ; j++) 
-            {
-                parity ^= fmRootApi->l2lHashTable[temp & 0xff];
-                temp >>= 8;
-            }
- 
-            /* Set hash bit if count is odd. */
-            if (parity == 1)
-            {
-                hash |= (1 << i);
-            }
- 
-        }   /* end for (i = 0 ; i < 12 ; i++) */
-       
-        /* Save this hash index. */
-        hashes[setId] = (fm_uint16) hash;
-        
-        /* Rotate key for next set. */
-        if (hashMode == 0)
-        {    
-            key = (key >> 8) | (key << 56);
+            CalcAddrHashFromTable(byteTable,
+                                  L2L_HASH_KEY(macAddrs[i], fids[i]),
+                                  hashMode,
+                                  &hashes[i * FM10000_MAC_ADDR_BANK_COUNT]);
         }
+        else
+        {
+            CalcAddrHashBitwise(L2L_HASH_KEY(macAddrs[i], fids[i]),
+                                hashMode,
+                                &hashes[i * FM10000_MAC_ADDR_BANK_COUNT]);
+        }
+    }
 
-    }   /* end for (setId = 0 ; setId < FM10000_MAC_ADDR_BANK_COUNT ; ++setId) */
- 
     return FM_OK;
 
-}   /* end fm10000CalcAddrHash */
+}   /* end fm10000CalcAddrHashBatch */
 
 
 
@@ -1388,6 +1524,85 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000ComputeAddressIndexBatch
+ * \ingroup intAddr
+ *
+ * \desc            Computes the MA Table indexes of a number of entries,
+ *                  reading the hash mode once. Equivalent to calling
+ *                  ''fm10000ComputeAddressIndex'' for each entry, and
+ *                  intended for bulk programming of static entries.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       numKeys is the number of entries.
+ *
+ * \param[in]       macAddrs points to an array of numKeys MAC addresses.
+ *
+ * \param[in]       vlanIDs points to an array of numKeys VLAN numbers.
+ *
+ * \param[out]      indexes points to an array of numKeys *
+ *                  FM10000_MAC_ADDR_BANK_COUNT elements into which this
+ *                  function should place the absolute MA Table indexes of
+ *                  each entry's hash bin, one group of
+ *                  FM10000_MAC_ADDR_BANK_COUNT per entry.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an array pointer is NULL.
+ *
+ *****************************************************************************/
+fm_status fm10000ComputeAddressIndexBatch(fm_int             sw,
+                                          fm_int             numKeys,
+                                          const fm_macaddr * macAddrs,
+                                          const fm_uint16 *  vlanIDs,
+                                          fm_uint16 *        indexes)
+{
+    fm_switch * switchPtr;
+    fm_uint32   rv;
+    fm_uint32   hashMode;
+    fm_int      i;
+    fm_int      bank;
+    fm_status   err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_ADDR, "sw=%d numKeys=%d\n", sw, numKeys);
+
+    if (macAddrs == NULL || vlanIDs == NULL || indexes == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Get hash mode from configuration register. */
+    err = switchPtr->ReadUINT32(sw,
+                                FM10000_MA_TABLE_CFG_1(),
+                                &rv);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ADDR, err);
+
+    hashMode = FM_GET_BIT(rv, FM10000_MA_TABLE_CFG_1, HashMode);
+
+    /* Compute the L2 hash values. */
+    fm10000CalcAddrHashBatch(numKeys, macAddrs, vlanIDs, hashMode, indexes);
+
+    /* Convert hash values to MAC table indexes. */
+    for (i = 0 ; i < numKeys ; ++i)
+    {
+        for (bank = 0 ; bank < FM10000_MAC_ADDR_BANK_COUNT ; ++bank)
+        {
+            indexes[i * FM10000_MAC_ADDR_BANK_COUNT + bank] +=
+                FM10000_MAC_ADDR_BANK_SIZE * bank;
+        }
+    }
+
+ABORT:
+    FM_LOG_EXIT(FM_LOG_CAT_ADDR, err);
+
+}   /* end fm10000ComputeAddressIndexBatch */
+
+
+
+
 /*****************************************************************************/
 /* fm10000ConvertEntryToWords
  * \ingroup intAddr
@@ -1523,6 +1738,250 @@ fm_status fm10000ConvertWordsToEntry(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** fm10000DbgBenchmarkAddrHash
+ * \ingroup intAddr
+ *
+ * \desc            Measures the cost of computing MA Table hashes for a set
+ *                  of pseudo-random MAC address and FID pairs, comparing
+ *                  the bitwise reference hash, the table-driven
+ *                  ''fm10000CalcAddrHash'' and ''fm10000CalcAddrHashBatch'',
+ *                  and the per-entry and batch MA Table index computation
+ *                  used when programming static entries. The table-driven
+ *                  hashes are first checked bit for bit against the
+ *                  reference in both hash modes.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numKeys is the number of pairs to hash.
+ *
+ * \param[in]       iterations is the number of passes to make over the
+ *                  pairs.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if numKeys is not positive.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          FM_FAIL if a table-driven hash differs from the
+ *                  reference.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgBenchmarkAddrHash(fm_int sw,
+                                      fm_int numKeys,
+                                      fm_int iterations)
+{
+    fm_macaddr * macAddrs;
+    fm_uint16 *  fids;
+    fm_uint16 *  hashes;
+    fm_uint16    single[FM10000_MAC_ADDR_BANK_COUNT];
+    fm_uint16    reference[FM10000_MAC_ADDR_BANK_COUNT];
+    fm_uint64    seed;
+    fm_uint32    hashMode;
+    fm_int       i;
+    fm_int       bank;
+    fm_int       pass;
+    fm_int       mismatches;
+    fm_timestamp start;
+    fm_timestamp end;
+    fm_timestamp elapsed[5];
+    fm_uint64    hashCount;
+    fm_status    err;
+
+    static const fm_text methods[5] =
+    {
+        "Bitwise hash       ",
+        "Table hash         ",
+        "Batch hash         ",
+        "Per-entry index    ",
+        "Batch index        ",
+    };
+
+    if (numKeys <= 0)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    err = fm10000InitAddrHash();
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    macAddrs   = fmAlloc( numKeys * sizeof(fm_macaddr) );
+    fids       = fmAlloc( numKeys * sizeof(fm_uint16) );
+    hashes     = fmAlloc( numKeys * FM10000_MAC_ADDR_BANK_COUNT *
+                          sizeof(fm_uint16) );
+    mismatches = 0;
+
+    if (macAddrs == NULL || fids == NULL || hashes == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    /* Pseudo-random keys from a 64-bit linear congruential generator. */
+    seed = FM_LITERAL_U64(0x0123456789ABCDEF);
+
+    for (i = 0 ; i < numKeys ; i++)
+    {
+        seed = seed * FM_LITERAL_U64(6364136223846793005) +
+               FM_LITERAL_U64(1442695040888963407);
+        macAddrs[i] = seed >> 16;
+        fids[i]     = (fm_uint16) (seed & 0xfff);
+    }
+
+    /***************************************************
+     * Verify the table-driven hashes in both modes.
+     **************************************************/
+
+    for (hashMode = 0 ; hashMode < 2 ; hashMode++)
+    {
+        fm10000CalcAddrHashBatch(numKeys, macAddrs, fids, hashMode, hashes);
+
+        for (i = 0 ; i < numKeys ; i++)
+        {
+            CalcAddrHashBitwise(L2L_HASH_KEY(macAddrs[i], fids[i]),
+                                hashMode,
+                                reference);
+            fm10000CalcAddrHash(macAddrs[i], fids[i], hashMode, single);
+
+            for (bank = 0 ; bank < FM10000_MAC_ADDR_BANK_COUNT ; bank++)
+            {
+                if ( (single[bank] != reference[bank]) ||
+                     (hashes[i * FM10000_MAC_ADDR_BANK_COUNT + bank] !=
+                      reference[bank]) )
+                {
+                    mismatches++;
+                }
+            }
+        }
+    }
+
+    /***************************************************
+     * Time each method.
+     **************************************************/
+
+    FM_CLEAR(elapsed);
+
+    fmGetTime(&start);
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        for (i = 0 ; i < numKeys ; i++)
+        {
+            CalcAddrHashBitwise(L2L_HASH_KEY(macAddrs[i], fids[i]),
+                                0,
+                                &hashes[i * FM10000_MAC_ADDR_BANK_COUNT]);
+        }
+    }
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &elapsed[0]);
+
+    fmGetTime(&start);
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        for (i = 0 ; i < numKeys ; i++)
+        {
+            fm10000CalcAddrHash(macAddrs[i],
+                                fids[i],
+                                0,
+                                &hashes[i * FM10000_MAC_ADDR_BANK_COUNT]);
+        }
+    }
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &elapsed[1]);
+
+    fmGetTime(&start);
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        fm10000CalcAddrHashBatch(numKeys, macAddrs, fids, 0, hashes);
+    }
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &elapsed[2]);
+
+    VALIDATE_AND_PROTECT_SWITCH_NO_RETURN(err, sw);
+
+    if (err == FM_OK)
+    {
+        fmGetTime(&start);
+        for (pass = 0 ; pass < iterations ; pass++)
+        {
+            for (i = 0 ; i < numKeys ; i++)
+            {
+                fm10000ComputeAddressIndex(
+                    sw,
+                    macAddrs[i],
+                    fids[i],
+                    0,
+                    &hashes[i * FM10000_MAC_ADDR_BANK_COUNT]);
+            }
+        }
+        fmGetTime(&end);
+        fmSubTimestamps(&end, &start, &elapsed[3]);
+
+        fmGetTime(&start);
+        for (pass = 0 ; pass < iterations ; pass++)
+        {
+            fm10000ComputeAddressIndexBatch(sw,
+                                            numKeys,
+                                            macAddrs,
+                                            fids,
+                                            hashes);
+        }
+        fmGetTime(&end);
+        fmSubTimestamps(&end, &start, &elapsed[4]);
+
+        UNPROTECT_SWITCH(sw);
+    }
+
+    hashCount = (fm_uint64) numKeys *
+                (fm_uint64) ( (iterations > 0) ? iterations : 1 );
+
+    FM_LOG_PRINT("MA Table hash benchmark: %d keys, %d passes\n",
+                 numKeys,
+                 iterations);
+
+    for (i = 0 ; i < 5 ; i++)
+    {
+        if ( (i >= 3) && (err != FM_OK) )
+        {
+            FM_LOG_PRINT("  %s: switch %d not available\n", methods[i], sw);
+            continue;
+        }
+
+        FM_LOG_PRINT("  %s: %8" FM_FORMAT_64 "u usec (%" FM_FORMAT_64
+                     "u nsec/key)\n",
+                     methods[i],
+                     elapsed[i].sec * 1000000 + elapsed[i].usec,
+                     (elapsed[i].sec * 1000000 + elapsed[i].usec) * 1000 /
+                     hashCount);
+    }
+
+    FM_LOG_PRINT("  Mismatches         : %d\n", mismatches);
+
+    err = (mismatches == 0) ? FM_OK : FM_FAIL;
+
+ABORT:
+    if (macAddrs != NULL)
+    {
+        fmFree(macAddrs);
+    }
+
+    if (fids != NULL)
+    {
+        fmFree(fids);
+    }
+
+    if (hashes != NULL)
+    {
+        fmFree(hashes);
+    }
+
+    return err;
+
+}   /* end fm10000DbgBenchmarkAddrHash */
+
+
+
+
 /*****************************************************************************/
 /** fm10000FillInUserEntryFromTable
  * \ingroup intAddr
@@ -1706,11 +2165,12 @@ fm_status fm10000GetAddressTable(fm_int              sw,
                                  fm_macAddressEntry *entries,
                                  fm_int              maxEntries)
 {
-    fm_switch *             switchPtr;
-    fm_internalMacAddrEntry cacheEntry;
-    fm_status               result = FM_OK;
-    fm_status               status;
-    fm_int                  i;
+    fm_switch *              switchPtr;
+    fm_maTableSnapshot *     snapshot;
+    fm_internalMacAddrEntry *cacheEntry;
+    fm_status                result = FM_OK;
+    fm_status                status;
+    fm_int                   i;
 
     FM_LOG_ENTRY(FM_LOG_CAT_ADDR,
                  "sw=%d nEntries=%p entries=%p maxEntries=%d\n",
@@ -1720,13 +2180,27 @@ fm_status fm10000GetAddressTable(fm_int              sw,
                  maxEntries);
 
     switchPtr = GET_SWITCH_PTR(sw);
+    snapshot  = NULL;
 
     *nEntries = 0;
 
+    /* entries == NULL is used to count the number of MAC entries,
+     * which is tracked as the table is updated. */
+    if (entries == NULL)
+    {
+        FM_TAKE_L2_LOCK(sw);
+        *nEntries = switchPtr->maTableValidCount;
+        FM_DROP_L2_LOCK(sw);
+        goto ABORT;
+    }
+
     /***************************************************
      * The MAC address table is read from the software
      * cache, since on the FM10000 not all of the
-     * information is stored in the hardware.
+     * information is stored in the hardware. The cache
+     * is copied in a single critical section, so that
+     * learning and aging are not held off while the
+     * entries are converted.
      *
      * Whenever an error is encountered, either because 
      * the entry could not be retrieved or due to a 
@@ -1734,37 +2208,43 @@ fm_status fm10000GetAddressTable(fm_int              sw,
      * If multiple errors occur, the user is only notified
      * of the reason for the first error.
      **************************************************/
+    result = fmAcquireAddrTableSnapshot(sw, &snapshot);
+    if (result != FM_OK)
+    {
+        goto ABORT;
+    }
+
     for (i = 0 ; i < switchPtr->macTableSize ; i++)
     {
-        FM_TAKE_L2_LOCK(sw);
-        cacheEntry = switchPtr->maTable[i];
-        FM_DROP_L2_LOCK(sw);
+        cacheEntry = &snapshot->entries[i];
 
-        if (cacheEntry.state != FM_MAC_ENTRY_STATE_INVALID)
+        if (cacheEntry->state != FM_MAC_ENTRY_STATE_INVALID)
         {
-            /* entries == NULL is used to count the number of MAC entry */
-            if (entries != NULL)
+            if (*nEntries >= maxEntries)
             {
-                if (*nEntries >= maxEntries)
-                {
-                    result = FM_ERR_BUFFER_FULL;
-                    goto ABORT;
-                }
+                result = FM_ERR_BUFFER_FULL;
+                goto ABORT;
+            }
 
-                status = fm10000FillInUserEntryFromTable(sw,
-                                                         &cacheEntry,
-                                                         &entries[*nEntries]);
-                if (status != FM_OK)
-                {
-                    FM_ERR_COMBINE(result, status);
-                    continue;
-                }
+            status = fm10000FillInUserEntryFromTable(sw,
+                                                     cacheEntry,
+                                                     &entries[*nEntries]);
+            if (status != FM_OK)
+            {
+                FM_ERR_COMBINE(result, status);
+                continue;
             }
+
             (*nEntries)++;
         }
     }
     
 ABORT:        
+    if (snapshot != NULL)
+    {
+        fmReleaseAddrTableSnapshot(sw, snapshot);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_ADDR, result);
 
 }   /* end fm10000GetAddressTable */
@@ -1906,49 +2386,77 @@ ABORT:
 /** fm10000InitAddrHash
  * \ingroup intAddr
  *
- * \desc            Initialize data table needed to calculate MAC table
+ * \desc            Initialize data tables needed to calculate MAC table
  *                  hash function.
  *
  * \param           None.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_NO_MEM if the l2lHashTable could not be allocated.
+ * \return          FM_ERR_NO_MEM if the l2lHashTable or l2lHashByteTable
+ *                  could not be allocated.
  *
  *****************************************************************************/
 fm_status fm10000InitAddrHash(void)
 {
-    fm_int i;
-    fm_int j;
-    fm_int parity;
+    fm_uint16 hashes[FM10000_MAC_ADDR_BANK_COUNT];
+    fm_uint16 *byteTable;
+    fm_int    i;
+    fm_int    j;
+    fm_int    parity;
+
+    if (fmRootApi->l2lHashTable == NULL)
+    {
+        fmRootApi->l2lHashTable =
+            (fm_int *) fmAlloc(sizeof(fm_int) * L2L_HASH_TABLE_SIZE);
+
+        if (fmRootApi->l2lHashTable == NULL)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_ERR_NO_MEM);
+        }
+    
+        for (i = 0 ; i < L2L_HASH_TABLE_SIZE ; i++)
+        {
+            parity = 0;
+        
+            for (j = 0 ; j < 8 ; j++) 
+            {
+                if ( i & (1 << j) )
+                {
+                    parity ^= 1; 
+                }
+            }
+        
+            fmRootApi->l2lHashTable[i] = parity;
+        }
+    }
 
-    if (fmRootApi->l2lHashTable != NULL)
+    if (fmRootApi->l2lHashByteTable != NULL)
     {
         /* Already initialized, just exit */
         FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_OK);
     }
 
-    fmRootApi->l2lHashTable =
-        (fm_int *) fmAlloc(sizeof(fm_int) * L2L_HASH_TABLE_SIZE);
+    byteTable = (fm_uint16 *) fmAlloc(sizeof(fm_uint16) *
+                                      L2L_HASH_KEY_BYTES *
+                                      L2L_HASH_TABLE_SIZE);
 
-    if (fmRootApi->l2lHashTable == NULL)
+    if (byteTable == NULL)
     {
         FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_ERR_NO_MEM);
     }
-    
-    for (i = 0 ; i < L2L_HASH_TABLE_SIZE ; i++)
+
+    /* The hash of a key with a single non-zero byte is that byte's
+     * contribution to the hash of any key. */
+    for (i = 0 ; i < L2L_HASH_KEY_BYTES ; i++)
     {
-        parity = 0;
-        
-        for (j = 0 ; j < 8 ; j++) 
+        for (j = 0 ; j < L2L_HASH_TABLE_SIZE ; j++)
         {
-            if ( i & (1 << j) )
-            {
-                parity ^= 1; 
-            }
+            CalcAddrHashBitwise( (fm_uint64) j << (8 * i), 1, hashes );
+            byteTable[i * L2L_HASH_TABLE_SIZE + j] = hashes[0];
         }
-        
-        fmRootApi->l2lHashTable[i] = parity;
     }
+
+    fmRootApi->l2lHashByteTable = byteTable;
     
     FM_LOG_EXIT(FM_LOG_CAT_ADDR, FM_OK);
         
@@ -1984,6 +2492,8 @@ fm_status fm10000InitAddressTable(fm_switch * switchPtr)
         switchPtr->maTable[i].state = FM_MAC_ENTRY_STATE_INVALID;
     }
 
+    fmResetAddrTableTracking(switchPtr);
+
     err = fm10000InitAddrHash();
     
     FM_LOG_EXIT(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
@@ -2022,6 +2532,7 @@ fm_status fm10000InvalidateEntryAtIndex(fm_int sw, fm_uint32 index)
 
     /* Invalidate software cache entry. */
     FM_CLEAR(*cachePtr);
+    fmMarkAddrTableEntry(sw, index);
 
     /* Invalidate hardware entries. */
     status = fm10000WriteEntryAtIndex(sw, index, cachePtr);
@@ -2201,10 +2712,10 @@ fm_status fm10000WriteEntryAtIndex(fm_int                   sw,
                                    fm_uint32                index,
                                    fm_internalMacAddrEntry *entry)
 {
-    fm_switch * switchPtr;
-    fm_status   status;
-    fm_status   retVal;
-    fm_uint32   words[FM10000_MA_TABLE_WIDTH];
+    fm_status              retVal;
+    fm_uint32              words[FM10000_MA_TABLE_WIDTH];
+    fm_uint32              usedValue;
+    fm_regTransactionEntry txn[3];
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ADDR,
                          "sw=%d index=%d entry=%p\n",
@@ -2212,29 +2723,32 @@ fm_status fm10000WriteEntryAtIndex(fm_int                   sw,
                          index,
                          (void *) entry);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-
     retVal = fm10000ConvertEntryToWords(sw, entry, words);
 
     if (retVal  == FM_OK)
     {
-        /* write DMAC table entry */
-        status = switchPtr->WriteUINT32Mult(sw,
-                                            FM10000_MA_TABLE(0, index, 0),
-                                            FM10000_MA_TABLE_WIDTH,
-                                            words);
-        FM_ERR_COMBINE(retVal, status);
+        /**************************************************
+         * Write the DMAC and SMAC table entries and reset
+         * the SMAC USED bit as one register burst.
+         **************************************************/
+        usedValue = 1 << (index % 32);
+
+        txn[0].op    = FM_REG_TXN_WRITE;
+        txn[0].addr  = FM10000_MA_TABLE(0, index, 0);
+        txn[0].count = FM10000_MA_TABLE_WIDTH;
+        txn[0].data  = words;
 
-        /* write SMAC table entry */
-        status = switchPtr->WriteUINT32Mult(sw,
-                                            FM10000_MA_TABLE(1, index, 0),
-                                            FM10000_MA_TABLE_WIDTH,
-                                            words);
-        FM_ERR_COMBINE(retVal, status);
+        txn[1].op    = FM_REG_TXN_WRITE;
+        txn[1].addr  = FM10000_MA_TABLE(1, index, 0);
+        txn[1].count = FM10000_MA_TABLE_WIDTH;
+        txn[1].data  = words;
 
-        /* reset USED table entry */
-        status = ResetUsedEntry(sw, index);
-        FM_ERR_COMBINE(retVal, status);
+        txn[2].op    = FM_REG_TXN_WRITE;
+        txn[2].addr  = FM10000_MA_USED_TABLE(1, index / 32);
+        txn[2].count = 1;
+        txn[2].data  = &usedValue;
+
+        retVal = fmCommitRegTransaction(sw, FM_NENTRIES(txn), txn, 0);
 
         if (retVal != FM_OK)
         {
@@ -2273,10 +2787,10 @@ fm_status fm10000WriteSmacEntry(fm_int                    sw,
                                 fm_uint32                 index,
                                 fm_internalMacAddrEntry * entry)
 {
-    fm_switch * switchPtr;
-    fm_uint32   words[FM10000_MA_TABLE_WIDTH];
-    fm_status   retVal;
-    fm_status   status;
+    fm_uint32              words[FM10000_MA_TABLE_WIDTH];
+    fm_uint32              usedValue;
+    fm_status              retVal;
+    fm_regTransactionEntry txn[2];
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ADDR,
                          "sw=%d index=%d entry=%p\n",
@@ -2284,22 +2798,27 @@ fm_status fm10000WriteSmacEntry(fm_int                    sw,
                          index,
                          (void *) entry);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-
     retVal = fm10000ConvertEntryToWords(sw, entry, words);
 
     if (retVal == FM_OK)
     {
-        /* write SMAC table entry */
-        status = switchPtr->WriteUINT32Mult(sw,
-                                            FM10000_MA_TABLE(1, index, 0),
-                                            FM10000_MA_TABLE_WIDTH,
-                                            words);
-        FM_ERR_COMBINE(retVal, status);
+        /**************************************************
+         * Write the SMAC table entry and reset its USED
+         * bit as one register burst.
+         **************************************************/
+        usedValue = 1 << (index % 32);
+
+        txn[0].op    = FM_REG_TXN_WRITE;
+        txn[0].addr  = FM10000_MA_TABLE(1, index, 0);
+        txn[0].count = FM10000_MA_TABLE_WIDTH;
+        txn[0].data  = words;
+
+        txn[1].op    = FM_REG_TXN_WRITE;
+        txn[1].addr  = FM10000_MA_USED_TABLE(1, index / 32);
+        txn[1].count = 1;
+        txn[1].data  = &usedValue;
 
-        /* reset USED table entry */
-        status = ResetUsedEntry(sw, index);
-        FM_ERR_COMBINE(retVal, status);
+        retVal = fmCommitRegTransaction(sw, FM_NENTRIES(txn), txn, 0);
 
         if (retVal != FM_OK)
         {
@@ -2855,6 +2855,11 @@ fm_status fm10000GetSwitchAttribute(fm_int sw, fm_int attr, void *value)
             FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ATTR, err);
             break;
 
+        case FM_SWITCH_PACKET_TX_CLASS_CONFIG:
+        case FM_SWITCH_PACKET_TX_CLASS_STATS:
+            err = FM_FM10000_GET_PACKET_TX_CLASS_ATTR(sw, attr, value);
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
@@ -4053,6 +4058,11 @@ fm_status fm10000SetSwitchAttribute(fm_int sw, fm_int attr, void *value)
             }
             break;
 
+        case FM_SWITCH_PACKET_TX_CLASS_CONFIG:
+        case FM_SWITCH_PACKET_TX_CLASS_STATS:
+            err = FM_FM10000_SET_PACKET_TX_CLASS_ATTR(sw, attr, value);
+            break;
+
         default:
             err = FM_ERR_INVALID_ATTRIB;
             break;
@@ -156,6 +156,95 @@ static void EnterActiveState(fm_int sw, fm_uint64 currentTime)
 
 
 
+/*****************************************************************************/
+/** AgeWord
+ * \ingroup intFastMaint
+ *
+ * \desc            Applies one MA_USED_TABLE word to the aging fields of the
+ *                  ENTRIES_PER_WORD MA Table entries it covers. Computes
+ *                  the new state of every entry without branching, so the
+ *                  loops can be vectorized, and refreshes the aging time
+ *                  of the entries that were used.
+ *
+ * \param[in]       usedBits is the MA_USED_TABLE word.
+ *
+ * \param[in]       now is the low 32 bits of the current aging timer.
+ *
+ * \param[in]       agingTime is the time required for an entry to age
+ *                  from YOUNG to OLD.
+ *
+ * \param[in]       expiryTime is the time required for an entry to age out.
+ *
+ * \param[in]       state points to the entries' current states.
+ *
+ * \param[in,out]   lastUsed points to the entries' aging times.
+ *
+ * \param[out]      newState points to an array of ENTRIES_PER_WORD
+ *                  elements where this function should place the new
+ *                  state of each entry.
+ *
+ * \param[out]      agingMask points to caller-allocated storage where this
+ *                  function should place a mask of the entries that are
+ *                  subject to aging (OLD or YOUNG).
+ *
+ * \return          A mask of the entries whose state has changed.
+ *
+ *****************************************************************************/
+static fm_uint32 AgeWord(fm_uint32       usedBits,
+                         fm_uint32       now,
+                         fm_uint32       agingTime,
+                         fm_uint32       expiryTime,
+                         const fm_byte * state,
+                         fm_uint32 *     lastUsed,
+                         fm_byte *       newState,
+                         fm_uint32 *     agingMask)
+{
+    fm_uint32 changed;
+    fm_uint32 eligible;
+    fm_uint32 cur;
+    fm_uint32 next;
+    fm_uint32 isAging;
+    fm_uint32 isUsed;
+    fm_uint32 elapsed;
+    fm_int    j;
+
+    for (j = 0 ; j < ENTRIES_PER_WORD ; ++j)
+    {
+        cur     = state[j];
+        isAging = (cur == FM_MAC_ENTRY_STATE_OLD) |
+                  (cur == FM_MAC_ENTRY_STATE_YOUNG);
+        isUsed  = (usedBits >> j) & 1;
+        elapsed = now - lastUsed[j];
+
+        next = ( (cur == FM_MAC_ENTRY_STATE_YOUNG) & (elapsed >= agingTime) )
+               ? FM_MAC_ENTRY_STATE_OLD : cur;
+        next = (elapsed >= expiryTime) ? FM_MAC_ENTRY_STATE_EXPIRED : next;
+        next = isUsed ? FM_MAC_ENTRY_STATE_YOUNG : next;
+        next = isAging ? next : cur;
+
+        newState[j] = (fm_byte) next;
+        lastUsed[j] = (isAging & isUsed) ? now : lastUsed[j];
+    }
+
+    changed  = 0;
+    eligible = 0;
+
+    for (j = 0 ; j < ENTRIES_PER_WORD ; ++j)
+    {
+        changed  |= (fm_uint32) (newState[j] != state[j]) << j;
+        eligible |= (fm_uint32) ( (state[j] == FM_MAC_ENTRY_STATE_OLD) |
+                                  (state[j] == FM_MAC_ENTRY_STATE_YOUNG) ) << j;
+    }
+
+    *agingMask = eligible;
+
+    return changed;
+
+}   /* end AgeWord */
+
+
+
+
 /*****************************************************************************/
 /** ProcessSample
  * \ingroup intFastMaint
@@ -197,17 +286,29 @@ static fm_status ProcessSample(fm_int          sw,
 
     fm_switch *     switchPtr;
     fm_uint32       used[numWords];
+    fm_byte         newState[ENTRIES_PER_WORD];
     fm_status       status;
     fm_int          entryIndex;
+    fm_int          firstEntry;
     fm_int          i;
     fm_int          j;
-    fm_uint64       elapsedTime;
+    fm_uint32       now;
+    fm_uint32       aging32;
+    fm_uint32       expiry32;
+    fm_uint32       changed;
+    fm_uint32       agingMask;
+    fm_uint32       youngMask;
     fm_sweepStats   sampleStats;
 
     switchPtr = GET_SWITCH_PTR(sw);
 
     FM_CLEAR(sampleStats);
 
+    /* Aging times are compared modulo 2^32 milliseconds (about 49 days). */
+    now      = (fm_uint32) currentTime;
+    aging32  = (agingTime > 0xFFFFFFFF) ? 0xFFFFFFFF : (fm_uint32) agingTime;
+    expiry32 = (expiryTime > 0xFFFFFFFF) ? 0xFFFFFFFF : (fm_uint32) expiryTime;
+
     FM_TAKE_L2_LOCK(sw);
 
     /* Read next sample from MA_USED_TABLE. */
@@ -243,63 +344,65 @@ static fm_status ProcessSample(fm_int          sw,
     /* Process each word in the sample. */
     for (i = 0 ; i < numWords ; ++i)
     {
-        /* Process each bit in the word. */
-        for (j = 0 ; j < ENTRIES_PER_WORD ; ++j)
+        firstEntry = (index + i) * ENTRIES_PER_WORD;
+
+        changed = AgeWord(used[i],
+                          now,
+                          aging32,
+                          expiry32,
+                          &switchPtr->maTableAgingState[firstEntry],
+                          &switchPtr->maTableAgingTime[firstEntry],
+                          newState,
+                          &agingMask);
+
+        /* Count the dynamic entries that were used. */
+        for (youngMask = used[i] & agingMask ;
+             youngMask != 0 ;
+             youngMask &= youngMask - 1)
         {
-            /* Get the MA Table entry corresponding to this bit. */
-            entryIndex = (index + i) * ENTRIES_PER_WORD + j;
-            cachePtr   = &switchPtr->maTable[entryIndex];
+            ++sampleStats.young;
+        }
 
-            /* We only care about dynamic entries that are eligible
-             * for aging. If it's not one of these, keep going. */
-            if (cachePtr->state != FM_MAC_ENTRY_STATE_OLD &&
-                cachePtr->state != FM_MAC_ENTRY_STATE_YOUNG)
+        /* Apply the state changes to the MA Table cache. */
+        for (j = 0 ; changed != 0 ; ++j, changed >>= 1)
+        {
+            if ( (changed & 1) == 0 )
             {
                 continue;
             }
 
-            /* If the entry is USED, set its state to YOUNG
-             * and restart its aging timer. */
-            if (used[i] & (1 << j))
-            {
-                cachePtr->state = FM_MAC_ENTRY_STATE_YOUNG;
-                cachePtr->agingCounter = currentTime;
-                ++sampleStats.young;
-                continue;
-            }
+            entryIndex = firstEntry + j;
+            cachePtr   = &switchPtr->maTable[entryIndex];
 
-            /* Get the age of this entry. */
-            elapsedTime = currentTime - cachePtr->agingCounter;
+            cachePtr->state = newState[j];
+            fmMarkAddrTableEntry(sw, entryIndex);
 
-            if (elapsedTime >= expiryTime)
+            if (newState[j] == FM_MAC_ENTRY_STATE_EXPIRED)
             {
                 /* The entry has aged out. */
-                cachePtr->state = FM_MAC_ENTRY_STATE_EXPIRED;
                 ++sampleStats.expired;
                 FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
                              "expired: index=%d mac=%012llx vid=%u "
-                             "elapsed=%llu\n",
+                             "elapsed=%u\n",
                              entryIndex,
                              cachePtr->macAddress,
                              cachePtr->vlanID,
-                             elapsedTime);
+                             now - switchPtr->maTableAgingTime[entryIndex]);
             }
-            else if (cachePtr->state == FM_MAC_ENTRY_STATE_YOUNG &&
-                     elapsedTime >= agingTime)
+            else if (newState[j] == FM_MAC_ENTRY_STATE_OLD)
             {
                 /* The entry has gone from YOUNG to OLD. */
-                cachePtr->state = FM_MAC_ENTRY_STATE_OLD;
                 ++sampleStats.old;
                 FM_LOG_DEBUG(FM_LOG_CAT_EVENT_FAST_MAINT,
                              "aged: index=%d mac=%012llx vid=%u "
-                             "elapsed=%llu\n",
+                             "elapsed=%u\n",
                              entryIndex,
                              cachePtr->macAddress,
                              cachePtr->vlanID,
-                             elapsedTime);
+                             now - switchPtr->maTableAgingTime[entryIndex]);
             }
 
-        }   /* end for (j = 0 ; j < ENTRIES_PER_WORD ; ++j) */
+        }   /* end for (j = 0 ; changed != 0 ; ++j, changed >>= 1) */
 
     }   /* for (i = 0 ; i < numWords ; ++i) */
 
@@ -337,11 +440,21 @@ static void UsedSweeperActiveState(fm_int sw, fm_uint64 currentTime)
     fm_sweepStats   stats;
     fm_int          upperBound;
     fm_int          numWords;
+    fm_timestamp    cpuStart;
+    fm_timestamp    cpuEnd;
+    fm_timestamp    cpuUsed;
 
-    switchPtr = GET_SWITCH_PTR(sw);
-    switchExt = switchPtr->extension;
+    fm10000_usedTableSweepStats * sweepStats;
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    switchExt  = switchPtr->extension;
+    sweepStats = &switchExt->usedTableSweepStats;
 
     FM_CLEAR(stats);
+    FM_CLEAR(cpuStart);
+    FM_CLEAR(cpuEnd);
+
+    fmGetThreadCpuTime(&cpuStart);
 
     upperBound = switchExt->usedTableSweeperIndex + USED_TABLE_SAMPLE_SIZE;
     if (upperBound > USED_TABLE_SIZE)
@@ -370,6 +483,33 @@ static void UsedSweeperActiveState(fm_int sw, fm_uint64 currentTime)
 
     }   /* end while (switchExt->usedTableSweeperIndex < upperBound) */
 
+    fmGetThreadCpuTime(&cpuEnd);
+    fmSubTimestamps(&cpuEnd, &cpuStart, &cpuUsed);
+
+    /* The statistics are read and reset under the L2 lock. */
+    FM_TAKE_L2_LOCK(sw);
+
+    sweepStats->currentSweepCpuUsec += cpuUsed.sec * 1000000 + cpuUsed.usec;
+    sweepStats->numYoung            += stats.young;
+    sweepStats->numOld              += stats.old;
+    sweepStats->numExpired          += stats.expired;
+
+    if (switchExt->usedTableSweeperIndex >= USED_TABLE_SIZE)
+    {
+        sweepStats->numSweeps++;
+        sweepStats->lastSweepCpuUsec   = sweepStats->currentSweepCpuUsec;
+        sweepStats->totalSweepCpuUsec += sweepStats->currentSweepCpuUsec;
+
+        if (sweepStats->currentSweepCpuUsec > sweepStats->maxSweepCpuUsec)
+        {
+            sweepStats->maxSweepCpuUsec = sweepStats->currentSweepCpuUsec;
+        }
+
+        sweepStats->currentSweepCpuUsec = 0;
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
     switchExt->usedTableNumExpired += stats.expired;
 
     if (switchExt->usedTableSweeperIndex >= USED_TABLE_SIZE)
@@ -603,6 +743,82 @@ fm_uint64 fm10000GetAgingTimer(void)
 
 
 
+/*****************************************************************************/
+/** fm10000DumpUsedTableSweepStats
+ * \ingroup intFastMaint
+ *
+ * \desc            Displays the MA_USED_TABLE sweeper statistics.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000DumpUsedTableSweepStats(fm_int sw)
+{
+    fm10000_switch *            switchExt;
+    fm10000_usedTableSweepStats stats;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_TAKE_L2_LOCK(sw);
+    stats = switchExt->usedTableSweepStats;
+    FM_DROP_L2_LOCK(sw);
+
+    FM_LOG_PRINT("   MA_USED_TABLE sweeper:\n");
+    FM_LOG_PRINT("      Completed passes     : %" FM_FORMAT_64 "u\n",
+                 stats.numSweeps);
+    FM_LOG_PRINT("      Last pass CPU usec   : %" FM_FORMAT_64 "u\n",
+                 stats.lastSweepCpuUsec);
+    FM_LOG_PRINT("      Max pass CPU usec    : %" FM_FORMAT_64 "u\n",
+                 stats.maxSweepCpuUsec);
+    FM_LOG_PRINT("      Avg pass CPU usec    : %" FM_FORMAT_64 "u\n",
+                 stats.numSweeps ? stats.totalSweepCpuUsec / stats.numSweeps : 0);
+    FM_LOG_PRINT("      Entries used         : %" FM_FORMAT_64 "u\n",
+                 stats.numYoung);
+    FM_LOG_PRINT("      Entries aged to OLD  : %" FM_FORMAT_64 "u\n",
+                 stats.numOld);
+    FM_LOG_PRINT("      Entries expired      : %" FM_FORMAT_64 "u\n",
+                 stats.numExpired);
+    FM_LOG_PRINT("\n");
+
+}   /* end fm10000DumpUsedTableSweepStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetUsedTableSweepStats
+ * \ingroup intFastMaint
+ *
+ * \desc            Resets the MA_USED_TABLE sweeper statistics. The CPU
+ *                  time of a pass in progress is kept.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fm10000ResetUsedTableSweepStats(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_uint64       currentSweepCpuUsec;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_TAKE_L2_LOCK(sw);
+
+    currentSweepCpuUsec = switchExt->usedTableSweepStats.currentSweepCpuUsec;
+    FM_CLEAR(switchExt->usedTableSweepStats);
+    switchExt->usedTableSweepStats.currentSweepCpuUsec = currentSweepCpuUsec;
+
+    FM_DROP_L2_LOCK(sw);
+
+}   /* end fm10000ResetUsedTableSweepStats */
+
+
+
+
 /*****************************************************************************/
 /** fm10000FastMaintenanceTask
  * \ingroup intFastMaint
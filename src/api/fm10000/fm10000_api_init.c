@@ -94,6 +94,137 @@ enum
     FM10000_SOFT_RESET_LOCK_API  = 2,
 };
 
+/* Maximum number of boot workers of a switch */
+#define BOOT_MAX_WORKERS                2
+
+/* Boot worker index of the steps run by the booting thread */
+#define BOOT_WORKER_NONE                -1
+
+#define BOOT_STEP_BIT(step)             (1U << (step))
+
+/* Steps of the switch boot sequence, in the order the booting thread starts
+ * them. A step only depends on steps that come before it. */
+typedef enum
+{
+    BOOT_STEP_RESET = 0,
+    BOOT_STEP_RELEASE,
+    BOOT_STEP_SERDES_OPMODE,
+    BOOT_STEP_SBUS,
+    BOOT_STEP_SERDES,
+    BOOT_STEP_MODEL_PCIE,
+    BOOT_STEP_SCAN,
+    BOOT_STEP_CM,
+    BOOT_STEP_TCN,
+    BOOT_STEP_SCHEDULER,
+    BOOT_STEP_LED,
+    BOOT_STEP_LOOPBACK,
+    BOOT_STEP_SWITCH_READY,
+    BOOT_STEP_GLORT_RANGES,
+    BOOT_STEP_REG_CACHE,
+    BOOT_STEP_CRM,
+    BOOT_STEP_GLORT_CAM,
+    BOOT_STEP_LOGICAL_PORTS,
+    BOOT_STEP_PORT_TABLE,
+    BOOT_STEP_TRIGGERS,
+    BOOT_STEP_STORM,
+    BOOT_STEP_MTABLE,
+    BOOT_STEP_PARITY,
+    BOOT_STEP_PORT_QOS,
+    BOOT_STEP_MTU,
+    BOOT_STEP_SWITCH_INFO,
+    BOOT_STEP_PEP_MAPPING,
+
+    /* UPDATE THIS WHEN ADDING STEPS */
+    BOOT_STEP_MAX
+
+} fm10000_bootStepId;
+
+/* What a boot step does on a warm restart, see CheckWarmRestart */
+typedef enum
+{
+    /* The step programs the hardware or the register cache from scratch.
+     * Running it would disrupt the traffic or undo the restored register
+     * cache, so a sequence with such a step is always cold booted. */
+    BOOT_WARM_REPROGRAM = 0,
+
+    /* The step is skipped, the running switch keeps its state and the
+     * step has no software state to rebuild. */
+    BOOT_WARM_SKIP,
+
+    /* The step runs and rebuilds its state from the restored register
+     * cache, only writing the hardware where it differs. */
+    BOOT_WARM_RECONCILE,
+
+} fm10000_bootWarmPolicy;
+
+/* Step of the switch boot sequence */
+typedef struct _fm10000_bootStep
+{
+    /* Name of the step, also used in error messages */
+    fm_text     name;
+
+    /* Function performing the step */
+    fm_status   (*func)(fm_int sw);
+
+    /* Mask of the steps that must be completed before this one, see
+     * BOOT_STEP_BIT */
+    fm_uint32   deps;
+
+    /* TRUE if the step may run on a boot worker, concurrently with the
+     * steps of the booting thread. Such a step must not take the switch
+     * locks, since the booting thread holds them. */
+    fm_bool     concurrent;
+
+    /* What the step does on a warm restart, see fm10000_bootWarmPolicy */
+    fm10000_bootWarmPolicy warmPolicy;
+
+} fm10000_bootStep;
+
+/* Boot worker thread */
+typedef struct _fm10000_bootWorker
+{
+    /* Switch and index of the worker */
+    fm_int                  sw;
+    fm_int                  index;
+
+    /* Step to run, BOOT_STEP_MAX when idle */
+    fm_int                  stepId;
+
+    /* Timeline where the worker records the step */
+    fm10000_bootTimeline *  timeline;
+
+    /* Pool of the worker */
+    struct _fm10000_bootPool *pool;
+
+    /* Signaled to start the step */
+    fm_semaphore            startSem;
+
+} fm10000_bootWorker;
+
+/* Boot workers of a switch. They are created on the first boot of the
+ * switch and kept until the switch is removed. */
+typedef struct _fm10000_bootPool
+{
+    /* TRUE once the lock and the semaphore below have been created */
+    fm_bool                 initialized;
+
+    /* TRUE to make the workers exit, see FreeBootPool */
+    fm_bool                 exiting;
+
+    /* Number of workers created */
+    fm_int                  nrWorkers;
+
+    /* Protects the completion of the steps run by the workers */
+    fm_lock                 lock;
+
+    /* Signaled by the workers when a step completes */
+    fm_semaphore            doneSem;
+
+    fm_thread               threads[BOOT_MAX_WORKERS];
+    fm10000_bootWorker      workers[BOOT_MAX_WORKERS];
+
+} fm10000_bootPool;
+
 
 /*****************************************************************************
  * Global Variables
@@ -145,6 +276,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .ReleaseSwitch                      = fmPlatformRelease,
     .ResetSwitch                        = fmPlatformReset,
     .SetSwitchState                     = fm10000SetSwitchState,
+    .SaveWarmRestartImage               = fm10000SaveWarmRestartImage,
 
     /**************************************************
      * Switch Attributes
@@ -204,6 +336,7 @@ const fm_switch FM10000SwitchDefaultTable =
     .WriteTagEntry                      = fm10000WriteTagEntry,
     .AddVlanPortList                    = fm10000AddVlanPortList,
     .DeleteVlanPortList                 = fm10000DeleteVlanPortList,
+    .SetVlanPortConfigList              = fm10000SetVlanPortConfigList,
     .SetVlanCounterID                   = fm10000SetVlanCounterID,
 
     /**************************************************
@@ -256,6 +389,8 @@ const fm_switch FM10000SwitchDefaultTable =
     .GetCountersInitMode                = fm10000GetCountersInitMode,
     .GetVLANCounters                    = fm10000GetVLANCounters,
     .ResetVLANCounters                  = fm10000ResetVLANCounters,
+    .GetPortCounterRates                = fm10000GetPortCounterRates,
+    .CollectPortCounters                = fm10000CollectPortCounters,
 
     /**************************************************
      * Packet transmission functions.
@@ -750,6 +885,174 @@ const fm_switch FM10000SwitchDefaultTable =
 
 static fm_status InitCardinalPortMap(fm_switch *switchPtr);
 static void GetIMProperties(fm_int sw);
+static fm_status ResetSwitch(fm_int sw);
+static fm_status ReleaseSwitch(fm_int sw);
+static fm_status SetFHClockFreq(fm_int sw, fm_int fhClock);
+static fm_status BootResetSwitch(fm_int sw);
+static fm_status BootReleaseSwitch(fm_int sw);
+static fm_status BootInitSbus(fm_int sw);
+static fm_status BootReleaseModelPcie(fm_int sw);
+static fm_status BootDisableScan(fm_int sw);
+static fm_status BootDisableLoopbacks(fm_int sw);
+static fm_status BootInitTcnInterrupts(fm_int sw);
+static fm_status BootInitLed(fm_int sw);
+static fm_status BootSetSwitchReady(fm_int sw);
+static fm_status BootInitRegisterCache(fm_int sw);
+static fm_status BootInitCrm(fm_int sw);
+static fm_status BootInitPortTable(fm_int sw);
+static fm_status BootInitTriggers(fm_int sw);
+static fm_status BootInitStormControllers(fm_int sw);
+static fm_status BootInitParity(fm_int sw);
+static fm_status BootInitMtuTable(fm_int sw);
+static fm_status BootGetSwitchInfo(fm_int sw);
+static fm_status BootMapPepPorts(fm_int sw);
+static fm_status fm10000InitializeGlortRanges(fm_int sw);
+static fm_status InitPortQoS(fm_int sw);
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Switch boot sequence. The booting thread starts the steps in this order,
+ * waiting for the steps they depend on, and hands the concurrent steps
+ * over to boot workers. This is the order of the former sequential boot,
+ * except that the EPL loopbacks are disabled after the LED controller is
+ * enabled rather than before the CM is initialized.
+ *
+ * The SPICO image upload to the EPL SerDes only uses the EPL SBus ring.
+ * It overlaps the scan, CM, TCN interrupt, scheduler and LED steps, which
+ * only access the switch core registers, and the model PCIe release,
+ * which does nothing on silicon. On the white model, where that release
+ * reprograms the frame handler clock, the concurrent steps run on the
+ * booting thread. The steps touching the EPLs and the SwitchReady bit
+ * wait for the upload, as does everything after them.
+ *
+ * The last field tells what each step does on a warm restart. Most steps
+ * still reprogram the switch, which keeps warm restarts disabled until
+ * they can reconcile their state with the restored register cache. */
+static const fm10000_bootStep bootSteps[BOOT_STEP_MAX] =
+{
+    [BOOT_STEP_RESET] =
+        { "switch reset", BootResetSwitch, 0, FALSE,
+          BOOT_WARM_SKIP },
+    [BOOT_STEP_RELEASE] =
+        { "switch release", BootReleaseSwitch,
+          BOOT_STEP_BIT(BOOT_STEP_RESET), FALSE,
+          BOOT_WARM_SKIP },
+    [BOOT_STEP_SERDES_OPMODE] =
+        { "SerDes op mode", fm10000SerdesInitOpMode,
+          BOOT_STEP_BIT(BOOT_STEP_RELEASE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_SBUS] =
+        { "EPL SBus", BootInitSbus,
+          BOOT_STEP_BIT(BOOT_STEP_SERDES_OPMODE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_SERDES] =
+        { "SerDes and SPICO code", fm10000InitSwSerdes,
+          BOOT_STEP_BIT(BOOT_STEP_SBUS), TRUE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_MODEL_PCIE] =
+        { "model PCIe release", BootReleaseModelPcie,
+          BOOT_STEP_BIT(BOOT_STEP_RELEASE), FALSE,
+          BOOT_WARM_SKIP },
+    [BOOT_STEP_SCAN] =
+        { "scan", BootDisableScan,
+          BOOT_STEP_BIT(BOOT_STEP_MODEL_PCIE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_CM] =
+        { "CM", fm10000InitializeCM,
+          BOOT_STEP_BIT(BOOT_STEP_MODEL_PCIE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_TCN] =
+        { "TCN FIFO interrupts", BootInitTcnInterrupts,
+          BOOT_STEP_BIT(BOOT_STEP_MODEL_PCIE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_SCHEDULER] =
+        { "scheduler", fm10000InitScheduler,
+          BOOT_STEP_BIT(BOOT_STEP_CM), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_LED] =
+        { "LED controller", BootInitLed,
+          BOOT_STEP_BIT(BOOT_STEP_MODEL_PCIE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_LOOPBACK] =
+        { "switch loopbacks", BootDisableLoopbacks,
+          BOOT_STEP_BIT(BOOT_STEP_MODEL_PCIE) |
+          BOOT_STEP_BIT(BOOT_STEP_SERDES), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_SWITCH_READY] =
+        { "switch ready", BootSetSwitchReady,
+          BOOT_STEP_BIT(BOOT_STEP_SCAN)      |
+          BOOT_STEP_BIT(BOOT_STEP_TCN)       |
+          BOOT_STEP_BIT(BOOT_STEP_SCHEDULER) |
+          BOOT_STEP_BIT(BOOT_STEP_LED)       |
+          BOOT_STEP_BIT(BOOT_STEP_LOOPBACK)  |
+          BOOT_STEP_BIT(BOOT_STEP_SERDES), FALSE,
+          BOOT_WARM_SKIP },
+    [BOOT_STEP_GLORT_RANGES] =
+        { "glort ranges", fm10000InitializeGlortRanges,
+          BOOT_STEP_BIT(BOOT_STEP_SWITCH_READY), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_REG_CACHE] =
+        { "register cache", BootInitRegisterCache,
+          BOOT_STEP_BIT(BOOT_STEP_SWITCH_READY), FALSE,
+          BOOT_WARM_RECONCILE },
+    [BOOT_STEP_CRM] =
+        { "CRM subsystem", BootInitCrm,
+          BOOT_STEP_BIT(BOOT_STEP_REG_CACHE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_GLORT_CAM] =
+        { "glort cam", fm10000InitGlortCam,
+          BOOT_STEP_BIT(BOOT_STEP_GLORT_RANGES) |
+          BOOT_STEP_BIT(BOOT_STEP_CRM), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_LOGICAL_PORTS] =
+        { "logical port subsystem", fmInitializeLogicalPorts,
+          BOOT_STEP_BIT(BOOT_STEP_GLORT_CAM) |
+          BOOT_STEP_BIT(BOOT_STEP_SERDES), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_PORT_TABLE] =
+        { "port table", BootInitPortTable,
+          BOOT_STEP_BIT(BOOT_STEP_LOGICAL_PORTS), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_TRIGGERS] =
+        { "triggers", BootInitTriggers,
+          BOOT_STEP_BIT(BOOT_STEP_PORT_TABLE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_STORM] =
+        { "storm controllers", BootInitStormControllers,
+          BOOT_STEP_BIT(BOOT_STEP_TRIGGERS), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_MTABLE] =
+        { "MTable data structures", fm10000MTableInitialize,
+          BOOT_STEP_BIT(BOOT_STEP_PORT_TABLE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_PARITY] =
+        { "parity subsystem", BootInitParity,
+          BOOT_STEP_BIT(BOOT_STEP_REG_CACHE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_PORT_QOS] =
+        { "cardinal port QoS", InitPortQoS,
+          BOOT_STEP_BIT(BOOT_STEP_PORT_TABLE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_MTU] =
+        { "MTU table", BootInitMtuTable,
+          BOOT_STEP_BIT(BOOT_STEP_SWITCH_READY), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_SWITCH_INFO] =
+        { "switch info", BootGetSwitchInfo,
+          BOOT_STEP_BIT(BOOT_STEP_PORT_TABLE), FALSE,
+          BOOT_WARM_REPROGRAM },
+    [BOOT_STEP_PEP_MAPPING] =
+        { "PEP to logical port mapping", BootMapPepPorts,
+          BOOT_STEP_BIT(BOOT_STEP_LOGICAL_PORTS), FALSE,
+          BOOT_WARM_REPROGRAM },
+};
+
+/* Boot workers of each switch */
+static fm10000_bootPool bootPools[FM_MAX_NUM_SWITCHES];
+
 
 /*****************************************************************************
  * Local Functions
@@ -978,7 +1281,7 @@ ABORT:
  * \ingroup intSwitch
  *
  * \desc            Initializes QoS on the cardinal ports.
- *                  Called by fm10000InitializeAfterReset.
+ *                  Boot step run by fm10000BootSwitch.
  *
  * \param[in]       sw is the switch number.
  *
@@ -1300,229 +1603,6 @@ ABORT:
 
 
 
-/*****************************************************************************/
-/** fm10000InitializeAfterReset
- * \ingroup intSwitch
- *
- * \desc            Further initialization steps following a chip reset.
- *                  Called by fm10000BootSwitch.
- *
- * \param[in]       sw is the switch number.
- *
- * \return          Returns API status code
- *
- *****************************************************************************/
-static fm_status fm10000InitializeAfterReset(fm_int sw)
-{
-    fm_switch *     switchPtr;
-    fm_status       err;
-    fm_int          i;
-    fm_int          port;
-    fm_uint32       devCfg;
-    fm10000_switch *switchExt;
-    fm_int          pepId;
-    fm_bool         isWhiteModel;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
-
-    switchPtr = GET_SWITCH_PTR(sw);
-    switchExt = GET_SWITCH_EXT(sw);
-
-    isWhiteModel = GET_PROPERTY()->isWhiteModel;
-
-    /***************************************************
-     * Initialize glort ranges
-     **************************************************/
-    err = fm10000InitializeGlortRanges(sw);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Unable to initialize glort ranges: %s\n",
-                     fmErrorMsg(err));
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize all the cache arrays
-     **************************************************/
-    err = fm10000InitRegisterCache(sw);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Unable to initialize register cache: %s\n",
-                     fmErrorMsg(err));
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the counter rate monitor subsystem
-     **************************************************/
-
-    if (!isWhiteModel)
-    {
-        err = fm10000InitCrm(sw);
-        if (err != FM_OK)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                         "Unable to initialize CRM subsystem: %s\n",
-                         fmErrorMsg(err));
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-        }
-    }
-
-    /***************************************************
-     * Initialize glort cam
-     **************************************************/
-    err = fm10000InitGlortCam(sw);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize glort cam: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize logical ports
-     **************************************************/
-    err = fmInitializeLogicalPorts(sw);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize logical port subsystem: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the port tables
-     **************************************************/
-    err = fm10000InitPortTable(switchPtr);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize port table: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the triggers
-     **************************************************/
-    err = fm10000InitTriggers(switchPtr);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize triggers: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the storm controllers
-     **************************************************/
-    err = fm10000InitStormControllers(switchPtr);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize storm controllers: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the MTable structures
-     **************************************************/
-    err = fm10000MTableInitialize(switchPtr->switchNumber);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL( FM_LOG_CAT_SWITCH,
-                      "Unable to initialize MTable data structures: %s\n",
-                      fmErrorMsg(err) );
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize the parity subsystem
-     **************************************************/
-    err = fm10000InitParity(switchPtr);
-    if (err != FM_OK)
-    {
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Unable to initialize parity subsystem: %s\n",
-                     fmErrorMsg(err));
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Configure QoS on cardinal ports.
-     **************************************************/
-    err = InitPortQoS(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Set the MTU size to maximum for all MTU entries.
-     **************************************************/
-    for (i = 0 ; i < FM10000_MTU_TABLE_ENTRIES ; i++)
-    {
-        err = switchPtr->WriteUINT32(sw, FM10000_MTU_TABLE(i), 0xffffffff);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /***************************************************
-     * Initialize info struct
-     **************************************************/
-    err = switchPtr->GetSwitchInfo(sw, &switchPtr->info);
-    if (err != FM_OK )
-    {
-        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
-                     "Unable to get switch info: %s\n",
-                     fmErrorMsg(err));
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-
-    /***************************************************
-     * Cache the PEP to logical port mapping
-     **************************************************/
-    err = switchPtr->ReadUINT32(sw,
-                                FM10000_DEVICE_CFG(),
-                                &devCfg);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    for ( pepId = 0; pepId < FM10000_NUM_PEPS; pepId++ )
-    {
-        if ( FM_GET_UNNAMED_FIELD(devCfg,
-                                 FM10000_DEVICE_CFG_b_PCIeEnable_0 + pepId,
-                                 1))
-        {
-            /* map the PEP to its logical port */
-            err = fm10000MapPepToLogicalPort( sw, pepId, &port );
-
-            if (err != FM_OK)
-            {
-                FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
-                               "pepId=%d has no logical port defined\n",
-                               pepId);
-
-                /* Flag the mapping as invalid */
-                switchExt->pepPortMapping[pepId] = FM10000_PCIE_INVALID_LOGICAL_PORT;
-
-                err = FM_OK;
-                continue;
-            }
-
-            switchExt->pepPortMapping[pepId] = port;
-        }
-    }
-
-ABORT:
-    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
-
-}   /* end fm10000InitializeAfterReset */
-
-
-
-
 /*****************************************************************************/
 /** InitDefaultAttributes
  * \ingroup intSwitch
@@ -2277,6 +2357,7 @@ ABORT:
 static fm_status ResetSwitchExtension(fm_switch * switchPtr)
 {
     fm10000_switch *switchExt;
+    fm_lock         sbusLock[FM10000_SBUS_NUM_RINGS];
 
     if (switchPtr == NULL)
     {
@@ -2287,11 +2368,23 @@ static fm_status ResetSwitchExtension(fm_switch * switchPtr)
 
     if (switchExt)
     {
+        /* The SBus ring locks live as long as the switch, they are
+         * deleted by fm10000FreeDataStructures. */
+        FM_MEMCPY_S(sbusLock,
+                    sizeof(sbusLock),
+                    switchExt->sbusLock,
+                    sizeof(switchExt->sbusLock));
+
         /* Zero the switch extension structure. */
         FM_CLEAR(*switchExt);
 
         /* Restore pointer to base structure. */
         switchExt->base = switchPtr;
+
+        FM_MEMCPY_S(switchExt->sbusLock,
+                    sizeof(switchExt->sbusLock),
+                    sbusLock,
+                    sizeof(sbusLock));
     }
 
     return FM_OK;
@@ -2475,16 +2568,15 @@ ABORT:
 }   /* end CreateSendDirectedTrigger */
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
 
 
 /*****************************************************************************/
-/** fm10000TakeSoftResetLock
+/** BootResetSwitch
  * \ingroup intSwitch
  *
- * \desc            Take SOFT_RESET lock to avoid contention with NVM.
+ * \desc            Boot step putting the switch domain into reset and
+ *                  setting up the FABRIC_PLL for the requested frame
+ *                  handler clock.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -2492,45 +2584,1289 @@ ABORT:
  * \return          Other ''Status Codes'' as appropriate in case of failure.
  *
  *****************************************************************************/
-fm_status fm10000TakeSoftResetLock(fm_int sw)
+static fm_status BootResetSwitch(fm_int sw)
 {
-    fm_status       err;
-    fm_switch *     switchPtr;
-    fm_uint         waitLoopCnt;
-    fm_uint32       softReset;
-    fm_uint32       PCIeActive;
-    fm_uint         delayNsec;
-    fm_uint         totalDelayNsec;
-    fm_int          cnt;
-    fm_uint         nvmVer;
-
-    switchPtr = GET_SWITCH_PTR(sw);
+    fm_status err;
+    fm_int    fhClock;
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
 
-    err = fm10000GetNvmImageVersion(sw, &nvmVer);
+    /***************************************************
+     * Put the switch domain into reset. We may be
+     * recovering from a bad state so we must enforce
+     * reset state here such that we have a clean start.
+     **************************************************/
+    err = ResetSwitch(sw);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-    if ( nvmVer >= NVM_PCIE_RECOVERY_VER )
-    {
-        /* Has support for locking in NVM */
-        for (cnt = 0; cnt < 3; cnt++)
-        {
-            /* Wait for lock is free */
-            err = WaitForSoftResetLockOwner(sw, FM10000_SOFT_RESET_LOCK_FREE, 1000*1000*2000);
-            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    /***************************************************
+     * We are in reset, let's setup the FABRIC_PLL based
+     * on requested frame handler clock.
+     **************************************************/
 
-            /* Write to take lock
-             * 0: free
-             * 2: API
-             * x: others
-             */
-            err = switchPtr->WriteUINT32( sw,
-                                          FM10000_BSM_SCRATCH(2),
-                                          FM10000_SOFT_RESET_LOCK_API );
-            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    /* Retrieve the clock from platform config attribute */
+    fhClock = GET_SWITCH_PTR(sw)->fhClock;
 
-            /* NVM is slower, so must delay before checking */
+    if ( ( (fhClock < 0) && (fhClock != -1)) ||
+         (fhClock > MAX_INT_VALUE) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Switch %d frame handler clock is out of range: [-1, %d]\n",
+                     sw,
+                     MAX_INT_VALUE);
+
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /* Configure the clock */
+    err = SetFHClockFreq(sw, fhClock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootResetSwitch */
+
+
+
+
+/*****************************************************************************/
+/** BootReleaseSwitch
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step taking the EPLs and the switch out of reset.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootReleaseSwitch(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                 "Taking switch fabric/EPL domain %d out of reset... \n", sw);
+
+    err = ReleaseSwitch(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootReleaseSwitch */
+
+
+
+
+/*****************************************************************************/
+/** BootInitSbus
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the switch SBus (EPL ring only).
+ *                  The SerDes op mode must be determined first.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitSbus(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000SbusInit(sw, TRUE);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitSbus */
+
+
+
+
+/*****************************************************************************/
+/** BootReleaseModelPcie
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step taking the PCIe devices of the white model out
+ *                  of warm reset. Nothing is done on real silicon.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootReleaseModelPcie(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  rv;
+    fm_uint32  pcieEnable;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    if (!GET_PROPERTY()->isWhiteModel)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Must be done after ReleaseSwitch because the model starts changing
+     * SOFT_RESET during its init */
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                 "Setting PCIeReset to ~PCIeEnable ... \n");
+
+    /* Need to take PCIe devices out of warm reset */
+    err = switchPtr->ReadUINT32(sw, FM10000_DEVICE_CFG(), &rv);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    pcieEnable = FM_GET_UNNAMED_FIELD(rv,
+                                      FM10000_DEVICE_CFG_b_PCIeEnable_0,
+                                      FM10000_NUM_PEPS);
+
+    err = fm10000TakeSoftResetLock(sw);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    err = switchPtr->ReadUINT32(sw, FM10000_SOFT_RESET(), &rv);
+    if (err == FM_OK)
+    {
+        /* PCIeReset and PCIeEnable are going to be the same value */
+        FM_SET_FIELD(rv, FM10000_SOFT_RESET, PCIeReset, ~pcieEnable);
+
+        err = switchPtr->WriteUINT32(sw, FM10000_SOFT_RESET(), rv);
+    }
+
+    fm10000DropSoftResetLock(sw);
+
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    /* Configure the clock (because the Release Switch cleared
+     * register values) */
+    err = SetFHClockFreq(sw, switchPtr->fhClock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootReleaseModelPcie */
+
+
+
+
+/*****************************************************************************/
+/** BootDisableScan
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step disabling scan.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootDisableScan(fm_int sw)
+{
+    fm_status err;
+    fm_uint32 rv;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Disabling SCAN...\n");
+
+    rv = 0;
+    FM_SET_BIT(rv, FM10000_SCAN_DATA_IN, UpdateNodes, 1);
+    FM_SET_BIT(rv, FM10000_SCAN_DATA_IN, Passthru, 1);
+
+    err = GET_SWITCH_PTR(sw)->WriteUINT32(sw, FM10000_SCAN_DATA_IN(), rv);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootDisableScan */
+
+
+
+
+/*****************************************************************************/
+/** BootDisableLoopbacks
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step disabling the loopback on the EPLs. The
+ *                  loopback on the TEs is disabled by the TE init function.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootDisableLoopbacks(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  regAddr;
+    fm_uint32  rv;
+    fm_int     i;
+    fm_bool    regLockTaken;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Disabling switch loopbacks...\n");
+
+    switchPtr    = GET_SWITCH_PTR(sw);
+    regLockTaken = FALSE;
+    err          = FM_OK;
+
+    FM_FLAG_TAKE_REG_LOCK(sw);
+
+    for (i = 0 ; i < FM10000_NUM_EPLS ; i++)
+    {
+        regAddr = FM10000_EPL_CFG_A(i);
+
+        err = switchPtr->ReadUINT32(sw, regAddr, &rv);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+        FM_SET_FIELD(rv, FM10000_EPL_CFG_A, Active, 1);
+
+        err = switchPtr->WriteUINT32(sw, regAddr, rv);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+ABORT:
+    if (regLockTaken)
+    {
+        FM_FLAG_DROP_REG_LOCK(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootDisableLoopbacks */
+
+
+
+
+/*****************************************************************************/
+/** BootInitTcnInterrupts
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the TCN FIFO interrupts.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitTcnInterrupts(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  rv;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing TCN FIFO Interrupts...\n");
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = switchPtr->WriteUINT32(sw, FM10000_MA_TCN_IM(), 0);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    rv = 0;
+    FM_SET_BIT(rv, FM10000_FH_TAIL_IM, TCN, 1);
+
+    err = switchPtr->MaskUINT32(sw, FM10000_FH_TAIL_IM(), rv, FALSE);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitTcnInterrupts */
+
+
+
+
+/*****************************************************************************/
+/** BootInitLed
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step enabling the LED controller.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitLed(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  rv;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing LED Controller...\n");
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    TAKE_REG_LOCK(sw);
+
+    err = switchPtr->ReadUINT32(sw, FM10000_LED_CFG(), &rv);
+    if (err == FM_OK)
+    {
+        FM_SET_BIT(rv, FM10000_LED_CFG, LEDEnable, 1);
+
+        err = switchPtr->WriteUINT32(sw, FM10000_LED_CFG(), rv);
+    }
+
+    DROP_REG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitLed */
+
+
+
+
+/*****************************************************************************/
+/** BootSetSwitchReady
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step asserting SwitchReady.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootSetSwitchReady(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  rv;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Marking switch as ready...\n");
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    TAKE_REG_LOCK(sw);
+
+    err = fm10000TakeSoftResetLock(sw);
+    if (err == FM_OK)
+    {
+        err = switchPtr->ReadUINT32(sw, FM10000_SOFT_RESET(), &rv);
+        if (err == FM_OK)
+        {
+            FM_SET_BIT(rv, FM10000_SOFT_RESET, SwitchReady, 1);
+
+            err = switchPtr->WriteUINT32(sw, FM10000_SOFT_RESET(), rv);
+        }
+
+        fm10000DropSoftResetLock(sw);
+    }
+
+    DROP_REG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootSetSwitchReady */
+
+
+
+
+/*****************************************************************************/
+/** BootInitRegisterCache
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the register cache. On a warm
+ *                  restart it is restored from the image named by
+ *                  ''api.FM10000.warmRestartImage'', and the hardware is
+ *                  only written where it differs from the image. If the
+ *                  restore fails, the cache is read from the hardware as
+ *                  on a cold boot, which keeps it consistent with the
+ *                  hardware.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitRegisterCache(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_status       err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    if (switchExt->bootTimeline.warmRestart)
+    {
+        err = fmRegCacheRestoreImage(sw,
+                                     GET_FM10000_PROPERTY()->warmRestartImage,
+                                     NULL);
+        if (err == FM_OK)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+        }
+
+        FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
+                       "Switch %d: unable to restore the register cache "
+                       "from %s (%s), reading it from the hardware\n",
+                       sw,
+                       GET_FM10000_PROPERTY()->warmRestartImage,
+                       fmErrorMsg(err));
+    }
+
+    err = fm10000InitRegisterCache(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitRegisterCache */
+
+
+
+
+/*****************************************************************************/
+/** BootInitCrm
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the counter rate monitor
+ *                  subsystem. It is not used on the white model.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitCrm(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    if (GET_PROPERTY()->isWhiteModel)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+    }
+
+    err = fm10000InitCrm(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitCrm */
+
+
+
+
+/*****************************************************************************/
+/** BootInitPortTable
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the port tables.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitPortTable(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000InitPortTable(GET_SWITCH_PTR(sw));
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitPortTable */
+
+
+
+
+/*****************************************************************************/
+/** BootInitTriggers
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the triggers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitTriggers(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000InitTriggers(GET_SWITCH_PTR(sw));
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitTriggers */
+
+
+
+
+/*****************************************************************************/
+/** BootInitStormControllers
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the storm controllers.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitStormControllers(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000InitStormControllers(GET_SWITCH_PTR(sw));
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitStormControllers */
+
+
+
+
+/*****************************************************************************/
+/** BootInitParity
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the parity subsystem.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitParity(fm_int sw)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000InitParity(GET_SWITCH_PTR(sw));
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitParity */
+
+
+
+
+/*****************************************************************************/
+/** BootInitMtuTable
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step setting the MTU size to maximum for all MTU
+ *                  entries.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootInitMtuTable(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_int     i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    err       = FM_OK;
+
+    for (i = 0 ; i < FM10000_MTU_TABLE_ENTRIES && err == FM_OK ; i++)
+    {
+        err = switchPtr->WriteUINT32(sw, FM10000_MTU_TABLE(i), 0xffffffff);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootInitMtuTable */
+
+
+
+
+/*****************************************************************************/
+/** BootGetSwitchInfo
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step initializing the switch info structure.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootGetSwitchInfo(fm_int sw)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    err = switchPtr->GetSwitchInfo(sw, &switchPtr->info);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end BootGetSwitchInfo */
+
+
+
+
+/*****************************************************************************/
+/** BootMapPepPorts
+ * \ingroup intSwitch
+ *
+ * \desc            Boot step caching the PEP to logical port mapping.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status BootMapPepPorts(fm_int sw)
+{
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm10000_switch *switchExt;
+    fm_uint32       devCfg;
+    fm_int          pepId;
+    fm_int          port;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+
+    err = switchPtr->ReadUINT32(sw,
+                                FM10000_DEVICE_CFG(),
+                                &devCfg);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    for ( pepId = 0; pepId < FM10000_NUM_PEPS; pepId++ )
+    {
+        if ( FM_GET_UNNAMED_FIELD(devCfg,
+                                 FM10000_DEVICE_CFG_b_PCIeEnable_0 + pepId,
+                                 1))
+        {
+            /* map the PEP to its logical port */
+            err = fm10000MapPepToLogicalPort( sw, pepId, &port );
+
+            if (err != FM_OK)
+            {
+                FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
+                               "pepId=%d has no logical port defined\n",
+                               pepId);
+
+                /* Flag the mapping as invalid */
+                switchExt->pepPortMapping[pepId] = FM10000_PCIE_INVALID_LOGICAL_PORT;
+
+                continue;
+            }
+
+            switchExt->pepPortMapping[pepId] = port;
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+
+}   /* end BootMapPepPorts */
+
+
+
+
+/*****************************************************************************/
+/** GetBootElapsedUsec
+ * \ingroup intSwitch
+ *
+ * \desc            Returns the time elapsed since the start of the boot.
+ *
+ * \param[in]       timeline points to the timeline of the boot.
+ *
+ * \return          The elapsed time in microseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 GetBootElapsedUsec(fm10000_bootTimeline *timeline)
+{
+    fm_timestamp now;
+    fm_timestamp diff;
+
+    fmGetTime(&now);
+    fmSubTimestamps(&now, &timeline->start, &diff);
+
+    return diff.sec * 1000000 + diff.usec;
+
+}   /* end GetBootElapsedUsec */
+
+
+
+
+/*****************************************************************************/
+/** RunBootStep
+ * \ingroup intSwitch
+ *
+ * \desc            Runs and times one step of the boot sequence.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       timeline points to the timeline of the boot.
+ *
+ * \param[in]       stepId is the step to run.
+ *
+ * \param[in]       worker is the boot worker running the step, or
+ *                  BOOT_WORKER_NONE for the booting thread.
+ *
+ * \return          The status of the step.
+ *
+ *****************************************************************************/
+static fm_status RunBootStep(fm_int                sw,
+                             fm10000_bootTimeline *timeline,
+                             fm_int                stepId,
+                             fm_int                worker)
+{
+    const fm10000_bootStep *step;
+    fm10000_bootStepTime *  stepTime;
+    fm_status               err;
+
+    step     = &bootSteps[stepId];
+    stepTime = &timeline->step[stepId];
+
+    stepTime->worker    = worker;
+    stepTime->startUsec = GetBootElapsedUsec(timeline);
+
+    err = step->func(sw);
+
+    stepTime->endUsec = GetBootElapsedUsec(timeline);
+    stepTime->status  = err;
+
+    if (err != FM_OK)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH,
+                     "Switch %d boot failed at step '%s': %s\n",
+                     sw,
+                     step->name,
+                     fmErrorMsg(err));
+    }
+
+    return err;
+
+}   /* end RunBootStep */
+
+
+
+
+/*****************************************************************************/
+/** BootWorkerThread
+ * \ingroup intSwitch
+ *
+ * \desc            Boot worker. Runs the concurrent boot steps handed over
+ *                  by the booting thread.
+ *
+ * \param[in]       args contains the thread handle and a pointer to the
+ *                  worker's ''fm10000_bootWorker'' structure.
+ *
+ * \return          None, the worker lives until the switch is removed.
+ *
+ *****************************************************************************/
+static void *BootWorkerThread(void *args)
+{
+    fm10000_bootWorker *worker;
+    fm10000_bootPool *  pool;
+
+    worker = FM_GET_THREAD_PARAM(fm10000_bootWorker, args);
+    pool   = worker->pool;
+
+    while (TRUE)
+    {
+        fmWaitSemaphore(&worker->startSem, FM_WAIT_FOREVER);
+
+        if (pool->exiting)
+        {
+            break;
+        }
+
+        RunBootStep(worker->sw,
+                    worker->timeline,
+                    worker->stepId,
+                    worker->index);
+
+        fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+        worker->timeline->step[worker->stepId].done = TRUE;
+        fmReleaseLock(&pool->lock);
+
+        fmSignalSemaphore(&pool->doneSem);
+    }
+
+    fmExitThread(&pool->threads[worker->index]);
+
+    return NULL;
+
+}   /* end BootWorkerThread */
+
+
+
+
+/*****************************************************************************/
+/** GetIdleBootWorker
+ * \ingroup intSwitch
+ *
+ * \desc            Returns an idle boot worker of a switch, creating it if
+ *                  all the existing workers are busy.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          The boot worker, NULL if none is available.
+ *
+ *****************************************************************************/
+static fm10000_bootWorker *GetIdleBootWorker(fm_int sw)
+{
+    fm10000_bootPool *  pool;
+    fm10000_bootWorker *worker;
+    fm_status           err;
+    fm_char             name[32];
+    fm_int              i;
+
+    pool = &bootPools[sw];
+
+    for (i = 0 ; i < pool->nrWorkers ; i++)
+    {
+        if (pool->workers[i].stepId == BOOT_STEP_MAX)
+        {
+            return &pool->workers[i];
+        }
+    }
+
+    if (pool->nrWorkers >= BOOT_MAX_WORKERS)
+    {
+        return NULL;
+    }
+
+    /* the lock and semaphore are kept if a worker cannot be created, so
+     * that the next attempt does not create them again */
+    if (!pool->initialized)
+    {
+        FM_SPRINTF_S(name, sizeof(name), "Boot Lock %d", sw);
+        err = fmCreateLock(name, &pool->lock);
+        if (err != FM_OK)
+        {
+            return NULL;
+        }
+
+        FM_SPRINTF_S(name, sizeof(name), "Boot Done %d", sw);
+        err = fmCreateSemaphore(name, FM_SEM_BINARY, &pool->doneSem, 0);
+        if (err != FM_OK)
+        {
+            fmDeleteLock(&pool->lock);
+            return NULL;
+        }
+
+        pool->initialized = TRUE;
+    }
+
+    worker = &pool->workers[pool->nrWorkers];
+    worker->sw     = sw;
+    worker->index  = pool->nrWorkers;
+    worker->stepId = BOOT_STEP_MAX;
+    worker->pool   = pool;
+
+    FM_SPRINTF_S(name, sizeof(name), "Boot Start %d.%d", sw, worker->index);
+    err = fmCreateSemaphore(name, FM_SEM_BINARY, &worker->startSem, 0);
+    if (err != FM_OK)
+    {
+        return NULL;
+    }
+
+    FM_SPRINTF_S(name, sizeof(name), "Boot Worker %d.%d", sw, worker->index);
+    err = fmCreateThread(name,
+                         FM_EVENT_QUEUE_SIZE_NONE,
+                         BootWorkerThread,
+                         worker,
+                         &pool->threads[worker->index]);
+    if (err != FM_OK)
+    {
+        fmDeleteSemaphore(&worker->startSem);
+        return NULL;
+    }
+
+    pool->nrWorkers++;
+
+    return worker;
+
+}   /* end GetIdleBootWorker */
+
+
+
+
+/*****************************************************************************/
+/** FreeBootPool
+ * \ingroup intSwitch
+ *
+ * \desc            Stops the boot workers of a switch and frees their
+ *                  resources. No boot may be in progress on the switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void FreeBootPool(fm_int sw)
+{
+    fm10000_bootPool *  pool;
+    fm10000_bootWorker *worker;
+    fm_int              i;
+
+    pool = &bootPools[sw];
+
+    pool->exiting = TRUE;
+
+    for (i = 0 ; i < pool->nrWorkers ; i++)
+    {
+        worker = &pool->workers[i];
+
+        fmSignalSemaphore(&worker->startSem);
+        fmWaitThreadExit(&pool->threads[i]);
+        fmDeleteSemaphore(&worker->startSem);
+    }
+
+    if (pool->initialized)
+    {
+        fmDeleteSemaphore(&pool->doneSem);
+        fmDeleteLock(&pool->lock);
+    }
+
+    FM_CLEAR(*pool);
+
+}   /* end FreeBootPool */
+
+
+
+
+/*****************************************************************************/
+/** CheckWarmRestart
+ * \ingroup intSwitch
+ *
+ * \desc            Determines whether the switch can be warm restarted: a
+ *                  register cache image is configured with
+ *                  ''api.FM10000.warmRestartImage'', every boot step can
+ *                  be skipped or reconciled with the restored cache (see
+ *                  ''fm10000_bootWarmPolicy''), the switch is still out of
+ *                  reset and ready from the previous run, and the image
+ *                  matches the register cache of the switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          TRUE if the switch reset can be skipped and the register
+ *                  cache restored from the image.
+ *
+ *****************************************************************************/
+static fm_bool CheckWarmRestart(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_text    imageName;
+    fm_uint32  rv;
+    fm_status  err;
+    fm_int     stepId;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    imageName = GET_FM10000_PROPERTY()->warmRestartImage;
+
+    if (imageName[0] == '\0')
+    {
+        return FALSE;
+    }
+
+    for (stepId = 0 ; stepId < BOOT_STEP_MAX ; stepId++)
+    {
+        if (bootSteps[stepId].warmPolicy == BOOT_WARM_REPROGRAM)
+        {
+            FM_LOG_INFO(FM_LOG_CAT_SWITCH,
+                        "Switch %d: boot step '%s' does not support warm "
+                        "restarts, cold booting\n",
+                        sw,
+                        bootSteps[stepId].name);
+            return FALSE;
+        }
+    }
+
+    err = switchPtr->ReadUINT32(sw, FM10000_SOFT_RESET(), &rv);
+    if (err != FM_OK)
+    {
+        return FALSE;
+    }
+
+    if ( FM_GET_BIT(rv, FM10000_SOFT_RESET, SwitchReset) ||
+         !FM_GET_BIT(rv, FM10000_SOFT_RESET, SwitchReady) )
+    {
+        FM_LOG_INFO(FM_LOG_CAT_SWITCH,
+                    "Switch %d is not running, cold booting\n",
+                    sw);
+        return FALSE;
+    }
+
+    err = fmRegCacheCheckImage(sw, imageName);
+    if (err != FM_OK)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
+                       "Switch %d: register cache image %s is not usable "
+                       "(%s), cold booting\n",
+                       sw,
+                       imageName,
+                       fmErrorMsg(err));
+        return FALSE;
+    }
+
+    return TRUE;
+
+}   /* end CheckWarmRestart */
+
+
+
+
+/*****************************************************************************/
+/** RunBootSequence
+ * \ingroup intSwitch
+ *
+ * \desc            Runs the boot sequence of a switch, see ''bootSteps''.
+ *                  The booting thread starts the steps in table order,
+ *                  waiting for the steps each one depends on, and hands
+ *                  the concurrent steps over to boot workers. Each step is
+ *                  timed in the switch's boot timeline.
+ *                                                                      \lb\lb
+ *                  On failure, no further step is started and the steps
+ *                  in progress on the workers are waited for.
+ *                                                                      \lb\lb
+ *                  On a warm restart, see ''CheckWarmRestart'', the steps
+ *                  are skipped or reconcile their state according to their
+ *                  ''fm10000_bootWarmPolicy''. The register cache step
+ *                  restores the cache from its image.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          The status of the first step that failed otherwise.
+ *
+ *****************************************************************************/
+static fm_status RunBootSequence(fm_int sw)
+{
+    fm10000_switch *      switchExt;
+    fm10000_bootTimeline *timeline;
+    fm10000_bootPool *    pool;
+    fm10000_bootWorker *  worker;
+    fm_status             err;
+    fm_uint32             doneMask;
+    fm_int                nrInFlight;
+    fm_int                nextStep;
+    fm_int                stepId;
+    fm_int                i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    timeline  = &switchExt->bootTimeline;
+    pool      = &bootPools[sw];
+
+    FM_CLEAR(*timeline);
+    fmGetTime(&timeline->start);
+    timeline->nrSteps     = BOOT_STEP_MAX;
+    timeline->warmRestart = CheckWarmRestart(sw);
+
+    err        = FM_OK;
+    doneMask   = 0;
+    nrInFlight = 0;
+    nextStep   = 0;
+
+    while (TRUE)
+    {
+        /**************************************************
+         * Collect the steps completed by the workers.
+         **************************************************/
+        if (nrInFlight > 0)
+        {
+            fmCaptureLock(&pool->lock, FM_WAIT_FOREVER);
+
+            for (i = 0 ; i < pool->nrWorkers ; i++)
+            {
+                worker = &pool->workers[i];
+
+                if ( (worker->stepId != BOOT_STEP_MAX) &&
+                     timeline->step[worker->stepId].done )
+                {
+                    doneMask |= BOOT_STEP_BIT(worker->stepId);
+
+                    if (err == FM_OK)
+                    {
+                        err = timeline->step[worker->stepId].status;
+                    }
+
+                    worker->stepId = BOOT_STEP_MAX;
+                    nrInFlight--;
+                }
+            }
+
+            fmReleaseLock(&pool->lock);
+        }
+
+        /**************************************************
+         * Take the next step in table order once the steps
+         * it depends on are done. Since they all come
+         * before it, they are done or in progress on a
+         * worker.
+         **************************************************/
+        stepId = BOOT_STEP_MAX;
+
+        if ( (err == FM_OK) &&
+             (nextStep < BOOT_STEP_MAX) &&
+             ( (bootSteps[nextStep].deps & ~doneMask) == 0 ) )
+        {
+            stepId = nextStep++;
+        }
+
+        if (stepId == BOOT_STEP_MAX)
+        {
+            if (nrInFlight == 0)
+            {
+                /* all the steps are done, or the boot failed */
+                break;
+            }
+
+            /* wait for a worker to complete its step */
+            fmWaitSemaphore(&pool->doneSem, FM_WAIT_FOREVER);
+            continue;
+        }
+
+        /**************************************************
+         * A warm restart keeps the switch running, the
+         * steps with nothing to reconcile are skipped.
+         **************************************************/
+        if ( timeline->warmRestart &&
+             (bootSteps[stepId].warmPolicy == BOOT_WARM_SKIP) )
+        {
+            timeline->step[stepId].skipped = TRUE;
+            doneMask |= BOOT_STEP_BIT(stepId);
+            continue;
+        }
+
+        timeline->step[stepId].started = TRUE;
+
+        /**************************************************
+         * Hand a concurrent step over to an idle worker,
+         * otherwise run it here.
+         **************************************************/
+        worker = NULL;
+
+        if (bootSteps[stepId].concurrent && !GET_PROPERTY()->isWhiteModel)
+        {
+            worker = GetIdleBootWorker(sw);
+        }
+
+        if (worker != NULL)
+        {
+            worker->stepId   = stepId;
+            worker->timeline = timeline;
+            nrInFlight++;
+
+            fmSignalSemaphore(&worker->startSem);
+            continue;
+        }
+
+        err = RunBootStep(sw, timeline, stepId, BOOT_WORKER_NONE);
+
+        timeline->step[stepId].done = TRUE;
+        doneMask |= BOOT_STEP_BIT(stepId);
+    }
+
+    timeline->totalUsec = GetBootElapsedUsec(timeline);
+    timeline->status    = err;
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end RunBootSequence */
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fm10000TakeSoftResetLock
+ * \ingroup intSwitch
+ *
+ * \desc            Take SOFT_RESET lock to avoid contention with NVM.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fm10000TakeSoftResetLock(fm_int sw)
+{
+    fm_status       err;
+    fm_switch *     switchPtr;
+    fm_uint         waitLoopCnt;
+    fm_uint32       softReset;
+    fm_uint32       PCIeActive;
+    fm_uint         delayNsec;
+    fm_uint         totalDelayNsec;
+    fm_int          cnt;
+    fm_uint         nvmVer;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    err = fm10000GetNvmImageVersion(sw, &nvmVer);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    if ( nvmVer >= NVM_PCIE_RECOVERY_VER )
+    {
+        /* Has support for locking in NVM */
+        for (cnt = 0; cnt < 3; cnt++)
+        {
+            /* Wait for lock is free */
+            err = WaitForSoftResetLockOwner(sw, FM10000_SOFT_RESET_LOCK_FREE, 1000*1000*2000);
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            /* Write to take lock
+             * 0: free
+             * 2: API
+             * x: others
+             */
+            err = switchPtr->WriteUINT32( sw,
+                                          FM10000_BSM_SCRATCH(2),
+                                          FM10000_SOFT_RESET_LOCK_API );
+            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+            /* NVM is slower, so must delay before checking */
             fmDelay(0, 50*1000);
 
             /* Check to make sure lock is taken correctly, if not try again */
@@ -2845,6 +4181,9 @@ fm_status fm10000AllocateDataStructures(fm_switch *switchPtr)
     err = fmMailboxAllocateDataStructures(sw);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
+    err = fm10000SbusAllocateResources(sw);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
 
 }   /* end fm10000AllocateDataStructures */
@@ -2897,6 +4236,17 @@ fm_status fm10000FreeDataStructures(fm_switch *switchPtr)
         /* Don't return, just continue on */
     }
 
+    err = fm10000SbusFreeResources(switchPtr->switchNumber);
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                      "Error freeing SBus resources: %s\n",
+                      fmErrorMsg(err) );
+        /* Don't return, just continue on */
+    }
+
+    FreeBootPool(switchPtr->switchNumber);
+
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
 
 }   /* end fm10000FreeDataStructures */
@@ -2961,6 +4311,16 @@ fm_status fm10000FreeResources(fm_int sw)
         /* Don't return, just continue on */
     }
 
+    err = fm10000FreeCounters(sw);
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                      "Error freeing statistics resources: %s\n",
+                      fmErrorMsg(err) );
+        retErr = err;
+        /* Don't return, just continue on */
+    }
+
     err = fm10000TunnelFree(sw);
     if (err != FM_OK)
     {
@@ -3189,6 +4549,9 @@ fm_status fm10000FreeResources(fm_int sw)
  *
  * \desc            Performs the auto-boot process on a chip.
  *                  Called by fm10000SetSwitchState.
+ *                                                                      \lb\lb
+ *                  The independent boot steps run concurrently and every
+ *                  step is timed, see ''fm10000DbgDumpBootTimeline''.
  *
  * \param[in]       sw contains the switch number
  *
@@ -3198,30 +4561,12 @@ fm_status fm10000FreeResources(fm_int sw)
 fm_status fm10000BootSwitch(fm_int sw)
 {
     fm_status           err;
-    fm_switch *         switchPtr;
     fm10000_switch *    switchExt;
-    fm_uint32           rv;
-    fm_uint32           regAddr;
-    fm_uint32           pcieEnable;
-    fm_int              i;
-    fm_uint32           rvMult[4] = {0,0,0,0};
-    fm_bool             regLockTaken;
-    fm_int              fhClock;
-#if 0
-    fm_timestamp t1;
-    fm_timestamp t2;
-    fm_timestamp tDiff;
-
-    fmGetTime(&t1);
-#endif
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
 
-    switchPtr = GET_SWITCH_PTR(sw);
     switchExt = GET_SWITCH_EXT(sw);
 
-    regLockTaken = FALSE;
-
 #if defined(FV_CODE) || defined (FAST_API_BOOT)
     FM_LOG_PRINT("####################################\n");
     FM_LOG_PRINT("# \n");
@@ -3231,234 +4576,166 @@ fm_status fm10000BootSwitch(fm_int sw)
 #endif
 
     /***************************************************
-     * Step 0a: Put the switch domain into reset.
-     *          We may be recovering from a bad state
-     *          so we must enforce reset state here
-     *          such that we have a clean start.
-     **************************************************/
-    err = ResetSwitch(sw);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 0b: We are in reset, let's setup the
-     *          FABRIC_PLL based on requested
-     *          frame handler clock.
+     * Run the boot sequence, see bootSteps: reset and
+     * release the switch, SBus and SerDes init (SPICO
+     * upload), per block init up to switch ready, then
+     * the per block initialization following the reset.
      **************************************************/
+    err = RunBootSequence(sw);
 
-    /* Retrieve the clock from platform config attribute */
-    fhClock = switchPtr->fhClock;
-
-    if ( ( (fhClock < 0) && (fhClock != -1)) ||
-         (fhClock > MAX_INT_VALUE) )
-    {
-        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
-                     "Switch %d frame handler clock is out of range: [-1, %d]\n",
-                     sw,
-                     MAX_INT_VALUE);
-
-        err = FM_ERR_INVALID_ARGUMENT;
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-    }
-
-    /* Configure the clock */
-    err = SetFHClockFreq(sw, fhClock);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 0c: Take EPLs out of reset 
-     * Step 0d: Take the switch out of reset.
-     **************************************************/
     FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
-                 "Taking switch fabric/EPL domain %d out of reset... \n", sw);
-
-    err = ReleaseSwitch(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 1a: Determine SerDes OpMode
-     *          This MUST be done before initializing
-     *          the SBus and SerDes
-     **************************************************/
-    err = fm10000SerdesInitOpMode(sw);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 1b: Initialize switch SBus (EPL ring only)
-     **************************************************/
-    err = fm10000SbusInit(sw, TRUE);
-    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 1c: Initialize switch SERDES
-     **************************************************/
-    err = fm10000InitSwSerdes(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    if (GET_PROPERTY()->isWhiteModel)
-    {
-        /* Must be done after ReleaseSwitch because the model starts changing
-         * SOFT_RESET during its init */
-        FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
-                     "Setting PCIeReset to ~PCIeEnable ... \n");
+                 "Switch %d boot time: %" FM_FORMAT_64 "u usec\n",
+                 sw,
+                 switchExt->bootTimeline.totalUsec);
 
-        /* Need to take PCIe devices out of warm reset */
-        err = switchPtr->ReadUINT32(sw, FM10000_DEVICE_CFG(), &rv);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
-        pcieEnable = FM_GET_UNNAMED_FIELD(rv,
-                                          FM10000_DEVICE_CFG_b_PCIeEnable_0,
-                                          FM10000_NUM_PEPS);
+}   /* end fm10000BootSwitch */
 
-        err = fm10000TakeSoftResetLock(sw);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-        err = switchPtr->ReadUINT32(sw, FM10000_SOFT_RESET(), &rv);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
 
-        /* PCIeReset and PCIeEnable are going to be the same value */
-        FM_SET_FIELD(rv, FM10000_SOFT_RESET, PCIeReset, ~pcieEnable);
 
-        err = switchPtr->WriteUINT32(sw, FM10000_SOFT_RESET(), rv);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+/*****************************************************************************/
+/** fm10000DbgDumpBootTimeline
+ * \ingroup intDiag
+ *
+ * \desc            Prints the timeline of the last boot of a switch: when
+ *                  each step started, how long it took and which thread ran
+ *                  it. The steps on the critical path, the chain of
+ *                  dependencies that determined the boot time, are flagged.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgDumpBootTimeline(fm_int sw)
+{
+    fm10000_switch *      switchExt;
+    fm10000_bootTimeline *timeline;
+    fm10000_bootStepTime *stepTime;
+    fm_uint32             criticalMask;
+    fm_uint64             serialUsec;
+    fm_uint64             endUsec;
+    fm_int                stepId;
+    fm_int                next;
+    fm_int                i;
+    fm_char               thread[16];
 
-        err = fm10000DropSoftResetLock(sw);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    switchExt = GET_SWITCH_EXT(sw);
+    timeline  = &switchExt->bootTimeline;
 
-        /* Configure the clock (because the Release Switch cleared
-         * register values) */
-        err = SetFHClockFreq(sw, fhClock);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    if (timeline->nrSteps == 0)
+    {
+        FM_LOG_PRINT("Switch %d has not been booted\n", sw);
+        return FM_OK;
     }
 
-    /***************************************************
-     * Step 2: Disable scan
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Disabling SCAN...\n");
-
-    rv = 0;
-    FM_SET_BIT(rv, FM10000_SCAN_DATA_IN, UpdateNodes, 1);
-    FM_SET_BIT(rv, FM10000_SCAN_DATA_IN, Passthru, 1);
-
-    err = switchPtr->WriteUINT32(sw, FM10000_SCAN_DATA_IN(), rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 3: Disable switch loopbacks
+    /**************************************************
+     * Walk the critical path back from the step that
+     * completed last, through whichever completed last
+     * of its dependencies and the step its thread ran
+     * before it.
      **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Disabling switch loopbacks...\n");
-
-    FM_FLAG_TAKE_REG_LOCK(sw);
+    criticalMask = 0;
+    stepId       = -1;
+    endUsec      = 0;
 
-    /* Disable loopback on EPLs */
-    for (i = 0 ; i < FM10000_NUM_EPLS ; i++)
+    for (i = 0 ; i < timeline->nrSteps ; i++)
     {
-        regAddr = FM10000_EPL_CFG_A(i);
-
-        err = switchPtr->ReadUINT32(sw, regAddr, &rv);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-        FM_SET_FIELD(rv, FM10000_EPL_CFG_A, Active, 1);
-
-        err = switchPtr->WriteUINT32(sw, regAddr, rv);
-        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        if (timeline->step[i].done && timeline->step[i].endUsec >= endUsec)
+        {
+            stepId  = i;
+            endUsec = timeline->step[i].endUsec;
+        }
     }
 
-    /* Do not disable loopback on TEs here - it will be done in the TE
-     * init function. */
-
-    FM_FLAG_DROP_REG_LOCK(sw);
-
-    /***************************************************
-     * Step 4a: Initialize CM
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing CM...\n");
-
-    err = fm10000InitializeCM(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 4b: TCN FIFO Interrupts
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing TCN FIFO Interrupts...\n");
-    err = switchPtr->WriteUINT32(sw, FM10000_MA_TCN_IM(), 0);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    rv = 0;
-    FM_SET_BIT(rv, FM10000_FH_TAIL_IM, TCN, 1);
-    err = switchPtr->MaskUINT32(sw, FM10000_FH_TAIL_IM(), rv, FALSE);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 5: Initialize the scheduler
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing the scheduler...\n");
-
-    err = fm10000InitScheduler(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    /***************************************************
-     * Step 6: Initialize LED Controller
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Initializing LED Controller...\n");
-
-    FM_FLAG_TAKE_REG_LOCK(sw);
-
-    err = switchPtr->ReadUINT32(sw, FM10000_LED_CFG(), &rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    FM_SET_BIT(rv, FM10000_LED_CFG, LEDEnable, 1);
-
-    err = switchPtr->WriteUINT32(sw, FM10000_LED_CFG(), rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    FM_FLAG_DROP_REG_LOCK(sw);
-
-    /***************************************************
-     * Step 7: Assert Switch Ready
-     **************************************************/
-    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH, "Marking switch as ready...\n");
-
-    FM_FLAG_TAKE_REG_LOCK(sw);
-
-    err = fm10000TakeSoftResetLock(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    err = switchPtr->ReadUINT32(sw, FM10000_SOFT_RESET(), &rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
-
-    FM_SET_BIT(rv, FM10000_SOFT_RESET, SwitchReady, 1);
-
-    err = switchPtr->WriteUINT32(sw, FM10000_SOFT_RESET(), rv);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    while (stepId >= 0)
+    {
+        criticalMask |= BOOT_STEP_BIT(stepId);
+        stepTime      = &timeline->step[stepId];
+        next          = -1;
+        endUsec       = 0;
 
-    err = fm10000DropSoftResetLock(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        for (i = 0 ; i < timeline->nrSteps ; i++)
+        {
+            if ( !timeline->step[i].done ||
+                 (criticalMask & BOOT_STEP_BIT(i)) ||
+                 (timeline->step[i].endUsec < endUsec) )
+            {
+                continue;
+            }
 
-    FM_FLAG_DROP_REG_LOCK(sw);
+            if ( (bootSteps[stepId].deps & BOOT_STEP_BIT(i)) ||
+                 ( (timeline->step[i].worker == stepTime->worker) &&
+                   (timeline->step[i].endUsec <= stepTime->startUsec) ) )
+            {
+                next    = i;
+                endUsec = timeline->step[i].endUsec;
+            }
+        }
 
-    /***************************************************
-     * Step 8: Proceed with initialization per block
-     **************************************************/
-    err = fm10000InitializeAfterReset(sw);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+        stepId = next;
+    }
 
-#if 0
-    fmGetTime(&t2);
+    FM_LOG_PRINT("\nBoot timeline for switch %d: %" FM_FORMAT_64 "u.%03u msec, "
+                 "%s%s\n\n",
+                 sw,
+                 timeline->totalUsec / 1000,
+                 (fm_uint) (timeline->totalUsec % 1000),
+                 fmErrorMsg(timeline->status),
+                 timeline->warmRestart ? " (warm restart)" : "");
+    FM_LOG_PRINT("%-30s %-10s %12s %12s %8s\n",
+                 "Step",
+                 "Thread",
+                 "Start(ms)",
+                 "Time(ms)",
+                 "Critical");
+
+    serialUsec = 0;
+
+    for (i = 0 ; i < timeline->nrSteps ; i++)
+    {
+        stepTime = &timeline->step[i];
 
-    fmSubTimestamps(&t2, &t1, &tDiff);
+        if (!stepTime->done)
+        {
+            FM_LOG_PRINT("%-30s %-10s\n",
+                         bootSteps[i].name,
+                         stepTime->skipped ? "skipped" : "not run");
+            continue;
+        }
 
-    FM_LOG_PRINT("fm10000BootSwitch:    %d.%d sec\n", (fm_uint)tDiff.sec, (fm_uint)tDiff.usec/1000);
-#endif
+        if (stepTime->worker == BOOT_WORKER_NONE)
+        {
+            FM_SPRINTF_S(thread, sizeof(thread), "boot");
+        }
+        else
+        {
+            FM_SPRINTF_S(thread, sizeof(thread), "worker %d", stepTime->worker);
+        }
 
-ABORT:
-    if (regLockTaken)
-    {
-        FM_FLAG_DROP_REG_LOCK(sw);
+        serialUsec += stepTime->endUsec - stepTime->startUsec;
+
+        FM_LOG_PRINT("%-30s %-10s %8" FM_FORMAT_64 "u.%03u "
+                     "%8" FM_FORMAT_64 "u.%03u %8s%s\n",
+                     bootSteps[i].name,
+                     thread,
+                     stepTime->startUsec / 1000,
+                     (fm_uint) (stepTime->startUsec % 1000),
+                     (stepTime->endUsec - stepTime->startUsec) / 1000,
+                     (fm_uint) ((stepTime->endUsec - stepTime->startUsec) % 1000),
+                     (criticalMask & BOOT_STEP_BIT(i)) ? "*" : "",
+                     (stepTime->status != FM_OK) ? " (failed)" : "");
     }
 
-    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+    FM_LOG_PRINT("\nSum of the step times: %" FM_FORMAT_64 "u.%03u msec\n",
+                 serialUsec / 1000,
+                 (fm_uint) (serialUsec % 1000));
 
-}   /* end fm10000BootSwitch */
+    return FM_OK;
+
+}   /* end fm10000DbgDumpBootTimeline */
 
 
 
@@ -4045,6 +5322,51 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000SaveWarmRestartImage
+ * \ingroup intSwitch
+ *
+ * \desc            Saves the register cache to the image file named by
+ *                  ''api.FM10000.warmRestartImage'', which the next boot
+ *                  restores on a warm restart, see ''CheckWarmRestart''.
+ *                  Called through the SaveWarmRestartImage function
+ *                  pointer with the switch write lock held.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if no image file is configured.
+ * \return          FM_FAIL if the image file could not be written.
+ *
+ *****************************************************************************/
+fm_status fm10000SaveWarmRestartImage(fm_int sw)
+{
+    const fm_char *imageName;
+    fm_status      err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    imageName = GET_FM10000_PROPERTY()->warmRestartImage;
+
+    if (imageName[0] == '\0')
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_UNSUPPORTED);
+    }
+
+    /* Threads that only take the register lock may still touch the cache */
+    TAKE_REG_LOCK(sw);
+
+    err = fmRegCacheSaveImage(sw, imageName);
+
+    DROP_REG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000SaveWarmRestartImage */
+
+
+
+
 /*****************************************************************************/
 /** fm10000InitPortTable
  * \ingroup intSwitch
@@ -4075,6 +5397,7 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
     fm_uint64           rv64;
     fm_char             serdesTimerName[16];
     fm_char             serdesDfeTimerName[16];
+    fm_char             serdesDfeLockName[16];
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH,
                  "switchPtr=%p\n",
@@ -4221,7 +5544,24 @@ fm_status fm10000InitPortTable(fm_switch *switchPtr)
             FM_LOG_EXIT( FM_LOG_CAT_PORT, err );
         }
 
+        /* create the lock serializing the DFE state machine events */
+        FM_SPRINTF_S(serdesDfeLockName,
+                     sizeof(serdesDfeLockName),
+                     "SerDesDfe%02dLock",
+                     cnt );
+
+        err = fmCreateLockV2(serdesDfeLockName,
+                             sw,
+                             FM_LOCK_PREC_SERDES_DFE,
+                             &laneDfePtr->lock);
+        if ( err != FM_OK )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_PORT,
+                         "Unable to create the DFE lock for serdes %d\n",
+                         cnt );
 
+            FM_LOG_EXIT( FM_LOG_CAT_PORT, err );
+        }
 
         /* Create the timer(s) associated to the dfe state machine */
         FM_SPRINTF_S(serdesDfeTimerName,
@@ -1404,6 +1404,10 @@ fm_status fm10000FreeLaneResources( fm_int sw )
                 fmDeleteTimer( laneExt->timerHandleErrorValidation );
                 fmDeleteStateMachine( laneDfePtr->smHandle );
                 fmDeleteTimer( laneDfePtr->timerHandle );
+                if ( laneDfePtr->lock.handle != NULL )
+                {
+                    fmDeleteLock( &laneDfePtr->lock );
+                }
 
                 /* Free lane table. */
                 if ( switchPtr->laneTable[lane]->extension )
@@ -70,11 +70,17 @@
  *
  * \param[in]       sw is the switch on which to operate.
  *
+ * \param[in]       indexed is TRUE if the purge examined only the entries
+ *                  on the MA Table index lists.
+ *
+ * \param[in]       numExamined is the number of MA Table entries the purge
+ *                  examined.
+ *
  * \return          FM_OK if successful.
  * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
  *
  *****************************************************************************/
-static fm_status FinishPurge(fm_int sw)
+static fm_status FinishPurge(fm_int sw, fm_bool indexed, fm_int numExamined)
 {
     fm_switch *     switchPtr;
     fm_maPurge *    purgePtr;
@@ -84,7 +90,11 @@ static fm_status FinishPurge(fm_int sw)
     fm_bool         swagLagLockTaken;
 #endif
 
-    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_MAC_MAINT, "sw=%d\n", sw);
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_MAC_MAINT,
+                 "sw=%d indexed=%d numExamined=%d\n",
+                 sw,
+                 indexed,
+                 numExamined);
 
     switchPtr = GET_SWITCH_PTR(sw);
     purgePtr  = &switchPtr->maPurge;
@@ -113,6 +123,12 @@ static fm_status FinishPurge(fm_int sw)
     FM_TAKE_MA_PURGE_LOCK(sw);
     
     ++purgePtr->stats.numCompletedOther;
+    purgePtr->stats.numEntriesExamined += (fm_uint64) numExamined;
+
+    if (indexed)
+    {
+        ++purgePtr->stats.numCompletedIndexed;
+    }
     
     /* Process any callbacks satisfied by the last purge. */
     fmProcessPurgeCallbacks(sw);
@@ -305,6 +321,152 @@ static fm_bool MeetsPurgeCriteria(fm_int                   sw,
 
 
 
+/*****************************************************************************/
+/** GetPurgeCandidates
+ * \ingroup intMacMaint
+ *
+ * \desc            Collects the MA Table entries that may meet the criteria
+ *                  for the current purge request, using the MA Table port,
+ *                  VLAN and expired entry lists. A purge of all ports and
+ *                  VLANs has no useful list, and must scan the whole table.
+ *
+ * \note            The caller is assumed to have taken the L2 lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      candidates points to caller-allocated storage where
+ *                  this function should place a pointer to an array of
+ *                  MA Table indexes, or NULL if the whole table must be
+ *                  scanned. The caller must free the array with fmFree.
+ *
+ * \param[out]      numCandidates points to caller-allocated storage where
+ *                  this function should place the number of entries to
+ *                  examine.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status GetPurgeCandidates(fm_int   sw,
+                                    fm_int **candidates,
+                                    fm_int * numCandidates)
+{
+    fm_switch *         switchPtr;
+    fm_maPurgeRequest * request;
+    fm_maTableIndex *   maIndex;
+    fm_maTableIndexType type;
+    fm_int              key;
+    fm_int              maxCandidates;
+    fm_int              count;
+    fm_int              entryIndex;
+    fm_int *            indexes;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    request   = &switchPtr->maPurge.request;
+    maIndex   = &switchPtr->maTableIndex;
+
+    *candidates    = NULL;
+    *numCandidates = switchPtr->macTableSize;
+
+    if (maIndex->nodes == NULL)
+    {
+        return FM_OK;
+    }
+
+    /***************************************************
+     * Choose the shortest list that holds every entry
+     * the request can match. Expired entries are purged
+     * by every request, so the expired list is always
+     * examined as well.
+     **************************************************/
+
+    if (request->expired)
+    {
+        type = FM_MA_INDEX_EXPIRED;
+        key  = 0;
+    }
+    else if (request->port >= 0 &&
+             ( request->vid1 < 0 ||
+               fmGetAddrTableIndexCount(maIndex,
+                                        FM_MA_INDEX_PORT,
+                                        request->port) <=
+               fmGetAddrTableIndexCount(maIndex,
+                                        FM_MA_INDEX_VLAN,
+                                        request->vid1) ) )
+    {
+        type = FM_MA_INDEX_PORT;
+        key  = request->port;
+    }
+    else if (request->vid1 >= 0)
+    {
+        type = FM_MA_INDEX_VLAN;
+        key  = request->vid1;
+    }
+    else
+    {
+        /* Matches all dynamic entries. */
+        return FM_OK;
+    }
+
+    maxCandidates = fmGetAddrTableIndexCount(maIndex, FM_MA_INDEX_EXPIRED, 0);
+
+    if (type != FM_MA_INDEX_EXPIRED)
+    {
+        maxCandidates += fmGetAddrTableIndexCount(maIndex, type, key);
+    }
+
+    *numCandidates = 0;
+
+    if (maxCandidates == 0)
+    {
+        return FM_OK;
+    }
+
+    indexes = fmAlloc( maxCandidates * sizeof(fm_int) );
+    if (indexes == NULL)
+    {
+        *numCandidates = switchPtr->macTableSize;
+        return FM_ERR_NO_MEM;
+    }
+
+    count = 0;
+
+    for (entryIndex = fmGetAddrTableIndexFirst(maIndex, FM_MA_INDEX_EXPIRED, 0) ;
+         entryIndex >= 0 && count < maxCandidates ;
+         entryIndex = fmGetAddrTableIndexNext(maIndex,
+                                              FM_MA_INDEX_EXPIRED,
+                                              entryIndex) )
+    {
+        indexes[count++] = entryIndex;
+    }
+
+    if (type != FM_MA_INDEX_EXPIRED)
+    {
+        for (entryIndex = fmGetAddrTableIndexFirst(maIndex, type, key) ;
+             entryIndex >= 0 && count < maxCandidates ;
+             entryIndex = fmGetAddrTableIndexNext(maIndex, type, entryIndex) )
+        {
+            /* Already collected from the expired list. */
+            if (switchPtr->maTable[entryIndex].state ==
+                FM_MAC_ENTRY_STATE_EXPIRED)
+            {
+                continue;
+            }
+
+            indexes[count++] = entryIndex;
+        }
+    }
+
+    *candidates    = indexes;
+    *numCandidates = count;
+
+    return FM_OK;
+
+}   /* end GetPurgeCandidates */
+
+
+
+
 /*****************************************************************************/
 /** PerformPurge
  * \ingroup intMacMaint
@@ -324,6 +486,10 @@ static fm_status PerformPurge(fm_int sw)
     fm_event *      eventPtr;
     fm_uint32       numUpdates;
     fm_int          entryIndex;
+    fm_int *        candidates;
+    fm_int          numCandidates;
+    fm_bool         indexed;
+    fm_int          i;
     fm_status       err;
 
     fm_internalMacAddrEntry *   cachePtr;
@@ -357,12 +523,29 @@ static fm_status PerformPurge(fm_int sw)
     }
 
     /***************************************************
-     * Iterate over MAC table cache.
+     * Find the entries that may need to be purged.
+     **************************************************/
+
+    FM_TAKE_L2_LOCK(sw);
+    l2Locked = TRUE;
+
+    err = GetPurgeCandidates(sw, &candidates, &numCandidates);
+    if (err != FM_OK)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_MAC_MAINT,
+                     "Unable to collect purge candidates, scanning "
+                     "MA table: %s\n",
+                     fmErrorMsg(err));
+    }
+
+    indexed = (candidates != NULL || numCandidates == 0);
+
+    /***************************************************
+     * Iterate over the candidates, or the entire MAC
+     * table cache if there are no candidate lists.
      **************************************************/
 
-    for ( entryIndex = 0 ;
-          entryIndex < switchPtr->macTableSize ;
-          ++entryIndex )
+    for ( i = 0 ; i < numCandidates ; ++i )
     {
         if (!l2Locked)
         {
@@ -371,7 +554,8 @@ static fm_status PerformPurge(fm_int sw)
             numSkipped = 0;
         }
 
-        cachePtr = &switchPtr->maTable[entryIndex];
+        entryIndex = (candidates != NULL) ? candidates[i] : i;
+        cachePtr   = &switchPtr->maTable[entryIndex];
 
         /***************************************************
          * Determine whether to purge this entry.
@@ -434,13 +618,18 @@ static fm_status PerformPurge(fm_int sw)
 
         fmDbgDiagCountIncr(sw, FM_CTR_MAC_PURGE_AGED, 1);
 
-    }   /* end for ( entryIndex = 0 ; ... ) */
+    }   /* end for ( i = 0 ; i < numCandidates ; ++i ) */
 
     if (l2Locked)
     {
         FM_DROP_L2_LOCK(sw);
     }
 
+    if (candidates != NULL)
+    {
+        fmFree(candidates);
+    }
+
     if (numUpdates != 0)
     {
         fmSendMacUpdateEvent(sw,
@@ -455,7 +644,7 @@ static fm_status PerformPurge(fm_int sw)
         fmReleaseEvent(eventPtr);
     }
 
-    err = FinishPurge(sw);
+    err = FinishPurge(sw, indexed, numCandidates);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_MAC_MAINT, err);
 
@@ -544,3 +733,64 @@ ABORT:
 
 }   /* end fm10000HandlePurgeRequest */
 
+
+
+
+/*****************************************************************************/
+/** fm10000DumpPurgeStats
+ * \ingroup intMacMaint
+ *
+ * \desc            Displays the MA Table purge and aging diagnostic
+ *                  statistics. Called through the DumpPurgeStats function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DumpPurgeStats(fm_int sw)
+{
+    fm_status err;
+
+    err = fmCommonDumpPurgeStats(sw);
+
+    if (err == FM_OK)
+    {
+        fm10000DumpUsedTableSweepStats(sw);
+    }
+
+    return err;
+
+}   /* end fm10000DumpPurgeStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetPurgeStats
+ * \ingroup intMacMaint
+ *
+ * \desc            Resets the MA Table purge and aging diagnostic
+ *                  statistics. Called through the ResetPurgeStats function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000ResetPurgeStats(fm_int sw)
+{
+    fm_status err;
+
+    err = fmCommonResetPurgeStats(sw);
+
+    if (err == FM_OK)
+    {
+        fm10000ResetUsedTableSweepStats(sw);
+    }
+
+    return err;
+
+}   /* end fm10000ResetPurgeStats */
@@ -894,6 +894,8 @@ static fm_status UpdateMacEntry(fm_int                    sw,
 
     }   /* end switch (entry->addrType) */
 
+    fmMarkAddrTableEntry(sw, index);
+
     /* Write updated MA Table entry. */
     status = fm10000WriteEntryAtIndex(sw, index, entry);
 
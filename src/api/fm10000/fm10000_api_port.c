@@ -17251,16 +17251,25 @@ fm_status fm10000ConfigureEthMode( fm_int      sw,
                                      "to SerDes %d's DFE-State Machine\n",
                                      FM10000_BASIC_SERDES_DFE_STATE_MACHINE,
                                      laneExt[i]->serDes );
+                    /* DFE timeouts are handled under the DFE lock alone */
+                    fmCaptureLock(&laneExt[i]->dfeExt.lock, FM_WAIT_FOREVER);
+
                     laneExt[i]->dfeExt.smType = FM_SMTYPE_UNSPECIFIED;
+                    laneExt[i]->dfeExt.numPendingInd = 0;
 
                     err = fmStartStateMachine(laneExt[i]->dfeExt.smHandle,
                                               FM10000_BASIC_SERDES_DFE_STATE_MACHINE,
                                               FM10000_SERDES_DFE_STATE_START);
 
-                    FM_LOG_ABORT_ON_ERR_V2( FM_LOG_CAT_PORT, port, err );
+                    if (err == FM_OK)
+                    {
+                        /* finally restart it and reconfigure it */
+                        laneExt[i]->dfeExt.smType   = FM10000_BASIC_SERDES_DFE_STATE_MACHINE;
+                    }
+
+                    fmReleaseLock(&laneExt[i]->dfeExt.lock);
 
-                    /* finally restart it and reconfigure it */
-                    laneExt[i]->dfeExt.smType   = FM10000_BASIC_SERDES_DFE_STATE_MACHINE;
+                    FM_LOG_ABORT_ON_ERR_V2( FM_LOG_CAT_PORT, port, err );
                 }
             }
         }
@@ -570,7 +570,8 @@ const fm_cachedRegs fm10000CachePolicerState4k =
     TRUE,
     { FM10000_POLICER_STATE_4K(0, 1, 0) - FM10000_POLICER_STATE_4K(0, 0, 0),
       FM10000_POLICER_STATE_4K(1, 0, 0) - FM10000_POLICER_STATE_4K(0, 0, 0) },
-    { FM10000_POLICER_STATE_4K_ENTRIES_0, FM10000_POLICER_STATE_4K_ENTRIES_1 }
+    { FM10000_POLICER_STATE_4K_ENTRIES_0, FM10000_POLICER_STATE_4K_ENTRIES_1 },
+    TRUE
 };
 
 /* POLICER_STATE_512 register set descriptor */
@@ -585,7 +586,8 @@ const fm_cachedRegs fm10000CachePolicerState512 =
     TRUE,
     { FM10000_POLICER_STATE_512(0, 1, 0) - FM10000_POLICER_STATE_512(0, 0, 0),
       FM10000_POLICER_STATE_512(1, 0, 0) - FM10000_POLICER_STATE_512(0, 0, 0) },
-    { FM10000_POLICER_STATE_512_ENTRIES_0, FM10000_POLICER_STATE_512_ENTRIES_1 }
+    { FM10000_POLICER_STATE_512_ENTRIES_0, FM10000_POLICER_STATE_512_ENTRIES_1 },
+    TRUE
 };
 
 /* POLICER_CFG register set descriptor */
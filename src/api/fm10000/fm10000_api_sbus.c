@@ -78,6 +78,39 @@ typedef struct
 
 } fm10000_sbusReq;
 
+/* SBus registers of a ring. SBUS_EPL_XXX and SBUS_PCIE_XXX have the same
+ * field format, so SBUS_EPL_XXX is used for both */
+#define SBUS_COMMAND_REG(ring)                                             \
+    ( (ring) == FM10000_SBUS_RING_EPL ? FM10000_SBUS_EPL_COMMAND()  :      \
+                                        FM10000_SBUS_PCIE_COMMAND() )
+#define SBUS_REQUEST_REG(ring)                                             \
+    ( (ring) == FM10000_SBUS_RING_EPL ? FM10000_SBUS_EPL_REQUEST()  :      \
+                                        FM10000_SBUS_PCIE_REQUEST() )
+#define SBUS_RESPONSE_REG(ring)                                            \
+    ( (ring) == FM10000_SBUS_RING_EPL ? FM10000_SBUS_EPL_RESPONSE() :      \
+                                        FM10000_SBUS_PCIE_RESPONSE() )
+
+#define SBUS_RING_NAME(ring) \
+    ( (ring) == FM10000_SBUS_RING_EPL ? "EPL" : "PCIe" )
+
+#define SBUS_CMD_RING(cmd) \
+    ( (cmd)->eplRing ? FM10000_SBUS_RING_EPL : FM10000_SBUS_RING_PCIE )
+
+/* State of a ring during the execution of a batch of SBus commands */
+typedef struct
+{
+    fm_int           nrQueued;       /* Number of commands of the ring */
+    fm_int           next;           /* Index of the next command to issue */
+    fm10000_sbusCmd *current;        /* Command in progress, NULL if idle */
+    fm_int           opCode;         /* Operation in progress */
+    fm_uint32        writeData;      /* Data of a write in progress */
+    fm_timestamp     issueTime;      /* Time the command was issued */
+    fm_uint          waitLoopCnt;    /* Number of waits for the operation */
+    fm_uint          totalDelayNsec; /* Time waited for the operation */
+    fm_status        err;            /* First error met on the ring */
+
+} fm10000_sbusRun;
+
 
 
 /*****************************************************************************
@@ -98,6 +131,35 @@ static fm_status SBusRequest(fm_int           sw,
                              fm_bool          eplRing,
                              fm10000_sbusReq *pSbusReq);
 
+static fm_status IssueSbusCommand(fm_int    sw,
+                                  fm_int    ring,
+                                  fm_int    opCode,
+                                  fm_uint32 devAddr,
+                                  fm_uint32 regAddr,
+                                  fm_uint32 data);
+
+static fm_status PollSbusCommand(fm_int     sw,
+                                 fm_int     ring,
+                                 fm_int     opCode,
+                                 fm_bool   *done,
+                                 fm_uint32 *pData);
+
+static void CompleteSbusCommand(fm_int            sw,
+                                fm_int            ring,
+                                fm10000_sbusRun  *state,
+                                fm10000_sbusCmd  *cmd,
+                                fm_status         status);
+
+static fm_status StartSbusCommand(fm_int           sw,
+                                  fm_int           ring,
+                                  fm10000_sbusRun *state,
+                                  fm10000_sbusCmd *cmd);
+
+static fm_int NextSbusCommand(fm10000_sbusCmd *cmds,
+                              fm_int           nrCmds,
+                              fm_int           ring,
+                              fm_int           first);
+
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
@@ -365,214 +427,481 @@ static fm_status DropPcieSbusLock(fm_int sw)
 
 
 /*****************************************************************************/
-/** SBusRequest
+/** IssueSbusCommand
  * \ingroup intSBus
  *
- * \desc            Executes the specified SBus transaction. The kind of
- *                  transaction is specified by the opCode field of the
- *                  ''fm10000_sbusReq'' structure pointed by pSbusReq and it may
- *                  be write, read or reset. This function blocks until the
- *                  transaction is completed or an error has happend.
- *                  Note that execution of a single SBus request could take up
- *                  to 15us.
+ * \desc            Starts the execution of an SBus operation on a ring. The
+ *                  operation runs in the background, its completion is
+ *                  detected with ''PollSbusCommand''.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       eplRing is TRUE if the destination ring is EPL or FALSE
- *                  if it is the PCIE ring.
+ * \param[in]       ring is the ring, see FM10000_SBUS_RING_xxx.
  *
- * \param[in,out]   pSbusReq points to the SBus request to execute.
+ * \param[in]       opCode is the SBus operation code.
+ *
+ * \param[in]       devAddr is the SBus device address.
+ *
+ * \param[in]       regAddr is the SBus register address.
+ *
+ * \param[in]       data is the data of a write or reset operation.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_ARGUMENT if pSbusReq is a NULL pointer.
+ * \return          FM_FAIL if the ring is busy.
  * \return          Other ''Status Codes'' as appropriate in case of failure.
  *
  *****************************************************************************/
-fm_status SBusRequest(fm_int           sw,
-                      fm_bool          eplRing,
-                      fm10000_sbusReq *pSbusReq)
+static fm_status IssueSbusCommand(fm_int    sw,
+                                  fm_int    ring,
+                                  fm_int    opCode,
+                                  fm_uint32 devAddr,
+                                  fm_uint32 regAddr,
+                                  fm_uint32 data)
 {
-    fm_status       err;
-    fm_switch *     switchPtr;
-    fm_uint         sbusReqRegAddr;
-    fm_uint         sbusCmdRegAddr;
-    fm_uint         sbusRespRegAddr;
-    fm_uint         waitLoopCnt;
-    fm_uint32       regValue;
-    fm_uint32       resultCode;
-    fm_uint         delayNsec;
-    fm_uint         totalDelayNsec;
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_uint32  regValue;
 
+    switchPtr = GET_SWITCH_PTR(sw);
 
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
-                         "sw=%d, eplRing=%d, pSbusReq=%p\n",
-                         sw,
-                         eplRing,
-                         (void *) pSbusReq);
+    /* verify that the SBUS is ready for a new command */
+    err = switchPtr->ReadUINT32(sw, SBUS_COMMAND_REG(ring), &regValue);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    if (FM_GET_BIT(regValue, FM10000_SBUS_EPL_COMMAND, Busy))
+    {
+        if (fm10000VerifySwitchAliveStatus(sw) == FM_OK)
+        {
+            /* No need to display this message if switch is dead 
+             * fm10000VerifySwitchAliveStatus will display one already */
+            FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                         "SBUS is busy, ring=%s \n",
+                         SBUS_RING_NAME(ring));
+        }
+        return FM_FAIL;
+    }
+
+    if (opCode == FM10000_SBUS_OP_WRITE || opCode == FM10000_SBUS_OP_RESET)
+    {
+        /* Load the data for the SBus request that is to be executed. */
+        err = switchPtr->WriteUINT32(sw, SBUS_REQUEST_REG(ring), data);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    /* Clear the SBUS_COMMAND register for new SBus request to be executed. */
+    regValue = 0;
+    err = switchPtr->WriteUINT32(sw, SBUS_COMMAND_REG(ring), regValue);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    /* Start execution of a new SBus request. */
+    FM_SET_FIELD(regValue, FM10000_SBUS_EPL_COMMAND, Register, regAddr);
+    FM_SET_FIELD(regValue, FM10000_SBUS_EPL_COMMAND, Address, devAddr);
+    FM_SET_FIELD(regValue, FM10000_SBUS_EPL_COMMAND, Op, opCode);
+    FM_SET_BIT  (regValue, FM10000_SBUS_EPL_COMMAND, Execute, TRUE);
+
+    return switchPtr->WriteUINT32(sw, SBUS_COMMAND_REG(ring), regValue);
+
+}   /* end IssueSbusCommand */
+
+
+
+
+/*****************************************************************************/
+/** PollSbusCommand
+ * \ingroup intSBus
+ *
+ * \desc            Checks whether the SBus operation started on a ring by
+ *                  ''IssueSbusCommand'' has completed, and if so checks its
+ *                  result code and retrieves the data of a read.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       ring is the ring, see FM10000_SBUS_RING_xxx.
+ *
+ * \param[in]       opCode is the SBus operation code in progress.
+ *
+ * \param[out]      done points to caller-allocated storage where this
+ *                  function sets TRUE if the operation has completed.
+ *
+ * \param[out]      pData points to caller-allocated storage where this
+ *                  function places the data of a completed read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the result code is not the expected one.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status PollSbusCommand(fm_int     sw,
+                                 fm_int     ring,
+                                 fm_int     opCode,
+                                 fm_bool   *done,
+                                 fm_uint32 *pData)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+    fm_uint32  regValue;
+    fm_uint32  resultCode;
+    fm_uint32  expected;
 
     switchPtr = GET_SWITCH_PTR(sw);
-    err = FM_OK;
+    *done     = FALSE;
 
-    if (pSbusReq == NULL)
+    /* check the busy flag */
+    err = switchPtr->ReadUINT32(sw, SBUS_COMMAND_REG(ring), &regValue);
+    if (err != FM_OK ||
+        FM_GET_BIT(regValue, FM10000_SBUS_EPL_COMMAND, Busy))
     {
-        err = FM_ERR_INVALID_ARGUMENT;
+        return err;
     }
-    else
+
+    *done = TRUE;
+
+    /* Retrieve the SBus result code */
+    switch (opCode)
     {
-        /* Need to create a specific LOCK of very low priority for the SBUS access */
-        TAKE_REG_LOCK(sw);
+        case FM10000_SBUS_OP_READ:
+            expected = FM10000_SBUS_RESULT_READ;
+            break;
+
+        case FM10000_SBUS_OP_WRITE:
+            expected = FM10000_SBUS_RESULT_WRITE;
+            break;
+
+        default:
+            expected = FM10000_SBUS_RESULT_RESET;
+            break;
+    }
+
+    resultCode = FM_GET_FIELD(regValue, FM10000_SBUS_EPL_COMMAND, ResultCode);
 
-        if (!eplRing)
+    if (resultCode != expected)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_SWITCH, 
+                     "SBUS Invalid result code %x. Expected 0x%x. "
+                     "Addr 0x%x Reg 0x%x.\n", 
+                     resultCode,
+                     expected,
+                     SBUS_COMMAND_REG(ring),
+                     regValue);
+        return FM_FAIL;
+    }
+
+    if (opCode == FM10000_SBUS_OP_READ)
+    {
+        /* a read command was executed, get the  SBus response. */
+        err = switchPtr->ReadUINT32(sw, SBUS_RESPONSE_REG(ring), &regValue);
+
+        if (err == FM_OK)
         {
-            err = TakePcieSbusLock(sw);
-            FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+            *pData = FM_GET_FIELD(regValue, FM10000_SBUS_EPL_RESPONSE, Data);
         }
+    }
 
-        /* SBUS_EPL_XXX and SBUS_PCIE_XXX have the same field format, so SBUS_EPL_XXX
-         * will be used for both */
-        if (eplRing)
+    return err;
+
+}   /* end PollSbusCommand */
+
+
+
+
+/*****************************************************************************/
+/** CompleteSbusCommand
+ * \ingroup intSBus
+ *
+ * \desc            Completes a command of a batch: records its status and
+ *                  latency in the ring statistics and calls its completion
+ *                  callback. A failed command also fails the commands queued
+ *                  behind it on the same ring.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       ring is the ring, see FM10000_SBUS_RING_xxx.
+ *
+ * \param[in,out]   state points to the batch state of the ring.
+ *
+ * \param[in,out]   cmd points to the command to complete.
+ *
+ * \param[in]       status is the completion status of the command.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void CompleteSbusCommand(fm_int            sw,
+                                fm_int            ring,
+                                fm10000_sbusRun  *state,
+                                fm10000_sbusCmd  *cmd,
+                                fm_status         status)
+{
+    fm10000_switch    *switchExt;
+    fm10000_sbusStats *stats;
+    fm_timestamp       now;
+    fm_timestamp       diff;
+    fm_uint64          latency;
+
+    switchExt = GET_SWITCH_EXT(sw);
+    stats     = &switchExt->sbusStats[ring];
+
+    cmd->status = status;
+
+    if (status == FM_OK)
+    {
+        fmGetTime(&now);
+        fmSubTimestamps(&now, &state->issueTime, &diff);
+        latency = diff.sec * 1000000 + diff.usec;
+
+        stats->nrCommands++;
+        stats->totalLatency += latency;
+        if (latency > stats->maxLatency)
         {
-            sbusReqRegAddr  = FM10000_SBUS_EPL_REQUEST();
-            sbusCmdRegAddr  = FM10000_SBUS_EPL_COMMAND();
-            sbusRespRegAddr = FM10000_SBUS_EPL_RESPONSE();
+            stats->maxLatency = latency;
         }
-        else
+
+        if (sbusDebug)
         {
-            sbusReqRegAddr  = FM10000_SBUS_PCIE_REQUEST();
-            sbusCmdRegAddr  = FM10000_SBUS_PCIE_COMMAND();
-            sbusRespRegAddr = FM10000_SBUS_PCIE_RESPONSE();
+            if (cmd->type == FM10000_SBUS_CMD_READ ||
+                cmd->type == FM10000_SBUS_CMD_RMW)
+            {
+                FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x => 0x%8.8x  t=%4.4d.%3.3d\n",
+                             sw,
+                             cmd->eplRing,
+                             cmd->sbusAddr,
+                             cmd->sbusReg,
+                             cmd->result,
+                             (fm_int)(state->issueTime.sec%10000),
+                             (fm_int)(state->issueTime.usec/1000));
+            }
+
+            if (cmd->type != FM10000_SBUS_CMD_READ)
+            {
+                FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x <= 0x%8.8x  t=%4.4d.%3.3d\n",
+                             sw,
+                             cmd->eplRing,
+                             cmd->sbusAddr,
+                             cmd->sbusReg,
+                             state->writeData,
+                             (fm_int)(state->issueTime.sec%10000),
+                             (fm_int)(state->issueTime.usec/1000));
+            }
         }
+    }
+    else
+    {
+        stats->nrErrors++;
 
-        /* verify that the SBUS is ready for a new command */
-        err = switchPtr->ReadUINT32(sw, sbusCmdRegAddr, &regValue);
+        if (state->err == FM_OK)
+        {
+            state->err = status;
+        }
+    }
 
-        if (err == FM_OK)
+    if (cmd->callback != NULL)
+    {
+        cmd->callback(sw, cmd);
+    }
+
+}   /* end CompleteSbusCommand */
+
+
+
+
+/*****************************************************************************/
+/** StartSbusCommand
+ * \ingroup intSBus
+ *
+ * \desc            Issues the next operation of a command of a batch: the
+ *                  command itself, or the write of a read-modify-write
+ *                  command whose read has completed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       ring is the ring, see FM10000_SBUS_RING_xxx.
+ *
+ * \param[in,out]   state points to the batch state of the ring.
+ *
+ * \param[in,out]   cmd points to the command to start.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status StartSbusCommand(fm_int           sw,
+                                  fm_int           ring,
+                                  fm10000_sbusRun *state,
+                                  fm10000_sbusCmd *cmd)
+{
+    fm_status err;
+
+    if (state->current != cmd)
+    {
+        /* first operation of the command */
+        state->current = cmd;
+        fmGetTime(&state->issueTime);
+
+        switch (cmd->type)
         {
-            if (!FM_GET_BIT(regValue, FM10000_SBUS_EPL_COMMAND, Busy))
-            {
-                if (pSbusReq->opCode == FM10000_SBUS_OP_WRITE ||
-                    pSbusReq->opCode == FM10000_SBUS_OP_RESET)
-                {
-                    /* Load the data for the SBus request that is to be executed. */
-                    err = switchPtr->WriteUINT32(sw, sbusReqRegAddr, pSbusReq->data);
-                }
+            case FM10000_SBUS_CMD_READ:
+            case FM10000_SBUS_CMD_RMW:
+                state->opCode    = FM10000_SBUS_OP_READ;
+                state->writeData = 0;
+                break;
 
-                /* configure the SBUS command */
-                if (err == FM_OK)
-                {
-                    regValue = 0;
+            case FM10000_SBUS_CMD_WRITE:
+                state->opCode    = FM10000_SBUS_OP_WRITE;
+                state->writeData = cmd->data;
+                break;
 
-                    /* Clear the SBUS_COMMAND register for new SBus request to be executed. */
-                    err = switchPtr->WriteUINT32(sw, sbusCmdRegAddr, regValue);
-                }
+            case FM10000_SBUS_CMD_RESET:
+                state->opCode    = FM10000_SBUS_OP_RESET;
+                state->writeData = cmd->data;
+                break;
 
-                if (err == FM_OK)
-                {
-                    /* Start execution of a new SBus request. */
-                    FM_SET_FIELD(regValue,
-                                 FM10000_SBUS_EPL_COMMAND,
-                                 Register,
-                                 pSbusReq->regAddr);
-                    FM_SET_FIELD(regValue,
-                                 FM10000_SBUS_EPL_COMMAND,
-                                 Address,
-                                 pSbusReq->devAddr);
-                    FM_SET_FIELD(regValue,
-                                 FM10000_SBUS_EPL_COMMAND,
-                                 Op,
-                                 pSbusReq->opCode);
-                    FM_SET_BIT  (regValue,
-                                 FM10000_SBUS_EPL_COMMAND,
-                                 Execute,
-                                 TRUE);
-    
-                    err = switchPtr->WriteUINT32(sw, sbusCmdRegAddr, regValue);
-                }
+            default:
+                return FM_ERR_INVALID_ARGUMENT;
+        }
+    }
+    else
+    {
+        /* write back the modified value of a read-modify-write */
+        state->opCode    = FM10000_SBUS_OP_WRITE;
+        state->writeData = (cmd->data & cmd->mask) | (cmd->result & ~cmd->mask);
+    }
 
-                /* Wait until the SBus request has been executed. */
+    state->waitLoopCnt    = 0;
+    state->totalDelayNsec = 0;
 
-                /* timeout = SBUS_WAIT_LOOP_INITIAL_DELAY_NS * SBUS_MAX_WAIT_LOOPS * (SBUS_MAX_WAIT_LOOPS/2) */
+    err = IssueSbusCommand(sw,
+                           ring,
+                           state->opCode,
+                           cmd->sbusAddr & 0xFFU,
+                           cmd->sbusReg & 0xFFU,
+                           state->writeData);
 
-                waitLoopCnt = 1;
-                totalDelayNsec = 0;
-                do
-                {
-                    /* check the busy flag */
-                    err = switchPtr->ReadUINT32(sw, sbusCmdRegAddr, &regValue);
+    return err;
 
-                    if (err == FM_OK && FM_GET_BIT(regValue, FM10000_SBUS_EPL_COMMAND, Busy) == FALSE)
-                    {
-                        break;
-                    }
+}   /* end StartSbusCommand */
 
-                    if (++waitLoopCnt >= SBUS_MAX_WAIT_LOOPS)
-                    {
-                        err = FM_FAIL;
-                        FM_LOG_FATAL(FM_LOG_CAT_SWITCH, 
-                                     "SBUS Command (dev=0x%x, reg=0x%x) timed out in %d ms\n", 
-                                     pSbusReq->devAddr,
-                                     pSbusReq->regAddr,
-                                     totalDelayNsec );
-                    }
-                    else
-                    {
-                        delayNsec = SBUS_WAIT_LOOP_INITIAL_DELAY_NS * waitLoopCnt;
-                        /* the delay is proportional to the number of wait loops */
-                        fmDelay(0, delayNsec);  
-                        totalDelayNsec += delayNsec;                    
-                    }
-                }
-                while (err == FM_OK);
 
 
-                if (err == FM_OK)
-                {
-                    /* Retrieve the SBus result code */
-                    resultCode = FM_GET_FIELD(regValue, FM10000_SBUS_EPL_COMMAND, ResultCode);
-    
-                    if (resultCode != pSbusReq->resultCode)
-                    {
-                        err = FM_FAIL;
-                        FM_LOG_FATAL(FM_LOG_CAT_SWITCH, 
-                                     "SBUS Invalid result code %x. Expected 0x%x. Addr 0x%x Reg 0x%x.\n", 
-                                     resultCode,
-                                     pSbusReq->resultCode,
-                                     sbusCmdRegAddr,
-                                     regValue);
-                    }
-                    else if (pSbusReq->opCode == FM10000_SBUS_OP_READ)
-                    {
-                        /* a read command was executed, get the  SBus response. */
-                        sbusRespRegAddr = eplRing ? FM10000_SBUS_EPL_RESPONSE() : FM10000_SBUS_PCIE_RESPONSE();
-    
-                        err = switchPtr->ReadUINT32(sw, sbusRespRegAddr, &regValue);
-    
-                        if (err == FM_OK)
-                        {
-                            pSbusReq->data = FM_GET_FIELD(regValue, FM10000_SBUS_EPL_RESPONSE, Data);
-                        }
-                    }
-                }
-            }   /* end if (!regValueFM_GET_BIT( ...) ) */
-            else
-            {
-                err = FM_FAIL;
-                if (fm10000VerifySwitchAliveStatus(sw) == FM_OK)
-                {
-                    /* No need to display this message if switch is dead 
-                     * fm10000VerifySwitchAliveStatus will display one already */
-                    FM_LOG_ERROR(FM_LOG_CAT_SWITCH, "SBUS is busy, ring=%s \n", eplRing ? "EPL" : "PCIe");
-                }
-            }
+
+/*****************************************************************************/
+/** NextSbusCommand
+ * \ingroup intSBus
+ *
+ * \desc            Finds the next command of a batch for a ring.
+ *
+ * \param[in]       cmds points to the commands of the batch.
+ *
+ * \param[in]       nrCmds is the number of commands of the batch.
+ *
+ * \param[in]       ring is the ring, see FM10000_SBUS_RING_xxx.
+ *
+ * \param[in]       first is the index to start searching from.
+ *
+ * \return          The index of the next command of the ring, nrCmds if
+ *                  there is none.
+ *
+ *****************************************************************************/
+static fm_int NextSbusCommand(fm10000_sbusCmd *cmds,
+                              fm_int           nrCmds,
+                              fm_int           ring,
+                              fm_int           first)
+{
+    fm_int i;
+
+    for (i = first ; i < nrCmds ; i++)
+    {
+        if (SBUS_CMD_RING(&cmds[i]) == ring)
+        {
+            break;
         }
+    }
+
+    return i;
+
+}   /* end NextSbusCommand */
+
+
+
+
+/*****************************************************************************/
+/** SBusRequest
+ * \ingroup intSBus
+ *
+ * \desc            Executes the specified SBus transaction. The kind of
+ *                  transaction is specified by the opCode field of the
+ *                  ''fm10000_sbusReq'' structure pointed by pSbusReq and it may
+ *                  be write, read or reset. This function blocks until the
+ *                  transaction is completed or an error has happend.
+ *                  Note that execution of a single SBus request could take up
+ *                  to 15us.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       eplRing is TRUE if the destination ring is EPL or FALSE
+ *                  if it is the PCIE ring.
+ *
+ * \param[in,out]   pSbusReq points to the SBus request to execute.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if pSbusReq is a NULL pointer.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status SBusRequest(fm_int           sw,
+                      fm_bool          eplRing,
+                      fm10000_sbusReq *pSbusReq)
+{
+    fm_status       err;
+    fm10000_sbusCmd cmd;
+
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
+                         "sw=%d, eplRing=%d, pSbusReq=%p\n",
+                         sw,
+                         eplRing,
+                         (void *) pSbusReq);
+
+    if (pSbusReq == NULL)
+    {
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    FM_CLEAR(cmd);
+
+    switch (pSbusReq->opCode)
+    {
+        case FM10000_SBUS_OP_READ:
+            cmd.type = FM10000_SBUS_CMD_READ;
+            break;
+
+        case FM10000_SBUS_OP_WRITE:
+            cmd.type = FM10000_SBUS_CMD_WRITE;
+            break;
 
-        if (!eplRing)
-        {
-            DropPcieSbusLock(sw);
-        }
+        default:
+            cmd.type = FM10000_SBUS_CMD_RESET;
+            break;
+    }
+
+    cmd.eplRing  = eplRing;
+    cmd.sbusAddr = pSbusReq->devAddr;
+    cmd.sbusReg  = pSbusReq->regAddr;
+    cmd.data     = pSbusReq->data;
 
-        DROP_REG_LOCK(sw);
+    err = fm10000SbusExecute(sw, &cmd, 1);
 
+    if (err == FM_OK && cmd.type == FM10000_SBUS_CMD_READ)
+    {
+        pSbusReq->data = cmd.result;
     }
 
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
@@ -630,6 +959,7 @@ fm_status fm10000SbusInit(fm_int    sw,
     fm_uint32       divider;
     fm_status       err;
     fm_status       err2;
+    fm_lock        *ringLock;
 
     FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
 
@@ -640,7 +970,10 @@ fm_status fm10000SbusInit(fm_int    sw,
     /* Skip SBus intialization if the API is running on the Test Bench */
     if (switchExt->serdesBypassSbus == FALSE)
     {
-        TAKE_REG_LOCK(sw);
+        /* keep the ring for the whole sequence */
+        ringLock = &switchExt->sbusLock[eplRing ? FM10000_SBUS_RING_EPL :
+                                                  FM10000_SBUS_RING_PCIE];
+        fmCaptureLock(ringLock, FM_WAIT_FOREVER);
 
         /* send a reset command to the SBus */
         err = fm10000SbusSbmReset(sw, eplRing);
@@ -689,7 +1022,7 @@ fm_status fm10000SbusInit(fm_int    sw,
                          eplRing? "EPL" : "PCIe");
         }
     
-        DROP_REG_LOCK(sw);
+        fmReleaseLock(ringLock);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
@@ -728,7 +1061,6 @@ fm_status fm10000SbusRead(fm_int     sw,
 {
     fm_status       err;
     fm10000_sbusReq sbusReq;
-    fm_timestamp    timeStamp;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
                          "sw=%d eplRing=%d sbusAddr=0x%x sbusReg=0x%x data=%p\n",
@@ -739,7 +1071,6 @@ fm_status fm10000SbusRead(fm_int     sw,
                          (void *) pData);
 
     err = FM_OK;
-    fmGetTime(&timeStamp);
 
     if (pData == NULL)
     {
@@ -772,18 +1103,6 @@ fm_status fm10000SbusRead(fm_int     sw,
             if (err == FM_OK)
             {
                 *pData = sbusReq.data;
-
-                if (sbusDebug)
-                {
-                    FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x => 0x%8.8x  t=%4.4d.%3.3d\n",
-                                 sw,
-                                 eplRing,
-                                 sbusAddr, 
-                                 sbusReg,
-                                 *pData,
-                                 (fm_int)(timeStamp.sec%10000), 
-                                 (fm_int)(timeStamp.usec/1000));
-                }
             }
         }   /* end if (!fmPlatformBypassEnabled(sw)) */
     }
@@ -824,7 +1143,6 @@ fm_status fm10000SbusWrite(fm_int    sw,
 {
     fm_status       err;
     fm10000_sbusReq sbusReq;
-    fm_timestamp    timeStamp;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
                          "sw=%d eplRing=%d sbusAddr=0x%x sbusReg=0x%x data=0x%x\n",
@@ -835,7 +1153,6 @@ fm_status fm10000SbusWrite(fm_int    sw,
                          data);
 
     err = FM_OK;
-    fmGetTime(&timeStamp);
 
     if (sbusAddr > 0xFF)
     {
@@ -850,18 +1167,6 @@ fm_status fm10000SbusWrite(fm_int    sw,
          *  accesses are not performed to the real hardware */
         if (!fmPlatformBypassEnabled(sw))
         {
-            if (sbusDebug)
-            {
-                FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x <= 0x%8.8x  t=%4.4d.%3.3d\n",
-                             sw, 
-                             eplRing, 
-                             sbusAddr, 
-                             sbusReg, 
-                             data, 
-                             (fm_int)(timeStamp.sec%10000), 
-                             (fm_int)(timeStamp.usec/1000) );
-            }
-        
             memset((void *) &sbusReq, 0, sizeof(fm10000_sbusReq));
         
             sbusReq.opCode      = FM10000_SBUS_OP_WRITE;
@@ -900,14 +1205,12 @@ fm_status fm10000SbusReceiverReset(fm_int    sw,
 {
     fm_status       err;
     fm10000_sbusReq sbusReq;
-    fm_timestamp    timeStamp;
     fm_serdesRing   ring;
     fm_bool         eplRing;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw=%d serDes=%d\n", sw, serDes);
 
     err = FM_OK;
-    fmGetTime(&timeStamp);
 
     sbusReq.opCode      = FM10000_SBUS_OP_RESET;
     sbusReq.resultCode  = FM10000_SBUS_RESULT_RESET;
@@ -922,18 +1225,6 @@ fm_status fm10000SbusReceiverReset(fm_int    sw,
         
         eplRing = ( ring == FM10000_SERDES_RING_EPL);
         
-        if (sbusDebug)
-        {
-            FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x <= 0x%8.8x  t=%4.4d.%3.3d\n",
-                         sw, 
-                         eplRing, 
-                         sbusReq.devAddr, 
-                         sbusReq.regAddr, 
-                         sbusReq.data,
-                         (fm_int)(timeStamp.sec%10000), 
-                         (fm_int)(timeStamp.usec/1000));
-        }
-    
         err = SBusRequest(sw, eplRing, &sbusReq);
     }
 
@@ -963,12 +1254,10 @@ fm_status fm10000SbusReset(fm_int    sw,
 {
     fm_status       err;
     fm10000_sbusReq sbusReq;
-    fm_timestamp    timeStamp;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw=%d eplRing=%d\n", sw, eplRing);
 
     err = FM_OK;
-    fmGetTime(&timeStamp);
 
     /* use broadcast address to reset all SerDes */
     sbusReq.opCode      = FM10000_SBUS_OP_RESET;
@@ -982,18 +1271,6 @@ fm_status fm10000SbusReset(fm_int    sw,
      *  accesses are not performed to the real hardware */
     if (!fmPlatformBypassEnabled(sw))
     {
-        if (sbusDebug)
-        {
-            FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x <= 0x%8.8x  t=%4.4d.%3.3d\n",
-                         sw, 
-                         eplRing, 
-                         sbusReq.devAddr, 
-                         sbusReq.regAddr, 
-                         sbusReq.data,
-                         (fm_int)(timeStamp.sec%10000), 
-                         (fm_int)(timeStamp.usec/1000));
-        }
-    
         err = SBusRequest(sw, eplRing, &sbusReq);
     }
 
@@ -1023,12 +1300,10 @@ fm_status fm10000SbusSbmReset(fm_int    sw,
 {
     fm_status       err;
     fm10000_sbusReq sbusReq;
-    fm_timestamp    timeStamp;
 
     FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH, "sw=%d eplRing=%d\n", sw, eplRing);
 
     err = FM_OK;
-    fmGetTime(&timeStamp);
 
 
     sbusReq.opCode      = FM10000_SBUS_OP_RESET;
@@ -1042,18 +1317,6 @@ fm_status fm10000SbusSbmReset(fm_int    sw,
      *  accesses are not performed to the real hardware */
     if (!fmPlatformBypassEnabled(sw))
     {
-        if (sbusDebug)
-        {
-            FM_LOG_PRINT("sw=%d ring=%d addr=0x%2.2x reg=0x%2.2x <= 0x%8.8x  t=%4.4d.%3.3d\n",
-                         sw, 
-                         eplRing, 
-                         sbusReq.devAddr, 
-                         sbusReq.regAddr, 
-                         sbusReq.data,
-                         (fm_int)(timeStamp.sec%10000), 
-                         (fm_int)(timeStamp.usec/1000));
-        }
-    
         err = SBusRequest(sw, eplRing, &sbusReq);
     }
 
@@ -1062,3 +1325,491 @@ fm_status fm10000SbusSbmReset(fm_int    sw,
 }   /* end fm10000SbusSbmReset */
 
 
+
+
+/*****************************************************************************/
+/** fm10000SbusExecute
+ * \ingroup intSBus
+ *
+ * \desc            Executes a batch of SBus commands. Commands of the same
+ *                  ring are executed in order, one at a time since a ring
+ *                  controller runs a single command. The EPL and PCIE rings
+ *                  are run in parallel: while a command is in progress on
+ *                  one ring, commands are issued and completed on the other.
+ *                                                                      \lb\lb
+ *                  The rings used by the batch are locked for its whole
+ *                  duration, so that a sequence of commands is not
+ *                  interleaved with the commands of other threads. The
+ *                  PCIE ring is shared with the NVM and is also taken from
+ *                  it once per batch rather than once per command.
+ *                                                                      \lb\lb
+ *                  A failed command also fails the commands queued behind
+ *                  it on the same ring, since a sequence cannot go on past
+ *                  a failed step; the other ring is not affected. The
+ *                  callback of each command is called upon its completion,
+ *                  whether successful or not.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in,out]   cmds points to an array of nrCmds commands. The result
+ *                  and status of each command are returned in it.
+ *
+ * \param[in]       nrCmds is the number of commands.
+ *
+ * \return          FM_OK if all commands were successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if cmds is NULL or nrCmds is
+ *                  negative.
+ * \return          Other ''Status Codes'' as appropriate in case of failure,
+ *                  the first error met.
+ *
+ *****************************************************************************/
+fm_status fm10000SbusExecute(fm_int           sw,
+                             fm10000_sbusCmd *cmds,
+                             fm_int           nrCmds)
+{
+    fm10000_switch  *switchExt;
+    fm10000_sbusRun  run[FM10000_SBUS_NUM_RINGS];
+    fm10000_sbusRun *state;
+    fm10000_sbusCmd *cmd;
+    fm_bool          lockTaken[FM10000_SBUS_NUM_RINGS];
+    fm_bool          pcieLockTaken;
+    fm_bool          progress;
+    fm_bool          pending;
+    fm_bool          done;
+    fm_uint          minWaitLoopCnt;
+    fm_uint          delayNsec;
+    fm_uint32        value = 0;
+    fm_status        err;
+    fm_int           ring;
+    fm_int           i;
+
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_SWITCH,
+                         "sw=%d, cmds=%p, nrCmds=%d\n",
+                         sw,
+                         (void *) cmds,
+                         nrCmds);
+
+    if (cmds == NULL || nrCmds < 0)
+    {
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    /* bypass mode:
+     *   skip sbus access in bypass mode */
+    if (fmPlatformBypassEnabled(sw))
+    {
+        for (i = 0 ; i < nrCmds ; i++)
+        {
+            cmds[i].result = 0;
+            cmds[i].status = FM_OK;
+
+            if (cmds[i].callback != NULL)
+            {
+                cmds[i].callback(sw, &cmds[i]);
+            }
+        }
+
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, FM_OK);
+    }
+
+    switchExt     = GET_SWITCH_EXT(sw);
+    pcieLockTaken = FALSE;
+
+    FM_CLEAR(run);
+    FM_CLEAR(lockTaken);
+
+    for (i = 0 ; i < nrCmds ; i++)
+    {
+        cmds[i].result = 0;
+        cmds[i].status = FM_OK;
+        run[SBUS_CMD_RING(&cmds[i])].nrQueued++;
+    }
+
+    /**************************************************
+     * Lock the rings used by the batch, always in
+     * the same order.
+     **************************************************/
+
+    for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+    {
+        state       = &run[ring];
+        state->next = NextSbusCommand(cmds, nrCmds, ring, 0);
+
+        if (state->nrQueued == 0)
+        {
+            continue;
+        }
+
+        err = fmCaptureLock(&switchExt->sbusLock[ring], FM_WAIT_FOREVER);
+        if (err != FM_OK)
+        {
+            state->err = err;
+            continue;
+        }
+        lockTaken[ring] = TRUE;
+
+        switchExt->sbusStats[ring].nrBatches++;
+        switchExt->sbusStats[ring].totalQueueDepth += state->nrQueued;
+        if ((fm_uint64) state->nrQueued >
+            switchExt->sbusStats[ring].maxQueueDepth)
+        {
+            switchExt->sbusStats[ring].maxQueueDepth = state->nrQueued;
+        }
+
+        if (ring == FM10000_SBUS_RING_PCIE)
+        {
+            state->err = TakePcieSbusLock(sw);
+            pcieLockTaken = (state->err == FM_OK);
+        }
+    }
+
+    /**************************************************
+     * Keep a command in progress on every ring that
+     * has commands left, polling the rings in turn.
+     **************************************************/
+
+    do
+    {
+        progress = FALSE;
+        pending  = FALSE;
+
+        for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+        {
+            state = &run[ring];
+
+            /* start the next command if the ring is idle */
+            while (state->current == NULL && state->next < nrCmds)
+            {
+                cmd         = &cmds[state->next];
+                state->next = NextSbusCommand(cmds, nrCmds, ring, state->next + 1);
+
+                if (state->err != FM_OK)
+                {
+                    /* not executed, the ring failed */
+                    CompleteSbusCommand(sw, ring, state, cmd, state->err);
+                    continue;
+                }
+
+                err = StartSbusCommand(sw, ring, state, cmd);
+                if (err != FM_OK)
+                {
+                    state->current = NULL;
+                    CompleteSbusCommand(sw, ring, state, cmd, err);
+                }
+            }
+
+            if (state->current == NULL)
+            {
+                continue;
+            }
+
+            /* poll the command in progress */
+            cmd = state->current;
+            err = PollSbusCommand(sw, ring, state->opCode, &done, &value);
+
+            if (err == FM_OK && !done)
+            {
+                pending = TRUE;
+                continue;
+            }
+
+            progress = TRUE;
+
+            if (err == FM_OK && state->opCode == FM10000_SBUS_OP_READ)
+            {
+                cmd->result = value;
+
+                if (cmd->type == FM10000_SBUS_CMD_RMW)
+                {
+                    /* the read is done, issue the write */
+                    err = StartSbusCommand(sw, ring, state, cmd);
+                    if (err == FM_OK)
+                    {
+                        pending = TRUE;
+                        continue;
+                    }
+                }
+            }
+
+            state->current = NULL;
+            CompleteSbusCommand(sw, ring, state, cmd, err);
+
+            if (state->next < nrCmds)
+            {
+                pending = TRUE;
+            }
+        }
+
+        if (!pending || progress)
+        {
+            /* check again right away */
+            continue;
+        }
+
+        /**************************************************
+         * No command completed, wait. The delay is
+         * proportional to the number of wait loops of
+         * the most recent command.
+         * timeout = SBUS_WAIT_LOOP_INITIAL_DELAY_NS *
+         *           SBUS_MAX_WAIT_LOOPS * (SBUS_MAX_WAIT_LOOPS/2)
+         **************************************************/
+
+        minWaitLoopCnt = SBUS_MAX_WAIT_LOOPS;
+
+        for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+        {
+            state = &run[ring];
+            cmd   = state->current;
+
+            if (cmd == NULL)
+            {
+                continue;
+            }
+
+            if (++state->waitLoopCnt >= SBUS_MAX_WAIT_LOOPS)
+            {
+                FM_LOG_FATAL(FM_LOG_CAT_SWITCH, 
+                             "SBUS Command (dev=0x%x, reg=0x%x) timed out "
+                             "in %u usec\n", 
+                             cmd->sbusAddr,
+                             cmd->sbusReg,
+                             state->totalDelayNsec / 1000);
+
+                state->current = NULL;
+                CompleteSbusCommand(sw, ring, state, cmd, FM_FAIL);
+            }
+            else if (state->waitLoopCnt < minWaitLoopCnt)
+            {
+                minWaitLoopCnt = state->waitLoopCnt;
+            }
+        }
+
+        if (minWaitLoopCnt < SBUS_MAX_WAIT_LOOPS)
+        {
+            delayNsec = SBUS_WAIT_LOOP_INITIAL_DELAY_NS * minWaitLoopCnt;
+            fmDelay(0, delayNsec);
+
+            for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+            {
+                if (run[ring].current != NULL)
+                {
+                    run[ring].totalDelayNsec += delayNsec;
+                }
+            }
+        }
+    }
+    while (pending);
+
+    /**************************************************
+     * Unlock the rings.
+     **************************************************/
+
+    if (pcieLockTaken)
+    {
+        DropPcieSbusLock(sw);
+    }
+
+    err = FM_OK;
+
+    for (ring = FM10000_SBUS_NUM_RINGS - 1 ; ring >= 0 ; ring--)
+    {
+        if (lockTaken[ring])
+        {
+            fmReleaseLock(&switchExt->sbusLock[ring]);
+        }
+
+        if (run[ring].err != FM_OK)
+        {
+            err = run[ring].err;
+        }
+    }
+
+    FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000SbusExecute */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SbusAllocateResources
+ * \ingroup intSBus
+ *
+ * \desc            Creates the SBus ring locks of a switch. Called upon
+ *                  switch insertion.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fm10000SbusAllocateResources(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_status       err;
+    fm_char         lockName[32];
+    fm_int          ring;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    err       = FM_OK;
+
+    for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+    {
+        FM_SPRINTF_S(lockName,
+                     sizeof(lockName),
+                     "SBus %s Lock %d",
+                     SBUS_RING_NAME(ring),
+                     sw);
+
+        /* SBus commands are issued from the API and platform threads
+         * alike, the ring locks are always taken before the register
+         * lock and are not part of the API lock precedence */
+        err = fmCreateLock(lockName, &switchExt->sbusLock[ring]);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_CLEAR(switchExt->sbusStats);
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000SbusAllocateResources */
+
+
+
+
+/*****************************************************************************/
+/** fm10000SbusFreeResources
+ * \ingroup intSBus
+ *
+ * \desc            Deletes the SBus ring locks of a switch. Called upon
+ *                  switch removal.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+fm_status fm10000SbusFreeResources(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_status       err;
+    fm_status       err2;
+    fm_int          ring;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    err       = FM_OK;
+
+    for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+    {
+        if (switchExt->sbusLock[ring].handle != NULL)
+        {
+            err2 = fmDeleteLock(&switchExt->sbusLock[ring]);
+            if (err2 != FM_OK)
+            {
+                err = err2;
+            }
+        }
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fm10000SbusFreeResources */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgDumpSbusStats
+ * \ingroup intDiag
+ *
+ * \desc            Displays the SBus statistics of each ring: number of
+ *                  commands and batches, command latency and number of
+ *                  commands queued per batch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgDumpSbusStats(fm_int sw)
+{
+    fm10000_switch   *switchExt;
+    fm10000_sbusStats stats;
+    fm_int            ring;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    FM_LOG_PRINT("\nSBus statistics for switch %d\n\n", sw);
+    FM_LOG_PRINT("%-5s %10s %8s %9s %12s %12s %10s %10s\n",
+                 "Ring",
+                 "Commands",
+                 "Errors",
+                 "Batches",
+                 "AvgLat(us)",
+                 "MaxLat(us)",
+                 "AvgDepth",
+                 "MaxDepth");
+
+    for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+    {
+        fmCaptureLock(&switchExt->sbusLock[ring], FM_WAIT_FOREVER);
+        stats = switchExt->sbusStats[ring];
+        fmReleaseLock(&switchExt->sbusLock[ring]);
+
+        FM_LOG_PRINT("%-5s %10" FM_FORMAT_64 "u %8" FM_FORMAT_64 "u "
+                     "%9" FM_FORMAT_64 "u %12" FM_FORMAT_64 "u "
+                     "%12" FM_FORMAT_64 "u %10" FM_FORMAT_64 "u "
+                     "%10" FM_FORMAT_64 "u\n",
+                     SBUS_RING_NAME(ring),
+                     stats.nrCommands,
+                     stats.nrErrors,
+                     stats.nrBatches,
+                     stats.nrCommands ?
+                        stats.totalLatency / stats.nrCommands : 0,
+                     stats.maxLatency,
+                     stats.nrBatches ?
+                        stats.totalQueueDepth / stats.nrBatches : 0,
+                     stats.maxQueueDepth);
+    }
+
+    return FM_OK;
+
+}   /* end fm10000DbgDumpSbusStats */
+
+
+
+
+/*****************************************************************************/
+/** fm10000DbgResetSbusStats
+ * \ingroup intDiag
+ *
+ * \desc            Resets the SBus statistics of each ring.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000DbgResetSbusStats(fm_int sw)
+{
+    fm10000_switch *switchExt;
+    fm_int          ring;
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    for (ring = 0 ; ring < FM10000_SBUS_NUM_RINGS ; ring++)
+    {
+        fmCaptureLock(&switchExt->sbusLock[ring], FM_WAIT_FOREVER);
+        FM_CLEAR(switchExt->sbusStats[ring]);
+        fmReleaseLock(&switchExt->sbusLock[ring]);
+    }
+
+    return FM_OK;
+
+}   /* end fm10000DbgResetSbusStats */
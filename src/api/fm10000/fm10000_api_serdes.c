@@ -1450,7 +1450,9 @@ fm_status fm10000SerdesReadModifyWrite(fm_int     sw,
                                        fm_uint32 *pReadValue)
 {
     fm_status       err;
-    fm_uint32       readVal;
+    fm_uint         sbusAddr;
+    fm_serdesRing   ring;
+    fm10000_sbusCmd cmd;
     fm10000_switch *switchExt;
 
 
@@ -1471,15 +1473,25 @@ fm_status fm10000SerdesReadModifyWrite(fm_int     sw,
     }
     else
     {
-        err = fm10000SerdesRead(sw, serDes, regAddr, &readVal);
+        err = fm10000MapSerdesToSbus(sw, serDes, &sbusAddr, &ring);
 
         if (err == FM_OK)
         {
-            err = fm10000SerdesWrite(sw, serDes, regAddr, (data & mask) | (readVal & ~mask));
+            /* a single RMW command keeps the ring locked between the read
+             * and the write-back */
+            FM_CLEAR(cmd);
+            cmd.type     = FM10000_SBUS_CMD_RMW;
+            cmd.eplRing  = (ring == FM10000_SERDES_RING_EPL);
+            cmd.sbusAddr = sbusAddr;
+            cmd.sbusReg  = regAddr;
+            cmd.data     = data;
+            cmd.mask     = mask;
+
+            err = fm10000SbusExecute(sw, &cmd, 1);
 
             if (err == FM_OK && pReadValue != NULL)
             {
-                *pReadValue = readVal;
+                *pReadValue = cmd.result;
             }
         }
     }
@@ -3816,7 +3828,7 @@ fm_status fm10000SerdesSendDfeEventReq(fm_int    sw,
     dfeEventInfo.smType  = pLaneExt->dfeExt.smType;
     dfeEventInfo.srcSmType = pLaneExt->smType;
     dfeEventInfo.eventId = eventId;
-    dfeEventInfo.lock    = FM_GET_STATE_LOCK( sw );
+    dfeEventInfo.lock    = &pLaneExt->dfeExt.lock;
     dfeEventInfo.dontSaveRecord = FALSE;
 
     err = fmNotifyStateMachineEvent( pLaneExt->dfeExt.smHandle,
@@ -110,19 +110,17 @@ fm_status SendDfeEventReq( fm_smEventInfo *eventInfo,
                            fm_int          eventId )
 {
     fm_status        err;
-    fm_int           sw;
     fm10000_lane    *pLaneExt;
     fm_smEventInfo   dfeEventInfo;
 
     FM_NOT_USED(eventInfo);
 
-    sw = ((fm10000_serDesSmEventInfo *)userInfo)->switchPtr->switchNumber;
     pLaneExt = ((fm10000_serDesSmEventInfo *)userInfo)->laneExt;
 
     dfeEventInfo.smType  = pLaneExt->dfeExt.smType;
     dfeEventInfo.srcSmType = pLaneExt->smType;
     dfeEventInfo.eventId = eventId;
-    dfeEventInfo.lock    = FM_GET_STATE_LOCK( sw );
+    dfeEventInfo.lock    = &pLaneExt->dfeExt.lock;
     dfeEventInfo.dontSaveRecord = FALSE;
 
     err = fmNotifyStateMachineEvent( pLaneExt->dfeExt.smHandle,
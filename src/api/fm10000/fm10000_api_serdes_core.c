@@ -3837,33 +3837,39 @@ fm_status fm10000SbmSpicoIntWrite(fm_int        sw,
                                   fm_uint       intNum,
                                   fm_uint32     param)
 {
-    fm_status err;
-    fm_uint32 reg07;
-    fm_bool   isEplRing;
+    fm_status       err;
+    fm10000_sbusCmd cmds[3];
+    fm_uint32       bit0Mask;
+    fm_int          i;
 
 
-    isEplRing = (ring == FM10000_SERDES_RING_EPL);
+    bit0Mask = 1U << FM10000_SPICO_REG_07_b_BIT_0;
 
-    err = fm10000SbusWrite(sw, isEplRing, sbusAddr, FM10000_SPICO_REG_02, (param << 16) | intNum);
+    /* write the interrupt, then pulse REG_07 bit 0 to trigger it. The three
+     * commands are executed as one batch, holding the ring once. */
+    FM_CLEAR(cmds);
 
-    if (err == FM_OK)
+    for (i = 0 ; i < 3 ; i++)
     {
+        cmds[i].eplRing  = (ring == FM10000_SERDES_RING_EPL);
+        cmds[i].sbusAddr = sbusAddr;
+    }
 
-        err = fm10000SbusRead(sw, isEplRing, sbusAddr, FM10000_SPICO_REG_07, &reg07);
+    cmds[0].type    = FM10000_SBUS_CMD_WRITE;
+    cmds[0].sbusReg = FM10000_SPICO_REG_02;
+    cmds[0].data    = (param << 16) | intNum;
 
-        if (err == FM_OK)
-        {
-            FM_SET_BIT(reg07, FM10000_SPICO_REG_07, BIT_0, 1);
-            err = fm10000SbusWrite(sw, isEplRing, sbusAddr, FM10000_SPICO_REG_07, reg07);
+    cmds[1].type    = FM10000_SBUS_CMD_RMW;
+    cmds[1].sbusReg = FM10000_SPICO_REG_07;
+    cmds[1].data    = bit0Mask;
+    cmds[1].mask    = bit0Mask;
 
-            if (err == FM_OK)
-            {
+    cmds[2].type    = FM10000_SBUS_CMD_RMW;
+    cmds[2].sbusReg = FM10000_SPICO_REG_07;
+    cmds[2].data    = 0;
+    cmds[2].mask    = bit0Mask;
 
-                FM_SET_BIT(reg07, FM10000_SPICO_REG_07, BIT_0, 0);
-                err = fm10000SbusWrite(sw, isEplRing, sbusAddr, FM10000_SPICO_REG_07, reg07);
-            }
-        }
-    }
+    err = fm10000SbusExecute(sw, cmds, 3);
 
     return err;
 
@@ -4019,6 +4025,8 @@ fm_status fm10000SerdesSpicoUploadImage(fm_int           sw,
     fm_timestamp    tEnd;
     fm_timestamp    tDelta;
     fm_uint32       reg07;
+    fm10000_sbusCmd cmds[FM10000_SBUS_MAX_BATCH];
+    fm_int          nrCmds;
 
 
     FM_LOG_ENTRY(FM_LOG_CAT_SERDES,
@@ -4072,20 +4080,40 @@ fm_status fm10000SerdesSpicoUploadImage(fm_int           sw,
 
             fmGetTime(&tStart);
 
+            /* stream the image in batches of REG_0A writes, each holding
+             * three words */
+            FM_CLEAR(cmds);
 
-            for (addr = 0; addr < numWords && err == FM_OK; addr += 3)
+            for (nrCmds = 0 ; nrCmds < FM10000_SBUS_MAX_BATCH ; nrCmds++)
             {
-                val = 0xc0000000 | pRomImg[addr];
-                if ((addr+1) < numWords)
-                {
-                    val |= (pRomImg[addr+1] << 10);
+                cmds[nrCmds].type     = FM10000_SBUS_CMD_WRITE;
+                cmds[nrCmds].eplRing  = eplRing;
+                cmds[nrCmds].sbusAddr = serdesAddr;
+                cmds[nrCmds].sbusReg  = FM10000_SERDES_REG_0A;
+            }
 
-                    if ((addr+2) < numWords)
+            addr = 0;
+
+            while (addr < numWords && err == FM_OK)
+            {
+                for (nrCmds = 0 ;
+                     nrCmds < FM10000_SBUS_MAX_BATCH && addr < numWords ;
+                     nrCmds++, addr += 3)
+                {
+                    val = 0xc0000000 | pRomImg[addr];
+                    if ((addr+1) < numWords)
                     {
-                        val |= (pRomImg[addr+2] << 20);
+                        val |= (pRomImg[addr+1] << 10);
+
+                        if ((addr+2) < numWords)
+                        {
+                            val |= (pRomImg[addr+2] << 20);
+                        }
                     }
+                    cmds[nrCmds].data = val;
                 }
-                err = fm10000SbusWrite(sw, eplRing, serdesAddr, FM10000_SERDES_REG_0A, val);
+
+                err = fm10000SbusExecute(sw, cmds, nrCmds);
             }
 
             if (err == FM_OK)
@@ -4512,6 +4540,8 @@ fm_status fm10000SbmSpicoUploadImage(fm_int           sw,
     fm_timestamp    tStart;
     fm_timestamp    tEnd;
     fm_timestamp    tDelta;
+    fm10000_sbusCmd cmds[FM10000_SBUS_MAX_BATCH];
+    fm_int          nrCmds;
 
 
 
@@ -4558,10 +4588,30 @@ fm_status fm10000SbmSpicoUploadImage(fm_int           sw,
 
             fmGetTime(&tStart);
 
-            for (addr = 0 ; addr < sbmNumWords && err == FM_OK; addr++)
+            /* stream the image in batches of one word per write */
+            FM_CLEAR(cmds);
+
+            for (nrCmds = 0 ; nrCmds < FM10000_SBUS_MAX_BATCH ; nrCmds++)
             {
-                data = 0x80000000 | (pSbmRomImg[addr] << 16) | addr;
-                err = fm10000SbusWrite(sw, isEplRing, sbusAddr, 0x03, data);
+                cmds[nrCmds].type     = FM10000_SBUS_CMD_WRITE;
+                cmds[nrCmds].eplRing  = isEplRing;
+                cmds[nrCmds].sbusAddr = sbusAddr;
+                cmds[nrCmds].sbusReg  = 0x03;
+            }
+
+            addr = 0;
+
+            while (addr < sbmNumWords && err == FM_OK)
+            {
+                for (nrCmds = 0 ;
+                     nrCmds < FM10000_SBUS_MAX_BATCH && addr < sbmNumWords ;
+                     nrCmds++, addr++)
+                {
+                    data = 0x80000000 | (pSbmRomImg[addr] << 16) | addr;
+                    cmds[nrCmds].data = data;
+                }
+
+                err = fm10000SbusExecute(sw, cmds, nrCmds);
             }
 
             if (err == FM_OK)
@@ -5623,8 +5673,10 @@ fm_status fm10000SerdesDmaRead(fm_int               sw,
                                fm_uint32           *pReadValue)
 {
     fm_status       err;
-    fm_uint32       initVal20;
-    fm_uint32       initVal01;
+    fm_uint         sbusAddr;
+    fm_serdesRing   ring;
+    fm10000_sbusCmd cmds[3];
+    fm_int          i;
     fm10000_switch *switchExt;
 
     FM_LOG_ENTRY_V2(FM_LOG_CAT_SERDES, serDes,
@@ -5638,6 +5690,23 @@ fm_status fm10000SerdesDmaRead(fm_int               sw,
     switchExt = GET_SWITCH_EXT(sw);
     err = FM_OK;
 
+    /* the direct SBus paths below are executed as command batches */
+    if (switchExt->serdesBypassSbus == FALSE &&
+        (type == FM10000_SERDES_DMA_TYPE_LSB_DIRECT ||
+         type == FM10000_SERDES_DMA_TYPE_DMEM) )
+    {
+        err = fm10000MapSerdesToSbus(sw, serDes, &sbusAddr, &ring);
+        FM_LOG_EXIT_ON_ERR_V2(FM_LOG_CAT_SERDES, serDes, err);
+
+        FM_CLEAR(cmds);
+
+        for (i = 0 ; i < 3 ; i++)
+        {
+            cmds[i].eplRing  = (ring == FM10000_SERDES_RING_EPL);
+            cmds[i].sbusAddr = sbusAddr;
+        }
+    }
+
     switch (type)
     {
         case FM10000_SERDES_DMA_TYPE_DMAREG:
@@ -5668,10 +5737,17 @@ fm_status fm10000SerdesDmaRead(fm_int               sw,
             }
             else
             {
-                err = fm10000SerdesWrite(sw, serDes, 0x02, ((addr & 0x1ff) << 16));
+                cmds[0].type    = FM10000_SBUS_CMD_WRITE;
+                cmds[0].sbusReg = 0x02;
+                cmds[0].data    = ((addr & 0x1ff) << 16);
+
+                cmds[1].type    = FM10000_SBUS_CMD_READ;
+                cmds[1].sbusReg = 0x40;
+
+                err = fm10000SbusExecute(sw, cmds, 2);
                 if (err == FM_OK)
                 {
-                    err = fm10000SerdesRead(sw, serDes, 0x40, pReadValue);
+                    *pReadValue = cmds[1].result;
                 }
             }
             break;
@@ -5709,36 +5785,36 @@ fm_status fm10000SerdesDmaRead(fm_int               sw,
             else
             {
 
-                err = fm10000SerdesReadModifyWrite(sw, serDes, 0x20, 0x03, 0x01, &initVal20);
+                /* select the DMEM address and read it in one batch */
+                cmds[0].type    = FM10000_SBUS_CMD_RMW;
+                cmds[0].sbusReg = 0x20;
+                cmds[0].data    = 0x03;
+                cmds[0].mask    = 0x01;
 
-                if (err == FM_OK)
-                {
-                    err = fm10000SerdesReadModifyWrite(sw,
-                                                       serDes,
-                                                       0x01,
-                                                       0x40000000 | (addr & 0x3ff),
-                                                       0x400003ff,
-                                                       &initVal01);
-                }
+                cmds[1].type    = FM10000_SBUS_CMD_RMW;
+                cmds[1].sbusReg = 0x01;
+                cmds[1].data    = 0x40000000 | (addr & 0x3ff);
+                cmds[1].mask    = 0x400003ff;
 
-                if (err == FM_OK)
-                {
-                    err = fm10000SerdesRead(sw, serDes, 0x01, pReadValue);
-                    if (err == FM_OK)
-                    {
-                        *pReadValue = (*pReadValue >> 12) & 0xFFFF;
-                    }
-                }
+                cmds[2].type    = FM10000_SBUS_CMD_READ;
+                cmds[2].sbusReg = 0x01;
+
+                err = fm10000SbusExecute(sw, cmds, 3);
 
                 if (err == FM_OK)
                 {
+                    *pReadValue = (cmds[2].result >> 12) & 0xFFFF;
 
-                    err = fm10000SerdesWrite(sw, serDes, 0x01, initVal01);
-                    if (err == FM_OK)
-                    {
+                    /* then restore the initial register values, which are
+                     * only known once the first batch has completed */
+                    cmds[2].type    = FM10000_SBUS_CMD_WRITE;
+                    cmds[2].sbusReg = 0x20;
+                    cmds[2].data    = cmds[0].result;
 
-                        err = fm10000SerdesWrite(sw, serDes, 0x20, initVal20);
-                    }
+                    cmds[1].type    = FM10000_SBUS_CMD_WRITE;
+                    cmds[1].data    = cmds[1].result;
+
+                    err = fm10000SbusExecute(sw, &cmds[1], 2);
                 }
             }
             break;
@@ -42,6 +42,11 @@
  * Local function prototypes
  *****************************************************************************/
 
+static fm_status NotifySerDesEventInd(fm_int        sw,
+                                      fm10000_lane *pLaneExt,
+                                      fm_int        eventId);
+static fm_status SendPendingDfeEventInd(fm_int           sw,
+                                        fm10000_laneDfe *pLaneDfe);
 static fm_status SendDfeEventInd(fm_smEventInfo *eventInfo,
                                  void           *userInfo,
                                  fm_int          eventId);
@@ -67,12 +72,104 @@ static void HandleDfeTuningTimeout(void *arg);
 
 
 
+/*****************************************************************************/
+/** NotifySerDesEventInd
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Notifies a DFE-level event to the parent serdes state
+ *                  machine. The caller must hold the switch state lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pLaneExt points to the lane extension structure.
+ *
+ * \param[in]       eventId is the event to be notified.
+ *
+ * \return          FM_OK if successful
+ *
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status NotifySerDesEventInd(fm_int        sw,
+                                      fm10000_lane *pLaneExt,
+                                      fm_int        eventId)
+{
+    fm_smEventInfo   serDesEventInfo;
+
+    serDesEventInfo.smType  = pLaneExt->smType;
+    serDesEventInfo.srcSmType = pLaneExt->dfeExt.smType;
+    serDesEventInfo.eventId = eventId;
+    serDesEventInfo.lock    = FM_GET_STATE_LOCK( sw );
+
+    return fmNotifyStateMachineEvent(pLaneExt->smHandle,
+                                     &serDesEventInfo,
+                                     &pLaneExt->eventInfo,
+                                     &pLaneExt->serDes);
+
+}
+
+
+
+
+/*****************************************************************************/
+/** SendPendingDfeEventInd
+ * \ingroup intSerDesDfe
+ *
+ * \desc            Sends, oldest first, the indications left pending by the
+ *                  DFE events notified without the state lock. The caller
+ *                  must hold the switch state lock and the lane's DFE lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       pLaneDfe points to the lane's DFE extension structure.
+ *
+ * \return          FM_OK if successful
+ *
+ * \return          Other ''Status Codes'' as appropriate in case of failure.
+ *
+ *****************************************************************************/
+static fm_status SendPendingDfeEventInd(fm_int           sw,
+                                        fm10000_laneDfe *pLaneDfe)
+{
+    fm_status   err;
+    fm_int      eventId;
+    fm_int      i;
+
+    err = FM_OK;
+
+    while (err == FM_OK && pLaneDfe->numPendingInd > 0)
+    {
+        /* dequeue before notifying: the serdes state machine may send DFE
+           requests whose indications flush the rest of the queue */
+        eventId = pLaneDfe->pendingInd[0];
+        for (i = 1 ; i < pLaneDfe->numPendingInd ; i++)
+        {
+            pLaneDfe->pendingInd[i - 1] = pLaneDfe->pendingInd[i];
+        }
+        pLaneDfe->numPendingInd--;
+
+        err = NotifySerDesEventInd(sw, pLaneDfe->pLaneExt, eventId);
+    }
+
+    return err;
+
+}
+
+
+
+
 /*****************************************************************************/
 /** SendDfeEventInd
  * \ingroup intPort
  *
  * \desc            Sends a DFE-level event notification to the parent serdes
  *                  state machine.
+ *                                                                      \lb\lb
+ *                  The serdes state machine is protected by the switch state
+ *                  lock, which may not be taken under the lane's DFE lock.
+ *                  If the DFE event was notified without the state lock (see
+ *                  HandleDfeTuningTimeout), the indication is left pending
+ *                  for the notifier to send once it holds the state lock.
  *
  * \param[in]       eventInfo is a pointer the generic event descriptor.
  *
@@ -83,6 +180,9 @@ static void HandleDfeTuningTimeout(void *arg);
  *
  * \return          FM_OK if successful
  *
+ * \return          FM_ERR_NO_FREE_RESOURCES if too many indications are
+ *                  already pending.
+ *
  * \return          Other ''Status Codes'' as appropriate in case of failure.
  *
  *****************************************************************************/
@@ -93,22 +193,45 @@ fm_status SendDfeEventInd(fm_smEventInfo *eventInfo,
     fm_status        err;
     fm_int           sw;
     fm10000_lane    *pLaneExt;
-    fm_smEventInfo   serDesEventInfo;
+    fm10000_laneDfe *pLaneDfe;
+    fm_bool          stateLockTaken;
 
     FM_NOT_USED(eventInfo);
 
     sw = ((fm10000_dfeSmEventInfo *)userInfo)->switchPtr->switchNumber;
     pLaneExt = ((fm10000_dfeSmEventInfo *)userInfo)->laneExt;
+    pLaneDfe = ((fm10000_dfeSmEventInfo *)userInfo)->laneDfe;
 
-    serDesEventInfo.smType  = pLaneExt->smType;
-    serDesEventInfo.srcSmType = pLaneExt->dfeExt.smType;
-    serDesEventInfo.eventId = eventId;
-    serDesEventInfo.lock    = FM_GET_STATE_LOCK( sw );
+    err = fmIsLockTaken(FM_GET_STATE_LOCK( sw ), &stateLockTaken);
+    if (err != FM_OK)
+    {
+        return err;
+    }
 
-    err = fmNotifyStateMachineEvent(pLaneExt->smHandle,
-                                    &serDesEventInfo,
-                                    &pLaneExt->eventInfo,
-                                    &pLaneExt->serDes);
+    if (!stateLockTaken)
+    {
+        if (pLaneDfe->numPendingInd >= FM10000_SERDES_DFE_MAX_PENDING_IND)
+        {
+            FM_LOG_ERROR_V2(FM_LOG_CAT_SERDES,
+                            pLaneExt->serDes,
+                            "Serdes=0x%2.2x: Too many pending DFE "
+                            "indications, dropping event %d\n",
+                            pLaneExt->serDes,
+                            eventId);
+            return FM_ERR_NO_FREE_RESOURCES;
+        }
+
+        pLaneDfe->pendingInd[pLaneDfe->numPendingInd++] = eventId;
+        return FM_OK;
+    }
+
+    /* keep the indications in order */
+    err = SendPendingDfeEventInd(sw, pLaneDfe);
+
+    if (err == FM_OK)
+    {
+        err = NotifySerDesEventInd(sw, pLaneExt, eventId);
+    }
 
     return err;
 
@@ -123,6 +246,12 @@ fm_status SendDfeEventInd(fm_smEventInfo *eventInfo,
  *
  * \desc            Callback that handles a timeout and sends an event to the
  *                  DFE state machine.
+ *                                                                      \lb\lb
+ *                  The event is notified under the lane's DFE lock alone,
+ *                  so the tuning of a lane neither waits for the other lanes
+ *                  nor for the API threads holding the state lock. The
+ *                  state lock is only taken afterwards, if the event left
+ *                  indications for the serdes state machine.
  *
  * \param[in]       arg is the pointer to the argument passed when the timer
  *                  was started, in this case the pointer to the lane extension
@@ -137,6 +266,7 @@ static void HandleDfeTuningTimeout(void *arg)
     fm10000_dfeSmEventInfo    *pDfeEventInfo;
     fm10000_laneDfe           *pLaneDfe;
     fm_int                     sw;
+    fm_bool                    pending;
 
 
     pLaneDfe          = (fm10000_laneDfe *) arg;
@@ -149,13 +279,29 @@ static void HandleDfeTuningTimeout(void *arg)
     eventInfo.smType  = pLaneDfe->smType;
     eventInfo.srcSmType = 0;
     eventInfo.eventId = FM10000_SERDES_DFE_EVENT_TIMEOUT_IND;
-    eventInfo.lock    = FM_GET_STATE_LOCK(sw);
+    eventInfo.lock    = &pLaneDfe->lock;
 
     fmNotifyStateMachineEvent(pLaneDfe->smHandle,
                               &eventInfo,
                               pDfeEventInfo,
                               &pLaneDfe->pLaneExt->serDes);
 
+    fmCaptureLock(&pLaneDfe->lock, FM_WAIT_FOREVER);
+    pending = (pLaneDfe->numPendingInd > 0);
+    fmReleaseLock(&pLaneDfe->lock);
+
+    if (pending)
+    {
+        /* state lock first, the DFE lock nests inside it */
+        fmCaptureLock(FM_GET_STATE_LOCK(sw), FM_WAIT_FOREVER);
+        fmCaptureLock(&pLaneDfe->lock, FM_WAIT_FOREVER);
+
+        SendPendingDfeEventInd(sw, pLaneDfe);
+
+        fmReleaseLock(&pLaneDfe->lock);
+        fmReleaseLock(FM_GET_STATE_LOCK(sw));
+    }
+
     UNPROTECT_SWITCH(sw);
 
 }
@@ -567,14 +713,12 @@ fm_status fm10000SerDesDfeProcessPushAutoStartTuning(fm_smEventInfo *eventInfo,
                                                      fm_int         *nextState)
 {
     fm_status        err;
-    fm_int           sw;
     fm10000_laneDfe *pLaneDfe;
     fm_smEventInfo   dfeEventInfo;
 
     FM_NOT_USED(eventInfo);
 
     err = FM_OK;
-    sw = ((fm10000_dfeSmEventInfo *)userInfo)->switchPtr->switchNumber;
     pLaneDfe  = ((fm10000_dfeSmEventInfo *)userInfo)->laneDfe;
 
 
@@ -584,7 +728,7 @@ fm_status fm10000SerDesDfeProcessPushAutoStartTuning(fm_smEventInfo *eventInfo,
         dfeEventInfo.smType  = pLaneDfe->smType;
         dfeEventInfo.srcSmType = 0;
         dfeEventInfo.eventId = FM10000_SERDES_DFE_EVENT_START_TUNING_REQ;
-        dfeEventInfo.lock    = FM_GET_STATE_LOCK( sw );
+        dfeEventInfo.lock    = &pLaneDfe->lock;
 
         err = fmNotifyStateMachineEvent(pLaneDfe->smHandle,
                                         &dfeEventInfo,
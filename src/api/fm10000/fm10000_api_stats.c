@@ -39,13 +39,13 @@
 
 #define FM10000_MAX_VLAN_COUNTER            63
 
-#define FM10000_NB_RX_STATS_BANKS           FM10000_RX_STATS_BANK_ENTRIES_1
-#define FM10000_BINS_PER_RX_STATS_BANK      16
-#define FM10000_WORDS_PER_RX_STATS_COUNTER  FM10000_RX_STATS_BANK_WIDTH
-
 /* Max expected entries in read stats scatter gather list */
 #define MAX_STATS_SGLIST 128
 
+/* Max entries read by the statistics collector in one scatter gather
+ * transaction, to bound how long other register accesses wait on it. */
+#define FM10000_STATS_SWEEP_SGLIST_CHUNK    512
+
 /** Add a 32bit read of an EPL counter to the scatter gather
  *  list.
  *  
@@ -126,6 +126,19 @@
         ((fm_uint64)(cntRxPortStatsBank[bank][bin][3]) << 32) |             \
         ((fm_uint64)(cntRxPortStatsBank[bank][bin][2]) ) );                 \
     
+/** Add to the 64-bit total of a counter the number of counts since the
+ *  previous sweep. type is the width of the HW counter (fm_uint32 or
+ *  fm_uint64), so the difference is computed modulo that width.
+ *  
+ * Depends on the fields hwRead, lastRead and total of the 
+ * fm10000_portStatsState pointed to by state.
+ */
+#define FM10000_ACCUMULATE_PORT_STAT(state, offset, type)                   \
+    *( (fm_uint64 *) ( ((fm_byte *) &(state)->total) + (offset) ) ) +=      \
+        (type) ( *( (fm_uint64 *) ( ((fm_byte *) &(state)->hwRead) +        \
+                                    (offset) ) ) -                          \
+                 *( (fm_uint64 *) ( ((fm_byte *) &(state)->lastRead) +      \
+                                    (offset) ) ) );
      
 
 
@@ -443,6 +456,21 @@ static fm10000_portCounterMapping txPortCntMapTable[] =
 
 };  /* end txPortCntMapTable */
 
+
+/* Offsets of the 32bit EPL counters in the fm_portCounters structure.
+ * Must match the EPL counters read by AddPortCounterReads. */
+static const fm_uint32 eplPortCntOffsetTable[] =
+{
+    offsetof(fm_portCounters, cntRxOversizedPkts),
+    offsetof(fm_portCounters, cntRxJabberPkts),
+    offsetof(fm_portCounters, cntRxUndersizedPkts),
+    offsetof(fm_portCounters, cntRxFragmentPkts),
+    offsetof(fm_portCounters, cntOverrunPkts),
+    offsetof(fm_portCounters, cntUnderrunPkts),
+    offsetof(fm_portCounters, cntCodeErrors),
+
+};  /* end eplPortCntOffsetTable */
+
 /*****************************************************************************
  * Local Function Prototypes
  *****************************************************************************/
@@ -617,154 +645,121 @@ ABORT:
 }   /* End fm10000SetBankEnable */
 
 
- /*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
 
 
 /*****************************************************************************/
-/** fm10000SetStatsFrameAdjustment
+/** GetPortStatsInfo
  * \ingroup intStats
  *
- * \desc            Sets the RX priority select for bank 3.
+ * \desc            Retrieves the information needed to read the counters
+ *                  of a port.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       physPort is the physical port for which to retrieve
- *                  statistics.
- * 
- * \param[in]       nbBytes is the number of bytes that should be substracted
- *                  from the received packet length for the specified port.
- * 
- * \return          FM_OK if successful.
- * 
- *****************************************************************************/
-fm_status fm10000SetStatsFrameAdjustment(fm_int sw,
-                                         fm_int physPort,
-                                         fm_int nbBytes)
-{
-    fm_status  err;
-    fm_switch *switchPtr;
-    fm_uint32  rxStatCfg;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_PORT, 
-                 "sw=%d physPort=%d, nbBytes=%d\n", 
-                 sw, 
-                 physPort,
-                 nbBytes);
-    
-    switchPtr = GET_SWITCH_PTR(sw);
-
-    TAKE_REG_LOCK(sw)
-
-    /* Retrieve existing values */
-    err = switchPtr->ReadUINT32(sw, FM10000_RX_STATS_CFG(physPort), &rxStatCfg);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
-
-    /* Apply */
-    FM_SET_FIELD(rxStatCfg, FM10000_RX_STATS_CFG, PerFrameAdjustment, nbBytes);
-
-    err = switchPtr->WriteUINT32(sw, FM10000_RX_STATS_CFG(physPort), rxStatCfg);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
-
-ABORT:
-    DROP_REG_LOCK(sw)
-
-    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
-
-}   /* End fm10000SetStatsFrameAdjustment */
-
-
-/*****************************************************************************/
-/** fm10000GetPortCounters
- * \ingroup intStats
+ * \param[in]       port is the logical port for which to retrieve
+ *                  information.
  *
- * \desc            Retrieve port statistics.
+ * \param[out]      physPort points to caller-allocated storage where this
+ *                  function should place the physical port number.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[out]      epl points to caller-allocated storage where this
+ *                  function should place the EPL number of the port.
  *
- * \param[in]       port is the logical port for which to retrieve statistics.
+ * \param[out]      lane points to caller-allocated storage where this
+ *                  function should place the EPL lane of the port.
  *
- * \param[out]      counters is a pointer to an fm_portCounters structure to be
- *                  filled in by this function.
- *                  If the requested port is parsing L3 headers then version
- *                  will be FM10000_STATS_VERSION | FM_VALID_IP_STATS_VERSION.
- *                  Otherwise the version will be FM10000_STATS_VERSION.
+ * \param[out]      hasEpl points to caller-allocated storage where this
+ *                  function should place whether the port has an EPL.
+ *
+ * \param[out]      validIpStats points to caller-allocated storage where
+ *                  this function should place whether the port is parsing
+ *                  L3 headers.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_PORT if port is invalid.
- * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
+ *
  *****************************************************************************/
-fm_status fm10000GetPortCounters(fm_int           sw,
-                                 fm_int           port,
-                                 fm_portCounters *counters)
+static fm_status GetPortStatsInfo(fm_int   sw,
+                                  fm_int   port,
+                                  fm_int * physPort,
+                                  fm_int * epl,
+                                  fm_int * lane,
+                                  fm_bool *hasEpl,
+                                  fm_bool *validIpStats)
 {
-    fm_status                 err = FM_OK;
-    fm_switch *               switchPtr;
-    fm10000_switch *          switchExt;
-    fm_int                    physPort;
-    fm_int                    epl;
-    fm_int                    lane;
-    fm_bool                   hasEpl;
-    fm_uint32                 parserCfg     = 0;
-    fm_bool                   validIpStats = FALSE;
-    fm_uint32                 i;
-    fm_port *                 entry;
-    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
-    fm_int                    sgListCnt    = 0;
-    fm_timestamp              ts;
-    fm_bool                   stateLockTaken = FALSE;
-
-    /* Temporary bin array to retrieve 128bit port counters (frame + bytes). */
-    fm_uint32 cntRxPortStatsBank[FM10000_NB_RX_STATS_BANKS]
-                                [FM10000_BINS_PER_RX_STATS_BANK]
-                                [FM10000_WORDS_PER_RX_STATS_COUNTER];
-    
-    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
+    fm_status err;
+    fm_port * entry;
+    fm_uint32 parserCfg = 0;
 
-    switchPtr = GET_SWITCH_PTR(sw);
-    switchExt = GET_SWITCH_EXT(sw);
-    
     entry     = GET_PORT_PTR(sw, port);
-    physPort  = entry->physicalPort;
+    *physPort = entry->physicalPort;
 
-    err = fm10000MapPhysicalPortToEplLane(sw, physPort, &epl, &lane);
-    hasEpl = (err == FM_OK) ? TRUE : FALSE;
+    err = fm10000MapPhysicalPortToEplLane(sw, *physPort, epl, lane);
+    *hasEpl = (err == FM_OK) ? TRUE : FALSE;
 
     /* Some ports do not have an EPL */
     if (err == FM_ERR_INVALID_PORT)
     {
         err = FM_OK;
     }
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
-    
-    /* Fill the counters structure with 0 to assure all fields not explicitly
-     * set below, which will be the fields not supported by the FM10000,
-     * will be 0 on return. */
-    FM_MEMSET_S( (void *) counters, sizeof(*counters), 0, sizeof(*counters) );
-
-    /**************************************************
-     * Setting the counters version
-     **************************************************/
-    counters->cntVersion = FM10000_STATS_VERSION;
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PORT, err);
 
-    /* Determine if L3 headers are being parsed and set the valid IP
-     * stats version bit if so. */
+    /* Determine if L3 headers are being parsed. */
     err = fm10000GetPortAttribute(sw,
                                   port,
                                   FM_PORT_ACTIVE_MAC,
                                   FM_PORT_LANE_NA,
                                   FM_PORT_PARSER,
                                   (void *) &parserCfg);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PORT, err);
 
-    if (parserCfg >= FM_PORT_PARSER_STOP_AFTER_L3)
-    {
-        counters->cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
-        validIpStats = TRUE;
-    }
+    *validIpStats = (parserCfg >= FM_PORT_PARSER_STOP_AFTER_L3) ? TRUE : FALSE;
+
+    return FM_OK;
+
+}   /* end GetPortStatsInfo */
+
+
+
+
+/*****************************************************************************/
+/** AddPortCounterReads
+ * \ingroup intStats
+ *
+ * \desc            Adds the reads of all hardware counters of a port to
+ *                  a scatter-gather list.
+ *
+ * \param[in]       physPort is the physical port whose counters are read.
+ *
+ * \param[in]       epl is the EPL of the port.
+ *
+ * \param[in]       lane is the EPL lane of the port.
+ *
+ * \param[in]       hasEpl is TRUE if the port has an EPL.
+ *
+ * \param[out]      counters points to the structure in which the TX, CM
+ *                  and EPL counters will be read.
+ *
+ * \param[out]      cntRxPortStatsBank is the array in which the 128bit RX
+ *                  bank bins will be read. See ''UpdateRxPortCounters''.
+ *
+ * \param[out]      sgList points to the scatter-gather array to fill in.
+ *                  Must have room for MAX_STATS_SGLIST entries.
+ *
+ * \return          The number of entries added to sgList.
+ *
+ *****************************************************************************/
+static fm_int AddPortCounterReads(fm_int                     physPort,
+                                  fm_int                     epl,
+                                  fm_int                     lane,
+                                  fm_bool                    hasEpl,
+                                  fm_portCounters *          counters,
+                                  fm_uint32                  cntRxPortStatsBank[]
+                                                             [FM10000_BINS_PER_RX_STATS_BANK]
+                                                             [FM10000_WORDS_PER_RX_STATS_COUNTER],
+                                  fm_scatterGatherListEntry *sgList)
+{
+    fm_int    sgListCnt = 0;
+    fm_uint32 i;
 
     /**************************************************
      * Reading counters for each RX bank
@@ -813,7 +808,7 @@ fm_status fm10000GetPortCounters(fm_int           sw,
 
     if (hasEpl)
     {
-        /* EPL Counters */
+        /* EPL Counters, keep in sync with eplPortCntOffsetTable */
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_OVERSIZE_COUNTER,   cntRxOversizedPkts);
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_JABBER_COUNTER,     cntRxJabberPkts);
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_UNDERSIZE_COUNTER,  cntRxUndersizedPkts);
@@ -822,35 +817,45 @@ fm_status fm10000GetPortCounters(fm_int           sw,
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_UNDERRUN_COUNTER,   cntUnderrunPkts);
         FM10000_GET_EPL_PORT_STAT_32(FM10000_MAC_CODE_ERROR_COUNTER, cntCodeErrors);
     }
-    
-    /***************************************************
-     * 4. Execute scatter gather read.
-     **************************************************/
+
     if (sgListCnt >= MAX_STATS_SGLIST)
     {
         /* Pretty static. Mainly to warn if something new added, 
          * but the array size is not adjust accordingly */
         FM_LOG_FATAL(FM_LOG_CAT_PORT,
-                     "fm4000GetPortCounters: Scatter list array %d overflow.\n", 
+                     "Scatter list array %d overflow.\n", 
                      sgListCnt);
     }
 
-    /* Taking lock to protect temporary structures used to
-     * store 128b counters */
-    FM_FLAG_TAKE_STATE_LOCK(sw);
+    return sgListCnt;
 
-    /* now get the stats in one shot, optimized for fibm */
-    err = fmReadScatterGather(sw, sgListCnt, sgList);
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+}   /* end AddPortCounterReads */
 
-    err = fmGetTime(&ts);
-    counters->timestamp = ts.sec * 1000000 + ts.usec;   
-    
-    /***************************************************
-     * 5. Retrieve the frame/byte counts from 128bit 
-     *    registers stored in temporary array and set
-     *    the proper fm_portCounter structure members.
-     **************************************************/
+
+
+
+/*****************************************************************************/
+/** UpdateRxPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Retrieves the frame/byte counts from the 128bit RX bank
+ *                  bins read by ''AddPortCounterReads'' and sets the
+ *                  corresponding port counters.
+ *
+ * \param[out]      counters points to the port counters to update.
+ *
+ * \param[in]       cntRxPortStatsBank is the array holding the RX bank
+ *                  bins.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void UpdateRxPortCounters(fm_portCounters *counters,
+                                 fm_uint32        cntRxPortStatsBank[]
+                                                  [FM10000_BINS_PER_RX_STATS_BANK]
+                                                  [FM10000_WORDS_PER_RX_STATS_COUNTER])
+{
+    fm_uint32 i;
 
     for (i = 0; i < FM_NENTRIES(rxPortCntMapTable); i++)
     {
@@ -859,15 +864,30 @@ fm_status fm10000GetPortCounters(fm_int           sw,
                                      rxPortCntMapTable[i].frameOffset,
                                      rxPortCntMapTable[i].byteOffset);
     }
-    
-    FM_FLAG_DROP_STATE_LOCK(sw);
 
-    /***************************************************
-     * 6. Set some counters that are not available 
-     *    in HW but can be computed from two or more
-     *    HW counters.
-     **************************************************/
+}   /* end UpdateRxPortCounters */
+
+
 
+
+/*****************************************************************************/
+/** ComputeSoftwareCounters
+ * \ingroup intStats
+ *
+ * \desc            Sets the counters that are not available in HW but can
+ *                  be computed from two or more HW counters.
+ *
+ * \param[in,out]   counters points to the port counters to update. The
+ *                  software counters must be 0 on entry.
+ *
+ * \param[in]       validIpStats is TRUE if the port is parsing L3 headers.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ComputeSoftwareCounters(fm_portCounters *counters,
+                                    fm_bool          validIpStats)
+{
     /* If IP parsing is enabled then the IP stats will be read and will be
      * valid. Else all traffic, whether IP or not, is counted as NonIP. */
     if (validIpStats)
@@ -942,96 +962,608 @@ fm_status fm10000GetPortCounters(fm_int           sw,
     counters->cntTxOctets += counters->cntTx8192to10239octets;
     counters->cntTxOctets += counters->cntTx10240toMaxOctets;
 
-ABORT:
-    if (stateLockTaken)
-    {
-        FM_FLAG_DROP_STATE_LOCK(sw);
-    }
-
-    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
-
-}   /* end fm10000GetPortCounters */
+}   /* end ComputeSoftwareCounters */
 
 
 
 
 /*****************************************************************************/
-/** fm10000ResetPortCounters
+/** AccumulatePortCounters
  * \ingroup intStats
  *
- * \desc            Reset port statistics.
+ * \desc            Adds to the 64-bit totals of a port the counts read by
+ *                  the current sweep since the previous one. Hardware
+ *                  counters narrower than 64 bits are allowed to wrap
+ *                  once between two sweeps.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in,out]   state points to the collector state of the port.
  *
- * \param[in]       port is the port for which to reset statistics.
+ * \return          None.
  *
- * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_INVALID_PORT if port is invalid.
- * 
  *****************************************************************************/
-fm_status fm10000ResetPortCounters(fm_int sw,
-                                   fm_int port)
+static void AccumulatePortCounters(fm10000_portStatsState *state)
 {
-    fm_status                 err = FM_OK;
-    fm_status                 err2;
-    fm_switch *               switchPtr;
-    fm_port *                 entry;
-    fm_uint64                 resetValue64 = 0;
-    fm_uint32                 resetValue128[4] = { 0, 0, 0, 0 };
-    fm_int                    physPort;
-    fm_int                    epl;
-    fm_int                    lane;
-    fm_bool                   hasEpl;
-    fm_bool                   stateLockTaken = FALSE;
-    fm_uint32                 i;
-    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
-    fm_int                    sgListCnt    = 0;
-
-    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
-
-    switchPtr = GET_SWITCH_PTR(sw);
-    
-    entry     = switchPtr->portTable[port];
-    physPort  = entry->physicalPort;
+    fm_uint32 i;
 
-    err = fm10000MapPhysicalPortToEplLane(sw, physPort, &epl, &lane);
-    hasEpl = (err == FM_OK) ? TRUE : FALSE;
+    for (i = 0; i < FM_NENTRIES(rxPortCntMapTable); i++)
+    {
+        FM10000_ACCUMULATE_PORT_STAT(state,
+                                     rxPortCntMapTable[i].frameOffset,
+                                     fm_uint64);
+        FM10000_ACCUMULATE_PORT_STAT(state,
+                                     rxPortCntMapTable[i].byteOffset,
+                                     fm_uint64);
+    }
 
-    /* Some ports do not have an EPL */
-    if (err == FM_ERR_INVALID_PORT)
+    for (i = 0; i < FM_NENTRIES(txPortCntMapTable); i++)
     {
-        err = FM_OK;
+        FM10000_ACCUMULATE_PORT_STAT(state,
+                                     txPortCntMapTable[i].frameOffset,
+                                     fm_uint64);
+        FM10000_ACCUMULATE_PORT_STAT(state,
+                                     txPortCntMapTable[i].byteOffset,
+                                     fm_uint64);
     }
-    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
 
-    /************************************************ 
-     * 1. Add all counters to be reset to the scatter
-     *    gather list
-     ***********************************************/
+    FM10000_ACCUMULATE_PORT_STAT(state,
+                                 offsetof(fm_portCounters, cntTxCMDropPkts),
+                                 fm_uint64);
 
-    /* Reset all RX counters for the given port */
-    for (i = 0; i < FM_NENTRIES(rxPortCntMapTable); i++)
+    for (i = 0; i < FM_NENTRIES(eplPortCntOffsetTable); i++)
     {
-        sgList[sgListCnt].addr = 
-            FM10000_RX_STATS_BANK(rxPortCntMapTable[i].bank,
-                                  (physPort << 4 | rxPortCntMapTable[i].bin),
-                                  0);
-        sgList[sgListCnt].count = 4;
-        sgList[sgListCnt].data = resetValue128;
-        sgListCnt++;
+        FM10000_ACCUMULATE_PORT_STAT(state,
+                                     eplPortCntOffsetTable[i],
+                                     fm_uint32);
     }
 
-    /* Reset all TX counters for the given port */
-    for (i = 0; i < FM_NENTRIES(txPortCntMapTable); i++)
-    {
-        sgList[sgListCnt].addr = 
-            FM10000_MOD_STATS_BANK_FRAME(txPortCntMapTable[i].bank,
-                                  (physPort << 4 | txPortCntMapTable[i].bin),
-                                  0);
-        sgList[sgListCnt].count = 2;
-        sgList[sgListCnt].data = (fm_uint32 *)&resetValue64;
-        sgListCnt++;
+    state->lastRead = state->hwRead;
+
+}   /* end AccumulatePortCounters */
+
+
+
+
+/*****************************************************************************/
+/** PerSecond
+ * \ingroup intStats
+ *
+ * \desc            Converts a count over an interval to a count per second,
+ *                  without overflowing for long intervals.
+ *
+ * \param[in]       count is the count over the interval.
+ *
+ * \param[in]       interval is the length of the interval in microseconds.
+ *                  Must not be 0.
+ *
+ * \return          The count per second.
+ *
+ *****************************************************************************/
+static fm_uint64 PerSecond(fm_uint64 count, fm_uint64 interval)
+{
+    return (count / interval) * 1000000 +
+           ( (count % interval) * 1000000 ) / interval;
+
+}   /* end PerSecond */
+
+
+
+
+/*****************************************************************************/
+/** ComputePortRates
+ * \ingroup intStats
+ *
+ * \desc            Derives the frame and bit rates of a port from two
+ *                  consecutive snapshots of its counters.
+ *
+ * \param[in]       prev points to the previously published snapshot of the
+ *                  port, or NULL if there is none.
+ *
+ * \param[in,out]   cur points to the snapshot being built, whose counters
+ *                  have been filled in.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ComputePortRates(fm10000_portStatsSnapshot *prev,
+                             fm10000_portStatsSnapshot *cur)
+{
+    fm_portCounters *p;
+    fm_portCounters *c;
+    fm_uint64        interval;
+    fm_uint64        prevCount;
+    fm_uint64        curCount;
+
+    FM_CLEAR(cur->rates);
+    cur->rates.timestamp = cur->counters.timestamp;
+
+    /* Rates are not available across a counter reset */
+    if (prev == NULL || prev->resetCount != cur->resetCount)
+    {
+        return;
+    }
+
+    p = &prev->counters;
+    c = &cur->counters;
+
+    if (c->timestamp <= p->timestamp)
+    {
+        return;
+    }
+
+    interval = c->timestamp - p->timestamp;
+
+    /* The software RX counters depend on the parser configuration, so
+     * they may decrease if it changed between the two sweeps. */
+    prevCount = p->cntRxUcstPkts + p->cntRxMcstPkts + p->cntRxBcstPkts;
+    curCount  = c->cntRxUcstPkts + c->cntRxMcstPkts + c->cntRxBcstPkts;
+
+    if (curCount > prevCount)
+    {
+        cur->rates.rxFramesPerSec = PerSecond(curCount - prevCount, interval);
+    }
+
+    if (c->cntRxGoodOctets > p->cntRxGoodOctets)
+    {
+        cur->rates.rxBitsPerSec =
+            PerSecond( (c->cntRxGoodOctets - p->cntRxGoodOctets) * 8,
+                       interval );
+    }
+
+    prevCount = p->cntTxUcstPkts + p->cntTxMcstPkts + p->cntTxBcstPkts;
+    curCount  = c->cntTxUcstPkts + c->cntTxMcstPkts + c->cntTxBcstPkts;
+
+    cur->rates.txFramesPerSec = PerSecond(curCount - prevCount, interval);
+    cur->rates.txBitsPerSec   =
+        PerSecond( (c->cntTxOctets - p->cntTxOctets) * 8, interval );
+
+    cur->rates.interval = interval;
+
+}   /* end ComputePortRates */
+
+
+
+
+/*****************************************************************************/
+/** GetCollectedPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Copies the counters of a port from the snapshot last
+ *                  published by the statistics collector.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port for which to retrieve
+ *                  statistics.
+ *
+ * \param[out]      counters points to caller-allocated storage where this
+ *                  function should place the port counters. May be NULL.
+ *
+ * \param[out]      rates points to caller-allocated storage where this
+ *                  function should place the port rates. May be NULL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the snapshot does not hold the
+ *                  current counters of the port: no sweep has completed
+ *                  yet, port is not a cardinal port, or its counters were
+ *                  reset after the last sweep.
+ *
+ *****************************************************************************/
+static fm_status GetCollectedPortCounters(fm_int               sw,
+                                          fm_int               port,
+                                          fm_portCounters *    counters,
+                                          fm_portCounterRates *rates)
+{
+    fm10000_statsCollector *   collector;
+    fm10000_portStatsSnapshot *entry;
+    fm_status                  err;
+    fm_int                     cpi;
+
+    collector = ((fm10000_switch *) GET_SWITCH_EXT(sw))->statsCollector;
+
+    if ( !fmIsCardinalPort(sw, port) )
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    cpi = GET_PORT_INDEX(sw, port);
+    err = FM_ERR_NOT_FOUND;
+
+    fmCaptureLock(&collector->snapshotLock, FM_WAIT_FOREVER);
+
+    if (collector->published >= 0)
+    {
+        entry = &collector->snapshot[collector->published][cpi];
+
+        if (entry->resetCount == collector->ports[cpi].resetCount)
+        {
+            if (counters != NULL)
+            {
+                *counters = entry->counters;
+            }
+
+            if (rates != NULL)
+            {
+                *rates = entry->rates;
+            }
+
+            err = FM_OK;
+        }
+    }
+
+    fmReleaseLock(&collector->snapshotLock);
+
+    return err;
+
+}   /* end GetCollectedPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** CreateStatsCollector
+ * \ingroup intStats
+ *
+ * \desc            Allocates and initializes the statistics collector
+ *                  state of a switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ *
+ *****************************************************************************/
+static fm_status CreateStatsCollector(fm_int sw)
+{
+    fm_status               err;
+    fm_switch *             switchPtr;
+    fm10000_switch *        switchExt;
+    fm10000_statsCollector *collector;
+    fm_int                  numPorts;
+    fm_int                  cpi;
+    fm_int                  i;
+    fm_uint                 nbytes;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    switchExt = GET_SWITCH_EXT(sw);
+    numPorts  = switchPtr->numCardinalPorts;
+
+    collector = fmAlloc( sizeof(fm10000_statsCollector) );
+    if (collector == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_NO_MEM);
+    }
+
+    FM_CLEAR(*collector);
+    collector->numPorts  = numPorts;
+    collector->published = -1;
+
+    /* Freed by fm10000FreeCounters on failure */
+    switchExt->statsCollector = collector;
+
+    err = fmCreateLockV2("StatsCollectorLock",
+                         sw,
+                         FM_LOCK_PREC_STATS,
+                         &collector->lock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    err = fmCreateLock("StatsSnapshotLock", &collector->snapshotLock);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+
+    nbytes = numPorts * sizeof(fm10000_portStatsState);
+    collector->ports = fmAlloc(nbytes);
+    if (collector->ports == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_NO_MEM);
+    }
+    FM_MEMSET_S(collector->ports, nbytes, 0, nbytes);
+
+    nbytes = numPorts * sizeof(fm10000_portStatsSnapshot);
+    for (i = 0 ; i < 2 ; i++)
+    {
+        collector->snapshot[i] = fmAlloc(nbytes);
+        if (collector->snapshot[i] == NULL)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_NO_MEM);
+        }
+        FM_MEMSET_S(collector->snapshot[i], nbytes, 0, nbytes);
+    }
+
+    collector->sgListSize = numPorts * MAX_STATS_SGLIST;
+    nbytes = collector->sgListSize * sizeof(fm_scatterGatherListEntry);
+    collector->sgList = fmAlloc(nbytes);
+    if (collector->sgList == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_ERR_NO_MEM);
+    }
+
+    for (cpi = 0 ; cpi < numPorts ; cpi++)
+    {
+        err = fmMapCardinalPortInternal(switchPtr,
+                                        cpi,
+                                        &collector->ports[cpi].logPort,
+                                        &collector->ports[cpi].physPort);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+
+}   /* end CreateStatsCollector */
+
+
+ /*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+
+/*****************************************************************************/
+/** fm10000SetStatsFrameAdjustment
+ * \ingroup intStats
+ *
+ * \desc            Sets the RX priority select for bank 3.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       physPort is the physical port for which to retrieve
+ *                  statistics.
+ * 
+ * \param[in]       nbBytes is the number of bytes that should be substracted
+ *                  from the received packet length for the specified port.
+ * 
+ * \return          FM_OK if successful.
+ * 
+ *****************************************************************************/
+fm_status fm10000SetStatsFrameAdjustment(fm_int sw,
+                                         fm_int physPort,
+                                         fm_int nbBytes)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+    fm_uint32  rxStatCfg;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, 
+                 "sw=%d physPort=%d, nbBytes=%d\n", 
+                 sw, 
+                 physPort,
+                 nbBytes);
+    
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    TAKE_REG_LOCK(sw)
+
+    /* Retrieve existing values */
+    err = switchPtr->ReadUINT32(sw, FM10000_RX_STATS_CFG(physPort), &rxStatCfg);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    /* Apply */
+    FM_SET_FIELD(rxStatCfg, FM10000_RX_STATS_CFG, PerFrameAdjustment, nbBytes);
+
+    err = switchPtr->WriteUINT32(sw, FM10000_RX_STATS_CFG(physPort), rxStatCfg);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+ABORT:
+    DROP_REG_LOCK(sw)
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* End fm10000SetStatsFrameAdjustment */
+
+
+/*****************************************************************************/
+/** fm10000GetPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Retrieve port statistics. When the statistics collector
+ *                  is enabled, returns the counters from its last sweep
+ *                  without accessing the hardware.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port for which to retrieve statistics.
+ *
+ * \param[out]      counters is a pointer to an fm_portCounters structure to be
+ *                  filled in by this function.
+ *                  If the requested port is parsing L3 headers then version
+ *                  will be FM10000_STATS_VERSION | FM_VALID_IP_STATS_VERSION.
+ *                  Otherwise the version will be FM10000_STATS_VERSION.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if port is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if counters is NULL.
+ *****************************************************************************/
+fm_status fm10000GetPortCounters(fm_int           sw,
+                                 fm_int           port,
+                                 fm_portCounters *counters)
+{
+    fm_status                 err = FM_OK;
+    fm10000_switch *          switchExt;
+    fm_int                    physPort;
+    fm_int                    epl;
+    fm_int                    lane;
+    fm_bool                   hasEpl;
+    fm_bool                   validIpStats;
+    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
+    fm_int                    sgListCnt;
+    fm_timestamp              ts;
+    fm_bool                   stateLockTaken = FALSE;
+
+    /* Temporary bin array to retrieve 128bit port counters (frame + bytes). */
+    fm_uint32 cntRxPortStatsBank[FM10000_NB_RX_STATS_BANKS]
+                                [FM10000_BINS_PER_RX_STATS_BANK]
+                                [FM10000_WORDS_PER_RX_STATS_COUNTER];
+    
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
+
+    switchExt = GET_SWITCH_EXT(sw);
+
+    /* When the statistics collector is running, return the counters it
+     * last collected rather than accessing the hardware. */
+    if (switchExt->statsCollector != NULL)
+    {
+        err = GetCollectedPortCounters(sw, port, counters, NULL);
+
+        if (err != FM_ERR_NOT_FOUND)
+        {
+            FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+        }
+    }
+    
+    err = GetPortStatsInfo(sw,
+                           port,
+                           &physPort,
+                           &epl,
+                           &lane,
+                           &hasEpl,
+                           &validIpStats);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    
+    /* Fill the counters structure with 0 to assure all fields not explicitly
+     * set below, which will be the fields not supported by the FM10000,
+     * will be 0 on return. */
+    FM_MEMSET_S( (void *) counters, sizeof(*counters), 0, sizeof(*counters) );
+
+    /**************************************************
+     * Setting the counters version
+     **************************************************/
+    counters->cntVersion = FM10000_STATS_VERSION;
+
+    /* Set the valid IP stats version bit if L3 headers are being parsed. */
+    if (validIpStats)
+    {
+        counters->cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
+    }
+
+    /**************************************************
+     * Fill in the scatter gather list with the RX
+     * bank bins, and the TX, CM and EPL counters.
+     **************************************************/
+    sgListCnt = AddPortCounterReads(physPort,
+                                    epl,
+                                    lane,
+                                    hasEpl,
+                                    counters,
+                                    cntRxPortStatsBank,
+                                    sgList);
+
+    /* Taking lock to protect temporary structures used to
+     * store 128b counters */
+    FM_FLAG_TAKE_STATE_LOCK(sw);
+
+    /* now get the stats in one shot, optimized for fibm */
+    err = fmReadScatterGather(sw, sgListCnt, sgList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    err = fmGetTime(&ts);
+    counters->timestamp = ts.sec * 1000000 + ts.usec;   
+    
+    /***************************************************
+     * Retrieve the frame/byte counts from 128bit 
+     * registers stored in temporary array and set
+     * the proper fm_portCounter structure members.
+     **************************************************/
+    UpdateRxPortCounters(counters, cntRxPortStatsBank);
+    
+    FM_FLAG_DROP_STATE_LOCK(sw);
+
+    ComputeSoftwareCounters(counters, validIpStats);
+
+ABORT:
+    if (stateLockTaken)
+    {
+        FM_FLAG_DROP_STATE_LOCK(sw);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000GetPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000ResetPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Reset port statistics.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port for which to reset statistics.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if port is invalid.
+ * 
+ *****************************************************************************/
+fm_status fm10000ResetPortCounters(fm_int sw,
+                                   fm_int port)
+{
+    fm_status                 err = FM_OK;
+    fm_status                 err2;
+    fm_switch *               switchPtr;
+    fm_port *                 entry;
+    fm_uint64                 resetValue64 = 0;
+    fm_uint32                 resetValue128[4] = { 0, 0, 0, 0 };
+    fm_int                    physPort;
+    fm_int                    epl;
+    fm_int                    lane;
+    fm_bool                   hasEpl;
+    fm_bool                   stateLockTaken = FALSE;
+    fm_uint32                 i;
+    fm_scatterGatherListEntry sgList[MAX_STATS_SGLIST];
+    fm_int                    sgListCnt    = 0;
+    fm10000_statsCollector *  collector;
+    fm10000_portStatsState *  state;
+    fm_bool                   collectorLockTaken = FALSE;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    collector = ((fm10000_switch *) switchPtr->extension)->statsCollector;
+    
+    entry     = switchPtr->portTable[port];
+    physPort  = entry->physicalPort;
+
+    err = fm10000MapPhysicalPortToEplLane(sw, physPort, &epl, &lane);
+    hasEpl = (err == FM_OK) ? TRUE : FALSE;
+
+    /* Some ports do not have an EPL */
+    if (err == FM_ERR_INVALID_PORT)
+    {
+        err = FM_OK;
+    }
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    /************************************************ 
+     * 1. Add all counters to be reset to the scatter
+     *    gather list
+     ***********************************************/
+
+    /* Reset all RX counters for the given port */
+    for (i = 0; i < FM_NENTRIES(rxPortCntMapTable); i++)
+    {
+        sgList[sgListCnt].addr = 
+            FM10000_RX_STATS_BANK(rxPortCntMapTable[i].bank,
+                                  (physPort << 4 | rxPortCntMapTable[i].bin),
+                                  0);
+        sgList[sgListCnt].count = 4;
+        sgList[sgListCnt].data = resetValue128;
+        sgListCnt++;
+    }
+
+    /* Reset all TX counters for the given port */
+    for (i = 0; i < FM_NENTRIES(txPortCntMapTable); i++)
+    {
+        sgList[sgListCnt].addr = 
+            FM10000_MOD_STATS_BANK_FRAME(txPortCntMapTable[i].bank,
+                                  (physPort << 4 | txPortCntMapTable[i].bin),
+                                  0);
+        sgList[sgListCnt].count = 2;
+        sgList[sgListCnt].data = (fm_uint32 *)&resetValue64;
+        sgListCnt++;
 
         sgList[sgListCnt].addr = 
             FM10000_MOD_STATS_BANK_BYTE(txPortCntMapTable[i].bank,
@@ -1075,6 +1607,14 @@ fm_status fm10000ResetPortCounters(fm_int sw,
      *    this process. Execute Scatter Gather Write
      ***********************************************/
 
+    /* Keep the statistics collector from sweeping the counters until
+     * its accumulated values have been reset as well. */
+    if (collector != NULL)
+    {
+        fmCaptureLock(&collector->lock, FM_WAIT_FOREVER);
+        collectorLockTaken = TRUE;
+    }
+
     FM_FLAG_TAKE_STATE_LOCK(sw);
 
     /* For atomic reset, we disable the banks before reseting */
@@ -1089,6 +1629,19 @@ fm_status fm10000ResetPortCounters(fm_int sw,
     err = fmWriteScatterGather(sw, sgListCnt, sgList);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
 
+    if ( collectorLockTaken && fmIsCardinalPort(sw, port) )
+    {
+        state = &collector->ports[GET_PORT_INDEX(sw, port)];
+
+        FM_CLEAR(state->lastRead);
+        FM_CLEAR(state->total);
+
+        /* Stop serving the published snapshot of the port */
+        fmCaptureLock(&collector->snapshotLock, FM_WAIT_FOREVER);
+        state->resetCount++;
+        fmReleaseLock(&collector->snapshotLock);
+    }
+
 ABORT:
     if (stateLockTaken == TRUE)
     {
@@ -1114,6 +1667,11 @@ ABORT:
         FM_FLAG_DROP_STATE_LOCK(sw);
     }
 
+    if (collectorLockTaken)
+    {
+        fmReleaseLock(&collector->lock);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
 
 }   /* end fm10000ResetPortCounters */
@@ -1121,6 +1679,217 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000CollectPortCounters
+ * \ingroup intStats
+ *
+ * \desc            Sweeps the counters of all cardinal ports, accumulates
+ *                  them on 64 bits and publishes a new snapshot of the
+ *                  counters and rates. Called by the statistics collector
+ *                  thread through the CollectPortCounters function
+ *                  pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000CollectPortCounters(fm_int sw)
+{
+    fm_status                  err = FM_OK;
+    fm10000_statsCollector *   collector;
+    fm10000_portStatsState *   state;
+    fm10000_portStatsSnapshot *prev;
+    fm10000_portStatsSnapshot *cur;
+    fm_timestamp               start;
+    fm_timestamp               end;
+    fm_uint64                  sweepTime;
+    fm_int                     cpi;
+    fm_int                     epl;
+    fm_int                     lane;
+    fm_bool                    hasEpl;
+    fm_int                     sgListCnt;
+    fm_int                     nEntries;
+    fm_int                     next;
+    fm_int                     i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d\n", sw);
+
+    collector = ((fm10000_switch *) GET_SWITCH_EXT(sw))->statsCollector;
+
+    if (collector == NULL)
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_OK);
+    }
+
+    fmCaptureLock(&collector->lock, FM_WAIT_FOREVER);
+
+    /**************************************************
+     * 1. Build a single scatter gather list covering
+     *    the counters of all ports.
+     **************************************************/
+    sgListCnt = 0;
+
+    for (cpi = 0 ; cpi < collector->numPorts ; cpi++)
+    {
+        state = &collector->ports[cpi];
+
+        err = GetPortStatsInfo(sw,
+                               state->logPort,
+                               &state->physPort,
+                               &epl,
+                               &lane,
+                               &hasEpl,
+                               &state->validIpStats);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+        sgListCnt += AddPortCounterReads(state->physPort,
+                                         epl,
+                                         lane,
+                                         hasEpl,
+                                         &state->hwRead,
+                                         state->rxBank,
+                                         &collector->sgList[sgListCnt]);
+    }
+
+    /**************************************************
+     * 2. Execute it, in chunks so that other register
+     *    accesses are not held off for the whole sweep.
+     **************************************************/
+    err = fmGetTime(&start);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    for (i = 0 ; i < sgListCnt ; i += nEntries)
+    {
+        nEntries = sgListCnt - i;
+
+        if (nEntries > FM10000_STATS_SWEEP_SGLIST_CHUNK)
+        {
+            nEntries = FM10000_STATS_SWEEP_SGLIST_CHUNK;
+        }
+
+        err = fmReadScatterGather(sw, nEntries, &collector->sgList[i]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    err = fmGetTime(&end);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+
+    /**************************************************
+     * 3. Accumulate the counts and build the snapshot
+     *    that is not published. Readers only copy from
+     *    the published one.
+     **************************************************/
+    sweepTime = start.sec * 1000000 + start.usec;
+    next      = (collector->published == 0) ? 1 : 0;
+    prev      = (collector->published >= 0) ?
+                collector->snapshot[collector->published] : NULL;
+
+    for (cpi = 0 ; cpi < collector->numPorts ; cpi++)
+    {
+        state = &collector->ports[cpi];
+        cur   = &collector->snapshot[next][cpi];
+
+        UpdateRxPortCounters(&state->hwRead, state->rxBank);
+        AccumulatePortCounters(state);
+
+        cur->counters            = state->total;
+        cur->counters.cntVersion = FM10000_STATS_VERSION;
+        cur->counters.timestamp  = sweepTime;
+        cur->resetCount          = state->resetCount;
+
+        if (state->validIpStats)
+        {
+            cur->counters.cntVersion |= (fm_uint64)FM_VALID_IP_STATS_VERSION;
+        }
+
+        ComputeSoftwareCounters(&cur->counters, state->validIpStats);
+        ComputePortRates( (prev != NULL) ? &prev[cpi] : NULL, cur );
+    }
+
+    /**************************************************
+     * 4. Publish it.
+     **************************************************/
+    fmCaptureLock(&collector->snapshotLock, FM_WAIT_FOREVER);
+    collector->published = next;
+    fmReleaseLock(&collector->snapshotLock);
+
+    fmSubTimestamps(&end, &start, &end);
+    collector->lastSweepTime = end.sec * 1000000 + end.usec;
+    collector->numSweeps++;
+
+    FM_LOG_DEBUG(FM_LOG_CAT_PORT,
+                 "Swept %d ports (%d reads) in %llu usec\n",
+                 collector->numPorts,
+                 sgListCnt,
+                 collector->lastSweepTime);
+
+ABORT:
+    fmReleaseLock(&collector->lock);
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000CollectPortCounters */
+
+
+
+
+/*****************************************************************************/
+/** fm10000GetPortCounterRates
+ * \ingroup intStats
+ *
+ * \desc            Retrieves the rates of a port derived by the statistics
+ *                  collector. Called through the GetPortCounterRates
+ *                  function pointer.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the logical port for which to retrieve rates.
+ *
+ * \param[out]      rates points to an fm_portCounterRates structure to be
+ *                  filled in by this function. All fields are 0 if no
+ *                  sweep has completed since the port counters were last
+ *                  reset.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the statistics collector is not
+ *                  enabled.
+ * \return          FM_ERR_INVALID_PORT if port is not a cardinal port.
+ *
+ *****************************************************************************/
+fm_status fm10000GetPortCounterRates(fm_int               sw,
+                                     fm_int               port,
+                                     fm_portCounterRates *rates)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT, "sw=%d port=%d\n", sw, port);
+
+    if ( ((fm10000_switch *) GET_SWITCH_EXT(sw))->statsCollector == NULL )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_UNSUPPORTED);
+    }
+
+    if ( !fmIsCardinalPort(sw, port) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_PORT, FM_ERR_INVALID_PORT);
+    }
+
+    err = GetCollectedPortCounters(sw, port, NULL, rates);
+
+    if (err == FM_ERR_NOT_FOUND)
+    {
+        FM_CLEAR(*rates);
+        err = FM_OK;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_PORT, err);
+
+}   /* end fm10000GetPortCounterRates */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetVLANCounters
  * \ingroup intStats
@@ -1307,7 +2076,9 @@ ABORT:
 /** fm10000InitCounters
  * \ingroup intStats
  *
- * \desc            Initialize statistic counters
+ * \desc            Initialize statistic counters, and the statistics
+ *                  collector if the api.statsCollector.period property
+ *                  is non-zero.
  *
  * \param[in]       sw is the switch on which to operate.
  *
@@ -1345,6 +2116,12 @@ fm_status fm10000InitCounters(fm_int sw)
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
     }
 
+    if (GET_PROPERTY()->statsCollectorPer > 0)
+    {
+        err = CreateStatsCollector(sw);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
@@ -1353,6 +2130,69 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000FreeCounters
+ * \ingroup intStats
+ *
+ * \desc            Frees the resources allocated by fm10000InitCounters.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fm10000FreeCounters(fm_int sw)
+{
+    fm10000_switch *        switchExt;
+    fm10000_statsCollector *collector;
+    fm_int                  i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    switchExt = GET_SWITCH_EXT(sw);
+    collector = switchExt->statsCollector;
+
+    if (collector != NULL)
+    {
+        if (collector->lock.handle != NULL)
+        {
+            fmDeleteLock(&collector->lock);
+        }
+
+        if (collector->snapshotLock.handle != NULL)
+        {
+            fmDeleteLock(&collector->snapshotLock);
+        }
+
+        for (i = 0 ; i < 2 ; i++)
+        {
+            if (collector->snapshot[i] != NULL)
+            {
+                fmFree(collector->snapshot[i]);
+            }
+        }
+
+        if (collector->ports != NULL)
+        {
+            fmFree(collector->ports);
+        }
+
+        if (collector->sgList != NULL)
+        {
+            fmFree(collector->sgList);
+        }
+
+        fmFree(collector);
+        switchExt->statsCollector = NULL;
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_SWITCH, FM_OK);
+
+}   /* end fm10000FreeCounters */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetCountersInitMode
  * \ingroup intStats
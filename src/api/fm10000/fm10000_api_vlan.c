@@ -37,6 +37,27 @@
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Software state saved by fm10000SetVlanPortConfigList before changing it,
+ * so that a failure can be rolled back. */
+typedef struct _fm10000_vlanPortConfigUndo
+{
+    /* Member and tag masks of each VLAN, indexed by VLAN ID. Only valid
+     * for the VLANs set in the dirty VLAN bit array. */
+    fm_portmask *   member;
+    fm_portmask *   tag;
+
+    /* Spanning tree states of each instance, numCardinalPorts per
+     * instance. Only valid for the instances set in the dirty instance
+     * bit array. */
+    fm_int *        states;
+
+    /* LAG VLAN membership of each entry, saved before the entry was
+     * applied, for the first numLagEntries entries. */
+    fm_byte *       lagMembership;
+    fm_int          numLagEntries;
+
+} fm10000_vlanPortConfigUndo;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -134,6 +155,499 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** BuildVlanEntryRegs
+ * \ingroup intVlan
+ *
+ * \desc            Computes the INGRESS_VID_TABLE and EGRESS_VID_TABLE
+ *                  entries of a VLAN from the software tables.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vlanID is the VLAN number.
+ *
+ * \param[in]       stpInstance is the spanning-tree instance of the VLAN.
+ *
+ * \param[out]      ingressVals points to an array of
+ *                  FM10000_INGRESS_VID_TABLE_WIDTH words to fill in.
+ *
+ * \param[out]      egressVals points to an array of
+ *                  FM10000_EGRESS_VID_TABLE_WIDTH words to fill in.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the VLAN learning mode is invalid.
+ *
+ *****************************************************************************/
+static fm_status BuildVlanEntryRegs(fm_int     sw,
+                                    fm_uint16  vlanID,
+                                    fm_int     stpInstance,
+                                    fm_uint32 *ingressVals,
+                                    fm_uint32 *egressVals)
+{
+    fm_switch *        switchPtr;
+    fm_vlanEntry *     ventry;
+    fm10000_vlanEntry *ventryExt;
+    fm_int             fid;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    ventry    = GET_VLAN_PTR(sw, vlanID);
+    ventryExt = GET_VLAN_EXT(sw, vlanID);
+
+    switch (switchPtr->vlanLearningMode)
+    {
+        case FM_VLAN_LEARNING_MODE_INDEPENDENT:
+            fid = vlanID;
+            break;
+
+        case FM_VLAN_LEARNING_MODE_SHARED:
+            fid = switchPtr->sharedLearningVlan;
+            break;
+
+        default:
+            FM_LOG_FATAL(FM_LOG_CAT_VLAN,
+                         "Invalid vlan learning mode %d configured\n",
+                         switchPtr->vlanLearningMode);
+            return FM_ERR_UNSUPPORTED;
+    }
+
+    memset( ingressVals,
+            0,
+            FM10000_INGRESS_VID_TABLE_WIDTH * sizeof(fm_uint32) );
+    FM_ARRAY_SET_PORTMASK( ingressVals, FM10000_INGRESS_VID_TABLE, membership, &ventryExt->member);
+    FM_ARRAY_SET_FIELD(    ingressVals, FM10000_INGRESS_VID_TABLE, FID,        fid );
+    FM_ARRAY_SET_FIELD(    ingressVals, FM10000_INGRESS_VID_TABLE, MST_Index,  stpInstance );
+    FM_ARRAY_SET_FIELD(    ingressVals, FM10000_INGRESS_VID_TABLE, vcnt,       ventryExt->statIndex );
+    FM_ARRAY_SET_BIT(      ingressVals, FM10000_INGRESS_VID_TABLE, reflect,    ventry->reflect );
+    FM_ARRAY_SET_BIT(      ingressVals, FM10000_INGRESS_VID_TABLE, TrapIGMP,   ventry->trapIGMP );
+
+    /* set the EGRESS_VID_TABLE[].membership[] using
+     * EGRESS_FID_TABLE[].Forwarding[] & real VLAN membership to make sure that
+     * any packet that are being untrapped by the trigger do not bypass the
+     * egress STP state checks.
+     */
+    memset( egressVals,
+            0,
+            FM10000_EGRESS_VID_TABLE_WIDTH * sizeof(fm_uint32) );
+    FM_ARRAY_SET_PORTMASK( egressVals, FM10000_EGRESS_VID_TABLE, membership, &ventryExt->member);
+    FM_ARRAY_SET_FIELD(    egressVals, FM10000_EGRESS_VID_TABLE, FID,        fid );
+    FM_ARRAY_SET_FIELD(    egressVals, FM10000_EGRESS_VID_TABLE, MST_Index,  stpInstance );
+    FM_ARRAY_SET_FIELD(    egressVals, FM10000_EGRESS_VID_TABLE, MTU_Index,  ventryExt->mtuIndex );
+    FM_ARRAY_SET_FIELD(    egressVals, FM10000_EGRESS_VID_TABLE, TrigID,     ventryExt->trigger );
+
+    return FM_OK;
+
+}   /* end BuildVlanEntryRegs */
+
+
+
+
+/*****************************************************************************/
+/** BuildTagEntryRegs
+ * \ingroup intVlan
+ *
+ * \desc            Computes the MOD_VLAN_TAG_VID1_MAP entry of a VLAN from
+ *                  the software tables.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vlanID is the VLAN number.
+ *
+ * \param[out]      tagVals points to an array of
+ *                  FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH words to fill in.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void BuildTagEntryRegs(fm_int sw, fm_uint16 vlanID, fm_uint32 *tagVals)
+{
+    fm10000_vlanEntry *ventryExt;
+
+    ventryExt = GET_VLAN_EXT(sw, vlanID);
+
+    memset( tagVals,
+            0,
+            FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH * sizeof(fm_uint32) );
+
+    FM_ARRAY_SET_PORTMASK(tagVals,
+                          FM10000_MOD_VLAN_TAG_VID1_MAP,
+                          Tag,
+                          &ventryExt->tag);
+
+    FM_ARRAY_SET_FIELD(tagVals,
+                       FM10000_MOD_VLAN_TAG_VID1_MAP,
+                       VID,
+                       ventryExt->egressVid);
+
+}   /* end BuildTagEntryRegs */
+
+
+
+
+/*****************************************************************************/
+/** BuildVlanInstanceMap
+ * \ingroup intVlan
+ *
+ * \desc            Records the spanning-tree instance of every VLAN with a
+ *                  single walk of the instance tree, rather than one
+ *                  ''fmFindInstanceForVlan'' search per VLAN.
+ *
+ * \note            The caller must hold the L2 lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      vlanInstance points to an array of FM_MAX_VLAN entries
+ *                  to fill in. VLANs that belong to no instance are set
+ *                  to -1, as ''fmFindInstanceForVlan'' reports them.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status BuildVlanInstanceMap(fm_int sw, fm_int *vlanInstance)
+{
+    fm_status           err;
+    fm_treeIterator     treeIter;
+    fm_stpInstanceInfo *instanceInfo;
+    fm_uint64           key;
+    fm_int              vlanID;
+
+    for (vlanID = 0 ; vlanID < FM_MAX_VLAN ; vlanID++)
+    {
+        vlanInstance[vlanID] = -1;
+    }
+
+    fmTreeIterInit(&treeIter, GET_STP_INFO(sw));
+
+    while ( ( err = fmTreeIterNext(&treeIter,
+                                   &key,
+                                   (void **) &instanceInfo) ) == FM_OK )
+    {
+        err = fmFindBitInBitArray(&instanceInfo->vlans, 0, TRUE, &vlanID);
+
+        while (err == FM_OK && vlanID >= 0)
+        {
+            /* The first instance found wins, as in fmFindInstanceForVlan */
+            if (vlanInstance[vlanID] < 0)
+            {
+                vlanInstance[vlanID] = (fm_int) key;
+            }
+
+            err = fmFindBitInBitArray(&instanceInfo->vlans,
+                                      vlanID + 1,
+                                      TRUE,
+                                      &vlanID);
+        }
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    return (err == FM_ERR_NO_MORE) ? FM_OK : err;
+
+}   /* end BuildVlanInstanceMap */
+
+
+
+
+/*****************************************************************************/
+/** WriteVlanEntryList
+ * \ingroup intVlan
+ *
+ * \desc            Writes the INGRESS_VID_TABLE, EGRESS_VID_TABLE and
+ *                  MOD_VLAN_TAG_VID1_MAP entries of a set of VLANs to the
+ *                  hardware as a single register cache burst. Runs of
+ *                  consecutive VLANs are coalesced into one scatter-gather
+ *                  entry per table, and the register cache skips the
+ *                  entries whose contents did not change.
+ *
+ * \note            The caller must hold the L2 lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vlans points to a bit array of FM_MAX_VLAN bits in
+ *                  which the VLANs to write are set.
+ *
+ * \param[in]       vlanInstance points to the spanning-tree instance of
+ *                  every VLAN, as filled in by ''BuildVlanInstanceMap''.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status WriteVlanEntryList(fm_int       sw,
+                                    fm_bitArray *vlans,
+                                    fm_int *     vlanInstance)
+{
+    fm_status               err;
+    fm_registerSGListEntry *sgList;
+    fm_uint32 *             ingressVals;
+    fm_uint32 *             egressVals;
+    fm_uint32 *             tagVals;
+    fm_int                  numVlans;
+    fm_int                  numSgEntries;
+    fm_int                  row;
+    fm_int                  vlanID;
+    fm_int                  prevVlanID;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN, "sw=%d\n", sw);
+
+    sgList      = NULL;
+    ingressVals = NULL;
+    egressVals  = NULL;
+    tagVals     = NULL;
+
+    err = fmGetBitArrayNonZeroBitCount(vlans, &numVlans);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    if (numVlans == 0)
+    {
+        goto ABORT;
+    }
+
+    /* Worst case, no two VLANs are consecutive and each needs its own
+     * entry in all three tables. */
+    sgList      = fmAlloc( 3 * numVlans * sizeof(fm_registerSGListEntry) );
+    ingressVals = fmAlloc( numVlans * FM10000_INGRESS_VID_TABLE_WIDTH *
+                           sizeof(fm_uint32) );
+    egressVals  = fmAlloc( numVlans * FM10000_EGRESS_VID_TABLE_WIDTH *
+                           sizeof(fm_uint32) );
+    tagVals     = fmAlloc( numVlans * FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH *
+                           sizeof(fm_uint32) );
+
+    if ( sgList == NULL || ingressVals == NULL ||
+         egressVals == NULL || tagVals == NULL )
+    {
+        err = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    numSgEntries = 0;
+    prevVlanID   = -2;
+    row          = 0;
+
+    err = fmFindBitInBitArray(vlans, 0, TRUE, &vlanID);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    while (vlanID >= 0)
+    {
+        err = BuildVlanEntryRegs(sw,
+                                 (fm_uint16) vlanID,
+                                 vlanInstance[vlanID],
+                                 &ingressVals[row * FM10000_INGRESS_VID_TABLE_WIDTH],
+                                 &egressVals[row * FM10000_EGRESS_VID_TABLE_WIDTH]);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+        BuildTagEntryRegs(sw,
+                          (fm_uint16) vlanID,
+                          &tagVals[row * FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH]);
+
+        if (vlanID == prevVlanID + 1)
+        {
+            /* Extend the current run in each of the three tables. */
+            sgList[numSgEntries - 3].count++;
+            sgList[numSgEntries - 2].count++;
+            sgList[numSgEntries - 1].count++;
+        }
+        else
+        {
+            FM_REGS_CACHE_FILL_SGLIST(&sgList[numSgEntries],
+                                      &fm10000CacheIngressVidTable,
+                                      1,
+                                      vlanID,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      &ingressVals[row * FM10000_INGRESS_VID_TABLE_WIDTH],
+                                      FALSE);
+            numSgEntries++;
+
+            FM_REGS_CACHE_FILL_SGLIST(&sgList[numSgEntries],
+                                      &fm10000CacheEgressVidTable,
+                                      1,
+                                      vlanID,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      &egressVals[row * FM10000_EGRESS_VID_TABLE_WIDTH],
+                                      FALSE);
+            numSgEntries++;
+
+            FM_REGS_CACHE_FILL_SGLIST(&sgList[numSgEntries],
+                                      &fm10000CacheModVlanTagVid1Map,
+                                      1,
+                                      vlanID,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      FM_REGS_CACHE_INDEX_UNUSED,
+                                      &tagVals[row * FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH],
+                                      FALSE);
+            numSgEntries++;
+        }
+
+        prevVlanID = vlanID;
+        row++;
+
+        err = fmFindBitInBitArray(vlans, vlanID + 1, TRUE, &vlanID);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    FM_LOG_DEBUG(FM_LOG_CAT_VLAN,
+                 "Writing %d VLAN entries in %d scatter-gather entries\n",
+                 numVlans,
+                 numSgEntries);
+
+    err = fmRegCacheWrite(sw, numSgEntries, sgList, TRUE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+ABORT:
+
+    if (sgList != NULL)
+    {
+        fmFree(sgList);
+    }
+
+    if (ingressVals != NULL)
+    {
+        fmFree(ingressVals);
+    }
+
+    if (egressVals != NULL)
+    {
+        fmFree(egressVals);
+    }
+
+    if (tagVals != NULL)
+    {
+        fmFree(tagVals);
+    }
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, err);
+
+}   /* end WriteVlanEntryList */
+
+
+
+
+/*****************************************************************************/
+/** UndoVlanPortConfigList
+ * \ingroup intVlan
+ *
+ * \desc            Rolls back a failed ''fm10000SetVlanPortConfigList'':
+ *                  restores the VLAN masks, spanning tree states and LAG
+ *                  VLAN membership it saved, then rewrites the hardware
+ *                  from them if it may already have been written.
+ *
+ * \note            The caller must hold the LAG and L2 locks.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       configList points to the entries being applied.
+ *
+ * \param[in]       undo points to the saved software state.
+ *
+ * \param[in]       dirtyVlans points to the bit array of the VLANs that
+ *                  were changed.
+ *
+ * \param[in]       dirtyInstances points to the bit array of the spanning
+ *                  tree instances that were changed.
+ *
+ * \param[in]       vlanInstance points to the spanning-tree instance of
+ *                  every VLAN, as filled in by ''BuildVlanInstanceMap''.
+ *
+ * \param[in]       hwWritten is TRUE if the hardware may have been written.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void UndoVlanPortConfigList(fm_int                       sw,
+                                   fm_vlanPortConfig *          configList,
+                                   fm10000_vlanPortConfigUndo * undo,
+                                   fm_bitArray *                dirtyVlans,
+                                   fm_bitArray *                dirtyInstances,
+                                   fm_int *                     vlanInstance,
+                                   fm_bool                      hwWritten)
+{
+    fm_switch *         switchPtr;
+    fm10000_vlanEntry * ventryExt;
+    fm_stpInstanceInfo *instanceInfo;
+    fm_port *           portPtr;
+    fm_lag *            lagPtr;
+    fm_int              i;
+    fm_int              vlanID;
+    fm_int              instance;
+    fm_status           err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* Later entries may have overwritten earlier ones, so restore the
+     * LAG membership in reverse order. */
+    for (i = undo->numLagEntries - 1 ; i >= 0 ; i--)
+    {
+        portPtr = GET_PORT_PTR(sw, configList[i].port);
+
+        if (switchPtr->perLagMgmt && portPtr->portType == FM_PORT_TYPE_LAG)
+        {
+            lagPtr = GET_LAG_PTR(sw, portPtr->lagIndex);
+            lagPtr->vlanMembership[configList[i].vlanID] =
+                undo->lagMembership[i];
+        }
+    }
+
+    err = fmFindBitInBitArray(dirtyVlans, 0, TRUE, &vlanID);
+
+    while (err == FM_OK && vlanID >= 0)
+    {
+        ventryExt         = GET_VLAN_EXT(sw, vlanID);
+        ventryExt->member = undo->member[vlanID];
+        ventryExt->tag    = undo->tag[vlanID];
+
+        err = fmFindBitInBitArray(dirtyVlans, vlanID + 1, TRUE, &vlanID);
+    }
+
+    err = fmFindBitInBitArray(dirtyInstances, 0, TRUE, &instance);
+
+    while (err == FM_OK && instance >= 0)
+    {
+        if ( fmTreeFind(GET_STP_INFO(sw),
+                        instance,
+                        (void **) &instanceInfo) == FM_OK )
+        {
+            FM_MEMCPY_S(instanceInfo->states,
+                        switchPtr->numCardinalPorts * sizeof(fm_int),
+                        &undo->states[instance * switchPtr->numCardinalPorts],
+                        switchPtr->numCardinalPorts * sizeof(fm_int));
+
+            if (hwWritten)
+            {
+                err = fmRefreshStpStateInternal(switchPtr, instanceInfo, -1, -1);
+                if (err != FM_OK)
+                {
+                    FM_LOG_ERROR(FM_LOG_CAT_VLAN,
+                                 "Unable to restore spanning tree instance "
+                                 "%d: %s\n",
+                                 instance,
+                                 fmErrorMsg(err));
+                }
+            }
+        }
+
+        err = fmFindBitInBitArray(dirtyInstances, instance + 1, TRUE, &instance);
+    }
+
+    if (hwWritten)
+    {
+        err = WriteVlanEntryList(sw, dirtyVlans, vlanInstance);
+        if (err != FM_OK)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_VLAN,
+                         "Unable to restore the VLAN table: %s\n",
+                         fmErrorMsg(err));
+        }
+    }
+
+}   /* end UndoVlanPortConfigList */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -467,11 +981,8 @@ fm_status fm10000WriteVlanEntryV2(fm_int    sw,
                                   fm_int    stpInstance)
 {
     fm_status          status;
-    fm_vlanEntry *     ventry;
-    fm10000_vlanEntry *ventryExt;
-    fm_switch *        switchPtr;
-    fm_uint32          regVals[FM10000_INGRESS_VID_TABLE_WIDTH];
-    fm_int             fid;
+    fm_uint32          ingressVals[FM10000_INGRESS_VID_TABLE_WIDTH];
+    fm_uint32          egressVals[FM10000_EGRESS_VID_TABLE_WIDTH];
     fm_bool            regLockTaken;
 
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
@@ -480,10 +991,6 @@ fm_status fm10000WriteVlanEntryV2(fm_int    sw,
                  vlanID,
                  stpInstance);
 
-    switchPtr = GET_SWITCH_PTR(sw);
-    ventry    = GET_VLAN_PTR(sw, vlanID);
-    ventryExt = GET_VLAN_EXT(sw, vlanID);
-
     regLockTaken = FALSE;
 
     if (stpInstance < 0)
@@ -492,35 +999,12 @@ fm_status fm10000WriteVlanEntryV2(fm_int    sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
     }
 
-    switch (switchPtr->vlanLearningMode)
-    {
-        case FM_VLAN_LEARNING_MODE_INDEPENDENT:
-            fid = vlanID;
-            break;
-
-        case FM_VLAN_LEARNING_MODE_SHARED:
-            fid = switchPtr->sharedLearningVlan;
-            break;
-
-        default:
-            FM_LOG_FATAL(FM_LOG_CAT_VLAN,
-                         "Invalid vlan learning mode %d configured\n",
-                         switchPtr->vlanLearningMode);
-            status = FM_ERR_UNSUPPORTED;
-            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
-    }
-
     /**************************************************
      * Update the VLAN tables in hardware.
      **************************************************/
 
-    FM_CLEAR(regVals);
-    FM_ARRAY_SET_PORTMASK( regVals, FM10000_INGRESS_VID_TABLE, membership, &ventryExt->member);
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_INGRESS_VID_TABLE, FID,        fid );
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_INGRESS_VID_TABLE, MST_Index,  stpInstance );
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_INGRESS_VID_TABLE, vcnt,       ventryExt->statIndex );
-    FM_ARRAY_SET_BIT(      regVals, FM10000_INGRESS_VID_TABLE, reflect,    ventry->reflect );
-    FM_ARRAY_SET_BIT(      regVals, FM10000_INGRESS_VID_TABLE, TrapIGMP,   ventry->trapIGMP );
+    status = BuildVlanEntryRegs(sw, vlanID, stpInstance, ingressVals, egressVals);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
 
     TAKE_REG_LOCK(sw);
 
@@ -529,27 +1013,15 @@ fm_status fm10000WriteVlanEntryV2(fm_int    sw,
     /* write to this one register (single indexed) */
     status = fmRegCacheWriteSingle1D(sw,
                                      &fm10000CacheIngressVidTable,
-                                     regVals,
+                                     ingressVals,
                                      vlanID,
                                      FALSE);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
 
-    /* set the EGRESS_VID_TABLE[].membership[] using
-     * EGRESS_FID_TABLE[].Forwarding[] & real VLAN membership to make sure that
-     * any packet that are being untrapped by the trigger do not bypass the
-     * egress STP state checks.
-     */
-    FM_CLEAR(regVals);
-    FM_ARRAY_SET_PORTMASK( regVals, FM10000_EGRESS_VID_TABLE, membership, &ventryExt->member);
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_EGRESS_VID_TABLE, FID,        fid );
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_EGRESS_VID_TABLE, MST_Index,  stpInstance );
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_EGRESS_VID_TABLE, MTU_Index,  ventryExt->mtuIndex );
-    FM_ARRAY_SET_FIELD(    regVals, FM10000_EGRESS_VID_TABLE, TrigID,     ventryExt->trigger );
-
     /* write to this one register (single indexed) */
     status = fmRegCacheWriteSingle1D(sw,
                                      &fm10000CacheEgressVidTable,
-                                     regVals,
+                                     egressVals,
                                      vlanID,
                                      FALSE );
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
@@ -619,27 +1091,14 @@ fm_status fm10000WriteVlanEntry(fm_int sw, fm_uint16 vlanID)
 fm_status fm10000WriteTagEntry(fm_int sw, fm_uint16 vlanID)
 {
     fm_status          status;
-    fm10000_vlanEntry *ventryExt;
     fm_uint32          regVals[FM10000_MOD_VLAN_TAG_VID1_MAP_WIDTH];
 
     FM_LOG_ENTRY(FM_LOG_CAT_VLAN, "sw=%d, vlanID=%u\n", sw, vlanID);
 
-    ventryExt = GET_VLAN_EXT(sw, vlanID);
-
     TAKE_REG_LOCK(sw);
 
     /* write MOD_VLAN_TAG_VID1_MAP registers */
-    FM_CLEAR(regVals);
-
-    FM_ARRAY_SET_PORTMASK(regVals,
-                          FM10000_MOD_VLAN_TAG_VID1_MAP,
-                          Tag,
-                          &ventryExt->tag);
-
-    FM_ARRAY_SET_FIELD(regVals,
-                       FM10000_MOD_VLAN_TAG_VID1_MAP,
-                       VID,
-                       ventryExt->egressVid);
+    BuildTagEntryRegs(sw, vlanID, regVals);
 
     /* write to this one register (single indexed) */
     status = fmRegCacheWriteSingle1D(sw,
@@ -1239,6 +1698,371 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fm10000SetVlanPortConfigList
+ * \ingroup intVlan
+ *
+ * \desc            Sets the membership, egress tagging and spanning tree
+ *                  state of a list of VLAN/port pairs.
+ *                  Called through the SetVlanPortConfigList function
+ *                  pointer.
+ *
+ * \note            All the software tables are updated first. The VLAN
+ *                  table entries that changed are then written as a single
+ *                  register cache burst, and each spanning tree instance
+ *                  whose state changed is refreshed once, regardless of
+ *                  how many entries referred to it.
+ *
+ * \note            The software state is saved before it is changed, so
+ *                  that any failure rolls back the changes already made,
+ *                  in software and in the hardware.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in configList.
+ *
+ * \param[in]       configList points to an array of numEntries entries,
+ *                  already validated by the caller.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_STP_MODE if a spanning tree state is set
+ *                  in per-VLAN spanning tree mode.
+ * \return          FM_ERR_PORT_IS_INTERNAL if trying to change the state of
+ *                  an internal port.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fm10000SetVlanPortConfigList(fm_int              sw,
+                                       fm_int              numEntries,
+                                       fm_vlanPortConfig * configList)
+{
+    fm_switch *         switchPtr;
+    fm_vlanPortConfig * entry;
+    fm10000_vlanEntry * ventryExt;
+    fm_stpInstanceInfo *instanceInfo;
+    fm_port *           portPtr;
+    fm_int *            vlanInstance;
+    fm_bitArray         dirtyVlans;
+    fm_bitArray         dirtyInstances;
+    fm10000_vlanPortConfigUndo undo;
+    fm_lag *            lagPtr;
+    fm_int              members[FM_MAX_NUM_LAG_MEMBERS];
+    fm_int              numMembers;
+    fm_int              i;
+    fm_int              j;
+    fm_int              physPort;
+    fm_int              cpi;
+    fm_int              instance;
+    fm_bool             tag;
+    fm_bool             vlansCreated;
+    fm_bool             instancesCreated;
+    fm_bool             hwWritten;
+    fm_status           status;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_VLAN,
+                 "sw=%d, numEntries=%d, configList=%p\n",
+                 sw,
+                 numEntries,
+                 (void *) configList);
+
+    switchPtr        = GET_SWITCH_PTR(sw);
+    vlanInstance     = NULL;
+    vlansCreated     = FALSE;
+    instancesCreated = FALSE;
+    hwWritten        = FALSE;
+
+    FM_CLEAR(undo);
+
+    /* The LAG lock keeps the LAG member lists stable for the duration. */
+    TAKE_LAG_LOCK(sw);
+    FM_TAKE_L2_LOCK(sw);
+
+    vlanInstance = fmAlloc( FM_MAX_VLAN * sizeof(fm_int) );
+    if (vlanInstance == NULL)
+    {
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    }
+
+    status = BuildVlanInstanceMap(sw, vlanInstance);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+    status = fmCreateBitArray(&dirtyVlans, FM_MAX_VLAN);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    vlansCreated = TRUE;
+
+    status = fmCreateBitArray(&dirtyInstances, FM10000_MAX_STP_INSTANCE);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    instancesCreated = TRUE;
+
+    /* Allocate the undo state up front, so that nothing is left to
+     * allocate once the software tables start changing. */
+    undo.member        = fmAlloc( FM_MAX_VLAN * sizeof(fm_portmask) );
+    undo.tag           = fmAlloc( FM_MAX_VLAN * sizeof(fm_portmask) );
+    undo.states        = fmAlloc( FM10000_MAX_STP_INSTANCE *
+                                  switchPtr->numCardinalPorts *
+                                  sizeof(fm_int) );
+    undo.lagMembership = fmAlloc( (numEntries + 1) * sizeof(fm_byte) );
+
+    if ( undo.member == NULL || undo.tag == NULL ||
+         undo.states == NULL || undo.lagMembership == NULL )
+    {
+        status = FM_ERR_NO_MEM;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    }
+
+    /***************************************************
+     * Check the spanning tree states before anything is
+     * modified, so a rejected entry leaves the
+     * configuration unchanged.
+     **************************************************/
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &configList[i];
+
+        if (entry->stpState == FM_VLAN_PORT_STP_STATE_UNCHANGED)
+        {
+            continue;
+        }
+
+        if ( (switchPtr->stpMode != FM_SPANNING_TREE_SHARED) &&
+             (switchPtr->stpMode != FM_SPANNING_TREE_MULTIPLE) )
+        {
+            status = FM_ERR_INVALID_STP_MODE;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+        }
+
+        if (GET_PROPERTY()->stpEnIntPortCtrl)
+        {
+            continue;
+        }
+
+        instance = (switchPtr->stpMode == FM_SPANNING_TREE_SHARED)
+                   ? FM_DEFAULT_STP_INSTANCE
+                   : vlanInstance[entry->vlanID];
+
+        status = fmTreeFind(GET_STP_INFO(sw), instance, (void **) &instanceInfo);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+        status = fmGetLAGCardinalPortList(sw,
+                                          entry->port,
+                                          &numMembers,
+                                          members,
+                                          FM_MAX_NUM_LAG_MEMBERS);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+        for (j = 0 ; j < numMembers ; j++)
+        {
+            /* Cannot change the STP state of an internal port, the state
+             * is forced to FM_STP_STATE_FORWARDING */
+            cpi = GET_PORT_INDEX(sw, members[j]);
+
+            if ( fmIsInternalPort(sw, members[j]) &&
+                 (instanceInfo->states[cpi] == FM_STP_STATE_FORWARDING) &&
+                 (entry->stpState != FM_STP_STATE_FORWARDING) )
+            {
+                status = FM_ERR_PORT_IS_INTERNAL;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+            }
+        }
+    }
+
+    /***************************************************
+     * Update the software tables, recording which VLANs
+     * and spanning tree instances actually changed.
+     **************************************************/
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry     = &configList[i];
+        ventryExt = GET_VLAN_EXT(sw, entry->vlanID);
+        portPtr   = GET_PORT_PTR(sw, entry->port);
+        tag       = entry->member ? entry->tag : FALSE;
+
+        if (switchPtr->perLagMgmt && portPtr->portType == FM_PORT_TYPE_LAG)
+        {
+            lagPtr = GET_LAG_PTR(sw, portPtr->lagIndex);
+
+            undo.lagMembership[i] = lagPtr->vlanMembership[entry->vlanID];
+            undo.numLagEntries    = i + 1;
+
+            status = fmSetLAGVlanMembership(sw,
+                                            entry->vlanID,
+                                            entry->port,
+                                            entry->member,
+                                            tag);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+            if (entry->stpState != FM_VLAN_PORT_STP_STATE_UNCHANGED)
+            {
+                status = fmSetLAGVlanPortState(sw,
+                                               entry->vlanID,
+                                               entry->port,
+                                               entry->stpState);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+            }
+        }
+
+        status = fmGetLAGCardinalPortList(sw,
+                                          entry->port,
+                                          &numMembers,
+                                          members,
+                                          FM_MAX_NUM_LAG_MEMBERS);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+        instanceInfo = NULL;
+
+        if (entry->stpState != FM_VLAN_PORT_STP_STATE_UNCHANGED)
+        {
+            instance = (switchPtr->stpMode == FM_SPANNING_TREE_SHARED)
+                       ? FM_DEFAULT_STP_INSTANCE
+                       : vlanInstance[entry->vlanID];
+
+            status = fmTreeFind(GET_STP_INFO(sw),
+                                instance,
+                                (void **) &instanceInfo);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+        }
+
+        for (j = 0 ; j < numMembers ; j++)
+        {
+            status = fmMapLogicalPortToPhysical(switchPtr, members[j], &physPort);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+            if ( (FM_PORTMASK_IS_BIT_SET(&ventryExt->member, physPort) !=
+                  (entry->member != FALSE)) ||
+                 (FM_PORTMASK_IS_BIT_SET(&ventryExt->tag, physPort) !=
+                  (tag != FALSE)) )
+            {
+                if ( !fmIsBitInBitArray(&dirtyVlans, entry->vlanID) )
+                {
+                    undo.member[entry->vlanID] = ventryExt->member;
+                    undo.tag[entry->vlanID]    = ventryExt->tag;
+                }
+
+                FM_PORTMASK_SET_BIT(&ventryExt->member, physPort, entry->member);
+                FM_PORTMASK_SET_BIT(&ventryExt->tag, physPort, tag);
+
+                status = fmSetBitArrayBit(&dirtyVlans, entry->vlanID, TRUE);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+            }
+
+            if (instanceInfo != NULL)
+            {
+                cpi = GET_PORT_INDEX(sw, members[j]);
+
+                if (instanceInfo->states[cpi] != entry->stpState)
+                {
+                    if ( !fmIsBitInBitArray(&dirtyInstances,
+                                            instanceInfo->instance) )
+                    {
+                        FM_MEMCPY_S(&undo.states[instanceInfo->instance *
+                                                 switchPtr->numCardinalPorts],
+                                    switchPtr->numCardinalPorts * sizeof(fm_int),
+                                    instanceInfo->states,
+                                    switchPtr->numCardinalPorts * sizeof(fm_int));
+                    }
+
+                    instanceInfo->states[cpi] = entry->stpState;
+
+                    status = fmSetBitArrayBit(&dirtyInstances,
+                                              instanceInfo->instance,
+                                              TRUE);
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+                }
+            }
+        }
+    }
+
+    /***************************************************
+     * Write the changed VLAN entries in one burst, then
+     * the changed spanning tree instances.
+     **************************************************/
+    hwWritten = TRUE;
+
+    status = WriteVlanEntryList(sw, &dirtyVlans, vlanInstance);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+    status = fmFindBitInBitArray(&dirtyInstances, 0, TRUE, &instance);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+    while (instance >= 0)
+    {
+        status = fmTreeFind(GET_STP_INFO(sw), instance, (void **) &instanceInfo);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+        status = fmRefreshStpStateInternal(switchPtr, instanceInfo, -1, -1);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+
+        status = fmFindBitInBitArray(&dirtyInstances,
+                                     instance + 1,
+                                     TRUE,
+                                     &instance);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, status);
+    }
+
+
+ABORT:
+
+    /* The undo state is complete once allocated, since it is saved before
+     * anything it covers is changed. */
+    if ( (status != FM_OK) &&
+         (undo.member != NULL) && (undo.tag != NULL) &&
+         (undo.states != NULL) && (undo.lagMembership != NULL) )
+    {
+        UndoVlanPortConfigList(sw,
+                               configList,
+                               &undo,
+                               &dirtyVlans,
+                               &dirtyInstances,
+                               vlanInstance,
+                               hwWritten);
+    }
+
+    if (undo.member != NULL)
+    {
+        fmFree(undo.member);
+    }
+
+    if (undo.tag != NULL)
+    {
+        fmFree(undo.tag);
+    }
+
+    if (undo.states != NULL)
+    {
+        fmFree(undo.states);
+    }
+
+    if (undo.lagMembership != NULL)
+    {
+        fmFree(undo.lagMembership);
+    }
+
+    if (instancesCreated)
+    {
+        fmDeleteBitArray(&dirtyInstances);
+    }
+
+    if (vlansCreated)
+    {
+        fmDeleteBitArray(&dirtyVlans);
+    }
+
+    if (vlanInstance != NULL)
+    {
+        fmFree(vlanInstance);
+    }
+
+    FM_DROP_L2_LOCK(sw);
+    DROP_LAG_LOCK(sw);
+
+    FM_LOG_EXIT(FM_LOG_CAT_VLAN, status);
+
+}   /* end fm10000SetVlanPortConfigList */
+
+
+
+
 /*****************************************************************************/
 /** fm10000GetVlanAttribute
  * \ingroup intVlan
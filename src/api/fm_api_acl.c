@@ -259,6 +259,7 @@ static fm_acl *AllocateAcl(fm_int maxPorts)
         fmTreeInit(&aclEntry->rules);
         fmTreeInit(&aclEntry->addedRules);
         fmTreeInit(&aclEntry->removedRules);
+        aclEntry->modified = TRUE;
 
         if (fmCreateBitArray(&aclEntry->associatedPorts,
                              maxPorts * FM_ACL_TYPE_MAX) != FM_OK)
@@ -748,6 +749,11 @@ fm_status fmSetACLAttribute(fm_int sw, fm_int acl, fm_int attr, void *value)
         err = FM_ERR_INVALID_ARGUMENT;
     }
 
+    if (err == FM_OK)
+    {
+        aclEntry->modified = TRUE;
+    }
+
 ABORT:
     FM_DROP_ACL_LOCK(sw);
     UNPROTECT_SWITCH(sw);
@@ -2994,6 +3000,7 @@ fm_status fmClearACLPort(fm_int sw, fm_int acl)
 
     err = fmClearBitArray(&aclEntry->associatedPorts);
 
+    aclEntry->modified = TRUE;
     aclEntry->numberOfPorts[FM_ACL_TYPE_INGRESS] = 0;
     aclEntry->numberOfPorts[FM_ACL_TYPE_EGRESS] = 0;
     aclEntry->aclPortType = FM_ACL_PORT_TYPE_NONE;
@@ -4590,6 +4597,11 @@ fm_status fmSetAclAssociatedPort(fm_int     sw,
 
     err = fmSetBitArrayBit(&aclEntry->associatedPorts, bitNo, bitValue);
 
+    if (err == FM_OK)
+    {
+        aclEntry->modified = TRUE;
+    }
+
     return err;
 
 }   /* end fmSetAclAssociatedPort */
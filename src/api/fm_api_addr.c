@@ -67,6 +67,108 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** IndexUnlink
+ * \ingroup intAddr
+ *
+ * \desc            Removes an entry from the list it is linked on for one
+ *                  index type.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       entryIndex is the MA Table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void IndexUnlink(fm_maTableIndex *   maIndex,
+                        fm_maTableIndexType type,
+                        fm_int              entryIndex)
+{
+    fm_maTableIndexNode *node;
+    fm_int32             list;
+
+    node = &maIndex->nodes[entryIndex];
+    list = node->list[type];
+
+    if (list < 0)
+    {
+        return;
+    }
+
+    if (node->prev[type] >= 0)
+    {
+        maIndex->nodes[node->prev[type]].next[type] = node->next[type];
+    }
+    else
+    {
+        maIndex->head[type][list] = node->next[type];
+    }
+
+    if (node->next[type] >= 0)
+    {
+        maIndex->nodes[node->next[type]].prev[type] = node->prev[type];
+    }
+
+    maIndex->count[type][list]--;
+
+    node->list[type] = -1;
+    node->next[type] = -1;
+    node->prev[type] = -1;
+
+}   /* end IndexUnlink */
+
+
+
+
+/*****************************************************************************/
+/** IndexLink
+ * \ingroup intAddr
+ *
+ * \desc            Adds an entry to the head of a list for one index type.
+ *                  The entry must not already be linked for that type.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       list is the list on which to link the entry.
+ *
+ * \param[in]       entryIndex is the MA Table index of the entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void IndexLink(fm_maTableIndex *   maIndex,
+                      fm_maTableIndexType type,
+                      fm_int32            list,
+                      fm_int              entryIndex)
+{
+    fm_maTableIndexNode *node;
+    fm_int32             first;
+
+    node  = &maIndex->nodes[entryIndex];
+    first = maIndex->head[type][list];
+
+    node->list[type] = list;
+    node->prev[type] = -1;
+    node->next[type] = first;
+
+    if (first >= 0)
+    {
+        maIndex->nodes[first].prev[type] = (fm_int32) entryIndex;
+    }
+
+    maIndex->head[type][list] = (fm_int32) entryIndex;
+    maIndex->count[type][list]++;
+
+}   /* end IndexLink */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1639,175 +1741,555 @@ fm_status fmGetAddressTableExt(fm_int              sw,
 
 
 /*****************************************************************************/
-/** fmDeleteAllAddresses
+/** fmGetAddressTableChanges
  * \ingroup addr
  *
- * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ * \chips           FM10000
  *
- * \desc            Deletes all addresses from the MA Table before
- *                  returning to the caller, whether they are dynamic or
- *                  static. Age events are not reported.
+ * \desc            Retrieves the MA Table entries that have changed since
+ *                  a previous call, allowing an application to keep a
+ *                  copy of the MA Table up to date without reading the
+ *                  entire table each time.
+ *                                                                      \lb\lb
+ *                  The changes are taken from a point-in-time copy of the
+ *                  table, made under a single short hold of the MA Table
+ *                  lock, so learning and aging are not held off while the
+ *                  entries are converted. Changes are tracked per group
+ *                  of entries, so entries that did not change may also be
+ *                  reported.
  *
  * \param[in]       sw is the switch on which to operate.
  *
+ * \param[in,out]   epoch points to caller-allocated storage holding the
+ *                  epoch returned by the previous call, or zero to
+ *                  retrieve every valid entry. On success it is updated
+ *                  with the epoch to pass to the next call. The epoch
+ *                  of an ''fm_macTableIterator'' may also be used.
+ *
+ * \param[out]      nChanges points to caller-allocated storage where this
+ *                  function will place the number of changes retrieved.
+ *
+ * \param[out]      changes points to an array of ''fm_macTableChange''
+ *                  structures that will be filled in by this function.
+ *                  An array of ''FM_MAC_TABLE_SIZE'' entries is always
+ *                  large enough.
+ *
+ * \param[in]       maxChanges is the number of entries in changes.
+ *
  * \return          FM_OK if successful.
  * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if a pointer argument is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support
+ *                  change tracking.
+ * \return          FM_ERR_BUFFER_FULL if there are more than maxChanges
+ *                  changes. The epoch is not updated.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
  *
  *****************************************************************************/
-fm_status fmDeleteAllAddresses(fm_int sw)
+fm_status fmGetAddressTableChanges(fm_int             sw,
+                                   fm_uint64 *        epoch,
+                                   fm_int *           nChanges,
+                                   fm_macTableChange *changes,
+                                   fm_int             maxChanges)
 {
-    fm_status err; 
+    fm_switch *              switchPtr;
+    fm_maTableSnapshot *     snapshot;
+    fm_internalMacAddrEntry *cacheEntry;
+    fm_uint64                sinceEpoch;
+    fm_status                err;
+    fm_status                status;
+    fm_int                   bucket;
+    fm_int                   i;
 
-    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d epoch=%p nChanges=%p changes=%p maxChanges=%d\n",
+                     sw,
+                     (void *) epoch,
+                     (void *) nChanges,
+                     (void *) changes,
+                     maxChanges);
 
     VALIDATE_AND_PROTECT_SWITCH(sw);
-    err = fmDeleteAllAddressesInternal(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    snapshot  = NULL;
+
+    if ( (epoch == NULL) || (nChanges == NULL) || (changes == NULL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    *nChanges = 0;
+
+    err = fmAcquireAddrTableSnapshot(sw, &snapshot);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    /* An epoch from a previous incarnation of the switch is treated
+     * as a request for the whole table. */
+    sinceEpoch = (*epoch > snapshot->epoch) ? 0 : *epoch;
+
+    for (i = 0 ; i < switchPtr->macTableSize ; i++)
+    {
+        bucket = i / FM_MA_TABLE_BUCKET_SIZE;
+
+        if (snapshot->bucketEpoch[bucket] <= sinceEpoch)
+        {
+            /* Skip the rest of the bucket. */
+            i = (bucket + 1) * FM_MA_TABLE_BUCKET_SIZE - 1;
+            continue;
+        }
+
+        cacheEntry = &snapshot->entries[i];
+
+        if ( (cacheEntry->state == FM_MAC_ENTRY_STATE_INVALID)
+            && (sinceEpoch == 0) )
+        {
+            continue;
+        }
+
+        if (*nChanges >= maxChanges)
+        {
+            err = FM_ERR_BUFFER_FULL;
+            goto ABORT;
+        }
+
+        changes[*nChanges].index = i;
+        changes[*nChanges].valid =
+            (cacheEntry->state != FM_MAC_ENTRY_STATE_INVALID);
+
+        if (changes[*nChanges].valid)
+        {
+            FM_API_CALL_FAMILY(status,
+                               switchPtr->FillInUserEntryFromTable,
+                               sw,
+                               cacheEntry,
+                               &changes[*nChanges].entry);
+            if (status != FM_OK)
+            {
+                FM_ERR_COMBINE(err, status);
+                continue;
+            }
+        }
+        else
+        {
+            FM_CLEAR(changes[*nChanges].entry);
+        }
+
+        (*nChanges)++;
+    }
+
+    if (err == FM_OK)
+    {
+        *epoch = snapshot->epoch;
+    }
+
+ABORT:
+    if (snapshot != NULL)
+    {
+        fmReleaseAddrTableSnapshot(sw, snapshot);
+    }
+
     UNPROTECT_SWITCH(sw);
 
     FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
 
-}   /* end fmDeleteAllAddresses */
+}   /* end fmGetAddressTableChanges */
 
 
 
 
 /*****************************************************************************/
-/** fmDeleteAllAddressesInternal
- * \ingroup intAddr
+/** fmCreateAddressTableIterator
+ * \ingroup addr
  *
- * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ * \chips           FM10000
  *
- * \desc            Deletes all addresses from the MA Table before
- *                  returning to the caller, whether they are dynamic or
- *                  static. Age events are not reported.
+ * \desc            Takes a point-in-time copy of the MA Table and
+ *                  initializes an iterator over it. The entries can then
+ *                  be retrieved a page at a time with
+ *                  ''fmGetAddressTableIteratorNext'' without holding any
+ *                  lock that would delay learning or aging.
+ *                                                                      \lb\lb
+ *                  Iterators created while the table is unchanged share
+ *                  the same copy.
+ *
+ * \note            ''fmDeleteAddressTableIterator'' must be called to
+ *                  release the copy when the iterator is no longer
+ *                  needed.
  *
  * \param[in]       sw is the switch on which to operate.
  *
+ * \param[out]      iter points to the iterator to initialize.
+ *
  * \return          FM_OK if successful.
  * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if iter is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support
+ *                  MA Table snapshots.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
  *
  *****************************************************************************/
-fm_status fmDeleteAllAddressesInternal(fm_int sw)
+fm_status fmCreateAddressTableIterator(fm_int sw, fm_macTableIterator *iter)
 {
-    fm_switch * switchPtr;
-    fm_status   err;
+    fm_maTableSnapshot *snapshot;
+    fm_status           err;
 
-    switchPtr = GET_SWITCH_PTR(sw);
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "sw=%d iter=%p\n",
+                     sw,
+                     (void *) iter);
 
-    fmDbgDiagCountIncr(sw, FM_CTR_DELETE_ALL, 1);
+    VALIDATE_AND_PROTECT_SWITCH(sw);
 
-    /* Clear MA Table */
-    FM_API_CALL_FAMILY(err, switchPtr->DeleteAllAddresses, sw, FALSE);
-    
-    return err;
+    if (iter == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
 
-}   /* end fmDeleteAllAddressesInternal */
+    FM_CLEAR(*iter);
+
+    err = fmAcquireAddrTableSnapshot(sw, &snapshot);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    iter->sw         = sw;
+    iter->snapshot   = snapshot;
+    iter->nextIndex  = 0;
+    iter->epoch      = snapshot->epoch;
+    iter->numEntries = snapshot->numValid;
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmCreateAddressTableIterator */
 
 
 
 
 /*****************************************************************************/
-/** fmDeleteAllDynamicAddresses
+/** fmGetAddressTableIteratorNext
  * \ingroup addr
  *
- * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ * \chips           FM10000
  *
- * \desc            Deletes all dynamic addresses from the MA Table before
- *                  returning to the caller. Static entries are left untouched. 
- *                  Age events are not reported. (See also 
- *                  ''fmFlushAllDynamicAddresses''.
+ * \desc            Retrieves the next page of entries from an MA Table
+ *                  iterator.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in,out]   iter points to an iterator initialized by
+ *                  ''fmCreateAddressTableIterator''.
+ *
+ * \param[out]      nEntries points to caller-allocated storage where this
+ *                  function will place the number of entries retrieved.
+ *
+ * \param[out]      entries points to an array of ''fm_macAddressEntry''
+ *                  structures that will be filled in by this function.
+ *
+ * \param[in]       maxEntries is the number of entries in the array.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_NO_MORE if there are no more entries.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_INVALID_SWITCH if the iterator's switch is
+ *                  invalid.
  *
  *****************************************************************************/
-fm_status fmDeleteAllDynamicAddresses(fm_int sw)
+fm_status fmGetAddressTableIteratorNext(fm_macTableIterator *iter,
+                                        fm_int *             nEntries,
+                                        fm_macAddressEntry * entries,
+                                        fm_int               maxEntries)
 {
-    fm_switch *switchPtr;
-    fm_status  err;
+    fm_switch *         switchPtr;
+    fm_maTableSnapshot *snapshot;
+    fm_status           err;
+    fm_status           status;
+    fm_int              sw;
 
-    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR,
+                     "iter=%p nEntries=%p entries=%p maxEntries=%d\n",
+                     (void *) iter,
+                     (void *) nEntries,
+                     (void *) entries,
+                     maxEntries);
+
+    if ( (iter == NULL)
+        || (iter->snapshot == NULL)
+        || (nEntries == NULL)
+        || (entries == NULL)
+        || (maxEntries <= 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
 
-    VALIDATE_AND_PROTECT_SWITCH(sw);
+    sw = iter->sw;
 
-    fmDbgDiagCountIncr(sw, FM_CTR_DELETE_ALL_DYNAMIC, 1);
+    VALIDATE_AND_PROTECT_SWITCH(sw);
 
     switchPtr = GET_SWITCH_PTR(sw);
+    snapshot  = iter->snapshot;
+    err       = FM_OK;
+    *nEntries = 0;
 
-    FM_API_CALL_FAMILY(err, switchPtr->DeleteAllAddresses, sw, TRUE);
+    while ( (iter->nextIndex < switchPtr->macTableSize)
+           && (*nEntries < maxEntries) )
+    {
+        if (snapshot->entries[iter->nextIndex].state !=
+            FM_MAC_ENTRY_STATE_INVALID)
+        {
+            FM_API_CALL_FAMILY(status,
+                               switchPtr->FillInUserEntryFromTable,
+                               sw,
+                               &snapshot->entries[iter->nextIndex],
+                               &entries[*nEntries]);
+            if (status == FM_OK)
+            {
+                (*nEntries)++;
+            }
+            else
+            {
+                FM_ERR_COMBINE(err, status);
+            }
+        }
+
+        iter->nextIndex++;
+    }
+
+    if ( (err == FM_OK) && (*nEntries == 0) )
+    {
+        err = FM_ERR_NO_MORE;
+    }
 
     UNPROTECT_SWITCH(sw);
+
     FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
 
-}   /* end fmDeleteAllDynamicAddresses */
+}   /* end fmGetAddressTableIteratorNext */
 
 
 
 
 /*****************************************************************************/
-/** fmFlushAllDynamicAddresses
+/** fmDeleteAddressTableIterator
  * \ingroup addr
  *
- * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ * \chips           FM10000
  *
- * \desc            Dispatch an independent thread to delete all dynamic
- *                  addresses from the MA Table (this function returns
- *                  immediately, before the MA Table entries have actually been
- *                  deleted). Static entries are left untouched. An age event
- *                  is reported to the application for each MA Table entry
- *                  deleted.
+ * \desc            Releases the MA Table copy held by an iterator.
  *
- * \param[in]       sw is the switch on which to operate.
+ * \param[in,out]   iter points to an iterator initialized by
+ *                  ''fmCreateAddressTableIterator''.
  *
  * \return          FM_OK if successful.
- * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_UNSUPPORTED if function not supported.
- * \return          FM_ERR_EVENT_QUEUE_FULL if the independent thread's event
- *                  queue is full.
+ * \return          FM_ERR_INVALID_ARGUMENT if iter is invalid.
+ * \return          FM_ERR_INVALID_SWITCH if the iterator's switch is
+ *                  invalid.
  *
  *****************************************************************************/
-fm_status fmFlushAllDynamicAddresses(fm_int sw)
+fm_status fmDeleteAddressTableIterator(fm_macTableIterator *iter)
 {
-    fm_status      err;
-    fm_flushParams params;
+    fm_int sw;
 
-    FM_CLEAR(params);
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "iter=%p\n", (void *) iter);
 
-    err = fmFlushAddresses(sw, FM_FLUSH_MODE_ALL_DYNAMIC, params);
+    if ( (iter == NULL) || (iter->snapshot == NULL) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_ERR_INVALID_ARGUMENT);
+    }
 
-    return err;
+    sw = iter->sw;
 
-}   /* end fmFlushAllDynamicAddresses */
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    fmReleaseAddrTableSnapshot(sw, iter->snapshot);
+    iter->snapshot = NULL;
+
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, FM_OK);
+
+}   /* end fmDeleteAddressTableIterator */
 
 
 
 
 /*****************************************************************************/
-/** fmFlushPortAddresses
+/** fmDeleteAllAddresses
  * \ingroup addr
  *
  * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
  *
- * \desc            Dispatch an independent thread to delete all dynamic MA 
- *                  Table entries associated with the specified port (this 
- *                  function returns immediately, before the MA Table entries 
- *                  have actually been deleted). An age event is reported to 
- *                  the application for each MA Table entry deleted.
+ * \desc            Deletes all addresses from the MA Table before
+ *                  returning to the caller, whether they are dynamic or
+ *                  static. Age events are not reported.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       port is the port number to filter on.
- *
  * \return          FM_OK if successful.
  * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
- * \return          FM_ERR_UNSUPPORTED if function not supported.
- * \return          FM_ERR_EVENT_QUEUE_FULL if the independent thread's event
- *                  queue is full.
  *
  *****************************************************************************/
-fm_status fmFlushPortAddresses(fm_int sw, fm_uint port)
+fm_status fmDeleteAllAddresses(fm_int sw)
+{
+    fm_status err; 
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    err = fmDeleteAllAddressesInternal(sw);
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmDeleteAllAddresses */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteAllAddressesInternal
+ * \ingroup intAddr
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Deletes all addresses from the MA Table before
+ *                  returning to the caller, whether they are dynamic or
+ *                  static. Age events are not reported.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDeleteAllAddressesInternal(fm_int sw)
+{
+    fm_switch * switchPtr;
+    fm_status   err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    fmDbgDiagCountIncr(sw, FM_CTR_DELETE_ALL, 1);
+
+    /* Clear MA Table */
+    FM_API_CALL_FAMILY(err, switchPtr->DeleteAllAddresses, sw, FALSE);
+    
+    return err;
+
+}   /* end fmDeleteAllAddressesInternal */
+
+
+
+
+/*****************************************************************************/
+/** fmDeleteAllDynamicAddresses
+ * \ingroup addr
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Deletes all dynamic addresses from the MA Table before
+ *                  returning to the caller. Static entries are left untouched. 
+ *                  Age events are not reported. (See also 
+ *                  ''fmFlushAllDynamicAddresses''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ *
+ *****************************************************************************/
+fm_status fmDeleteAllDynamicAddresses(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ADDR, "sw=%d\n", sw);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    fmDbgDiagCountIncr(sw, FM_CTR_DELETE_ALL_DYNAMIC, 1);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err, switchPtr->DeleteAllAddresses, sw, TRUE);
+
+    UNPROTECT_SWITCH(sw);
+    FM_LOG_EXIT_API(FM_LOG_CAT_ADDR, err);
+
+}   /* end fmDeleteAllDynamicAddresses */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushAllDynamicAddresses
+ * \ingroup addr
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Dispatch an independent thread to delete all dynamic
+ *                  addresses from the MA Table (this function returns
+ *                  immediately, before the MA Table entries have actually been
+ *                  deleted). Static entries are left untouched. An age event
+ *                  is reported to the application for each MA Table entry
+ *                  deleted.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if function not supported.
+ * \return          FM_ERR_EVENT_QUEUE_FULL if the independent thread's event
+ *                  queue is full.
+ *
+ *****************************************************************************/
+fm_status fmFlushAllDynamicAddresses(fm_int sw)
+{
+    fm_status      err;
+    fm_flushParams params;
+
+    FM_CLEAR(params);
+
+    err = fmFlushAddresses(sw, FM_FLUSH_MODE_ALL_DYNAMIC, params);
+
+    return err;
+
+}   /* end fmFlushAllDynamicAddresses */
+
+
+
+
+/*****************************************************************************/
+/** fmFlushPortAddresses
+ * \ingroup addr
+ *
+ * \chips           FM2000, FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Dispatch an independent thread to delete all dynamic MA 
+ *                  Table entries associated with the specified port (this 
+ *                  function returns immediately, before the MA Table entries 
+ *                  have actually been deleted). An age event is reported to 
+ *                  the application for each MA Table entry deleted.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port number to filter on.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_UNSUPPORTED if function not supported.
+ * \return          FM_ERR_EVENT_QUEUE_FULL if the independent thread's event
+ *                  queue is full.
+ *
+ *****************************************************************************/
+fm_status fmFlushPortAddresses(fm_int sw, fm_uint port)
 {
     fm_status      err;
     fm_flushParams params;
@@ -2452,7 +2934,15 @@ fm_status fmCommonFindAndInvalidateAddr(fm_int     sw,
                 }
             }
 
+            /* The lock may have been dropped to generate the update. */
+            if (!l2Locked)
+            {
+                FM_TAKE_L2_LOCK(sw);
+                l2Locked = TRUE;
+            }
+
             tblentry->state = FM_MAC_ENTRY_STATE_INVALID;
+            fmMarkAddrTableEntry(sw, addr);
 
             FM_LOG_DEBUG2(FM_LOG_CAT_ADDR,
                           "index=0x%x/%d mac=" FM_FORMAT_ADDR 
@@ -2534,12 +3024,87 @@ fm_status fmCommonAllocAddrTableCache(fm_switch *switchPtr)
     if (switchPtr->maTable == NULL)
     {
         err = FM_ERR_NO_MEM;
+        goto ABORT;
     }
-    else
+
+    memset((void *) switchPtr->maTable, 0, (size_t) size);
+
+    /**************************************************
+     * Change tracking used by snapshot readers.
+     **************************************************/
+
+    size  = (fm_uint) sizeof(fm_uint64);
+    size *= (fm_uint) ( (switchPtr->macTableSize + FM_MA_TABLE_BUCKET_SIZE - 1)
+                        / FM_MA_TABLE_BUCKET_SIZE );
+
+    switchPtr->maTableBucketEpoch = (fm_uint64 *) fmAlloc(size);
+
+    if (switchPtr->maTableBucketEpoch == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    err = fmCreateBitArray(&switchPtr->maTableValidEntries,
+                           switchPtr->macTableSize);
+    if (err != FM_OK)
+    {
+        fmFree(switchPtr->maTableBucketEpoch);
+        switchPtr->maTableBucketEpoch = NULL;
+        goto ABORT;
+    }
+
+    err = fmAllocAddrTableIndex(&switchPtr->maTableIndex,
+                                switchPtr->macTableSize);
+    if (err != FM_OK)
     {
-        memset((void *) switchPtr->maTable, 0, (size_t) size);
+        fmDeleteBitArray(&switchPtr->maTableValidEntries);
+        fmFree(switchPtr->maTableBucketEpoch);
+        switchPtr->maTableBucketEpoch = NULL;
+        goto ABORT;
+    }
+
+    /**************************************************
+     * Aging fields.
+     **************************************************/
+
+    switchPtr->maTableAgingState =
+        fmAlloc( switchPtr->macTableSize * sizeof(fm_byte) );
+    switchPtr->maTableAgingTime  =
+        fmAlloc( switchPtr->macTableSize * sizeof(fm_uint32) );
+
+    if ( (switchPtr->maTableAgingState == NULL) ||
+         (switchPtr->maTableAgingTime == NULL) )
+    {
+        if (switchPtr->maTableAgingState != NULL)
+        {
+            fmFree(switchPtr->maTableAgingState);
+            switchPtr->maTableAgingState = NULL;
+        }
+
+        if (switchPtr->maTableAgingTime != NULL)
+        {
+            fmFree(switchPtr->maTableAgingTime);
+            switchPtr->maTableAgingTime = NULL;
+        }
+
+        fmFreeAddrTableIndex(&switchPtr->maTableIndex);
+        fmDeleteBitArray(&switchPtr->maTableValidEntries);
+        fmFree(switchPtr->maTableBucketEpoch);
+        switchPtr->maTableBucketEpoch = NULL;
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
     }
 
+    memset( switchPtr->maTableAgingTime,
+            0,
+            switchPtr->macTableSize * sizeof(fm_uint32) );
+
+    switchPtr->maTableEpoch    = 0;
+    switchPtr->maTableSnapshot = NULL;
+
+    fmResetAddrTableTracking(switchPtr);
+
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
 
@@ -2581,6 +3146,36 @@ fm_status fmCommonFreeAddrTableCache(fm_switch *switchPtr)
         fmFree(switchPtr->maTable);
         switchPtr->maTable = NULL;
     }
+
+    if (switchPtr->maTableBucketEpoch != NULL)
+    {
+        fmFree(switchPtr->maTableBucketEpoch);
+        switchPtr->maTableBucketEpoch = NULL;
+
+        fmDeleteBitArray(&switchPtr->maTableValidEntries);
+        fmFreeAddrTableIndex(&switchPtr->maTableIndex);
+    }
+
+    if (switchPtr->maTableAgingState != NULL)
+    {
+        fmFree(switchPtr->maTableAgingState);
+        switchPtr->maTableAgingState = NULL;
+    }
+
+    if (switchPtr->maTableAgingTime != NULL)
+    {
+        fmFree(switchPtr->maTableAgingTime);
+        switchPtr->maTableAgingTime = NULL;
+    }
+
+    /* Readers still holding the snapshot will free it on release. */
+    if ( (switchPtr->maTableSnapshot != NULL)
+        && (--switchPtr->maTableSnapshot->refCount == 0) )
+    {
+        fmFree(switchPtr->maTableSnapshot);
+    }
+
+    switchPtr->maTableSnapshot = NULL;
     
 ABORT:
     FM_LOG_EXIT(FM_LOG_CAT_ADDR | FM_LOG_CAT_SWITCH, err);
@@ -2590,6 +3185,614 @@ ABORT:
 
 
 
+/*****************************************************************************/
+/** fmResetAddrTableTracking
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Resets the MA Table change tracking to match an empty
+ *                  table. Every bucket is reported as changed to readers
+ *                  holding an older epoch.
+ *
+ * \param[in]       switchPtr points to the switch's state structure.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmResetAddrTableTracking(fm_switch *switchPtr)
+{
+    fm_int numBuckets;
+    fm_int i;
+
+    if (switchPtr->maTableBucketEpoch == NULL)
+    {
+        return;
+    }
+
+    numBuckets = (switchPtr->macTableSize + FM_MA_TABLE_BUCKET_SIZE - 1)
+                 / FM_MA_TABLE_BUCKET_SIZE;
+
+    switchPtr->maTableEpoch++;
+
+    for (i = 0 ; i < numBuckets ; i++)
+    {
+        switchPtr->maTableBucketEpoch[i] = switchPtr->maTableEpoch;
+    }
+
+    fmClearBitArray(&switchPtr->maTableValidEntries);
+    switchPtr->maTableValidCount = 0;
+
+    fmResetAddrTableIndex(&switchPtr->maTableIndex);
+
+    if (switchPtr->maTableAgingState != NULL)
+    {
+        memset( switchPtr->maTableAgingState,
+                FM_MAC_ENTRY_STATE_INVALID,
+                switchPtr->macTableSize * sizeof(fm_byte) );
+    }
+
+}   /* end fmResetAddrTableTracking */
+
+
+
+
+/*****************************************************************************/
+/** fmMarkAddrTableEntry
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Records a change to an MA Table cache entry. Must be
+ *                  called, with the L2 lock held, after every update to
+ *                  an entry of switchPtr->maTable.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       index is the MA Table index of the changed entry.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmMarkAddrTableEntry(fm_int sw, fm_uint32 index)
+{
+    fm_switch *switchPtr;
+    fm_bool    isValid;
+    fm_bool    wasValid;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->maTableBucketEpoch == NULL)
+    {
+        return;
+    }
+
+    isValid = (switchPtr->maTable[index].state != FM_MAC_ENTRY_STATE_INVALID);
+
+    if ( (fmGetBitArrayBit(&switchPtr->maTableValidEntries,
+                           (fm_int) index,
+                           &wasValid) == FM_OK)
+        && (isValid != wasValid) )
+    {
+        fmSetBitArrayBit(&switchPtr->maTableValidEntries,
+                         (fm_int) index,
+                         isValid);
+
+        switchPtr->maTableValidCount += isValid ? 1 : -1;
+    }
+
+    switchPtr->maTableBucketEpoch[index / FM_MA_TABLE_BUCKET_SIZE] =
+        ++switchPtr->maTableEpoch;
+
+    fmUpdateAddrTableIndex(&switchPtr->maTableIndex,
+                           (fm_int) index,
+                           &switchPtr->maTable[index]);
+
+    if (switchPtr->maTableAgingState != NULL)
+    {
+        switchPtr->maTableAgingState[index] =
+            (fm_byte) switchPtr->maTable[index].state;
+    }
+
+}   /* end fmMarkAddrTableEntry */
+
+
+
+
+/*****************************************************************************/
+/** fmAllocAddrTableIndex
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Allocates the secondary indexes over an MA Table and
+ *                  initializes them to match an empty table.
+ *
+ * \param[out]      maIndex points to the index to allocate.
+ *
+ * \param[in]       numEntries is the number of MA Table entries.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmAllocAddrTableIndex(fm_maTableIndex *maIndex, fm_int numEntries)
+{
+    fm_int type;
+
+    FM_CLEAR(*maIndex);
+
+    maIndex->numEntries                    = numEntries;
+    maIndex->numLists[FM_MA_INDEX_PORT]    = FM_MA_INDEX_PORT_LISTS;
+    maIndex->numLists[FM_MA_INDEX_VLAN]    = FM_MAX_VLAN;
+    maIndex->numLists[FM_MA_INDEX_EXPIRED] = 1;
+
+    maIndex->nodes = fmAlloc( numEntries * sizeof(fm_maTableIndexNode) );
+
+    if (maIndex->nodes == NULL)
+    {
+        goto ABORT;
+    }
+
+    for (type = 0 ; type < FM_MA_INDEX_MAX ; type++)
+    {
+        maIndex->head[type]  =
+            fmAlloc( maIndex->numLists[type] * sizeof(fm_int32) );
+        maIndex->count[type] =
+            fmAlloc( maIndex->numLists[type] * sizeof(fm_int32) );
+
+        if ( (maIndex->head[type] == NULL) || (maIndex->count[type] == NULL) )
+        {
+            goto ABORT;
+        }
+    }
+
+    fmResetAddrTableIndex(maIndex);
+
+    return FM_OK;
+
+ABORT:
+    fmFreeAddrTableIndex(maIndex);
+
+    return FM_ERR_NO_MEM;
+
+}   /* end fmAllocAddrTableIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeAddrTableIndex
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Frees the secondary indexes over an MA Table.
+ *
+ * \param[in]       maIndex points to the index to free.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmFreeAddrTableIndex(fm_maTableIndex *maIndex)
+{
+    fm_int type;
+
+    if (maIndex->nodes != NULL)
+    {
+        fmFree(maIndex->nodes);
+    }
+
+    for (type = 0 ; type < FM_MA_INDEX_MAX ; type++)
+    {
+        if (maIndex->head[type] != NULL)
+        {
+            fmFree(maIndex->head[type]);
+        }
+
+        if (maIndex->count[type] != NULL)
+        {
+            fmFree(maIndex->count[type]);
+        }
+    }
+
+    FM_CLEAR(*maIndex);
+
+}   /* end fmFreeAddrTableIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmResetAddrTableIndex
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Resets the secondary indexes to match an empty table.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmResetAddrTableIndex(fm_maTableIndex *maIndex)
+{
+    fm_int type;
+
+    if (maIndex->nodes == NULL)
+    {
+        return;
+    }
+
+    /* All bits set gives -1 in every link. */
+    memset( maIndex->nodes,
+            0xff,
+            maIndex->numEntries * sizeof(fm_maTableIndexNode) );
+
+    for (type = 0 ; type < FM_MA_INDEX_MAX ; type++)
+    {
+        memset( maIndex->head[type],
+                0xff,
+                maIndex->numLists[type] * sizeof(fm_int32) );
+        memset( maIndex->count[type],
+                0,
+                maIndex->numLists[type] * sizeof(fm_int32) );
+    }
+
+}   /* end fmResetAddrTableIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmUpdateAddrTableIndex
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Moves an MA Table entry onto the index lists that match
+ *                  its current port, VLAN and state. Invalid entries are
+ *                  removed from every list.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       entryIndex is the MA Table index of the entry.
+ *
+ * \param[in]       entry points to the entry's current contents.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmUpdateAddrTableIndex(fm_maTableIndex *         maIndex,
+                            fm_int                    entryIndex,
+                            fm_internalMacAddrEntry * entry)
+{
+    fm_maTableIndexNode *node;
+    fm_int32             list[FM_MA_INDEX_MAX];
+    fm_int               type;
+
+    if (maIndex->nodes == NULL)
+    {
+        return;
+    }
+
+    if (entry->state == FM_MAC_ENTRY_STATE_INVALID)
+    {
+        list[FM_MA_INDEX_PORT]    = -1;
+        list[FM_MA_INDEX_VLAN]    = -1;
+        list[FM_MA_INDEX_EXPIRED] = -1;
+    }
+    else
+    {
+        list[FM_MA_INDEX_PORT] =
+            fmGetAddrTableIndexList(FM_MA_INDEX_PORT, entry->port);
+        list[FM_MA_INDEX_VLAN] =
+            fmGetAddrTableIndexList(FM_MA_INDEX_VLAN, entry->vlanID);
+        list[FM_MA_INDEX_EXPIRED] =
+            (entry->state == FM_MAC_ENTRY_STATE_EXPIRED) ? 0 : -1;
+    }
+
+    node = &maIndex->nodes[entryIndex];
+
+    for (type = 0 ; type < FM_MA_INDEX_MAX ; type++)
+    {
+        if (node->list[type] == list[type])
+        {
+            continue;
+        }
+
+        IndexUnlink(maIndex, type, entryIndex);
+
+        if (list[type] >= 0)
+        {
+            IndexLink(maIndex, type, list[type], entryIndex);
+        }
+    }
+
+}   /* end fmUpdateAddrTableIndex */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddrTableIndexList
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the list of an index type on which entries with
+ *                  the given key are linked. Port lists are shared by
+ *                  ports that are equal modulo FM_MA_INDEX_PORT_LISTS, so
+ *                  callers must still compare each entry's port.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       key is the logical port for FM_MA_INDEX_PORT, the
+ *                  VLAN for FM_MA_INDEX_VLAN, and ignored for
+ *                  FM_MA_INDEX_EXPIRED.
+ *
+ * \return          The list number, or -1 if no entry can have the key.
+ *
+ *****************************************************************************/
+fm_int fmGetAddrTableIndexList(fm_maTableIndexType type, fm_int key)
+{
+    switch (type)
+    {
+        case FM_MA_INDEX_PORT:
+            return (key < 0) ? -1 : (key & (FM_MA_INDEX_PORT_LISTS - 1));
+
+        case FM_MA_INDEX_VLAN:
+            return (key < 0) ? -1 : (key & (FM_MAX_VLAN - 1));
+
+        case FM_MA_INDEX_EXPIRED:
+            return 0;
+
+        default:
+            return -1;
+    }
+
+}   /* end fmGetAddrTableIndexList */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddrTableIndexCount
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the number of entries on the list for a key.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       key is the list key (see ''fmGetAddrTableIndexList'').
+ *
+ * \return          The number of entries on the list.
+ *
+ *****************************************************************************/
+fm_int fmGetAddrTableIndexCount(fm_maTableIndex *   maIndex,
+                                fm_maTableIndexType type,
+                                fm_int              key)
+{
+    fm_int list;
+
+    list = fmGetAddrTableIndexList(type, key);
+
+    return (list < 0) ? 0 : maIndex->count[type][list];
+
+}   /* end fmGetAddrTableIndexCount */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddrTableIndexFirst
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the first entry on the list for a key.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       key is the list key (see ''fmGetAddrTableIndexList'').
+ *
+ * \return          The MA Table index of the first entry, or -1 if the
+ *                  list is empty.
+ *
+ *****************************************************************************/
+fm_int fmGetAddrTableIndexFirst(fm_maTableIndex *   maIndex,
+                                fm_maTableIndexType type,
+                                fm_int              key)
+{
+    fm_int list;
+
+    list = fmGetAddrTableIndexList(type, key);
+
+    return (list < 0) ? -1 : maIndex->head[type][list];
+
+}   /* end fmGetAddrTableIndexFirst */
+
+
+
+
+/*****************************************************************************/
+/** fmGetAddrTableIndexNext
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns the entry following another on its list.
+ *
+ * \param[in]       maIndex points to the index.
+ *
+ * \param[in]       type is the index type.
+ *
+ * \param[in]       entryIndex is the MA Table index of an entry on a list
+ *                  of the given type.
+ *
+ * \return          The MA Table index of the next entry, or -1 if
+ *                  entryIndex is the last entry on its list.
+ *
+ *****************************************************************************/
+fm_int fmGetAddrTableIndexNext(fm_maTableIndex *   maIndex,
+                               fm_maTableIndexType type,
+                               fm_int              entryIndex)
+{
+    return maIndex->nodes[entryIndex].next[type];
+
+}   /* end fmGetAddrTableIndexNext */
+
+
+
+
+/*****************************************************************************/
+/** fmAcquireAddrTableSnapshot
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Returns a point-in-time copy of the MA Table cache. If
+ *                  the table has not changed since the last copy was
+ *                  taken, that copy is shared; otherwise a new copy is
+ *                  made in a single critical section. The snapshot must
+ *                  be released with ''fmReleaseAddrTableSnapshot''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[out]      snapshotPtr points to caller-allocated storage where
+ *                  this function will place the snapshot pointer.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the switch has no MA Table cache.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmAcquireAddrTableSnapshot(fm_int sw, fm_maTableSnapshot **snapshotPtr)
+{
+    fm_switch *         switchPtr;
+    fm_maTableSnapshot *snapshot;
+    fm_maTableSnapshot *oldSnapshot;
+    fm_int              numBuckets;
+    fm_uint             entrySize;
+    fm_uint             bucketSize;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (switchPtr->maTable == NULL) || (switchPtr->maTableBucketEpoch == NULL) )
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    FM_TAKE_L2_LOCK(sw);
+
+    snapshot = switchPtr->maTableSnapshot;
+
+    if ( (snapshot != NULL) && (snapshot->epoch == switchPtr->maTableEpoch) )
+    {
+        snapshot->refCount++;
+        FM_DROP_L2_LOCK(sw);
+
+        *snapshotPtr = snapshot;
+        return FM_OK;
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
+    /* Allocate outside the lock; the table size is fixed. */
+    numBuckets = (switchPtr->macTableSize + FM_MA_TABLE_BUCKET_SIZE - 1)
+                 / FM_MA_TABLE_BUCKET_SIZE;
+    entrySize  = sizeof(fm_internalMacAddrEntry) * switchPtr->macTableSize;
+    bucketSize = sizeof(fm_uint64) * numBuckets;
+
+    snapshot = fmAlloc(sizeof(fm_maTableSnapshot) + entrySize + bucketSize);
+    if (snapshot == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    snapshot->entries     = (fm_internalMacAddrEntry *) (snapshot + 1);
+    snapshot->bucketEpoch = (fm_uint64 *) ( (fm_byte *) snapshot->entries
+                                            + entrySize );
+
+    FM_TAKE_L2_LOCK(sw);
+
+    FM_MEMCPY_S(snapshot->entries, entrySize, switchPtr->maTable, entrySize);
+    FM_MEMCPY_S(snapshot->bucketEpoch,
+                bucketSize,
+                switchPtr->maTableBucketEpoch,
+                bucketSize);
+
+    snapshot->epoch    = switchPtr->maTableEpoch;
+    snapshot->numValid = switchPtr->maTableValidCount;
+
+    /* One reference for the switch, one for the caller. */
+    snapshot->refCount = 2;
+
+    oldSnapshot = switchPtr->maTableSnapshot;
+    switchPtr->maTableSnapshot = snapshot;
+
+    if ( (oldSnapshot != NULL) && (--oldSnapshot->refCount != 0) )
+    {
+        oldSnapshot = NULL;
+    }
+
+    FM_DROP_L2_LOCK(sw);
+
+    if (oldSnapshot != NULL)
+    {
+        fmFree(oldSnapshot);
+    }
+
+    *snapshotPtr = snapshot;
+
+    return FM_OK;
+
+}   /* end fmAcquireAddrTableSnapshot */
+
+
+
+
+/*****************************************************************************/
+/** fmReleaseAddrTableSnapshot
+ * \ingroup intAddr
+ *
+ * \chips           FM10000
+ *
+ * \desc            Releases a snapshot returned by
+ *                  ''fmAcquireAddrTableSnapshot''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       snapshot points to the snapshot to release.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmReleaseAddrTableSnapshot(fm_int sw, fm_maTableSnapshot *snapshot)
+{
+    fm_bool freeSnapshot;
+
+    FM_TAKE_L2_LOCK(sw);
+    freeSnapshot = (--snapshot->refCount == 0);
+    FM_DROP_L2_LOCK(sw);
+
+    if (freeSnapshot)
+    {
+        fmFree(snapshot);
+    }
+
+}   /* end fmReleaseAddrTableSnapshot */
+
+
+
+
 /*****************************************************************************/
 /** fmCommonGetAddressTable
  * \ingroup intAddr
@@ -2811,6 +4014,7 @@ fm_status fmCommonDeleteAllAddresses(fm_int sw, fm_bool dynamicOnly)
                (cacheEntry->state != FM_MAC_ENTRY_STATE_LOCKED) ) )
         {
             cacheEntry->state = FM_MAC_ENTRY_STATE_INVALID;
+            fmMarkAddrTableEntry(sw, (fm_uint32) i);
 
             fmDbgDiagCountIncr(sw, FM_CTR_MAC_CACHE_DELETED, 1);
 
@@ -161,6 +161,9 @@ fm_buffer *fmAllocateBufferV2(int sw, fm_bufferType bufferType)
  *
  * \desc            Return a packet buffer, previously allocated with a
  *                  call to ''fmAllocateBuffer'', to the free buffer pool.
+ *                  If the buffer is shared (see ''fmShareBufferChain''),
+ *                  only the caller's reference is dropped and the buffer is
+ *                  returned to the pool by its last owner.
  *
  * \note            If the buffer is part of a chain of buffers, this function
  *                  will not dispose of the other buffers in the chain.  See
@@ -182,6 +185,14 @@ fm_status fmFreeBuffer(int sw, fm_buffer *buf)
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER, "sw=%d\n", sw);
 
+    /* Another owner still holds the buffer. If the count drops below zero,
+     * another owner raced us and this is the last reference after all. */
+    if ( (buf->shareCount > 0) &&
+         (__sync_fetch_and_sub(&buf->shareCount, 1) > 0) )
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_OK);
+    }
+
     err = fmPlatformFreeBuffer(buf);
 
     if (err == FM_OK)
@@ -536,6 +547,119 @@ fm_buffer *fmDuplicateBufferChain(fm_int sw, fm_buffer *srcFrame)
 
 
 
+/*****************************************************************************/
+/** fmShareBufferChain
+ * \ingroup intBuffer
+ *
+ * \desc            Adds owners to a buffer chain, so that the same chain can
+ *                  be handed to several consumers without being copied. Each
+ *                  owner releases the chain with ''fmFreeBufferChain'', and
+ *                  must call ''fmUnshareBufferChain'' before modifying it.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       bufChain points to the first buffer in the chain.
+ *
+ * \param[in]       numShares is the number of owners to add.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_BAD_BUFFER if bufChain is invalid.
+ *
+ *****************************************************************************/
+fm_status fmShareBufferChain(fm_int sw, fm_buffer *bufChain, fm_int numShares)
+{
+    fm_buffer *curBuffer;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d bufChain=%p numShares=%d\n",
+                     sw,
+                     (void *) bufChain,
+                     numShares);
+
+    if (bufChain == NULL)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_ERR_BAD_BUFFER);
+    }
+
+    for (curBuffer = bufChain ; curBuffer != NULL ; curBuffer = curBuffer->next)
+    {
+        __sync_fetch_and_add(&curBuffer->shareCount, numShares);
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_BUFFER, FM_OK);
+
+}   /* end fmShareBufferChain */
+
+
+
+
+/*****************************************************************************/
+/** fmUnshareBufferChain
+ * \ingroup buffer
+ *
+ * \desc            Returns a buffer chain the caller may modify. A received
+ *                  packet delivered to several processes is shared between
+ *                  them; in that case the chain is copied and the caller's
+ *                  reference on the shared chain is released. An unshared
+ *                  chain is returned as is.
+ *
+ * \note            The chains passed to the application's event handler
+ *                  are only unshared if the process has called
+ *                  ''fmSetProcessPacketWritable''. Otherwise a handler
+ *                  that modifies a packet must call this function first.
+ *
+ * \param[in]       sw is not used. This is a legacy argument for backward
+ *                  compatibility with existing applications.
+ *
+ * \param[in]       bufChain points to the first buffer in the chain.
+ *
+ * \return          Pointer to the first buffer of the chain to use in place
+ *                  of bufChain.
+ * \return          NULL if the chain could not be copied, in which case
+ *                  bufChain is left untouched.
+ *
+ *****************************************************************************/
+fm_buffer *fmUnshareBufferChain(fm_int sw, fm_buffer *bufChain)
+{
+    fm_buffer *curBuffer;
+    fm_buffer *newChain;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_BUFFER,
+                     "sw=%d bufChain=%p\n",
+                     sw,
+                     (void *) bufChain);
+
+    newChain = bufChain;
+
+    for (curBuffer = bufChain ; curBuffer != NULL ; curBuffer = curBuffer->next)
+    {
+        if (curBuffer->shareCount > 0)
+        {
+            break;
+        }
+    }
+
+    if (curBuffer != NULL)
+    {
+        newChain = fmDuplicateBufferChain(sw, bufChain);
+
+        if (newChain != NULL)
+        {
+            fmFreeBufferChain(sw, bufChain);
+        }
+    }
+
+    FM_LOG_EXIT_API_CUSTOM(FM_LOG_CAT_BUFFER,
+                           newChain,
+                           "newChain=%p\n",
+                           (void *) newChain);
+
+}   /* end fmUnshareBufferChain */
+
+
+
+
 /*****************************************************************************/
 /** fmFreeBufferQueueNode
  * \ingroup intBuffer
@@ -60,6 +60,10 @@ fm_bool localDispatchThreadExit = FALSE;
  *****************************************************************************/
 static fm_bool enableFramePriority = FALSE;
 
+/* Whether this process's event handler modifies received packets, see
+ * fmSetProcessPacketWritable */
+static fm_bool handlerModifiesPackets = FALSE;
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -69,18 +73,163 @@ static fm_bool enableFramePriority = FALSE;
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** ReclaimRetiredSnapshots
+ * \ingroup intSwitch
+ *
+ * \desc            Frees the local delivery snapshots that have been
+ *                  replaced. Must only be called by the event distributor
+ *                  between two events, when it no longer references any
+ *                  snapshot.
+ *
+ * \param           None.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void ReclaimRetiredSnapshots(void)
+{
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDeliverySnapshot *next;
+
+    fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
+    snapshot = fmRootApi->localDeliveryRetired;
+    fmRootApi->localDeliveryRetired = NULL;
+    fmReleaseLock(&fmRootApi->localDeliveryLock);
+
+    while (snapshot != NULL)
+    {
+        next = snapshot->nextRetired;
+        fmFree(snapshot);
+        snapshot = next;
+    }
+
+}   /* end ReclaimRetiredSnapshots */
+
+
+
 
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** fmPublishLocalDeliverySnapshot
+ * \ingroup intSwitch
+ *
+ * \desc            Publishes an immutable copy of the local delivery list
+ *                  for ''fmDistributeEvent''. Must be called with the local
+ *                  delivery lock held, after each change of the list.
+ *
+ * \param           None.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the snapshot could not be allocated, in
+ *                  which case the previous snapshot remains in use.
+ *
+ *****************************************************************************/
+fm_status fmPublishLocalDeliverySnapshot(void)
+{
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDeliverySnapshot *oldSnapshot;
+    fm_dlist_node *           node;
+    fm_uint                   count;
+    fm_uint                   i;
+
+    count    = fmRootApi->localDeliveryCount;
+    snapshot = fmAlloc( sizeof(fm_localDeliverySnapshot) +
+                        count * sizeof(fm_localDelivery) );
+
+    if (snapshot == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head );
+
+    for (i = 0 ; (node != NULL) && (i < count) ; i++)
+    {
+        snapshot->delivery[i] = *(fm_localDelivery *) node->data;
+        node = FM_DLL_GET_NEXT(node, nextPtr);
+    }
+
+    snapshot->count       = i;
+    snapshot->nextRetired = NULL;
+
+    /* The snapshot must be complete before it becomes visible */
+    __sync_synchronize();
+
+    oldSnapshot = fmRootApi->localDeliverySnapshot;
+    fmRootApi->localDeliverySnapshot = snapshot;
+
+    if (oldSnapshot != NULL)
+    {
+        oldSnapshot->nextRetired        = fmRootApi->localDeliveryRetired;
+        fmRootApi->localDeliveryRetired = oldSnapshot;
+    }
+
+    return FM_OK;
+
+}   /* end fmPublishLocalDeliverySnapshot */
+
+
+
+
+/*****************************************************************************/
+/** HasRemoteDelivery
+ * \ingroup intSwitch
+ *
+ * \desc            Determines whether an event is delivered to a process
+ *                  other than the calling one.
+ *
+ * \param[in]       delivery points to the local delivery snapshot entries.
+ *
+ * \param[in]       count is the number of entries.
+ *
+ * \param[in]       eventType is the type of the event.
+ *
+ * \return          TRUE if another process receives the event.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+static fm_bool HasRemoteDelivery(fm_localDelivery *delivery,
+                                 fm_uint           count,
+                                 fm_uint32         eventType)
+{
+    fm_int  myProcessId;
+    fm_uint i;
+
+    myProcessId = fmGetCurrentProcessId();
+
+    for (i = 0 ; i < count ; i++)
+    {
+        if ( (delivery[i].mask & eventType) &&
+             (delivery[i].processId != myProcessId) )
+        {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+
+}   /* end HasRemoteDelivery */
+
+
+
+
 /*****************************************************************************/
 /** fmDistributeEvent
  * \ingroup intSwitch
  *
  * \desc            distributes events to those processes that have registered
- *                  an interest in the particular event.
+ *                  an interest in the particular event. A received packet
+ *                  delivered to several processes is shared between them
+ *                  rather than copied for each.
+ *
+ * \note            Only called from the global event handler thread, which
+ *                  is what allows retired delivery snapshots to be
+ *                  reclaimed here without further synchronization.
  *
  * \param[in]       event points to the event structure.
  *
@@ -89,42 +238,51 @@ static fm_bool enableFramePriority = FALSE;
  *****************************************************************************/
 void fmDistributeEvent(fm_event *event)
 {
-    fmCaptureLock(&fmRootApi->localDeliveryLock, FM_WAIT_FOREVER);
-
+    fm_localDeliverySnapshot *snapshot;
+    fm_localDelivery *        delivery;
+    fm_uint                   count;
+    fm_uint                   i;
+    fm_uint                   pktDeliveryCount = 0;
+    fm_eventPktRecv *         rcvPktEvent = NULL;
+    fm_status                 status;
+    fm_buffer                 *buffer;
+    fm_bool                   isPktEvent;
+    fm_bool                   sharePkt = FALSE;
+
+    /**************************************************
+     * We want to have a consistent snapshot of the
+     * local delivery list without holding the lock
+     * while we deliver all the events. The list is
+     * published as an immutable snapshot whenever it
+     * changes, so just pick up the current one.
+     **************************************************/
+
+    if (fmRootApi->localDeliveryRetired != NULL)
     {
-        /**************************************************
-         * We want to have a consistent snapshot of the
-         * local delivery list, but we don't want to hold
-         * the lock while we deliver all the events, so we
-         * briefly grab the lock and copy the list into a
-         * C99 variable-size array.
-         **************************************************/
+        ReclaimRetiredSnapshots();
+    }
 
-        fm_uint          count = fmRootApi->localDeliveryCount;
-        fm_localDelivery delivery[count];
-        fm_dlist_node *  node;
-        fm_uint          i;
-        fm_uint          pktDeliveryCount = 0;
-        fm_eventPktRecv *rcvPktEvent = NULL;
-        fm_status        status;
-        fm_buffer        *buffer;
+    snapshot = fmRootApi->localDeliverySnapshot;
+    count    = (snapshot != NULL) ? snapshot->count : 0;
+    delivery = (snapshot != NULL) ? snapshot->delivery : NULL;
 
-        node = FM_DLL_GET_FIRST( (&fmRootApi->localDeliveryThreads), head );
+    isPktEvent = ( (event->type == FM_EVENT_PKT_RECV) ||
+                   (event->type == FM_EVENT_SFLOW_PKT_RECV) );
 
-        for (i = 0 ; (node != NULL) && (i < count) ; i++)
+    for (i = 0 ; i < count ; i++)
+    {
+        if ( (delivery[i].mask & 
+              (FM_EVENT_PKT_RECV | FM_EVENT_SFLOW_PKT_RECV)) &
+              event->type )
         {
-            delivery[i] = *(fm_localDelivery *) node->data;
-
-            if ( (delivery[i].mask & 
-                  (FM_EVENT_PKT_RECV | FM_EVENT_SFLOW_PKT_RECV)) &
-                  event->type )
-            {
-                /* Found thread we need to deliver packet to. */
-                pktDeliveryCount++;
-            }
-
-            node = FM_DLL_GET_NEXT(node, nextPtr);
+            /* Found thread we need to deliver packet to. */
+            pktDeliveryCount++;
         }
+    }
+
+    if (isPktEvent)
+    {
+        rcvPktEvent = &event->info.fpPktEvent;
 
         /**************************************************
          * If the event is packet receive but no one has
@@ -132,11 +290,8 @@ void fmDistributeEvent(fm_event *event)
          * packet buffer and return.
          **************************************************/
 
-        if ( ( (event->type == FM_EVENT_PKT_RECV) ||
-               (event->type == FM_EVENT_SFLOW_PKT_RECV) ) 
-             && (pktDeliveryCount == 0) )
+        if (pktDeliveryCount == 0)
         {
-            rcvPktEvent = &event->info.fpPktEvent;
             if (enableFramePriority)
             {
                 status = fmFreeBufferQueueNode(event->sw, rcvPktEvent);
@@ -152,174 +307,201 @@ void fmDistributeEvent(fm_event *event)
             }
             fmFreeBufferChain(event->sw, rcvPktEvent->pkt);
             fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
-            fmReleaseLock(&fmRootApi->localDeliveryLock);
             return;
         }
 
-        /* valid actually found */
-        count = i;
-        fmReleaseLock(&fmRootApi->localDeliveryLock);
-
         /**************************************************
-         * Now we do the actual delivery
+         * A chain pointing into memory mapped by this
+         * process, such as a packet ring, can't be handed
+         * to another process. Replace it with a copy if
+         * another process is interested in the packet.
          **************************************************/
 
-        for (i = 0 ; i < count ; i++)
+        if ( HasRemoteDelivery(delivery, count, event->type) &&
+             fmPlatformBufferChainHasView(rcvPktEvent->pkt) )
         {
-            fm_event *localEvent = NULL;
-            fm_uint64 nanos      = MIN_WAIT_NANOS;
-            fm_status err        = FM_FAIL;
-            fm_uint32 numUpdates;
+            buffer = fmDuplicateBufferChain(event->sw, rcvPktEvent->pkt);
+            fmFreeBufferChain(event->sw, rcvPktEvent->pkt);
 
-            if ( (delivery[i].mask & event->type) == 0 )
+            if (buffer == NULL)
             {
-                continue;
+                if (enableFramePriority)
+                {
+                    fmFreeBufferQueueNode(event->sw, rcvPktEvent);
+                }
+                fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
+                return;
             }
 
-            /**************************************************
-             * Always use high priority for the locally dispatched
-             * events, because DistributeEvent is only called from
-             * a single thread (the global event handler), and if
-             * we allocated both low and high priority events here,
-             * we could get priority inversion.
-             **************************************************/
+            rcvPktEvent->pkt = buffer;
+        }
 
-            while (localEvent == NULL)
-            {
-                localEvent = fmAllocateEvent(event->sw,
-                                             event->eventID,
-                                             event->type,
-                                             FM_EVENT_PRIORITY_HIGH);
+        /**************************************************
+         * Every interested process gets a reference on the
+         * same buffer chain. Buffer queues track a chain
+         * per receive event, so with frame prioritization
+         * the chain is still copied for each process.
+         **************************************************/
 
-                if (localEvent == NULL)
-                {
-                    DELAY_NANOS(nanos);
-                    nanos *= 2;
+        if ( (pktDeliveryCount > 1) && !enableFramePriority )
+        {
+            fmShareBufferChain(event->sw,
+                               rcvPktEvent->pkt,
+                               pktDeliveryCount - 1);
+            sharePkt = TRUE;
+        }
+    }
 
-                    if (nanos > MAX_WAIT_NANOS)
-                    {
-                        nanos = MAX_WAIT_NANOS;
-                        FM_LOG_WARNING(FM_LOG_CAT_EVENT,
-                                       "Waiting to allocate event of type %d "
-                                       "for switch %d\n",
-                                       event->type,
-                                       event->sw);
-                    }
-                }
-            }
+    /**************************************************
+     * Now we do the actual delivery
+     **************************************************/
 
-            if (event->type == FM_EVENT_TABLE_UPDATE)
-            {
-                /**************************************************
-                 * Because the updates field is a pointer to memory
-                 * that has been "secretly" allocated after the event,
-                 * rather than just being part of the union, we have
-                 * to handle it specially.
-                 **************************************************/
-
-                numUpdates = event->info.fpUpdateEvent.numUpdates;
-                localEvent->info.fpUpdateEvent.numUpdates = numUpdates;
-                FM_MEMCPY_S( localEvent->info.fpUpdateEvent.updates,
-                             numUpdates * sizeof(fm_eventTableUpdate),
-                             event->info.fpUpdateEvent.updates,
-                             numUpdates * sizeof(fm_eventTableUpdate) );
-            }
-            else if (event->type == FM_EVENT_PURGE_SCAN_COMPLETE)
-            {
-                localEvent->info.purgeScanComplete = event->info.purgeScanComplete;
-            } 
-            else if ( (event->type == FM_EVENT_PKT_RECV) ||
-                      (event->type == FM_EVENT_SFLOW_PKT_RECV) )
-            {
-                rcvPktEvent = &event->info.fpPktEvent;
+    for (i = 0 ; i < count ; i++)
+    {
+        fm_event *localEvent = NULL;
+        fm_uint64 nanos      = MIN_WAIT_NANOS;
+        fm_status err        = FM_FAIL;
+        fm_uint32 numUpdates;
 
-                /**************************************************
-                 * Copy the whole event, including the packet, to
-                 * localEvent. If this is not the last registered
-                 * client, we will overwrite the packet with a
-                 * clone.
-                 **************************************************/
+        if ( (delivery[i].mask & event->type) == 0 )
+        {
+            continue;
+        }
+
+        /**************************************************
+         * Always use high priority for the locally dispatched
+         * events, because DistributeEvent is only called from
+         * a single thread (the global event handler), and if
+         * we allocated both low and high priority events here,
+         * we could get priority inversion.
+         **************************************************/
 
-                localEvent->info = event->info;
+        while (localEvent == NULL)
+        {
+            localEvent = fmAllocateEvent(event->sw,
+                                         event->eventID,
+                                         event->type,
+                                         FM_EVENT_PRIORITY_HIGH);
 
-                /**************************************************
-                 * If there is more than one remaining process that is
-                 * interested in receive packet events, clone the
-                 * receive buffer for delivery.
-                 **************************************************/
+            if (localEvent == NULL)
+            {
+                DELAY_NANOS(nanos);
+                nanos *= 2;
 
-                if (pktDeliveryCount-- > 1)
+                if (nanos > MAX_WAIT_NANOS)
                 {
-                    if (enableFramePriority)
-                    {
-                        FM_LOG_ERROR(FM_LOG_CAT_EVENT,
-                                     "Prioritization is supported only for the"
-                                     "first registered process. Subsequent "
-                                     "processes follow normal buffer allocation"
-                                     " without prioritization.\n");
-                    }
-                    localEvent->info.fpPktEvent.pkt =
-                        fmDuplicateBufferChain(event->sw, rcvPktEvent->pkt);
+                    nanos = MAX_WAIT_NANOS;
+                    FM_LOG_WARNING(FM_LOG_CAT_EVENT,
+                                   "Waiting to allocate event of type %d "
+                                   "for switch %d\n",
+                                   event->type,
+                                   event->sw);
+                }
+            }
+        }
 
-                    if (localEvent->info.fpPktEvent.pkt == NULL)
-                    {
-                        /**************************************************
-                         * Couldn't copy the packet. Free the event so that
-                         * it is not lost and continue the loop.
-                         **************************************************/
-
-                        fmReleaseEvent(localEvent);
-                        fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
-                        continue;
-                    }
+        if (event->type == FM_EVENT_TABLE_UPDATE)
+        {
+            /**************************************************
+             * Because the updates field is a pointer to memory
+             * that has been "secretly" allocated after the event,
+             * rather than just being part of the union, we have
+             * to handle it specially.
+             **************************************************/
 
-                }
+            numUpdates = event->info.fpUpdateEvent.numUpdates;
+            localEvent->info.fpUpdateEvent.numUpdates = numUpdates;
+            FM_MEMCPY_S( localEvent->info.fpUpdateEvent.updates,
+                         numUpdates * sizeof(fm_eventTableUpdate),
+                         event->info.fpUpdateEvent.updates,
+                         numUpdates * sizeof(fm_eventTableUpdate) );
+        }
+        else if (event->type == FM_EVENT_PURGE_SCAN_COMPLETE)
+        {
+            localEvent->info.purgeScanComplete = event->info.purgeScanComplete;
+        } 
+        else if (isPktEvent)
+        {
+            /**************************************************
+             * Copy the whole event, including the packet, to
+             * localEvent. When the chain is shared, every
+             * process gets the same chain, and its local
+             * dispatch thread unshares it before handing it to
+             * the application. Otherwise, if this
+             * is not the last registered client, we will
+             * overwrite the packet with a clone.
+             **************************************************/
 
-                if (enableFramePriority)
+            localEvent->info = event->info;
+
+            if (!sharePkt && (pktDeliveryCount-- > 1))
+            {
+                FM_LOG_ERROR(FM_LOG_CAT_EVENT,
+                             "Prioritization is supported only for the"
+                             "first registered process. Subsequent "
+                             "processes follow normal buffer allocation"
+                             " without prioritization.\n");
+
+                localEvent->info.fpPktEvent.pkt =
+                    fmDuplicateBufferChain(event->sw, rcvPktEvent->pkt);
+
+                if (localEvent->info.fpPktEvent.pkt == NULL)
                 {
-                    buffer = ((fm_buffer *)(localEvent->info.fpPktEvent.pkt));
-                    buffer->recvEvent = localEvent;
+                    /**************************************************
+                     * Couldn't copy the packet. Free the event so that
+                     * it is not lost and continue the loop.
+                     **************************************************/
+
+                    fmReleaseEvent(localEvent);
+                    fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
+                    continue;
                 }
-            }
-            else
-            {
-                /**************************************************
-                 * Otherwise, we can just copy the whole union
-                 * without worrying what type it is.
-                 **************************************************/
 
-                localEvent->info = event->info;
             }
 
+            if (enableFramePriority)
+            {
+                buffer = ((fm_buffer *)(localEvent->info.fpPktEvent.pkt));
+                buffer->recvEvent = localEvent;
+            }
+        }
+        else
+        {
             /**************************************************
-             * Now try to send the event to the local dispatch
-             * thread, using exponential backoff if the event
-             * queue is full.
+             * Otherwise, we can just copy the whole union
+             * without worrying what type it is.
              **************************************************/
 
-            nanos = MIN_WAIT_NANOS;
+            localEvent->info = event->info;
+        }
 
-            while (err != FM_OK)
-            {
-                err = fmSendThreadEvent(delivery[i].thread, localEvent);
+        /**************************************************
+         * Now try to send the event to the local dispatch
+         * thread, using exponential backoff if the event
+         * queue is full.
+         **************************************************/
 
-                if (err != FM_OK)
-                {
-                    DELAY_NANOS(nanos);
-                    nanos *= 2;
+        nanos = MIN_WAIT_NANOS;
 
-                    if (nanos > MAX_WAIT_NANOS)
-                    {
-                        nanos = MAX_WAIT_NANOS;
-                    }
+        while (err != FM_OK)
+        {
+            err = fmSendThreadEvent(delivery[i].thread, localEvent);
 
-                }   /* end if (err != FM_OK) */
+            if (err != FM_OK)
+            {
+                DELAY_NANOS(nanos);
+                nanos *= 2;
 
-            }   /* end while (err != FM_OK) */
+                if (nanos > MAX_WAIT_NANOS)
+                {
+                    nanos = MAX_WAIT_NANOS;
+                }
 
-        }   /* end for (i = 0 ; i < count ; i++) */
+            }   /* end if (err != FM_OK) */
 
-    }   /* end (local scope) */
+        }   /* end while (err != FM_OK) */
+
+    }   /* end for (i = 0 ; i < count ; i++) */
 
 }   /* end fmDistributeEvent */
 
@@ -863,11 +1045,46 @@ FINISHED:
 
 
 
+/*****************************************************************************/
+/** GetHandlerPacket
+ * \ingroup intSwitch
+ *
+ * \desc            Returns the buffer chain of a received packet to hand to
+ *                  the application's event handler. The chain may be shared
+ *                  with other processes; it is only copied if the handler
+ *                  was declared to modify packets.
+ *
+ * \param[in]       sw is the switch on which the packet was received.
+ *
+ * \param[in]       pkt points to the received chain.
+ *
+ * \return          Pointer to the chain to hand to the handler.
+ * \return          NULL if the chain could not be copied, in which case pkt
+ *                  is left untouched.
+ *
+ *****************************************************************************/
+static fm_buffer *GetHandlerPacket(fm_int sw, fm_buffer *pkt)
+{
+    if (!handlerModifiesPackets)
+    {
+        return pkt;
+    }
+
+    return fmUnshareBufferChain(sw, pkt);
+
+}   /* end GetHandlerPacket */
+
+
+
+
 /*****************************************************************************/
 /** fmLocalEventHandler
  * \ingroup intSwitch
  *
- * \desc            event handler for local dispatch thread
+ * \desc            event handler for local dispatch thread. A received
+ *                  packet shared with other processes is unshared before
+ *                  it is handed to the application only if the process
+ *                  declared that its handler modifies packets.
  *
  * \param[in]       args points to the thread arguments
  *
@@ -878,6 +1095,7 @@ void *fmLocalEventHandler(void *args)
 {
     fm_thread *thread;
     fm_event * event;
+    fm_buffer *pkt;
     fm_status  status;
 
     /* grab arguments */
@@ -915,6 +1133,31 @@ void *fmLocalEventHandler(void *args)
             }
         }
         
+        /**************************************************
+         * A chain shared with other processes is read-only.
+         * If the application modifies packets in place, it
+         * gets a copy. The copy is made here rather than in
+         * fmDistributeEvent, so that it does not hold up the
+         * global event handler thread, and the process
+         * releasing the chain last gets it without a copy.
+         **************************************************/
+        if ( (fmEventHandler != NULL) &&
+             ( (event->type == FM_EVENT_PKT_RECV) ||
+               (event->type == FM_EVENT_SFLOW_PKT_RECV) ) )
+        {
+            pkt = GetHandlerPacket(event->sw, event->info.fpPktEvent.pkt);
+
+            if (pkt == NULL)
+            {
+                fmFreeBufferChain(event->sw, event->info.fpPktEvent.pkt);
+                fmDbgDiagCountIncr(event->sw, FM_CTR_RX_API_PKT_DROPS, 1);
+                fmReleaseEvent(event);
+                continue;
+            }
+
+            event->info.fpPktEvent.pkt = pkt;
+        }
+
         if (fmEventHandler != NULL)
         {
             fmEventHandler(event->type, event->sw, &event->info);
@@ -981,7 +1224,16 @@ fm_status fmSetProcessEventMask(fm_uint32 mask)
             }
         }
 
-        err = fmReleaseLock(&fmRootApi->localDeliveryLock);
+        err = fmPublishLocalDeliverySnapshot();
+
+        if (err == FM_OK)
+        {
+            err = fmReleaseLock(&fmRootApi->localDeliveryLock);
+        }
+        else
+        {
+            (void) fmReleaseLock(&fmRootApi->localDeliveryLock);
+        }
 
         if (count != expectedCount)
         {
@@ -1001,6 +1253,167 @@ fm_status fmSetProcessEventMask(fm_uint32 mask)
 
 
 
+/*****************************************************************************/
+/** fmSetProcessPacketWritable
+ * \ingroup api
+ *
+ * \desc            Declares whether the current process's event handler
+ *                  modifies the received packets it is given.
+ *                                                                      \lb\lb
+ *                  A packet delivered to several processes is shared
+ *                  between them rather than copied for each, and by
+ *                  default the handler must treat it as read-only. If the
+ *                  handler modifies packets in place, set writable to TRUE
+ *                  and each shared packet is copied before it is handed
+ *                  to the handler. A handler may also call
+ *                  ''fmUnshareBufferChain'' itself on the packets it
+ *                  modifies.
+ *
+ * \param[in]       writable is TRUE if the handler modifies packets.
+ *
+ * \return          FM_OK
+ *
+ *****************************************************************************/
+fm_status fmSetProcessPacketWritable(fm_bool writable)
+{
+    FM_LOG_ENTRY_API(FM_LOG_CAT_API, "writable=%d\n", writable);
+
+    handlerModifiesPackets = writable;
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_API, FM_OK);
+
+}   /* end fmSetProcessPacketWritable */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgPacketFanOutTest
+ * \ingroup intDiagMisc
+ *
+ * \desc            Checks that a packet fanned out to several subscribers
+ *                  is only copied for subscribers that modify packets. A
+ *                  chain is shared between numSubscribers owners, each of
+ *                  which gets it through the same path as the local
+ *                  dispatch thread and then frees it. The number of buffers
+ *                  allocated on the way must be 0 if writable is FALSE,
+ *                  and numSubscribers - 1 if it is TRUE, and every buffer
+ *                  must be back in the pool at the end.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       numSubscribers is the number of subscribers.
+ *
+ * \param[in]       writable is TRUE to test subscribers that modify packets,
+ *                  as declared with ''fmSetProcessPacketWritable''.
+ *
+ * \return          FM_OK if the test passes.
+ * \return          FM_FAIL if the test fails.
+ * \return          FM_ERR_INVALID_ARGUMENT if numSubscribers is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          FM_ERR_NO_FREE_RESOURCES if no buffer could be allocated.
+ *
+ *****************************************************************************/
+fm_status fmDbgPacketFanOutTest(fm_int sw, fm_int numSubscribers, fm_bool writable)
+{
+    fm_buffer **pkts;
+    fm_buffer * chain;
+    fm_bool     savedWritable;
+    fm_uint64   allocsBefore;
+    fm_uint64   allocsAfter;
+    fm_int      availBefore;
+    fm_int      availAfter;
+    fm_int      expected;
+    fm_int      numPkts;
+    fm_int      i;
+    fm_status   err;
+
+    if (numSubscribers < 1)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    pkts = fmAlloc(numSubscribers * sizeof(fm_buffer *));
+    if (pkts == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    fmPlatformGetAvailableBuffers(&availBefore);
+
+    chain = fmAllocateBuffer(sw);
+    if (chain == NULL)
+    {
+        fmFree(pkts);
+        return FM_ERR_NO_FREE_RESOURCES;
+    }
+
+    chain->len = FM_BUFFER_SIZE_BYTES;
+
+    if (numSubscribers > 1)
+    {
+        fmShareBufferChain(sw, chain, numSubscribers - 1);
+    }
+
+    savedWritable          = handlerModifiesPackets;
+    handlerModifiesPackets = writable;
+
+    fmDbgGlobalDiagCountGet(FM_GLOBAL_CTR_BUFFER_ALLOCS, &allocsBefore);
+
+    for (numPkts = 0 ; numPkts < numSubscribers ; numPkts++)
+    {
+        pkts[numPkts] = GetHandlerPacket(sw, chain);
+
+        if (pkts[numPkts] == NULL)
+        {
+            break;
+        }
+    }
+
+    fmDbgGlobalDiagCountGet(FM_GLOBAL_CTR_BUFFER_ALLOCS, &allocsAfter);
+
+    handlerModifiesPackets = savedWritable;
+
+    /* The subscribers whose copy failed still own the shared chain */
+    for (i = numPkts ; i < numSubscribers ; i++)
+    {
+        fmFreeBufferChain(sw, chain);
+    }
+
+    for (i = 0 ; i < numPkts ; i++)
+    {
+        fmFreeBufferChain(sw, pkts[i]);
+    }
+
+    fmFree(pkts);
+
+    fmPlatformGetAvailableBuffers(&availAfter);
+
+    expected = writable ? (numSubscribers - 1) : 0;
+    err      = FM_OK;
+
+    FM_LOG_PRINT("%d subscribers, %s: %" FM_FORMAT_64 "u copies "
+                 "(expected %d), %d buffers leaked\n",
+                 numSubscribers,
+                 writable ? "writable" : "read-only",
+                 allocsAfter - allocsBefore,
+                 expected,
+                 availBefore - availAfter);
+
+    if ( (numPkts != numSubscribers) ||
+         (allocsAfter - allocsBefore != (fm_uint64) expected) ||
+         (availAfter != availBefore) )
+    {
+        err = FM_FAIL;
+    }
+
+    return err;
+
+}   /* end fmDbgPacketFanOutTest */
+
+
+
+
 /*****************************************************************************/
 /** fmRemoveEventHandler
  * \ingroup intApi
@@ -1014,12 +1427,15 @@ fm_status fmSetProcessEventMask(fm_uint32 mask)
  * \return          FM_OK if successful.
  * \return          FM_ERR_NOT_FOUND if there is no delivery structure for
  *                  the calling process.
+ * \return          FM_ERR_NO_MEM if the delivery list snapshot could not be
+ *                  published, in which case the handler remains registered.
  *
  *****************************************************************************/
 fm_status fmRemoveEventHandler(fm_localDelivery ** delivery)
 {
     fm_status         err;
     fm_dlist_node *   node;
+    fm_dlist_node *   next;
     fm_localDelivery *cur;
     fm_int            myProcessId;
 
@@ -1046,9 +1462,41 @@ fm_status fmRemoveEventHandler(fm_localDelivery ** delivery)
 
         if (node != NULL) 
         {
-            fmDListRemove(&fmRootApi->localDeliveryThreads, node);
-            *delivery = cur;
+            /**************************************************
+             * Unlink the node without freeing it, so that it
+             * can be put back if the snapshot without it cannot
+             * be published: fmDistributeEvent would otherwise
+             * keep delivering to a handler the caller is about
+             * to release.
+             **************************************************/
+            next = FM_DLL_GET_NEXT(node, nextPtr);
+
+            FM_DLL_REMOVE_NODE( (&fmRootApi->localDeliveryThreads),
+                                head,
+                                tail,
+                                node,
+                                nextPtr,
+                                prev );
             fmRootApi->localDeliveryCount--;
+
+            err = fmPublishLocalDeliverySnapshot();
+
+            if (err == FM_OK)
+            {
+                fmFree(node);
+                *delivery = cur;
+            }
+            else
+            {
+                FM_DLL_INSERT_BEFORE( (&fmRootApi->localDeliveryThreads),
+                                      head,
+                                      tail,
+                                      next,
+                                      nextPtr,
+                                      prev,
+                                      node );
+                fmRootApi->localDeliveryCount++;
+            }
         }
         else
         {
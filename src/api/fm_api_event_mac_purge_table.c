@@ -1059,6 +1059,189 @@ static void RemovePendingPurgeEntryData(fm_maPurgeListEntry *purgeEntry,
 }    /* end RemovePendingPurgeEntryData */
 
 
+
+
+/*****************************************************************************/
+/** BenchmarkFlushMatch
+ * \ingroup intAddr
+ *
+ * \desc            Determines whether a synthetic MA Table entry would be
+ *                  purged by a flush of a port, VLAN or both. Mirrors the
+ *                  purge criteria for dynamic entries.
+ *
+ * \param[in]       entry points to the MA Table entry.
+ *
+ * \param[in]       port is the port to flush, or -1 for all ports.
+ *
+ * \param[in]       vlan is the VLAN to flush, or -1 for all VLANs.
+ *
+ * \return          TRUE if the entry would be purged.
+ *
+ *****************************************************************************/
+static fm_bool BenchmarkFlushMatch(fm_internalMacAddrEntry *entry,
+                                   fm_int                   port,
+                                   fm_int                   vlan)
+{
+    if (entry->state == FM_MAC_ENTRY_STATE_INVALID ||
+        entry->state == FM_MAC_ENTRY_STATE_LOCKED)
+    {
+        return FALSE;
+    }
+
+    if (entry->state == FM_MAC_ENTRY_STATE_EXPIRED)
+    {
+        return TRUE;
+    }
+
+    return ( (port < 0 || entry->port == port) &&
+             (vlan < 0 || entry->vlanID == vlan) );
+
+}   /* end BenchmarkFlushMatch */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkFlush
+ * \ingroup intAddr
+ *
+ * \desc            Times the selection of the entries to purge for one
+ *                  flush of a synthetic MA Table, by scanning the whole
+ *                  table and by walking the index lists, and prints the
+ *                  result.
+ *
+ * \param[in]       desc is the flush description to print.
+ *
+ * \param[in]       table points to the synthetic MA Table.
+ *
+ * \param[in]       maIndex points to the index over table.
+ *
+ * \param[in]       port is the port to flush, or -1 for all ports.
+ *
+ * \param[in]       vlan is the VLAN to flush, or -1 for all VLANs.
+ *
+ * \param[in]       iterations is the number of times to repeat the flush.
+ *
+ * \return          TRUE if both methods selected the same entries.
+ *
+ *****************************************************************************/
+static fm_bool BenchmarkFlush(fm_text                  desc,
+                              fm_internalMacAddrEntry *table,
+                              fm_maTableIndex *        maIndex,
+                              fm_int                   port,
+                              fm_int                   vlan,
+                              fm_int                   iterations)
+{
+    fm_maTableIndexType type;
+    fm_int              key;
+    fm_int              pass;
+    fm_int              entryIndex;
+    fm_int              scanMatches;
+    fm_int              indexMatches;
+    fm_int              examined;
+    fm_timestamp        start;
+    fm_timestamp        end;
+    fm_timestamp        scanTime;
+    fm_timestamp        indexTime;
+    fm_uint64           scanUsec;
+    fm_uint64           indexUsec;
+
+    if ( port >= 0 &&
+         ( vlan < 0 ||
+           fmGetAddrTableIndexCount(maIndex, FM_MA_INDEX_PORT, port) <=
+           fmGetAddrTableIndexCount(maIndex, FM_MA_INDEX_VLAN, vlan) ) )
+    {
+        type = FM_MA_INDEX_PORT;
+        key  = port;
+    }
+    else
+    {
+        type = FM_MA_INDEX_VLAN;
+        key  = vlan;
+    }
+
+    /* Scan the whole table. */
+    scanMatches = 0;
+    fmGetTime(&start);
+
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        scanMatches = 0;
+
+        for (entryIndex = 0 ; entryIndex < maIndex->numEntries ; entryIndex++)
+        {
+            if ( BenchmarkFlushMatch(&table[entryIndex], port, vlan) )
+            {
+                scanMatches++;
+            }
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &scanTime);
+
+    /* Walk the expired list and the shorter of the port and VLAN lists. */
+    indexMatches = 0;
+    examined     = 0;
+    fmGetTime(&start);
+
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        indexMatches = 0;
+        examined     = 0;
+
+        for (entryIndex = fmGetAddrTableIndexFirst(maIndex,
+                                                   FM_MA_INDEX_EXPIRED,
+                                                   0) ;
+             entryIndex >= 0 ;
+             entryIndex = fmGetAddrTableIndexNext(maIndex,
+                                                  FM_MA_INDEX_EXPIRED,
+                                                  entryIndex) )
+        {
+            examined++;
+            indexMatches++;
+        }
+
+        for (entryIndex = fmGetAddrTableIndexFirst(maIndex, type, key) ;
+             entryIndex >= 0 ;
+             entryIndex = fmGetAddrTableIndexNext(maIndex, type, entryIndex) )
+        {
+            if (table[entryIndex].state == FM_MAC_ENTRY_STATE_EXPIRED)
+            {
+                continue;
+            }
+
+            examined++;
+
+            if ( BenchmarkFlushMatch(&table[entryIndex], port, vlan) )
+            {
+                indexMatches++;
+            }
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &indexTime);
+
+    iterations = (iterations > 0) ? iterations : 1;
+    scanUsec   = scanTime.sec * 1000000 + scanTime.usec;
+    indexUsec  = indexTime.sec * 1000000 + indexTime.usec;
+
+    FM_LOG_PRINT("  %-12s: %6d matches, scan %6d entries %8" FM_FORMAT_64
+                 "u nsec, lists %6d entries %8" FM_FORMAT_64 "u nsec%s\n",
+                 desc,
+                 indexMatches,
+                 maIndex->numEntries,
+                 scanUsec * 1000 / iterations,
+                 examined,
+                 indexUsec * 1000 / iterations,
+                 (scanMatches == indexMatches) ? "" : " MISMATCH");
+
+    return (scanMatches == indexMatches);
+
+}   /* end BenchmarkFlush */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -3714,6 +3897,9 @@ fm_status fmCommonDumpPurgeStats(fm_int sw)
 
     FM_LOG_PRINT("      Total purges         : %u\n", stats.numCompletedOther);
     FM_LOG_PRINT("      With more pending    : %u\n", stats.numCompletedWithMorePending);
+    FM_LOG_PRINT("      Using MA Table lists : %u\n", stats.numCompletedIndexed);
+    FM_LOG_PRINT("      Entries examined     : %" FM_FORMAT_64 "u\n",
+                 stats.numEntriesExamined);
 
     FM_LOG_PRINT("   Per-port purge list entries:\n");
     FM_LOG_PRINT("      Currently allocated  : %u\n", stats.numEntriesAllocated);
@@ -3763,6 +3949,129 @@ fm_status fmDbgResetMACTablePurgeStats(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmDbgBenchmarkMACTableFlush
+ * \ingroup diagMATable
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the cost of finding the entries to purge when
+ *                  flushing a port, a VLAN and a port/VLAN pair from a
+ *                  full MA Table. A synthetic table of the switch's MA
+ *                  Table size is built in memory, with dynamic entries
+ *                  spread evenly over the given ports and VLANs and one
+ *                  entry in 64 expired. Each flush is timed both as a scan
+ *                  of the whole table and as a walk of the port, VLAN and
+ *                  expired entry lists used by purges, and the two are
+ *                  checked to select the same entries. Neither the
+ *                  switch's MA Table nor the hardware is modified.
+ *
+ * \param[in]       sw is the switch whose MA Table size is used.
+ *
+ * \param[in]       numPorts is the number of ports to spread entries over.
+ *
+ * \param[in]       numVlans is the number of VLANs to spread entries over.
+ *
+ * \param[in]       iterations is the number of times to repeat each flush.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if numPorts or numVlans is out
+ *                  of range.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          FM_FAIL if the two methods selected different entries.
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkMACTableFlush(fm_int sw,
+                                      fm_int numPorts,
+                                      fm_int numVlans,
+                                      fm_int iterations)
+{
+    fm_switch *              switchPtr;
+    fm_internalMacAddrEntry *table;
+    fm_maTableIndex          maIndex;
+    fm_int                   numEntries;
+    fm_int                   entryIndex;
+    fm_bool                  match;
+    fm_status                err;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    table     = NULL;
+    FM_CLEAR(maIndex);
+
+    if ( numPorts <= 0 || numPorts >= FM_MA_INDEX_PORT_LISTS ||
+         numVlans <= 0 || numVlans >= FM_MAX_VLAN )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    numEntries = switchPtr->macTableSize;
+
+    table = fmAlloc( numEntries * sizeof(fm_internalMacAddrEntry) );
+    if (table == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    err = fmAllocAddrTableIndex(&maIndex, numEntries);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    /***************************************************
+     * Build a full table.
+     **************************************************/
+
+    memset( table, 0, numEntries * sizeof(fm_internalMacAddrEntry) );
+
+    for (entryIndex = 0 ; entryIndex < numEntries ; entryIndex++)
+    {
+        table[entryIndex].macAddress = 0x000100000000LL + entryIndex;
+        table[entryIndex].port       = 1 + (entryIndex % numPorts);
+        table[entryIndex].vlanID     = 1 + ( (entryIndex / numPorts) % numVlans );
+        table[entryIndex].addrType   = FM_ADDRESS_DYNAMIC;
+        table[entryIndex].state      = ( (entryIndex % 64) == 63 )
+                                       ? FM_MAC_ENTRY_STATE_EXPIRED
+                                       : FM_MAC_ENTRY_STATE_YOUNG;
+
+        fmUpdateAddrTableIndex(&maIndex, entryIndex, &table[entryIndex]);
+    }
+
+    FM_LOG_PRINT("MA Table flush benchmark: %d entries, %d ports, "
+                 "%d vlans, %d passes\n",
+                 numEntries,
+                 numPorts,
+                 numVlans,
+                 iterations);
+
+    match  = BenchmarkFlush("Port", table, &maIndex, 1, -1, iterations);
+    match &= BenchmarkFlush("VLAN", table, &maIndex, -1, 1, iterations);
+    match &= BenchmarkFlush("Port/VLAN", table, &maIndex, 1, 1, iterations);
+
+    err = match ? FM_OK : FM_FAIL;
+
+ABORT:
+    fmFreeAddrTableIndex(&maIndex);
+
+    if (table != NULL)
+    {
+        fmFree(table);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmDbgBenchmarkMACTableFlush */
+
+
+
+
 /*****************************************************************************/
 /** fmCommonResetPurgeStats
  * \ingroup intDiagMATable 
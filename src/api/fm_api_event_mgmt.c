@@ -89,11 +89,11 @@ fm_status fmEventHandlingInitialize(void)
                             1);
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
 
-    err = fmEventQueueInitialize(&fmRootApi->fmEventFreeQueue, FM_MAX_EVENTS,
-                                 "fmEventFreeQueue");
+    err = fmEventStackInitialize(&fmRootApi->fmEventFreeStack, FM_MAX_EVENTS,
+                                 "fmEventFreeStack");
     FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
 
-    /* put all event buffers into the free queue */
+    /* put all event buffers into the free stack */
     for (i = 0 ; i < FM_MAX_EVENTS ; i++)
     {
         /***************************************************
@@ -108,7 +108,9 @@ fm_status fmEventHandlingInitialize(void)
             FM_LOG_EXIT(FM_LOG_CAT_EVENT, FM_ERR_NO_MEM);
         }
 
-        err = fmEventQueueAdd(&fmRootApi->fmEventFreeQueue, ptr);
+        ptr->poolIndex = i;
+
+        err = fmEventStackPush(&fmRootApi->fmEventFreeStack, ptr);
         FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT, err);
     }
 
@@ -140,7 +142,7 @@ fm_status fmEventHandlingInitialize(void)
 /*****************************************************************************
  * fmAllocateEvent
  *
- * Description: Gets an event from the event free queue.
+ * Description: Gets an event from the event free stack.
  *
  * Arguments:   sw is the switch number.
  *
@@ -172,7 +174,7 @@ fm_event *fmAllocateEvent(fm_int           sw,
 
     if (priority == FM_EVENT_PRIORITY_LOW)
     {
-        err = fmEventQueueCount(&fmRootApi->fmEventFreeQueue, &eventCount);
+        err = fmEventStackCount(&fmRootApi->fmEventFreeStack, &eventCount);
         if (err != FM_OK)
         {
             FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_EVENT, NULL, "NULL\n");
@@ -190,7 +192,7 @@ fm_event *fmAllocateEvent(fm_int           sw,
         }
     }
 
-    err = fmEventQueueGet(&fmRootApi->fmEventFreeQueue, &event);
+    err = fmEventStackPop(&fmRootApi->fmEventFreeStack, &event);
 
     if (err != FM_OK)
     {
@@ -227,7 +229,7 @@ fm_event *fmAllocateEvent(fm_int           sw,
 /*****************************************************************************
  * fmReleaseEvent
  *
- * Description: Puts an event back onto the event free queue.
+ * Description: Puts an event back onto the event free stack.
  *
  * Arguments:   event points to the event to be freed.
  *
@@ -245,11 +247,11 @@ fm_status fmReleaseEvent(fm_event *event)
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT, "%p\n", (void *) event);
 
-    fmEventQueueAdd(&fmRootApi->fmEventFreeQueue, event);
+    fmEventStackPush(&fmRootApi->fmEventFreeStack, event);
 
     /* Need to unblock regardless of priority */
     eventCount = 0; /* incase call return error */
-    fmEventQueueCount(&fmRootApi->fmEventFreeQueue, &eventCount);
+    fmEventStackCount(&fmRootApi->fmEventFreeStack, &eventCount);
 
     /* Only release when free event above a threshold */
     if (eventCount > unblockThreshold)
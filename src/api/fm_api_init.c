@@ -1709,6 +1709,7 @@ static fm_status CreateLocalDispatchThread(void)
     if (err == FM_OK)
     {
         fmRootApi->localDeliveryCount++;
+        err = fmPublishLocalDeliverySnapshot();
     }
 
 ABORT:
@@ -1886,7 +1887,9 @@ static fm_status fmApiRootInit(void)
 
     /* initialize the event delivery data structures */
     fmDListInit(&fmRootApi->localDeliveryThreads);
-    fmRootApi->localDeliveryCount = 0;
+    fmRootApi->localDeliveryCount    = 0;
+    fmRootApi->localDeliverySnapshot = NULL;
+    fmRootApi->localDeliveryRetired  = NULL;
 
     err = fmCreateLock("Local event delivery lock",
                        &fmRootApi->localDeliveryLock);
@@ -2094,6 +2097,17 @@ static fm_status fmApiThreadInit(void)
         }
     }
 
+    /* Create statistics collector thread. */
+    if (prop->statsCollectorPer > 0)
+    {
+        err = fmCreateThread("StatsCollectorTask",
+                             FM_EVENT_QUEUE_SIZE_NONE,
+                             fmStatsCollectorTask,
+                             &fmRootApi->eventThread,
+                             &fmRootApi->statsCollectorTask);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_SWITCH, err);
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_SWITCH, err);
 
 }   /* end fmApiThreadInit */
@@ -3306,6 +3320,65 @@ fm_status fmGetSwitchStateExt(fm_int sw, fm_switchState *state)
 
 
 
+/*****************************************************************************/
+/** fmSaveWarmRestartImage
+ * \ingroup switch
+ *
+ * \chips           FM10000
+ *
+ * \desc            Saves the register cache of a switch to the image file
+ *                  named by the ''api.FM10000.warmRestartImage'' property,
+ *                  so that the next process to boot the switch can do a
+ *                  warm restart. The application calls it just before a
+ *                  planned restart of the API process, once it has
+ *                  stopped configuring the switch.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_SWITCH_NOT_UP if the switch is not up.
+ * \return          FM_ERR_UNSUPPORTED if the switch does not support warm
+ *                  restarts or no image file is configured.
+ * \return          FM_FAIL if the image file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmSaveWarmRestartImage(fm_int sw)
+{
+    fm_switch *switchPtr;
+    fm_status  err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_SWITCH, "sw=%d\n", sw);
+
+    VALIDATE_SWITCH_LOCK(sw);
+
+    /* Take write access so that no API call changes the cache meanwhile */
+    err = LOCK_SWITCH(sw);
+    if (err != FM_OK)
+    {
+        FM_LOG_EXIT_API(FM_LOG_CAT_SWITCH, err);
+    }
+
+    switchPtr = fmRootApi->fmSwitchStateTable[sw];
+
+    if (switchPtr == NULL || switchPtr->state != FM_SWITCH_STATE_UP)
+    {
+        err = FM_ERR_SWITCH_NOT_UP;
+    }
+    else
+    {
+        FM_API_CALL_FAMILY(err, switchPtr->SaveWarmRestartImage, sw);
+    }
+
+    UNLOCK_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_SWITCH, err);
+
+}   /* end fmSaveWarmRestartImage */
+
+
+
+
 /*****************************************************************************/
 /** fmSetEventHandler
  * \ingroup api
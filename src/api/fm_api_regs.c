@@ -912,6 +912,85 @@ fm_status fmWriteScatterGather(fm_int                     sw,
 
 
 
+/*****************************************************************************/
+/** fmCommitRegTransaction
+ * \ingroup intSwitch
+ *
+ * \desc            Executes a list of register reads and writes, in order,
+ *                  as a single transaction. Platforms that support it take
+ *                  the register access lock once for the whole list rather
+ *                  than once per access.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of entries in entries.
+ *
+ * \param[in,out]   entries is an array of length nEntries, which describes
+ *                  each region to be read or written. Read data is stored
+ *                  in the entry's data array.
+ *
+ * \param[in]       flags is a bit mask of FM_REG_TXN_FLAG_* values. It is
+ *                  ignored by platforms that do not support transactions.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if an entry is invalid.
+ *
+ *****************************************************************************/
+fm_status fmCommitRegTransaction(fm_int                  sw,
+                                 fm_int                  nEntries,
+                                 fm_regTransactionEntry *entries,
+                                 fm_uint32               flags)
+{
+    fm_status  err = FM_OK;
+    fm_int     i;
+    fm_switch *switchPtr;
+
+    VALIDATE_AND_PROTECT_SW(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    /* If supported then use it */
+    if (switchPtr->CommitRegTransaction)
+    {
+        err = switchPtr->CommitRegTransaction(sw, nEntries, entries, flags);
+    }
+    else
+    {
+        for (i = 0 ; err == FM_OK && i < nEntries ; i++)
+        {
+            switch (entries[i].op)
+            {
+                case FM_REG_TXN_READ:
+                    err = switchPtr->ReadUINT32Mult(sw,
+                                                    entries[i].addr,
+                                                    entries[i].count,
+                                                    entries[i].data);
+                    break;
+
+                case FM_REG_TXN_WRITE:
+                    err = switchPtr->WriteUINT32Mult(sw,
+                                                     entries[i].addr,
+                                                     entries[i].count,
+                                                     entries[i].data);
+                    break;
+
+                default:
+                    err = FM_ERR_INVALID_ARGUMENT;
+                    break;
+            }
+        }
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmCommitRegTransaction */
+
+
+
+
 /*****************************************************************************/
 /** fmMaskUINT32
  * \ingroup intSwitch
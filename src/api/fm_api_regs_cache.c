@@ -42,6 +42,44 @@
 
 #define CACHE_BURST_SIZE    512
 
+/* Identifies a register cache image file ("FMRC"). */
+#define REGS_CACHE_IMAGE_MAGIC      0x43524d46
+#define REGS_CACHE_IMAGE_VERSION    1
+
+/* Header at the start of a register cache image file. */
+typedef struct
+{
+    fm_uint32   magic;
+    fm_uint32   version;
+    fm_uint32   nRegSets;
+
+} fm_regCacheImageHeader;
+
+/* Describes one register set in a register cache image. The cached words
+ * of the set follow the descriptor, then its key valid bits packed into
+ * 32-bit words. */
+typedef struct
+{
+    fm_uint32   baseAddr;
+    fm_uint32   nWords;
+    fm_uint32   nIndices;
+    fm_uint32   nElements[FM_REGS_CACHE_MAX_INDICES];
+    fm_uint32   nValidBits;
+    fm_uint32   checksum;
+
+} fm_regCacheImageRegSet;
+
+/* Scratch copy of one register set loaded from a register cache image. It
+ * is only copied into the cache once the whole image has been validated. */
+typedef struct
+{
+    fm_uint32 * data;
+    fm_uint32   nCacheWords;
+    fm_uint32 * validWords;
+    fm_uint32   nValidBits;
+
+} fm_regCacheImageSet;
+
 
 /*****************************************************************************
  * Local function prototypes
@@ -83,6 +121,45 @@ static fm_status fmRegCacheReadNC(fm_int                        sw,
                                   fm_int                        nEntries,
                                   const fm_registerSGListEntry *sgList);
 
+static void GetRegSetDimensions(const fm_cachedRegs *regSet,
+                                fm_uint32 *          secondDimension,
+                                fm_uint32 *          thirdDimension);
+
+static fm_uint32 GetKeyValidSize(fm_int sw, const fm_cachedRegs *regSet);
+
+static void ComputeRegSetChecksum(const fm_cachedRegs *regSet,
+                                  const fm_uint32 *    data,
+                                  fm_uint32 *          checksum);
+
+static fm_status WriteImageData(FILE *fp, const void *data, fm_uint size);
+
+static fm_status ReadImageData(FILE *fp, void *data, fm_uint size);
+
+static fm_status SaveRegSetImage(fm_int sw, FILE *fp, const fm_cachedRegs *regSet);
+
+static fm_status LoadRegSetImage(fm_int                sw,
+                                 FILE *                fp,
+                                 const fm_cachedRegs * regSet,
+                                 fm_regCacheImageSet * set);
+
+static fm_status CommitRegSetImage(fm_int                      sw,
+                                   const fm_cachedRegs *       regSet,
+                                   const fm_regCacheImageSet * set);
+
+static void FreeImage(fm_regCacheImageSet *sets, fm_int nRegSets);
+
+static fm_status LoadImage(fm_int                 sw,
+                           const fm_char *        fileName,
+                           const fm_cachedRegs ** cachedRegs,
+                           fm_regCacheImageSet ** setsOut,
+                           fm_int *               nRegSetsOut);
+
+static fm_status RefreshRegSet(fm_int sw, const fm_cachedRegs *regSet);
+
+static fm_status ReconcileRegSet(fm_int                    sw,
+                                 const fm_cachedRegs *     regSet,
+                                 fm_regCacheRestoreStats * stats);
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -936,263 +1013,1097 @@ static fm_bool IsScatterGatherListCorrect(const fm_registerSGListEntry *sgListPt
 
 
 
-/*****************************************************************************
- * Public Functions
- *****************************************************************************/
-
-
 /*****************************************************************************/
-/** fmInitRegisterCache
+/** GetRegSetDimensions
  * \ingroup intRegCache
  *
- * \chips           FM3000, FM4000, FM6000, FM10000
+ * \desc            Returns the number of rows of a register set along its
+ *                  second and third dimensions. A row is the block of
+ *                  nElements[0] entries that are contiguous in the cache.
  *
- * \desc            Initializes the Register Cache.
+ * \param[in]       regSet points to the register set descriptor.
  *
- * \param[in]       sw is the switch whose cache is being initialized.
- * 
- * \return          FM_OK: if successful
- * \return          FM_ERR_INVALID_SWITCH: if the switch ID is invalid
- * \return          FM_ERR_NO_MEM: if there's no memory for the initialization
- * \return          FM_ERR_INVALID_ARGUMENT: if the word count in any register 
- *                  description is wrong
- * \return          FM_ERR_BAD_IOCTL: driver error during the first read
- * \return          FM_FAIL: any other error
+ * \param[out]      secondDimension points to the location to receive the
+ *                  number of rows along the second dimension.
+ *
+ * \param[out]      thirdDimension points to the location to receive the
+ *                  number of rows along the third dimension.
+ *
+ * \return          None
  *
  *****************************************************************************/
-fm_status fmInitRegisterCache(fm_int sw)
+static void GetRegSetDimensions(const fm_cachedRegs *regSet,
+                                fm_uint32 *          secondDimension,
+                                fm_uint32 *          thirdDimension)
 {
-    fm_status             err = FM_OK;
-    fm_int                nEntries;
-    fm_switch            *switchPtr;
-    const fm_cachedRegs **cachedRegs;
+    *secondDimension = (regSet->nIndices < 2) ? 1 : regSet->nElements[1];
+    *thirdDimension  = (regSet->nIndices < 3) ? 1 : regSet->nElements[2];
 
+}   /* end GetRegSetDimensions */
 
-    /* get the switch pointer and initialize its cache */
-    VALIDATE_SWITCH_INDEX(sw);
 
-    switchPtr = GET_SWITCH_PTR(sw);
 
-    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
-    if (cachedRegs == NULL)
+
+/*****************************************************************************/
+/** GetKeyValidSize
+ * \ingroup intRegCache
+ *
+ * \desc            Returns the number of key valid bits of a register set,
+ *                  as created by ''fmRegCacheInitKeyValid''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \return          The number of key valid bits, or 0 if the register set
+ *                  has none.
+ *
+ *****************************************************************************/
+static fm_uint32 GetKeyValidSize(fm_int sw, const fm_cachedRegs *regSet)
+{
+    fm_uint32   size;
+    fm_int      i;
+
+    if ( regSet->getCache.valid == NULL ||
+         regSet->getCache.valid(sw) == NULL )
     {
-        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, "CachedRegisterList is NULL\n");
-        return FM_ERR_INVALID_ARGUMENT;
+        return 0;
     }
 
-    /* First, count how many cached register we have total */
-    nEntries = fmGenerateCacheInitializer(sw, cachedRegs, NULL);
-             
-    /* any cached registers? */
-    if (nEntries > 0)
+    size = 2;
+    for (i = 0 ; i < regSet->nIndices ; i++)
     {
-        fm_cleanupListEntry *      cleanupList = NULL;
-        fm_registerSGListEntry *   entries;
-
-        /* Yes, allocate and format a scatter-gather list for those */
-
-        FM_ALLOC_TEMP_ARRAY(entries, fm_registerSGListEntry, nEntries);
-        
-        memset(entries, 0, sizeof(fm_registerSGListEntry) * nEntries);
-        fmGenerateCacheInitializer(sw, cachedRegs, entries );
-
-        /* Initialize the keyValid bit arrarys */
-        err = fmRegCacheInitKeyValid(sw, cachedRegs);
-
-        /* If that worked, perform the first read of into the cache */ 
-        if ( err == FM_OK )
-        {
-            err = fmRegCacheRead(sw, nEntries, entries, FALSE);
-        }
-
-        /* relinquish the memory allocated for the scatter-gather list */
-        FM_FREE_TEMP_ARRAYS();
+        size *= regSet->nElements[i];
     }
 
-ABORT:
-    return err;
+    return size;
 
-}   /* end fmInitRegisterCache */
+}   /* end GetKeyValidSize */
 
 
 
 
 /*****************************************************************************/
-/** fmFreeRegisterCache
+/** ComputeRegSetChecksum
  * \ingroup intRegCache
  *
- * \chips           FM3000, FM4000, FM6000, FM10000
+ * \desc            Computes a checksum over the contents of a register set,
+ *                  laid out as in the cache. Each block of entries that
+ *                  the hardware checksums as a unit is XORed the same way
+ *                  as ''fmRegCacheComputeChecksum'', and the block
+ *                  checksum is rotated into the result, so that blocks
+ *                  that were swapped are detected as well as corrupted
+ *                  words.
  *
- * \desc            Function that frees memory allocated for the Register Cache
+ * \param[in]       regSet points to the register set descriptor.
  *
- * \param[in]       sw is the switch whose cache is being freed.
- * 
- * \return          FM_OK: if successful
- * \return          FM_ERR_INVALID_SWITCH: if the switch ID is invalid
- * \return          FM_ERR_INVALID_ARGUMENT: if the word count in any register 
- *                  description is wrong
- * \return          FM_FAIL: any other error
+ * \param[in]       data points to the register set contents, which may be
+ *                  the cache itself or a scratch copy of it.
+ *
+ * \param[out]      checksum points to the location to receive the checksum.
+ *
+ * \return          None
  *
  *****************************************************************************/
-fm_status fmFreeRegisterCache(fm_int sw)
+static void ComputeRegSetChecksum(const fm_cachedRegs *regSet,
+                                  const fm_uint32 *    data,
+                                  fm_uint32 *          checksum)
 {
-    fm_status             err = FM_OK;
-    fm_switch            *switchPtr;
-    const fm_cachedRegs **cachedRegs;
+    fm_uint32           idx[FM_REGS_CACHE_MAX_INDICES];
+    const fm_uint32 *   blockPtr;
+    fm_uint32           secondDimension;
+    fm_uint32           thirdDimension;
+    fm_uint32           blockSize;
+    fm_uint32           blockWords;
+    fm_uint32           blockChecksum;
+    fm_uint32           i;
 
+    GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
 
-    /* get the switch pointer and point to its cache */
-    VALIDATE_SWITCH_INDEX(sw);
+    /* A hardware block covers a whole row of a contiguous set, but a single
+     * entry of a non-contiguous one. */
+    if ( fmRegCacheStrideIsContiguous(regSet) )
+    {
+        blockSize = regSet->nElements[0];
+    }
+    else
+    {
+        blockSize = 1;
+    }
 
-    switchPtr = GET_SWITCH_PTR(sw);
+    blockWords = blockSize * regSet->nWords;
+    *checksum  = 0;
 
-    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    for (idx[1] = 0 ; idx[1] < secondDimension ; idx[1]++)
+    {
+        for (idx[2] = 0 ; idx[2] < thirdDimension ; idx[2]++)
+        {
+            for (idx[0] = 0 ;
+                 idx[0] < regSet->nElements[0] ;
+                 idx[0] += blockSize)
+            {
+                blockPtr      = data + fmRegCacheComputeOffset(idx, regSet);
+                blockChecksum = 0;
 
-    fmGenerateCacheInitializer(sw, cachedRegs, NULL);
+                for (i = 0 ; i < blockWords ; i++)
+                {
+                    blockChecksum ^= blockPtr[i];
+                }
 
-    /* Free the cache key valids */
-    err = fmRegCacheFreeKeyValid(sw, cachedRegs);
-             
-    return err;
+                *checksum = ( (*checksum << 1) | (*checksum >> 31) ) ^
+                            blockChecksum;
+            }
+        }
+    }
 
-}   /* end fmFreeRegisterCache */
+}   /* end ComputeRegSetChecksum */
 
 
 
 
 /*****************************************************************************/
-/** fmRegCacheRead
+/** WriteImageData
  * \ingroup intRegCache
  *
- * \chips           FM3000, FM4000, FM6000, FM10000
- * 
- * \desc            Read a scatter-gather list from the hardware registers
- *                  or their cache.
- *
- * \param[in]       sw is the switch on which to operate.
+ * \desc            Writes a block of data to a register cache image file.
  *
- * \param[in]       nEntries is the number of entries in sgList.
+ * \param[in]       fp is the image file.
  *
- * \param[in]       sgList is the list of contiguous ranges of data
- *                  to read from the cached registers.
+ * \param[in]       data points to the data to write.
  *
- * \param[in]       useCache indicates whether using the cache is allowed.
- *                  If true, the value will be returned from the cache
- *                  without querying the hardware.
+ * \param[in]       size is the number of bytes to write.
  *
- * \return          status code
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the data could not be written.
  *
  *****************************************************************************/
-fm_status fmRegCacheRead(fm_int                        sw,
-                         fm_int                        nEntries,
-                         const fm_registerSGListEntry *sgList,
-                         fm_bool                       useCache)
+static fm_status WriteImageData(FILE *fp, const void *data, fm_uint size)
 {
-    fm_status err;
-
-    /* Sanity check on the scatter-gather list */
-    if ( !IsScatterGatherListCorrect(sgList, nEntries) )
+    if (size != 0 && fwrite(data, size, 1, fp) != 1)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
-                     "incorrect scatter-gather entry!\n");
-        FM_LOG_CALL_STACK(FM_LOG_CAT_SWITCH, FM_LOG_LEVEL_ERROR);
-        return FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to write register cache image\n");
+        return FM_FAIL;
     }
 
-    TAKE_REG_LOCK(sw);   /* make access atomic */
+    return FM_OK;
 
-    if (useCache)
-    {
-        err = fmRegCacheReadC(sw, nEntries, sgList);
-    }
-    else
+}   /* end WriteImageData */
+
+
+
+
+/*****************************************************************************/
+/** ReadImageData
+ * \ingroup intRegCache
+ *
+ * \desc            Reads a block of data from a register cache image file.
+ *
+ * \param[in]       fp is the image file.
+ *
+ * \param[out]      data points to the location to receive the data.
+ *
+ * \param[in]       size is the number of bytes to read.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_VALUE if the image is truncated.
+ *
+ *****************************************************************************/
+static fm_status ReadImageData(FILE *fp, void *data, fm_uint size)
+{
+    if (size != 0 && fread(data, size, 1, fp) != 1)
     {
-        err = fmRegCacheReadNC(sw, nEntries, sgList);
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Register cache image is truncated\n");
+        return FM_ERR_INVALID_VALUE;
     }
 
-    DROP_REG_LOCK(sw);
-
-    return err;
+    return FM_OK;
 
-}   /* end fmRegCacheRead */
+}   /* end ReadImageData */
 
 
 
 
 /*****************************************************************************/
-/** fmRegCacheWrite
+/** SaveRegSetImage
  * \ingroup intRegCache
  *
- * \chips           FM3000, FM4000, FM6000, FM10000
- * 
- * \desc            Write a scatter-gather list to the hardware registers,
- *                  keeping a copy in their cache.
+ * \desc            Writes the cached contents of one register set, and
+ *                  its key valid bits if it has any, to a register cache
+ *                  image file.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       nEntries is the number of entries in sgList.
- *
- * \param[in]       sgList is the list of contiguous ranges of data
- *                  to write to the register set.
+ * \param[in]       fp is the image file.
  *
- * \param[in]       useCache indicates whether using the cache is allowed.
- *                  If true, the value will only be written to the
- *                  hardware if it differs from the cached value.
- *                  The cache is updated regardless of the value of useCache.
+ * \param[in]       regSet points to the register set descriptor.
  *
- * \return          status code
+ * \return          FM_OK if successful.
  *
  *****************************************************************************/
-fm_status fmRegCacheWrite(fm_int                        sw,
-                          fm_int                        nEntries,
-                          const fm_registerSGListEntry *sgList,
-                          fm_bool                       useCache)
+static fm_status SaveRegSetImage(fm_int sw, FILE *fp, const fm_cachedRegs *regSet)
 {
-    fm_int                     nSGEntries;
-    fm_scatterGatherListEntry *hwSGList;
-    fm_status                  err;
-    fm_int                     i;
-    fm_int                     j;
-    fm_uint32 *                cache;
-    fm_cleanupListEntry *      cleanupList = NULL;
+    fm_regCacheImageRegSet  desc;
+    fm_bitArray *           valid;
+    fm_uint32               secondDimension;
+    fm_uint32               thirdDimension;
+    fm_uint32               nCacheWords;
+    fm_uint32               validWord;
+    fm_bool                 bitValue;
+    fm_int                  i;
+    fm_status               err;
 
-    /* Sanity check on the scatter-gather list */
-    if ( !IsScatterGatherListCorrect(sgList, nEntries) )
+    GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
+
+    nCacheWords = regSet->nWords * regSet->nElements[0] *
+                  secondDimension * thirdDimension;
+
+    valid = NULL;
+    if (regSet->getCache.valid != NULL)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
-                     "incorrect scatter-gather entry!\n");
-        FM_LOG_CALL_STACK( FM_LOG_CAT_SWITCH, FM_LOG_LEVEL_ERROR );
-        return FM_ERR_INVALID_ARGUMENT;
+        valid = regSet->getCache.valid(sw);
     }
 
-    TAKE_REG_LOCK(sw);   /* make access atomic */
+    FM_CLEAR(desc);
+    desc.baseAddr   = regSet->baseAddr;
+    desc.nWords     = regSet->nWords;
+    desc.nIndices   = regSet->nIndices;
+    desc.nValidBits = GetKeyValidSize(sw, regSet);
 
-    /**************************************************
-     * Write to the hardware
-     **************************************************/
+    for (i = 0 ; i < FM_REGS_CACHE_MAX_INDICES ; i++)
+    {
+        desc.nElements[i] = regSet->nElements[i];
+    }
 
-    nSGEntries = fmRegCacheConvSGList(sw,
-                                      nEntries,
-                                      sgList,
-                                      NULL,
-                                      useCache);
+    ComputeRegSetChecksum(regSet, regSet->getCache.data(sw), &desc.checksum);
 
-    if (nSGEntries > 0)
+    err = WriteImageData(fp, &desc, sizeof(desc));
+    if (err != FM_OK)
     {
-        FM_ALLOC_TEMP_ARRAY(hwSGList, fm_scatterGatherListEntry, nSGEntries);
-        fmRegCacheConvSGList(sw, 
-                             nEntries, 
-                             sgList, 
-                             hwSGList, 
-                             useCache);
-        err = fmWriteScatterGather(sw, nSGEntries, hwSGList);
+        return err;
     }
-    else
+
+    err = WriteImageData(fp,
+                         regSet->getCache.data(sw),
+                         nCacheWords * sizeof(fm_uint32));
+    if (err != FM_OK)
     {
-        err = FM_OK;
+        return err;
     }
 
-    /**************************************************
+    validWord = 0;
+
+    for (i = 0 ; i < (fm_int) desc.nValidBits ; i++)
+    {
+        err = fmGetBitArrayBit(valid, i, &bitValue);
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        if (bitValue)
+        {
+            validWord |= 1U << (i % 32);
+        }
+
+        if ( (i % 32) == 31 || i == (fm_int) desc.nValidBits - 1 )
+        {
+            err = WriteImageData(fp, &validWord, sizeof(validWord));
+            if (err != FM_OK)
+            {
+                return err;
+            }
+
+            validWord = 0;
+        }
+    }
+
+    return FM_OK;
+
+}   /* end SaveRegSetImage */
+
+
+
+
+/*****************************************************************************/
+/** LoadRegSetImage
+ * \ingroup intRegCache
+ *
+ * \desc            Loads the contents of one register set, and its key
+ *                  valid bits if it has any, from a register cache image
+ *                  file into a scratch copy, and validates it against the
+ *                  register set layout and its saved checksum. Neither the
+ *                  cache nor the hardware is accessed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fp is the image file.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \param[out]      set points to the scratch copy to fill in. Its buffers
+ *                  must be released with ''FreeImage'', even on failure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the scratch copy could not be allocated.
+ * \return          FM_ERR_INVALID_VALUE if the image does not describe
+ *                  this register set or fails its checksum.
+ *
+ *****************************************************************************/
+static fm_status LoadRegSetImage(fm_int                sw,
+                                 FILE *                fp,
+                                 const fm_cachedRegs * regSet,
+                                 fm_regCacheImageSet * set)
+{
+    fm_regCacheImageRegSet  desc;
+    fm_uint32               secondDimension;
+    fm_uint32               thirdDimension;
+    fm_uint32               nValidWords;
+    fm_uint32               checksum;
+    fm_int                  i;
+    fm_status               err;
+
+    err = ReadImageData(fp, &desc, sizeof(desc));
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    /* The image must have been saved from the same register set layout. */
+    if ( desc.baseAddr != regSet->baseAddr ||
+         desc.nWords != regSet->nWords ||
+         desc.nIndices != regSet->nIndices ||
+         desc.nValidBits != GetKeyValidSize(sw, regSet) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Register cache image does not match register set "
+                     "at 0x%08x\n",
+                     regSet->baseAddr);
+        return FM_ERR_INVALID_VALUE;
+    }
+
+    for (i = 0 ; i < FM_REGS_CACHE_MAX_INDICES ; i++)
+    {
+        if (desc.nElements[i] != regSet->nElements[i])
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                         "Register cache image does not match register set "
+                         "at 0x%08x\n",
+                         regSet->baseAddr);
+            return FM_ERR_INVALID_VALUE;
+        }
+    }
+
+    GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
+
+    set->nCacheWords = regSet->nWords * regSet->nElements[0] *
+                       secondDimension * thirdDimension;
+    set->nValidBits  = desc.nValidBits;
+    nValidWords      = (desc.nValidBits + 31) / 32;
+
+    set->data = fmAlloc(set->nCacheWords * sizeof(fm_uint32));
+    if (set->data == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    err = ReadImageData(fp, set->data, set->nCacheWords * sizeof(fm_uint32));
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    if (nValidWords != 0)
+    {
+        set->validWords = fmAlloc(nValidWords * sizeof(fm_uint32));
+        if (set->validWords == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+
+        err = ReadImageData(fp,
+                            set->validWords,
+                            nValidWords * sizeof(fm_uint32));
+        if (err != FM_OK)
+        {
+            return err;
+        }
+    }
+
+    ComputeRegSetChecksum(regSet, set->data, &checksum);
+
+    if (checksum != desc.checksum)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Register cache image checksum mismatch for register "
+                     "set at 0x%08x: expected 0x%08x, got 0x%08x\n",
+                     regSet->baseAddr,
+                     desc.checksum,
+                     checksum);
+        return FM_ERR_INVALID_VALUE;
+    }
+
+    return FM_OK;
+
+}   /* end LoadRegSetImage */
+
+
+
+
+/*****************************************************************************/
+/** CommitRegSetImage
+ * \ingroup intRegCache
+ *
+ * \desc            Copies a validated scratch copy of a register set into
+ *                  the cache, and rebuilds its key valid bits. The hardware
+ *                  is not accessed.
+ *
+ * \note            The key valid bit arrays must have been created with
+ *                  ''fmRegCacheInitKeyValid''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \param[in]       set points to the scratch copy loaded by
+ *                  ''LoadRegSetImage''.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status CommitRegSetImage(fm_int                      sw,
+                                   const fm_cachedRegs *       regSet,
+                                   const fm_regCacheImageSet * set)
+{
+    fm_bitArray *   valid;
+    fm_uint32       i;
+    fm_status       err;
+
+    FM_MEMCPY_S(regSet->getCache.data(sw),
+                set->nCacheWords * sizeof(fm_uint32),
+                set->data,
+                set->nCacheWords * sizeof(fm_uint32));
+
+    if (set->nValidBits == 0)
+    {
+        return FM_OK;
+    }
+
+    valid = regSet->getCache.valid(sw);
+
+    err = fmClearBitArray(valid);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    for (i = 0 ; i < set->nValidBits ; i++)
+    {
+        if ( set->validWords[i / 32] & (1U << (i % 32)) )
+        {
+            err = fmSetBitArrayBit(valid, i, TRUE);
+            if (err != FM_OK)
+            {
+                return err;
+            }
+        }
+    }
+
+    return FM_OK;
+
+}   /* end CommitRegSetImage */
+
+
+
+
+/*****************************************************************************/
+/** FreeImage
+ * \ingroup intRegCache
+ *
+ * \desc            Frees the scratch copies of a register cache image.
+ *
+ * \param[in]       sets points to the array of scratch copies.
+ *
+ * \param[in]       nRegSets is the number of entries in sets.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+static void FreeImage(fm_regCacheImageSet *sets, fm_int nRegSets)
+{
+    fm_int  i;
+
+    for (i = 0 ; i < nRegSets ; i++)
+    {
+        if (sets[i].data != NULL)
+        {
+            fmFree(sets[i].data);
+        }
+
+        if (sets[i].validWords != NULL)
+        {
+            fmFree(sets[i].validWords);
+        }
+    }
+
+    fmFree(sets);
+
+}   /* end FreeImage */
+
+
+
+
+/*****************************************************************************/
+/** LoadImage
+ * \ingroup intRegCache
+ *
+ * \desc            Loads a whole register cache image file into scratch
+ *                  copies and validates every register set in it. Neither
+ *                  the cache nor the hardware is accessed.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the image file.
+ *
+ * \param[in]       cachedRegs is the NULL-terminated list of cached
+ *                  register sets of the switch.
+ *
+ * \param[out]      setsOut points to the location to receive the array of
+ *                  scratch copies, one per register set. The caller must
+ *                  release it with ''FreeImage''.
+ *
+ * \param[out]      nRegSetsOut points to the location to receive the
+ *                  number of register sets.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the scratch copies could not be
+ *                  allocated.
+ * \return          FM_ERR_INVALID_VALUE if the image does not match the
+ *                  register cache layout or fails its checksum.
+ * \return          FM_FAIL if the image file could not be opened.
+ *
+ *****************************************************************************/
+static fm_status LoadImage(fm_int                 sw,
+                           const fm_char *        fileName,
+                           const fm_cachedRegs ** cachedRegs,
+                           fm_regCacheImageSet ** setsOut,
+                           fm_int *               nRegSetsOut)
+{
+    fm_regCacheImageHeader  header;
+    fm_regCacheImageSet *   sets;
+    fm_int                  nRegSets;
+    fm_int                  i;
+    FILE *                  fp;
+    fm_status               err;
+
+    nRegSets = 0;
+    while (cachedRegs[nRegSets] != NULL)
+    {
+        nRegSets++;
+    }
+
+    /* One spare entry, so that an empty register list still allocates. */
+    sets = fmAlloc( (nRegSets + 1) * sizeof(fm_regCacheImageSet) );
+    if (sets == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_MEMSET_S(sets,
+                (nRegSets + 1) * sizeof(fm_regCacheImageSet),
+                0,
+                (nRegSets + 1) * sizeof(fm_regCacheImageSet));
+
+    fp = fopen(fileName, "rb");
+    if (fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to open register cache image %s\n",
+                     fileName);
+        fmFree(sets);
+        return FM_FAIL;
+    }
+
+    err = ReadImageData(fp, &header, sizeof(header));
+
+    if ( err == FM_OK &&
+         ( header.magic != REGS_CACHE_IMAGE_MAGIC ||
+           header.version != REGS_CACHE_IMAGE_VERSION ||
+           header.nRegSets != (fm_uint32) nRegSets ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "%s is not a register cache image for this switch\n",
+                     fileName);
+        err = FM_ERR_INVALID_VALUE;
+    }
+
+    for (i = 0 ; err == FM_OK && i < nRegSets ; i++)
+    {
+        err = LoadRegSetImage(sw, fp, cachedRegs[i], &sets[i]);
+    }
+
+    fclose(fp);
+
+    if (err != FM_OK)
+    {
+        FreeImage(sets, nRegSets);
+        return err;
+    }
+
+    *setsOut     = sets;
+    *nRegSetsOut = nRegSets;
+
+    return FM_OK;
+
+}   /* end LoadImage */
+
+
+
+
+/*****************************************************************************/
+/** RefreshRegSet
+ * \ingroup intRegCache
+ *
+ * \desc            Reads the contents of a register set from the hardware
+ *                  into the cache.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status RefreshRegSet(fm_int sw, const fm_cachedRegs *regSet)
+{
+    fm_registerSGListEntry  entry;
+    fm_uint32               secondDimension;
+    fm_uint32               thirdDimension;
+    fm_status               err;
+
+    GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
+
+    FM_CLEAR(entry);
+    entry.registerSet = regSet;
+    entry.count       = regSet->nElements[0];
+
+    for (entry.idx[1] = 0 ; entry.idx[1] < secondDimension ; entry.idx[1]++)
+    {
+        for (entry.idx[2] = 0 ; entry.idx[2] < thirdDimension ; entry.idx[2]++)
+        {
+            entry.data  = regSet->getCache.data(sw);
+            entry.data += fmRegCacheComputeOffset(entry.idx, regSet);
+
+            err = fmRegCacheRead(sw, 1, &entry, FALSE);
+            if (err != FM_OK)
+            {
+                return err;
+            }
+        }
+    }
+
+    return FM_OK;
+
+}   /* end RefreshRegSet */
+
+
+
+
+/*****************************************************************************/
+/** ReconcileRegSet
+ * \ingroup intRegCache
+ *
+ * \desc            Compares the hardware contents of a register set with
+ *                  the cache, and writes back from the cache only the
+ *                  entries that differ.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ *
+ * \param[in,out]   stats points to the restore statistics to update.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+static fm_status ReconcileRegSet(fm_int                    sw,
+                                 const fm_cachedRegs *     regSet,
+                                 fm_regCacheRestoreStats * stats)
+{
+    fm_uint32               hwData[CACHE_BURST_SIZE];
+    fm_uint32               writeIdx[FM_REGS_CACHE_MAX_INDICES];
+    fm_registerSGListEntry  entry;
+    fm_uint32 *             cachePtr;
+    fm_uint32               secondDimension;
+    fm_uint32               thirdDimension;
+    fm_uint32               burstSize;
+    fm_uint32               first;
+    fm_uint32               last;
+    fm_uint32               i;
+    fm_bool                 contiguous;
+    fm_status               err;
+
+    GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
+
+    contiguous = fmRegCacheStrideIsContiguous(regSet);
+
+    /* The number of entries compared at a time. */
+    burstSize = CACHE_BURST_SIZE / regSet->nWords;
+
+    FM_CLEAR(entry);
+    entry.registerSet = regSet;
+    entry.data        = hwData;
+
+    for (entry.idx[1] = 0 ; entry.idx[1] < secondDimension ; entry.idx[1]++)
+    {
+        for (entry.idx[2] = 0 ; entry.idx[2] < thirdDimension ; entry.idx[2]++)
+        {
+            for (entry.idx[0] = 0 ;
+                 entry.idx[0] < regSet->nElements[0] ;
+                 entry.idx[0] += entry.count)
+            {
+                entry.count = regSet->nElements[0] - entry.idx[0];
+                if (entry.count > burstSize)
+                {
+                    entry.count = burstSize;
+                }
+
+                err = fmRegCacheRead(sw, 1, &entry, FALSE);
+                if (err != FM_OK)
+                {
+                    return err;
+                }
+
+                cachePtr  = regSet->getCache.data(sw);
+                cachePtr += fmRegCacheComputeOffset(entry.idx, regSet);
+
+                writeIdx[0] = entry.idx[0];
+                writeIdx[1] = entry.idx[1];
+                writeIdx[2] = entry.idx[2];
+
+                first = entry.count;
+                last  = 0;
+
+                for (i = 0 ; i < entry.count ; i++)
+                {
+                    if ( memcmp(&hwData[i * regSet->nWords],
+                                &cachePtr[i * regSet->nWords],
+                                regSet->nWords * sizeof(fm_uint32)) == 0 )
+                    {
+                        continue;
+                    }
+
+                    stats->nDiffering++;
+
+                    if (contiguous)
+                    {
+                        /* Rewrite the differing span in a single burst. */
+                        if (first == entry.count)
+                        {
+                            first = i;
+                        }
+                        last = i;
+                    }
+                    else
+                    {
+                        writeIdx[0] = entry.idx[0] + i;
+
+                        err = fmRegCacheWriteFromCache(sw, regSet, writeIdx, 1);
+                        if (err != FM_OK)
+                        {
+                            return err;
+                        }
+
+                        stats->nWrites++;
+                    }
+                }
+
+                if (first < entry.count)
+                {
+                    writeIdx[0] = entry.idx[0] + first;
+
+                    err = fmRegCacheWriteFromCache(sw,
+                                                   regSet,
+                                                   writeIdx,
+                                                   last - first + 1);
+                    if (err != FM_OK)
+                    {
+                        return err;
+                    }
+
+                    stats->nWrites++;
+                }
+
+                stats->nEntries += entry.count;
+            }
+        }
+    }
+
+    return FM_OK;
+
+}   /* end ReconcileRegSet */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmInitRegisterCache
+ * \ingroup intRegCache
+ *
+ * \chips           FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Initializes the Register Cache.
+ *
+ * \param[in]       sw is the switch whose cache is being initialized.
+ * 
+ * \return          FM_OK: if successful
+ * \return          FM_ERR_INVALID_SWITCH: if the switch ID is invalid
+ * \return          FM_ERR_NO_MEM: if there's no memory for the initialization
+ * \return          FM_ERR_INVALID_ARGUMENT: if the word count in any register 
+ *                  description is wrong
+ * \return          FM_ERR_BAD_IOCTL: driver error during the first read
+ * \return          FM_FAIL: any other error
+ *
+ *****************************************************************************/
+fm_status fmInitRegisterCache(fm_int sw)
+{
+    fm_status             err = FM_OK;
+    fm_int                nEntries;
+    fm_switch            *switchPtr;
+    const fm_cachedRegs **cachedRegs;
+
+
+    /* get the switch pointer and initialize its cache */
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    if (cachedRegs == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, "CachedRegisterList is NULL\n");
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    /* First, count how many cached register we have total */
+    nEntries = fmGenerateCacheInitializer(sw, cachedRegs, NULL);
+             
+    /* any cached registers? */
+    if (nEntries > 0)
+    {
+        fm_cleanupListEntry *      cleanupList = NULL;
+        fm_registerSGListEntry *   entries;
+
+        /* Yes, allocate and format a scatter-gather list for those */
+
+        FM_ALLOC_TEMP_ARRAY(entries, fm_registerSGListEntry, nEntries);
+        
+        memset(entries, 0, sizeof(fm_registerSGListEntry) * nEntries);
+        fmGenerateCacheInitializer(sw, cachedRegs, entries );
+
+        /* Initialize the keyValid bit arrarys */
+        err = fmRegCacheInitKeyValid(sw, cachedRegs);
+
+        /* If that worked, perform the first read of into the cache */ 
+        if ( err == FM_OK )
+        {
+            err = fmRegCacheRead(sw, nEntries, entries, FALSE);
+        }
+
+        /* relinquish the memory allocated for the scatter-gather list */
+        FM_FREE_TEMP_ARRAYS();
+    }
+
+ABORT:
+    return err;
+
+}   /* end fmInitRegisterCache */
+
+
+
+
+/*****************************************************************************/
+/** fmFreeRegisterCache
+ * \ingroup intRegCache
+ *
+ * \chips           FM3000, FM4000, FM6000, FM10000
+ *
+ * \desc            Function that frees memory allocated for the Register Cache
+ *
+ * \param[in]       sw is the switch whose cache is being freed.
+ * 
+ * \return          FM_OK: if successful
+ * \return          FM_ERR_INVALID_SWITCH: if the switch ID is invalid
+ * \return          FM_ERR_INVALID_ARGUMENT: if the word count in any register 
+ *                  description is wrong
+ * \return          FM_FAIL: any other error
+ *
+ *****************************************************************************/
+fm_status fmFreeRegisterCache(fm_int sw)
+{
+    fm_status             err = FM_OK;
+    fm_switch            *switchPtr;
+    const fm_cachedRegs **cachedRegs;
+
+
+    /* get the switch pointer and point to its cache */
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+
+    fmGenerateCacheInitializer(sw, cachedRegs, NULL);
+
+    /* Free the cache key valids */
+    err = fmRegCacheFreeKeyValid(sw, cachedRegs);
+             
+    return err;
+
+}   /* end fmFreeRegisterCache */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheRead
+ * \ingroup intRegCache
+ *
+ * \chips           FM3000, FM4000, FM6000, FM10000
+ * 
+ * \desc            Read a scatter-gather list from the hardware registers
+ *                  or their cache.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of entries in sgList.
+ *
+ * \param[in]       sgList is the list of contiguous ranges of data
+ *                  to read from the cached registers.
+ *
+ * \param[in]       useCache indicates whether using the cache is allowed.
+ *                  If true, the value will be returned from the cache
+ *                  without querying the hardware.
+ *
+ * \return          status code
+ *
+ *****************************************************************************/
+fm_status fmRegCacheRead(fm_int                        sw,
+                         fm_int                        nEntries,
+                         const fm_registerSGListEntry *sgList,
+                         fm_bool                       useCache)
+{
+    fm_status err;
+
+    /* Sanity check on the scatter-gather list */
+    if ( !IsScatterGatherListCorrect(sgList, nEntries) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
+                     "incorrect scatter-gather entry!\n");
+        FM_LOG_CALL_STACK(FM_LOG_CAT_SWITCH, FM_LOG_LEVEL_ERROR);
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    TAKE_REG_LOCK(sw);   /* make access atomic */
+
+    if (useCache)
+    {
+        err = fmRegCacheReadC(sw, nEntries, sgList);
+    }
+    else
+    {
+        err = fmRegCacheReadNC(sw, nEntries, sgList);
+    }
+
+    DROP_REG_LOCK(sw);
+
+    return err;
+
+}   /* end fmRegCacheRead */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheWrite
+ * \ingroup intRegCache
+ *
+ * \chips           FM3000, FM4000, FM6000, FM10000
+ * 
+ * \desc            Write a scatter-gather list to the hardware registers,
+ *                  keeping a copy in their cache.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of entries in sgList.
+ *
+ * \param[in]       sgList is the list of contiguous ranges of data
+ *                  to write to the register set.
+ *
+ * \param[in]       useCache indicates whether using the cache is allowed.
+ *                  If true, the value will only be written to the
+ *                  hardware if it differs from the cached value.
+ *                  The cache is updated regardless of the value of useCache.
+ *
+ * \return          status code
+ *
+ *****************************************************************************/
+fm_status fmRegCacheWrite(fm_int                        sw,
+                          fm_int                        nEntries,
+                          const fm_registerSGListEntry *sgList,
+                          fm_bool                       useCache)
+{
+    fm_int                     nSGEntries;
+    fm_scatterGatherListEntry *hwSGList;
+    fm_status                  err;
+    fm_int                     i;
+    fm_int                     j;
+    fm_uint32 *                cache;
+    fm_cleanupListEntry *      cleanupList = NULL;
+
+    /* Sanity check on the scatter-gather list */
+    if ( !IsScatterGatherListCorrect(sgList, nEntries) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH, 
+                     "incorrect scatter-gather entry!\n");
+        FM_LOG_CALL_STACK( FM_LOG_CAT_SWITCH, FM_LOG_LEVEL_ERROR );
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    TAKE_REG_LOCK(sw);   /* make access atomic */
+
+    /**************************************************
+     * Write to the hardware
+     **************************************************/
+
+    nSGEntries = fmRegCacheConvSGList(sw,
+                                      nEntries,
+                                      sgList,
+                                      NULL,
+                                      useCache);
+
+    if (nSGEntries > 0)
+    {
+        FM_ALLOC_TEMP_ARRAY(hwSGList, fm_scatterGatherListEntry, nSGEntries);
+        fmRegCacheConvSGList(sw, 
+                             nEntries, 
+                             sgList, 
+                             hwSGList, 
+                             useCache);
+        err = fmWriteScatterGather(sw, nSGEntries, hwSGList);
+    }
+    else
+    {
+        err = FM_OK;
+    }
+
+    /**************************************************
      * Update the cache
      **************************************************/
 
@@ -2228,159 +3139,469 @@ fm_status fmRegCacheWriteFromCache(fm_int                sw,
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    /* Get the actual addresses. */
-    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+    /* Get the actual addresses. */
+    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+
+    regAddr  = sgList[0].addr;
+    numWords = sgList[0].count;
+    cachePtr = sgList[0].data;
+
+    /* The number of words to write at a time. Make it an multiple of the
+     * entry size, so we restore the register table in integral units. */
+    burstSize = (CACHE_BURST_SIZE / regSet->nWords) * regSet->nWords;
+
+#if (DEBUG_PARITY)
+    FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
+                 "burstSize = %u iterations = %u\n",
+                 burstSize,
+                 (numWords + burstSize - 1) / burstSize);
+#endif
+
+    while (numWords != 0)
+    {
+        wcount = (numWords > burstSize) ? burstSize : numWords;
+        if (wcount == 0)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "wcount = 0\n");
+            return FM_FAIL;
+        }
+
+#if (DEBUG_PARITY)
+        FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
+                     "restoring regAddr %08x wcount %u\n",
+                     regAddr,
+                     wcount);
+#endif
+
+        TAKE_REG_LOCK(sw);
+        err = switchPtr->WriteUINT32Mult(sw, regAddr, wcount, cachePtr);
+        DROP_REG_LOCK(sw);
+
+        if (err != FM_OK)
+        {
+            return err;
+        }
+
+        regAddr  += wcount;
+        cachePtr += wcount;
+        numWords -= wcount;
+    }
+
+    return FM_OK;
+
+}   /* end fmRegCacheWriteFromCache */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheComputeChecksum
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Computes the CRM checksum for a block of consecutive
+ *                  entries in the register cache.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       regSet points to the register set descriptor.
+ * 
+ * \param[in]       indices points to an array specifying the indices of the
+ *                  first entry to write.
+ * 
+ * \param[in]       nEntries is the number of register entries to write.
+ * 
+ * \param[out]      checksum points to the location to receive the checksum.
+ *
+ * \return          FM_OK if successful.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheComputeChecksum(fm_int                sw,
+                                    const fm_cachedRegs * regSet,
+                                    const fm_uint32 *     indices,
+                                    fm_int                nEntries,
+                                    fm_uint32 *           checksum)
+{
+    fm_scatterGatherListEntry   sgList[1];
+    fm_registerSGListEntry      entry;
+    fm_int                      sgListSize;
+    fm_uint32                   numWords;
+    fm_uint32 *                 cachePtr;
+    fm_uint32                   value;
+
+    FM_NOT_USED(sw);
+
+    if (regSet == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    entry.registerSet = regSet;
+    entry.data        = NULL;
+    entry.count       = nEntries;
+    entry.idx[0]      = indices[0];
+    entry.idx[1]      = indices[1];
+    entry.idx[2]      = indices[2];
+    entry.rewriting   = FALSE;
+
+    if ( !IsScatterGatherListCorrect(&entry, 1) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "invalid scatter-gather list\n");
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    entry.data  = regSet->getCache.data(sw);
+    entry.data += fmRegCacheComputeOffset(indices, regSet);
+
+    /* Find out how many scatter-gather entries we will need. */
+    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE);
+
+    if (sgListSize != 1)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "sgListSize (%d) != 1\n", sgListSize);
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+
+    numWords = sgList[0].count;
+    cachePtr = sgList[0].data;
+    value    = 0;
+
+    while (numWords != 0)
+    {
+        value ^= *cachePtr;
+        cachePtr++;
+        numWords--;
+    }
+
+#if 0
+    FM_LOG_PRINT("idx=[%d,%d,%d] nEntries=%d regAddr=%08x cachePtr=%p count=%u "
+                 "value=%08x\n",
+                 indices[0], indices[1], indices[2],
+                 nEntries,
+                 sgList[0].addr,
+                 (void *)sgList[0].data,
+                 sgList[0].count,
+                 value);
+#endif
+
+    *checksum = value;
+
+    return FM_OK;
+
+}   /* end fmRegCacheComputeChecksum */
+
+
+
+
+/*****************************************************************************/
+/** fmRegCacheSaveImage
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Saves the contents of the register cache to an image
+ *                  file, so that a restarted process can recover it with
+ *                  ''fmRegCacheRestoreImage'' instead of reprogramming the
+ *                  cached tables.
+ *                                                                      \lb\lb
+ *                  The image is written to a temporary file that is
+ *                  flushed to disk and then renamed over fileName, so a
+ *                  crash during the save never leaves a partial image
+ *                  behind.
+ *
+ * \note            The caller must hold the switch lock, so that the
+ *                  cache does not change while the image is written.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the image file.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the switch has no register
+ *                  cache.
+ * \return          FM_FAIL if the image file could not be written.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheSaveImage(fm_int sw, const fm_char *fileName)
+{
+    fm_switch *             switchPtr;
+    const fm_cachedRegs **  cachedRegs;
+    fm_regCacheImageHeader  header;
+    fm_char                 tmpName[FM_API_ATTR_TEXT_MAX_LENGTH + 8];
+    FILE *                  fp;
+    fm_status               err;
+
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    if (cachedRegs == NULL || fileName == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if ( FM_STRNLEN_S(fileName, sizeof(tmpName)) + 5 > sizeof(tmpName) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    FM_SNPRINTF_S(tmpName, sizeof(tmpName), "%s.tmp", fileName);
+
+    FM_CLEAR(header);
+    header.magic   = REGS_CACHE_IMAGE_MAGIC;
+    header.version = REGS_CACHE_IMAGE_VERSION;
+
+    while (cachedRegs[header.nRegSets] != NULL)
+    {
+        header.nRegSets++;
+    }
+
+    fp = fopen(tmpName, "wb");
+    if (fp == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to create register cache image %s\n",
+                     tmpName);
+        return FM_FAIL;
+    }
+
+    err = WriteImageData(fp, &header, sizeof(header));
+
+    while (err == FM_OK && *cachedRegs != NULL)
+    {
+        err = SaveRegSetImage(sw, fp, *cachedRegs);
+        cachedRegs++;
+    }
+
+    /* The image must be on disk before it replaces the previous one. */
+    if ( err == FM_OK &&
+         ( fflush(fp) != 0 || fsync(fileno(fp)) != 0 ) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to flush register cache image %s\n",
+                     tmpName);
+        err = FM_FAIL;
+    }
+
+    if (fclose(fp) != 0 && err == FM_OK)
+    {
+        err = FM_FAIL;
+    }
+
+    if (err == FM_OK && rename(tmpName, fileName) != 0)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to rename register cache image %s to %s\n",
+                     tmpName,
+                     fileName);
+        err = FM_FAIL;
+    }
+
+    if (err != FM_OK)
+    {
+        remove(tmpName);
+    }
+
+    return err;
+
+}   /* end fmRegCacheSaveImage */
 
-    regAddr  = sgList[0].addr;
-    numWords = sgList[0].count;
-    cachePtr = sgList[0].data;
 
-    /* The number of words to write at a time. Make it an multiple of the
-     * entry size, so we restore the register table in integral units. */
-    burstSize = (CACHE_BURST_SIZE / regSet->nWords) * regSet->nWords;
 
-#if (DEBUG_PARITY)
-    FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
-                 "burstSize = %u iterations = %u\n",
-                 burstSize,
-                 (numWords + burstSize - 1) / burstSize);
-#endif
 
-    while (numWords != 0)
-    {
-        wcount = (numWords > burstSize) ? burstSize : numWords;
-        if (wcount == 0)
-        {
-            FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "wcount = 0\n");
-            return FM_FAIL;
-        }
+/*****************************************************************************/
+/** fmRegCacheCheckImage
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Checks that an image file saved by
+ *                  ''fmRegCacheSaveImage'' matches the register cache
+ *                  layout of the switch and passes its checksums, without
+ *                  touching the cache or the hardware. Used to decide
+ *                  whether a warm restart can be attempted.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the image file.
+ *
+ * \return          FM_OK if the image can be restored.
+ * \return          FM_ERR_INVALID_ARGUMENT if the switch has no register
+ *                  cache.
+ * \return          FM_ERR_NO_MEM if the image could not be loaded.
+ * \return          FM_ERR_INVALID_VALUE if the image does not match the
+ *                  register cache layout or fails its checksum.
+ * \return          FM_FAIL if the image file could not be opened.
+ *
+ *****************************************************************************/
+fm_status fmRegCacheCheckImage(fm_int sw, const fm_char *fileName)
+{
+    fm_switch *             switchPtr;
+    const fm_cachedRegs **  cachedRegs;
+    fm_regCacheImageSet *   sets;
+    fm_int                  nRegSets;
+    fm_status               err;
 
-#if (DEBUG_PARITY)
-        FM_LOG_DEBUG(FM_LOG_CAT_PARITY,
-                     "restoring regAddr %08x wcount %u\n",
-                     regAddr,
-                     wcount);
-#endif
+    VALIDATE_SWITCH_INDEX(sw);
 
-        TAKE_REG_LOCK(sw);
-        err = switchPtr->WriteUINT32Mult(sw, regAddr, wcount, cachePtr);
-        DROP_REG_LOCK(sw);
+    switchPtr = GET_SWITCH_PTR(sw);
 
-        if (err != FM_OK)
-        {
-            return err;
-        }
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    if (cachedRegs == NULL || fileName == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
-        regAddr  += wcount;
-        cachePtr += wcount;
-        numWords -= wcount;
+    err = LoadImage(sw, fileName, cachedRegs, &sets, &nRegSets);
+    if (err == FM_OK)
+    {
+        FreeImage(sets, nRegSets);
     }
 
-    return FM_OK;
+    return err;
 
-}   /* end fmRegCacheWriteFromCache */
+}   /* end fmRegCacheCheckImage */
 
 
 
 
 /*****************************************************************************/
-/** fmRegCacheComputeChecksum
+/** fmRegCacheRestoreImage
  * \ingroup intRegCache
  *
  * \chips           FM10000
  *
- * \desc            Computes the CRM checksum for a block of consecutive
- *                  entries in the register cache.
+ * \desc            Initializes the register cache from an image file saved
+ *                  by ''fmRegCacheSaveImage'', then reconciles the
+ *                  hardware with it. Only the register entries whose
+ *                  hardware contents differ from the image are written,
+ *                  so tables that survived a process restart are left
+ *                  untouched.
+ *                                                                      \lb\lb
+ *                  The whole image is loaded into scratch buffers and
+ *                  each register set is validated against its saved
+ *                  checksum before anything is copied into the cache, so
+ *                  a stale or corrupted image never reaches the cache or
+ *                  the hardware. Volatile register sets, which the
+ *                  hardware updates on its own, are refreshed from the
+ *                  hardware rather than written.
+ *
+ * \note            This function replaces ''fmInitRegisterCache'' on a
+ *                  warm restart and must be called with the switch lock
+ *                  held. If it fails, the register cache is left
+ *                  uninitialized and the caller must fall back to
+ *                  ''fmInitRegisterCache''.
  *
  * \param[in]       sw is the switch on which to operate.
  *
- * \param[in]       regSet points to the register set descriptor.
- * 
- * \param[in]       indices points to an array specifying the indices of the
- *                  first entry to write.
- * 
- * \param[in]       nEntries is the number of register entries to write.
- * 
- * \param[out]      checksum points to the location to receive the checksum.
+ * \param[in]       fileName is the name of the image file.
+ *
+ * \param[out]      stats points to the location to receive the restore
+ *                  statistics. May be NULL.
  *
  * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the switch has no register
+ *                  cache.
+ * \return          FM_ERR_NO_MEM if the image could not be loaded.
+ * \return          FM_ERR_INVALID_VALUE if the image does not match the
+ *                  register cache layout or fails its checksum.
+ * \return          FM_FAIL if the image file could not be opened.
  *
  *****************************************************************************/
-fm_status fmRegCacheComputeChecksum(fm_int                sw,
-                                    const fm_cachedRegs * regSet,
-                                    const fm_uint32 *     indices,
-                                    fm_int                nEntries,
-                                    fm_uint32 *           checksum)
+fm_status fmRegCacheRestoreImage(fm_int                    sw,
+                                 const fm_char *           fileName,
+                                 fm_regCacheRestoreStats * stats)
 {
-    fm_scatterGatherListEntry   sgList[1];
-    fm_registerSGListEntry      entry;
-    fm_int                      sgListSize;
-    fm_uint32                   numWords;
-    fm_uint32 *                 cachePtr;
-    fm_uint32                   value;
+    fm_switch *             switchPtr;
+    const fm_cachedRegs **  cachedRegs;
+    const fm_cachedRegs **  regs;
+    fm_regCacheImageSet *   sets;
+    fm_regCacheRestoreStats localStats;
+    fm_timestamp            start;
+    fm_timestamp            end;
+    fm_timestamp            diff;
+    fm_int                  nRegSets;
+    fm_int                  i;
+    fm_status               err;
 
-    FM_NOT_USED(sw);
+    VALIDATE_SWITCH_INDEX(sw);
 
-    if (regSet == NULL)
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    if (cachedRegs == NULL || fileName == NULL)
     {
         return FM_ERR_INVALID_ARGUMENT;
     }
 
-    entry.registerSet = regSet;
-    entry.data        = NULL;
-    entry.count       = nEntries;
-    entry.idx[0]      = indices[0];
-    entry.idx[1]      = indices[1];
-    entry.idx[2]      = indices[2];
-    entry.rewriting   = FALSE;
-
-    if ( !IsScatterGatherListCorrect(&entry, 1) )
+    if (stats == NULL)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "invalid scatter-gather list\n");
-        return FM_ERR_INVALID_ARGUMENT;
+        stats = &localStats;
     }
 
-    entry.data  = regSet->getCache.data(sw);
-    entry.data += fmRegCacheComputeOffset(indices, regSet);
+    FM_CLEAR(*stats);
 
-    /* Find out how many scatter-gather entries we will need. */
-    sgListSize = fmRegCacheConvSGList(sw, 1, &entry, NULL, FALSE);
+    fmGetTime(&start);
 
-    if (sgListSize != 1)
+    /* Load and validate the whole image before touching the cache. */
+    err = LoadImage(sw, fileName, cachedRegs, &sets, &nRegSets);
+    if (err != FM_OK)
     {
-        FM_LOG_ERROR(FM_LOG_CAT_GENERAL, "sgListSize (%d) != 1\n", sgListSize);
-        return FM_ERR_INVALID_ARGUMENT;
+        return err;
     }
 
-    fmRegCacheConvSGList(sw, 1, &entry, sgList, FALSE);
+    err = fmRegCacheInitKeyValid(sw, cachedRegs);
 
-    numWords = sgList[0].count;
-    cachePtr = sgList[0].data;
-    value    = 0;
+    for (i = 0 ; err == FM_OK && i < nRegSets ; i++)
+    {
+        err = CommitRegSetImage(sw, cachedRegs[i], &sets[i]);
+    }
 
-    while (numWords != 0)
+    FreeImage(sets, nRegSets);
+
+    for (regs = cachedRegs ; err == FM_OK && *regs != NULL ; regs++)
     {
-        value ^= *cachePtr;
-        cachePtr++;
-        numWords--;
+        if ( (*regs)->isVolatile )
+        {
+            err = RefreshRegSet(sw, *regs);
+        }
+        else
+        {
+            err = ReconcileRegSet(sw, *regs, stats);
+        }
+
+        stats->nRegSets++;
     }
 
-#if 0
-    FM_LOG_PRINT("idx=[%d,%d,%d] nEntries=%d regAddr=%08x cachePtr=%p count=%u "
-                 "value=%08x\n",
-                 indices[0], indices[1], indices[2],
-                 nEntries,
-                 sgList[0].addr,
-                 (void *)sgList[0].data,
-                 sgList[0].count,
-                 value);
-#endif
+    if (err != FM_OK)
+    {
+        fmRegCacheFreeKeyValid(sw, cachedRegs);
+        return err;
+    }
 
-    *checksum = value;
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &diff);
+
+    stats->usec = diff.sec * 1000000 + diff.usec;
+
+    FM_LOG_DEBUG(FM_LOG_CAT_SWITCH,
+                 "Switch %d register cache restored from %s in %"
+                 FM_FORMAT_64 "u usec: "
+                 "%u of %u entries rewritten in %u writes\n",
+                 sw,
+                 fileName,
+                 stats->usec,
+                 stats->nDiffering,
+                 stats->nEntries,
+                 stats->nWrites);
 
     return FM_OK;
 
-}   /* end fmRegCacheComputeChecksum */
+}   /* end fmRegCacheRestoreImage */
 
 
 
@@ -2466,3 +3687,228 @@ fm_status fmDbgDumpRegCacheEntry(fm_int                sw,
 
 }   /* end fmDbgDumpRegCacheEntry */
 
+
+
+
+/*****************************************************************************/
+/** fmDbgTestRegCacheImage
+ * \ingroup intRegCache
+ *
+ * \chips           FM10000
+ *
+ * \desc            Tests the register cache image round trip: the cache is
+ *                  saved to an image file, the image is checked, the cache
+ *                  is restored from it as on a warm restart, and the
+ *                  restored contents and key valid bits are compared with
+ *                  a copy of the cache taken before the save.
+ *                                                                      \lb\lb
+ *                  Volatile register sets are refreshed from the hardware
+ *                  by the restore and are not compared. If the restore
+ *                  fails, the cache is reinitialized from the hardware.
+ *
+ * \note            The caller must hold the switch lock.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       fileName is the name of the scratch image file.
+ *
+ * \return          FM_OK if the restored cache matches the original.
+ * \return          FM_ERR_INVALID_ARGUMENT if the switch has no register
+ *                  cache.
+ * \return          FM_ERR_NO_MEM if the copy of the cache could not be
+ *                  allocated.
+ * \return          FM_FAIL if the restored cache differs from the original.
+ * \return          Other ''Status Codes'' as returned by the save, check or
+ *                  restore of the image.
+ *
+ *****************************************************************************/
+fm_status fmDbgTestRegCacheImage(fm_int sw, const fm_char *fileName)
+{
+    fm_switch *             switchPtr;
+    const fm_cachedRegs **  cachedRegs;
+    const fm_cachedRegs *   regSet;
+    fm_regCacheImageSet *   sets;
+    fm_regCacheRestoreStats stats;
+    fm_uint32               secondDimension;
+    fm_uint32               thirdDimension;
+    fm_uint32               nValidWords;
+    fm_uint32               nDiffering;
+    fm_uint32               nMismatches;
+    fm_uint32               j;
+    fm_bool                 bitValue;
+    fm_int                  nRegSets;
+    fm_int                  i;
+    fm_status               err;
+
+    VALIDATE_SWITCH_INDEX(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    cachedRegs = (const fm_cachedRegs **)(switchPtr->CachedRegisterList);
+    if (cachedRegs == NULL || fileName == NULL)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    for (nRegSets = 0 ; cachedRegs[nRegSets] != NULL ; nRegSets++)
+    {
+        ;
+    }
+
+    sets = fmAlloc(nRegSets * sizeof(fm_regCacheImageSet));
+    if (sets == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_MEMSET_S(sets,
+                nRegSets * sizeof(fm_regCacheImageSet),
+                0,
+                nRegSets * sizeof(fm_regCacheImageSet));
+
+    /* Take a copy of the cache, laid out as in the image. */
+    err = FM_OK;
+
+    for (i = 0 ; err == FM_OK && i < nRegSets ; i++)
+    {
+        regSet = cachedRegs[i];
+
+        GetRegSetDimensions(regSet, &secondDimension, &thirdDimension);
+
+        sets[i].nCacheWords = regSet->nWords * regSet->nElements[0] *
+                              secondDimension * thirdDimension;
+        sets[i].nValidBits  = GetKeyValidSize(sw, regSet);
+        nValidWords         = (sets[i].nValidBits + 31) / 32;
+
+        sets[i].data = fmAlloc(sets[i].nCacheWords * sizeof(fm_uint32));
+        if (sets[i].data == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            break;
+        }
+
+        FM_MEMCPY_S(sets[i].data,
+                    sets[i].nCacheWords * sizeof(fm_uint32),
+                    regSet->getCache.data(sw),
+                    sets[i].nCacheWords * sizeof(fm_uint32));
+
+        if (nValidWords == 0)
+        {
+            continue;
+        }
+
+        sets[i].validWords = fmAlloc(nValidWords * sizeof(fm_uint32));
+        if (sets[i].validWords == NULL)
+        {
+            err = FM_ERR_NO_MEM;
+            break;
+        }
+
+        FM_MEMSET_S(sets[i].validWords,
+                    nValidWords * sizeof(fm_uint32),
+                    0,
+                    nValidWords * sizeof(fm_uint32));
+
+        for (j = 0 ; j < sets[i].nValidBits ; j++)
+        {
+            err = fmGetBitArrayBit(regSet->getCache.valid(sw), j, &bitValue);
+            if (err != FM_OK)
+            {
+                break;
+            }
+
+            if (bitValue)
+            {
+                sets[i].validWords[j / 32] |= 1U << (j % 32);
+            }
+        }
+    }
+
+    if (err == FM_OK)
+    {
+        err = fmRegCacheSaveImage(sw, fileName);
+        FM_LOG_PRINT("Save:    %s\n", fmErrorMsg(err));
+    }
+
+    if (err == FM_OK)
+    {
+        err = fmRegCacheCheckImage(sw, fileName);
+        FM_LOG_PRINT("Check:   %s\n", fmErrorMsg(err));
+    }
+
+    if (err == FM_OK)
+    {
+        /* The restore recreates the key valid bit arrays. */
+        fmRegCacheFreeKeyValid(sw, cachedRegs);
+
+        err = fmRegCacheRestoreImage(sw, fileName, &stats);
+        FM_LOG_PRINT("Restore: %s, %u of %u entries rewritten\n",
+                     fmErrorMsg(err),
+                     stats.nDiffering,
+                     stats.nEntries);
+
+        if (err != FM_OK)
+        {
+            fmInitRegisterCache(sw);
+        }
+    }
+
+    nMismatches = 0;
+
+    for (i = 0 ; err == FM_OK && i < nRegSets ; i++)
+    {
+        regSet = cachedRegs[i];
+
+        if (regSet->isVolatile)
+        {
+            continue;
+        }
+
+        nDiffering = 0;
+
+        for (j = 0 ; j < sets[i].nCacheWords ; j++)
+        {
+            if (regSet->getCache.data(sw)[j] != sets[i].data[j])
+            {
+                nDiffering++;
+            }
+        }
+
+        for (j = 0 ; j < sets[i].nValidBits ; j++)
+        {
+            err = fmGetBitArrayBit(regSet->getCache.valid(sw), j, &bitValue);
+            if (err != FM_OK)
+            {
+                break;
+            }
+
+            if ( bitValue !=
+                 ( (sets[i].validWords[j / 32] & (1U << (j % 32))) != 0 ) )
+            {
+                nDiffering++;
+            }
+        }
+
+        if (nDiffering > 0)
+        {
+            FM_LOG_PRINT("Register set 0x%08x: %u words or key valid bits "
+                         "differ after the restore\n",
+                         regSet->baseAddr,
+                         nDiffering);
+            nMismatches += nDiffering;
+        }
+    }
+
+    if (err == FM_OK && nMismatches > 0)
+    {
+        err = FM_FAIL;
+    }
+
+    FM_LOG_PRINT("Result:  %s\n", (err == FM_OK) ? "PASS" : "FAIL");
+
+    FreeImage(sets, nRegSets);
+
+    return err;
+
+}   /* end fmDbgTestRegCacheImage */
+
@@ -64,6 +64,21 @@ static void SetVirtualRouterMac(fm_switch *switchPtr,
                                 fm_int     vrMacId,
                                 fm_macaddr macAddr);
 static void DestroyRecord(void *key, void *data);
+static void IPAddrToLpmKey(const fm_ipAddr *ip, fm_byte *key);
+static fm_status GetRouteLookupLpm(fm_int       sw,
+                                   fm_int       vrid,
+                                   fm_bool      isIPv6,
+                                   fm_lpmTrie **lpmPtrPtr);
+static fm_status InsertRouteLookupEntry(fm_int            sw,
+                                        fm_int            vrid,
+                                        fm_int            prefixLength,
+                                        fm_customTree *   lookupTree,
+                                        fm_intRouteEntry *route);
+static void RemoveRouteLookupEntry(fm_int            sw,
+                                   fm_int            vrid,
+                                   fm_int            prefixLength,
+                                   fm_customTree *   lookupTree,
+                                   fm_intRouteEntry *route);
 
 
 /*****************************************************************************
@@ -628,6 +643,204 @@ static void DestroyRecord(void *key, void *data)
 
 
 
+/*****************************************************************************/
+/** IPAddrToLpmKey
+ * \ingroup intRouter
+ *
+ * \desc            Converts an IP address into a route lookup trie key,
+ *                  most significant byte first.
+ *
+ * \param[in]       ip points to the IP address.
+ *
+ * \param[out]      key points to caller-allocated storage of at least
+ *                  FM_LPM_MAX_KEY_BYTES bytes into which the key is written.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void IPAddrToLpmKey(const fm_ipAddr *ip, fm_byte *key)
+{
+    fm_int    numWords;
+    fm_int    i;
+    fm_uint32 word;
+
+    /* For IPv6, addr[0] holds the least significant 32 bits. */
+    numWords = ip->isIPv6 ? 4 : 1;
+
+    for (i = 0 ; i < numWords ; i++)
+    {
+        word = ntohl(ip->addr[numWords - 1 - i]);
+
+        key[i * 4]     = (fm_byte) (word >> 24);
+        key[i * 4 + 1] = (fm_byte) (word >> 16);
+        key[i * 4 + 2] = (fm_byte) (word >> 8);
+        key[i * 4 + 3] = (fm_byte) word;
+    }
+
+}   /* end IPAddrToLpmKey */
+
+
+
+
+/*****************************************************************************/
+/** GetRouteLookupLpm
+ * \ingroup intRouter
+ *
+ * \desc            Returns the longest-prefix-match trie associated with a
+ *                  vrid and address family.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       isIPv6 is TRUE for the IPv6 trie, FALSE for IPv4.
+ *
+ * \param[out]      lpmPtrPtr points to caller-provided storage into which
+ *                  the pointer to the trie will be written.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if route lookups are not supported.
+ * \return          FM_ERR_INVALID_VRID if vrid is invalid.
+ *
+ *****************************************************************************/
+static fm_status GetRouteLookupLpm(fm_int       sw,
+                                   fm_int       vrid,
+                                   fm_bool      isIPv6,
+                                   fm_lpmTrie **lpmPtrPtr)
+{
+    fm_switch *switchPtr;
+    fm_int     vroff;
+    fm_status  err;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if (switchPtr->routeLookupLpm == NULL)
+    {
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    err = fmValidateVirtualRouterId(sw, vrid, &vroff);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    if (vrid == FM_ROUTER_ANY)
+    {
+        /* Use maxVirtualRouters number as an index for vrid = FM_ROUTER_ANY */
+        vroff = switchPtr->maxVirtualRouters;
+    }
+
+    *lpmPtrPtr = &switchPtr->routeLookupLpm[(vroff * 2) + (isIPv6 ? 1 : 0)];
+
+    return FM_OK;
+
+}   /* end GetRouteLookupLpm */
+
+
+
+
+/*****************************************************************************/
+/** InsertRouteLookupEntry
+ * \ingroup intRouter
+ *
+ * \desc            Adds a route to a route lookup tree and to the
+ *                  longest-prefix-match trie that mirrors the lookup trees.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       prefixLength is the destination prefix length.
+ *
+ * \param[in]       lookupTree points to the route lookup tree for vrid and
+ *                  prefixLength.
+ *
+ * \param[in]       route points to the route.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+static fm_status InsertRouteLookupEntry(fm_int            sw,
+                                        fm_int            vrid,
+                                        fm_int            prefixLength,
+                                        fm_customTree *   lookupTree,
+                                        fm_intRouteEntry *route)
+{
+    fm_lpmTrie *lpm;
+    fm_byte     key[FM_LPM_MAX_KEY_BYTES];
+    fm_status   err;
+
+    err = fmCustomTreeInsert(lookupTree, route->destIPAddress, route);
+    if (err != FM_OK)
+    {
+        return err;
+    }
+
+    err = GetRouteLookupLpm(sw, vrid, route->destIPAddress->isIPv6, &lpm);
+
+    if (err == FM_OK)
+    {
+        IPAddrToLpmKey(route->destIPAddress, key);
+        err = fmLpmInsert(lpm, key, prefixLength, route);
+    }
+
+    if (err != FM_OK)
+    {
+        fmCustomTreeRemove(lookupTree, route->destIPAddress, NULL);
+    }
+
+    return err;
+
+}   /* end InsertRouteLookupEntry */
+
+
+
+
+/*****************************************************************************/
+/** RemoveRouteLookupEntry
+ * \ingroup intRouter
+ *
+ * \desc            Removes a route from a route lookup tree and from the
+ *                  longest-prefix-match trie that mirrors the lookup trees.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       prefixLength is the destination prefix length.
+ *
+ * \param[in]       lookupTree points to the route lookup tree for vrid and
+ *                  prefixLength.
+ *
+ * \param[in]       route points to the route.
+ *
+ * \return          Nothing.
+ *
+ *****************************************************************************/
+static void RemoveRouteLookupEntry(fm_int            sw,
+                                   fm_int            vrid,
+                                   fm_int            prefixLength,
+                                   fm_customTree *   lookupTree,
+                                   fm_intRouteEntry *route)
+{
+    fm_lpmTrie *lpm;
+    fm_byte     key[FM_LPM_MAX_KEY_BYTES];
+
+    fmCustomTreeRemove(lookupTree, route->destIPAddress, NULL);
+
+    if (GetRouteLookupLpm(sw, vrid, route->destIPAddress->isIPv6, &lpm) == FM_OK)
+    {
+        IPAddrToLpmKey(route->destIPAddress, key);
+        fmLpmRemove(lpm, key, prefixLength);
+    }
+
+}   /* end RemoveRouteLookupEntry */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -958,11 +1171,10 @@ fm_status fmGetIntRouteForIP(fm_int             sw,
                              fm_intRouteEntry **routePtrPtr)
 {
     fm_switch *       switchPtr;
-    fm_int            prefixLength;
-    fm_customTree *   routeLookupTree;
+    fm_lpmTrie *      lpm;
+    fm_byte           key[FM_LPM_MAX_KEY_BYTES];
     fm_intRouteEntry *route;
     fm_status         status;
-    fm_ipAddr         maskedIP;
 
     FM_LOG_ENTRY( FM_LOG_CAT_ROUTING,
                   "sw = %d, vrid = %d, ip = %p, routePtrPtr = %p\n",
@@ -985,33 +1197,19 @@ fm_status fmGetIntRouteForIP(fm_int             sw,
         FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_INVALID_ARGUMENT);
     }
 
-    if (ip->isIPv6)
-    {
-        prefixLength = FM_IPV6_MAX_PREFIX_LENGTH;
-    }
-    else
-    {
-        prefixLength = FM_IPV4_MAX_PREFIX_LENGTH;
-    }
-
-    while (prefixLength >= 0)
-    {
-        maskedIP = *ip;
-        fmMaskIPAddress(&maskedIP, prefixLength);
+    /* The trie holds the same routes as the per-prefix lookup trees, but
+     * finds the longest match in a single bounded walk instead of probing
+     * every prefix length. */
+    status = GetRouteLookupLpm(sw, vrid, ip->isIPv6, &lpm);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ROUTING, status);
 
-        status = fmGetRouteLookupTree(sw, vrid, prefixLength, &routeLookupTree);
-        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_ROUTING, status);
-
-        status = fmCustomTreeFind( routeLookupTree,
-                                   &maskedIP,
-                                   (void **) &route );
-        if (status == FM_OK)
-        {
-            *routePtrPtr = route;
-            FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
-        }
+    IPAddrToLpmKey(ip, key);
 
-        --prefixLength;
+    status = fmLpmLookup(lpm, key, (void **) &route, NULL);
+    if (status == FM_OK)
+    {
+        *routePtrPtr = route;
+        FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_ERR_NO_ROUTE_TO_HOST);
@@ -1141,6 +1339,7 @@ fm_status fmRouterAlloc(fm_int sw)
     switchPtr->virtualRouterMacModes = NULL;
     switchPtr->virtualRouterIds      = NULL;
     switchPtr->routeLookupTrees      = NULL;
+    switchPtr->routeLookupLpm        = NULL;
 
     /* If routing is not supported, exit */
     if (switchPtr->RouterInit != NULL)
@@ -1215,6 +1414,22 @@ fm_status fmRouterAlloc(fm_int sw)
                     }
                 }
             }
+
+            if ( (err == FM_OK) && (switchPtr->routeLookupTrees != NULL) )
+            {
+                /* One longest-prefix-match trie per address family for each
+                 * virtual router, plus one pair for vrid = FM_ROUTER_ANY. */
+                tsize = sizeof(fm_lpmTrie) * (switchPtr->maxVirtualRouters + 1) * 2;
+                switchPtr->routeLookupLpm = fmAlloc(tsize);
+                if (switchPtr->routeLookupLpm != NULL)
+                {
+                    FM_MEMSET_S(switchPtr->routeLookupLpm, tsize, 0, tsize);
+                }
+                else
+                {
+                    err = FM_ERR_NO_MEM;
+                }
+            }
         }
         /* if error: free all allocated memory */
         if (err != FM_OK)
@@ -1274,6 +1489,12 @@ fm_status fmRouterFree(fm_int sw)
         switchPtr->routeLookupTrees = NULL;
     }
 
+    if (switchPtr->routeLookupLpm != NULL)
+    {
+        fmFree(switchPtr->routeLookupLpm);
+        switchPtr->routeLookupLpm = NULL;
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, FM_OK);
 
 }   /* end fmRouterFree */
@@ -1366,6 +1587,17 @@ fm_status fmRouterInit(fm_int sw)
         }
     }
 
+    if (switchPtr->routeLookupLpm != NULL)
+    {
+        for (index1 = 0 ; index1 < (switchPtr->maxVirtualRouters + 1) ; index1++)
+        {
+            fmLpmInit(&switchPtr->routeLookupLpm[index1 * 2],
+                      FM_IPV4_MAX_PREFIX_LENGTH);
+            fmLpmInit(&switchPtr->routeLookupLpm[(index1 * 2) + 1],
+                      FM_IPV6_MAX_PREFIX_LENGTH);
+        }
+    }
+
     FM_LOG_EXIT(FM_LOG_CAT_ROUTING, err);
 
 }   /* end fmRouterInit */
@@ -1414,6 +1646,14 @@ fm_status fmRouterCleanup(fm_int sw)
         }
     }
 
+    if (switchPtr->routeLookupLpm != NULL)
+    {
+        for (vrid = 0 ; vrid < (switchPtr->maxVirtualRouters + 1) * 2 ; vrid++)
+        {
+            fmLpmDestroy(&switchPtr->routeLookupLpm[vrid]);
+        }
+    }
+
     /**************************************************
      * Destroy route tables
      **************************************************/
@@ -2953,9 +3193,11 @@ fm_status fmAddRouteInternal(fm_int          sw,
 
     if (routeLookupTree != NULL)
     {
-        err = fmCustomTreeInsert(routeLookupTree,
-                                 routeEntry->destIPAddress,
-                                 routeEntry);
+        err = InsertRouteLookupEntry(sw,
+                                     vrid,
+                                     routePrefixLength,
+                                     routeLookupTree,
+                                     routeEntry);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
 
         routeAddedToLookupTree = TRUE;
@@ -3011,7 +3253,11 @@ ABORT:
 
         if (routeAddedToLookupTree)
         {
-            fmCustomTreeRemove(routeLookupTree, routeEntry->destIPAddress, NULL);
+            RemoveRouteLookupEntry(sw,
+                                   vrid,
+                                   routePrefixLength,
+                                   routeLookupTree,
+                                   routeEntry);
         }
 
         if (routeAllocated)
@@ -3477,9 +3723,11 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
                  * it is easier to just make KW happy than to fight it. */
                 if ( (routeLookupTree != NULL) && (ecmpRoute != NULL) )
                 {
-                    fmCustomTreeRemove(routeLookupTree,
-                                       ecmpRoute->destIPAddress,
-                                       NULL);
+                    RemoveRouteLookupEntry(sw,
+                                           vrid,
+                                           routePrefixLength,
+                                           routeLookupTree,
+                                           ecmpRoute);
                 }
 
                 /* Get the first remaining next hop from the ECMP group. */
@@ -3511,9 +3759,11 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
 
                 if (routeLookupTree != NULL)
                 {
-                    err = fmCustomTreeInsert(routeLookupTree,
-                                             ecmpRoute->destIPAddress,
-                                             ecmpRoute);
+                    err = InsertRouteLookupEntry(sw,
+                                                 vrid,
+                                                 routePrefixLength,
+                                                 routeLookupTree,
+                                                 ecmpRoute);
                     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_ROUTING, err);
                 }
 
@@ -3567,7 +3817,11 @@ fm_status fmDeleteRouteInternal(fm_int         sw,
 
     if (routeLookupTree != NULL)
     {
-        fmCustomTreeRemove(routeLookupTree, curRoute->destIPAddress, NULL);
+        RemoveRouteLookupEntry(sw,
+                               vrid,
+                               routePrefixLength,
+                               routeLookupTree,
+                               curRoute);
     }
 
     switch (curRoute->route.routeType)
@@ -6407,6 +6661,231 @@ fm_status fmDbgDumpRouteForIP(fm_int sw, fm_int vrid, fm_text ipAddr)
 
 
 
+/*****************************************************************************/
+/** fmDbgBenchmarkRouteLookup
+ * \ingroup diagMisc
+ *
+ * \chips           FM4000, FM6000, FM10000
+ *
+ * \desc            Measures the cost of resolving the destination address
+ *                  of every route in a virtual router's lookup tables,
+ *                  comparing the longest-prefix-match trie used by
+ *                  route lookups against a probe of the per-prefix lookup
+ *                  trees, and verifies that both return the same route.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       vrid is the virtual router ID number.
+ *
+ * \param[in]       iterations is the number of passes to make over the
+ *                  route addresses.
+ *
+ * \return          FM_OK if successful
+ * \return          FM_ERR_INVALID_SWITCH if the switch ID is invalid
+ * \return          FM_ERR_SWITCH_NOT_UP  if the switch is not running
+ * \return          FM_ERR_NO_MEM if memory could not be allocated
+ * \return          FM_FAIL if the trie and the trees disagree
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkRouteLookup(fm_int sw, fm_int vrid, fm_int iterations)
+{
+    fm_status             status;
+    fm_int                prefix;
+    fm_int                numProbes;
+    fm_int                maxProbes;
+    fm_int                probe;
+    fm_int                pass;
+    fm_int                mismatches;
+    fm_customTree *       lookupTree;
+    fm_customTreeIterator iter;
+    fm_ipAddr *           routeIP;
+    fm_ipAddr *           probes;
+    fm_ipAddr             maskedIP;
+    fm_intRouteEntry *    route;
+    fm_intRouteEntry *    treeRoute;
+    fm_intRouteEntry *    lpmRoute;
+    fm_lpmTrie *          lpm;
+    fm_byte               key[FM_LPM_MAX_KEY_BYTES];
+    fm_timestamp          start;
+    fm_timestamp          end;
+    fm_timestamp          treeTime;
+    fm_timestamp          lpmTime;
+    fm_uint64             lookups;
+
+    VALIDATE_AND_PROTECT_SWITCH( sw );
+
+    probes     = NULL;
+    numProbes  = 0;
+    maxProbes  = 0;
+    mismatches = 0;
+
+    /* Count the routes so the probe addresses can be collected. */
+    for (prefix = 0 ; prefix < FM_MAX_NUM_IP_PREFIXES ; prefix++)
+    {
+        status = fmGetRouteLookupTree(sw, vrid, prefix, &lookupTree);
+        if (status != FM_OK)
+        {
+            goto ABORT;
+        }
+
+        maxProbes += fmCustomTreeSize(lookupTree);
+    }
+
+    if (maxProbes == 0)
+    {
+        FM_LOG_PRINT("No routes in virtual router %d\n", vrid);
+        status = FM_OK;
+        goto ABORT;
+    }
+
+    probes = fmAlloc( maxProbes * sizeof(fm_ipAddr) );
+    if (probes == NULL)
+    {
+        status = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    for (prefix = 0 ; prefix < FM_MAX_NUM_IP_PREFIXES ; prefix++)
+    {
+        fmGetRouteLookupTree(sw, vrid, prefix, &lookupTree);
+        fmCustomTreeIterInit(&iter, lookupTree);
+
+        while ( (numProbes < maxProbes)
+               && (fmCustomTreeIterNext( &iter,
+                                         (void **) &routeIP,
+                                         (void **) &route ) == FM_OK) )
+        {
+            probes[numProbes++] = *routeIP;
+        }
+    }
+
+    /* Verify that both lookup methods agree. */
+    for (probe = 0 ; probe < numProbes ; probe++)
+    {
+        treeRoute = NULL;
+        lpmRoute  = NULL;
+
+        for (prefix = probes[probe].isIPv6 ? FM_IPV6_MAX_PREFIX_LENGTH
+                                           : FM_IPV4_MAX_PREFIX_LENGTH ;
+             prefix >= 0 ;
+             prefix--)
+        {
+            maskedIP = probes[probe];
+            fmMaskIPAddress(&maskedIP, prefix);
+            fmGetRouteLookupTree(sw, vrid, prefix, &lookupTree);
+
+            if (fmCustomTreeFind(lookupTree,
+                                 &maskedIP,
+                                 (void **) &treeRoute) == FM_OK)
+            {
+                break;
+            }
+        }
+
+        fmGetIntRouteForIP(sw, vrid, &probes[probe], &lpmRoute);
+
+        if (treeRoute != lpmRoute)
+        {
+            mismatches++;
+        }
+    }
+
+    /* Time the per-prefix tree probe. */
+    fmGetTime(&start);
+
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        for (probe = 0 ; probe < numProbes ; probe++)
+        {
+            for (prefix = probes[probe].isIPv6 ? FM_IPV6_MAX_PREFIX_LENGTH
+                                               : FM_IPV4_MAX_PREFIX_LENGTH ;
+                 prefix >= 0 ;
+                 prefix--)
+            {
+                maskedIP = probes[probe];
+                fmMaskIPAddress(&maskedIP, prefix);
+                fmGetRouteLookupTree(sw, vrid, prefix, &lookupTree);
+
+                if (fmCustomTreeFind(lookupTree,
+                                     &maskedIP,
+                                     (void **) &treeRoute) == FM_OK)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &treeTime);
+
+    /* Time the trie lookup. */
+    fmGetTime(&start);
+
+    for (pass = 0 ; pass < iterations ; pass++)
+    {
+        for (probe = 0 ; probe < numProbes ; probe++)
+        {
+            if (GetRouteLookupLpm(sw, vrid, probes[probe].isIPv6, &lpm) == FM_OK)
+            {
+                IPAddrToLpmKey(&probes[probe], key);
+                fmLpmLookup(lpm, key, (void **) &lpmRoute, NULL);
+            }
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &lpmTime);
+
+    lookups = (fm_uint64) numProbes * (fm_uint64) ( (iterations > 0) ? iterations : 1 );
+
+    FM_LOG_PRINT("Route lookup benchmark, vrid %d: %d routes, %d passes\n",
+                 vrid,
+                 numProbes,
+                 iterations);
+    FM_LOG_PRINT("  Prefix trees : %" FM_FORMAT_64 "u usec (%" FM_FORMAT_64
+                 "u nsec/lookup)\n",
+                 treeTime.sec * 1000000 + treeTime.usec,
+                 (treeTime.sec * 1000000 + treeTime.usec) * 1000 / lookups);
+    FM_LOG_PRINT("  LPM trie     : %" FM_FORMAT_64 "u usec (%" FM_FORMAT_64
+                 "u nsec/lookup)\n",
+                 lpmTime.sec * 1000000 + lpmTime.usec,
+                 (lpmTime.sec * 1000000 + lpmTime.usec) * 1000 / lookups);
+
+    if (GetRouteLookupLpm(sw, vrid, FALSE, &lpm) == FM_OK)
+    {
+        FM_LOG_PRINT("  IPv4 trie    : %d prefixes, %d nodes\n",
+                     lpm->numPrefixes,
+                     lpm->numNodes);
+    }
+
+    if (GetRouteLookupLpm(sw, vrid, TRUE, &lpm) == FM_OK)
+    {
+        FM_LOG_PRINT("  IPv6 trie    : %d prefixes, %d nodes\n",
+                     lpm->numPrefixes,
+                     lpm->numNodes);
+    }
+
+    FM_LOG_PRINT("  Mismatches   : %d\n", mismatches);
+
+    status = (mismatches == 0) ? FM_OK : FM_FAIL;
+
+ABORT:
+
+    if (probes != NULL)
+    {
+        fmFree(probes);
+    }
+
+    UNPROTECT_SWITCH( sw );
+
+    return status;
+
+}   /* end fmDbgBenchmarkRouteLookup */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgValidateRouteTables
  * \ingroup intDebug
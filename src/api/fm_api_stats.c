@@ -645,6 +645,160 @@ fm_status fmResetPortCounters(fm_int sw, fm_int port)
 
 
 
+/*****************************************************************************/
+/** fmGetPortCounterRates
+ * \ingroup stats
+ *
+ * \chips           FM10000
+ *
+ * \desc            Retrieve the frame and bit rates of a port, as derived
+ *                  by the statistics collector from its two most recent
+ *                  sweeps of the port counters. Does not access the
+ *                  hardware.
+ *
+ * \note            The statistics collector is only running when the
+ *                  ''api.statsCollector.period'' API property is non-zero.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       port is the port for which to retrieve the rates. May
+ *                  be the CPU interface port.
+ *
+ * \param[out]      rates points to an ''fm_portCounterRates'' structure to
+ *                  be filled in by this function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_PORT if port is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if rates is NULL.
+ * \return          FM_ERR_UNSUPPORTED if the statistics collector is not
+ *                  running.
+ *
+ *****************************************************************************/
+fm_status fmGetPortCounterRates(fm_int               sw,
+                                fm_int               port,
+                                fm_portCounterRates *rates)
+{
+    fm_status  err;
+    fm_switch *switchPtr;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_PORT, 
+                     "sw=%d port=%d rates=%p\n", 
+                     sw, 
+                     port, 
+                     (void *) rates);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+    VALIDATE_LOGICAL_PORT(sw, port, ALLOW_CPU);
+
+    if (rates == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PORT, err);
+    }
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    FM_API_CALL_FAMILY(err, switchPtr->GetPortCounterRates, sw, port, rates);
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_PORT, err);
+
+}   /* end fmGetPortCounterRates */
+
+
+
+
+/*****************************************************************************/
+/** fmStatsCollectorTask
+ * \ingroup intStats
+ *
+ * \desc            Generic thread wrapper for the chip specific statistics
+ *                  collector. Sweeps the port counters of every switch
+ *                  that is up once per ''api.statsCollector.period''
+ *                  milliseconds.
+ *
+ * \param[in]       args contains a pointer to the thread information.
+ *
+ * \return          Should never exit.
+ *
+ *****************************************************************************/
+void *fmStatsCollectorTask(void *args)
+{
+    fm_thread * thread;
+    fm_thread * eventHandler;
+    fm_switch * switchPtr;
+    fm_status   err;
+    fm_int      sw;
+    fm_int      period;
+
+    thread       = FM_GET_THREAD_HANDLE(args);
+    eventHandler = FM_GET_THREAD_PARAM(fm_thread, args);
+
+    /* If logging is disabled, thread and eventHandler won't be used */
+    FM_NOT_USED(thread);
+    FM_NOT_USED(eventHandler);
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PORT,
+                 "thread=%s, eventHandler=%s\n",
+                 thread->name,
+                 eventHandler->name);
+
+    period = GET_PROPERTY()->statsCollectorPer;
+
+    for ( ; ; )
+    {
+        for (sw = FM_FIRST_FOCALPOINT ; sw <= FM_LAST_FOCALPOINT ; sw++)
+        {
+            if (!SWITCH_LOCK_EXISTS(sw))
+            {
+                continue;
+            }
+
+            PROTECT_SWITCH(sw);
+
+            switchPtr = GET_SWITCH_PTR(sw);
+
+            if (switchPtr &&
+                switchPtr->state == FM_SWITCH_STATE_UP &&
+                switchPtr->CollectPortCounters)
+            {
+                err = switchPtr->CollectPortCounters(sw);
+
+                if (err != FM_OK)
+                {
+                    FM_LOG_WARNING(FM_LOG_CAT_PORT,
+                                   "Unable to collect port counters on "
+                                   "switch %d: %s\n",
+                                   sw,
+                                   fmErrorMsg(err));
+                }
+            }
+
+            UNPROTECT_SWITCH(sw);
+        }
+
+        fmDelay(period / 1000, (period % 1000) * 1000000);
+
+    }   /* end for ( ; ; ) */
+
+    /**************************************************
+     * Should never exit.
+     **************************************************/
+
+    FM_LOG_ERROR(FM_LOG_CAT_PORT,
+                 "fmStatsCollectorTask exiting inadvertently!\n");
+
+    fmExitThread(thread);
+    return NULL;
+
+}   /* end fmStatsCollectorTask */
+
+
+
+
 /*****************************************************************************/
 /** fmGetVLANCounters
  * \ingroup stats
@@ -60,6 +60,46 @@
  *****************************************************************************/
 
 
+/*****************************************************************************/
+/** PrintProvisioningTime
+ * \ingroup intVlan
+ *
+ * \desc            Prints the time taken by one phase of
+ *                  ''fmDbgBenchmarkVlanProvisioning''.
+ *
+ * \param[in]       desc is the name of the phase.
+ *
+ * \param[in]       start is the time at which the phase started.
+ *
+ * \param[in]       numVlans is the number of VLANs provisioned.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void PrintProvisioningTime(fm_text       desc,
+                                  fm_timestamp *start,
+                                  fm_int        numVlans)
+{
+    fm_timestamp end;
+    fm_timestamp elapsed;
+    fm_uint64    usec;
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, start, &elapsed);
+
+    usec = elapsed.sec * 1000000 + elapsed.usec;
+
+    FM_LOG_PRINT("  %-24s: %10" FM_FORMAT_64 "u usec, %8" FM_FORMAT_64
+                 "u usec/VLAN\n",
+                 desc,
+                 usec,
+                 usec / numVlans);
+
+}   /* end PrintProvisioningTime */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -910,6 +950,9 @@ ABORT:
  *                  overridden by specifying the
  *                  ''api.stp.defaultState.vlanMember'' API property.
  *
+ * \note            To provision many VLANs at once, see also
+ *                  ''fmSetVlanPortConfigList''.
+ *
  * \param[in]       sw is the switch on which to operate.
  *
  * \param[in]       vlanID is the VLAN number to which the ports should be
@@ -2415,6 +2458,155 @@ fm_status fmSetVlanPortListState(fm_int    sw,
 
 
 
+/*****************************************************************************/
+/** fmSetVlanPortConfigList
+ * \ingroup vlan
+ *
+ * \chips           FM10000
+ *
+ * \desc            Sets the membership, egress tagging and spanning tree
+ *                  state of any number of ports in any number of VLANs at
+ *                  one time. The software tables are updated for every
+ *                  entry first, and only the VLAN and spanning tree table
+ *                  rows that changed as a result are then written to the
+ *                  hardware, as one burst. This is considerably faster
+ *                  than provisioning many VLANs with ''fmAddVlanPortList''
+ *                  and ''fmSetVlanPortState''.
+ *
+ * \note            All the entries are validated before any of them is
+ *                  applied, so an invalid entry leaves the configuration
+ *                  unchanged. If applying the entries fails, the changes
+ *                  already made are rolled back. Entries are applied in
+ *                  list order; when several entries address the same port
+ *                  in the same VLAN, or the same port in VLANs sharing a
+ *                  spanning tree instance, the last one wins.
+ *
+ * \note            On FM10000, the spanning tree state of a port is shared
+ *                  by all the VLANs of its spanning tree instance, so the
+ *                  stpState member of an entry applies to the instance of
+ *                  the entry's VLAN. It may not be set when the
+ *                  ''FM_SPANNING_TREE_MODE'' switch attribute is
+ *                  ''FM_SPANNING_TREE_PER_VLAN''.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       numEntries is the number of entries in configList.
+ *
+ * \param[in]       configList points to an array of numEntries entries,
+ *                  each describing one port in one VLAN.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if configList is NULL or an
+ *                  entry's stpState is invalid.
+ * \return          FM_ERR_INVALID_VLAN if an entry's VLAN is out of range
+ *                  or does not exist.
+ * \return          FM_ERR_INVALID_PORT if an entry's port is invalid.
+ * \return          FM_ERR_INVALID_STP_MODE if a spanning tree state is set
+ *                  in a spanning tree mode that does not support it.
+ * \return          FM_ERR_PORT_IS_INTERNAL if trying to change the state of
+ *                  an internal port.
+ *
+ *****************************************************************************/
+fm_status fmSetVlanPortConfigList(fm_int              sw,
+                                  fm_int              numEntries,
+                                  fm_vlanPortConfig * configList)
+{
+    fm_switch *         switchPtr;
+    fm_vlanPortConfig * entry;
+    fm_status           err = FM_OK;
+    fm_int              i;
+    fm_flushParams      flushParams;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_VLAN,
+                     "sw=%d numEntries=%d configList=%p\n",
+                     sw, numEntries, (void *) configList);
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( numEntries < 0 || (numEntries > 0 && configList == NULL) )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+    }
+
+    /***************************************************
+     * Validate every entry before touching anything.
+     **************************************************/
+    for (i = 0 ; i < numEntries ; i++)
+    {
+        entry = &configList[i];
+
+        if ( VLAN_OUT_OF_BOUNDS(entry->vlanID) ||
+             !switchPtr->vidTable[entry->vlanID].valid ||
+             (entry->vlanID == switchPtr->reservedVlan) )
+        {
+            err = FM_ERR_INVALID_VLAN;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+
+        if ( !fmIsValidPort(sw, entry->port, ALLOW_CPU | ALLOW_LAG) )
+        {
+            err = FM_ERR_INVALID_PORT;
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+
+        switch (entry->stpState)
+        {
+            case FM_VLAN_PORT_STP_STATE_UNCHANGED:
+                break;
+
+            case FM_STP_STATE_DISABLED:
+            case FM_STP_STATE_LISTENING:
+            case FM_STP_STATE_LEARNING:
+            case FM_STP_STATE_FORWARDING:
+            case FM_STP_STATE_BLOCKING:
+                if (entry->port == switchPtr->cpuPort)
+                {
+                    err = FM_ERR_INVALID_PORT;
+                    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+                }
+                break;
+
+            default:
+                err = FM_ERR_INVALID_ARGUMENT;
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+        }
+    }
+
+    FM_API_CALL_FAMILY(err,
+                       switchPtr->SetVlanPortConfigList,
+                       sw,
+                       numEntries,
+                       configList);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+
+    if (GET_PROPERTY()->maFlushOnVlanChange)
+    {
+        for (i = 0 ; i < numEntries ; i++)
+        {
+            if (!configList[i].member)
+            {
+                flushParams.port = configList[i].port;
+                flushParams.vid1 = configList[i].vlanID;
+                err = fmFlushAddresses(sw, FM_FLUSH_MODE_PORT_VLAN, flushParams);
+                FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_VLAN, err);
+            }
+        }
+    }
+
+ABORT:
+    UNPROTECT_SWITCH(sw);
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_VLAN, err);
+
+}   /* end fmSetVlanPortConfigList */
+
+
+
+
 /*****************************************************************************/
 /** fmGetVlanPortState
  * \ingroup vlan
@@ -3488,6 +3680,294 @@ fm_status fmDbgDumpCVlanCounter(fm_int sw)
 
 
 
+/*****************************************************************************/
+/** fmDbgBenchmarkVlanProvisioning
+ * \ingroup diagMisc
+ *
+ * \chips           FM10000
+ *
+ * \desc            Measures the time taken to make every non-CPU, non-
+ *                  internal cardinal port a tagged member of a range of
+ *                  VLANs, first one port at a time with ''fmAddVlanPort'',
+ *                  then one VLAN at a time with ''fmAddVlanPortList'', and
+ *                  finally in a single ''fmSetVlanPortConfigList'' call.
+ *                  The ports are removed between passes, and the final
+ *                  membership of every VLAN is checked against the first
+ *                  pass.
+ *
+ * \note            The VLANs are created by this function and deleted when
+ *                  it returns, so none of them may exist beforehand. The
+ *                  hardware VLAN tables are modified while it runs.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       firstVlan is the first VLAN of the range.
+ *
+ * \param[in]       numVlans is the number of VLANs in the range.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_SWITCH if sw is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if the range is out of bounds
+ *                  or contains an existing VLAN.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          FM_FAIL if the passes produced different memberships.
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkVlanProvisioning(fm_int sw,
+                                         fm_int firstVlan,
+                                         fm_int numVlans)
+{
+    fm_switch *         switchPtr;
+    fm_vlanPortConfig * configList;
+    fm_int *            portList;
+    fm_int *            vlanPorts;
+    fm_int              numPorts;
+    fm_int              numVlanPorts;
+    fm_int              expectedPorts;
+    fm_int              numCreated;
+    fm_int              vlanID;
+    fm_int              i;
+    fm_int              j;
+    fm_int              n;
+    fm_timestamp        start;
+    fm_status           err;
+    fm_status           err2;
+
+    VALIDATE_AND_PROTECT_SWITCH(sw);
+
+    switchPtr  = GET_SWITCH_PTR(sw);
+    configList = NULL;
+    portList   = NULL;
+    vlanPorts  = NULL;
+    numCreated = 0;
+
+    if ( firstVlan <= 0 || numVlans <= 0 || firstVlan + numVlans > FM_MAX_VLAN )
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        if ( switchPtr->vidTable[vlanID].valid ||
+             vlanID == switchPtr->reservedVlan )
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            goto ABORT;
+        }
+    }
+
+    portList  = fmAlloc( switchPtr->numCardinalPorts * sizeof(fm_int) );
+    vlanPorts = fmAlloc( switchPtr->numCardinalPorts * sizeof(fm_int) );
+
+    if (portList == NULL || vlanPorts == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    err = fmGetCardinalPortList(sw,
+                                &n,
+                                portList,
+                                switchPtr->numCardinalPorts);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    /* Keep the front-panel ports only. */
+    numPorts = 0;
+
+    for (i = 0 ; i < n ; i++)
+    {
+        if ( portList[i] != switchPtr->cpuPort &&
+             !fmIsInternalPort(sw, portList[i]) )
+        {
+            portList[numPorts++] = portList[i];
+        }
+    }
+
+    configList = fmAlloc( numVlans * numPorts * sizeof(fm_vlanPortConfig) );
+    if (configList == NULL)
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    for (i = 0 ; i < numVlans ; i++)
+    {
+        for (j = 0 ; j < numPorts ; j++)
+        {
+            n = i * numPorts + j;
+
+            configList[n].vlanID   = (fm_uint16) (firstVlan + i);
+            configList[n].port     = portList[j];
+            configList[n].member   = TRUE;
+            configList[n].tag      = TRUE;
+            configList[n].stpState = FM_VLAN_PORT_STP_STATE_UNCHANGED;
+        }
+    }
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        err = fmCreateVlan(sw, (fm_uint16) vlanID);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+
+        numCreated++;
+    }
+
+    FM_LOG_PRINT("VLAN provisioning benchmark: %d VLANs from %d, %d ports\n",
+                 numVlans,
+                 firstVlan,
+                 numPorts);
+
+    /***************************************************
+     * One port at a time.
+     **************************************************/
+    fmGetTime(&start);
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        for (j = 0 ; j < numPorts ; j++)
+        {
+            err = fmAddVlanPort(sw, (fm_uint16) vlanID, portList[j], TRUE);
+            if (err != FM_OK)
+            {
+                goto ABORT;
+            }
+        }
+    }
+
+    PrintProvisioningTime("fmAddVlanPort", &start, numVlans);
+
+    err = fmGetVlanPortList(sw,
+                            (fm_uint16) firstVlan,
+                            &expectedPorts,
+                            vlanPorts,
+                            switchPtr->numCardinalPorts);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        err = fmDeleteVlanPortList(sw, (fm_uint16) vlanID, numPorts, portList);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+    }
+
+    /***************************************************
+     * One VLAN at a time.
+     **************************************************/
+    fmGetTime(&start);
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        err = fmAddVlanPortList(sw, (fm_uint16) vlanID, numPorts, portList, TRUE);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+    }
+
+    PrintProvisioningTime("fmAddVlanPortList", &start, numVlans);
+
+    for (n = 0 ; n < numVlans * numPorts ; n++)
+    {
+        configList[n].member = FALSE;
+    }
+
+    fmGetTime(&start);
+
+    err = fmSetVlanPortConfigList(sw, numVlans * numPorts, configList);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    PrintProvisioningTime("fmSetVlanPortConfigList -", &start, numVlans);
+
+    /***************************************************
+     * All VLANs at once.
+     **************************************************/
+    for (n = 0 ; n < numVlans * numPorts ; n++)
+    {
+        configList[n].member = TRUE;
+    }
+
+    fmGetTime(&start);
+
+    err = fmSetVlanPortConfigList(sw, numVlans * numPorts, configList);
+    if (err != FM_OK)
+    {
+        goto ABORT;
+    }
+
+    PrintProvisioningTime("fmSetVlanPortConfigList +", &start, numVlans);
+
+    for (vlanID = firstVlan ; vlanID < firstVlan + numVlans ; vlanID++)
+    {
+        err = fmGetVlanPortList(sw,
+                                (fm_uint16) vlanID,
+                                &numVlanPorts,
+                                vlanPorts,
+                                switchPtr->numCardinalPorts);
+        if (err != FM_OK)
+        {
+            goto ABORT;
+        }
+
+        if (numVlanPorts != expectedPorts)
+        {
+            FM_LOG_PRINT("  VLAN %d has %d ports, expected %d\n",
+                         vlanID,
+                         numVlanPorts,
+                         expectedPorts);
+            err = FM_FAIL;
+            goto ABORT;
+        }
+    }
+
+ABORT:
+    for (vlanID = firstVlan ; vlanID < firstVlan + numCreated ; vlanID++)
+    {
+        err2 = fmDeleteVlan(sw, (fm_uint16) vlanID);
+        if (err == FM_OK)
+        {
+            err = err2;
+        }
+    }
+
+    if (configList != NULL)
+    {
+        fmFree(configList);
+    }
+
+    if (vlanPorts != NULL)
+    {
+        fmFree(vlanPorts);
+    }
+
+    if (portList != NULL)
+    {
+        fmFree(portList);
+    }
+
+    UNPROTECT_SWITCH(sw);
+
+    return err;
+
+}   /* end fmDbgBenchmarkVlanProvisioning */
+
+
+
+
 /*****************************************************************************/
 /** fmAddInternalPortsToVlan
  * \ingroup intVlan
@@ -33,10 +33,43 @@
 
 #include <fm_sdk_int.h>
 
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(FM_CRC32_NO_HW)
+#define FM_CRC32_HW_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 /*****************************************************************************
  * Macros, Constants & Types
  *****************************************************************************/
 
+/* Number of lookup tables used by the slicing-by-8 algorithm. */
+#define FM_CRC32_SLICES             8
+
+/* Minimum length handed to the PCLMULQDQ folding routine. */
+#define FM_CRC32_FOLD_MIN_LEN       64
+
+/* Frame sizes exercised by fmDbgBenchmarkCrc32. */
+#define FM_CRC32_BENCH_MAX_LEN      9216
+
+/* Assembles 4 bytes into a little-endian 32-bit word. */
+#define FM_CRC32_LOAD_LE32(p)                                                 \
+    ( (fm_uint32) (p)[0]         | ( (fm_uint32) (p)[1] << 8 ) |             \
+      ( (fm_uint32) (p)[2] << 16 ) | ( (fm_uint32) (p)[3] << 24 ) )
+
+typedef enum
+{
+    /* Engine selection has not been done yet. */
+    FM_CRC32_ENGINE_UNKNOWN = 0,
+
+    /* Portable slicing-by-8 table lookup. */
+    FM_CRC32_ENGINE_SLICE8,
+
+    /* Carry-less multiply folding (CRC-32) or SSE4.2 crc32 (CRC-32C). */
+    FM_CRC32_ENGINE_HW,
+
+} fm_crc32Engine;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -45,8 +78,12 @@
  * Local Variables
  *****************************************************************************/
 
-/* CRC-32 least significant bit (LSB) first table.
- * The table has been generated using the following algorithm:
+/* Engines selected for CRC-32 and CRC-32C, set on first use. */
+static volatile fm_crc32Engine crc32Engine  = FM_CRC32_ENGINE_UNKNOWN;
+static volatile fm_crc32Engine crc32CEngine = FM_CRC32_ENGINE_UNKNOWN;
+
+/* CRC-32 least significant bit (LSB) first slicing-by-8 tables.
+ * The tables have been generated using the following algorithm:
  *
  * fm_uint32 crc;
  * fm_uint32 poly = 0xedb88320U;
@@ -59,136 +96,894 @@
  *     {
  *         crc = (crc >> 1) ^ (poly & (-(crc & 1)));
  *     }
- *     fmCrc32CTable[i] = crc;
+ *     fmCrc32Table[0][i] = crc;
  * }
- */
-static const fm_uint32 fmCrc32Table[] =
-{
-    0x00000000U, 0x77073096U, 0xee0e612cU, 0x990951baU, 0x076dc419U,
-    0x706af48fU, 0xe963a535U, 0x9e6495a3U, 0x0edb8832U, 0x79dcb8a4U,
-    0xe0d5e91eU, 0x97d2d988U, 0x09b64c2bU, 0x7eb17cbdU, 0xe7b82d07U,
-    0x90bf1d91U, 0x1db71064U, 0x6ab020f2U, 0xf3b97148U, 0x84be41deU,
-    0x1adad47dU, 0x6ddde4ebU, 0xf4d4b551U, 0x83d385c7U, 0x136c9856U,
-    0x646ba8c0U, 0xfd62f97aU, 0x8a65c9ecU, 0x14015c4fU, 0x63066cd9U,
-    0xfa0f3d63U, 0x8d080df5U, 0x3b6e20c8U, 0x4c69105eU, 0xd56041e4U,
-    0xa2677172U, 0x3c03e4d1U, 0x4b04d447U, 0xd20d85fdU, 0xa50ab56bU,
-    0x35b5a8faU, 0x42b2986cU, 0xdbbbc9d6U, 0xacbcf940U, 0x32d86ce3U,
-    0x45df5c75U, 0xdcd60dcfU, 0xabd13d59U, 0x26d930acU, 0x51de003aU,
-    0xc8d75180U, 0xbfd06116U, 0x21b4f4b5U, 0x56b3c423U, 0xcfba9599U,
-    0xb8bda50fU, 0x2802b89eU, 0x5f058808U, 0xc60cd9b2U, 0xb10be924U,
-    0x2f6f7c87U, 0x58684c11U, 0xc1611dabU, 0xb6662d3dU, 0x76dc4190U,
-    0x01db7106U, 0x98d220bcU, 0xefd5102aU, 0x71b18589U, 0x06b6b51fU,
-    0x9fbfe4a5U, 0xe8b8d433U, 0x7807c9a2U, 0x0f00f934U, 0x9609a88eU,
-    0xe10e9818U, 0x7f6a0dbbU, 0x086d3d2dU, 0x91646c97U, 0xe6635c01U,
-    0x6b6b51f4U, 0x1c6c6162U, 0x856530d8U, 0xf262004eU, 0x6c0695edU,
-    0x1b01a57bU, 0x8208f4c1U, 0xf50fc457U, 0x65b0d9c6U, 0x12b7e950U,
-    0x8bbeb8eaU, 0xfcb9887cU, 0x62dd1ddfU, 0x15da2d49U, 0x8cd37cf3U,
-    0xfbd44c65U, 0x4db26158U, 0x3ab551ceU, 0xa3bc0074U, 0xd4bb30e2U,
-    0x4adfa541U, 0x3dd895d7U, 0xa4d1c46dU, 0xd3d6f4fbU, 0x4369e96aU,
-    0x346ed9fcU, 0xad678846U, 0xda60b8d0U, 0x44042d73U, 0x33031de5U,
-    0xaa0a4c5fU, 0xdd0d7cc9U, 0x5005713cU, 0x270241aaU, 0xbe0b1010U,
-    0xc90c2086U, 0x5768b525U, 0x206f85b3U, 0xb966d409U, 0xce61e49fU,
-    0x5edef90eU, 0x29d9c998U, 0xb0d09822U, 0xc7d7a8b4U, 0x59b33d17U,
-    0x2eb40d81U, 0xb7bd5c3bU, 0xc0ba6cadU, 0xedb88320U, 0x9abfb3b6U,
-    0x03b6e20cU, 0x74b1d29aU, 0xead54739U, 0x9dd277afU, 0x04db2615U,
-    0x73dc1683U, 0xe3630b12U, 0x94643b84U, 0x0d6d6a3eU, 0x7a6a5aa8U,
-    0xe40ecf0bU, 0x9309ff9dU, 0x0a00ae27U, 0x7d079eb1U, 0xf00f9344U,
-    0x8708a3d2U, 0x1e01f268U, 0x6906c2feU, 0xf762575dU, 0x806567cbU,
-    0x196c3671U, 0x6e6b06e7U, 0xfed41b76U, 0x89d32be0U, 0x10da7a5aU,
-    0x67dd4accU, 0xf9b9df6fU, 0x8ebeeff9U, 0x17b7be43U, 0x60b08ed5U,
-    0xd6d6a3e8U, 0xa1d1937eU, 0x38d8c2c4U, 0x4fdff252U, 0xd1bb67f1U,
-    0xa6bc5767U, 0x3fb506ddU, 0x48b2364bU, 0xd80d2bdaU, 0xaf0a1b4cU,
-    0x36034af6U, 0x41047a60U, 0xdf60efc3U, 0xa867df55U, 0x316e8eefU,
-    0x4669be79U, 0xcb61b38cU, 0xbc66831aU, 0x256fd2a0U, 0x5268e236U,
-    0xcc0c7795U, 0xbb0b4703U, 0x220216b9U, 0x5505262fU, 0xc5ba3bbeU,
-    0xb2bd0b28U, 0x2bb45a92U, 0x5cb36a04U, 0xc2d7ffa7U, 0xb5d0cf31U,
-    0x2cd99e8bU, 0x5bdeae1dU, 0x9b64c2b0U, 0xec63f226U, 0x756aa39cU,
-    0x026d930aU, 0x9c0906a9U, 0xeb0e363fU, 0x72076785U, 0x05005713U,
-    0x95bf4a82U, 0xe2b87a14U, 0x7bb12baeU, 0x0cb61b38U, 0x92d28e9bU,
-    0xe5d5be0dU, 0x7cdcefb7U, 0x0bdbdf21U, 0x86d3d2d4U, 0xf1d4e242U,
-    0x68ddb3f8U, 0x1fda836eU, 0x81be16cdU, 0xf6b9265bU, 0x6fb077e1U,
-    0x18b74777U, 0x88085ae6U, 0xff0f6a70U, 0x66063bcaU, 0x11010b5cU,
-    0x8f659effU, 0xf862ae69U, 0x616bffd3U, 0x166ccf45U, 0xa00ae278U,
-    0xd70dd2eeU, 0x4e048354U, 0x3903b3c2U, 0xa7672661U, 0xd06016f7U,
-    0x4969474dU, 0x3e6e77dbU, 0xaed16a4aU, 0xd9d65adcU, 0x40df0b66U,
-    0x37d83bf0U, 0xa9bcae53U, 0xdebb9ec5U, 0x47b2cf7fU, 0x30b5ffe9U,
-    0xbdbdf21cU, 0xcabac28aU, 0x53b39330U, 0x24b4a3a6U, 0xbad03605U,
-    0xcdd70693U, 0x54de5729U, 0x23d967bfU, 0xb3667a2eU, 0xc4614ab8U,
-    0x5d681b02U, 0x2a6f2b94U, 0xb40bbe37U, 0xc30c8ea1U, 0x5a05df1bU,
-    0x2d02ef8dU
-};
-
-/* CRC-32C least significant bit (LSB) first table.
- * The table has been generated using the following algorithm:
- *
- * fm_uint32 crc;
- * fm_uint32 poly = 0x82f63b78U;
- * fm_int    i, j;
  *
- * for (i = 0 ; i < 256 ; i++)
+ * for (j = 1 ; j < FM_CRC32_SLICES ; j++)
  * {
- *     crc = i;
- *     for (j = 0; j < 8; j++)
+ *     for (i = 0 ; i < 256 ; i++)
  *     {
- *         crc = (crc >> 1) ^ (poly & (-(crc & 1)));
+ *         crc = fmCrc32Table[j - 1][i];
+ *         fmCrc32Table[j][i] = (crc >> 8) ^ fmCrc32Table[0][crc & 0xff];
  *     }
- *     fmCrc32CTable[i] = crc;
  * }
+ *
+ * Table j gives the CRC contribution of a byte followed by j zero bytes.
+ */
+static const fm_uint32 fmCrc32Table[FM_CRC32_SLICES][256] =
+{
+    {
+        0x00000000U, 0x77073096U, 0xee0e612cU, 0x990951baU, 0x076dc419U,
+        0x706af48fU, 0xe963a535U, 0x9e6495a3U, 0x0edb8832U, 0x79dcb8a4U,
+        0xe0d5e91eU, 0x97d2d988U, 0x09b64c2bU, 0x7eb17cbdU, 0xe7b82d07U,
+        0x90bf1d91U, 0x1db71064U, 0x6ab020f2U, 0xf3b97148U, 0x84be41deU,
+        0x1adad47dU, 0x6ddde4ebU, 0xf4d4b551U, 0x83d385c7U, 0x136c9856U,
+        0x646ba8c0U, 0xfd62f97aU, 0x8a65c9ecU, 0x14015c4fU, 0x63066cd9U,
+        0xfa0f3d63U, 0x8d080df5U, 0x3b6e20c8U, 0x4c69105eU, 0xd56041e4U,
+        0xa2677172U, 0x3c03e4d1U, 0x4b04d447U, 0xd20d85fdU, 0xa50ab56bU,
+        0x35b5a8faU, 0x42b2986cU, 0xdbbbc9d6U, 0xacbcf940U, 0x32d86ce3U,
+        0x45df5c75U, 0xdcd60dcfU, 0xabd13d59U, 0x26d930acU, 0x51de003aU,
+        0xc8d75180U, 0xbfd06116U, 0x21b4f4b5U, 0x56b3c423U, 0xcfba9599U,
+        0xb8bda50fU, 0x2802b89eU, 0x5f058808U, 0xc60cd9b2U, 0xb10be924U,
+        0x2f6f7c87U, 0x58684c11U, 0xc1611dabU, 0xb6662d3dU, 0x76dc4190U,
+        0x01db7106U, 0x98d220bcU, 0xefd5102aU, 0x71b18589U, 0x06b6b51fU,
+        0x9fbfe4a5U, 0xe8b8d433U, 0x7807c9a2U, 0x0f00f934U, 0x9609a88eU,
+        0xe10e9818U, 0x7f6a0dbbU, 0x086d3d2dU, 0x91646c97U, 0xe6635c01U,
+        0x6b6b51f4U, 0x1c6c6162U, 0x856530d8U, 0xf262004eU, 0x6c0695edU,
+        0x1b01a57bU, 0x8208f4c1U, 0xf50fc457U, 0x65b0d9c6U, 0x12b7e950U,
+        0x8bbeb8eaU, 0xfcb9887cU, 0x62dd1ddfU, 0x15da2d49U, 0x8cd37cf3U,
+        0xfbd44c65U, 0x4db26158U, 0x3ab551ceU, 0xa3bc0074U, 0xd4bb30e2U,
+        0x4adfa541U, 0x3dd895d7U, 0xa4d1c46dU, 0xd3d6f4fbU, 0x4369e96aU,
+        0x346ed9fcU, 0xad678846U, 0xda60b8d0U, 0x44042d73U, 0x33031de5U,
+        0xaa0a4c5fU, 0xdd0d7cc9U, 0x5005713cU, 0x270241aaU, 0xbe0b1010U,
+        0xc90c2086U, 0x5768b525U, 0x206f85b3U, 0xb966d409U, 0xce61e49fU,
+        0x5edef90eU, 0x29d9c998U, 0xb0d09822U, 0xc7d7a8b4U, 0x59b33d17U,
+        0x2eb40d81U, 0xb7bd5c3bU, 0xc0ba6cadU, 0xedb88320U, 0x9abfb3b6U,
+        0x03b6e20cU, 0x74b1d29aU, 0xead54739U, 0x9dd277afU, 0x04db2615U,
+        0x73dc1683U, 0xe3630b12U, 0x94643b84U, 0x0d6d6a3eU, 0x7a6a5aa8U,
+        0xe40ecf0bU, 0x9309ff9dU, 0x0a00ae27U, 0x7d079eb1U, 0xf00f9344U,
+        0x8708a3d2U, 0x1e01f268U, 0x6906c2feU, 0xf762575dU, 0x806567cbU,
+        0x196c3671U, 0x6e6b06e7U, 0xfed41b76U, 0x89d32be0U, 0x10da7a5aU,
+        0x67dd4accU, 0xf9b9df6fU, 0x8ebeeff9U, 0x17b7be43U, 0x60b08ed5U,
+        0xd6d6a3e8U, 0xa1d1937eU, 0x38d8c2c4U, 0x4fdff252U, 0xd1bb67f1U,
+        0xa6bc5767U, 0x3fb506ddU, 0x48b2364bU, 0xd80d2bdaU, 0xaf0a1b4cU,
+        0x36034af6U, 0x41047a60U, 0xdf60efc3U, 0xa867df55U, 0x316e8eefU,
+        0x4669be79U, 0xcb61b38cU, 0xbc66831aU, 0x256fd2a0U, 0x5268e236U,
+        0xcc0c7795U, 0xbb0b4703U, 0x220216b9U, 0x5505262fU, 0xc5ba3bbeU,
+        0xb2bd0b28U, 0x2bb45a92U, 0x5cb36a04U, 0xc2d7ffa7U, 0xb5d0cf31U,
+        0x2cd99e8bU, 0x5bdeae1dU, 0x9b64c2b0U, 0xec63f226U, 0x756aa39cU,
+        0x026d930aU, 0x9c0906a9U, 0xeb0e363fU, 0x72076785U, 0x05005713U,
+        0x95bf4a82U, 0xe2b87a14U, 0x7bb12baeU, 0x0cb61b38U, 0x92d28e9bU,
+        0xe5d5be0dU, 0x7cdcefb7U, 0x0bdbdf21U, 0x86d3d2d4U, 0xf1d4e242U,
+        0x68ddb3f8U, 0x1fda836eU, 0x81be16cdU, 0xf6b9265bU, 0x6fb077e1U,
+        0x18b74777U, 0x88085ae6U, 0xff0f6a70U, 0x66063bcaU, 0x11010b5cU,
+        0x8f659effU, 0xf862ae69U, 0x616bffd3U, 0x166ccf45U, 0xa00ae278U,
+        0xd70dd2eeU, 0x4e048354U, 0x3903b3c2U, 0xa7672661U, 0xd06016f7U,
+        0x4969474dU, 0x3e6e77dbU, 0xaed16a4aU, 0xd9d65adcU, 0x40df0b66U,
+        0x37d83bf0U, 0xa9bcae53U, 0xdebb9ec5U, 0x47b2cf7fU, 0x30b5ffe9U,
+        0xbdbdf21cU, 0xcabac28aU, 0x53b39330U, 0x24b4a3a6U, 0xbad03605U,
+        0xcdd70693U, 0x54de5729U, 0x23d967bfU, 0xb3667a2eU, 0xc4614ab8U,
+        0x5d681b02U, 0x2a6f2b94U, 0xb40bbe37U, 0xc30c8ea1U, 0x5a05df1bU,
+        0x2d02ef8dU
+    },
+    {
+        0x00000000U, 0x191b3141U, 0x32366282U, 0x2b2d53c3U, 0x646cc504U,
+        0x7d77f445U, 0x565aa786U, 0x4f4196c7U, 0xc8d98a08U, 0xd1c2bb49U,
+        0xfaefe88aU, 0xe3f4d9cbU, 0xacb54f0cU, 0xb5ae7e4dU, 0x9e832d8eU,
+        0x87981ccfU, 0x4ac21251U, 0x53d92310U, 0x78f470d3U, 0x61ef4192U,
+        0x2eaed755U, 0x37b5e614U, 0x1c98b5d7U, 0x05838496U, 0x821b9859U,
+        0x9b00a918U, 0xb02dfadbU, 0xa936cb9aU, 0xe6775d5dU, 0xff6c6c1cU,
+        0xd4413fdfU, 0xcd5a0e9eU, 0x958424a2U, 0x8c9f15e3U, 0xa7b24620U,
+        0xbea97761U, 0xf1e8e1a6U, 0xe8f3d0e7U, 0xc3de8324U, 0xdac5b265U,
+        0x5d5daeaaU, 0x44469febU, 0x6f6bcc28U, 0x7670fd69U, 0x39316baeU,
+        0x202a5aefU, 0x0b07092cU, 0x121c386dU, 0xdf4636f3U, 0xc65d07b2U,
+        0xed705471U, 0xf46b6530U, 0xbb2af3f7U, 0xa231c2b6U, 0x891c9175U,
+        0x9007a034U, 0x179fbcfbU, 0x0e848dbaU, 0x25a9de79U, 0x3cb2ef38U,
+        0x73f379ffU, 0x6ae848beU, 0x41c51b7dU, 0x58de2a3cU, 0xf0794f05U,
+        0xe9627e44U, 0xc24f2d87U, 0xdb541cc6U, 0x94158a01U, 0x8d0ebb40U,
+        0xa623e883U, 0xbf38d9c2U, 0x38a0c50dU, 0x21bbf44cU, 0x0a96a78fU,
+        0x138d96ceU, 0x5ccc0009U, 0x45d73148U, 0x6efa628bU, 0x77e153caU,
+        0xbabb5d54U, 0xa3a06c15U, 0x888d3fd6U, 0x91960e97U, 0xded79850U,
+        0xc7cca911U, 0xece1fad2U, 0xf5facb93U, 0x7262d75cU, 0x6b79e61dU,
+        0x4054b5deU, 0x594f849fU, 0x160e1258U, 0x0f152319U, 0x243870daU,
+        0x3d23419bU, 0x65fd6ba7U, 0x7ce65ae6U, 0x57cb0925U, 0x4ed03864U,
+        0x0191aea3U, 0x188a9fe2U, 0x33a7cc21U, 0x2abcfd60U, 0xad24e1afU,
+        0xb43fd0eeU, 0x9f12832dU, 0x8609b26cU, 0xc94824abU, 0xd05315eaU,
+        0xfb7e4629U, 0xe2657768U, 0x2f3f79f6U, 0x362448b7U, 0x1d091b74U,
+        0x04122a35U, 0x4b53bcf2U, 0x52488db3U, 0x7965de70U, 0x607eef31U,
+        0xe7e6f3feU, 0xfefdc2bfU, 0xd5d0917cU, 0xcccba03dU, 0x838a36faU,
+        0x9a9107bbU, 0xb1bc5478U, 0xa8a76539U, 0x3b83984bU, 0x2298a90aU,
+        0x09b5fac9U, 0x10aecb88U, 0x5fef5d4fU, 0x46f46c0eU, 0x6dd93fcdU,
+        0x74c20e8cU, 0xf35a1243U, 0xea412302U, 0xc16c70c1U, 0xd8774180U,
+        0x9736d747U, 0x8e2de606U, 0xa500b5c5U, 0xbc1b8484U, 0x71418a1aU,
+        0x685abb5bU, 0x4377e898U, 0x5a6cd9d9U, 0x152d4f1eU, 0x0c367e5fU,
+        0x271b2d9cU, 0x3e001cddU, 0xb9980012U, 0xa0833153U, 0x8bae6290U,
+        0x92b553d1U, 0xddf4c516U, 0xc4eff457U, 0xefc2a794U, 0xf6d996d5U,
+        0xae07bce9U, 0xb71c8da8U, 0x9c31de6bU, 0x852aef2aU, 0xca6b79edU,
+        0xd37048acU, 0xf85d1b6fU, 0xe1462a2eU, 0x66de36e1U, 0x7fc507a0U,
+        0x54e85463U, 0x4df36522U, 0x02b2f3e5U, 0x1ba9c2a4U, 0x30849167U,
+        0x299fa026U, 0xe4c5aeb8U, 0xfdde9ff9U, 0xd6f3cc3aU, 0xcfe8fd7bU,
+        0x80a96bbcU, 0x99b25afdU, 0xb29f093eU, 0xab84387fU, 0x2c1c24b0U,
+        0x350715f1U, 0x1e2a4632U, 0x07317773U, 0x4870e1b4U, 0x516bd0f5U,
+        0x7a468336U, 0x635db277U, 0xcbfad74eU, 0xd2e1e60fU, 0xf9ccb5ccU,
+        0xe0d7848dU, 0xaf96124aU, 0xb68d230bU, 0x9da070c8U, 0x84bb4189U,
+        0x03235d46U, 0x1a386c07U, 0x31153fc4U, 0x280e0e85U, 0x674f9842U,
+        0x7e54a903U, 0x5579fac0U, 0x4c62cb81U, 0x8138c51fU, 0x9823f45eU,
+        0xb30ea79dU, 0xaa1596dcU, 0xe554001bU, 0xfc4f315aU, 0xd7626299U,
+        0xce7953d8U, 0x49e14f17U, 0x50fa7e56U, 0x7bd72d95U, 0x62cc1cd4U,
+        0x2d8d8a13U, 0x3496bb52U, 0x1fbbe891U, 0x06a0d9d0U, 0x5e7ef3ecU,
+        0x4765c2adU, 0x6c48916eU, 0x7553a02fU, 0x3a1236e8U, 0x230907a9U,
+        0x0824546aU, 0x113f652bU, 0x96a779e4U, 0x8fbc48a5U, 0xa4911b66U,
+        0xbd8a2a27U, 0xf2cbbce0U, 0xebd08da1U, 0xc0fdde62U, 0xd9e6ef23U,
+        0x14bce1bdU, 0x0da7d0fcU, 0x268a833fU, 0x3f91b27eU, 0x70d024b9U,
+        0x69cb15f8U, 0x42e6463bU, 0x5bfd777aU, 0xdc656bb5U, 0xc57e5af4U,
+        0xee530937U, 0xf7483876U, 0xb809aeb1U, 0xa1129ff0U, 0x8a3fcc33U,
+        0x9324fd72U
+    },
+    {
+        0x00000000U, 0x01c26a37U, 0x0384d46eU, 0x0246be59U, 0x0709a8dcU,
+        0x06cbc2ebU, 0x048d7cb2U, 0x054f1685U, 0x0e1351b8U, 0x0fd13b8fU,
+        0x0d9785d6U, 0x0c55efe1U, 0x091af964U, 0x08d89353U, 0x0a9e2d0aU,
+        0x0b5c473dU, 0x1c26a370U, 0x1de4c947U, 0x1fa2771eU, 0x1e601d29U,
+        0x1b2f0bacU, 0x1aed619bU, 0x18abdfc2U, 0x1969b5f5U, 0x1235f2c8U,
+        0x13f798ffU, 0x11b126a6U, 0x10734c91U, 0x153c5a14U, 0x14fe3023U,
+        0x16b88e7aU, 0x177ae44dU, 0x384d46e0U, 0x398f2cd7U, 0x3bc9928eU,
+        0x3a0bf8b9U, 0x3f44ee3cU, 0x3e86840bU, 0x3cc03a52U, 0x3d025065U,
+        0x365e1758U, 0x379c7d6fU, 0x35dac336U, 0x3418a901U, 0x3157bf84U,
+        0x3095d5b3U, 0x32d36beaU, 0x331101ddU, 0x246be590U, 0x25a98fa7U,
+        0x27ef31feU, 0x262d5bc9U, 0x23624d4cU, 0x22a0277bU, 0x20e69922U,
+        0x2124f315U, 0x2a78b428U, 0x2bbade1fU, 0x29fc6046U, 0x283e0a71U,
+        0x2d711cf4U, 0x2cb376c3U, 0x2ef5c89aU, 0x2f37a2adU, 0x709a8dc0U,
+        0x7158e7f7U, 0x731e59aeU, 0x72dc3399U, 0x7793251cU, 0x76514f2bU,
+        0x7417f172U, 0x75d59b45U, 0x7e89dc78U, 0x7f4bb64fU, 0x7d0d0816U,
+        0x7ccf6221U, 0x798074a4U, 0x78421e93U, 0x7a04a0caU, 0x7bc6cafdU,
+        0x6cbc2eb0U, 0x6d7e4487U, 0x6f38fadeU, 0x6efa90e9U, 0x6bb5866cU,
+        0x6a77ec5bU, 0x68315202U, 0x69f33835U, 0x62af7f08U, 0x636d153fU,
+        0x612bab66U, 0x60e9c151U, 0x65a6d7d4U, 0x6464bde3U, 0x662203baU,
+        0x67e0698dU, 0x48d7cb20U, 0x4915a117U, 0x4b531f4eU, 0x4a917579U,
+        0x4fde63fcU, 0x4e1c09cbU, 0x4c5ab792U, 0x4d98dda5U, 0x46c49a98U,
+        0x4706f0afU, 0x45404ef6U, 0x448224c1U, 0x41cd3244U, 0x400f5873U,
+        0x4249e62aU, 0x438b8c1dU, 0x54f16850U, 0x55330267U, 0x5775bc3eU,
+        0x56b7d609U, 0x53f8c08cU, 0x523aaabbU, 0x507c14e2U, 0x51be7ed5U,
+        0x5ae239e8U, 0x5b2053dfU, 0x5966ed86U, 0x58a487b1U, 0x5deb9134U,
+        0x5c29fb03U, 0x5e6f455aU, 0x5fad2f6dU, 0xe1351b80U, 0xe0f771b7U,
+        0xe2b1cfeeU, 0xe373a5d9U, 0xe63cb35cU, 0xe7fed96bU, 0xe5b86732U,
+        0xe47a0d05U, 0xef264a38U, 0xeee4200fU, 0xeca29e56U, 0xed60f461U,
+        0xe82fe2e4U, 0xe9ed88d3U, 0xebab368aU, 0xea695cbdU, 0xfd13b8f0U,
+        0xfcd1d2c7U, 0xfe976c9eU, 0xff5506a9U, 0xfa1a102cU, 0xfbd87a1bU,
+        0xf99ec442U, 0xf85cae75U, 0xf300e948U, 0xf2c2837fU, 0xf0843d26U,
+        0xf1465711U, 0xf4094194U, 0xf5cb2ba3U, 0xf78d95faU, 0xf64fffcdU,
+        0xd9785d60U, 0xd8ba3757U, 0xdafc890eU, 0xdb3ee339U, 0xde71f5bcU,
+        0xdfb39f8bU, 0xddf521d2U, 0xdc374be5U, 0xd76b0cd8U, 0xd6a966efU,
+        0xd4efd8b6U, 0xd52db281U, 0xd062a404U, 0xd1a0ce33U, 0xd3e6706aU,
+        0xd2241a5dU, 0xc55efe10U, 0xc49c9427U, 0xc6da2a7eU, 0xc7184049U,
+        0xc25756ccU, 0xc3953cfbU, 0xc1d382a2U, 0xc011e895U, 0xcb4dafa8U,
+        0xca8fc59fU, 0xc8c97bc6U, 0xc90b11f1U, 0xcc440774U, 0xcd866d43U,
+        0xcfc0d31aU, 0xce02b92dU, 0x91af9640U, 0x906dfc77U, 0x922b422eU,
+        0x93e92819U, 0x96a63e9cU, 0x976454abU, 0x9522eaf2U, 0x94e080c5U,
+        0x9fbcc7f8U, 0x9e7eadcfU, 0x9c381396U, 0x9dfa79a1U, 0x98b56f24U,
+        0x99770513U, 0x9b31bb4aU, 0x9af3d17dU, 0x8d893530U, 0x8c4b5f07U,
+        0x8e0de15eU, 0x8fcf8b69U, 0x8a809decU, 0x8b42f7dbU, 0x89044982U,
+        0x88c623b5U, 0x839a6488U, 0x82580ebfU, 0x801eb0e6U, 0x81dcdad1U,
+        0x8493cc54U, 0x8551a663U, 0x8717183aU, 0x86d5720dU, 0xa9e2d0a0U,
+        0xa820ba97U, 0xaa6604ceU, 0xaba46ef9U, 0xaeeb787cU, 0xaf29124bU,
+        0xad6fac12U, 0xacadc625U, 0xa7f18118U, 0xa633eb2fU, 0xa4755576U,
+        0xa5b73f41U, 0xa0f829c4U, 0xa13a43f3U, 0xa37cfdaaU, 0xa2be979dU,
+        0xb5c473d0U, 0xb40619e7U, 0xb640a7beU, 0xb782cd89U, 0xb2cddb0cU,
+        0xb30fb13bU, 0xb1490f62U, 0xb08b6555U, 0xbbd72268U, 0xba15485fU,
+        0xb853f606U, 0xb9919c31U, 0xbcde8ab4U, 0xbd1ce083U, 0xbf5a5edaU,
+        0xbe9834edU
+    },
+    {
+        0x00000000U, 0xb8bc6765U, 0xaa09c88bU, 0x12b5afeeU, 0x8f629757U,
+        0x37def032U, 0x256b5fdcU, 0x9dd738b9U, 0xc5b428efU, 0x7d084f8aU,
+        0x6fbde064U, 0xd7018701U, 0x4ad6bfb8U, 0xf26ad8ddU, 0xe0df7733U,
+        0x58631056U, 0x5019579fU, 0xe8a530faU, 0xfa109f14U, 0x42acf871U,
+        0xdf7bc0c8U, 0x67c7a7adU, 0x75720843U, 0xcdce6f26U, 0x95ad7f70U,
+        0x2d111815U, 0x3fa4b7fbU, 0x8718d09eU, 0x1acfe827U, 0xa2738f42U,
+        0xb0c620acU, 0x087a47c9U, 0xa032af3eU, 0x188ec85bU, 0x0a3b67b5U,
+        0xb28700d0U, 0x2f503869U, 0x97ec5f0cU, 0x8559f0e2U, 0x3de59787U,
+        0x658687d1U, 0xdd3ae0b4U, 0xcf8f4f5aU, 0x7733283fU, 0xeae41086U,
+        0x525877e3U, 0x40edd80dU, 0xf851bf68U, 0xf02bf8a1U, 0x48979fc4U,
+        0x5a22302aU, 0xe29e574fU, 0x7f496ff6U, 0xc7f50893U, 0xd540a77dU,
+        0x6dfcc018U, 0x359fd04eU, 0x8d23b72bU, 0x9f9618c5U, 0x272a7fa0U,
+        0xbafd4719U, 0x0241207cU, 0x10f48f92U, 0xa848e8f7U, 0x9b14583dU,
+        0x23a83f58U, 0x311d90b6U, 0x89a1f7d3U, 0x1476cf6aU, 0xaccaa80fU,
+        0xbe7f07e1U, 0x06c36084U, 0x5ea070d2U, 0xe61c17b7U, 0xf4a9b859U,
+        0x4c15df3cU, 0xd1c2e785U, 0x697e80e0U, 0x7bcb2f0eU, 0xc377486bU,
+        0xcb0d0fa2U, 0x73b168c7U, 0x6104c729U, 0xd9b8a04cU, 0x446f98f5U,
+        0xfcd3ff90U, 0xee66507eU, 0x56da371bU, 0x0eb9274dU, 0xb6054028U,
+        0xa4b0efc6U, 0x1c0c88a3U, 0x81dbb01aU, 0x3967d77fU, 0x2bd27891U,
+        0x936e1ff4U, 0x3b26f703U, 0x839a9066U, 0x912f3f88U, 0x299358edU,
+        0xb4446054U, 0x0cf80731U, 0x1e4da8dfU, 0xa6f1cfbaU, 0xfe92dfecU,
+        0x462eb889U, 0x549b1767U, 0xec277002U, 0x71f048bbU, 0xc94c2fdeU,
+        0xdbf98030U, 0x6345e755U, 0x6b3fa09cU, 0xd383c7f9U, 0xc1366817U,
+        0x798a0f72U, 0xe45d37cbU, 0x5ce150aeU, 0x4e54ff40U, 0xf6e89825U,
+        0xae8b8873U, 0x1637ef16U, 0x048240f8U, 0xbc3e279dU, 0x21e91f24U,
+        0x99557841U, 0x8be0d7afU, 0x335cb0caU, 0xed59b63bU, 0x55e5d15eU,
+        0x47507eb0U, 0xffec19d5U, 0x623b216cU, 0xda874609U, 0xc832e9e7U,
+        0x708e8e82U, 0x28ed9ed4U, 0x9051f9b1U, 0x82e4565fU, 0x3a58313aU,
+        0xa78f0983U, 0x1f336ee6U, 0x0d86c108U, 0xb53aa66dU, 0xbd40e1a4U,
+        0x05fc86c1U, 0x1749292fU, 0xaff54e4aU, 0x322276f3U, 0x8a9e1196U,
+        0x982bbe78U, 0x2097d91dU, 0x78f4c94bU, 0xc048ae2eU, 0xd2fd01c0U,
+        0x6a4166a5U, 0xf7965e1cU, 0x4f2a3979U, 0x5d9f9697U, 0xe523f1f2U,
+        0x4d6b1905U, 0xf5d77e60U, 0xe762d18eU, 0x5fdeb6ebU, 0xc2098e52U,
+        0x7ab5e937U, 0x680046d9U, 0xd0bc21bcU, 0x88df31eaU, 0x3063568fU,
+        0x22d6f961U, 0x9a6a9e04U, 0x07bda6bdU, 0xbf01c1d8U, 0xadb46e36U,
+        0x15080953U, 0x1d724e9aU, 0xa5ce29ffU, 0xb77b8611U, 0x0fc7e174U,
+        0x9210d9cdU, 0x2aacbea8U, 0x38191146U, 0x80a57623U, 0xd8c66675U,
+        0x607a0110U, 0x72cfaefeU, 0xca73c99bU, 0x57a4f122U, 0xef189647U,
+        0xfdad39a9U, 0x45115eccU, 0x764dee06U, 0xcef18963U, 0xdc44268dU,
+        0x64f841e8U, 0xf92f7951U, 0x41931e34U, 0x5326b1daU, 0xeb9ad6bfU,
+        0xb3f9c6e9U, 0x0b45a18cU, 0x19f00e62U, 0xa14c6907U, 0x3c9b51beU,
+        0x842736dbU, 0x96929935U, 0x2e2efe50U, 0x2654b999U, 0x9ee8defcU,
+        0x8c5d7112U, 0x34e11677U, 0xa9362eceU, 0x118a49abU, 0x033fe645U,
+        0xbb838120U, 0xe3e09176U, 0x5b5cf613U, 0x49e959fdU, 0xf1553e98U,
+        0x6c820621U, 0xd43e6144U, 0xc68bceaaU, 0x7e37a9cfU, 0xd67f4138U,
+        0x6ec3265dU, 0x7c7689b3U, 0xc4caeed6U, 0x591dd66fU, 0xe1a1b10aU,
+        0xf3141ee4U, 0x4ba87981U, 0x13cb69d7U, 0xab770eb2U, 0xb9c2a15cU,
+        0x017ec639U, 0x9ca9fe80U, 0x241599e5U, 0x36a0360bU, 0x8e1c516eU,
+        0x866616a7U, 0x3eda71c2U, 0x2c6fde2cU, 0x94d3b949U, 0x090481f0U,
+        0xb1b8e695U, 0xa30d497bU, 0x1bb12e1eU, 0x43d23e48U, 0xfb6e592dU,
+        0xe9dbf6c3U, 0x516791a6U, 0xccb0a91fU, 0x740cce7aU, 0x66b96194U,
+        0xde0506f1U
+    },
+    {
+        0x00000000U, 0x3d6029b0U, 0x7ac05360U, 0x47a07ad0U, 0xf580a6c0U,
+        0xc8e08f70U, 0x8f40f5a0U, 0xb220dc10U, 0x30704bc1U, 0x0d106271U,
+        0x4ab018a1U, 0x77d03111U, 0xc5f0ed01U, 0xf890c4b1U, 0xbf30be61U,
+        0x825097d1U, 0x60e09782U, 0x5d80be32U, 0x1a20c4e2U, 0x2740ed52U,
+        0x95603142U, 0xa80018f2U, 0xefa06222U, 0xd2c04b92U, 0x5090dc43U,
+        0x6df0f5f3U, 0x2a508f23U, 0x1730a693U, 0xa5107a83U, 0x98705333U,
+        0xdfd029e3U, 0xe2b00053U, 0xc1c12f04U, 0xfca106b4U, 0xbb017c64U,
+        0x866155d4U, 0x344189c4U, 0x0921a074U, 0x4e81daa4U, 0x73e1f314U,
+        0xf1b164c5U, 0xccd14d75U, 0x8b7137a5U, 0xb6111e15U, 0x0431c205U,
+        0x3951ebb5U, 0x7ef19165U, 0x4391b8d5U, 0xa121b886U, 0x9c419136U,
+        0xdbe1ebe6U, 0xe681c256U, 0x54a11e46U, 0x69c137f6U, 0x2e614d26U,
+        0x13016496U, 0x9151f347U, 0xac31daf7U, 0xeb91a027U, 0xd6f18997U,
+        0x64d15587U, 0x59b17c37U, 0x1e1106e7U, 0x23712f57U, 0x58f35849U,
+        0x659371f9U, 0x22330b29U, 0x1f532299U, 0xad73fe89U, 0x9013d739U,
+        0xd7b3ade9U, 0xead38459U, 0x68831388U, 0x55e33a38U, 0x124340e8U,
+        0x2f236958U, 0x9d03b548U, 0xa0639cf8U, 0xe7c3e628U, 0xdaa3cf98U,
+        0x3813cfcbU, 0x0573e67bU, 0x42d39cabU, 0x7fb3b51bU, 0xcd93690bU,
+        0xf0f340bbU, 0xb7533a6bU, 0x8a3313dbU, 0x0863840aU, 0x3503adbaU,
+        0x72a3d76aU, 0x4fc3fedaU, 0xfde322caU, 0xc0830b7aU, 0x872371aaU,
+        0xba43581aU, 0x9932774dU, 0xa4525efdU, 0xe3f2242dU, 0xde920d9dU,
+        0x6cb2d18dU, 0x51d2f83dU, 0x167282edU, 0x2b12ab5dU, 0xa9423c8cU,
+        0x9422153cU, 0xd3826fecU, 0xeee2465cU, 0x5cc29a4cU, 0x61a2b3fcU,
+        0x2602c92cU, 0x1b62e09cU, 0xf9d2e0cfU, 0xc4b2c97fU, 0x8312b3afU,
+        0xbe729a1fU, 0x0c52460fU, 0x31326fbfU, 0x7692156fU, 0x4bf23cdfU,
+        0xc9a2ab0eU, 0xf4c282beU, 0xb362f86eU, 0x8e02d1deU, 0x3c220dceU,
+        0x0142247eU, 0x46e25eaeU, 0x7b82771eU, 0xb1e6b092U, 0x8c869922U,
+        0xcb26e3f2U, 0xf646ca42U, 0x44661652U, 0x79063fe2U, 0x3ea64532U,
+        0x03c66c82U, 0x8196fb53U, 0xbcf6d2e3U, 0xfb56a833U, 0xc6368183U,
+        0x74165d93U, 0x49767423U, 0x0ed60ef3U, 0x33b62743U, 0xd1062710U,
+        0xec660ea0U, 0xabc67470U, 0x96a65dc0U, 0x248681d0U, 0x19e6a860U,
+        0x5e46d2b0U, 0x6326fb00U, 0xe1766cd1U, 0xdc164561U, 0x9bb63fb1U,
+        0xa6d61601U, 0x14f6ca11U, 0x2996e3a1U, 0x6e369971U, 0x5356b0c1U,
+        0x70279f96U, 0x4d47b626U, 0x0ae7ccf6U, 0x3787e546U, 0x85a73956U,
+        0xb8c710e6U, 0xff676a36U, 0xc2074386U, 0x4057d457U, 0x7d37fde7U,
+        0x3a978737U, 0x07f7ae87U, 0xb5d77297U, 0x88b75b27U, 0xcf1721f7U,
+        0xf2770847U, 0x10c70814U, 0x2da721a4U, 0x6a075b74U, 0x576772c4U,
+        0xe547aed4U, 0xd8278764U, 0x9f87fdb4U, 0xa2e7d404U, 0x20b743d5U,
+        0x1dd76a65U, 0x5a7710b5U, 0x67173905U, 0xd537e515U, 0xe857cca5U,
+        0xaff7b675U, 0x92979fc5U, 0xe915e8dbU, 0xd475c16bU, 0x93d5bbbbU,
+        0xaeb5920bU, 0x1c954e1bU, 0x21f567abU, 0x66551d7bU, 0x5b3534cbU,
+        0xd965a31aU, 0xe4058aaaU, 0xa3a5f07aU, 0x9ec5d9caU, 0x2ce505daU,
+        0x11852c6aU, 0x562556baU, 0x6b457f0aU, 0x89f57f59U, 0xb49556e9U,
+        0xf3352c39U, 0xce550589U, 0x7c75d999U, 0x4115f029U, 0x06b58af9U,
+        0x3bd5a349U, 0xb9853498U, 0x84e51d28U, 0xc34567f8U, 0xfe254e48U,
+        0x4c059258U, 0x7165bbe8U, 0x36c5c138U, 0x0ba5e888U, 0x28d4c7dfU,
+        0x15b4ee6fU, 0x521494bfU, 0x6f74bd0fU, 0xdd54611fU, 0xe03448afU,
+        0xa794327fU, 0x9af41bcfU, 0x18a48c1eU, 0x25c4a5aeU, 0x6264df7eU,
+        0x5f04f6ceU, 0xed242adeU, 0xd044036eU, 0x97e479beU, 0xaa84500eU,
+        0x4834505dU, 0x755479edU, 0x32f4033dU, 0x0f942a8dU, 0xbdb4f69dU,
+        0x80d4df2dU, 0xc774a5fdU, 0xfa148c4dU, 0x78441b9cU, 0x4524322cU,
+        0x028448fcU, 0x3fe4614cU, 0x8dc4bd5cU, 0xb0a494ecU, 0xf704ee3cU,
+        0xca64c78cU
+    },
+    {
+        0x00000000U, 0xcb5cd3a5U, 0x4dc8a10bU, 0x869472aeU, 0x9b914216U,
+        0x50cd91b3U, 0xd659e31dU, 0x1d0530b8U, 0xec53826dU, 0x270f51c8U,
+        0xa19b2366U, 0x6ac7f0c3U, 0x77c2c07bU, 0xbc9e13deU, 0x3a0a6170U,
+        0xf156b2d5U, 0x03d6029bU, 0xc88ad13eU, 0x4e1ea390U, 0x85427035U,
+        0x9847408dU, 0x531b9328U, 0xd58fe186U, 0x1ed33223U, 0xef8580f6U,
+        0x24d95353U, 0xa24d21fdU, 0x6911f258U, 0x7414c2e0U, 0xbf481145U,
+        0x39dc63ebU, 0xf280b04eU, 0x07ac0536U, 0xccf0d693U, 0x4a64a43dU,
+        0x81387798U, 0x9c3d4720U, 0x57619485U, 0xd1f5e62bU, 0x1aa9358eU,
+        0xebff875bU, 0x20a354feU, 0xa6372650U, 0x6d6bf5f5U, 0x706ec54dU,
+        0xbb3216e8U, 0x3da66446U, 0xf6fab7e3U, 0x047a07adU, 0xcf26d408U,
+        0x49b2a6a6U, 0x82ee7503U, 0x9feb45bbU, 0x54b7961eU, 0xd223e4b0U,
+        0x197f3715U, 0xe82985c0U, 0x23755665U, 0xa5e124cbU, 0x6ebdf76eU,
+        0x73b8c7d6U, 0xb8e41473U, 0x3e7066ddU, 0xf52cb578U, 0x0f580a6cU,
+        0xc404d9c9U, 0x4290ab67U, 0x89cc78c2U, 0x94c9487aU, 0x5f959bdfU,
+        0xd901e971U, 0x125d3ad4U, 0xe30b8801U, 0x28575ba4U, 0xaec3290aU,
+        0x659ffaafU, 0x789aca17U, 0xb3c619b2U, 0x35526b1cU, 0xfe0eb8b9U,
+        0x0c8e08f7U, 0xc7d2db52U, 0x4146a9fcU, 0x8a1a7a59U, 0x971f4ae1U,
+        0x5c439944U, 0xdad7ebeaU, 0x118b384fU, 0xe0dd8a9aU, 0x2b81593fU,
+        0xad152b91U, 0x6649f834U, 0x7b4cc88cU, 0xb0101b29U, 0x36846987U,
+        0xfdd8ba22U, 0x08f40f5aU, 0xc3a8dcffU, 0x453cae51U, 0x8e607df4U,
+        0x93654d4cU, 0x58399ee9U, 0xdeadec47U, 0x15f13fe2U, 0xe4a78d37U,
+        0x2ffb5e92U, 0xa96f2c3cU, 0x6233ff99U, 0x7f36cf21U, 0xb46a1c84U,
+        0x32fe6e2aU, 0xf9a2bd8fU, 0x0b220dc1U, 0xc07ede64U, 0x46eaaccaU,
+        0x8db67f6fU, 0x90b34fd7U, 0x5bef9c72U, 0xdd7beedcU, 0x16273d79U,
+        0xe7718facU, 0x2c2d5c09U, 0xaab92ea7U, 0x61e5fd02U, 0x7ce0cdbaU,
+        0xb7bc1e1fU, 0x31286cb1U, 0xfa74bf14U, 0x1eb014d8U, 0xd5ecc77dU,
+        0x5378b5d3U, 0x98246676U, 0x852156ceU, 0x4e7d856bU, 0xc8e9f7c5U,
+        0x03b52460U, 0xf2e396b5U, 0x39bf4510U, 0xbf2b37beU, 0x7477e41bU,
+        0x6972d4a3U, 0xa22e0706U, 0x24ba75a8U, 0xefe6a60dU, 0x1d661643U,
+        0xd63ac5e6U, 0x50aeb748U, 0x9bf264edU, 0x86f75455U, 0x4dab87f0U,
+        0xcb3ff55eU, 0x006326fbU, 0xf135942eU, 0x3a69478bU, 0xbcfd3525U,
+        0x77a1e680U, 0x6aa4d638U, 0xa1f8059dU, 0x276c7733U, 0xec30a496U,
+        0x191c11eeU, 0xd240c24bU, 0x54d4b0e5U, 0x9f886340U, 0x828d53f8U,
+        0x49d1805dU, 0xcf45f2f3U, 0x04192156U, 0xf54f9383U, 0x3e134026U,
+        0xb8873288U, 0x73dbe12dU, 0x6eded195U, 0xa5820230U, 0x2316709eU,
+        0xe84aa33bU, 0x1aca1375U, 0xd196c0d0U, 0x5702b27eU, 0x9c5e61dbU,
+        0x815b5163U, 0x4a0782c6U, 0xcc93f068U, 0x07cf23cdU, 0xf6999118U,
+        0x3dc542bdU, 0xbb513013U, 0x700de3b6U, 0x6d08d30eU, 0xa65400abU,
+        0x20c07205U, 0xeb9ca1a0U, 0x11e81eb4U, 0xdab4cd11U, 0x5c20bfbfU,
+        0x977c6c1aU, 0x8a795ca2U, 0x41258f07U, 0xc7b1fda9U, 0x0ced2e0cU,
+        0xfdbb9cd9U, 0x36e74f7cU, 0xb0733dd2U, 0x7b2fee77U, 0x662adecfU,
+        0xad760d6aU, 0x2be27fc4U, 0xe0beac61U, 0x123e1c2fU, 0xd962cf8aU,
+        0x5ff6bd24U, 0x94aa6e81U, 0x89af5e39U, 0x42f38d9cU, 0xc467ff32U,
+        0x0f3b2c97U, 0xfe6d9e42U, 0x35314de7U, 0xb3a53f49U, 0x78f9ececU,
+        0x65fcdc54U, 0xaea00ff1U, 0x28347d5fU, 0xe368aefaU, 0x16441b82U,
+        0xdd18c827U, 0x5b8cba89U, 0x90d0692cU, 0x8dd55994U, 0x46898a31U,
+        0xc01df89fU, 0x0b412b3aU, 0xfa1799efU, 0x314b4a4aU, 0xb7df38e4U,
+        0x7c83eb41U, 0x6186dbf9U, 0xaada085cU, 0x2c4e7af2U, 0xe712a957U,
+        0x15921919U, 0xdececabcU, 0x585ab812U, 0x93066bb7U, 0x8e035b0fU,
+        0x455f88aaU, 0xc3cbfa04U, 0x089729a1U, 0xf9c19b74U, 0x329d48d1U,
+        0xb4093a7fU, 0x7f55e9daU, 0x6250d962U, 0xa90c0ac7U, 0x2f987869U,
+        0xe4c4abccU
+    },
+    {
+        0x00000000U, 0xa6770bb4U, 0x979f1129U, 0x31e81a9dU, 0xf44f2413U,
+        0x52382fa7U, 0x63d0353aU, 0xc5a73e8eU, 0x33ef4e67U, 0x959845d3U,
+        0xa4705f4eU, 0x020754faU, 0xc7a06a74U, 0x61d761c0U, 0x503f7b5dU,
+        0xf64870e9U, 0x67de9cceU, 0xc1a9977aU, 0xf0418de7U, 0x56368653U,
+        0x9391b8ddU, 0x35e6b369U, 0x040ea9f4U, 0xa279a240U, 0x5431d2a9U,
+        0xf246d91dU, 0xc3aec380U, 0x65d9c834U, 0xa07ef6baU, 0x0609fd0eU,
+        0x37e1e793U, 0x9196ec27U, 0xcfbd399cU, 0x69ca3228U, 0x582228b5U,
+        0xfe552301U, 0x3bf21d8fU, 0x9d85163bU, 0xac6d0ca6U, 0x0a1a0712U,
+        0xfc5277fbU, 0x5a257c4fU, 0x6bcd66d2U, 0xcdba6d66U, 0x081d53e8U,
+        0xae6a585cU, 0x9f8242c1U, 0x39f54975U, 0xa863a552U, 0x0e14aee6U,
+        0x3ffcb47bU, 0x998bbfcfU, 0x5c2c8141U, 0xfa5b8af5U, 0xcbb39068U,
+        0x6dc49bdcU, 0x9b8ceb35U, 0x3dfbe081U, 0x0c13fa1cU, 0xaa64f1a8U,
+        0x6fc3cf26U, 0xc9b4c492U, 0xf85cde0fU, 0x5e2bd5bbU, 0x440b7579U,
+        0xe27c7ecdU, 0xd3946450U, 0x75e36fe4U, 0xb044516aU, 0x16335adeU,
+        0x27db4043U, 0x81ac4bf7U, 0x77e43b1eU, 0xd19330aaU, 0xe07b2a37U,
+        0x460c2183U, 0x83ab1f0dU, 0x25dc14b9U, 0x14340e24U, 0xb2430590U,
+        0x23d5e9b7U, 0x85a2e203U, 0xb44af89eU, 0x123df32aU, 0xd79acda4U,
+        0x71edc610U, 0x4005dc8dU, 0xe672d739U, 0x103aa7d0U, 0xb64dac64U,
+        0x87a5b6f9U, 0x21d2bd4dU, 0xe47583c3U, 0x42028877U, 0x73ea92eaU,
+        0xd59d995eU, 0x8bb64ce5U, 0x2dc14751U, 0x1c295dccU, 0xba5e5678U,
+        0x7ff968f6U, 0xd98e6342U, 0xe86679dfU, 0x4e11726bU, 0xb8590282U,
+        0x1e2e0936U, 0x2fc613abU, 0x89b1181fU, 0x4c162691U, 0xea612d25U,
+        0xdb8937b8U, 0x7dfe3c0cU, 0xec68d02bU, 0x4a1fdb9fU, 0x7bf7c102U,
+        0xdd80cab6U, 0x1827f438U, 0xbe50ff8cU, 0x8fb8e511U, 0x29cfeea5U,
+        0xdf879e4cU, 0x79f095f8U, 0x48188f65U, 0xee6f84d1U, 0x2bc8ba5fU,
+        0x8dbfb1ebU, 0xbc57ab76U, 0x1a20a0c2U, 0x8816eaf2U, 0x2e61e146U,
+        0x1f89fbdbU, 0xb9fef06fU, 0x7c59cee1U, 0xda2ec555U, 0xebc6dfc8U,
+        0x4db1d47cU, 0xbbf9a495U, 0x1d8eaf21U, 0x2c66b5bcU, 0x8a11be08U,
+        0x4fb68086U, 0xe9c18b32U, 0xd82991afU, 0x7e5e9a1bU, 0xefc8763cU,
+        0x49bf7d88U, 0x78576715U, 0xde206ca1U, 0x1b87522fU, 0xbdf0599bU,
+        0x8c184306U, 0x2a6f48b2U, 0xdc27385bU, 0x7a5033efU, 0x4bb82972U,
+        0xedcf22c6U, 0x28681c48U, 0x8e1f17fcU, 0xbff70d61U, 0x198006d5U,
+        0x47abd36eU, 0xe1dcd8daU, 0xd034c247U, 0x7643c9f3U, 0xb3e4f77dU,
+        0x1593fcc9U, 0x247be654U, 0x820cede0U, 0x74449d09U, 0xd23396bdU,
+        0xe3db8c20U, 0x45ac8794U, 0x800bb91aU, 0x267cb2aeU, 0x1794a833U,
+        0xb1e3a387U, 0x20754fa0U, 0x86024414U, 0xb7ea5e89U, 0x119d553dU,
+        0xd43a6bb3U, 0x724d6007U, 0x43a57a9aU, 0xe5d2712eU, 0x139a01c7U,
+        0xb5ed0a73U, 0x840510eeU, 0x22721b5aU, 0xe7d525d4U, 0x41a22e60U,
+        0x704a34fdU, 0xd63d3f49U, 0xcc1d9f8bU, 0x6a6a943fU, 0x5b828ea2U,
+        0xfdf58516U, 0x3852bb98U, 0x9e25b02cU, 0xafcdaab1U, 0x09baa105U,
+        0xfff2d1ecU, 0x5985da58U, 0x686dc0c5U, 0xce1acb71U, 0x0bbdf5ffU,
+        0xadcafe4bU, 0x9c22e4d6U, 0x3a55ef62U, 0xabc30345U, 0x0db408f1U,
+        0x3c5c126cU, 0x9a2b19d8U, 0x5f8c2756U, 0xf9fb2ce2U, 0xc813367fU,
+        0x6e643dcbU, 0x982c4d22U, 0x3e5b4696U, 0x0fb35c0bU, 0xa9c457bfU,
+        0x6c636931U, 0xca146285U, 0xfbfc7818U, 0x5d8b73acU, 0x03a0a617U,
+        0xa5d7ada3U, 0x943fb73eU, 0x3248bc8aU, 0xf7ef8204U, 0x519889b0U,
+        0x6070932dU, 0xc6079899U, 0x304fe870U, 0x9638e3c4U, 0xa7d0f959U,
+        0x01a7f2edU, 0xc400cc63U, 0x6277c7d7U, 0x539fdd4aU, 0xf5e8d6feU,
+        0x647e3ad9U, 0xc209316dU, 0xf3e12bf0U, 0x55962044U, 0x90311ecaU,
+        0x3646157eU, 0x07ae0fe3U, 0xa1d90457U, 0x579174beU, 0xf1e67f0aU,
+        0xc00e6597U, 0x66796e23U, 0xa3de50adU, 0x05a95b19U, 0x34414184U,
+        0x92364a30U
+    },
+    {
+        0x00000000U, 0xccaa009eU, 0x4225077dU, 0x8e8f07e3U, 0x844a0efaU,
+        0x48e00e64U, 0xc66f0987U, 0x0ac50919U, 0xd3e51bb5U, 0x1f4f1b2bU,
+        0x91c01cc8U, 0x5d6a1c56U, 0x57af154fU, 0x9b0515d1U, 0x158a1232U,
+        0xd92012acU, 0x7cbb312bU, 0xb01131b5U, 0x3e9e3656U, 0xf23436c8U,
+        0xf8f13fd1U, 0x345b3f4fU, 0xbad438acU, 0x767e3832U, 0xaf5e2a9eU,
+        0x63f42a00U, 0xed7b2de3U, 0x21d12d7dU, 0x2b142464U, 0xe7be24faU,
+        0x69312319U, 0xa59b2387U, 0xf9766256U, 0x35dc62c8U, 0xbb53652bU,
+        0x77f965b5U, 0x7d3c6cacU, 0xb1966c32U, 0x3f196bd1U, 0xf3b36b4fU,
+        0x2a9379e3U, 0xe639797dU, 0x68b67e9eU, 0xa41c7e00U, 0xaed97719U,
+        0x62737787U, 0xecfc7064U, 0x205670faU, 0x85cd537dU, 0x496753e3U,
+        0xc7e85400U, 0x0b42549eU, 0x01875d87U, 0xcd2d5d19U, 0x43a25afaU,
+        0x8f085a64U, 0x562848c8U, 0x9a824856U, 0x140d4fb5U, 0xd8a74f2bU,
+        0xd2624632U, 0x1ec846acU, 0x9047414fU, 0x5ced41d1U, 0x299dc2edU,
+        0xe537c273U, 0x6bb8c590U, 0xa712c50eU, 0xadd7cc17U, 0x617dcc89U,
+        0xeff2cb6aU, 0x2358cbf4U, 0xfa78d958U, 0x36d2d9c6U, 0xb85dde25U,
+        0x74f7debbU, 0x7e32d7a2U, 0xb298d73cU, 0x3c17d0dfU, 0xf0bdd041U,
+        0x5526f3c6U, 0x998cf358U, 0x1703f4bbU, 0xdba9f425U, 0xd16cfd3cU,
+        0x1dc6fda2U, 0x9349fa41U, 0x5fe3fadfU, 0x86c3e873U, 0x4a69e8edU,
+        0xc4e6ef0eU, 0x084cef90U, 0x0289e689U, 0xce23e617U, 0x40ace1f4U,
+        0x8c06e16aU, 0xd0eba0bbU, 0x1c41a025U, 0x92cea7c6U, 0x5e64a758U,
+        0x54a1ae41U, 0x980baedfU, 0x1684a93cU, 0xda2ea9a2U, 0x030ebb0eU,
+        0xcfa4bb90U, 0x412bbc73U, 0x8d81bcedU, 0x8744b5f4U, 0x4beeb56aU,
+        0xc561b289U, 0x09cbb217U, 0xac509190U, 0x60fa910eU, 0xee7596edU,
+        0x22df9673U, 0x281a9f6aU, 0xe4b09ff4U, 0x6a3f9817U, 0xa6959889U,
+        0x7fb58a25U, 0xb31f8abbU, 0x3d908d58U, 0xf13a8dc6U, 0xfbff84dfU,
+        0x37558441U, 0xb9da83a2U, 0x7570833cU, 0x533b85daU, 0x9f918544U,
+        0x111e82a7U, 0xddb48239U, 0xd7718b20U, 0x1bdb8bbeU, 0x95548c5dU,
+        0x59fe8cc3U, 0x80de9e6fU, 0x4c749ef1U, 0xc2fb9912U, 0x0e51998cU,
+        0x04949095U, 0xc83e900bU, 0x46b197e8U, 0x8a1b9776U, 0x2f80b4f1U,
+        0xe32ab46fU, 0x6da5b38cU, 0xa10fb312U, 0xabcaba0bU, 0x6760ba95U,
+        0xe9efbd76U, 0x2545bde8U, 0xfc65af44U, 0x30cfafdaU, 0xbe40a839U,
+        0x72eaa8a7U, 0x782fa1beU, 0xb485a120U, 0x3a0aa6c3U, 0xf6a0a65dU,
+        0xaa4de78cU, 0x66e7e712U, 0xe868e0f1U, 0x24c2e06fU, 0x2e07e976U,
+        0xe2ade9e8U, 0x6c22ee0bU, 0xa088ee95U, 0x79a8fc39U, 0xb502fca7U,
+        0x3b8dfb44U, 0xf727fbdaU, 0xfde2f2c3U, 0x3148f25dU, 0xbfc7f5beU,
+        0x736df520U, 0xd6f6d6a7U, 0x1a5cd639U, 0x94d3d1daU, 0x5879d144U,
+        0x52bcd85dU, 0x9e16d8c3U, 0x1099df20U, 0xdc33dfbeU, 0x0513cd12U,
+        0xc9b9cd8cU, 0x4736ca6fU, 0x8b9ccaf1U, 0x8159c3e8U, 0x4df3c376U,
+        0xc37cc495U, 0x0fd6c40bU, 0x7aa64737U, 0xb60c47a9U, 0x3883404aU,
+        0xf42940d4U, 0xfeec49cdU, 0x32464953U, 0xbcc94eb0U, 0x70634e2eU,
+        0xa9435c82U, 0x65e95c1cU, 0xeb665bffU, 0x27cc5b61U, 0x2d095278U,
+        0xe1a352e6U, 0x6f2c5505U, 0xa386559bU, 0x061d761cU, 0xcab77682U,
+        0x44387161U, 0x889271ffU, 0x825778e6U, 0x4efd7878U, 0xc0727f9bU,
+        0x0cd87f05U, 0xd5f86da9U, 0x19526d37U, 0x97dd6ad4U, 0x5b776a4aU,
+        0x51b26353U, 0x9d1863cdU, 0x1397642eU, 0xdf3d64b0U, 0x83d02561U,
+        0x4f7a25ffU, 0xc1f5221cU, 0x0d5f2282U, 0x079a2b9bU, 0xcb302b05U,
+        0x45bf2ce6U, 0x89152c78U, 0x50353ed4U, 0x9c9f3e4aU, 0x121039a9U,
+        0xdeba3937U, 0xd47f302eU, 0x18d530b0U, 0x965a3753U, 0x5af037cdU,
+        0xff6b144aU, 0x33c114d4U, 0xbd4e1337U, 0x71e413a9U, 0x7b211ab0U,
+        0xb78b1a2eU, 0x39041dcdU, 0xf5ae1d53U, 0x2c8e0fffU, 0xe0240f61U,
+        0x6eab0882U, 0xa201081cU, 0xa8c40105U, 0x646e019bU, 0xeae10678U,
+        0x264b06e6U
+    }
+};
+
+/* CRC-32C least significant bit (LSB) first slicing-by-8 tables.
+ * The tables have been generated with the same algorithm as fmCrc32Table,
+ * using poly = 0x82f63b78U.
  */
-static const fm_uint32 fmCrc32CTable[] =
+static const fm_uint32 fmCrc32CTable[FM_CRC32_SLICES][256] =
 {
-    0x00000000U, 0xf26b8303U, 0xe13b70f7U, 0x1350f3f4U, 0xc79a971fU,
-    0x35f1141cU, 0x26a1e7e8U, 0xd4ca64ebU, 0x8ad958cfU, 0x78b2dbccU,
-    0x6be22838U, 0x9989ab3bU, 0x4d43cfd0U, 0xbf284cd3U, 0xac78bf27U,
-    0x5e133c24U, 0x105ec76fU, 0xe235446cU, 0xf165b798U, 0x030e349bU,
-    0xd7c45070U, 0x25afd373U, 0x36ff2087U, 0xc494a384U, 0x9a879fa0U,
-    0x68ec1ca3U, 0x7bbcef57U, 0x89d76c54U, 0x5d1d08bfU, 0xaf768bbcU,
-    0xbc267848U, 0x4e4dfb4bU, 0x20bd8edeU, 0xd2d60dddU, 0xc186fe29U,
-    0x33ed7d2aU, 0xe72719c1U, 0x154c9ac2U, 0x061c6936U, 0xf477ea35U,
-    0xaa64d611U, 0x580f5512U, 0x4b5fa6e6U, 0xb93425e5U, 0x6dfe410eU,
-    0x9f95c20dU, 0x8cc531f9U, 0x7eaeb2faU, 0x30e349b1U, 0xc288cab2U,
-    0xd1d83946U, 0x23b3ba45U, 0xf779deaeU, 0x05125dadU, 0x1642ae59U,
-    0xe4292d5aU, 0xba3a117eU, 0x4851927dU, 0x5b016189U, 0xa96ae28aU,
-    0x7da08661U, 0x8fcb0562U, 0x9c9bf696U, 0x6ef07595U, 0x417b1dbcU,
-    0xb3109ebfU, 0xa0406d4bU, 0x522bee48U, 0x86e18aa3U, 0x748a09a0U,
-    0x67dafa54U, 0x95b17957U, 0xcba24573U, 0x39c9c670U, 0x2a993584U,
-    0xd8f2b687U, 0x0c38d26cU, 0xfe53516fU, 0xed03a29bU, 0x1f682198U,
-    0x5125dad3U, 0xa34e59d0U, 0xb01eaa24U, 0x42752927U, 0x96bf4dccU,
-    0x64d4cecfU, 0x77843d3bU, 0x85efbe38U, 0xdbfc821cU, 0x2997011fU,
-    0x3ac7f2ebU, 0xc8ac71e8U, 0x1c661503U, 0xee0d9600U, 0xfd5d65f4U,
-    0x0f36e6f7U, 0x61c69362U, 0x93ad1061U, 0x80fde395U, 0x72966096U,
-    0xa65c047dU, 0x5437877eU, 0x4767748aU, 0xb50cf789U, 0xeb1fcbadU,
-    0x197448aeU, 0x0a24bb5aU, 0xf84f3859U, 0x2c855cb2U, 0xdeeedfb1U,
-    0xcdbe2c45U, 0x3fd5af46U, 0x7198540dU, 0x83f3d70eU, 0x90a324faU,
-    0x62c8a7f9U, 0xb602c312U, 0x44694011U, 0x5739b3e5U, 0xa55230e6U,
-    0xfb410cc2U, 0x092a8fc1U, 0x1a7a7c35U, 0xe811ff36U, 0x3cdb9bddU,
-    0xceb018deU, 0xdde0eb2aU, 0x2f8b6829U, 0x82f63b78U, 0x709db87bU,
-    0x63cd4b8fU, 0x91a6c88cU, 0x456cac67U, 0xb7072f64U, 0xa457dc90U,
-    0x563c5f93U, 0x082f63b7U, 0xfa44e0b4U, 0xe9141340U, 0x1b7f9043U,
-    0xcfb5f4a8U, 0x3dde77abU, 0x2e8e845fU, 0xdce5075cU, 0x92a8fc17U,
-    0x60c37f14U, 0x73938ce0U, 0x81f80fe3U, 0x55326b08U, 0xa759e80bU,
-    0xb4091bffU, 0x466298fcU, 0x1871a4d8U, 0xea1a27dbU, 0xf94ad42fU,
-    0x0b21572cU, 0xdfeb33c7U, 0x2d80b0c4U, 0x3ed04330U, 0xccbbc033U,
-    0xa24bb5a6U, 0x502036a5U, 0x4370c551U, 0xb11b4652U, 0x65d122b9U,
-    0x97baa1baU, 0x84ea524eU, 0x7681d14dU, 0x2892ed69U, 0xdaf96e6aU,
-    0xc9a99d9eU, 0x3bc21e9dU, 0xef087a76U, 0x1d63f975U, 0x0e330a81U,
-    0xfc588982U, 0xb21572c9U, 0x407ef1caU, 0x532e023eU, 0xa145813dU,
-    0x758fe5d6U, 0x87e466d5U, 0x94b49521U, 0x66df1622U, 0x38cc2a06U,
-    0xcaa7a905U, 0xd9f75af1U, 0x2b9cd9f2U, 0xff56bd19U, 0x0d3d3e1aU,
-    0x1e6dcdeeU, 0xec064eedU, 0xc38d26c4U, 0x31e6a5c7U, 0x22b65633U,
-    0xd0ddd530U, 0x0417b1dbU, 0xf67c32d8U, 0xe52cc12cU, 0x1747422fU,
-    0x49547e0bU, 0xbb3ffd08U, 0xa86f0efcU, 0x5a048dffU, 0x8ecee914U,
-    0x7ca56a17U, 0x6ff599e3U, 0x9d9e1ae0U, 0xd3d3e1abU, 0x21b862a8U,
-    0x32e8915cU, 0xc083125fU, 0x144976b4U, 0xe622f5b7U, 0xf5720643U,
-    0x07198540U, 0x590ab964U, 0xab613a67U, 0xb831c993U, 0x4a5a4a90U,
-    0x9e902e7bU, 0x6cfbad78U, 0x7fab5e8cU, 0x8dc0dd8fU, 0xe330a81aU,
-    0x115b2b19U, 0x020bd8edU, 0xf0605beeU, 0x24aa3f05U, 0xd6c1bc06U,
-    0xc5914ff2U, 0x37faccf1U, 0x69e9f0d5U, 0x9b8273d6U, 0x88d28022U,
-    0x7ab90321U, 0xae7367caU, 0x5c18e4c9U, 0x4f48173dU, 0xbd23943eU,
-    0xf36e6f75U, 0x0105ec76U, 0x12551f82U, 0xe03e9c81U, 0x34f4f86aU,
-    0xc69f7b69U, 0xd5cf889dU, 0x27a40b9eU, 0x79b737baU, 0x8bdcb4b9U,
-    0x988c474dU, 0x6ae7c44eU, 0xbe2da0a5U, 0x4c4623a6U, 0x5f16d052U,
-    0xad7d5351U
+    {
+        0x00000000U, 0xf26b8303U, 0xe13b70f7U, 0x1350f3f4U, 0xc79a971fU,
+        0x35f1141cU, 0x26a1e7e8U, 0xd4ca64ebU, 0x8ad958cfU, 0x78b2dbccU,
+        0x6be22838U, 0x9989ab3bU, 0x4d43cfd0U, 0xbf284cd3U, 0xac78bf27U,
+        0x5e133c24U, 0x105ec76fU, 0xe235446cU, 0xf165b798U, 0x030e349bU,
+        0xd7c45070U, 0x25afd373U, 0x36ff2087U, 0xc494a384U, 0x9a879fa0U,
+        0x68ec1ca3U, 0x7bbcef57U, 0x89d76c54U, 0x5d1d08bfU, 0xaf768bbcU,
+        0xbc267848U, 0x4e4dfb4bU, 0x20bd8edeU, 0xd2d60dddU, 0xc186fe29U,
+        0x33ed7d2aU, 0xe72719c1U, 0x154c9ac2U, 0x061c6936U, 0xf477ea35U,
+        0xaa64d611U, 0x580f5512U, 0x4b5fa6e6U, 0xb93425e5U, 0x6dfe410eU,
+        0x9f95c20dU, 0x8cc531f9U, 0x7eaeb2faU, 0x30e349b1U, 0xc288cab2U,
+        0xd1d83946U, 0x23b3ba45U, 0xf779deaeU, 0x05125dadU, 0x1642ae59U,
+        0xe4292d5aU, 0xba3a117eU, 0x4851927dU, 0x5b016189U, 0xa96ae28aU,
+        0x7da08661U, 0x8fcb0562U, 0x9c9bf696U, 0x6ef07595U, 0x417b1dbcU,
+        0xb3109ebfU, 0xa0406d4bU, 0x522bee48U, 0x86e18aa3U, 0x748a09a0U,
+        0x67dafa54U, 0x95b17957U, 0xcba24573U, 0x39c9c670U, 0x2a993584U,
+        0xd8f2b687U, 0x0c38d26cU, 0xfe53516fU, 0xed03a29bU, 0x1f682198U,
+        0x5125dad3U, 0xa34e59d0U, 0xb01eaa24U, 0x42752927U, 0x96bf4dccU,
+        0x64d4cecfU, 0x77843d3bU, 0x85efbe38U, 0xdbfc821cU, 0x2997011fU,
+        0x3ac7f2ebU, 0xc8ac71e8U, 0x1c661503U, 0xee0d9600U, 0xfd5d65f4U,
+        0x0f36e6f7U, 0x61c69362U, 0x93ad1061U, 0x80fde395U, 0x72966096U,
+        0xa65c047dU, 0x5437877eU, 0x4767748aU, 0xb50cf789U, 0xeb1fcbadU,
+        0x197448aeU, 0x0a24bb5aU, 0xf84f3859U, 0x2c855cb2U, 0xdeeedfb1U,
+        0xcdbe2c45U, 0x3fd5af46U, 0x7198540dU, 0x83f3d70eU, 0x90a324faU,
+        0x62c8a7f9U, 0xb602c312U, 0x44694011U, 0x5739b3e5U, 0xa55230e6U,
+        0xfb410cc2U, 0x092a8fc1U, 0x1a7a7c35U, 0xe811ff36U, 0x3cdb9bddU,
+        0xceb018deU, 0xdde0eb2aU, 0x2f8b6829U, 0x82f63b78U, 0x709db87bU,
+        0x63cd4b8fU, 0x91a6c88cU, 0x456cac67U, 0xb7072f64U, 0xa457dc90U,
+        0x563c5f93U, 0x082f63b7U, 0xfa44e0b4U, 0xe9141340U, 0x1b7f9043U,
+        0xcfb5f4a8U, 0x3dde77abU, 0x2e8e845fU, 0xdce5075cU, 0x92a8fc17U,
+        0x60c37f14U, 0x73938ce0U, 0x81f80fe3U, 0x55326b08U, 0xa759e80bU,
+        0xb4091bffU, 0x466298fcU, 0x1871a4d8U, 0xea1a27dbU, 0xf94ad42fU,
+        0x0b21572cU, 0xdfeb33c7U, 0x2d80b0c4U, 0x3ed04330U, 0xccbbc033U,
+        0xa24bb5a6U, 0x502036a5U, 0x4370c551U, 0xb11b4652U, 0x65d122b9U,
+        0x97baa1baU, 0x84ea524eU, 0x7681d14dU, 0x2892ed69U, 0xdaf96e6aU,
+        0xc9a99d9eU, 0x3bc21e9dU, 0xef087a76U, 0x1d63f975U, 0x0e330a81U,
+        0xfc588982U, 0xb21572c9U, 0x407ef1caU, 0x532e023eU, 0xa145813dU,
+        0x758fe5d6U, 0x87e466d5U, 0x94b49521U, 0x66df1622U, 0x38cc2a06U,
+        0xcaa7a905U, 0xd9f75af1U, 0x2b9cd9f2U, 0xff56bd19U, 0x0d3d3e1aU,
+        0x1e6dcdeeU, 0xec064eedU, 0xc38d26c4U, 0x31e6a5c7U, 0x22b65633U,
+        0xd0ddd530U, 0x0417b1dbU, 0xf67c32d8U, 0xe52cc12cU, 0x1747422fU,
+        0x49547e0bU, 0xbb3ffd08U, 0xa86f0efcU, 0x5a048dffU, 0x8ecee914U,
+        0x7ca56a17U, 0x6ff599e3U, 0x9d9e1ae0U, 0xd3d3e1abU, 0x21b862a8U,
+        0x32e8915cU, 0xc083125fU, 0x144976b4U, 0xe622f5b7U, 0xf5720643U,
+        0x07198540U, 0x590ab964U, 0xab613a67U, 0xb831c993U, 0x4a5a4a90U,
+        0x9e902e7bU, 0x6cfbad78U, 0x7fab5e8cU, 0x8dc0dd8fU, 0xe330a81aU,
+        0x115b2b19U, 0x020bd8edU, 0xf0605beeU, 0x24aa3f05U, 0xd6c1bc06U,
+        0xc5914ff2U, 0x37faccf1U, 0x69e9f0d5U, 0x9b8273d6U, 0x88d28022U,
+        0x7ab90321U, 0xae7367caU, 0x5c18e4c9U, 0x4f48173dU, 0xbd23943eU,
+        0xf36e6f75U, 0x0105ec76U, 0x12551f82U, 0xe03e9c81U, 0x34f4f86aU,
+        0xc69f7b69U, 0xd5cf889dU, 0x27a40b9eU, 0x79b737baU, 0x8bdcb4b9U,
+        0x988c474dU, 0x6ae7c44eU, 0xbe2da0a5U, 0x4c4623a6U, 0x5f16d052U,
+        0xad7d5351U
+    },
+    {
+        0x00000000U, 0x13a29877U, 0x274530eeU, 0x34e7a899U, 0x4e8a61dcU,
+        0x5d28f9abU, 0x69cf5132U, 0x7a6dc945U, 0x9d14c3b8U, 0x8eb65bcfU,
+        0xba51f356U, 0xa9f36b21U, 0xd39ea264U, 0xc03c3a13U, 0xf4db928aU,
+        0xe7790afdU, 0x3fc5f181U, 0x2c6769f6U, 0x1880c16fU, 0x0b225918U,
+        0x714f905dU, 0x62ed082aU, 0x560aa0b3U, 0x45a838c4U, 0xa2d13239U,
+        0xb173aa4eU, 0x859402d7U, 0x96369aa0U, 0xec5b53e5U, 0xfff9cb92U,
+        0xcb1e630bU, 0xd8bcfb7cU, 0x7f8be302U, 0x6c297b75U, 0x58ced3ecU,
+        0x4b6c4b9bU, 0x310182deU, 0x22a31aa9U, 0x1644b230U, 0x05e62a47U,
+        0xe29f20baU, 0xf13db8cdU, 0xc5da1054U, 0xd6788823U, 0xac154166U,
+        0xbfb7d911U, 0x8b507188U, 0x98f2e9ffU, 0x404e1283U, 0x53ec8af4U,
+        0x670b226dU, 0x74a9ba1aU, 0x0ec4735fU, 0x1d66eb28U, 0x298143b1U,
+        0x3a23dbc6U, 0xdd5ad13bU, 0xcef8494cU, 0xfa1fe1d5U, 0xe9bd79a2U,
+        0x93d0b0e7U, 0x80722890U, 0xb4958009U, 0xa737187eU, 0xff17c604U,
+        0xecb55e73U, 0xd852f6eaU, 0xcbf06e9dU, 0xb19da7d8U, 0xa23f3fafU,
+        0x96d89736U, 0x857a0f41U, 0x620305bcU, 0x71a19dcbU, 0x45463552U,
+        0x56e4ad25U, 0x2c896460U, 0x3f2bfc17U, 0x0bcc548eU, 0x186eccf9U,
+        0xc0d23785U, 0xd370aff2U, 0xe797076bU, 0xf4359f1cU, 0x8e585659U,
+        0x9dface2eU, 0xa91d66b7U, 0xbabffec0U, 0x5dc6f43dU, 0x4e646c4aU,
+        0x7a83c4d3U, 0x69215ca4U, 0x134c95e1U, 0x00ee0d96U, 0x3409a50fU,
+        0x27ab3d78U, 0x809c2506U, 0x933ebd71U, 0xa7d915e8U, 0xb47b8d9fU,
+        0xce1644daU, 0xddb4dcadU, 0xe9537434U, 0xfaf1ec43U, 0x1d88e6beU,
+        0x0e2a7ec9U, 0x3acdd650U, 0x296f4e27U, 0x53028762U, 0x40a01f15U,
+        0x7447b78cU, 0x67e52ffbU, 0xbf59d487U, 0xacfb4cf0U, 0x981ce469U,
+        0x8bbe7c1eU, 0xf1d3b55bU, 0xe2712d2cU, 0xd69685b5U, 0xc5341dc2U,
+        0x224d173fU, 0x31ef8f48U, 0x050827d1U, 0x16aabfa6U, 0x6cc776e3U,
+        0x7f65ee94U, 0x4b82460dU, 0x5820de7aU, 0xfbc3faf9U, 0xe861628eU,
+        0xdc86ca17U, 0xcf245260U, 0xb5499b25U, 0xa6eb0352U, 0x920cabcbU,
+        0x81ae33bcU, 0x66d73941U, 0x7575a136U, 0x419209afU, 0x523091d8U,
+        0x285d589dU, 0x3bffc0eaU, 0x0f186873U, 0x1cbaf004U, 0xc4060b78U,
+        0xd7a4930fU, 0xe3433b96U, 0xf0e1a3e1U, 0x8a8c6aa4U, 0x992ef2d3U,
+        0xadc95a4aU, 0xbe6bc23dU, 0x5912c8c0U, 0x4ab050b7U, 0x7e57f82eU,
+        0x6df56059U, 0x1798a91cU, 0x043a316bU, 0x30dd99f2U, 0x237f0185U,
+        0x844819fbU, 0x97ea818cU, 0xa30d2915U, 0xb0afb162U, 0xcac27827U,
+        0xd960e050U, 0xed8748c9U, 0xfe25d0beU, 0x195cda43U, 0x0afe4234U,
+        0x3e19eaadU, 0x2dbb72daU, 0x57d6bb9fU, 0x447423e8U, 0x70938b71U,
+        0x63311306U, 0xbb8de87aU, 0xa82f700dU, 0x9cc8d894U, 0x8f6a40e3U,
+        0xf50789a6U, 0xe6a511d1U, 0xd242b948U, 0xc1e0213fU, 0x26992bc2U,
+        0x353bb3b5U, 0x01dc1b2cU, 0x127e835bU, 0x68134a1eU, 0x7bb1d269U,
+        0x4f567af0U, 0x5cf4e287U, 0x04d43cfdU, 0x1776a48aU, 0x23910c13U,
+        0x30339464U, 0x4a5e5d21U, 0x59fcc556U, 0x6d1b6dcfU, 0x7eb9f5b8U,
+        0x99c0ff45U, 0x8a626732U, 0xbe85cfabU, 0xad2757dcU, 0xd74a9e99U,
+        0xc4e806eeU, 0xf00fae77U, 0xe3ad3600U, 0x3b11cd7cU, 0x28b3550bU,
+        0x1c54fd92U, 0x0ff665e5U, 0x759baca0U, 0x663934d7U, 0x52de9c4eU,
+        0x417c0439U, 0xa6050ec4U, 0xb5a796b3U, 0x81403e2aU, 0x92e2a65dU,
+        0xe88f6f18U, 0xfb2df76fU, 0xcfca5ff6U, 0xdc68c781U, 0x7b5fdfffU,
+        0x68fd4788U, 0x5c1aef11U, 0x4fb87766U, 0x35d5be23U, 0x26772654U,
+        0x12908ecdU, 0x013216baU, 0xe64b1c47U, 0xf5e98430U, 0xc10e2ca9U,
+        0xd2acb4deU, 0xa8c17d9bU, 0xbb63e5ecU, 0x8f844d75U, 0x9c26d502U,
+        0x449a2e7eU, 0x5738b609U, 0x63df1e90U, 0x707d86e7U, 0x0a104fa2U,
+        0x19b2d7d5U, 0x2d557f4cU, 0x3ef7e73bU, 0xd98eedc6U, 0xca2c75b1U,
+        0xfecbdd28U, 0xed69455fU, 0x97048c1aU, 0x84a6146dU, 0xb041bcf4U,
+        0xa3e32483U
+    },
+    {
+        0x00000000U, 0xa541927eU, 0x4f6f520dU, 0xea2ec073U, 0x9edea41aU,
+        0x3b9f3664U, 0xd1b1f617U, 0x74f06469U, 0x38513ec5U, 0x9d10acbbU,
+        0x773e6cc8U, 0xd27ffeb6U, 0xa68f9adfU, 0x03ce08a1U, 0xe9e0c8d2U,
+        0x4ca15aacU, 0x70a27d8aU, 0xd5e3eff4U, 0x3fcd2f87U, 0x9a8cbdf9U,
+        0xee7cd990U, 0x4b3d4beeU, 0xa1138b9dU, 0x045219e3U, 0x48f3434fU,
+        0xedb2d131U, 0x079c1142U, 0xa2dd833cU, 0xd62de755U, 0x736c752bU,
+        0x9942b558U, 0x3c032726U, 0xe144fb14U, 0x4405696aU, 0xae2ba919U,
+        0x0b6a3b67U, 0x7f9a5f0eU, 0xdadbcd70U, 0x30f50d03U, 0x95b49f7dU,
+        0xd915c5d1U, 0x7c5457afU, 0x967a97dcU, 0x333b05a2U, 0x47cb61cbU,
+        0xe28af3b5U, 0x08a433c6U, 0xade5a1b8U, 0x91e6869eU, 0x34a714e0U,
+        0xde89d493U, 0x7bc846edU, 0x0f382284U, 0xaa79b0faU, 0x40577089U,
+        0xe516e2f7U, 0xa9b7b85bU, 0x0cf62a25U, 0xe6d8ea56U, 0x43997828U,
+        0x37691c41U, 0x92288e3fU, 0x78064e4cU, 0xdd47dc32U, 0xc76580d9U,
+        0x622412a7U, 0x880ad2d4U, 0x2d4b40aaU, 0x59bb24c3U, 0xfcfab6bdU,
+        0x16d476ceU, 0xb395e4b0U, 0xff34be1cU, 0x5a752c62U, 0xb05bec11U,
+        0x151a7e6fU, 0x61ea1a06U, 0xc4ab8878U, 0x2e85480bU, 0x8bc4da75U,
+        0xb7c7fd53U, 0x12866f2dU, 0xf8a8af5eU, 0x5de93d20U, 0x29195949U,
+        0x8c58cb37U, 0x66760b44U, 0xc337993aU, 0x8f96c396U, 0x2ad751e8U,
+        0xc0f9919bU, 0x65b803e5U, 0x1148678cU, 0xb409f5f2U, 0x5e273581U,
+        0xfb66a7ffU, 0x26217bcdU, 0x8360e9b3U, 0x694e29c0U, 0xcc0fbbbeU,
+        0xb8ffdfd7U, 0x1dbe4da9U, 0xf7908ddaU, 0x52d11fa4U, 0x1e704508U,
+        0xbb31d776U, 0x511f1705U, 0xf45e857bU, 0x80aee112U, 0x25ef736cU,
+        0xcfc1b31fU, 0x6a802161U, 0x56830647U, 0xf3c29439U, 0x19ec544aU,
+        0xbcadc634U, 0xc85da25dU, 0x6d1c3023U, 0x8732f050U, 0x2273622eU,
+        0x6ed23882U, 0xcb93aafcU, 0x21bd6a8fU, 0x84fcf8f1U, 0xf00c9c98U,
+        0x554d0ee6U, 0xbf63ce95U, 0x1a225cebU, 0x8b277743U, 0x2e66e53dU,
+        0xc448254eU, 0x6109b730U, 0x15f9d359U, 0xb0b84127U, 0x5a968154U,
+        0xffd7132aU, 0xb3764986U, 0x1637dbf8U, 0xfc191b8bU, 0x595889f5U,
+        0x2da8ed9cU, 0x88e97fe2U, 0x62c7bf91U, 0xc7862defU, 0xfb850ac9U,
+        0x5ec498b7U, 0xb4ea58c4U, 0x11abcabaU, 0x655baed3U, 0xc01a3cadU,
+        0x2a34fcdeU, 0x8f756ea0U, 0xc3d4340cU, 0x6695a672U, 0x8cbb6601U,
+        0x29faf47fU, 0x5d0a9016U, 0xf84b0268U, 0x1265c21bU, 0xb7245065U,
+        0x6a638c57U, 0xcf221e29U, 0x250cde5aU, 0x804d4c24U, 0xf4bd284dU,
+        0x51fcba33U, 0xbbd27a40U, 0x1e93e83eU, 0x5232b292U, 0xf77320ecU,
+        0x1d5de09fU, 0xb81c72e1U, 0xccec1688U, 0x69ad84f6U, 0x83834485U,
+        0x26c2d6fbU, 0x1ac1f1ddU, 0xbf8063a3U, 0x55aea3d0U, 0xf0ef31aeU,
+        0x841f55c7U, 0x215ec7b9U, 0xcb7007caU, 0x6e3195b4U, 0x2290cf18U,
+        0x87d15d66U, 0x6dff9d15U, 0xc8be0f6bU, 0xbc4e6b02U, 0x190ff97cU,
+        0xf321390fU, 0x5660ab71U, 0x4c42f79aU, 0xe90365e4U, 0x032da597U,
+        0xa66c37e9U, 0xd29c5380U, 0x77ddc1feU, 0x9df3018dU, 0x38b293f3U,
+        0x7413c95fU, 0xd1525b21U, 0x3b7c9b52U, 0x9e3d092cU, 0xeacd6d45U,
+        0x4f8cff3bU, 0xa5a23f48U, 0x00e3ad36U, 0x3ce08a10U, 0x99a1186eU,
+        0x738fd81dU, 0xd6ce4a63U, 0xa23e2e0aU, 0x077fbc74U, 0xed517c07U,
+        0x4810ee79U, 0x04b1b4d5U, 0xa1f026abU, 0x4bdee6d8U, 0xee9f74a6U,
+        0x9a6f10cfU, 0x3f2e82b1U, 0xd50042c2U, 0x7041d0bcU, 0xad060c8eU,
+        0x08479ef0U, 0xe2695e83U, 0x4728ccfdU, 0x33d8a894U, 0x96993aeaU,
+        0x7cb7fa99U, 0xd9f668e7U, 0x9557324bU, 0x3016a035U, 0xda386046U,
+        0x7f79f238U, 0x0b899651U, 0xaec8042fU, 0x44e6c45cU, 0xe1a75622U,
+        0xdda47104U, 0x78e5e37aU, 0x92cb2309U, 0x378ab177U, 0x437ad51eU,
+        0xe63b4760U, 0x0c158713U, 0xa954156dU, 0xe5f54fc1U, 0x40b4ddbfU,
+        0xaa9a1dccU, 0x0fdb8fb2U, 0x7b2bebdbU, 0xde6a79a5U, 0x3444b9d6U,
+        0x91052ba8U
+    },
+    {
+        0x00000000U, 0xdd45aab8U, 0xbf672381U, 0x62228939U, 0x7b2231f3U,
+        0xa6679b4bU, 0xc4451272U, 0x1900b8caU, 0xf64463e6U, 0x2b01c95eU,
+        0x49234067U, 0x9466eadfU, 0x8d665215U, 0x5023f8adU, 0x32017194U,
+        0xef44db2cU, 0xe964b13dU, 0x34211b85U, 0x560392bcU, 0x8b463804U,
+        0x924680ceU, 0x4f032a76U, 0x2d21a34fU, 0xf06409f7U, 0x1f20d2dbU,
+        0xc2657863U, 0xa047f15aU, 0x7d025be2U, 0x6402e328U, 0xb9474990U,
+        0xdb65c0a9U, 0x06206a11U, 0xd725148bU, 0x0a60be33U, 0x6842370aU,
+        0xb5079db2U, 0xac072578U, 0x71428fc0U, 0x136006f9U, 0xce25ac41U,
+        0x2161776dU, 0xfc24ddd5U, 0x9e0654ecU, 0x4343fe54U, 0x5a43469eU,
+        0x8706ec26U, 0xe524651fU, 0x3861cfa7U, 0x3e41a5b6U, 0xe3040f0eU,
+        0x81268637U, 0x5c632c8fU, 0x45639445U, 0x98263efdU, 0xfa04b7c4U,
+        0x27411d7cU, 0xc805c650U, 0x15406ce8U, 0x7762e5d1U, 0xaa274f69U,
+        0xb327f7a3U, 0x6e625d1bU, 0x0c40d422U, 0xd1057e9aU, 0xaba65fe7U,
+        0x76e3f55fU, 0x14c17c66U, 0xc984d6deU, 0xd0846e14U, 0x0dc1c4acU,
+        0x6fe34d95U, 0xb2a6e72dU, 0x5de23c01U, 0x80a796b9U, 0xe2851f80U,
+        0x3fc0b538U, 0x26c00df2U, 0xfb85a74aU, 0x99a72e73U, 0x44e284cbU,
+        0x42c2eedaU, 0x9f874462U, 0xfda5cd5bU, 0x20e067e3U, 0x39e0df29U,
+        0xe4a57591U, 0x8687fca8U, 0x5bc25610U, 0xb4868d3cU, 0x69c32784U,
+        0x0be1aebdU, 0xd6a40405U, 0xcfa4bccfU, 0x12e11677U, 0x70c39f4eU,
+        0xad8635f6U, 0x7c834b6cU, 0xa1c6e1d4U, 0xc3e468edU, 0x1ea1c255U,
+        0x07a17a9fU, 0xdae4d027U, 0xb8c6591eU, 0x6583f3a6U, 0x8ac7288aU,
+        0x57828232U, 0x35a00b0bU, 0xe8e5a1b3U, 0xf1e51979U, 0x2ca0b3c1U,
+        0x4e823af8U, 0x93c79040U, 0x95e7fa51U, 0x48a250e9U, 0x2a80d9d0U,
+        0xf7c57368U, 0xeec5cba2U, 0x3380611aU, 0x51a2e823U, 0x8ce7429bU,
+        0x63a399b7U, 0xbee6330fU, 0xdcc4ba36U, 0x0181108eU, 0x1881a844U,
+        0xc5c402fcU, 0xa7e68bc5U, 0x7aa3217dU, 0x52a0c93fU, 0x8fe56387U,
+        0xedc7eabeU, 0x30824006U, 0x2982f8ccU, 0xf4c75274U, 0x96e5db4dU,
+        0x4ba071f5U, 0xa4e4aad9U, 0x79a10061U, 0x1b838958U, 0xc6c623e0U,
+        0xdfc69b2aU, 0x02833192U, 0x60a1b8abU, 0xbde41213U, 0xbbc47802U,
+        0x6681d2baU, 0x04a35b83U, 0xd9e6f13bU, 0xc0e649f1U, 0x1da3e349U,
+        0x7f816a70U, 0xa2c4c0c8U, 0x4d801be4U, 0x90c5b15cU, 0xf2e73865U,
+        0x2fa292ddU, 0x36a22a17U, 0xebe780afU, 0x89c50996U, 0x5480a32eU,
+        0x8585ddb4U, 0x58c0770cU, 0x3ae2fe35U, 0xe7a7548dU, 0xfea7ec47U,
+        0x23e246ffU, 0x41c0cfc6U, 0x9c85657eU, 0x73c1be52U, 0xae8414eaU,
+        0xcca69dd3U, 0x11e3376bU, 0x08e38fa1U, 0xd5a62519U, 0xb784ac20U,
+        0x6ac10698U, 0x6ce16c89U, 0xb1a4c631U, 0xd3864f08U, 0x0ec3e5b0U,
+        0x17c35d7aU, 0xca86f7c2U, 0xa8a47efbU, 0x75e1d443U, 0x9aa50f6fU,
+        0x47e0a5d7U, 0x25c22ceeU, 0xf8878656U, 0xe1873e9cU, 0x3cc29424U,
+        0x5ee01d1dU, 0x83a5b7a5U, 0xf90696d8U, 0x24433c60U, 0x4661b559U,
+        0x9b241fe1U, 0x8224a72bU, 0x5f610d93U, 0x3d4384aaU, 0xe0062e12U,
+        0x0f42f53eU, 0xd2075f86U, 0xb025d6bfU, 0x6d607c07U, 0x7460c4cdU,
+        0xa9256e75U, 0xcb07e74cU, 0x16424df4U, 0x106227e5U, 0xcd278d5dU,
+        0xaf050464U, 0x7240aedcU, 0x6b401616U, 0xb605bcaeU, 0xd4273597U,
+        0x09629f2fU, 0xe6264403U, 0x3b63eebbU, 0x59416782U, 0x8404cd3aU,
+        0x9d0475f0U, 0x4041df48U, 0x22635671U, 0xff26fcc9U, 0x2e238253U,
+        0xf36628ebU, 0x9144a1d2U, 0x4c010b6aU, 0x5501b3a0U, 0x88441918U,
+        0xea669021U, 0x37233a99U, 0xd867e1b5U, 0x05224b0dU, 0x6700c234U,
+        0xba45688cU, 0xa345d046U, 0x7e007afeU, 0x1c22f3c7U, 0xc167597fU,
+        0xc747336eU, 0x1a0299d6U, 0x782010efU, 0xa565ba57U, 0xbc65029dU,
+        0x6120a825U, 0x0302211cU, 0xde478ba4U, 0x31035088U, 0xec46fa30U,
+        0x8e647309U, 0x5321d9b1U, 0x4a21617bU, 0x9764cbc3U, 0xf54642faU,
+        0x2803e842U
+    },
+    {
+        0x00000000U, 0x38116facU, 0x7022df58U, 0x4833b0f4U, 0xe045beb0U,
+        0xd854d11cU, 0x906761e8U, 0xa8760e44U, 0xc5670b91U, 0xfd76643dU,
+        0xb545d4c9U, 0x8d54bb65U, 0x2522b521U, 0x1d33da8dU, 0x55006a79U,
+        0x6d1105d5U, 0x8f2261d3U, 0xb7330e7fU, 0xff00be8bU, 0xc711d127U,
+        0x6f67df63U, 0x5776b0cfU, 0x1f45003bU, 0x27546f97U, 0x4a456a42U,
+        0x725405eeU, 0x3a67b51aU, 0x0276dab6U, 0xaa00d4f2U, 0x9211bb5eU,
+        0xda220baaU, 0xe2336406U, 0x1ba8b557U, 0x23b9dafbU, 0x6b8a6a0fU,
+        0x539b05a3U, 0xfbed0be7U, 0xc3fc644bU, 0x8bcfd4bfU, 0xb3debb13U,
+        0xdecfbec6U, 0xe6ded16aU, 0xaeed619eU, 0x96fc0e32U, 0x3e8a0076U,
+        0x069b6fdaU, 0x4ea8df2eU, 0x76b9b082U, 0x948ad484U, 0xac9bbb28U,
+        0xe4a80bdcU, 0xdcb96470U, 0x74cf6a34U, 0x4cde0598U, 0x04edb56cU,
+        0x3cfcdac0U, 0x51eddf15U, 0x69fcb0b9U, 0x21cf004dU, 0x19de6fe1U,
+        0xb1a861a5U, 0x89b90e09U, 0xc18abefdU, 0xf99bd151U, 0x37516aaeU,
+        0x0f400502U, 0x4773b5f6U, 0x7f62da5aU, 0xd714d41eU, 0xef05bbb2U,
+        0xa7360b46U, 0x9f2764eaU, 0xf236613fU, 0xca270e93U, 0x8214be67U,
+        0xba05d1cbU, 0x1273df8fU, 0x2a62b023U, 0x625100d7U, 0x5a406f7bU,
+        0xb8730b7dU, 0x806264d1U, 0xc851d425U, 0xf040bb89U, 0x5836b5cdU,
+        0x6027da61U, 0x28146a95U, 0x10050539U, 0x7d1400ecU, 0x45056f40U,
+        0x0d36dfb4U, 0x3527b018U, 0x9d51be5cU, 0xa540d1f0U, 0xed736104U,
+        0xd5620ea8U, 0x2cf9dff9U, 0x14e8b055U, 0x5cdb00a1U, 0x64ca6f0dU,
+        0xccbc6149U, 0xf4ad0ee5U, 0xbc9ebe11U, 0x848fd1bdU, 0xe99ed468U,
+        0xd18fbbc4U, 0x99bc0b30U, 0xa1ad649cU, 0x09db6ad8U, 0x31ca0574U,
+        0x79f9b580U, 0x41e8da2cU, 0xa3dbbe2aU, 0x9bcad186U, 0xd3f96172U,
+        0xebe80edeU, 0x439e009aU, 0x7b8f6f36U, 0x33bcdfc2U, 0x0badb06eU,
+        0x66bcb5bbU, 0x5eadda17U, 0x169e6ae3U, 0x2e8f054fU, 0x86f90b0bU,
+        0xbee864a7U, 0xf6dbd453U, 0xcecabbffU, 0x6ea2d55cU, 0x56b3baf0U,
+        0x1e800a04U, 0x269165a8U, 0x8ee76becU, 0xb6f60440U, 0xfec5b4b4U,
+        0xc6d4db18U, 0xabc5decdU, 0x93d4b161U, 0xdbe70195U, 0xe3f66e39U,
+        0x4b80607dU, 0x73910fd1U, 0x3ba2bf25U, 0x03b3d089U, 0xe180b48fU,
+        0xd991db23U, 0x91a26bd7U, 0xa9b3047bU, 0x01c50a3fU, 0x39d46593U,
+        0x71e7d567U, 0x49f6bacbU, 0x24e7bf1eU, 0x1cf6d0b2U, 0x54c56046U,
+        0x6cd40feaU, 0xc4a201aeU, 0xfcb36e02U, 0xb480def6U, 0x8c91b15aU,
+        0x750a600bU, 0x4d1b0fa7U, 0x0528bf53U, 0x3d39d0ffU, 0x954fdebbU,
+        0xad5eb117U, 0xe56d01e3U, 0xdd7c6e4fU, 0xb06d6b9aU, 0x887c0436U,
+        0xc04fb4c2U, 0xf85edb6eU, 0x5028d52aU, 0x6839ba86U, 0x200a0a72U,
+        0x181b65deU, 0xfa2801d8U, 0xc2396e74U, 0x8a0ade80U, 0xb21bb12cU,
+        0x1a6dbf68U, 0x227cd0c4U, 0x6a4f6030U, 0x525e0f9cU, 0x3f4f0a49U,
+        0x075e65e5U, 0x4f6dd511U, 0x777cbabdU, 0xdf0ab4f9U, 0xe71bdb55U,
+        0xaf286ba1U, 0x9739040dU, 0x59f3bff2U, 0x61e2d05eU, 0x29d160aaU,
+        0x11c00f06U, 0xb9b60142U, 0x81a76eeeU, 0xc994de1aU, 0xf185b1b6U,
+        0x9c94b463U, 0xa485dbcfU, 0xecb66b3bU, 0xd4a70497U, 0x7cd10ad3U,
+        0x44c0657fU, 0x0cf3d58bU, 0x34e2ba27U, 0xd6d1de21U, 0xeec0b18dU,
+        0xa6f30179U, 0x9ee26ed5U, 0x36946091U, 0x0e850f3dU, 0x46b6bfc9U,
+        0x7ea7d065U, 0x13b6d5b0U, 0x2ba7ba1cU, 0x63940ae8U, 0x5b856544U,
+        0xf3f36b00U, 0xcbe204acU, 0x83d1b458U, 0xbbc0dbf4U, 0x425b0aa5U,
+        0x7a4a6509U, 0x3279d5fdU, 0x0a68ba51U, 0xa21eb415U, 0x9a0fdbb9U,
+        0xd23c6b4dU, 0xea2d04e1U, 0x873c0134U, 0xbf2d6e98U, 0xf71ede6cU,
+        0xcf0fb1c0U, 0x6779bf84U, 0x5f68d028U, 0x175b60dcU, 0x2f4a0f70U,
+        0xcd796b76U, 0xf56804daU, 0xbd5bb42eU, 0x854adb82U, 0x2d3cd5c6U,
+        0x152dba6aU, 0x5d1e0a9eU, 0x650f6532U, 0x081e60e7U, 0x300f0f4bU,
+        0x783cbfbfU, 0x402dd013U, 0xe85bde57U, 0xd04ab1fbU, 0x9879010fU,
+        0xa0686ea3U
+    },
+    {
+        0x00000000U, 0xef306b19U, 0xdb8ca0c3U, 0x34bccbdaU, 0xb2f53777U,
+        0x5dc55c6eU, 0x697997b4U, 0x8649fcadU, 0x6006181fU, 0x8f367306U,
+        0xbb8ab8dcU, 0x54bad3c5U, 0xd2f32f68U, 0x3dc34471U, 0x097f8fabU,
+        0xe64fe4b2U, 0xc00c303eU, 0x2f3c5b27U, 0x1b8090fdU, 0xf4b0fbe4U,
+        0x72f90749U, 0x9dc96c50U, 0xa975a78aU, 0x4645cc93U, 0xa00a2821U,
+        0x4f3a4338U, 0x7b8688e2U, 0x94b6e3fbU, 0x12ff1f56U, 0xfdcf744fU,
+        0xc973bf95U, 0x2643d48cU, 0x85f4168dU, 0x6ac47d94U, 0x5e78b64eU,
+        0xb148dd57U, 0x370121faU, 0xd8314ae3U, 0xec8d8139U, 0x03bdea20U,
+        0xe5f20e92U, 0x0ac2658bU, 0x3e7eae51U, 0xd14ec548U, 0x570739e5U,
+        0xb83752fcU, 0x8c8b9926U, 0x63bbf23fU, 0x45f826b3U, 0xaac84daaU,
+        0x9e748670U, 0x7144ed69U, 0xf70d11c4U, 0x183d7addU, 0x2c81b107U,
+        0xc3b1da1eU, 0x25fe3eacU, 0xcace55b5U, 0xfe729e6fU, 0x1142f576U,
+        0x970b09dbU, 0x783b62c2U, 0x4c87a918U, 0xa3b7c201U, 0x0e045bebU,
+        0xe13430f2U, 0xd588fb28U, 0x3ab89031U, 0xbcf16c9cU, 0x53c10785U,
+        0x677dcc5fU, 0x884da746U, 0x6e0243f4U, 0x813228edU, 0xb58ee337U,
+        0x5abe882eU, 0xdcf77483U, 0x33c71f9aU, 0x077bd440U, 0xe84bbf59U,
+        0xce086bd5U, 0x213800ccU, 0x1584cb16U, 0xfab4a00fU, 0x7cfd5ca2U,
+        0x93cd37bbU, 0xa771fc61U, 0x48419778U, 0xae0e73caU, 0x413e18d3U,
+        0x7582d309U, 0x9ab2b810U, 0x1cfb44bdU, 0xf3cb2fa4U, 0xc777e47eU,
+        0x28478f67U, 0x8bf04d66U, 0x64c0267fU, 0x507ceda5U, 0xbf4c86bcU,
+        0x39057a11U, 0xd6351108U, 0xe289dad2U, 0x0db9b1cbU, 0xebf65579U,
+        0x04c63e60U, 0x307af5baU, 0xdf4a9ea3U, 0x5903620eU, 0xb6330917U,
+        0x828fc2cdU, 0x6dbfa9d4U, 0x4bfc7d58U, 0xa4cc1641U, 0x9070dd9bU,
+        0x7f40b682U, 0xf9094a2fU, 0x16392136U, 0x2285eaecU, 0xcdb581f5U,
+        0x2bfa6547U, 0xc4ca0e5eU, 0xf076c584U, 0x1f46ae9dU, 0x990f5230U,
+        0x763f3929U, 0x4283f2f3U, 0xadb399eaU, 0x1c08b7d6U, 0xf338dccfU,
+        0xc7841715U, 0x28b47c0cU, 0xaefd80a1U, 0x41cdebb8U, 0x75712062U,
+        0x9a414b7bU, 0x7c0eafc9U, 0x933ec4d0U, 0xa7820f0aU, 0x48b26413U,
+        0xcefb98beU, 0x21cbf3a7U, 0x1577387dU, 0xfa475364U, 0xdc0487e8U,
+        0x3334ecf1U, 0x0788272bU, 0xe8b84c32U, 0x6ef1b09fU, 0x81c1db86U,
+        0xb57d105cU, 0x5a4d7b45U, 0xbc029ff7U, 0x5332f4eeU, 0x678e3f34U,
+        0x88be542dU, 0x0ef7a880U, 0xe1c7c399U, 0xd57b0843U, 0x3a4b635aU,
+        0x99fca15bU, 0x76ccca42U, 0x42700198U, 0xad406a81U, 0x2b09962cU,
+        0xc439fd35U, 0xf08536efU, 0x1fb55df6U, 0xf9fab944U, 0x16cad25dU,
+        0x22761987U, 0xcd46729eU, 0x4b0f8e33U, 0xa43fe52aU, 0x90832ef0U,
+        0x7fb345e9U, 0x59f09165U, 0xb6c0fa7cU, 0x827c31a6U, 0x6d4c5abfU,
+        0xeb05a612U, 0x0435cd0bU, 0x308906d1U, 0xdfb96dc8U, 0x39f6897aU,
+        0xd6c6e263U, 0xe27a29b9U, 0x0d4a42a0U, 0x8b03be0dU, 0x6433d514U,
+        0x508f1eceU, 0xbfbf75d7U, 0x120cec3dU, 0xfd3c8724U, 0xc9804cfeU,
+        0x26b027e7U, 0xa0f9db4aU, 0x4fc9b053U, 0x7b757b89U, 0x94451090U,
+        0x720af422U, 0x9d3a9f3bU, 0xa98654e1U, 0x46b63ff8U, 0xc0ffc355U,
+        0x2fcfa84cU, 0x1b736396U, 0xf443088fU, 0xd200dc03U, 0x3d30b71aU,
+        0x098c7cc0U, 0xe6bc17d9U, 0x60f5eb74U, 0x8fc5806dU, 0xbb794bb7U,
+        0x544920aeU, 0xb206c41cU, 0x5d36af05U, 0x698a64dfU, 0x86ba0fc6U,
+        0x00f3f36bU, 0xefc39872U, 0xdb7f53a8U, 0x344f38b1U, 0x97f8fab0U,
+        0x78c891a9U, 0x4c745a73U, 0xa344316aU, 0x250dcdc7U, 0xca3da6deU,
+        0xfe816d04U, 0x11b1061dU, 0xf7fee2afU, 0x18ce89b6U, 0x2c72426cU,
+        0xc3422975U, 0x450bd5d8U, 0xaa3bbec1U, 0x9e87751bU, 0x71b71e02U,
+        0x57f4ca8eU, 0xb8c4a197U, 0x8c786a4dU, 0x63480154U, 0xe501fdf9U,
+        0x0a3196e0U, 0x3e8d5d3aU, 0xd1bd3623U, 0x37f2d291U, 0xd8c2b988U,
+        0xec7e7252U, 0x034e194bU, 0x8507e5e6U, 0x6a378effU, 0x5e8b4525U,
+        0xb1bb2e3cU
+    },
+    {
+        0x00000000U, 0x68032cc8U, 0xd0065990U, 0xb8057558U, 0xa5e0c5d1U,
+        0xcde3e919U, 0x75e69c41U, 0x1de5b089U, 0x4e2dfd53U, 0x262ed19bU,
+        0x9e2ba4c3U, 0xf628880bU, 0xebcd3882U, 0x83ce144aU, 0x3bcb6112U,
+        0x53c84ddaU, 0x9c5bfaa6U, 0xf458d66eU, 0x4c5da336U, 0x245e8ffeU,
+        0x39bb3f77U, 0x51b813bfU, 0xe9bd66e7U, 0x81be4a2fU, 0xd27607f5U,
+        0xba752b3dU, 0x02705e65U, 0x6a7372adU, 0x7796c224U, 0x1f95eeecU,
+        0xa7909bb4U, 0xcf93b77cU, 0x3d5b83bdU, 0x5558af75U, 0xed5dda2dU,
+        0x855ef6e5U, 0x98bb466cU, 0xf0b86aa4U, 0x48bd1ffcU, 0x20be3334U,
+        0x73767eeeU, 0x1b755226U, 0xa370277eU, 0xcb730bb6U, 0xd696bb3fU,
+        0xbe9597f7U, 0x0690e2afU, 0x6e93ce67U, 0xa100791bU, 0xc90355d3U,
+        0x7106208bU, 0x19050c43U, 0x04e0bccaU, 0x6ce39002U, 0xd4e6e55aU,
+        0xbce5c992U, 0xef2d8448U, 0x872ea880U, 0x3f2bddd8U, 0x5728f110U,
+        0x4acd4199U, 0x22ce6d51U, 0x9acb1809U, 0xf2c834c1U, 0x7ab7077aU,
+        0x12b42bb2U, 0xaab15eeaU, 0xc2b27222U, 0xdf57c2abU, 0xb754ee63U,
+        0x0f519b3bU, 0x6752b7f3U, 0x349afa29U, 0x5c99d6e1U, 0xe49ca3b9U,
+        0x8c9f8f71U, 0x917a3ff8U, 0xf9791330U, 0x417c6668U, 0x297f4aa0U,
+        0xe6ecfddcU, 0x8eefd114U, 0x36eaa44cU, 0x5ee98884U, 0x430c380dU,
+        0x2b0f14c5U, 0x930a619dU, 0xfb094d55U, 0xa8c1008fU, 0xc0c22c47U,
+        0x78c7591fU, 0x10c475d7U, 0x0d21c55eU, 0x6522e996U, 0xdd279cceU,
+        0xb524b006U, 0x47ec84c7U, 0x2fefa80fU, 0x97eadd57U, 0xffe9f19fU,
+        0xe20c4116U, 0x8a0f6ddeU, 0x320a1886U, 0x5a09344eU, 0x09c17994U,
+        0x61c2555cU, 0xd9c72004U, 0xb1c40cccU, 0xac21bc45U, 0xc422908dU,
+        0x7c27e5d5U, 0x1424c91dU, 0xdbb77e61U, 0xb3b452a9U, 0x0bb127f1U,
+        0x63b20b39U, 0x7e57bbb0U, 0x16549778U, 0xae51e220U, 0xc652cee8U,
+        0x959a8332U, 0xfd99affaU, 0x459cdaa2U, 0x2d9ff66aU, 0x307a46e3U,
+        0x58796a2bU, 0xe07c1f73U, 0x887f33bbU, 0xf56e0ef4U, 0x9d6d223cU,
+        0x25685764U, 0x4d6b7bacU, 0x508ecb25U, 0x388de7edU, 0x808892b5U,
+        0xe88bbe7dU, 0xbb43f3a7U, 0xd340df6fU, 0x6b45aa37U, 0x034686ffU,
+        0x1ea33676U, 0x76a01abeU, 0xcea56fe6U, 0xa6a6432eU, 0x6935f452U,
+        0x0136d89aU, 0xb933adc2U, 0xd130810aU, 0xccd53183U, 0xa4d61d4bU,
+        0x1cd36813U, 0x74d044dbU, 0x27180901U, 0x4f1b25c9U, 0xf71e5091U,
+        0x9f1d7c59U, 0x82f8ccd0U, 0xeafbe018U, 0x52fe9540U, 0x3afdb988U,
+        0xc8358d49U, 0xa036a181U, 0x1833d4d9U, 0x7030f811U, 0x6dd54898U,
+        0x05d66450U, 0xbdd31108U, 0xd5d03dc0U, 0x8618701aU, 0xee1b5cd2U,
+        0x561e298aU, 0x3e1d0542U, 0x23f8b5cbU, 0x4bfb9903U, 0xf3feec5bU,
+        0x9bfdc093U, 0x546e77efU, 0x3c6d5b27U, 0x84682e7fU, 0xec6b02b7U,
+        0xf18eb23eU, 0x998d9ef6U, 0x2188ebaeU, 0x498bc766U, 0x1a438abcU,
+        0x7240a674U, 0xca45d32cU, 0xa246ffe4U, 0xbfa34f6dU, 0xd7a063a5U,
+        0x6fa516fdU, 0x07a63a35U, 0x8fd9098eU, 0xe7da2546U, 0x5fdf501eU,
+        0x37dc7cd6U, 0x2a39cc5fU, 0x423ae097U, 0xfa3f95cfU, 0x923cb907U,
+        0xc1f4f4ddU, 0xa9f7d815U, 0x11f2ad4dU, 0x79f18185U, 0x6414310cU,
+        0x0c171dc4U, 0xb412689cU, 0xdc114454U, 0x1382f328U, 0x7b81dfe0U,
+        0xc384aab8U, 0xab878670U, 0xb66236f9U, 0xde611a31U, 0x66646f69U,
+        0x0e6743a1U, 0x5daf0e7bU, 0x35ac22b3U, 0x8da957ebU, 0xe5aa7b23U,
+        0xf84fcbaaU, 0x904ce762U, 0x2849923aU, 0x404abef2U, 0xb2828a33U,
+        0xda81a6fbU, 0x6284d3a3U, 0x0a87ff6bU, 0x17624fe2U, 0x7f61632aU,
+        0xc7641672U, 0xaf673abaU, 0xfcaf7760U, 0x94ac5ba8U, 0x2ca92ef0U,
+        0x44aa0238U, 0x594fb2b1U, 0x314c9e79U, 0x8949eb21U, 0xe14ac7e9U,
+        0x2ed97095U, 0x46da5c5dU, 0xfedf2905U, 0x96dc05cdU, 0x8b39b544U,
+        0xe33a998cU, 0x5b3fecd4U, 0x333cc01cU, 0x60f48dc6U, 0x08f7a10eU,
+        0xb0f2d456U, 0xd8f1f89eU, 0xc5144817U, 0xad1764dfU, 0x15121187U,
+        0x7d113d4fU
+    },
+    {
+        0x00000000U, 0x493c7d27U, 0x9278fa4eU, 0xdb448769U, 0x211d826dU,
+        0x6821ff4aU, 0xb3657823U, 0xfa590504U, 0x423b04daU, 0x0b0779fdU,
+        0xd043fe94U, 0x997f83b3U, 0x632686b7U, 0x2a1afb90U, 0xf15e7cf9U,
+        0xb86201deU, 0x847609b4U, 0xcd4a7493U, 0x160ef3faU, 0x5f328eddU,
+        0xa56b8bd9U, 0xec57f6feU, 0x37137197U, 0x7e2f0cb0U, 0xc64d0d6eU,
+        0x8f717049U, 0x5435f720U, 0x1d098a07U, 0xe7508f03U, 0xae6cf224U,
+        0x7528754dU, 0x3c14086aU, 0x0d006599U, 0x443c18beU, 0x9f789fd7U,
+        0xd644e2f0U, 0x2c1de7f4U, 0x65219ad3U, 0xbe651dbaU, 0xf759609dU,
+        0x4f3b6143U, 0x06071c64U, 0xdd439b0dU, 0x947fe62aU, 0x6e26e32eU,
+        0x271a9e09U, 0xfc5e1960U, 0xb5626447U, 0x89766c2dU, 0xc04a110aU,
+        0x1b0e9663U, 0x5232eb44U, 0xa86bee40U, 0xe1579367U, 0x3a13140eU,
+        0x732f6929U, 0xcb4d68f7U, 0x827115d0U, 0x593592b9U, 0x1009ef9eU,
+        0xea50ea9aU, 0xa36c97bdU, 0x782810d4U, 0x31146df3U, 0x1a00cb32U,
+        0x533cb615U, 0x8878317cU, 0xc1444c5bU, 0x3b1d495fU, 0x72213478U,
+        0xa965b311U, 0xe059ce36U, 0x583bcfe8U, 0x1107b2cfU, 0xca4335a6U,
+        0x837f4881U, 0x79264d85U, 0x301a30a2U, 0xeb5eb7cbU, 0xa262caecU,
+        0x9e76c286U, 0xd74abfa1U, 0x0c0e38c8U, 0x453245efU, 0xbf6b40ebU,
+        0xf6573dccU, 0x2d13baa5U, 0x642fc782U, 0xdc4dc65cU, 0x9571bb7bU,
+        0x4e353c12U, 0x07094135U, 0xfd504431U, 0xb46c3916U, 0x6f28be7fU,
+        0x2614c358U, 0x1700aeabU, 0x5e3cd38cU, 0x857854e5U, 0xcc4429c2U,
+        0x361d2cc6U, 0x7f2151e1U, 0xa465d688U, 0xed59abafU, 0x553baa71U,
+        0x1c07d756U, 0xc743503fU, 0x8e7f2d18U, 0x7426281cU, 0x3d1a553bU,
+        0xe65ed252U, 0xaf62af75U, 0x9376a71fU, 0xda4ada38U, 0x010e5d51U,
+        0x48322076U, 0xb26b2572U, 0xfb575855U, 0x2013df3cU, 0x692fa21bU,
+        0xd14da3c5U, 0x9871dee2U, 0x4335598bU, 0x0a0924acU, 0xf05021a8U,
+        0xb96c5c8fU, 0x6228dbe6U, 0x2b14a6c1U, 0x34019664U, 0x7d3deb43U,
+        0xa6796c2aU, 0xef45110dU, 0x151c1409U, 0x5c20692eU, 0x8764ee47U,
+        0xce589360U, 0x763a92beU, 0x3f06ef99U, 0xe44268f0U, 0xad7e15d7U,
+        0x572710d3U, 0x1e1b6df4U, 0xc55fea9dU, 0x8c6397baU, 0xb0779fd0U,
+        0xf94be2f7U, 0x220f659eU, 0x6b3318b9U, 0x916a1dbdU, 0xd856609aU,
+        0x0312e7f3U, 0x4a2e9ad4U, 0xf24c9b0aU, 0xbb70e62dU, 0x60346144U,
+        0x29081c63U, 0xd3511967U, 0x9a6d6440U, 0x4129e329U, 0x08159e0eU,
+        0x3901f3fdU, 0x703d8edaU, 0xab7909b3U, 0xe2457494U, 0x181c7190U,
+        0x51200cb7U, 0x8a648bdeU, 0xc358f6f9U, 0x7b3af727U, 0x32068a00U,
+        0xe9420d69U, 0xa07e704eU, 0x5a27754aU, 0x131b086dU, 0xc85f8f04U,
+        0x8163f223U, 0xbd77fa49U, 0xf44b876eU, 0x2f0f0007U, 0x66337d20U,
+        0x9c6a7824U, 0xd5560503U, 0x0e12826aU, 0x472eff4dU, 0xff4cfe93U,
+        0xb67083b4U, 0x6d3404ddU, 0x240879faU, 0xde517cfeU, 0x976d01d9U,
+        0x4c2986b0U, 0x0515fb97U, 0x2e015d56U, 0x673d2071U, 0xbc79a718U,
+        0xf545da3fU, 0x0f1cdf3bU, 0x4620a21cU, 0x9d642575U, 0xd4585852U,
+        0x6c3a598cU, 0x250624abU, 0xfe42a3c2U, 0xb77edee5U, 0x4d27dbe1U,
+        0x041ba6c6U, 0xdf5f21afU, 0x96635c88U, 0xaa7754e2U, 0xe34b29c5U,
+        0x380faeacU, 0x7133d38bU, 0x8b6ad68fU, 0xc256aba8U, 0x19122cc1U,
+        0x502e51e6U, 0xe84c5038U, 0xa1702d1fU, 0x7a34aa76U, 0x3308d751U,
+        0xc951d255U, 0x806daf72U, 0x5b29281bU, 0x1215553cU, 0x230138cfU,
+        0x6a3d45e8U, 0xb179c281U, 0xf845bfa6U, 0x021cbaa2U, 0x4b20c785U,
+        0x906440ecU, 0xd9583dcbU, 0x613a3c15U, 0x28064132U, 0xf342c65bU,
+        0xba7ebb7cU, 0x4027be78U, 0x091bc35fU, 0xd25f4436U, 0x9b633911U,
+        0xa777317bU, 0xee4b4c5cU, 0x350fcb35U, 0x7c33b612U, 0x866ab316U,
+        0xcf56ce31U, 0x14124958U, 0x5d2e347fU, 0xe54c35a1U, 0xac704886U,
+        0x7734cfefU, 0x3e08b2c8U, 0xc451b7ccU, 0x8d6dcaebU, 0x56294d82U,
+        0x1f1530a5U
+    }
 };
 
 /*****************************************************************************
@@ -199,6 +994,483 @@ static const fm_uint32 fmCrc32CTable[] =
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** Crc32Bytewise
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC one byte at a time. This is the
+ *                  reference algorithm the faster engines are checked
+ *                  against.
+ *
+ * \param[in]       table is the slicing table set for the polynomial.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 Crc32Bytewise(const fm_uint32 (*table)[256],
+                               fm_uint32        crc,
+                               const fm_byte *  buf,
+                               fm_int           len)
+{
+    fm_int i;
+
+    for (i = 0 ; i < len ; i++)
+    {
+        crc = table[0][(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+    }
+
+    return crc;
+
+}   /* end Crc32Bytewise */
+
+
+
+
+/*****************************************************************************/
+/** Crc32Slice8
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC 8 bytes at a time using the
+ *                  slicing-by-8 tables. The 8 lookups of each step are
+ *                  independent of each other, unlike the serial
+ *                  dependency of the bytewise loop.
+ *
+ * \param[in]       table is the slicing table set for the polynomial.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 Crc32Slice8(const fm_uint32 (*table)[256],
+                             fm_uint32        crc,
+                             const fm_byte *  buf,
+                             fm_int           len)
+{
+    fm_uint32 lo;
+    fm_uint32 hi;
+
+    while (len >= 8)
+    {
+        lo = crc ^ FM_CRC32_LOAD_LE32(buf);
+        hi = FM_CRC32_LOAD_LE32(buf + 4);
+
+        crc = table[7][lo & 0xff]         ^
+              table[6][(lo >> 8) & 0xff]  ^
+              table[5][(lo >> 16) & 0xff] ^
+              table[4][lo >> 24]          ^
+              table[3][hi & 0xff]         ^
+              table[2][(hi >> 8) & 0xff]  ^
+              table[1][(hi >> 16) & 0xff] ^
+              table[0][hi >> 24];
+
+        buf += 8;
+        len -= 8;
+    }
+
+    return Crc32Bytewise(table, crc, buf, len);
+
+}   /* end Crc32Slice8 */
+
+
+
+
+#ifdef FM_CRC32_HW_X86
+
+/*****************************************************************************/
+/** Crc32FoldPclmul
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC-32 using carry-less multiplication
+ *                  to fold 64 bytes per step, followed by a Barrett
+ *                  reduction to 32 bits. See "Fast CRC Computation for
+ *                  Generic Polynomials Using PCLMULQDQ Instruction",
+ *                  Intel, 2009, for the derivation of the constants.
+ *
+ * \note            The caller must check that the CPU supports PCLMULQDQ
+ *                  and SSE4.1.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf. It must be at least
+ *                  FM_CRC32_FOLD_MIN_LEN and a multiple of 16.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+__attribute__((target("pclmul,sse4.1")))
+static fm_uint32 Crc32FoldPclmul(fm_uint32       crc,
+                                 const fm_byte * buf,
+                                 fm_int          len)
+{
+    __m128i k;
+    __m128i x1;
+    __m128i x2;
+    __m128i x3;
+    __m128i x4;
+    __m128i t1;
+    __m128i t2;
+    __m128i t3;
+    __m128i t4;
+    __m128i mask;
+
+    x1 = _mm_loadu_si128( (const __m128i *) (buf + 0x00) );
+    x2 = _mm_loadu_si128( (const __m128i *) (buf + 0x10) );
+    x3 = _mm_loadu_si128( (const __m128i *) (buf + 0x20) );
+    x4 = _mm_loadu_si128( (const __m128i *) (buf + 0x30) );
+
+    x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( (int) crc ) );
+
+    buf += 64;
+    len -= 64;
+
+    /* Fold 4 x 128 bits forward by 512 bits. */
+    k = _mm_set_epi64x( 0x01c6e41596LL, 0x0154442bd4LL );
+
+    while (len >= 64)
+    {
+        t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+        t2 = _mm_clmulepi64_si128(x2, k, 0x00);
+        t3 = _mm_clmulepi64_si128(x3, k, 0x00);
+        t4 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+
+        x1 = _mm_xor_si128( _mm_xor_si128(x1, t1),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x00) ) );
+        x2 = _mm_xor_si128( _mm_xor_si128(x2, t2),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x10) ) );
+        x3 = _mm_xor_si128( _mm_xor_si128(x3, t3),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x20) ) );
+        x4 = _mm_xor_si128( _mm_xor_si128(x4, t4),
+                            _mm_loadu_si128( (const __m128i *) (buf + 0x30) ) );
+
+        buf += 64;
+        len -= 64;
+    }
+
+    /* Fold the 4 lanes into one, 128 bits at a time. */
+    k = _mm_set_epi64x( 0x00ccaa009eLL, 0x01751997d0LL );
+
+    t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x2), t1 );
+
+    t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x3), t1 );
+
+    t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+    x1 = _mm_xor_si128( _mm_xor_si128(x1, x4), t1 );
+
+    while (len >= 16)
+    {
+        t1 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        x1 = _mm_xor_si128( _mm_xor_si128(x1, t1),
+                            _mm_loadu_si128( (const __m128i *) buf ) );
+
+        buf += 16;
+        len -= 16;
+    }
+
+    /* Fold 128 bits down to 64. */
+    mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    t1 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128( _mm_srli_si128(x1, 8), t1 );
+
+    k  = _mm_set_epi64x( 0, 0x0163cd6124LL );
+    t1 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128( _mm_and_si128(x1, mask), k, 0x00 );
+    x1 = _mm_xor_si128(x1, t1);
+
+    /* Barrett reduction to 32 bits. */
+    k  = _mm_set_epi64x( 0x01f7011641LL, 0x01db710641LL );
+    t1 = _mm_clmulepi64_si128( _mm_and_si128(x1, mask), k, 0x10 );
+    t1 = _mm_clmulepi64_si128( _mm_and_si128(t1, mask), k, 0x00 );
+    x1 = _mm_xor_si128(x1, t1);
+
+    return (fm_uint32) _mm_extract_epi32(x1, 1);
+
+}   /* end Crc32FoldPclmul */
+
+
+
+
+/*****************************************************************************/
+/** Crc32CSse42
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC-32C using the SSE4.2 crc32
+ *                  instruction, 8 bytes at a time.
+ *
+ * \note            The caller must check that the CPU supports SSE4.2.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+__attribute__((target("sse4.2")))
+static fm_uint32 Crc32CSse42(fm_uint32       crc,
+                             const fm_byte * buf,
+                             fm_int          len)
+{
+    fm_uint64 crc64;
+    fm_uint64 word;
+
+    crc64 = crc;
+
+    while (len >= 8)
+    {
+        word  = (fm_uint64) _mm_cvtsi128_si64(
+                    _mm_loadl_epi64( (const __m128i *) buf ) );
+        crc64 = _mm_crc32_u64(crc64, word);
+        buf += 8;
+        len -= 8;
+    }
+
+    crc = (fm_uint32) crc64;
+
+    while (len > 0)
+    {
+        crc = _mm_crc32_u8(crc, *buf);
+        buf++;
+        len--;
+    }
+
+    return crc;
+
+}   /* end Crc32CSse42 */
+
+#endif  /* FM_CRC32_HW_X86 */
+
+
+
+
+/*****************************************************************************/
+/** SelectEngines
+ * \ingroup intUtil
+ *
+ * \desc            Probes the CPU once and selects the fastest engine
+ *                  available for CRC-32 and CRC-32C. Concurrent first
+ *                  callers may both probe; they store the same result.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SelectEngines(void)
+{
+    fm_crc32Engine engine32  = FM_CRC32_ENGINE_SLICE8;
+    fm_crc32Engine engine32C = FM_CRC32_ENGINE_SLICE8;
+#ifdef FM_CRC32_HW_X86
+    unsigned int   eax;
+    unsigned int   ebx;
+    unsigned int   ecx;
+    unsigned int   edx;
+
+    if ( __get_cpuid(1, &eax, &ebx, &ecx, &edx) )
+    {
+        if ( (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1) )
+        {
+            engine32 = FM_CRC32_ENGINE_HW;
+        }
+
+        if (ecx & bit_SSE4_2)
+        {
+            engine32C = FM_CRC32_ENGINE_HW;
+        }
+    }
+#endif
+
+    crc32CEngine = engine32C;
+    crc32Engine  = engine32;
+
+}   /* end SelectEngines */
+
+
+
+
+/*****************************************************************************/
+/** Crc32UpdateWith
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC-32 with the given engine.
+ *
+ * \param[in]       engine is the engine to use.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 Crc32UpdateWith(fm_crc32Engine  engine,
+                                 fm_uint32       crc,
+                                 const fm_byte * buf,
+                                 fm_int          len)
+{
+#ifdef FM_CRC32_HW_X86
+    fm_int chunk;
+
+    if ( (engine == FM_CRC32_ENGINE_HW) && (len >= FM_CRC32_FOLD_MIN_LEN) )
+    {
+        chunk = len & ~15;
+        crc   = Crc32FoldPclmul(crc, buf, chunk);
+        buf  += chunk;
+        len  -= chunk;
+    }
+#else
+    FM_NOT_USED(engine);
+#endif
+
+    return Crc32Slice8(fmCrc32Table, crc, buf, len);
+
+}   /* end Crc32UpdateWith */
+
+
+
+
+/*****************************************************************************/
+/** Crc32CUpdateWith
+ * \ingroup intUtil
+ *
+ * \desc            Updates a running CRC-32C with the given engine.
+ *
+ * \param[in]       engine is the engine to use.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+static fm_uint32 Crc32CUpdateWith(fm_crc32Engine  engine,
+                                  fm_uint32       crc,
+                                  const fm_byte * buf,
+                                  fm_int          len)
+{
+#ifdef FM_CRC32_HW_X86
+    if (engine == FM_CRC32_ENGINE_HW)
+    {
+        return Crc32CSse42(crc, buf, len);
+    }
+#else
+    FM_NOT_USED(engine);
+#endif
+
+    return Crc32Slice8(fmCrc32CTable, crc, buf, len);
+
+}   /* end Crc32CUpdateWith */
+
+
+
+
+/*****************************************************************************/
+/** BenchmarkCrc
+ * \ingroup intUtil
+ *
+ * \desc            Times one CRC engine over a frame. Each pass feeds the
+ *                  previous result back in as the initial register, so
+ *                  that the passes cannot be merged by the compiler.
+ *
+ * \param[in]       castagnoli is TRUE for CRC-32C, FALSE for CRC-32.
+ *
+ * \param[in]       engine is the engine to time, or
+ *                  FM_CRC32_ENGINE_UNKNOWN for the bytewise reference.
+ *
+ * \param[in]       buf points to the frame.
+ *
+ * \param[in]       len is the frame length in bytes.
+ *
+ * \param[in]       iterations is the number of times to compute the CRC.
+ *
+ * \param[out]      crc receives the CRC of the frame.
+ *
+ * \return          The elapsed time in nanoseconds.
+ *
+ *****************************************************************************/
+static fm_uint64 BenchmarkCrc(fm_bool         castagnoli,
+                              fm_crc32Engine  engine,
+                              const fm_byte * buf,
+                              fm_int          len,
+                              fm_int          iterations,
+                              fm_uint32 *     crc)
+{
+    const fm_uint32 (*table)[256];
+    fm_timestamp    start;
+    fm_timestamp    end;
+    fm_timestamp    elapsed;
+    fm_uint32       result;
+    fm_int          i;
+
+    static volatile fm_uint32 sink;
+
+    table  = castagnoli ? fmCrc32CTable : fmCrc32Table;
+    result = FM_CRC32_INIT;
+
+    for (i = 0 ; i <= iterations ; i++)
+    {
+        if (engine == FM_CRC32_ENGINE_UNKNOWN)
+        {
+            result = Crc32Bytewise(table, result, buf, len);
+        }
+        else if (castagnoli)
+        {
+            result = Crc32CUpdateWith(engine, result, buf, len);
+        }
+        else
+        {
+            result = Crc32UpdateWith(engine, result, buf, len);
+        }
+
+        /* The first pass is the untimed correctness check. */
+        if (i == 0)
+        {
+            *crc = ~result;
+            fmGetTime(&start);
+        }
+    }
+
+    fmGetTime(&end);
+    fmSubTimestamps(&end, &start, &elapsed);
+
+    sink = result;
+
+    return (elapsed.sec * 1000000 + elapsed.usec) * 1000;
+
+}   /* end BenchmarkCrc */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -219,19 +1491,7 @@ static const fm_uint32 fmCrc32CTable[] =
  *****************************************************************************/
 fm_uint32 fmCrc32(fm_byte *buf, fm_int len)
 {
-    fm_int        i;
-    fm_uint32     crc;
-
-    crc = 0xffffffffU;
-
-    for (i = 0 ; i < len ; i++)
-    {
-        crc = fmCrc32Table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
-    }
-
-    crc = ~crc;
-
-    return crc;
+    return ~fmCrc32Update(FM_CRC32_INIT, buf, len);
 
 }   /* end fmCrc32 */
 
@@ -255,17 +1515,7 @@ fm_uint32 fmCrc32(fm_byte *buf, fm_int len)
  *****************************************************************************/
 fm_uint32 fmCrc32Math(fm_byte *buf, fm_int len)
 {
-    fm_int        i;
-    fm_uint32     crc;
-
-    crc = 0;
-
-    for (i = 0 ; i < len ; i++)
-    {
-        crc = fmCrc32Table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
-    }
-
-    return crc;
+    return fmCrc32Update(0, buf, len);
 
 }   /* end fmCrc32Math */
 
@@ -288,19 +1538,338 @@ fm_uint32 fmCrc32Math(fm_byte *buf, fm_int len)
  *****************************************************************************/
 fm_uint32 fmCrc32C(fm_byte *buf, fm_int len)
 {
-    fm_int    i;
-    fm_uint32 crc;
+    return ~fmCrc32CUpdate(FM_CRC32_INIT, buf, len);
+
+}   /* end fmCrc32C */
 
-    crc = 0xffffffffU;
 
-    for (i = 0 ; i < len ; i++)
+
+
+/*****************************************************************************/
+/** fmCrc32Update
+ * \ingroup intUtil
+ *
+ * \desc            Adds a block of data to a running CRC-32. Start with
+ *                  FM_CRC32_INIT and complement the result after the last
+ *                  block to get the Ethernet FCS, so that a frame held in
+ *                  several pieces need not be copied into one.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the next block of data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+fm_uint32 fmCrc32Update(fm_uint32 crc, fm_byte *buf, fm_int len)
+{
+    if (crc32Engine == FM_CRC32_ENGINE_UNKNOWN)
     {
-        crc = fmCrc32CTable[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+        SelectEngines();
     }
 
-    crc = ~crc;
+    return Crc32UpdateWith(crc32Engine, crc, buf, len);
+
+}   /* end fmCrc32Update */
+
+
+
+
+/*****************************************************************************/
+/** fmCrc32CUpdate
+ * \ingroup intUtil
+ *
+ * \desc            Adds a block of data to a running CRC-32C. Start with
+ *                  FM_CRC32_INIT and complement the result after the last
+ *                  block.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buf points to the next block of data.
+ *
+ * \param[in]       len is the number of bytes in buf.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+fm_uint32 fmCrc32CUpdate(fm_uint32 crc, fm_byte *buf, fm_int len)
+{
+    if (crc32CEngine == FM_CRC32_ENGINE_UNKNOWN)
+    {
+        SelectEngines();
+    }
+
+    return Crc32CUpdateWith(crc32CEngine, crc, buf, len);
+
+}   /* end fmCrc32CUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fmCrc32BufferUpdate
+ * \ingroup intUtil
+ *
+ * \desc            Adds a range of a buffer chain to a running CRC-32,
+ *                  walking the chain in place.
+ *
+ * \param[in]       crc is the running CRC register.
+ *
+ * \param[in]       buffer points to the first buffer of the chain.
+ *
+ * \param[in]       offset is the byte offset into the chain at which
+ *                  to start.
+ *
+ * \param[in]       len is the number of bytes to include, or -1 to
+ *                  include everything up to the end of the chain.
+ *
+ * \return          The updated CRC register.
+ *
+ *****************************************************************************/
+fm_uint32 fmCrc32BufferUpdate(fm_uint32          crc,
+                              struct _fm_buffer *buffer,
+                              fm_int             offset,
+                              fm_int             len)
+{
+    fm_int chunk;
+
+    while ( (buffer != NULL) && (len != 0) )
+    {
+        if (offset >= buffer->len)
+        {
+            offset -= buffer->len;
+            buffer  = buffer->next;
+            continue;
+        }
+
+        chunk = buffer->len - offset;
+
+        if ( (len > 0) && (chunk > len) )
+        {
+            chunk = len;
+        }
+
+        crc = fmCrc32Update(crc, (fm_byte *) buffer->data + offset, chunk);
+
+        if (len > 0)
+        {
+            len -= chunk;
+        }
+
+        offset = 0;
+        buffer = buffer->next;
+    }
 
     return crc;
 
-}   /* end fmCrc32C */
+}   /* end fmCrc32BufferUpdate */
+
+
+
+
+/*****************************************************************************/
+/** fmCrc32Buffer
+ * \ingroup intUtil
+ *
+ * \desc            Returns the Ethernet 32-bit cyclic redundancy check
+ *                  (CRC-32) of a range of a buffer chain.
+ *
+ * \param[in]       buffer points to the first buffer of the chain.
+ *
+ * \param[in]       offset is the byte offset into the chain at which
+ *                  to start.
+ *
+ * \param[in]       len is the number of bytes to include, or -1 to
+ *                  include everything up to the end of the chain.
+ *
+ * \return          The CRC-32 value.
+ *
+ *****************************************************************************/
+fm_uint32 fmCrc32Buffer(struct _fm_buffer *buffer, fm_int offset, fm_int len)
+{
+    return ~fmCrc32BufferUpdate(FM_CRC32_INIT, buffer, offset, len);
+
+}   /* end fmCrc32Buffer */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgBenchmarkCrc32
+ * \ingroup intDiag
+ *
+ * \desc            Checks the CRC-32 and CRC-32C engines against the
+ *                  bytewise reference and times them over frame sizes
+ *                  from 64 bytes to 9 KB.
+ *
+ * \param[in]       iterations is the number of CRCs to time per frame
+ *                  size and engine.
+ *
+ * \return          FM_OK if every engine matched the reference.
+ * \return          FM_ERR_INVALID_ARGUMENT if iterations is not positive.
+ * \return          FM_ERR_NO_MEM if memory allocation failed.
+ * \return          FM_FAIL if an engine produced a wrong CRC.
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkCrc32(fm_int iterations)
+{
+    fm_byte *      frame;
+    fm_buffer *    chain;
+    fm_uint32      seed;
+    fm_uint32      reference;
+    fm_uint32      crc;
+    fm_uint64      nsec[3];
+    fm_crc32Engine engine;
+    fm_int         mismatches;
+    fm_int         size;
+    fm_int         split;
+    fm_int         numChunks;
+    fm_int         i;
+    fm_int         j;
+    fm_int         k;
+
+    static const fm_int frameSizes[] =
+    {
+        64, 128, 256, 512, 1024, 1518, 2048, 4096, 9000, 9216
+    };
+
+    static const fm_text engineNames[3] =
+    {
+        "bytewise", "slice-8 ", "hardware"
+    };
+
+    if (iterations <= 0)
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    if (crc32Engine == FM_CRC32_ENGINE_UNKNOWN ||
+        crc32CEngine == FM_CRC32_ENGINE_UNKNOWN)
+    {
+        SelectEngines();
+    }
+
+    /* Chain of 256-byte chunks covering the largest frame. */
+    numChunks = FM_CRC32_BENCH_MAX_LEN / 256;
+
+    frame = fmAlloc(FM_CRC32_BENCH_MAX_LEN + 1);
+    chain = fmAlloc( numChunks * sizeof(fm_buffer) );
+
+    if (frame == NULL || chain == NULL)
+    {
+        if (frame != NULL)
+        {
+            fmFree(frame);
+        }
+
+        if (chain != NULL)
+        {
+            fmFree(chain);
+        }
+
+        return FM_ERR_NO_MEM;
+    }
+
+    /* Start one byte in so the wide loads are unaligned, as they are for
+     * a frame following an odd-length header. */
+    seed = 0x12345678;
+    for (i = 0 ; i < FM_CRC32_BENCH_MAX_LEN + 1 ; i++)
+    {
+        seed     = seed * 1103515245 + 12345;
+        frame[i] = (fm_byte) (seed >> 16);
+    }
+
+    for (i = 0 ; i < numChunks ; i++)
+    {
+        FM_CLEAR(chain[i]);
+        chain[i].data = (fm_uint32 *) (frame + 1 + i * 256);
+        chain[i].len  = 256;
+        chain[i].next = (i + 1 < numChunks) ? &chain[i + 1] : NULL;
+    }
+
+    mismatches = 0;
+    reference  = 0;
+
+    FM_LOG_PRINT("CRC benchmark: %d iterations, CRC-32 engine %s, "
+                 "CRC-32C engine %s\n",
+                 iterations,
+                 engineNames[crc32Engine == FM_CRC32_ENGINE_HW ? 2 : 1],
+                 engineNames[crc32CEngine == FM_CRC32_ENGINE_HW ? 2 : 1]);
+
+    for (k = 0 ; k < 2 ; k++)
+    {
+        FM_LOG_PRINT("\n%-8s %6s %14s %14s %14s\n",
+                     (k == 0) ? "CRC-32" : "CRC-32C",
+                     "Bytes",
+                     "bytewise ns",
+                     "slice-8 ns",
+                     "hardware ns");
+
+        for (i = 0 ; i < (fm_int) FM_NENTRIES(frameSizes) ; i++)
+        {
+            size = frameSizes[i];
+
+            for (j = 0 ; j < 3 ; j++)
+            {
+                /* The hardware column falls back to the selected engine
+                 * on CPUs without the instructions. */
+                engine = (j == 2) ? ( (k == 0) ? crc32Engine : crc32CEngine )
+                                  : (fm_crc32Engine) j;
+
+                nsec[j] = BenchmarkCrc( (k == 1),
+                                        engine,
+                                        frame + 1,
+                                        size,
+                                        iterations,
+                                        &crc );
+
+                if (j == 0)
+                {
+                    reference = crc;
+                }
+                else if (crc != reference)
+                {
+                    FM_LOG_PRINT("  %s mismatch at %d bytes: "
+                                 "0x%08x != 0x%08x\n",
+                                 engineNames[j], size, crc, reference);
+                    mismatches++;
+                }
+            }
+
+            /* The chain walk must agree with the linear computation,
+             * including a split in the middle of a chunk. */
+            if (k == 0)
+            {
+                split = size / 2 + 3;
+                crc   = fmCrc32BufferUpdate(FM_CRC32_INIT, chain, 0, split);
+                crc   = ~fmCrc32BufferUpdate(crc, chain, split, size - split);
+
+                if (crc != reference)
+                {
+                    FM_LOG_PRINT("  buffer chain mismatch at %d bytes: "
+                                 "0x%08x != 0x%08x\n",
+                                 size, crc, reference);
+                    mismatches++;
+                }
+            }
+
+            FM_LOG_PRINT("%-8s %6d %14" FM_FORMAT_64 "u %14" FM_FORMAT_64
+                         "u %14" FM_FORMAT_64 "u\n",
+                         "",
+                         size,
+                         nsec[0] / iterations,
+                         nsec[1] / iterations,
+                         nsec[2] / iterations);
+        }
+    }
+
+    FM_LOG_PRINT("\nMismatches: %d\n", mismatches);
+
+    fmFree(chain);
+    fmFree(frame);
+
+    return (mismatches == 0) ? FM_OK : FM_FAIL;
 
+}   /* end fmDbgBenchmarkCrc32 */
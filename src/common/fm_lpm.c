@@ -0,0 +1,786 @@
+/* vim:ts=4:sw=4:expandtab
+ * (No tabs, indent level is 4 spaces)  */
+/*****************************************************************************
+ * File:            fm_lpm.c
+ * Creation Date:   October 17, 2026
+ * Description:     Multibit trie supporting longest-prefix-match lookups
+ *
+ * Copyright (c) 2015 - 2026, Intel Corporation
+ * Copyright (c) 2006 - 2012, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *     * Redistributions of source code must retain the above copyright notice,
+ *       this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of Intel Corporation nor the names of its contributors
+ *       may be used to endorse or promote products derived from this software
+ *       without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <fm_sdk_int.h>
+
+/*****************************************************************************
+ * Macros, Constants & Types
+ *****************************************************************************/
+
+/* Mask selecting the leading 'len' bits of a stride (0 <= len <= 8). */
+#define LPM_STRIDE_MASK(len) \
+    ( (fm_byte) ( ( 0xFF00 >> (len) ) & 0xFF ) )
+
+/* Initial number of prefix records allocated for a node. */
+#define LPM_INITIAL_PREFIXES    4
+
+
+/* A prefix that terminates in a node. The prefix covers the leading
+ * 'length' bits of 'bits' within the node's stride. */
+typedef struct _fm_lpmPrefix
+{
+    void *  value;
+    fm_byte bits;
+    fm_byte length;
+
+} fm_lpmPrefix;
+
+
+struct _fm_lpmNode
+{
+    /* Value of the longest prefix covering each slot, or NULL. Only
+     * allocated while prefixes terminate in this node. */
+    void **       values;
+
+    /* For each slot, the stride-relative length plus one of the prefix
+     * whose value is in the slot, or zero if the slot is empty. */
+    fm_byte *     lengths;
+
+    /* Child nodes, indexed by slot. Only allocated while the node
+     * has children. */
+    fm_lpmNode ** children;
+
+    /* Prefixes terminating in this node. Used to recompute the expanded
+     * slots when a prefix is removed. */
+    fm_lpmPrefix *prefixes;
+
+    fm_int        numPrefixes;
+    fm_int        maxPrefixes;
+    fm_int        numChildren;
+
+};
+
+
+/*****************************************************************************
+ * Global Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * FreeNode
+ *
+ * Description: Recursively frees a trie node and all of its descendants.
+ *
+ * Arguments:   trie                    pointer to the trie
+ *
+ *              node                    node to free
+ *
+ * Returns:     None
+ *
+ *****************************************************************************/
+static void FreeNode(fm_lpmTrie *trie, fm_lpmNode *node)
+{
+    fm_int slot;
+
+    if (node->children != NULL)
+    {
+        for (slot = 0 ; slot < FM_LPM_NODE_SLOTS ; slot++)
+        {
+            if (node->children[slot] != NULL)
+            {
+                FreeNode(trie, node->children[slot]);
+            }
+        }
+
+        fmFree(node->children);
+    }
+
+    if (node->values != NULL)
+    {
+        fmFree(node->values);
+        fmFree(node->lengths);
+    }
+
+    if (node->prefixes != NULL)
+    {
+        fmFree(node->prefixes);
+    }
+
+    fmFree(node);
+    trie->numNodes--;
+
+}   /* end FreeNode */
+
+
+
+
+/*****************************************************************************
+ * AllocNode
+ *
+ * Description: Allocates an empty trie node.
+ *
+ * Arguments:   trie                    pointer to the trie
+ *
+ * Returns:     Pointer to the node, or NULL if out of memory.
+ *
+ *****************************************************************************/
+static fm_lpmNode *AllocNode(fm_lpmTrie *trie)
+{
+    fm_lpmNode *node;
+
+    node = fmAlloc( sizeof(fm_lpmNode) );
+    if (node != NULL)
+    {
+        FM_MEMSET_S( node, sizeof(fm_lpmNode), 0, sizeof(fm_lpmNode) );
+        trie->numNodes++;
+    }
+
+    return node;
+
+}   /* end AllocNode */
+
+
+
+
+/*****************************************************************************
+ * PrunePath
+ *
+ * Description: Releases the storage of a node that no longer holds
+ *              prefixes or children, then frees empty nodes from the node
+ *              up towards the root.
+ *
+ * Arguments:   trie                    pointer to the trie
+ *
+ *              path                    nodes visited above the node,
+ *                                      indexed by level
+ *
+ *              key                     key used to walk the path
+ *
+ *              level                   level of the node
+ *
+ *              node                    node at which to start
+ *
+ * Returns:     None
+ *
+ *****************************************************************************/
+static void PrunePath(fm_lpmTrie *      trie,
+                      fm_lpmNode **     path,
+                      const fm_byte *   key,
+                      fm_int            level,
+                      fm_lpmNode *      node)
+{
+    if ( (node->numPrefixes == 0) && (node->values != NULL) )
+    {
+        fmFree(node->values);
+        fmFree(node->lengths);
+        node->values  = NULL;
+        node->lengths = NULL;
+    }
+
+    if ( (node->numPrefixes == 0) && (node->prefixes != NULL) )
+    {
+        fmFree(node->prefixes);
+        node->prefixes    = NULL;
+        node->maxPrefixes = 0;
+    }
+
+    if ( (node->numChildren == 0) && (node->children != NULL) )
+    {
+        fmFree(node->children);
+        node->children = NULL;
+    }
+
+    /* Free empty nodes from the bottom of the path upwards. */
+    for ( ; level >= 0 ; level--)
+    {
+        if ( (node->numPrefixes != 0) || (node->numChildren != 0) )
+        {
+            break;
+        }
+
+        FreeNode(trie, node);
+
+        if (level == 0)
+        {
+            trie->root = NULL;
+            break;
+        }
+
+        node = path[level - 1];
+        node->children[key[level - 1]] = NULL;
+
+        if (--node->numChildren == 0)
+        {
+            fmFree(node->children);
+            node->children = NULL;
+        }
+    }
+
+}   /* end PrunePath */
+
+
+
+
+/*****************************************************************************
+ * FillSlots
+ *
+ * Description: Writes a prefix value into each slot that it covers,
+ *              leaving slots that are owned by longer prefixes alone.
+ *
+ * Arguments:   node                    node on which to operate
+ *
+ *              bits                    masked stride bits of the prefix
+ *
+ *              length                  stride-relative prefix length
+ *
+ *              ownerLength             stride-relative length plus one of
+ *                                      the prefix whose slots may be
+ *                                      overwritten; slots owned by shorter
+ *                                      prefixes are always overwritten
+ *
+ *              value                   value to store, NULL to empty the
+ *                                      slots
+ *
+ *              valueLength             stride-relative length plus one to
+ *                                      record for the slots, zero if
+ *                                      value is NULL
+ *
+ * Returns:     None
+ *
+ *****************************************************************************/
+static void FillSlots(fm_lpmNode *node,
+                      fm_int      bits,
+                      fm_int      length,
+                      fm_int      ownerLength,
+                      void *      value,
+                      fm_int      valueLength)
+{
+    fm_int slot;
+    fm_int lastSlot;
+
+    lastSlot = bits + ( 1 << (FM_LPM_STRIDE - length) );
+
+    for (slot = bits ; slot < lastSlot ; slot++)
+    {
+        if (node->lengths[slot] <= ownerLength)
+        {
+            node->values[slot]  = value;
+            node->lengths[slot] = (fm_byte) valueLength;
+        }
+    }
+
+}   /* end FillSlots */
+
+
+
+
+/*****************************************************************************
+ * GetPrefixPosition
+ *
+ * Description: Computes the depth of the node in which a prefix terminates
+ *              and the prefix length relative to that node's stride.
+ *
+ * Arguments:   prefixLength            prefix length in bits
+ *
+ *              depth                   pointer to caller-allocated storage
+ *                                      where the node depth is written
+ *
+ *              length                  pointer to caller-allocated storage
+ *                                      where the stride-relative length is
+ *                                      written
+ *
+ * Returns:     None
+ *
+ *****************************************************************************/
+static void GetPrefixPosition(fm_int  prefixLength,
+                              fm_int *depth,
+                              fm_int *length)
+{
+    if (prefixLength == 0)
+    {
+        *depth  = 0;
+        *length = 0;
+    }
+    else
+    {
+        *depth  = (prefixLength - 1) / FM_LPM_STRIDE;
+        *length = prefixLength - (*depth * FM_LPM_STRIDE);
+    }
+
+}   /* end GetPrefixPosition */
+
+
+
+
+/*****************************************************************************
+ * Public Functions
+ *****************************************************************************/
+
+
+/*****************************************************************************/
+/** fmLpmInit
+ * \ingroup intLpm
+ *
+ * \desc            Initializes a user-supplied ''fm_lpmTrie'' structure to
+ *                  represent an empty longest-prefix-match table.
+ *
+ * \param[out]      trie is the trie on which to operate.
+ *
+ * \param[in]       keyBits is the key length in bits. It must be a
+ *                  multiple of 8 no larger than FM_LPM_MAX_KEY_BITS.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ *
+ *****************************************************************************/
+fm_status fmLpmInit(fm_lpmTrie *trie, fm_int keyBits)
+{
+    if ( (trie == NULL)
+        || (keyBits <= 0)
+        || (keyBits > FM_LPM_MAX_KEY_BITS)
+        || ( (keyBits % 8) != 0 ) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    FM_MEMSET_S( trie, sizeof(fm_lpmTrie), 0, sizeof(fm_lpmTrie) );
+
+    trie->keyBits  = keyBits;
+    trie->keyBytes = keyBits / 8;
+
+    return FM_OK;
+
+}   /* end fmLpmInit */
+
+
+
+
+/*****************************************************************************/
+/** fmLpmDestroy
+ * \ingroup intLpm
+ *
+ * \desc            Releases all memory held by a trie. The values stored
+ *                  in the trie are not freed. The trie is left empty and
+ *                  may be reused.
+ *
+ * \param[in]       trie is the trie on which to operate.
+ *
+ * \return          None
+ *
+ *****************************************************************************/
+void fmLpmDestroy(fm_lpmTrie *trie)
+{
+    if ( (trie != NULL) && (trie->root != NULL) )
+    {
+        FreeNode(trie, trie->root);
+        trie->root        = NULL;
+        trie->numPrefixes = 0;
+    }
+
+}   /* end fmLpmDestroy */
+
+
+
+
+/*****************************************************************************/
+/** fmLpmInsert
+ * \ingroup intLpm
+ *
+ * \desc            Adds a prefix to the trie. If the prefix is already
+ *                  present its value is replaced.
+ *
+ * \param[in]       trie is the trie on which to operate.
+ *
+ * \param[in]       key points to the key, most significant byte first.
+ *                  Bits beyond prefixLength are ignored.
+ *
+ * \param[in]       prefixLength is the number of leading key bits that
+ *                  make up the prefix.
+ *
+ * \param[in]       value is the value to associate with the prefix. It
+ *                  must not be NULL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ *
+ *****************************************************************************/
+fm_status fmLpmInsert(fm_lpmTrie *   trie,
+                      const fm_byte *key,
+                      fm_int         prefixLength,
+                      void *         value)
+{
+    fm_lpmNode *  path[FM_LPM_MAX_KEY_BYTES];
+    fm_lpmNode *  node;
+    fm_lpmNode *  child;
+    fm_lpmPrefix *prefixes;
+    fm_int        depth;
+    fm_int        length;
+    fm_int        bits;
+    fm_int        level;
+    fm_int        i;
+
+    if ( (trie == NULL)
+        || (key == NULL)
+        || (value == NULL)
+        || (prefixLength < 0)
+        || (prefixLength > trie->keyBits) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    GetPrefixPosition(prefixLength, &depth, &length);
+
+    if (trie->root == NULL)
+    {
+        trie->root = AllocNode(trie);
+        if (trie->root == NULL)
+        {
+            return FM_ERR_NO_MEM;
+        }
+    }
+
+    /* Walk down to the node in which the prefix terminates, creating
+     * nodes as needed. Nodes created here are freed again on failure. */
+    node = trie->root;
+
+    for (level = 0 ; level < depth ; level++)
+    {
+        path[level] = node;
+
+        if (node->children == NULL)
+        {
+            node->children = fmAlloc(FM_LPM_NODE_SLOTS * sizeof(fm_lpmNode *));
+            if (node->children == NULL)
+            {
+                PrunePath(trie, path, key, level, node);
+                return FM_ERR_NO_MEM;
+            }
+
+            FM_MEMSET_S( node->children,
+                         FM_LPM_NODE_SLOTS * sizeof(fm_lpmNode *),
+                         0,
+                         FM_LPM_NODE_SLOTS * sizeof(fm_lpmNode *) );
+        }
+
+        child = node->children[key[level]];
+
+        if (child == NULL)
+        {
+            child = AllocNode(trie);
+            if (child == NULL)
+            {
+                PrunePath(trie, path, key, level, node);
+                return FM_ERR_NO_MEM;
+            }
+
+            node->children[key[level]] = child;
+            node->numChildren++;
+        }
+
+        node = child;
+    }
+
+    bits = key[depth] & LPM_STRIDE_MASK(length);
+
+    /* Replace the value of an existing prefix. */
+    for (i = 0 ; i < node->numPrefixes ; i++)
+    {
+        if ( (node->prefixes[i].length == length)
+            && (node->prefixes[i].bits == bits) )
+        {
+            node->prefixes[i].value = value;
+            FillSlots(node, bits, length, length + 1, value, length + 1);
+            return FM_OK;
+        }
+    }
+
+    if (node->values == NULL)
+    {
+        node->values  = fmAlloc(FM_LPM_NODE_SLOTS * sizeof(void *));
+        node->lengths = fmAlloc(FM_LPM_NODE_SLOTS * sizeof(fm_byte));
+
+        if ( (node->values == NULL) || (node->lengths == NULL) )
+        {
+            if (node->values != NULL)
+            {
+                fmFree(node->values);
+                node->values = NULL;
+            }
+
+            if (node->lengths != NULL)
+            {
+                fmFree(node->lengths);
+                node->lengths = NULL;
+            }
+
+            PrunePath(trie, path, key, depth, node);
+            return FM_ERR_NO_MEM;
+        }
+
+        FM_MEMSET_S( node->values,
+                     FM_LPM_NODE_SLOTS * sizeof(void *),
+                     0,
+                     FM_LPM_NODE_SLOTS * sizeof(void *) );
+        FM_MEMSET_S( node->lengths,
+                     FM_LPM_NODE_SLOTS * sizeof(fm_byte),
+                     0,
+                     FM_LPM_NODE_SLOTS * sizeof(fm_byte) );
+    }
+
+    if (node->numPrefixes >= node->maxPrefixes)
+    {
+        i = (node->maxPrefixes == 0) ? LPM_INITIAL_PREFIXES
+                                     : (node->maxPrefixes * 2);
+
+        prefixes = fmAlloc( i * sizeof(fm_lpmPrefix) );
+        if (prefixes == NULL)
+        {
+            PrunePath(trie, path, key, depth, node);
+            return FM_ERR_NO_MEM;
+        }
+
+        if (node->prefixes != NULL)
+        {
+            FM_MEMCPY_S( prefixes,
+                         i * sizeof(fm_lpmPrefix),
+                         node->prefixes,
+                         node->numPrefixes * sizeof(fm_lpmPrefix) );
+            fmFree(node->prefixes);
+        }
+
+        node->prefixes    = prefixes;
+        node->maxPrefixes = i;
+    }
+
+    prefixes         = &node->prefixes[node->numPrefixes++];
+    prefixes->value  = value;
+    prefixes->bits   = (fm_byte) bits;
+    prefixes->length = (fm_byte) length;
+
+    /* Expand the prefix into every slot not owned by a longer prefix. */
+    FillSlots(node, bits, length, length, value, length + 1);
+
+    trie->numPrefixes++;
+
+    return FM_OK;
+
+}   /* end fmLpmInsert */
+
+
+
+
+/*****************************************************************************/
+/** fmLpmRemove
+ * \ingroup intLpm
+ *
+ * \desc            Removes a prefix from the trie. Slots covered by the
+ *                  prefix revert to the next longest prefix in the same
+ *                  node, and nodes left empty are freed.
+ *
+ * \param[in]       trie is the trie on which to operate.
+ *
+ * \param[in]       key points to the key, most significant byte first.
+ *                  Bits beyond prefixLength are ignored.
+ *
+ * \param[in]       prefixLength is the number of leading key bits that
+ *                  make up the prefix.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NOT_FOUND if the prefix is not in the trie.
+ *
+ *****************************************************************************/
+fm_status fmLpmRemove(fm_lpmTrie *trie, const fm_byte *key, fm_int prefixLength)
+{
+    fm_lpmNode *  path[FM_LPM_MAX_KEY_BYTES];
+    fm_lpmNode *  node;
+    fm_lpmPrefix *prefix;
+    void *        value;
+    fm_int        valueLength;
+    fm_int        depth;
+    fm_int        length;
+    fm_int        bits;
+    fm_int        level;
+    fm_int        i;
+
+    if ( (trie == NULL)
+        || (key == NULL)
+        || (prefixLength < 0)
+        || (prefixLength > trie->keyBits) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    GetPrefixPosition(prefixLength, &depth, &length);
+
+    node = trie->root;
+
+    for (level = 0 ; (node != NULL) && (level < depth) ; level++)
+    {
+        path[level] = node;
+        node = (node->children != NULL) ? node->children[key[level]] : NULL;
+    }
+
+    if (node == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    bits = key[depth] & LPM_STRIDE_MASK(length);
+
+    for (i = 0 ; i < node->numPrefixes ; i++)
+    {
+        if ( (node->prefixes[i].length == length)
+            && (node->prefixes[i].bits == bits) )
+        {
+            break;
+        }
+    }
+
+    if (i >= node->numPrefixes)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    node->prefixes[i] = node->prefixes[--node->numPrefixes];
+    trie->numPrefixes--;
+
+    /* Any shorter prefix in this node that covers one slot of the removed
+     * prefix covers all of them, so a single replacement is enough. */
+    value       = NULL;
+    valueLength = 0;
+
+    for (i = 0 ; i < node->numPrefixes ; i++)
+    {
+        prefix = &node->prefixes[i];
+
+        if ( (prefix->length < length)
+            && (prefix->length + 1 > valueLength)
+            && ( (bits & LPM_STRIDE_MASK(prefix->length)) == prefix->bits ) )
+        {
+            value       = prefix->value;
+            valueLength = prefix->length + 1;
+        }
+    }
+
+    FillSlots(node, bits, length, length + 1, value, valueLength);
+
+    PrunePath(trie, path, key, depth, node);
+
+    return FM_OK;
+
+}   /* end fmLpmRemove */
+
+
+
+
+/*****************************************************************************/
+/** fmLpmLookup
+ * \ingroup intLpm
+ *
+ * \desc            Finds the longest prefix in the trie that matches a key.
+ *                  The lookup visits at most one node per FM_LPM_STRIDE
+ *                  bits of key.
+ *
+ * \param[in]       trie is the trie on which to operate.
+ *
+ * \param[in]       key points to the key, most significant byte first.
+ *
+ * \param[out]      value points to caller-allocated storage where the
+ *                  value of the matching prefix is written.
+ *
+ * \param[out]      prefixLength points to caller-allocated storage where
+ *                  the length of the matching prefix is written. May be
+ *                  NULL.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NOT_FOUND if no prefix matches the key.
+ *
+ *****************************************************************************/
+fm_status fmLpmLookup(const fm_lpmTrie *trie,
+                      const fm_byte *   key,
+                      void **           value,
+                      fm_int *          prefixLength)
+{
+    const fm_lpmNode *node;
+    void *            bestValue;
+    fm_int            bestLength;
+    fm_int            level;
+    fm_byte           slot;
+
+    if ( (trie == NULL) || (key == NULL) || (value == NULL) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    bestValue  = NULL;
+    bestLength = 0;
+    node       = trie->root;
+
+    for (level = 0 ; (node != NULL) && (level < trie->keyBytes) ; level++)
+    {
+        slot = key[level];
+
+        if ( (node->lengths != NULL) && (node->lengths[slot] != 0) )
+        {
+            bestValue  = node->values[slot];
+            bestLength = (level * FM_LPM_STRIDE) + node->lengths[slot] - 1;
+        }
+
+        node = (node->children != NULL) ? node->children[slot] : NULL;
+    }
+
+    if (bestValue == NULL)
+    {
+        return FM_ERR_NOT_FOUND;
+    }
+
+    *value = bestValue;
+
+    if (prefixLength != NULL)
+    {
+        *prefixLength = bestLength;
+    }
+
+    return FM_OK;
+
+}   /* end fmLpmLookup */
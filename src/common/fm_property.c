@@ -47,6 +47,83 @@
 
 #define TFSTR(x)      (x)?"true":"false"
 
+/* Property structure holding the value of a property. */
+#define PROPERTY_SET_COMMON         0
+#define PROPERTY_SET_FM10000        1
+
+#define PROPERTY_STRUCT_COMMON      fm_property
+#define PROPERTY_STRUCT_FM10000     fm10000_property
+
+/* Builds a property descriptor from the FM_AAK_ and FM_AAD_ definitions
+ * of the property and the field of the property structure holding it. */
+#define PROPERTY_DESC(set, field, name, type, tlvType, flag, defInt, defText, hex) \
+    { FM_AAK_##name,                                                        \
+      type,                                                                 \
+      tlvType,                                                              \
+      PROPERTY_SET_##set,                                                   \
+      offsetof(PROPERTY_STRUCT_##set, field),                               \
+      sizeof( ( (PROPERTY_STRUCT_##set *) 0 )->field ),                     \
+      flag,                                                                 \
+      defInt,                                                               \
+      defText,                                                              \
+      hex }
+
+#define PROPERTY_INT(set, field, name, tlvType)                             \
+    PROPERTY_DESC(set, field, name, FM_API_ATTR_INT, tlvType,               \
+                  0, FM_AAD_##name, NULL, FALSE)
+
+#define PROPERTY_HEX(set, field, name, tlvType)                             \
+    PROPERTY_DESC(set, field, name, FM_API_ATTR_INT, tlvType,               \
+                  0, FM_AAD_##name, NULL, TRUE)
+
+#define PROPERTY_BOOL(set, field, name, tlvType)                            \
+    PROPERTY_DESC(set, field, name, FM_API_ATTR_BOOL, tlvType,              \
+                  0, FM_AAD_##name, NULL, FALSE)
+
+#define PROPERTY_TEXT(set, field, name, tlvType)                            \
+    PROPERTY_DESC(set, field, name, FM_API_ATTR_TEXT, tlvType,              \
+                  0, 0, FM_AAD_##name, FALSE)
+
+/* Boolean property stored as one value of an integer field. */
+#define PROPERTY_FLAG(set, field, name, tlvType, flag)                      \
+    PROPERTY_DESC(set, field, name, FM_API_ATTR_BOOL, tlvType,              \
+                  flag, FM_AAD_##name, NULL, FALSE)
+
+#define NUM_PROPERTIES              ( (fm_int) FM_NENTRIES(propertyTable) )
+
+
+/* Describes where and how an API property is stored. */
+typedef struct _fm_propertyDesc
+{
+    /* Dotted key string of the property. */
+    fm_text        key;
+
+    /* Type of the property, see ''fm_apiAttrType''. */
+    fm_apiAttrType type;
+
+    /* TLV type used to load the property from a configuration file. */
+    fm_uint        tlvType;
+
+    /* Property structure holding the value, see PROPERTY_SET_xxx. */
+    fm_int         set;
+
+    /* Offset and size of the value within the property structure. */
+    fm_uint        offset;
+    fm_uint        size;
+
+    /* For Boolean properties sharing an integer field, the value stored in
+     * the field when the property is TRUE. Zero for all other properties. */
+    fm_int         flagValue;
+
+    /* Default value. defText is used for text properties only. */
+    fm_int         defInt;
+    fm_text        defText;
+
+    /* Whether the value is dumped in hexadecimal. */
+    fm_bool        hex;
+
+} fm_propertyDesc;
+
 
 
 /*****************************************************************************
@@ -57,6 +134,337 @@
  * Local Variables
  *****************************************************************************/
 
+/* Descriptors of all API properties, in enumeration and dump order. The
+ * key and TLV type hash indexes in fmRootAlos refer to entries of this
+ * table by position. */
+static const fm_propertyDesc propertyTable[] =
+{
+    PROPERTY_INT(COMMON, defStateVlanMember, API_STP_DEF_STATE_VLAN_MEMBER,
+                 FM_TLV_API_STP_DEF_VLAN_MEMBER),
+    PROPERTY_BOOL(COMMON, directSendToCpu, API_DIRECT_SEND_TO_CPU,
+                  FM_TLV_API_DIR_SEND_TO_CPU),
+    PROPERTY_INT(COMMON, defStateVlanNonMember, API_STP_DEF_STATE_VLAN_NON_MEMBER,
+                 FM_TLV_API_STP_DEF_VLAN_NON_MEMBER),
+    PROPERTY_BOOL(COMMON, bootIdentifySw, DEBUG_BOOT_IDENTIFYSWITCH,
+                  FM_TLV_API_IDENTIFY_SWITCH),
+    PROPERTY_BOOL(COMMON, bootReset, DEBUG_BOOT_RESET,
+                  FM_TLV_API_BOOT_RESET),
+    PROPERTY_BOOL(COMMON, autoInsertSwitches, DEBUG_BOOT_AUTOINSERTSWITCH,
+                  FM_TLV_API_AUTO_INSERT_SW),
+    PROPERTY_INT(COMMON, deviceResetTime, API_BOOT_RESET_TIME,
+                 FM_TLV_API_DEV_RESET_TIME),
+    PROPERTY_BOOL(COMMON, swagAutoEnableLinks, API_AUTO_ENABLE_SWAG_LINKS,
+                  FM_TLV_API_SWAG_EN_LINK),
+    PROPERTY_INT(COMMON, eventBlockThreshold, API_FREE_EVENT_BLOCK_THRESHOLD,
+                 FM_TLV_API_EVENT_BLK_THRESHOLD),
+    PROPERTY_INT(COMMON, eventUnblockThreshold, API_FREE_EVENT_UNBLOCK_THRESHOLD,
+                 FM_TLV_API_EVENT_UNBLK_THRESHOLD),
+    PROPERTY_INT(COMMON, eventSemTimeout, API_EVENT_SEM_TIMEOUT,
+                 FM_TLV_API_EVENT_SEM_TIMEOUT),
+    PROPERTY_BOOL(COMMON, rxDirectEnqueueing, API_PACKET_RX_DIRECT_ENQUEUEING,
+                  FM_TLV_API_RX_DIRECTED_ENQ),
+    PROPERTY_INT(COMMON, rxDriverDestinations, API_PACKET_RX_DRV_DEST,
+                 FM_TLV_API_RX_DRV_DEST),
+    PROPERTY_BOOL(COMMON, lagAsyncDeletion, API_ASYNC_LAG_DELETION,
+                  FM_TLV_API_LAG_ASYNC_DEL),
+    PROPERTY_BOOL(COMMON, maEventOnStaticAddr, API_MA_EVENT_ON_STATIC_ADDR,
+                  FM_TLV_API_EVENT_ON_STATIC_ADDR),
+    PROPERTY_BOOL(COMMON, maEventOnDynAddr, API_MA_EVENT_ON_DYNAMIC_ADDR,
+                  FM_TLV_API_EVENT_ON_DYN_ADDR),
+    PROPERTY_BOOL(COMMON, maEventOnAddrChange, API_MA_EVENT_ON_ADDR_CHANGE,
+                  FM_TLV_API_EVENT_ON_ADDR_CHG),
+    PROPERTY_BOOL(COMMON, maFlushOnPortDown, API_MA_FLUSH_ON_PORT_DOWN,
+                  FM_TLV_API_FLUSH_ON_PORT_DOWN),
+    PROPERTY_BOOL(COMMON, maFlushOnVlanChange, API_MA_FLUSH_ON_VLAN_CHANGE,
+                  FM_TLV_API_FLUSH_ON_VLAN_CHG),
+    PROPERTY_BOOL(COMMON, maFlushOnLagChange, API_MA_FLUSH_ON_LAG_CHANGE,
+                  FM_TLV_API_FLUSH_ON_LAG_CHG),
+    PROPERTY_INT(COMMON, maTcnFifoBurstSize, API_MA_TCN_FIFO_BURST_SIZE,
+                 FM_TLV_API_TCN_FIFO_BURST_SIZE),
+    PROPERTY_BOOL(COMMON, swagIntVlanStats, API_SWAG_INTERNAL_VLAN_STATS,
+                  FM_TLV_API_SWAG_INT_VLAN_STATS),
+    PROPERTY_BOOL(COMMON, perLagManagement, API_PER_LAG_MANAGEMENT,
+                  FM_TLV_API_PER_LAG_MGMT),
+    PROPERTY_BOOL(COMMON, parityRepairEnable, API_PARITY_REPAIR_ENABLE,
+                  FM_TLV_API_PARITY_REPAIR_EN),
+    PROPERTY_INT(COMMON, swagMaxAclPortSets, API_SWAG_MAX_ACL_PORT_SETS,
+                 FM_TLV_API_SWAG_MAX_ACL_PORT_SET),
+    PROPERTY_INT(COMMON, maxPortSets, API_MAX_PORT_SETS,
+                 FM_TLV_API_MAX_PORT_SETS),
+    PROPERTY_BOOL(COMMON, packetReceiveEnable, API_PACKET_RECEIVE_ENABLE,
+                  FM_TLV_API_PKT_RX_EN),
+    PROPERTY_BOOL(COMMON, multicastSingleAddress, API_1_ADDR_PER_MCAST_GROUP,
+                  FM_TLV_API_MC_SINGLE_ADDR),
+    PROPERTY_INT(COMMON, modelPosition, API_PLATFORM_MODEL_POSITION,
+                 FM_TLV_API_PLAT_MODEL_POS),
+    PROPERTY_INT(COMMON, vnNumNextHops, API_NUM_VN_TUNNEL_NEXTHOPS,
+                 FM_TLV_API_VN_NUM_NH),
+    PROPERTY_INT(COMMON, vnEncapProtocol, API_VN_ENCAP_PROTOCOL,
+                 FM_TLV_API_VN_ENCAP_PROTOCOL),
+    PROPERTY_INT(COMMON, vnEncapVersion, API_VN_ENCAP_VERSION,
+                 FM_TLV_API_VN_ENCAP_VER),
+    PROPERTY_BOOL(COMMON, supportRouteLookups, API_SUPPORT_ROUTE_LOOKUPS,
+                  FM_TLV_API_SUP_ROUTE_LOOKUP),
+    PROPERTY_BOOL(COMMON, routeMaintenanceEnable, API_ROUTING_MAINTENANCE_ENABLE,
+                  FM_TLV_API_RT_MAINT_EN),
+    PROPERTY_BOOL(COMMON, autoVlan2Tagging, API_AUTO_VLAN2_TAGGING,
+                  FM_TLV_API_AUTO_VLAN2_TAG),
+    PROPERTY_BOOL(COMMON, interruptHandlerDisable, DEBUG_BOOT_INTERRUPT_HANDLER,
+                  FM_TLV_API_INTR_HANDLER_DIS),
+    PROPERTY_BOOL(COMMON, maTableMaintenanceEnable, API_MA_TABLE_MAINTENENANCE_ENABLE,
+                  FM_TLV_API_MA_TABLE_MAINT_EN),
+    PROPERTY_BOOL(COMMON, fastMaintenanceEnable, API_FAST_MAINTENANCE_ENABLE,
+                  FM_TLV_API_FAST_MAINT_EN),
+    PROPERTY_INT(COMMON, fastMaintenancePer, API_FAST_MAINTENANCE_PERIOD,
+                 FM_TLV_API_FAST_MAINT_PER),
+    PROPERTY_INT(COMMON, statsCollectorPer, API_STATS_COLLECTOR_PERIOD,
+                 FM_TLV_API_STATS_COLLECTOR_PER),
+    PROPERTY_BOOL(COMMON, strictGlotPhysical, API_STRICT_GLORT_PHYSICAL,
+                  FM_TLV_API_STRICT_GLORT),
+    PROPERTY_BOOL(COMMON, resetWmAtPauseOff, API_RESET_WATERMARK_AT_PAUSE_OFF,
+                  FM_TLV_API_AUTO_RESET_WM),
+    PROPERTY_BOOL(COMMON, swagAutoSubSwitches, API_SWAG_AUTO_SUB_SWITCHES,
+                  FM_TLV_API_AUTO_SUB_SW),
+    PROPERTY_BOOL(COMMON, swagAutoIntPorts, API_SWAG_AUTO_INTERNAL_PORTS,
+                  FM_TLV_API_SWAG_AUTO_INT_PORT),
+    PROPERTY_BOOL(COMMON, swagAutoVNVsi, API_SWAG_AUTO_VN_VSI,
+                  FM_TLV_API_SWAG_AUTO_NVVSI),
+    PROPERTY_BOOL(COMMON, byPassEnable, API_PLATFORM_BYPASS_ENABLE,
+                  FM_TLV_API_PLAT_BYPASS_EN),
+    PROPERTY_INT(COMMON, lagDelSemTimeout, API_LAG_DELETE_SEMAPHORE_TIMEOUT,
+                 FM_TLV_API_LAG_DEL_SEM_TIMEOUT),
+    PROPERTY_BOOL(COMMON, stpEnIntPortCtrl, API_STP_ENABLE_INTERNAL_PORT_CTRL,
+                  FM_TLV_API_STP_EN_INT_PORT_CTRL),
+    PROPERTY_INT(COMMON, modelPortMapType, API_PLATFORM_MODEL_PORT_MAP_TYPE,
+                 FM_TLV_API_MODEL_PORT_MAP_TYPE),
+    PROPERTY_TEXT(COMMON, modelSwitchType, API_PLATFORM_MODEL_SWITCH_TYPE,
+                  FM_TLV_API_MODEL_SW_TYPE),
+    PROPERTY_BOOL(COMMON, modelSendEOT, API_PLATFORM_MODEL_SEND_EOT,
+                  FM_TLV_API_MODEL_TX_EOT),
+    PROPERTY_BOOL(COMMON, modelLogEgressInfo, API_PLATFORM_MODEL_LOG_EGRESS_INFO,
+                  FM_TLV_API_MODEL_LOG_EGR_INFO),
+    PROPERTY_BOOL(COMMON, enableRefClock, API_PLATFORM_ENABLE_REF_CLOCK,
+                  FM_TLV_API_PLAT_EN_REF_CLK),
+    PROPERTY_BOOL(COMMON, setRefClock, API_PLATFORM_SET_REF_CLOCK,
+                  FM_TLV_API_PLAT_SET_REF_CLK),
+    PROPERTY_BOOL(COMMON, priorityBufQueues, API_PLATFORM_PRIORITY_BUFFER_QUEUES,
+                  FM_TLV_API_PLAT_PRI_BUF_Q),
+    PROPERTY_INT(COMMON, pktSchedType, API_PLATFORM_PKT_SCHED_TYPE,
+                 FM_TLV_API_PLAT_PKT_SCHED_TYPE),
+    PROPERTY_BOOL(COMMON, separateBufPoolEnable, API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE,
+                  FM_TLV_API_PLAT_SEP_BUF_POOL),
+    PROPERTY_INT(COMMON, numBuffersRx, API_PLATFORM_NUM_BUFFERS_RX,
+                 FM_TLV_API_PLAT_NUM_BUF_RX),
+    PROPERTY_INT(COMMON, numBuffersTx, API_PLATFORM_NUM_BUFFERS_TX,
+                 FM_TLV_API_PLAT_NUM_BUF_TX),
+    PROPERTY_TEXT(COMMON, modelPktInterface, API_PLATFORM_MODEL_PKT_INTERFACE,
+                  FM_TLV_API_PLAT_MODEL_PKT_INTF),
+    PROPERTY_TEXT(COMMON, pktInterface, API_PLATFORM_PKT_INTERFACE,
+                  FM_TLV_API_PLAT_PKT_INTF),
+    PROPERTY_INT(COMMON, rawSocketRxBatchSize, API_PLATFORM_RAW_SOCKET_RX_BATCH,
+                 FM_TLV_API_RAW_SOCKET_RX_BATCH),
+    PROPERTY_INT(COMMON, rawSocketTxBatchSize, API_PLATFORM_RAW_SOCKET_TX_BATCH,
+                 FM_TLV_API_RAW_SOCKET_TX_BATCH),
+    PROPERTY_BOOL(COMMON, rawSocketMmapRing, API_PLATFORM_RAW_SOCKET_MMAP_RING,
+                  FM_TLV_API_RAW_SOCKET_MMAP_RING),
+    PROPERTY_INT(COMMON, rawSocketRingBlocks, API_PLATFORM_RAW_SOCKET_RING_BLOCKS,
+                 FM_TLV_API_RAW_SOCKET_RING_BLOCKS),
+    PROPERTY_INT(COMMON, pktTxClassMaxDepth, API_PLATFORM_PKT_TX_CLASS_DEPTH,
+                 FM_TLV_API_PKT_TX_CLASS_DEPTH),
+    PROPERTY_TEXT(COMMON, modelTopologyName, API_PLATFORM_MODEL_TOPOLOGY_NAME,
+                  FM_TLV_API_PLAT_MODEL_TOPO),
+    PROPERTY_BOOL(COMMON, modelUseModelPath, API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH,
+                  FM_TLV_API_PLAT_MODEL_USE_PATH),
+    PROPERTY_TEXT(COMMON, modelDevBoardIp, API_PLATFORM_MODEL_DEV_BOARD_IP,
+                  FM_TLV_API_PLAT_DEV_BOARD_IP),
+    PROPERTY_INT(COMMON, modelDevBoardPort, API_PLATFORM_MODEL_DEV_BOARD_PORT,
+                 FM_TLV_API_PLAT_DEV_BOARD_PORT),
+    PROPERTY_INT(COMMON, modelDeviceCfg, API_PLATFORM_MODEL_DEVICE_CFG,
+                 FM_TLV_API_PLAT_MODEL_DEVICE_CFG),
+    PROPERTY_INT(COMMON, modelChipVersion, API_PLATFORM_MODEL_CHIP_VERSION,
+                 FM_TLV_API_PLAT_MODEL_CHIP_VERSION),
+    PROPERTY_INT(COMMON, sbusServerPort, API_PLATFORM_SBUS_SERVER_PORT,
+                 FM_TLV_API_PLAT_SBUS_SERVER_PORT),
+    PROPERTY_BOOL(COMMON, isWhiteModel, API_PLATFORM_IS_WHITE_MODEL,
+                  FM_TLV_API_PLAT_IS_WHITE_MODEL),
+    PROPERTY_TEXT(COMMON, initLoggingCat, API_DEBUG_INIT_LOGGING_CAT,
+                  FM_TLV_API_DBG_INT_LOG_CAT),
+    PROPERTY_BOOL(COMMON, addPepsToFlooding, API_PORT_ADD_PEPS_TO_FLOODING,
+                  FM_TLV_API_ADD_PEP_FLOOD),
+    PROPERTY_BOOL(COMMON, allowFtagVlanTagging, API_PORT_ALLOW_FTAG_VLAN_TAGGING,
+                  FM_TLV_API_ADD_ALLOW_FTAG_VLAN_TAG),
+    PROPERTY_FLAG(COMMON, ignoreBwViolation, API_SCH_IGNORE_BW_VIOLATION,
+                  FM_TLV_API_IGNORE_BW_VIOLATION, 1),
+    PROPERTY_FLAG(COMMON, ignoreBwViolation, API_SCH_IGNORE_BW_VIOLATION_NO_WARNING,
+                  FM_TLV_API_IGNORE_BW_VIOLATION_NW, 2),
+    PROPERTY_BOOL(COMMON, dfeAllowEarlyLinkUp, API_DFE_ALLOW_EARLY_LINK_UP_MODE,
+                  FM_TLV_API_DFE_EARLY_LNK_UP),
+    PROPERTY_BOOL(COMMON, dfeAllowKrPcal, API_DFE_ALLOW_KR_PCAL_MODE,
+                  FM_TLV_API_DFE_ALLOW_KR_PCAL),
+    PROPERTY_BOOL(COMMON, dfeEnableSigOkDebounce, API_DFE_ENABLE_SIGNALOK_DEBOUNCING,
+                  FM_TLV_API_DFE_ENABLE_SIGNALOK_DEBOUNCING),
+    PROPERTY_BOOL(COMMON, enableStatusPolling, API_PORT_ENABLE_STATUS_POLLING,
+                  FM_TLV_API_PORT_ENABLE_STATUS_POLLING),
+    PROPERTY_INT(COMMON, gsmeTimestampMode, API_GSME_TIMESTAMP_MODE,
+                 FM_TLV_API_GSME_TS_MODE),
+    PROPERTY_BOOL(COMMON, hniMcastFlooding, API_MULTICAST_HNI_FLOODING,
+                  FM_TLV_API_MC_HNI_FLOODING),
+    PROPERTY_INT(COMMON, hniMacEntriesPerPep, API_HNI_MAC_ENTRIES_PER_PEP,
+                 FM_TLV_API_HNI_MAC_ENTRIES_PER_PEP),
+    PROPERTY_INT(COMMON, hniMacEntriesPerPort, API_HNI_MAC_ENTRIES_PER_PORT,
+                 FM_TLV_API_HNI_MAC_ENTRIES_PER_PORT),
+    PROPERTY_INT(COMMON, hniInnOutEntriesPerPep, API_HNI_INN_OUT_ENTRIES_PER_PEP,
+                 FM_TLV_API_HNI_INN_OUT_ENTRIES_PER_PEP),
+    PROPERTY_INT(COMMON, hniInnOutEntriesPerPort, API_HNI_INN_OUT_ENTRIES_PER_PORT,
+                 FM_TLV_API_HNI_INN_OUT_ENTRIES_PER_PORT),
+    PROPERTY_BOOL(COMMON, anTimerAllowOutSpec, API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC,
+                  FM_TLV_API_AN_TIMER_ALLOW_OUT_SPEC),
+    PROPERTY_BOOL(COMMON, serdesValidate, API_SERDES_VALIDATE,
+                  FM_TLV_API_SERDES_VALIDATE),
+    PROPERTY_BOOL(COMMON, sbmasterValidate, API_SBM_VALIDATE,
+                  FM_TLV_API_SBMASTER_VALIDATE),
+    PROPERTY_BOOL(COMMON, serdesErrActionUpState, API_SERDES_ACTION_IN_UP_STATE,
+                  FM_TVL_API_SERDES_ACTION_UP_ALLOWED),
+    PROPERTY_INT(COMMON, serdesValidateTimer, API_SERDES_VALIDATE_TIMER,
+                 FM_TVL_API_SERDES_VALIDATE_TIMER),
+    PROPERTY_INT(COMMON, hniFlowEntriesPerVf, API_HNI_FLOW_ENTRIES_VF,
+                 FM_TLV_API_HNI_FLOW_ENTRIES_PER_VF),
+    PROPERTY_BOOL(COMMON, cpuPortXCastMode, API_CPU_PORT_XCAST_MODE,
+                  FM_TLV_API_CPU_PORT_XCAST_MODE),
+    PROPERTY_INT(COMMON, hniGlortsPerPep, API_HNI_GLORTS_PER_PEP,
+                 FM_TLV_API_HNI_GLORTS_PER_PEP),
+#if defined(FM_SUPPORT_FM10000)
+    PROPERTY_TEXT(FM10000, wmSelect, API_FM10000_WMSELECT,
+                  FM_TLV_FM10K_WMSELECT),
+    PROPERTY_INT(FM10000, cmRxSmpPrivBytes, API_FM10000_CM_RX_SMP_PRIVATE_BYTES,
+                 FM_TLV_FM10K_CM_RX_SMP_PRIVATE_BYTES),
+    PROPERTY_INT(FM10000, cmTxTcHogBytes, API_FM10000_CM_TX_TC_HOG_BYTES,
+                 FM_TLV_FM10K_CM_TX_TC_HOG_BYTES),
+    PROPERTY_INT(FM10000, cmSmpSdVsHogPercent, API_FM10000_CM_SMP_SD_VS_HOG_PERCENT,
+                 FM_TLV_FM10K_CM_SMP_SD_VS_HOG_PERCENT),
+    PROPERTY_INT(FM10000, cmSmpSdJitterBits, API_FM10000_CM_SMP_SD_JITTER_BITS,
+                 FM_TLV_FM10K_CM_SMP_SD_JITTER_BITS),
+    PROPERTY_BOOL(FM10000, cmTxSdOnPrivate, API_FM10000_CM_TX_SD_ON_PRIVATE,
+                  FM_TLV_FM10K_CM_TX_SD_ON_PRIVATE),
+    PROPERTY_BOOL(FM10000, cmTxSdOnSmpFree, API_FM10000_CM_TX_SD_ON_SMP_FREE,
+                  FM_TLV_FM10K_CM_TX_SD_ON_SMP_FREE),
+    PROPERTY_INT(FM10000, cmPauseBufferBytes, API_FM10000_CM_PAUSE_BUFFER_BYTES,
+                 FM_TLV_FM10K_CM_PAUSE_BUFFER_BYTES),
+    PROPERTY_INT(FM10000, mcastMaxEntriesPerCam, API_FM10000_MCAST_MAX_ENTRIES_PER_CAM,
+                 FM_TLV_FM10K_MCAST_MAX_ENTRIES_PER_CAM),
+    PROPERTY_INT(FM10000, ffuUcastSliceRangeFirst, API_FM10000_FFU_UNICAST_SLICE_1ST,
+                 FM_TLV_FM10K_FFU_UNICAST_SLICE_1ST),
+    PROPERTY_INT(FM10000, ffuUcastSliceRangeLast, API_FM10000_FFU_UNICAST_SLICE_LAST,
+                 FM_TLV_FM10K_FFU_UNICAST_SLICE_LAST),
+    PROPERTY_INT(FM10000, ffuMcastSliceRangeFirst, API_FM10000_FFU_MULTICAST_SLICE_1ST,
+                 FM_TLV_FM10K_FFU_MULTICAST_SLICE_1ST),
+    PROPERTY_INT(FM10000, ffuMcastSliceRangeLast, API_FM10000_FFU_MULTICAST_SLICE_LAST,
+                 FM_TLV_FM10K_FFU_MULTICAST_SLICE_LAST),
+    PROPERTY_INT(FM10000, ffuAclSliceRangeFirst, API_FM10000_FFU_ACL_SLICE_1ST,
+                 FM_TLV_FM10K_FFU_ACL_SLICE_1ST),
+    PROPERTY_INT(FM10000, ffuAclSliceRangeLast, API_FM10000_FFU_ACL_SLICE_LAST,
+                 FM_TLV_FM10K_FFU_ACL_SLICE_LAST),
+    PROPERTY_INT(FM10000, ffuMapMacResvdForRoute, API_FM10000_FFU_MAPMAC_ROUTING,
+                 FM_TLV_FM10K_FFU_MAPMAC_ROUTING),
+    PROPERTY_INT(FM10000, ffuUcastPrecedenceMin, API_FM10000_FFU_UNICAST_PRECEDENCE_MIN,
+                 FM_TLV_FM10K_FFU_UNICAST_PRECEDENCE_MIN),
+    PROPERTY_INT(FM10000, ffuUcastPrecedenceMax, API_FM10000_FFU_UNICAST_PRECEDENCE_MAX,
+                 FM_TLV_FM10K_FFU_UNICAST_PRECEDENCE_MAX),
+    PROPERTY_INT(FM10000, ffuMcastPrecedenceMin, API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN,
+                 FM_TLV_FM10K_FFU_MULTICAST_PRECEDENCE_MIN),
+    PROPERTY_INT(FM10000, ffuMcastPrecedenceMax, API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX,
+                 FM_TLV_FM10K_FFU_MULTICAST_PRECEDENCE_MAX),
+    PROPERTY_INT(FM10000, ffuAclPrecedenceMin, API_FM10000_FFU_ACL_PRECEDENCE_MIN,
+                 FM_TLV_FM10K_FFU_ACL_PRECEDENCE_MIN),
+    PROPERTY_INT(FM10000, ffuAclPrecedenceMax, API_FM10000_FFU_ACL_PRECEDENCE_MAX,
+                 FM_TLV_FM10K_FFU_ACL_PRECEDENCE_MAX),
+    PROPERTY_BOOL(FM10000, ffuAclStrictCountPolice, API_FM10000_FFU_ACL_STRICT_COUNT_POLICE,
+                  FM_TLV_FM10K_FFU_ACL_STRICT_COUNT_POLICE),
+    PROPERTY_BOOL(FM10000, initUcastFloodTriggers, API_FM10000_INIT_UCAST_FLOODING_TRIGGERS,
+                  FM_TLV_FM10K_INIT_UCAST_FLOODING_TRIGGERS),
+    PROPERTY_BOOL(FM10000, initMcastFloodTriggers, API_FM10000_INIT_MCAST_FLOODING_TRIGGERS,
+                  FM_TLV_FM10K_INIT_MCAST_FLOODING_TRIGGERS),
+    PROPERTY_BOOL(FM10000, initBcastFloodTriggers, API_FM10000_INIT_BCAST_FLOODING_TRIGGERS,
+                  FM_TLV_FM10K_INIT_BCAST_FLOODING_TRIGGERS),
+    PROPERTY_BOOL(FM10000, initResvdMacTriggers, API_FM10000_INIT_RESERVED_MAC_TRIGGERS,
+                  FM_TLV_FM10K_INIT_RESERVED_MAC_TRIGGERS),
+    PROPERTY_INT(FM10000, floodingTrapPriority, API_FM10000_FLOODING_TRAP_PRIORITY,
+                 FM_TLV_FM10K_FLOODING_TRAP_PRIORITY),
+    PROPERTY_BOOL(FM10000, autonegGenerateEvents, API_FM10000_AUTONEG_GENERATE_EVENTS,
+                  FM_TLV_FM10K_AUTONEG_GENERATE_EVENTS),
+    PROPERTY_BOOL(FM10000, linkDependsOfDfe, API_FM10000_LINK_DEPENDS_ON_DFE,
+                  FM_TLV_FM10K_LINK_DEPENDS_ON_DFE),
+    PROPERTY_BOOL(FM10000, vnUseSharedEncapFlows, API_FM10000_VN_USE_SHARED_ENCAP_FLOWS,
+                  FM_TLV_FM10K_VN_USE_SHARED_ENCAP_FLOWS),
+    PROPERTY_INT(FM10000, vnMaxRemoteAddress, API_FM10000_VN_MAX_TUNNEL_RULES,
+                 FM_TLV_FM10K_VN_MAX_TUNNEL_RULES),
+    PROPERTY_INT(FM10000, vnTunnelGroupHashSize, API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE,
+                 FM_TLV_FM10K_VN_TUNNEL_GROUP_HASH_SIZE),
+    PROPERTY_INT(FM10000, vnTeVid, API_FM10000_VN_TE_VID,
+                 FM_TLV_FM10K_VN_TE_VID),
+    PROPERTY_INT(FM10000, vnEncapAclNumber, API_FM10000_VN_ENCAP_ACL_NUM,
+                 FM_TLV_FM10K_VN_ENCAP_ACL_NUM),
+    PROPERTY_INT(FM10000, vnDecapAclNumber, API_FM10000_VN_DECAP_ACL_NUM,
+                 FM_TLV_FM10K_VN_DECAP_ACL_NUM),
+    PROPERTY_INT(FM10000, mcastNumStackGroups, API_FM10000_MCAST_NUM_STACK_GROUPS,
+                 FM_TLV_FM10K_MCAST_NUM_STACK_GROUPS),
+    PROPERTY_BOOL(FM10000, vnTunnelOnlyOnIngress, API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS,
+                  FM_TLV_FM10K_VN_TUNNEL_ONLY_IN_INGRESS),
+    PROPERTY_INT(FM10000, mtableCleanupWm, API_FM10000_MTABLE_CLEANUP_WATERMARK,
+                 FM_TLV_FM10K_MTABLE_CLEANUP_WATERMARK),
+    PROPERTY_TEXT(FM10000, schedMode, API_FM10000_SCHED_MODE,
+                  FM_TLV_FM10K_SCHED_MODE),
+    PROPERTY_BOOL(FM10000, updateSchedOnLinkChange, API_FM10000_UPD_SCHED_ON_LNK_CHANGE,
+                  FM_TLV_FM10K_UPD_SCHED_ON_LNK_CHANGE),
+    PROPERTY_BOOL(FM10000, createRemoteLogicalPorts, API_FM10000_CREATE_REMOTE_LOGICAL_PORTS,
+                  FM_TLV_FM10K_CREATE_REMOTE_LOGICAL_PORTS),
+    PROPERTY_INT(FM10000, autonegCl37Timeout, API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT,
+                 FM_TLV_FM10K_AUTONEG_CLAUSE_37_TIMEOUT),
+    PROPERTY_INT(FM10000, autonegSgmiiTimeout, API_FM10000_AUTONEG_SGMII_TIMEOUT,
+                 FM_TLV_FM10K_AUTONEG_SGMII_TIMEOUT),
+    PROPERTY_BOOL(FM10000, useHniServicesLoopback, API_FM10000_HNI_SERVICES_LOOPBACK,
+                  FM_TLV_FM10K_HNI_SERVICES_LOOPBACK),
+    PROPERTY_INT(FM10000, antiBubbleWm, API_FM10000_ANTI_BUBBLE_WM,
+                 FM_TLV_FM10K_ANTI_BUBBLE_WM),
+    PROPERTY_INT(FM10000, serdesOpMode, API_FM10000_SERDES_OP_MODE,
+                 FM_TLV_FM10K_SERDES_OP_MODE),
+    PROPERTY_INT(FM10000, serdesDbgLevel, API_FM10000_SERDES_DBG_LVL,
+                 FM_TLV_FM10K_SERDES_DBG_LVL),
+    PROPERTY_BOOL(FM10000, parityEnableInterrupts, API_FM10000_PARITY_INTERRUPTS,
+                  FM_TLV_FM10K_PARITY_INTERRUPTS),
+    PROPERTY_BOOL(FM10000, parityStartTcamMonitors, API_FM10000_START_TCAM_MONITORS,
+                  FM_TLV_FM10K_PARITY_TCAM_MONITOR),
+    PROPERTY_INT(FM10000, parityCrmTimeout, API_FM10000_CRM_TIMEOUT,
+                 FM_TLV_FM10K_PARITY_CRM_TIMEOUT),
+    PROPERTY_INT(FM10000, schedOverspeed, API_FM10000_SCHED_OVERSPEED,
+                 FM_TLV_FM10K_SCHED_OVERSPEED),
+    PROPERTY_HEX(FM10000, intrLinkIgnoreMask, API_FM10000_INTR_LINK_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_LINK_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrAutonegIgnoreMask, API_FM10000_INTR_AUTONEG_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_AUTONEG_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrSerdesIgnoreMask, API_FM10000_INTR_SERDES_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_SERDES_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrPcieIgnoreMask, API_FM10000_INTR_PCIE_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_PCIE_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrMaTcnIgnoreMask, API_FM10000_INTR_MATCN_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_MATCN_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrFhTailIgnoreMask, API_FM10000_INTR_FHTAIL_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_FHTAIL_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrSwIgnoreMask, API_FM10000_INTR_SW_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_SW_IGNORE_MASK),
+    PROPERTY_HEX(FM10000, intrTeIgnoreMask, API_FM10000_INTR_TE_IGNORE_MASK,
+                 FM_TLV_FM10K_INTR_TE_IGNORE_MASK),
+    PROPERTY_BOOL(FM10000, enableEeeSpicoIntr, API_FM10000_ENABLE_EEE_SPICO_INTR,
+                  FM_TLV_FM10K_EEE_SPICO_INTR),
+    PROPERTY_BOOL(FM10000, useAlternateSpicoFw, API_FM10000_USE_ALTERNATE_SPICO_FW,
+                  FM_TLV_FM10K_USE_ALTERNATE_SPICO_FW),
+    PROPERTY_BOOL(FM10000, allowKrPcalOnEee, API_FM10000_ALLOW_KRPCAL_ON_EEE,
+                  FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE),
+    PROPERTY_TEXT(FM10000, warmRestartImage, API_FM10000_WARM_RESTART_IMAGE,
+                  FM_TLV_FM10K_WARM_RESTART_IMAGE),
+#endif
+};
+
 /*****************************************************************************
  * Local function prototypes.
  *****************************************************************************/
@@ -169,6 +577,357 @@ static fm_bool GetTlvBool(fm_byte *tlv)
 
 
 
+/*****************************************************************************/
+/* HashPropertyKey
+ * \ingroup intApi
+ *
+ * \desc            Computes the FNV-1a hash of a property key.
+ *
+ * \param[in]       key is the dotted string key.
+ *
+ * \return          Hash value of the key.
+ *
+ *****************************************************************************/
+static fm_uint HashPropertyKey(fm_text key)
+{
+    fm_uint hash;
+
+    hash = 2166136261U;
+
+    while (*key != '\0')
+    {
+        hash ^= (fm_byte) *key++;
+        hash *= 16777619U;
+    }
+
+    return hash;
+
+}   /* end HashPropertyKey */
+
+
+
+
+/*****************************************************************************/
+/* HashPropertyTlv
+ * \ingroup intApi
+ *
+ * \desc            Computes the hash of a property TLV type.
+ *
+ * \param[in]       tlvType is the TLV type.
+ *
+ * \return          Hash value of the TLV type.
+ *
+ *****************************************************************************/
+static fm_uint HashPropertyTlv(fm_uint tlvType)
+{
+
+    return (tlvType * 2654435761U) >> 16;
+
+}   /* end HashPropertyTlv */
+
+
+
+
+/*****************************************************************************/
+/* AddPropertyToIndex
+ * \ingroup intApi
+ *
+ * \desc            Inserts a property in one of the open addressed hash
+ *                  indexes of the property table.
+ *
+ * \param[in,out]   index is the hash index.
+ *
+ * \param[in]       hash is the hash value of the property.
+ *
+ * \param[in]       propIndex is the position of the property in
+ *                  propertyTable.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void AddPropertyToIndex(fm_uint16 *index, fm_uint hash, fm_int propIndex)
+{
+    fm_uint slot;
+
+    slot = hash & (FM_PROPERTY_INDEX_SIZE - 1);
+
+    while (index[slot] != FM_PROPERTY_INDEX_EMPTY)
+    {
+        slot = (slot + 1) & (FM_PROPERTY_INDEX_SIZE - 1);
+    }
+
+    index[slot] = (fm_uint16) propIndex;
+
+}   /* end AddPropertyToIndex */
+
+
+
+
+/*****************************************************************************/
+/* FindPropertyByKey
+ * \ingroup intApi
+ *
+ * \desc            Looks up a property descriptor by key.
+ *
+ * \param[in]       key is the dotted string key.
+ *
+ * \return          Pointer to the descriptor, or NULL if the key is unknown.
+ *
+ *****************************************************************************/
+static const fm_propertyDesc *FindPropertyByKey(fm_text key)
+{
+    const fm_propertyDesc *desc;
+    fm_uint                slot;
+    fm_uint16              propIndex;
+
+    if (key == NULL)
+    {
+        return NULL;
+    }
+
+    slot = HashPropertyKey(key) & (FM_PROPERTY_INDEX_SIZE - 1);
+
+    while ( (propIndex = fmRootAlos->propertyKeyIndex[slot]) !=
+            FM_PROPERTY_INDEX_EMPTY )
+    {
+        desc = &propertyTable[propIndex];
+
+        if (strcmp(desc->key, key) == 0)
+        {
+            return desc;
+        }
+
+        slot = (slot + 1) & (FM_PROPERTY_INDEX_SIZE - 1);
+    }
+
+    return NULL;
+
+}   /* end FindPropertyByKey */
+
+
+
+
+/*****************************************************************************/
+/* FindPropertyByTlv
+ * \ingroup intApi
+ *
+ * \desc            Looks up a property descriptor by TLV type.
+ *
+ * \param[in]       tlvType is the TLV type.
+ *
+ * \return          Pointer to the descriptor, or NULL if the TLV type is
+ *                  not an API property.
+ *
+ *****************************************************************************/
+static const fm_propertyDesc *FindPropertyByTlv(fm_uint tlvType)
+{
+    const fm_propertyDesc *desc;
+    fm_uint                slot;
+    fm_uint16              propIndex;
+
+    slot = HashPropertyTlv(tlvType) & (FM_PROPERTY_INDEX_SIZE - 1);
+
+    while ( (propIndex = fmRootAlos->propertyTlvIndex[slot]) !=
+            FM_PROPERTY_INDEX_EMPTY )
+    {
+        desc = &propertyTable[propIndex];
+
+        if (desc->tlvType == tlvType)
+        {
+            return desc;
+        }
+
+        slot = (slot + 1) & (FM_PROPERTY_INDEX_SIZE - 1);
+    }
+
+    return NULL;
+
+}   /* end FindPropertyByTlv */
+
+
+
+
+/*****************************************************************************/
+/* GetPropertyPtr
+ * \ingroup intApi
+ *
+ * \desc            Returns the storage of a property value.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \return          Pointer to the property value.
+ *
+ *****************************************************************************/
+static void *GetPropertyPtr(const fm_propertyDesc *desc)
+{
+    fm_byte *base;
+
+#if defined(FM_SUPPORT_FM10000)
+    if (desc->set == PROPERTY_SET_FM10000)
+    {
+        base = (fm_byte *) GET_FM10000_PROPERTY();
+    }
+    else
+#endif
+    {
+        base = (fm_byte *) GET_PROPERTY();
+    }
+
+    return base + desc->offset;
+
+}   /* end GetPropertyPtr */
+
+
+
+
+/*****************************************************************************/
+/* GetPropertyInt
+ * \ingroup intApi
+ *
+ * \desc            Reads the raw value of an integer or Boolean property.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \return          Value of the property field.
+ *
+ *****************************************************************************/
+static fm_int GetPropertyInt(const fm_propertyDesc *desc)
+{
+    void *ptr;
+
+    ptr = GetPropertyPtr(desc);
+
+    if (desc->size == sizeof(fm_bool))
+    {
+        return *(fm_bool *) ptr;
+    }
+
+    return *(fm_int *) ptr;
+
+}   /* end GetPropertyInt */
+
+
+
+
+/*****************************************************************************/
+/* SetPropertyInt
+ * \ingroup intApi
+ *
+ * \desc            Writes the raw value of an integer or Boolean property.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \param[in]       value is the value to store in the property field.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetPropertyInt(const fm_propertyDesc *desc, fm_int value)
+{
+    void *ptr;
+
+    ptr = GetPropertyPtr(desc);
+
+    if (desc->size == sizeof(fm_bool))
+    {
+        *(fm_bool *) ptr = (fm_bool) value;
+    }
+    else
+    {
+        *(fm_int *) ptr = value;
+    }
+
+}   /* end SetPropertyInt */
+
+
+
+
+/*****************************************************************************/
+/* GetPropertyBool
+ * \ingroup intApi
+ *
+ * \desc            Reads the value of a Boolean property.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \return          Value of the property.
+ *
+ *****************************************************************************/
+static fm_bool GetPropertyBool(const fm_propertyDesc *desc)
+{
+    fm_int value;
+
+    value = GetPropertyInt(desc);
+
+    if (desc->flagValue != 0)
+    {
+        return (value == desc->flagValue);
+    }
+
+    return (value != 0);
+
+}   /* end GetPropertyBool */
+
+
+
+
+/*****************************************************************************/
+/* SetPropertyBool
+ * \ingroup intApi
+ *
+ * \desc            Writes the value of a Boolean property.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \param[in]       value is the value of the property.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetPropertyBool(const fm_propertyDesc *desc, fm_bool value)
+{
+
+    if (!value)
+    {
+        SetPropertyInt(desc, 0);
+    }
+    else if (desc->flagValue != 0)
+    {
+        SetPropertyInt(desc, desc->flagValue);
+    }
+    else
+    {
+        SetPropertyInt(desc, TRUE);
+    }
+
+}   /* end SetPropertyBool */
+
+
+
+
+/*****************************************************************************/
+/* SetPropertyText
+ * \ingroup intApi
+ *
+ * \desc            Writes the value of a text property, truncating it to
+ *                  the size of the property field.
+ *
+ * \param[in]       desc points to the property descriptor.
+ *
+ * \param[in]       value is the value of the property.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetPropertyText(const fm_propertyDesc *desc, fm_text value)
+{
+
+    FM_SNPRINTF_S(GetPropertyPtr(desc), desc->size, "%s", value);
+
+}   /* end SetPropertyText */
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -188,192 +947,43 @@ static fm_bool GetTlvBool(fm_byte *tlv)
  *****************************************************************************/
 fm_status fmInitializeApiProperties(void)
 {
-    fm_status err = FM_OK;
-    fm_property *prop;
-#if defined(FM_SUPPORT_FM10000)
-    fm10000_property *fm10kProp;
-#endif
+    fm_status              err = FM_OK;
+    const fm_propertyDesc *desc;
+    fm_int                 i;
 
-    prop = GET_PROPERTY();
-
-    prop->defStateVlanMember = FM_AAD_API_STP_DEF_STATE_VLAN_MEMBER;
-    prop->directSendToCpu = FM_AAD_API_DIRECT_SEND_TO_CPU;
-    prop->defStateVlanNonMember = FM_AAD_API_STP_DEF_STATE_VLAN_NON_MEMBER;
-    prop->bootIdentifySw = FM_AAD_DEBUG_BOOT_IDENTIFYSWITCH;
-    prop->bootReset = FM_AAD_DEBUG_BOOT_RESET;
-    prop->autoInsertSwitches = FM_AAD_DEBUG_BOOT_AUTOINSERTSWITCH;
-    prop->deviceResetTime = FM_AAD_API_BOOT_RESET_TIME;
-    prop->swagAutoEnableLinks = FM_AAD_API_AUTO_ENABLE_SWAG_LINKS;
-    prop->eventBlockThreshold = FM_AAD_API_FREE_EVENT_BLOCK_THRESHOLD;
-    prop->eventUnblockThreshold = FM_AAD_API_FREE_EVENT_UNBLOCK_THRESHOLD;
-    prop->eventSemTimeout = FM_AAD_API_EVENT_SEM_TIMEOUT;
-    prop->rxDirectEnqueueing = FM_AAD_API_PACKET_RX_DIRECT_ENQUEUEING;
-    prop->rxDriverDestinations = FM_AAD_API_PACKET_RX_DRV_DEST;
-    prop->lagAsyncDeletion = FM_AAD_API_ASYNC_LAG_DELETION;
-    prop->maEventOnStaticAddr = FM_AAD_API_MA_EVENT_ON_STATIC_ADDR;
-    prop->maEventOnDynAddr = FM_AAD_API_MA_EVENT_ON_DYNAMIC_ADDR;
-    prop->maEventOnAddrChange = FM_AAD_API_MA_EVENT_ON_ADDR_CHANGE;
-    prop->maFlushOnPortDown = FM_AAD_API_MA_FLUSH_ON_PORT_DOWN;
-    prop->maFlushOnVlanChange = FM_AAD_API_MA_FLUSH_ON_VLAN_CHANGE;
-    prop->maFlushOnLagChange = FM_AAD_API_MA_FLUSH_ON_LAG_CHANGE;
-    prop->maTcnFifoBurstSize = FM_AAD_API_MA_TCN_FIFO_BURST_SIZE;
-    prop->swagIntVlanStats = FM_AAD_API_SWAG_INTERNAL_VLAN_STATS;
-    prop->perLagManagement = FM_AAD_API_PER_LAG_MANAGEMENT;
-    prop->parityRepairEnable = FM_AAD_API_PARITY_REPAIR_ENABLE;
-    prop->swagMaxAclPortSets = FM_AAD_API_SWAG_MAX_ACL_PORT_SETS;
-    prop->maxPortSets = FM_AAD_API_MAX_PORT_SETS;
-    prop->packetReceiveEnable = FM_AAD_API_PACKET_RECEIVE_ENABLE;
-    prop->multicastSingleAddress = FM_AAD_API_1_ADDR_PER_MCAST_GROUP;
-    prop->modelPosition = FM_AAD_API_PLATFORM_MODEL_POSITION;
-    prop->vnNumNextHops = FM_AAD_API_NUM_VN_TUNNEL_NEXTHOPS;
-    prop->vnEncapProtocol = FM_AAD_API_VN_ENCAP_PROTOCOL;
-    prop->vnEncapVersion = FM_AAD_API_VN_ENCAP_VERSION;
-    prop->supportRouteLookups = FM_AAD_API_SUPPORT_ROUTE_LOOKUPS;
-    prop->routeMaintenanceEnable = FM_AAD_API_ROUTING_MAINTENANCE_ENABLE;
-    prop->autoVlan2Tagging = FM_AAD_API_AUTO_VLAN2_TAGGING;
-    prop->hniGlortsPerPep = FM_AAD_API_HNI_GLORTS_PER_PEP;
-
-
-    prop->interruptHandlerDisable = FM_AAD_DEBUG_BOOT_INTERRUPT_HANDLER;
-    prop->maTableMaintenanceEnable = FM_AAD_API_MA_TABLE_MAINTENENANCE_ENABLE;
-    prop->fastMaintenanceEnable = FM_AAD_API_FAST_MAINTENANCE_ENABLE;
-    prop->fastMaintenancePer = FM_AAD_API_FAST_MAINTENANCE_PERIOD;
-    prop->strictGlotPhysical = FM_AAD_API_STRICT_GLORT_PHYSICAL;
-    prop->resetWmAtPauseOff = FM_AAD_API_RESET_WATERMARK_AT_PAUSE_OFF;
-    prop->swagAutoSubSwitches = FM_AAD_API_SWAG_AUTO_SUB_SWITCHES;
-    prop->swagAutoIntPorts = FM_AAD_API_SWAG_AUTO_INTERNAL_PORTS;
-    prop->swagAutoVNVsi = FM_AAD_API_SWAG_AUTO_VN_VSI;
-    prop->byPassEnable = FM_AAD_API_PLATFORM_BYPASS_ENABLE;
-    prop->lagDelSemTimeout = FM_AAD_API_LAG_DELETE_SEMAPHORE_TIMEOUT;
-    prop->stpEnIntPortCtrl = FM_AAD_API_STP_ENABLE_INTERNAL_PORT_CTRL;
-    prop->modelPortMapType = FM_AAD_API_PLATFORM_MODEL_PORT_MAP_TYPE;
-    FM_SNPRINTF_S(prop->modelSwitchType,
-            sizeof(prop->modelSwitchType), "%s",
-            FM_AAD_API_PLATFORM_MODEL_SWITCH_TYPE);
-    prop->modelSendEOT = FM_AAD_API_PLATFORM_MODEL_SEND_EOT;
-    prop->modelLogEgressInfo = FM_AAD_API_PLATFORM_MODEL_LOG_EGRESS_INFO;
-    prop->enableRefClock = FM_AAD_API_PLATFORM_ENABLE_REF_CLOCK;
-    prop->setRefClock = FM_AAD_API_PLATFORM_SET_REF_CLOCK;
-    prop->priorityBufQueues = FM_AAD_API_PLATFORM_PRIORITY_BUFFER_QUEUES;
-    prop->pktSchedType = FM_AAD_API_PLATFORM_PKT_SCHED_TYPE;
-    prop->separateBufPoolEnable = FM_AAD_API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE;
-    prop->numBuffersRx = FM_AAD_API_PLATFORM_NUM_BUFFERS_RX;
-    prop->numBuffersTx = FM_AAD_API_PLATFORM_NUM_BUFFERS_TX;
-    FM_SNPRINTF_S(prop->modelPktInterface,
-            sizeof(prop->modelPktInterface), "%s",
-            FM_AAD_API_PLATFORM_MODEL_PKT_INTERFACE);
-    FM_SNPRINTF_S(prop->pktInterface,
-            sizeof(prop->pktInterface), "%s",
-            FM_AAD_API_PLATFORM_PKT_INTERFACE);
-    FM_SNPRINTF_S(prop->modelTopologyName,
-            sizeof(prop->modelTopologyName), "%s",
-            FM_AAD_API_PLATFORM_MODEL_TOPOLOGY_NAME);
-    prop->modelUseModelPath = FM_AAD_API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH;
-    FM_SNPRINTF_S(prop->modelDevBoardIp,
-            sizeof(prop->modelDevBoardIp), "%s",
-            FM_AAD_API_PLATFORM_MODEL_DEV_BOARD_IP);
-    prop->modelDevBoardPort = FM_AAD_API_PLATFORM_MODEL_DEV_BOARD_PORT;
-    prop->modelDeviceCfg = FM_AAD_API_PLATFORM_MODEL_DEVICE_CFG;
-    prop->modelChipVersion = FM_AAD_API_PLATFORM_MODEL_CHIP_VERSION;
-    prop->sbusServerPort = FM_AAD_API_PLATFORM_SBUS_SERVER_PORT;
-    prop->isWhiteModel = FM_AAD_API_PLATFORM_IS_WHITE_MODEL;
-    FM_SNPRINTF_S(prop->initLoggingCat,
-            sizeof(prop->initLoggingCat), "%s",
-            FM_AAD_API_DEBUG_INIT_LOGGING_CAT);
-    prop->addPepsToFlooding = FM_AAD_API_PORT_ADD_PEPS_TO_FLOODING;
-    prop->allowFtagVlanTagging = FM_AAD_API_PORT_ALLOW_FTAG_VLAN_TAGGING;
-    prop->ignoreBwViolation = 0;
-    prop->dfeAllowEarlyLinkUp = FM_AAD_API_DFE_ALLOW_EARLY_LINK_UP_MODE;
-    prop->dfeAllowKrPcal = FM_AAD_API_DFE_ALLOW_KR_PCAL_MODE;
-    prop->dfeEnableSigOkDebounce = FM_AAD_API_DFE_ENABLE_SIGNALOK_DEBOUNCING;
-    prop->enableStatusPolling = FM_AAD_API_PORT_ENABLE_STATUS_POLLING;
-    prop->gsmeTimestampMode = FM_AAD_API_GSME_TIMESTAMP_MODE;
-    prop->hniMcastFlooding = FM_AAD_API_MULTICAST_HNI_FLOODING;
-    prop->hniMacEntriesPerPep = FM_AAD_API_HNI_MAC_ENTRIES_PER_PEP;
-    prop->hniMacEntriesPerPort = FM_AAD_API_HNI_MAC_ENTRIES_PER_PORT;
-    prop->hniInnOutEntriesPerPep = FM_AAD_API_HNI_INN_OUT_ENTRIES_PER_PEP;
-    prop->hniInnOutEntriesPerPort = FM_AAD_API_HNI_INN_OUT_ENTRIES_PER_PORT;
-    prop->anTimerAllowOutSpec = FM_AAD_API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC;
-    prop->serdesValidate = FM_AAD_API_SERDES_VALIDATE;
-    prop->sbmasterValidate = FM_AAD_API_SBM_VALIDATE;
-    prop->serdesErrActionUpState = FM_AAD_API_SERDES_ACTION_IN_UP_STATE;
-    prop->serdesValidateTimer = FM_AAD_API_SERDES_VALIDATE_TIMER;
-    prop->hniFlowEntriesPerVf = FM_AAD_API_HNI_FLOW_ENTRIES_VF;
-    prop->cpuPortXCastMode = FM_AAD_API_CPU_PORT_XCAST_MODE;
+    for (i = 0 ; i < FM_PROPERTY_INDEX_SIZE ; i++)
+    {
+        fmRootAlos->propertyKeyIndex[i] = FM_PROPERTY_INDEX_EMPTY;
+        fmRootAlos->propertyTlvIndex[i] = FM_PROPERTY_INDEX_EMPTY;
+    }
 
+    for (i = 0 ; i < NUM_PROPERTIES ; i++)
+    {
+        desc = &propertyTable[i];
 
-#if defined(FM_SUPPORT_FM10000)
-    fm10kProp = GET_FM10000_PROPERTY();
-    FM_SNPRINTF_S(fm10kProp->wmSelect,
-            sizeof(fm10kProp->wmSelect), "%s",
-            FM_AAD_API_FM10000_WMSELECT);
-    fm10kProp->cmRxSmpPrivBytes = FM_AAD_API_FM10000_CM_RX_SMP_PRIVATE_BYTES;
-    fm10kProp->cmTxTcHogBytes = FM_AAD_API_FM10000_CM_TX_TC_HOG_BYTES;
-    fm10kProp->cmSmpSdVsHogPercent = FM_AAD_API_FM10000_CM_SMP_SD_VS_HOG_PERCENT;
-    fm10kProp->cmSmpSdJitterBits = FM_AAD_API_FM10000_CM_SMP_SD_JITTER_BITS;
-    fm10kProp->cmTxSdOnPrivate = FM_AAD_API_FM10000_CM_TX_SD_ON_PRIVATE;
-    fm10kProp->cmTxSdOnSmpFree = FM_AAD_API_FM10000_CM_TX_SD_ON_SMP_FREE;
-    fm10kProp->cmPauseBufferBytes = FM_AAD_API_FM10000_CM_PAUSE_BUFFER_BYTES;
-    fm10kProp->mcastMaxEntriesPerCam = FM_AAD_API_FM10000_MCAST_MAX_ENTRIES_PER_CAM;
-    fm10kProp->ffuUcastSliceRangeFirst = FM_AAD_API_FM10000_FFU_UNICAST_SLICE_1ST;
-    fm10kProp->ffuUcastSliceRangeLast = FM_AAD_API_FM10000_FFU_UNICAST_SLICE_LAST;
-    fm10kProp->ffuMcastSliceRangeFirst = FM_AAD_API_FM10000_FFU_MULTICAST_SLICE_1ST;
-    fm10kProp->ffuMcastSliceRangeLast = FM_AAD_API_FM10000_FFU_MULTICAST_SLICE_LAST;
-    fm10kProp->ffuAclSliceRangeFirst = FM_AAD_API_FM10000_FFU_ACL_SLICE_1ST;
-    fm10kProp->ffuAclSliceRangeLast = FM_AAD_API_FM10000_FFU_ACL_SLICE_LAST;
-    fm10kProp->ffuMapMacResvdForRoute = FM_AAD_API_FM10000_FFU_MAPMAC_ROUTING;
-    fm10kProp->ffuUcastPrecedenceMin = FM_AAD_API_FM10000_FFU_UNICAST_PRECEDENCE_MIN;
-    fm10kProp->ffuUcastPrecedenceMax = FM_AAD_API_FM10000_FFU_UNICAST_PRECEDENCE_MAX;
-    fm10kProp->ffuMcastPrecedenceMin = FM_AAD_API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN;
-    fm10kProp->ffuMcastPrecedenceMax = FM_AAD_API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX;
-    fm10kProp->ffuAclPrecedenceMin = FM_AAD_API_FM10000_FFU_ACL_PRECEDENCE_MIN;
-    fm10kProp->ffuAclPrecedenceMax = FM_AAD_API_FM10000_FFU_ACL_PRECEDENCE_MAX;
-    fm10kProp->ffuAclStrictCountPolice = FM_AAD_API_FM10000_FFU_ACL_STRICT_COUNT_POLICE;
-    fm10kProp->initUcastFloodTriggers = FM_AAD_API_FM10000_INIT_UCAST_FLOODING_TRIGGERS;
-    fm10kProp->initMcastFloodTriggers = FM_AAD_API_FM10000_INIT_MCAST_FLOODING_TRIGGERS;
-    fm10kProp->initBcastFloodTriggers = FM_AAD_API_FM10000_INIT_BCAST_FLOODING_TRIGGERS;
-    fm10kProp->initResvdMacTriggers = FM_AAD_API_FM10000_INIT_RESERVED_MAC_TRIGGERS;
-    fm10kProp->floodingTrapPriority = FM_AAD_API_FM10000_FLOODING_TRAP_PRIORITY;
-    fm10kProp->autonegGenerateEvents = FM_AAD_API_FM10000_AUTONEG_GENERATE_EVENTS;
-    fm10kProp->linkDependsOfDfe = FM_AAD_API_FM10000_LINK_DEPENDS_ON_DFE;
-    fm10kProp->vnUseSharedEncapFlows = FM_AAD_API_FM10000_VN_USE_SHARED_ENCAP_FLOWS;
-    fm10kProp->vnMaxRemoteAddress = FM_AAD_API_FM10000_VN_MAX_TUNNEL_RULES;
-    fm10kProp->vnTunnelGroupHashSize = FM_AAD_API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE;
-    fm10kProp->vnTeVid = FM_AAD_API_FM10000_VN_TE_VID;
-    fm10kProp->vnEncapAclNumber = FM_AAD_API_FM10000_VN_ENCAP_ACL_NUM;
-    fm10kProp->vnDecapAclNumber = FM_AAD_API_FM10000_VN_DECAP_ACL_NUM;
-    fm10kProp->mcastNumStackGroups = FM_AAD_API_FM10000_MCAST_NUM_STACK_GROUPS;
-    fm10kProp->vnTunnelOnlyOnIngress = FM_AAD_API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS;
-    fm10kProp->mtableCleanupWm = FM_AAD_API_FM10000_MTABLE_CLEANUP_WATERMARK;
-    FM_SNPRINTF_S(fm10kProp->schedMode,
-            sizeof(fm10kProp->schedMode), "%s",
-            FM_AAD_API_FM10000_SCHED_MODE);
-    fm10kProp->updateSchedOnLinkChange = FM_AAD_API_FM10000_UPD_SCHED_ON_LNK_CHANGE;
-
-
-    fm10kProp->createRemoteLogicalPorts = FM_AAD_API_FM10000_CREATE_REMOTE_LOGICAL_PORTS;
-    fm10kProp->autonegCl37Timeout = FM_AAD_API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT;
-    fm10kProp->autonegSgmiiTimeout = FM_AAD_API_FM10000_AUTONEG_SGMII_TIMEOUT;
-    fm10kProp->useHniServicesLoopback = FM_AAD_API_FM10000_HNI_SERVICES_LOOPBACK;
-    fm10kProp->antiBubbleWm = FM_AAD_API_FM10000_ANTI_BUBBLE_WM;
-    fm10kProp->serdesOpMode = FM_AAD_API_FM10000_SERDES_OP_MODE;
-    fm10kProp->serdesDbgLevel = FM_AAD_API_FM10000_SERDES_DBG_LVL;
-    fm10kProp->parityEnableInterrupts = FM_AAD_API_FM10000_PARITY_INTERRUPTS;
-    fm10kProp->parityStartTcamMonitors = FM_AAD_API_FM10000_START_TCAM_MONITORS;
-    fm10kProp->parityCrmTimeout = FM_AAD_API_FM10000_CRM_TIMEOUT;
-    fm10kProp->schedOverspeed = FM_AAD_API_FM10000_SCHED_OVERSPEED;
-    fm10kProp->intrLinkIgnoreMask = FM_AAD_API_FM10000_INTR_LINK_IGNORE_MASK;
-    fm10kProp->intrAutonegIgnoreMask = FM_AAD_API_FM10000_INTR_AUTONEG_IGNORE_MASK;
-    fm10kProp->intrSerdesIgnoreMask = FM_AAD_API_FM10000_INTR_SERDES_IGNORE_MASK;
-    fm10kProp->intrPcieIgnoreMask = FM_AAD_API_FM10000_INTR_PCIE_IGNORE_MASK;
-    fm10kProp->intrMaTcnIgnoreMask = FM_AAD_API_FM10000_INTR_MATCN_IGNORE_MASK;
-    fm10kProp->intrFhTailIgnoreMask = FM_AAD_API_FM10000_INTR_FHTAIL_IGNORE_MASK;
-    fm10kProp->intrSwIgnoreMask = FM_AAD_API_FM10000_INTR_SW_IGNORE_MASK;
-    fm10kProp->intrTeIgnoreMask = FM_AAD_API_FM10000_INTR_TE_IGNORE_MASK;
-    fm10kProp->enableEeeSpicoIntr = FM_AAD_API_FM10000_ENABLE_EEE_SPICO_INTR;
-    fm10kProp->useAlternateSpicoFw = FM_AAD_API_FM10000_USE_ALTERNATE_SPICO_FW;
-    fm10kProp->allowKrPcalOnEee = FM_AAD_API_FM10000_ALLOW_KRPCAL_ON_EEE;
-#endif
+        switch (desc->type)
+        {
+            case FM_API_ATTR_BOOL:
+                SetPropertyBool(desc, (fm_bool) desc->defInt);
+                break;
+
+            case FM_API_ATTR_TEXT:
+                SetPropertyText(desc, desc->defText);
+                break;
+
+            default:
+                SetPropertyInt(desc, desc->defInt);
+                break;
+        }
+
+        AddPropertyToIndex(fmRootAlos->propertyKeyIndex,
+                           HashPropertyKey(desc->key),
+                           i);
+
+        AddPropertyToIndex(fmRootAlos->propertyTlvIndex,
+                           HashPropertyTlv(desc->tlvType),
+                           i);
+    }
 
     err = fmCreateLock("API Property Lock", 
                        &fmRootAlos->propertyLock);
@@ -402,509 +1012,41 @@ fm_status fmInitializeApiProperties(void)
  *****************************************************************************/
 fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
 {
-    fm_property *prop;
-#if defined(FM_SUPPORT_FM10000)
-    fm10000_property *fm10kProp;
-#endif
-    fm_uint     tlvType;
-    fm_uint     tlvLen;
-
-
-    prop = GET_PROPERTY();
-    fm10kProp  = GET_FM10000_PROPERTY();
+    const fm_propertyDesc *desc;
+    fm_uint                tlvType;
+    fm_uint                tlvLen;
 
     tlvType = (tlv[0] << 8) | tlv[1];
     tlvLen = tlv[2];
 
-    switch (tlvType)
+    desc = FindPropertyByTlv(tlvType);
+
+    if (desc == NULL)
     {
-        case FM_TLV_API_STP_DEF_VLAN_MEMBER:
-            prop->defStateVlanMember = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_DIR_SEND_TO_CPU:
-            prop->directSendToCpu = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_STP_DEF_VLAN_NON_MEMBER:
-            prop->defStateVlanNonMember = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_IDENTIFY_SWITCH:
-            prop->bootIdentifySw = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_BOOT_RESET:
-            prop->bootReset = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_AUTO_INSERT_SW:
-            prop->autoInsertSwitches = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_DEV_RESET_TIME:
-            prop->deviceResetTime = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_SWAG_EN_LINK:
-            prop->swagAutoEnableLinks = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_EVENT_BLK_THRESHOLD:
-            prop->eventBlockThreshold = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_EVENT_UNBLK_THRESHOLD:
-            prop->eventUnblockThreshold = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_EVENT_SEM_TIMEOUT:
-            prop->eventSemTimeout = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_RX_DIRECTED_ENQ:
-            prop->rxDirectEnqueueing = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_RX_DRV_DEST:
-            prop->rxDriverDestinations = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_LAG_ASYNC_DEL:
-            prop->lagAsyncDeletion = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_EVENT_ON_STATIC_ADDR:
-            prop->maEventOnStaticAddr = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_EVENT_ON_DYN_ADDR:
-            prop->maEventOnDynAddr = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_EVENT_ON_ADDR_CHG:
-            prop->maEventOnAddrChange = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_FLUSH_ON_PORT_DOWN:
-            prop->maFlushOnPortDown = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_FLUSH_ON_VLAN_CHG:
-            prop->maFlushOnVlanChange = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_FLUSH_ON_LAG_CHG:
-            prop->maFlushOnLagChange = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_TCN_FIFO_BURST_SIZE:
-            prop->maTcnFifoBurstSize = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_SWAG_INT_VLAN_STATS:
-            prop->swagIntVlanStats = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PER_LAG_MGMT:
-            prop->perLagManagement = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PARITY_REPAIR_EN:
-            prop->parityRepairEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_SWAG_MAX_ACL_PORT_SET:
-            prop->swagMaxAclPortSets = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_MAX_PORT_SETS:
-            prop->maxPortSets = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PKT_RX_EN:
-            prop->packetReceiveEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_MC_SINGLE_ADDR:
-            prop->multicastSingleAddress = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_MODEL_POS:
-            prop->modelPosition = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_VN_NUM_NH:
-            prop->vnNumNextHops = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_VN_ENCAP_PROTOCOL:
-            prop->vnEncapProtocol = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_VN_ENCAP_VER:
-            prop->vnEncapVersion = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_SUP_ROUTE_LOOKUP:
-            prop->supportRouteLookups = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_RT_MAINT_EN:
-            prop->routeMaintenanceEnable = FM_AAD_API_ROUTING_MAINTENANCE_ENABLE;
-        break;
-        case FM_TLV_API_AUTO_VLAN2_TAG:
-            prop->autoVlan2Tagging = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_HNI_GLORTS_PER_PEP:
-            prop->hniGlortsPerPep = GetTlvInt(tlv + 3, tlvLen);
-        break;
-
-
-        case FM_TLV_API_INTR_HANDLER_DIS:
-            prop->interruptHandlerDisable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_MA_TABLE_MAINT_EN:
-            prop->maTableMaintenanceEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_FAST_MAINT_EN:
-            prop->fastMaintenanceEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_FAST_MAINT_PER:
-            prop->fastMaintenancePer = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_STRICT_GLORT:
-            prop->strictGlotPhysical = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_AUTO_RESET_WM:
-            prop->resetWmAtPauseOff = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_AUTO_SUB_SW:
-            prop->swagAutoSubSwitches = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_SWAG_AUTO_INT_PORT:
-            prop->swagAutoIntPorts = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_SWAG_AUTO_NVVSI:
-            prop->swagAutoVNVsi = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_BYPASS_EN:
-            prop->byPassEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_LAG_DEL_SEM_TIMEOUT:
-            prop->lagDelSemTimeout = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_STP_EN_INT_PORT_CTRL:
-            prop->stpEnIntPortCtrl = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_MODEL_PORT_MAP_TYPE:
-            prop->modelPortMapType = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_MODEL_SW_TYPE:
-            CopyTlvStr(prop->modelSwitchType,
-                    sizeof(prop->modelSwitchType),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_MODEL_TX_EOT:
-            prop->modelSendEOT = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_MODEL_LOG_EGR_INFO:
-            prop->modelLogEgressInfo = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_EN_REF_CLK:
-            prop->enableRefClock = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_SET_REF_CLK:
-            prop->setRefClock = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_PRI_BUF_Q:
-            prop->priorityBufQueues = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_PKT_SCHED_TYPE:
-            prop->pktSchedType = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_SEP_BUF_POOL:
-            prop->separateBufPoolEnable = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_NUM_BUF_RX:
-            prop->numBuffersRx = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_NUM_BUF_TX:
-            prop->numBuffersTx = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_MODEL_PKT_INTF:
-            CopyTlvStr(prop->modelPktInterface,
-                    sizeof(prop->modelPktInterface),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_PKT_INTF:
-            CopyTlvStr(prop->pktInterface,
-                    sizeof(prop->pktInterface),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_MODEL_TOPO:
-            CopyTlvStr(prop->modelTopologyName,
-                    sizeof(prop->modelTopologyName),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_MODEL_USE_PATH:
-            prop->modelUseModelPath = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PLAT_DEV_BOARD_IP:
-            CopyTlvStr(prop->modelDevBoardIp,
-                    sizeof(prop->modelDevBoardIp),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_DEV_BOARD_PORT:
-            prop->modelDevBoardPort = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_MODEL_DEVICE_CFG:
-            prop->modelDeviceCfg = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_MODEL_CHIP_VERSION:
-            prop->modelChipVersion = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_SBUS_SERVER_PORT:
-            prop->sbusServerPort = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_PLAT_IS_WHITE_MODEL:
-            prop->isWhiteModel = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_DBG_INT_LOG_CAT:
-            CopyTlvStr(prop->initLoggingCat,
-                    sizeof(prop->initLoggingCat),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_ADD_PEP_FLOOD:
-            prop->addPepsToFlooding = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_ADD_ALLOW_FTAG_VLAN_TAG:
-            prop->allowFtagVlanTagging = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_IGNORE_BW_VIOLATION:
-            prop->ignoreBwViolation = GetTlvBool(tlv + 3) ? 1 : 0;
-        break;
-        case FM_TLV_API_IGNORE_BW_VIOLATION_NW:
-            prop->ignoreBwViolation = GetTlvBool(tlv + 3) ? 2 : 0;
-        break;
-        case FM_TLV_API_DFE_EARLY_LNK_UP:
-            prop->dfeAllowEarlyLinkUp = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_DFE_ALLOW_KR_PCAL:
-            prop->dfeAllowKrPcal = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_DFE_ENABLE_SIGNALOK_DEBOUNCING:
-            prop->dfeEnableSigOkDebounce = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_PORT_ENABLE_STATUS_POLLING:
-            prop->enableStatusPolling = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_GSME_TS_MODE:
-            prop->gsmeTimestampMode = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_MC_HNI_FLOODING:
-            prop->hniMcastFlooding = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_HNI_MAC_ENTRIES_PER_PEP:
-            prop->hniMacEntriesPerPep = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_HNI_MAC_ENTRIES_PER_PORT:
-            prop->hniMacEntriesPerPort = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_HNI_INN_OUT_ENTRIES_PER_PEP:
-            prop->hniInnOutEntriesPerPep = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_HNI_INN_OUT_ENTRIES_PER_PORT:
-            prop->hniInnOutEntriesPerPort = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_AN_TIMER_ALLOW_OUT_SPEC:
-            prop->anTimerAllowOutSpec = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_SERDES_VALIDATE:
-            prop->serdesValidate = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_SBMASTER_VALIDATE:
-            prop->sbmasterValidate = GetTlvBool(tlv + 3);
-        break;
-        case FM_TVL_API_SERDES_VALIDATE_TIMER:
-            prop->serdesValidateTimer = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TVL_API_SERDES_ACTION_UP_ALLOWED:
-            prop->serdesErrActionUpState = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_API_HNI_FLOW_ENTRIES_PER_VF:
-            prop->hniFlowEntriesPerVf = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_API_CPU_PORT_XCAST_MODE:
-            prop->cpuPortXCastMode = GetTlvBool(tlv + 3);
-        break;
+        FM_LOG_FATAL(FM_LOG_CAT_PLATFORM,
+            "Unhandled TLV type 0x%04x\n",
+            tlvType);
+        return FM_ERR_INVALID_ARGUMENT;
+    }
 
-#if defined(FM_SUPPORT_FM10000)
-        case FM_TLV_FM10K_WMSELECT:
-            CopyTlvStr(fm10kProp->wmSelect,
-                    sizeof(fm10kProp->wmSelect),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_CM_RX_SMP_PRIVATE_BYTES:
-            fm10kProp->cmRxSmpPrivBytes = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_CM_TX_TC_HOG_BYTES:
-            fm10kProp->cmTxTcHogBytes = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_CM_SMP_SD_VS_HOG_PERCENT:
-            fm10kProp->cmSmpSdVsHogPercent = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_CM_SMP_SD_JITTER_BITS:
-            fm10kProp->cmSmpSdJitterBits = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_CM_TX_SD_ON_PRIVATE:
-            fm10kProp->cmTxSdOnPrivate = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_CM_TX_SD_ON_SMP_FREE:
-            fm10kProp->cmTxSdOnSmpFree = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_CM_PAUSE_BUFFER_BYTES:
-            fm10kProp->cmPauseBufferBytes = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_MCAST_MAX_ENTRIES_PER_CAM:
-            fm10kProp->mcastMaxEntriesPerCam = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_UNICAST_SLICE_1ST:
-            fm10kProp->ffuUcastSliceRangeFirst = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_UNICAST_SLICE_LAST:
-            fm10kProp->ffuUcastSliceRangeLast = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_MULTICAST_SLICE_1ST:
-            fm10kProp->ffuMcastSliceRangeFirst = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_MULTICAST_SLICE_LAST:
-            fm10kProp->ffuMcastSliceRangeLast = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_ACL_SLICE_1ST:
-            fm10kProp->ffuAclSliceRangeFirst = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_ACL_SLICE_LAST:
-            fm10kProp->ffuAclSliceRangeLast = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_MAPMAC_ROUTING:
-            fm10kProp->ffuMapMacResvdForRoute = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_UNICAST_PRECEDENCE_MIN:
-            fm10kProp->ffuUcastPrecedenceMin = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_UNICAST_PRECEDENCE_MAX:
-            fm10kProp->ffuUcastPrecedenceMax = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_MULTICAST_PRECEDENCE_MIN:
-            fm10kProp->ffuMcastPrecedenceMin = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_MULTICAST_PRECEDENCE_MAX:
-            fm10kProp->ffuMcastPrecedenceMax = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_ACL_PRECEDENCE_MIN:
-            fm10kProp->ffuAclPrecedenceMin = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_ACL_PRECEDENCE_MAX:
-            fm10kProp->ffuAclPrecedenceMax = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_FFU_ACL_STRICT_COUNT_POLICE:
-            fm10kProp->ffuAclStrictCountPolice = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_INIT_UCAST_FLOODING_TRIGGERS:
-            fm10kProp->initUcastFloodTriggers = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_INIT_MCAST_FLOODING_TRIGGERS:
-            fm10kProp->initMcastFloodTriggers = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_INIT_BCAST_FLOODING_TRIGGERS:
-            fm10kProp->initBcastFloodTriggers = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_INIT_RESERVED_MAC_TRIGGERS:
-            fm10kProp->initResvdMacTriggers = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_FLOODING_TRAP_PRIORITY:
-            fm10kProp->floodingTrapPriority = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_AUTONEG_GENERATE_EVENTS:
-            fm10kProp->autonegGenerateEvents = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_LINK_DEPENDS_ON_DFE:
-            fm10kProp->linkDependsOfDfe = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_VN_USE_SHARED_ENCAP_FLOWS:
-            fm10kProp->vnUseSharedEncapFlows = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_VN_MAX_TUNNEL_RULES:
-            fm10kProp->vnMaxRemoteAddress = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_VN_TUNNEL_GROUP_HASH_SIZE:
-            fm10kProp->vnTunnelGroupHashSize = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_VN_TE_VID:
-            fm10kProp->vnTeVid = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_VN_ENCAP_ACL_NUM:
-            fm10kProp->vnEncapAclNumber = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_VN_DECAP_ACL_NUM:
-            fm10kProp->vnDecapAclNumber = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_MCAST_NUM_STACK_GROUPS:
-            fm10kProp->mcastNumStackGroups = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_VN_TUNNEL_ONLY_IN_INGRESS:
-            fm10kProp->vnTunnelOnlyOnIngress = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_MTABLE_CLEANUP_WATERMARK:
-            fm10kProp->mtableCleanupWm = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_SCHED_MODE:
-            CopyTlvStr(fm10kProp->schedMode,
-                    sizeof(fm10kProp->schedMode),
-                    tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_UPD_SCHED_ON_LNK_CHANGE:
-            fm10kProp->updateSchedOnLinkChange = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_CREATE_REMOTE_LOGICAL_PORTS:
-            fm10kProp->createRemoteLogicalPorts = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_AUTONEG_CLAUSE_37_TIMEOUT:
-            fm10kProp->autonegCl37Timeout = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_AUTONEG_SGMII_TIMEOUT:
-            fm10kProp->autonegSgmiiTimeout = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_HNI_SERVICES_LOOPBACK:
-            fm10kProp->useHniServicesLoopback = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_ANTI_BUBBLE_WM:
-            fm10kProp->antiBubbleWm = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_SERDES_OP_MODE:
-            fm10kProp->serdesOpMode = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_SERDES_DBG_LVL:
-            fm10kProp->serdesDbgLevel = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_PARITY_INTERRUPTS:
-            fm10kProp->parityEnableInterrupts = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_PARITY_TCAM_MONITOR:
-            fm10kProp->parityStartTcamMonitors = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_PARITY_CRM_TIMEOUT:
-            fm10kProp->parityCrmTimeout = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_SCHED_OVERSPEED:
-            fm10kProp->schedOverspeed = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_LINK_IGNORE_MASK:
-            fm10kProp->intrLinkIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_AUTONEG_IGNORE_MASK:
-            fm10kProp->intrAutonegIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_SERDES_IGNORE_MASK:
-            fm10kProp->intrSerdesIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_PCIE_IGNORE_MASK:
-            fm10kProp->intrPcieIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_MATCN_IGNORE_MASK:
-            fm10kProp->intrMaTcnIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_FHTAIL_IGNORE_MASK:
-            fm10kProp->intrFhTailIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_SW_IGNORE_MASK:
-            fm10kProp->intrSwIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_INTR_TE_IGNORE_MASK:
-            fm10kProp->intrTeIgnoreMask = GetTlvInt(tlv + 3, tlvLen);
-        break;
-        case FM_TLV_FM10K_EEE_SPICO_INTR:
-            fm10kProp->enableEeeSpicoIntr = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_USE_ALTERNATE_SPICO_FW:
-            fm10kProp->useAlternateSpicoFw = GetTlvBool(tlv + 3);
-        break;
-        case FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE:
-            fm10kProp->allowKrPcalOnEee = GetTlvBool(tlv + 3);
-        break;
-#endif
+    switch (desc->type)
+    {
+        case FM_API_ATTR_INT:
+            SetPropertyInt(desc, GetTlvInt(tlv + 3, tlvLen));
+            break;
+
+        case FM_API_ATTR_BOOL:
+            SetPropertyBool(desc, GetTlvBool(tlv + 3));
+            break;
+
+        case FM_API_ATTR_TEXT:
+            CopyTlvStr(GetPropertyPtr(desc), desc->size, tlv + 3, tlvLen);
+            break;
 
         default:
             FM_LOG_FATAL(FM_LOG_CAT_PLATFORM,
-                "Unhandled TLV type 0x%04x\n",
+                "Unhandled type %d for TLV type 0x%04x\n",
+                desc->type,
                 tlvType);
             return FM_ERR_INVALID_ARGUMENT;
     }
@@ -930,16 +1072,18 @@ fm_status fmLoadApiPropertyTlv(fm_byte *tlv)
  *                  value is stored. Its type is assumed to match attrType.
  *
  * \return          FM_OK on success.
+ * \return          FM_ERR_NOT_FOUND if the key is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if attrType does not match the
+ *                  type of the property.
  *
  *****************************************************************************/
 fm_status fmSetApiProperty(fm_text        key,
                            fm_apiAttrType attrType,
                            void *         value)
 {
-    fm_status      err;
-    fm_status      err2;
-    fm_byte        tlv[FM_TLV_MAX_BUF_SIZE];
-    fm_char        line[512];
+    const fm_propertyDesc *desc;
+    fm_status              err;
+    fm_status              err2;
 
     FM_LOG_ENTRY_API(FM_LOG_CAT_ATTR,
                      "key=%s type=%d value=%p\n",
@@ -953,60 +1097,49 @@ fm_status fmSetApiProperty(fm_text        key,
         FM_LOG_EXIT_API(FM_LOG_CAT_ATTR, err);
     }
 
-    
+    desc = FindPropertyByKey(key);
+
+    if (desc == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ATTR,
+                     "Unable to set unknown API property %s\n",
+                     key);
+        err = FM_ERR_NOT_FOUND;
+        goto ABORT;
+    }
+
+    if (attrType != desc->type)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ATTR,
+                     "%s: Got type %d but expected %d\n",
+                     key, attrType, desc->type);
+        err = FM_ERR_INVALID_ARGUMENT;
+        goto ABORT;
+    }
+
     switch (attrType)
     {
         case FM_API_ATTR_INT:
-            FM_SPRINTF_S(line,
-                        sizeof(line),
-                        "%s int %d",
-                        key,
-                        *(fm_int*)value);
+            SetPropertyInt(desc, *(fm_int *) value);
             break;
 
         case FM_API_ATTR_BOOL:
-            FM_SPRINTF_S(line,
-                        sizeof(line),
-                        "%s bool %d",
-                        key,
-                        *(fm_bool*)value);
-            break;
-
-        case FM_API_ATTR_FLOAT:
-            FM_SPRINTF_S(line,
-                        sizeof(line),
-                        "%s float %f",
-                        key,
-                        *(fm_float*)value);
+            SetPropertyBool(desc, *(fm_bool *) value);
             break;
 
         case FM_API_ATTR_TEXT:
-            FM_SPRINTF_S(line,
-                        sizeof(line),
-                        "%s text %s",
-                        key,
-                        (fm_text)value);
+            SetPropertyText(desc, (fm_text) value);
             break;
 
         default:
             FM_LOG_FATAL(FM_LOG_CAT_ATTR,
                          "Unknown type %d for set of property %s\n",
                          attrType, key);
-            goto ABORT;
+            err = FM_ERR_INVALID_ARGUMENT;
+            break;
 
     }   /* end switch (attrType) */
 
-    err = fmUtilConfigPropertyEncodeTlv(line, tlv, sizeof(tlv));
-
-    if (err)
-    {
-        FM_LOG_ERROR(FM_LOG_CAT_ATTR,
-            "Unable to encode API property: [%s]\n", line);
-        goto ABORT;
-    }
-
-    err = fmLoadApiPropertyTlv(tlv);
-
 ABORT:
 
     err2 = fmReleaseLock(&fmRootAlos->propertyLock);
@@ -1041,863 +1174,76 @@ ABORT:
  *                  value will be stored.
  *
  * \return          FM_OK on success.
- * \return          FM_ERR_KEY_NOT_FOUND if the key is invalid.
+ * \return          FM_ERR_INVALID_ARGUMENT if the key is invalid or
+ *                  attrType does not match the type of the property.
  *
  *****************************************************************************/
 fm_status fmGetApiProperty(fm_text        key,
                            fm_apiAttrType attrType,
-                           void *         value)
-{
-    fm_status       err       = FM_OK;
-    fm_apiAttrType  expType   = FM_API_ATTR_MAX;
-    fm_int          valInt    = 0;
-    fm_bool         valBool   = FALSE;
-    fm_float        valFloat  = 0;
-    fm_text         valText   = NULL;
-    fm_property     *prop;
-#if defined(FM_SUPPORT_FM10000)
-    fm10000_property *fm10kProp;
-#endif
-
-    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ATTR,
-                         "key=%s value=%p\n",
-                         key,
-                         value);
-
-    err = fmCaptureLock(&fmRootAlos->propertyLock, FM_WAIT_FOREVER);
-    if (err != FM_OK)
-    {
-        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
-    }
-
-    prop = GET_PROPERTY();
-
-    if (strcmp(key, FM_AAK_API_STP_DEF_STATE_VLAN_MEMBER) == 0)
-    {
-        valInt = prop->defStateVlanMember;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_DIRECT_SEND_TO_CPU) == 0)
-    {
-        valBool = prop->directSendToCpu;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_STP_DEF_STATE_VLAN_NON_MEMBER) == 0)
-    {
-        valInt = prop->defStateVlanNonMember;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_IDENTIFYSWITCH) == 0)
-    {
-        valBool = prop->bootIdentifySw;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_RESET) == 0)
-    {
-        valBool = prop->bootReset;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_AUTOINSERTSWITCH) == 0)
-    {
-        valBool = prop->autoInsertSwitches;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_BOOT_RESET_TIME) == 0)
-    {
-        valInt = prop->deviceResetTime;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_AUTO_ENABLE_SWAG_LINKS) == 0)
-    {
-        valBool = prop->swagAutoEnableLinks;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FREE_EVENT_BLOCK_THRESHOLD) == 0)
-    {
-        valInt = prop->eventBlockThreshold;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_FREE_EVENT_UNBLOCK_THRESHOLD) == 0)
-    {
-        valInt = prop->eventUnblockThreshold;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_EVENT_SEM_TIMEOUT) == 0)
-    {
-        valInt = prop->eventSemTimeout;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RX_DIRECT_ENQUEUEING) == 0)
-    {
-        valBool = prop->rxDirectEnqueueing;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RX_DRV_DEST) == 0)
-    {
-        valInt = prop->rxDriverDestinations;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_ASYNC_LAG_DELETION) == 0)
-    {
-        valBool = prop->lagAsyncDeletion;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_STATIC_ADDR) == 0)
-    {
-        valBool = prop->maEventOnStaticAddr;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_DYNAMIC_ADDR) == 0)
-    {
-        valBool = prop->maEventOnDynAddr;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_EVENT_ON_ADDR_CHANGE) == 0)
-    {
-        valBool = prop->maEventOnAddrChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_PORT_DOWN) == 0)
-    {
-        valBool = prop->maFlushOnPortDown;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_VLAN_CHANGE) == 0)
-    {
-        valBool = prop->maFlushOnVlanChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_FLUSH_ON_LAG_CHANGE) == 0)
-    {
-        valBool = prop->maFlushOnLagChange;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_TCN_FIFO_BURST_SIZE) == 0)
-    {
-        valInt = prop->maTcnFifoBurstSize;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_INTERNAL_VLAN_STATS) == 0)
-    {
-        valBool = prop->swagIntVlanStats;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PER_LAG_MANAGEMENT) == 0)
-    {
-        valBool = prop->perLagManagement;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PARITY_REPAIR_ENABLE) == 0)
-    {
-        valBool = prop->parityRepairEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_MAX_ACL_PORT_SETS) == 0)
-    {
-        valInt = prop->swagMaxAclPortSets;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_MAX_PORT_SETS) == 0)
-    {
-        valInt = prop->maxPortSets;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PACKET_RECEIVE_ENABLE) == 0)
-    {
-        valBool = prop->packetReceiveEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_1_ADDR_PER_MCAST_GROUP) == 0)
-    {
-        valBool = prop->multicastSingleAddress;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_POSITION) == 0)
-    {
-        valInt = prop->modelPosition;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_NUM_VN_TUNNEL_NEXTHOPS) == 0)
-    {
-        valInt = prop->vnNumNextHops;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_VN_ENCAP_PROTOCOL) == 0)
-    {
-        valInt = prop->vnEncapProtocol;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_VN_ENCAP_VERSION) == 0)
-    {
-        valInt = prop->vnEncapVersion;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_SUPPORT_ROUTE_LOOKUPS) == 0)
-    {
-        valBool = prop->supportRouteLookups;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_ROUTING_MAINTENANCE_ENABLE) == 0)
-    {
-        valBool = prop->routeMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_AUTO_VLAN2_TAGGING) == 0)
-    {
-        valBool = prop->autoVlan2Tagging;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_DEBUG_BOOT_INTERRUPT_HANDLER) == 0)
-    {
-        valBool = prop->interruptHandlerDisable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MA_TABLE_MAINTENENANCE_ENABLE) == 0)
-    {
-        valBool = prop->maTableMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FAST_MAINTENANCE_ENABLE) == 0)
-    {
-        valBool = prop->fastMaintenanceEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_FAST_MAINTENANCE_PERIOD) == 0)
-    {
-        valInt = prop->fastMaintenancePer;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_STRICT_GLORT_PHYSICAL) == 0)
-    {
-        valBool = prop->strictGlotPhysical;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_RESET_WATERMARK_AT_PAUSE_OFF) == 0)
-    {
-        valBool = prop->resetWmAtPauseOff;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_SUB_SWITCHES) == 0)
-    {
-        valBool = prop->swagAutoSubSwitches;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_INTERNAL_PORTS) == 0)
-    {
-        valBool = prop->swagAutoIntPorts;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SWAG_AUTO_VN_VSI) == 0)
-    {
-        valBool = prop->swagAutoVNVsi;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_BYPASS_ENABLE) == 0)
-    {
-        valBool = prop->byPassEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_LAG_DELETE_SEMAPHORE_TIMEOUT) == 0)
-    {
-        valInt = prop->lagDelSemTimeout;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_STP_ENABLE_INTERNAL_PORT_CTRL) == 0)
-    {
-        valBool = prop->stpEnIntPortCtrl;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_PORT_MAP_TYPE) == 0)
-    {
-        valInt = prop->modelPortMapType;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_SWITCH_TYPE) == 0)
-    {
-        valText = prop->modelSwitchType;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_SEND_EOT) == 0)
-    {
-        valBool = prop->modelSendEOT;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_LOG_EGRESS_INFO) == 0)
-    {
-        valBool = prop->modelLogEgressInfo;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_ENABLE_REF_CLOCK) == 0)
-    {
-        valBool = prop->enableRefClock;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SET_REF_CLOCK) == 0)
-    {
-        valBool = prop->setRefClock;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PRIORITY_BUFFER_QUEUES) == 0)
-    {
-        valBool = prop->priorityBufQueues;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PKT_SCHED_TYPE) == 0)
-    {
-        valInt = prop->pktSchedType;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE) == 0)
-    {
-        valBool = prop->separateBufPoolEnable;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_NUM_BUFFERS_RX) == 0)
-    {
-        valInt = prop->numBuffersRx;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_NUM_BUFFERS_TX) == 0)
-    {
-        valInt = prop->numBuffersTx;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_PKT_INTERFACE) == 0)
-    {
-        valText = prop->modelPktInterface;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_PKT_INTERFACE) == 0)
-    {
-        valText = prop->pktInterface;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_NAME) == 0)
-    {
-        valText = prop->modelTopologyName;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH) == 0)
-    {
-        valBool = prop->modelUseModelPath;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_IP) == 0)
-    {
-        valText = prop->modelDevBoardIp;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_PORT) == 0)
-    {
-        valInt = prop->modelDevBoardPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_DEVICE_CFG) == 0)
-    {
-        valInt = prop->modelDeviceCfg;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_MODEL_CHIP_VERSION) == 0)
-    {
-        valInt = prop->modelChipVersion;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_SBUS_SERVER_PORT) == 0)
-    {
-        valInt = prop->sbusServerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_PLATFORM_IS_WHITE_MODEL) == 0)
-    {
-        valBool = prop->isWhiteModel;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DEBUG_INIT_LOGGING_CAT) == 0)
-    {
-        valText = prop->initLoggingCat;
-        expType = FM_API_ATTR_TEXT;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ADD_PEPS_TO_FLOODING) == 0)
-    {
-        valBool = prop->addPepsToFlooding;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ALLOW_FTAG_VLAN_TAGGING) == 0)
-    {
-        valBool = prop->allowFtagVlanTagging;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SCH_IGNORE_BW_VIOLATION) == 0)
-    {
-        valBool = (prop->ignoreBwViolation == 1);
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SCH_IGNORE_BW_VIOLATION_NO_WARNING) == 0)
-    {
-        valBool = (prop->ignoreBwViolation == 2);
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ALLOW_EARLY_LINK_UP_MODE) == 0)
-    {
-        valBool = prop->dfeAllowEarlyLinkUp;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ALLOW_KR_PCAL_MODE) == 0)
-    {
-        valBool = prop->dfeAllowKrPcal;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_DFE_ENABLE_SIGNALOK_DEBOUNCING) == 0)
-    {
-        valBool = prop->dfeEnableSigOkDebounce;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_PORT_ENABLE_STATUS_POLLING) == 0)
-    {
-        valBool = prop->enableStatusPolling;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_GSME_TIMESTAMP_MODE) == 0)
-    {
-        valBool = prop->gsmeTimestampMode;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_MULTICAST_HNI_FLOODING) == 0)
-    {
-        valBool = prop->hniMcastFlooding;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP) == 0)
-    {
-        valInt = prop->hniMacEntriesPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_MAC_ENTRIES_PER_PORT) == 0)
-    {
-        valInt = prop->hniMacEntriesPerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PEP) == 0)
-    {
-        valInt = prop->hniInnOutEntriesPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PORT) == 0)
-    {
-        valInt = prop->hniInnOutEntriesPerPort;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC) == 0)
-    {
-        valBool = prop->anTimerAllowOutSpec;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_VALIDATE) == 0)
-    {
-        valBool = prop->serdesValidate;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SBM_VALIDATE) == 0)
-    {
-        valBool = prop->sbmasterValidate;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_ACTION_IN_UP_STATE) == 0)
-    {
-        valBool = prop->serdesErrActionUpState;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_SERDES_VALIDATE_TIMER) == 0)
-    {
-        valInt = prop->serdesValidateTimer;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_FLOW_ENTRIES_VF) == 0)
-    {
-        valInt = prop->hniFlowEntriesPerVf;
-        expType = FM_API_ATTR_INT;
-    }
-    else if (strcmp(key, FM_AAK_API_CPU_PORT_XCAST_MODE) == 0)
-    {
-        valBool = prop->cpuPortXCastMode;
-        expType = FM_API_ATTR_BOOL;
-    }
-    else if (strcmp(key, FM_AAK_API_HNI_GLORTS_PER_PEP) == 0)
-    {
-        valInt = prop->hniGlortsPerPep;
-        expType = FM_API_ATTR_INT;
-    }
-
+                           void *         value)
+{
+    const fm_propertyDesc *desc;
+    fm_status              err;
+    fm_status              err2;
 
-#if defined(FM_SUPPORT_FM10000)
+    FM_LOG_ENTRY_VERBOSE(FM_LOG_CAT_ATTR,
+                         "key=%s value=%p\n",
+                         key,
+                         value);
 
-    if (expType == FM_API_ATTR_MAX && 
-        strncmp(key, "api.FM10000.", 12) == 0)
+    err = fmCaptureLock(&fmRootAlos->propertyLock, FM_WAIT_FOREVER);
+    if (err != FM_OK)
     {
-        fm10kProp = GET_FM10000_PROPERTY();
-
-        if (strcmp(key, FM_AAK_API_FM10000_WMSELECT) == 0)
-        {
-            valText = fm10kProp->wmSelect;
-            expType = FM_API_ATTR_TEXT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_RX_SMP_PRIVATE_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmRxSmpPrivBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_TC_HOG_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmTxTcHogBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_SMP_SD_VS_HOG_PERCENT) == 0)
-        {
-            valInt = fm10kProp->cmSmpSdVsHogPercent;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_SMP_SD_JITTER_BITS) == 0)
-        {
-            valBool = fm10kProp->cmSmpSdJitterBits;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_SD_ON_PRIVATE) == 0)
-        {
-            valBool = fm10kProp->cmTxSdOnPrivate;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_TX_SD_ON_SMP_FREE) == 0)
-        {
-            valBool = fm10kProp->cmTxSdOnSmpFree;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CM_PAUSE_BUFFER_BYTES) == 0)
-        {
-            valInt = fm10kProp->cmPauseBufferBytes;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MCAST_MAX_ENTRIES_PER_CAM) == 0)
-        {
-            valInt = fm10kProp->mcastMaxEntriesPerCam;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuUcastSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuUcastSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuMcastSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuMcastSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_SLICE_1ST) == 0)
-        {
-            valInt = fm10kProp->ffuAclSliceRangeFirst;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_SLICE_LAST) == 0)
-        {
-            valInt = fm10kProp->ffuAclSliceRangeLast;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MAPMAC_ROUTING) == 0)
-        {
-            valInt = fm10kProp->ffuMapMacResvdForRoute;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuUcastPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuUcastPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuMcastPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuMcastPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MIN) == 0)
-        {
-            valInt = fm10kProp->ffuAclPrecedenceMin;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MAX) == 0)
-        {
-            valInt = fm10kProp->ffuAclPrecedenceMax;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FFU_ACL_STRICT_COUNT_POLICE) == 0)
-        {
-            valBool = fm10kProp->ffuAclStrictCountPolice;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_UCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initUcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_MCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initMcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_BCAST_FLOODING_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initBcastFloodTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INIT_RESERVED_MAC_TRIGGERS) == 0)
-        {
-            valBool = fm10kProp->initResvdMacTriggers;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_FLOODING_TRAP_PRIORITY) == 0)
-        {
-            valInt = fm10kProp->floodingTrapPriority;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_GENERATE_EVENTS) == 0)
-        {
-            valBool = fm10kProp->autonegGenerateEvents;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_LINK_DEPENDS_ON_DFE) == 0)
-        {
-            valBool = fm10kProp->linkDependsOfDfe;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_USE_SHARED_ENCAP_FLOWS) == 0)
-        {
-            valBool = fm10kProp->vnUseSharedEncapFlows;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_MAX_TUNNEL_RULES) == 0)
-        {
-            valInt = fm10kProp->vnMaxRemoteAddress;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE) == 0)
-        {
-            valInt = fm10kProp->vnTunnelGroupHashSize;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TE_VID) == 0)
-        {
-            valInt = fm10kProp->vnTeVid;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_ENCAP_ACL_NUM) == 0)
-        {
-            valInt = fm10kProp->vnEncapAclNumber;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_DECAP_ACL_NUM) == 0)
-        {
-            valInt = fm10kProp->vnDecapAclNumber;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MCAST_NUM_STACK_GROUPS) == 0)
-        {
-            valInt = fm10kProp->mcastNumStackGroups;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS) == 0)
-        {
-            valBool = fm10kProp->vnTunnelOnlyOnIngress;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_MTABLE_CLEANUP_WATERMARK) == 0)
-        {
-            valInt = fm10kProp->mtableCleanupWm;
-            expType = FM_API_ATTR_INT;
-        }
-       else if (strcmp(key, FM_AAK_API_FM10000_SCHED_MODE) == 0)
-        {
-            valText = fm10kProp->schedMode;
-            expType = FM_API_ATTR_TEXT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_UPD_SCHED_ON_LNK_CHANGE) == 0)
-        {
-            valBool = fm10kProp->updateSchedOnLinkChange;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CREATE_REMOTE_LOGICAL_PORTS) == 0)
-        {
-            valBool = fm10kProp->createRemoteLogicalPorts;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT) == 0)
-        {
-            valInt = fm10kProp->autonegCl37Timeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_AUTONEG_SGMII_TIMEOUT) == 0)
-        {
-            valInt = fm10kProp->autonegSgmiiTimeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_HNI_SERVICES_LOOPBACK) == 0)
-        {
-            valBool = fm10kProp->useHniServicesLoopback;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ANTI_BUBBLE_WM) == 0)
-        {
-            valInt = fm10kProp->antiBubbleWm;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SERDES_OP_MODE) == 0)
-        {
-            valInt = fm10kProp->serdesOpMode;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SERDES_DBG_LVL) == 0)
-        {
-            valInt = fm10kProp->serdesDbgLevel;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_PARITY_INTERRUPTS) == 0)
-        {
-            valBool = fm10kProp->parityEnableInterrupts;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_START_TCAM_MONITORS) == 0)
-        {
-            valBool = fm10kProp->parityStartTcamMonitors;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_CRM_TIMEOUT) == 0)
-        {
-            valBool = fm10kProp->parityCrmTimeout;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_SCHED_OVERSPEED) == 0)
-        {
-            valInt = fm10kProp->schedOverspeed;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_LINK_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrLinkIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_AUTONEG_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrAutonegIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_SERDES_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrSerdesIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_PCIE_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrPcieIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_MATCN_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrMaTcnIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_FHTAIL_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrFhTailIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_SW_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrSwIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_INTR_TE_IGNORE_MASK) == 0)
-        {
-            valInt = fm10kProp->intrTeIgnoreMask;
-            expType = FM_API_ATTR_INT;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ENABLE_EEE_SPICO_INTR) == 0)
-        {
-            valBool = fm10kProp->enableEeeSpicoIntr;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_USE_ALTERNATE_SPICO_FW) == 0)
-        {
-            valBool = fm10kProp->useAlternateSpicoFw;
-            expType = FM_API_ATTR_BOOL;
-        }
-        else if (strcmp(key, FM_AAK_API_FM10000_ALLOW_KRPCAL_ON_EEE) == 0)
-        {
-            valBool = fm10kProp->allowKrPcalOnEee;
-            expType = FM_API_ATTR_BOOL;
-        }
+        FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
     }
-#endif
 
-    err = fmReleaseLock(&fmRootAlos->propertyLock);
+    desc = FindPropertyByKey(key);
 
-    if (expType != FM_API_ATTR_MAX)
+    if (desc == NULL)
+    {
+        FM_LOG_FATAL(FM_LOG_CAT_ATTR,
+                     "Property %s not found\n",
+                     key);
+        err = FM_ERR_INVALID_ARGUMENT;
+    }
+    else if (attrType != desc->type)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_ATTR,
+                     "%s: Got type %d but expected %d\n",
+                     key, attrType, desc->type);
+        err = FM_ERR_INVALID_ARGUMENT;
+    }
+    else
     {
-        if (attrType != expType)
-        {
-            FM_LOG_ERROR(FM_LOG_CAT_ATTR,
-                         "%s: Got type %d but expected %d\n",
-                         key, attrType, expType);
-        
-            FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, FM_ERR_INVALID_ARGUMENT);
-        }
-
         switch (attrType)
         {
             case FM_API_ATTR_INT:
-                *(fm_int *)value = valInt;
+                *(fm_int *) value = GetPropertyInt(desc);
                 break;
 
             case FM_API_ATTR_BOOL:
-                *(fm_bool *)value = valBool;
-                break;
-
-            case FM_API_ATTR_FLOAT:
-                *(fm_float *)value = valFloat;
+                *(fm_bool *) value = GetPropertyBool(desc);
                 break;
 
             case FM_API_ATTR_TEXT:
-                *(fm_text *)value = valText;
+                *(fm_text *) value = (fm_text) GetPropertyPtr(desc);
                 break;
 
             default:
                 FM_LOG_FATAL(FM_LOG_CAT_ATTR,
                              "Unknown type %d for get of property %s\n",
                              attrType, key);
+                err = FM_ERR_INVALID_ARGUMENT;
+                break;
 
-        }   /* end switch (attrEntry->type) */
+        }   /* end switch (attrType) */
     }
-    else
+
+    err2 = fmReleaseLock(&fmRootAlos->propertyLock);
+
+    if (err == FM_OK && err2)
     {
-        FM_LOG_FATAL(FM_LOG_CAT_ATTR,
-                     "Property %s not found\n",
-                     key);
-        err = FM_ERR_INVALID_ARGUMENT;
+        err = err2;
     }
 
     FM_LOG_EXIT_VERBOSE(FM_LOG_CAT_ATTR, err);
@@ -2106,6 +1452,134 @@ fm_text fmGetTextApiProperty(fm_text key, fm_text defaultValue)
 
 
 
+/*****************************************************************************/
+/** fmGetApiPropertyFirst
+ * \ingroup api
+ *
+ * \desc            Retrieves the key of the first API property, for
+ *                  enumerating all properties (for example to save the
+ *                  running configuration).
+ *
+ * \param[out]      firstKey points to caller allocated storage where the
+ *                  key of the first property will be stored. The string
+ *                  is owned by the API and must not be modified.
+ *
+ * \param[out]      attrType points to caller allocated storage where the
+ *                  type of the property will be stored. May be NULL.
+ *
+ * \return          FM_OK on success.
+ * \return          FM_ERR_INVALID_ARGUMENT if firstKey is NULL.
+ * \return          FM_ERR_NO_MORE if there are no properties.
+ *
+ *****************************************************************************/
+fm_status fmGetApiPropertyFirst(fm_text *firstKey, fm_apiAttrType *attrType)
+{
+    fm_status err;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ATTR,
+                     "firstKey=%p attrType=%p\n",
+                     (void *) firstKey,
+                     (void *) attrType);
+
+    if (firstKey == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+    }
+    else if (NUM_PROPERTIES == 0)
+    {
+        err = FM_ERR_NO_MORE;
+    }
+    else
+    {
+        *firstKey = propertyTable[0].key;
+
+        if (attrType != NULL)
+        {
+            *attrType = propertyTable[0].type;
+        }
+
+        err = FM_OK;
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ATTR, err);
+
+}   /* end fmGetApiPropertyFirst */
+
+
+
+
+/*****************************************************************************/
+/** fmGetApiPropertyNext
+ * \ingroup api
+ *
+ * \desc            Retrieves the key of the API property following the
+ *                  given one.
+ *
+ * \param[in]       startKey is the key of the previous property, as
+ *                  returned by ''fmGetApiPropertyFirst'' or a prior call to
+ *                  this function.
+ *
+ * \param[out]      nextKey points to caller allocated storage where the
+ *                  key of the next property will be stored. The string
+ *                  is owned by the API and must not be modified.
+ *
+ * \param[out]      attrType points to caller allocated storage where the
+ *                  type of the property will be stored. May be NULL.
+ *
+ * \return          FM_OK on success.
+ * \return          FM_ERR_INVALID_ARGUMENT if startKey is not a valid key
+ *                  or nextKey is NULL.
+ * \return          FM_ERR_NO_MORE if startKey is the last property.
+ *
+ *****************************************************************************/
+fm_status fmGetApiPropertyNext(fm_text         startKey,
+                               fm_text *       nextKey,
+                               fm_apiAttrType *attrType)
+{
+    const fm_propertyDesc *desc;
+    fm_status              err;
+    fm_int                 next;
+
+    FM_LOG_ENTRY_API(FM_LOG_CAT_ATTR,
+                     "startKey=%s nextKey=%p attrType=%p\n",
+                     startKey,
+                     (void *) nextKey,
+                     (void *) attrType);
+
+    desc = FindPropertyByKey(startKey);
+
+    if (desc == NULL || nextKey == NULL)
+    {
+        err = FM_ERR_INVALID_ARGUMENT;
+    }
+    else
+    {
+        next = (fm_int) (desc - propertyTable) + 1;
+
+        if (next >= NUM_PROPERTIES)
+        {
+            err = FM_ERR_NO_MORE;
+        }
+        else
+        {
+            *nextKey = propertyTable[next].key;
+
+            if (attrType != NULL)
+            {
+                *attrType = propertyTable[next].type;
+            }
+
+            err = FM_OK;
+        }
+    }
+
+    FM_LOG_EXIT_API(FM_LOG_CAT_ATTR, err);
+
+}   /* end fmGetApiPropertyNext */
+
+
+
+
 /*****************************************************************************/
 /** fmDbgDumpApiProperties
  * \ingroup diagMisc
@@ -2119,180 +1593,44 @@ fm_text fmGetTextApiProperty(fm_text key, fm_text defaultValue)
  *****************************************************************************/
 void fmDbgDumpApiProperties(void)
 {
-    fm_property *prop;
-#if defined(FM_SUPPORT_FM10000)
-    fm10000_property *fm10kProp;
-#endif
-
-    prop = GET_PROPERTY();
+    const fm_propertyDesc *desc;
+    fm_int                 i;
 
     FM_LOG_PRINT("##########################################################\n");
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_IS_WHITE_MODEL, TFSTR(prop->isWhiteModel));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_STP_DEF_STATE_VLAN_MEMBER, prop->defStateVlanMember);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_DIRECT_SEND_TO_CPU, TFSTR(prop->directSendToCpu));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_STP_DEF_STATE_VLAN_NON_MEMBER, prop->defStateVlanNonMember);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_DEBUG_BOOT_IDENTIFYSWITCH, TFSTR(prop->bootIdentifySw));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_DEBUG_BOOT_RESET, TFSTR(prop->bootReset));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_DEBUG_BOOT_AUTOINSERTSWITCH, TFSTR(prop->autoInsertSwitches));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_BOOT_RESET_TIME, prop->deviceResetTime);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_AUTO_ENABLE_SWAG_LINKS, TFSTR(prop->swagAutoEnableLinks));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FREE_EVENT_BLOCK_THRESHOLD, prop->eventBlockThreshold);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FREE_EVENT_UNBLOCK_THRESHOLD, prop->eventUnblockThreshold);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_EVENT_SEM_TIMEOUT, prop->eventSemTimeout);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PACKET_RX_DIRECT_ENQUEUEING, TFSTR(prop->rxDirectEnqueueing));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PACKET_RX_DRV_DEST, prop->rxDriverDestinations);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_ASYNC_LAG_DELETION, TFSTR(prop->lagAsyncDeletion));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_EVENT_ON_STATIC_ADDR, TFSTR(prop->maEventOnStaticAddr));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_EVENT_ON_DYNAMIC_ADDR, TFSTR(prop->maEventOnDynAddr));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_EVENT_ON_ADDR_CHANGE, TFSTR(prop->maEventOnAddrChange));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_FLUSH_ON_PORT_DOWN, TFSTR(prop->maFlushOnPortDown));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_FLUSH_ON_VLAN_CHANGE, TFSTR(prop->maFlushOnVlanChange));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_FLUSH_ON_LAG_CHANGE, TFSTR(prop->maFlushOnLagChange));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MA_TCN_FIFO_BURST_SIZE, prop->maTcnFifoBurstSize);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SWAG_INTERNAL_VLAN_STATS, TFSTR(prop->swagIntVlanStats));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PER_LAG_MANAGEMENT, TFSTR(prop->perLagManagement));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PARITY_REPAIR_ENABLE, TFSTR(prop->parityRepairEnable));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_SWAG_MAX_ACL_PORT_SETS, prop->swagMaxAclPortSets);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_MAX_PORT_SETS, prop->maxPortSets);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PACKET_RECEIVE_ENABLE, TFSTR(prop->packetReceiveEnable));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_1_ADDR_PER_MCAST_GROUP, TFSTR(prop->multicastSingleAddress));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_MODEL_POSITION, prop->modelPosition);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_NUM_VN_TUNNEL_NEXTHOPS, prop->vnNumNextHops);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_VN_ENCAP_PROTOCOL, prop->vnEncapProtocol);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_VN_ENCAP_VERSION, prop->vnEncapVersion);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SUPPORT_ROUTE_LOOKUPS, TFSTR(prop->supportRouteLookups));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_ROUTING_MAINTENANCE_ENABLE, TFSTR(prop->routeMaintenanceEnable));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_AUTO_VLAN2_TAGGING, TFSTR(prop->autoVlan2Tagging));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_GLORTS_PER_PEP, prop->hniGlortsPerPep);
-
-
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_DEBUG_BOOT_INTERRUPT_HANDLER, TFSTR(prop->interruptHandlerDisable));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MA_TABLE_MAINTENENANCE_ENABLE, TFSTR(prop->maTableMaintenanceEnable));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FAST_MAINTENANCE_ENABLE, TFSTR(prop->fastMaintenanceEnable));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FAST_MAINTENANCE_PERIOD, prop->fastMaintenancePer);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_STRICT_GLORT_PHYSICAL, TFSTR(prop->strictGlotPhysical));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_RESET_WATERMARK_AT_PAUSE_OFF, TFSTR(prop->resetWmAtPauseOff));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SWAG_AUTO_SUB_SWITCHES, TFSTR(prop->swagAutoSubSwitches));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SWAG_AUTO_INTERNAL_PORTS, TFSTR(prop->swagAutoIntPorts));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SWAG_AUTO_VN_VSI, TFSTR(prop->swagAutoVNVsi));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_BYPASS_ENABLE, TFSTR(prop->byPassEnable));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_LAG_DELETE_SEMAPHORE_TIMEOUT, prop->lagDelSemTimeout);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_STP_ENABLE_INTERNAL_PORT_CTRL, TFSTR(prop->stpEnIntPortCtrl));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_MODEL_PORT_MAP_TYPE, prop->modelPortMapType);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_PLATFORM_MODEL_SWITCH_TYPE, prop->modelSwitchType);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_MODEL_SEND_EOT, TFSTR(prop->modelSendEOT));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_MODEL_LOG_EGRESS_INFO, TFSTR(prop->modelLogEgressInfo));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_ENABLE_REF_CLOCK, TFSTR(prop->enableRefClock));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_SET_REF_CLOCK, TFSTR(prop->setRefClock));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_PRIORITY_BUFFER_QUEUES, TFSTR(prop->priorityBufQueues));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_PKT_SCHED_TYPE, prop->pktSchedType);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_SEPARATE_BUFFER_POOL_ENABLE, TFSTR(prop->separateBufPoolEnable));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_NUM_BUFFERS_RX, prop->numBuffersRx);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_NUM_BUFFERS_TX, prop->numBuffersTx);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_PLATFORM_MODEL_PKT_INTERFACE, prop->modelPktInterface);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_PLATFORM_PKT_INTERFACE, prop->pktInterface);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_NAME, prop->modelTopologyName);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PLATFORM_MODEL_TOPOLOGY_USE_MODEL_PATH, TFSTR(prop->modelUseModelPath));
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_IP, prop->modelDevBoardIp);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_MODEL_DEV_BOARD_PORT, prop->modelDevBoardPort);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_MODEL_DEVICE_CFG, prop->modelDeviceCfg);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_MODEL_CHIP_VERSION, prop->modelChipVersion);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_PLATFORM_SBUS_SERVER_PORT, prop->sbusServerPort);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_DEBUG_INIT_LOGGING_CAT, prop->initLoggingCat);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PORT_ADD_PEPS_TO_FLOODING, TFSTR(prop->addPepsToFlooding));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PORT_ALLOW_FTAG_VLAN_TAGGING, TFSTR(prop->allowFtagVlanTagging));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SCH_IGNORE_BW_VIOLATION_NO_WARNING, TFSTR(prop->ignoreBwViolation == 2));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_SCH_IGNORE_BW_VIOLATION, TFSTR(prop->ignoreBwViolation == 1));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_DFE_ALLOW_EARLY_LINK_UP_MODE, TFSTR(prop->dfeAllowEarlyLinkUp));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_DFE_ALLOW_KR_PCAL_MODE, TFSTR(prop->dfeAllowKrPcal));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_DFE_ENABLE_SIGNALOK_DEBOUNCING, TFSTR(prop->dfeEnableSigOkDebounce));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_PORT_ENABLE_STATUS_POLLING, TFSTR(prop->enableStatusPolling));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_GSME_TIMESTAMP_MODE, prop->gsmeTimestampMode);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_MULTICAST_HNI_FLOODING, TFSTR(prop->hniMcastFlooding));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_MAC_ENTRIES_PER_PEP, prop->hniMacEntriesPerPep);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_MAC_ENTRIES_PER_PORT, prop->hniMacEntriesPerPort);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PEP, prop->hniInnOutEntriesPerPep);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_INN_OUT_ENTRIES_PER_PORT, prop->hniInnOutEntriesPerPort);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_AN_INHBT_TIMER_ALLOW_OUT_OF_SPEC, TFSTR(prop->anTimerAllowOutSpec));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_SERDES_VALIDATE, prop->serdesValidate);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_SBM_VALIDATE, prop->sbmasterValidate);
-    FM_LOG_PRINT(_FORMAT_I,
-                 FM_AAK_API_SERDES_VALIDATE_TIMER,
-                 prop->serdesValidateTimer);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_HNI_FLOW_ENTRIES_VF, prop->hniFlowEntriesPerVf);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_CPU_PORT_XCAST_MODE, TFSTR(prop->cpuPortXCastMode));
 
-#if defined(FM_SUPPORT_FM10000)
-    FM_LOG_PRINT("############################################################\n");
-
-    fm10kProp = GET_FM10000_PROPERTY();
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_FM10000_WMSELECT, fm10kProp->wmSelect);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CM_RX_SMP_PRIVATE_BYTES, fm10kProp->cmRxSmpPrivBytes);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CM_TX_TC_HOG_BYTES, fm10kProp->cmTxTcHogBytes);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CM_SMP_SD_VS_HOG_PERCENT, fm10kProp->cmSmpSdVsHogPercent);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CM_SMP_SD_JITTER_BITS, fm10kProp->cmSmpSdJitterBits);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CM_TX_SD_ON_PRIVATE, fm10kProp->cmTxSdOnPrivate);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_CM_TX_SD_ON_SMP_FREE, TFSTR(fm10kProp->cmTxSdOnSmpFree));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_CM_PAUSE_BUFFER_BYTES, TFSTR(fm10kProp->cmPauseBufferBytes));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MCAST_MAX_ENTRIES_PER_CAM, fm10kProp->mcastMaxEntriesPerCam);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_1ST, fm10kProp->ffuUcastSliceRangeFirst);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_UNICAST_SLICE_LAST, fm10kProp->ffuUcastSliceRangeLast);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_1ST, fm10kProp->ffuMcastSliceRangeFirst);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_MULTICAST_SLICE_LAST, fm10kProp->ffuMcastSliceRangeLast);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_ACL_SLICE_1ST, fm10kProp->ffuAclSliceRangeFirst);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_ACL_SLICE_LAST, fm10kProp->ffuAclSliceRangeLast);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_MAPMAC_ROUTING, fm10kProp->ffuMapMacResvdForRoute);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MIN, fm10kProp->ffuUcastPrecedenceMin);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_UNICAST_PRECEDENCE_MAX, fm10kProp->ffuUcastPrecedenceMax);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MIN, fm10kProp->ffuMcastPrecedenceMin);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_MULTICAST_PRECEDENCE_MAX, fm10kProp->ffuMcastPrecedenceMax);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MIN, fm10kProp->ffuAclPrecedenceMin);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FFU_ACL_PRECEDENCE_MAX, fm10kProp->ffuAclPrecedenceMax);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_FFU_ACL_STRICT_COUNT_POLICE, TFSTR(fm10kProp->ffuAclStrictCountPolice));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_INIT_UCAST_FLOODING_TRIGGERS, TFSTR(fm10kProp->initUcastFloodTriggers));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_INIT_MCAST_FLOODING_TRIGGERS, TFSTR(fm10kProp->initMcastFloodTriggers));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_INIT_BCAST_FLOODING_TRIGGERS, TFSTR(fm10kProp->initBcastFloodTriggers));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_INIT_RESERVED_MAC_TRIGGERS, TFSTR(fm10kProp->initResvdMacTriggers));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_FLOODING_TRAP_PRIORITY, fm10kProp->floodingTrapPriority);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_AUTONEG_GENERATE_EVENTS, TFSTR(fm10kProp->autonegGenerateEvents));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_LINK_DEPENDS_ON_DFE, TFSTR(fm10kProp->linkDependsOfDfe));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_VN_USE_SHARED_ENCAP_FLOWS, TFSTR(fm10kProp->vnUseSharedEncapFlows));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_VN_MAX_TUNNEL_RULES, fm10kProp->vnMaxRemoteAddress);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_VN_TUNNEL_GROUP_HASH_SIZE, fm10kProp->vnTunnelGroupHashSize);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_VN_TE_VID, fm10kProp->vnTeVid);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_VN_ENCAP_ACL_NUM, fm10kProp->vnEncapAclNumber);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_VN_DECAP_ACL_NUM, fm10kProp->vnDecapAclNumber);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MCAST_NUM_STACK_GROUPS, fm10kProp->mcastNumStackGroups);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_VN_TUNNEL_ONLY_IN_INGRESS, TFSTR(fm10kProp->vnTunnelOnlyOnIngress));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_MTABLE_CLEANUP_WATERMARK, fm10kProp->mtableCleanupWm);
-    FM_LOG_PRINT(_FORMAT_T, FM_AAK_API_FM10000_SCHED_MODE, fm10kProp->schedMode);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_UPD_SCHED_ON_LNK_CHANGE, TFSTR(fm10kProp->updateSchedOnLinkChange));
-
-
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_CREATE_REMOTE_LOGICAL_PORTS, TFSTR(fm10kProp->createRemoteLogicalPorts));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_AUTONEG_CLAUSE_37_TIMEOUT, fm10kProp->autonegCl37Timeout);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_AUTONEG_SGMII_TIMEOUT, fm10kProp->autonegSgmiiTimeout);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_HNI_SERVICES_LOOPBACK, TFSTR(fm10kProp->useHniServicesLoopback));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_ANTI_BUBBLE_WM, fm10kProp->antiBubbleWm);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_SERDES_OP_MODE, fm10kProp->serdesOpMode);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_SERDES_DBG_LVL, fm10kProp->serdesDbgLevel);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_PARITY_INTERRUPTS, TFSTR(fm10kProp->parityEnableInterrupts));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_START_TCAM_MONITORS, TFSTR(fm10kProp->parityStartTcamMonitors));
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_CRM_TIMEOUT, fm10kProp->parityCrmTimeout);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_SCHED_OVERSPEED, fm10kProp->schedOverspeed);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_LINK_IGNORE_MASK, fm10kProp->intrLinkIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_AUTONEG_IGNORE_MASK, fm10kProp->intrAutonegIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_SERDES_IGNORE_MASK, fm10kProp->intrSerdesIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_PCIE_IGNORE_MASK, fm10kProp->intrPcieIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_MATCN_IGNORE_MASK, fm10kProp->intrMaTcnIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_FHTAIL_IGNORE_MASK, fm10kProp->intrFhTailIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_SW_IGNORE_MASK, fm10kProp->intrSwIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_H, FM_AAK_API_FM10000_INTR_TE_IGNORE_MASK, fm10kProp->intrTeIgnoreMask);
-    FM_LOG_PRINT(_FORMAT_I, FM_AAK_API_FM10000_ENABLE_EEE_SPICO_INTR, fm10kProp->enableEeeSpicoIntr);
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_USE_ALTERNATE_SPICO_FW, TFSTR(fm10kProp->useAlternateSpicoFw));
-    FM_LOG_PRINT(_FORMAT_B, FM_AAK_API_FM10000_ALLOW_KRPCAL_ON_EEE, TFSTR(fm10kProp->allowKrPcalOnEee));
+    for (i = 0 ; i < NUM_PROPERTIES ; i++)
+    {
+        desc = &propertyTable[i];
 
-#endif
+        if ( (i > 0) && (desc->set != propertyTable[i - 1].set) )
+        {
+            FM_LOG_PRINT("############################################################\n");
+        }
+
+        switch (desc->type)
+        {
+            case FM_API_ATTR_INT:
+                FM_LOG_PRINT(desc->hex ? _FORMAT_H : _FORMAT_I,
+                             desc->key,
+                             GetPropertyInt(desc));
+                break;
+
+            case FM_API_ATTR_BOOL:
+                FM_LOG_PRINT(_FORMAT_B,
+                             desc->key,
+                             TFSTR(GetPropertyBool(desc)));
+                break;
+
+            case FM_API_ATTR_TEXT:
+                FM_LOG_PRINT(_FORMAT_T,
+                             desc->key,
+                             (fm_text) GetPropertyPtr(desc));
+                break;
+
+            default:
+                break;
+        }
+    }
 
     FM_LOG_PRINT("##########################################################\n");
 
@@ -57,6 +57,32 @@
     gsmeLockTaken = FALSE;      \
 }
 
+/* number of locks protecting the state machine instances, must be a power
+ * of two. Instances are spread over the shards by hashing their handle, so
+ * that the shard can be found without touching the instance itself */
+#define GSME_LOCK_SHARD_BITS    4
+#define GSME_NUM_LOCK_SHARDS    (1 << GSME_LOCK_SHARD_BITS)
+
+#define GET_SHARD_LOCK( handle )                                        \
+    ( &smEngine.shardLock[ ( (fm_uint32)( (fm_uintptr)(handle) >> 3 ) * \
+                             2654435761U ) >> (32 - GSME_LOCK_SHARD_BITS) ] )
+
+#define TAKE_SHARD_LOCK( handle ) \
+    fmCaptureLock( GET_SHARD_LOCK( handle ), FM_WAIT_FOREVER )
+#define DROP_SHARD_LOCK( handle ) fmReleaseLock( GET_SHARD_LOCK( handle ) )
+
+#define FLAG_TAKE_SHARD_LOCK( handle )  \
+{                                       \
+    TAKE_SHARD_LOCK( handle );          \
+    shardLockTaken = TRUE;              \
+}
+
+#define FLAG_DROP_SHARD_LOCK( handle )  \
+{                                       \
+    DROP_SHARD_LOCK( handle );          \
+    shardLockTaken = FALSE;             \
+}
+
 #define TAKE_CALLER_LOCK( info ) fmCaptureLock( (info)->lock, FM_WAIT_FOREVER )
 #define DROP_CALLER_LOCK( info ) fmReleaseLock( (info)->lock )
 
@@ -153,9 +179,16 @@ typedef struct _fm_stateMachineEngine
     /* reference value */
     fm_uint32          refValue;
 
-    /* GSME lock */
+    /* GSME lock, protects the lists of types and instances */
     fm_lock            lock;
 
+    /* locks protecting the state of the state machine instances, see
+       GET_SHARD_LOCK. They also protect the transition history rings: a
+       record is saved in the same critical section as the state change it
+       describes, so a lock-free ring would not let any more events run in
+       parallel */
+    fm_lock            shardLock[GSME_NUM_LOCK_SHARDS];
+
     /* Init time to be used as reference for event time stamping */
     fm_timestamp       initTime;
 
@@ -171,6 +204,86 @@ typedef struct _fm_stateMachineEngine
 
 
 
+/* state machine type of the link-flap replay benchmark, chosen away from
+ * the types registered by the switch APIs */
+#define GSME_BENCH_SM_TYPE          0x7FFF
+#define GSME_BENCH_MAX_WORKERS      8
+#define GSME_BENCH_LANES_PER_PORT   4
+#define GSME_BENCH_HISTORY_SIZE     16
+
+/* states of the benchmark lane state machine */
+typedef enum
+{
+    GSME_BENCH_STATE_DOWN = 0,
+    GSME_BENCH_STATE_SIGNAL,
+    GSME_BENCH_STATE_AN_DONE,
+    GSME_BENCH_STATE_UP,
+    GSME_BENCH_STATE_MAX
+
+} fm_smBenchState;
+
+/* events of the benchmark lane state machine */
+typedef enum
+{
+    GSME_BENCH_EVENT_SIGNAL_LOST = 0,
+    GSME_BENCH_EVENT_SIGNAL_DETECT,
+    GSME_BENCH_EVENT_AN_COMPLETE,
+    GSME_BENCH_EVENT_LINK_UP,
+    GSME_BENCH_EVENT_MAX
+
+} fm_smBenchEvent;
+
+/* one event of the recorded link-flap trace */
+typedef struct _fm_smBenchTraceEntry
+{
+    /* lane of the port the event occurred on */
+    fm_int lane;
+
+    /* event, see fm_smBenchEvent */
+    fm_int eventId;
+
+} fm_smBenchTraceEntry;
+
+/* state of one worker of the link-flap replay benchmark */
+typedef struct _fm_smBenchWorker
+{
+    /* worker index, the worker replays the ports whose index modulo the
+       number of workers is equal to it */
+    fm_int        index;
+
+    /* number of workers of the current run */
+    fm_int        nrWorkers;
+
+    /* number of ports and state machine instances, one per lane */
+    fm_int        nrPorts;
+    fm_smHandle  *handles;
+
+    /* number of times the trace is replayed on each port */
+    fm_int        iterations;
+
+    /* switch whose lock the worker holds for reading, as the timer
+       callbacks notifying the SerDes-DFE events do */
+    fm_int        sw;
+
+    /* the caller lock passed with the events of this worker's lanes, it
+       has the precedence of the SerDes-DFE lane locks it stands for */
+    fm_lock       lock;
+
+    /* signaled to start a run */
+    fm_semaphore  startSem;
+
+    /* signaled to the benchmark at the end of each run */
+    fm_semaphore *doneSem;
+
+    /* number of transitions done by the callbacks in the last run */
+    fm_uint64     nrTransitions;
+
+    /* first error met in the last run */
+    fm_status     status;
+
+} fm_smBenchWorker;
+
+
 /*****************************************************************************
  * Local function prototypes
  *****************************************************************************/
@@ -199,6 +312,10 @@ static fm_status ClearStateTransitionHistory( fm_stateMachine *sm );
 
 static fm_status SaveEventTime( fm_stateMachine *sm, fm_timestamp *ts );
 
+static fm_status BenchTransition( fm_smEventInfo *eventInfo, void *userInfo );
+
+static void *BenchWorkerThread( void *args );
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -212,6 +329,37 @@ static fm_stateMachineEngine smEngine =
     FALSE,
 };
 
+/* link-flap event trace recorded on a 4-lane port: all lanes lose the
+ * signal, the signal bounces on lanes 0 and 1 before settling, then
+ * autonegotiation completes and the link comes back up on every lane */
+static const fm_smBenchTraceEntry benchLinkFlapTrace[] =
+{
+    { 0, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 1, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 2, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 3, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 0, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 1, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 0, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 2, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 3, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 1, GSME_BENCH_EVENT_SIGNAL_LOST   },
+    { 0, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 1, GSME_BENCH_EVENT_SIGNAL_DETECT },
+    { 0, GSME_BENCH_EVENT_AN_COMPLETE   },
+    { 1, GSME_BENCH_EVENT_AN_COMPLETE   },
+    { 2, GSME_BENCH_EVENT_AN_COMPLETE   },
+    { 3, GSME_BENCH_EVENT_AN_COMPLETE   },
+    { 0, GSME_BENCH_EVENT_LINK_UP       },
+    { 1, GSME_BENCH_EVENT_LINK_UP       },
+    { 2, GSME_BENCH_EVENT_LINK_UP       },
+    { 3, GSME_BENCH_EVENT_LINK_UP       },
+};
+
+/* benchmark worker pool, created on first use and kept afterwards */
+static fm_thread        benchThreads[GSME_BENCH_MAX_WORKERS];
+static fm_smBenchWorker benchWorkers[GSME_BENCH_MAX_WORKERS];
+
 /*****************************************************************************
  * Local Functions
  *****************************************************************************/
@@ -466,6 +614,10 @@ static fm_status StartStateMachine( fm_smHandle handle,
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
     }
 
+    /* the GSME lock keeps the type registered, the shard lock serializes
+       the binding with the events notified on this instance */
+    TAKE_SHARD_LOCK( handle );
+
     sm->type     = type;
     sm->curState = initState;
 
@@ -490,6 +642,8 @@ static fm_status StartStateMachine( fm_smHandle handle,
         status = FM_ERR_NO_MEM;
     }
 
+    DROP_SHARD_LOCK( handle );
+
     /* successful if we got here */
     status = FM_OK;
 
@@ -718,6 +872,108 @@ static fm_status SaveEventTime( fm_stateMachine *sm, fm_timestamp *ts )
 
 } /* end SaveEventTime */
 
+
+/*****************************************************************************/
+/** BenchTransition
+ * \ingroup intStateMachine
+ *
+ * \desc            Transition callback of the link-flap replay benchmark
+ *                  state machine, counts the transitions of a worker.
+ *
+ * \param[in]       eventInfo is the event being processed.
+ *
+ * \param[in]       userInfo points to the worker's transition counter.
+ *
+ * \return          FM_OK
+ *
+ *****************************************************************************/
+static fm_status BenchTransition( fm_smEventInfo *eventInfo, void *userInfo )
+{
+    FM_NOT_USED( eventInfo );
+
+    ( *(fm_uint64 *)userInfo )++;
+
+    return FM_OK;
+
+}   /* end BenchTransition */
+
+
+/*****************************************************************************/
+/** BenchWorkerThread
+ * \ingroup intStateMachine
+ *
+ * \desc            Worker of the link-flap replay benchmark. On each run it
+ *                  replays the recorded trace on its share of the ports,
+ *                  passing its own caller lock with each event as the
+ *                  SerDes-DFE timeouts pass their lane's lock, so that the
+ *                  workers only meet on the shard locks.
+ *
+ * \param[in]       args contains the thread handle and a pointer to the
+ *                  worker's ''fm_smBenchWorker'' structure.
+ *
+ * \return          None, the worker lives as long as the application.
+ *
+ *****************************************************************************/
+static void *BenchWorkerThread( void *args )
+{
+    fm_smBenchWorker *worker;
+    fm_smEventInfo    eventInfo;
+    fm_status         status;
+    fm_int            iter;
+    fm_int            port;
+    fm_int            i;
+    fm_int            lane;
+
+    worker = FM_GET_THREAD_PARAM( fm_smBenchWorker, args );
+
+    eventInfo.smType    = GSME_BENCH_SM_TYPE;
+    eventInfo.srcSmType = 0;
+    eventInfo.lock      = &worker->lock;
+
+    while ( TRUE )
+    {
+        fmWaitSemaphore( &worker->startSem, FM_WAIT_FOREVER );
+
+        worker->nrTransitions = 0;
+        worker->status        = FM_OK;
+
+        PROTECT_SWITCH( worker->sw );
+
+        for ( iter = 0 ; iter < worker->iterations ; iter++ )
+        {
+            for ( port = worker->index ;
+                  port < worker->nrPorts ;
+                  port += worker->nrWorkers )
+            {
+                for ( i = 0 ;
+                      i < (fm_int) FM_NENTRIES( benchLinkFlapTrace ) ;
+                      i++ )
+                {
+                    lane = benchLinkFlapTrace[i].lane;
+                    eventInfo.eventId = benchLinkFlapTrace[i].eventId;
+
+                    status = fmNotifyStateMachineEvent(
+                        worker->handles[port * GSME_BENCH_LANES_PER_PORT + lane],
+                        &eventInfo,
+                        &worker->nrTransitions,
+                        &lane );
+                    if ( status != FM_OK && worker->status == FM_OK )
+                    {
+                        worker->status = status;
+                    }
+                }
+            }
+        }
+
+        UNPROTECT_SWITCH( worker->sw );
+
+        fmSignalSemaphore( worker->doneSem );
+    }
+
+    return NULL;
+
+}   /* end BenchWorkerThread */
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -742,12 +998,21 @@ fm_status fmInitStateMachineEngine( fm_timestamp       *initTime,
                                     fm_smTimestampMode  mode )
 {
     fm_status status;
+    fm_char   lockName[32];
+    fm_int    i;
 
     FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE, "Initializing GSME\n" );
 
     status = fmCreateLock( "GSME Lock", &smEngine.lock );
     FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
 
+    for ( i = 0 ; i < GSME_NUM_LOCK_SHARDS ; i++ )
+    {
+        FM_SPRINTF_S( lockName, sizeof(lockName), "GSME Shard Lock %d", i );
+        status = fmCreateLock( lockName, &smEngine.shardLock[i] );
+        FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+
     smEngine.init              = TRUE;
     smEngine.nrRegisteredTypes = 0;
     smEngine.refValue          = 0;
@@ -1271,7 +1536,9 @@ fm_status fmStopStateMachine( fm_smHandle  handle )
     }
 
     /* unbind it from the registered type */
+    TAKE_SHARD_LOCK( handle );
     sm->type = NULL;
+    DROP_SHARD_LOCK( handle );
 
     status = FM_OK;
 
@@ -1324,7 +1591,11 @@ fm_status fmDeleteStateMachine( fm_smHandle  handle )
         FM_LOG_ABORT_ON_ERR( FM_LOG_CAT_STATE_MACHINE, status );
     }
 
+    /* invalidate the handle while holding its shard lock, so that no event
+       can be in progress on this instance */
+    TAKE_SHARD_LOCK( handle );
     sm->smMagicNumber = 0;
+    DROP_SHARD_LOCK( handle );
 
     /* remove it from the linked list of state machines */
     FM_DLL_REMOVE_NODE( &smEngine, smHead, smTail, sm, next, prev );
@@ -1401,7 +1672,7 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
     fm_smConditionCallback   condition;
     fm_smTransitionRecord    record;
     fm_int                   nextState;
-    fm_bool                  gsmeLockTaken   = FALSE;
+    fm_bool                  shardLockTaken  = FALSE;
     fm_bool                  callerLockTaken = FALSE;
     fm_int                   smType;
     fm_uint32                refValue;
@@ -1438,8 +1709,10 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
     }
 
 
+    /* only the instance's shard lock is needed, events on instances in
+       other shards proceed in parallel */
     FLAG_TAKE_CALLER_LOCK( eventInfo );
-    FLAG_TAKE_GSME_LOCK( );
+    FLAG_TAKE_SHARD_LOCK( handle );
 
     /* consistency check on the handle */
     sm = (fm_stateMachine *)handle;
@@ -1489,10 +1762,10 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
         /* by default, nextState is set to the current state */
         nextState  = sm->curState;
 
-        /* drop the GSME lock to allow the callback to use other locks */
-        FLAG_DROP_GSME_LOCK();
+        /* drop the shard lock to allow the callback to use other locks */
+        FLAG_DROP_SHARD_LOCK( handle );
         status = condition( eventInfo, userInfo, &nextState );
-        FLAG_TAKE_GSME_LOCK();
+        FLAG_TAKE_SHARD_LOCK( handle );
     }
     else
     {
@@ -1507,14 +1780,14 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
         /* default action if the action list is empty */
         if ( transition != NULL )
         {
-            /* drop the GSME lock to allow the callback to use other locks */
-            FLAG_DROP_GSME_LOCK();
+            /* drop the shard lock to allow the callback to use other locks */
+            FLAG_DROP_SHARD_LOCK( handle );
             status = transition( eventInfo, userInfo );
-            FLAG_TAKE_GSME_LOCK();
+            FLAG_TAKE_SHARD_LOCK( handle );
         }
     }
 
-    /* we may have release the GSME lock temporarily, make sure the state
+    /* we may have release the shard lock temporarily, make sure the state
        machine instance is still valid and nothing changed meanwhile */
     if ( ( sm->smMagicNumber != STATE_MACHINE_MAGIC_NUMBER ) ||
          ( sm->smRefValue    != refValue )                   ||
@@ -1574,9 +1847,9 @@ fm_status fmNotifyStateMachineEvent( fm_smHandle     handle,
     }
     
 ABORT:
-    if ( gsmeLockTaken )
+    if ( shardLockTaken )
     {
-        DROP_GSME_LOCK();
+        DROP_SHARD_LOCK( handle );
     }
     if ( callerLockTaken )
     {
@@ -1623,7 +1896,7 @@ fm_status fmGetStateMachineCurrentState( fm_smHandle  handle, fm_int *state )
         FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
 
-    TAKE_GSME_LOCK();
+    TAKE_SHARD_LOCK( handle );
 
     /* consistency check on the handle */
     sm = (fm_stateMachine *)handle;
@@ -1644,7 +1917,7 @@ fm_status fmGetStateMachineCurrentState( fm_smHandle  handle, fm_int *state )
     status = FM_OK;
 
 ABORT:
-    DROP_GSME_LOCK();
+    DROP_SHARD_LOCK( handle );
 
     FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status )
 
@@ -1704,7 +1977,7 @@ fm_status fmGetStateTransitionHistory( fm_smHandle            handle,
         FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
 
-    TAKE_GSME_LOCK();
+    TAKE_SHARD_LOCK( handle );
 
     /* consistency check on the handle */
     sm = (fm_stateMachine *)handle;
@@ -1747,7 +2020,7 @@ fm_status fmGetStateTransitionHistory( fm_smHandle            handle,
     status = FM_OK;
 
 ABORT:
-    DROP_GSME_LOCK();
+    DROP_SHARD_LOCK( handle );
 
     FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
 
@@ -1782,7 +2055,7 @@ fm_status fmClearStateTransitionHistory( fm_smHandle handle )
         FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
 
-    TAKE_GSME_LOCK();
+    TAKE_SHARD_LOCK( handle );
 
     /* consistency check on the handle */
     sm = (fm_stateMachine *)handle;
@@ -1801,7 +2074,7 @@ fm_status fmClearStateTransitionHistory( fm_smHandle handle )
     status = ClearStateTransitionHistory( sm );
 
 ABORT:
-    DROP_GSME_LOCK();
+    DROP_SHARD_LOCK( handle );
 
     FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
 
@@ -1862,7 +2135,7 @@ fm_status fmChangeStateTransitionHistorySize( fm_smHandle handle,
         FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
     }
 
-    TAKE_GSME_LOCK();
+    TAKE_SHARD_LOCK( handle );
 
     newDataBuf      = NULL;
     newHistoryStart = NULL;
@@ -1997,7 +2270,7 @@ fm_status fmChangeStateTransitionHistorySize( fm_smHandle handle,
     status = FM_OK;
 
 ABORT:
-    DROP_GSME_LOCK();
+    DROP_SHARD_LOCK( handle );
 
     if ( status != FM_OK )
     {
@@ -2014,3 +2287,355 @@ ABORT:
 
 }   /* end fmChangeStateTransitionHistory */
 
+
+
+/*****************************************************************************/
+/** fmDbgBenchmarkStateMachine
+ * \ingroup intDiag
+ *
+ * \desc            Times the replay of a recorded link-flap event trace on
+ *                  many lane state machines. The ports are spread over a
+ *                  pool of workers and the run is repeated with 1, 2, 4
+ *                  and up to nrWorkers workers, so that the event rate
+ *                  shows how well events on independent instances scale.
+ *                                                                      \lb\lb
+ *                  Each worker passes its own caller lock with the events,
+ *                  with the precedence of the SerDes-DFE lane locks, and
+ *                  holds the switch lock for reading, as the DFE timeouts
+ *                  do. The workers thus only contend on the state machine
+ *                  engine's shard locks. The switch must be up.
+ *
+ * \param[in]       sw is the switch the caller locks belong to.
+ *
+ * \param[in]       nrLanes is the number of lane state machines, rounded
+ *                  down to a multiple of the lanes per port.
+ *
+ * \param[in]       nrWorkers is the largest number of workers to run, up to
+ *                  GSME_BENCH_MAX_WORKERS.
+ *
+ * \param[in]       iterations is the number of times the trace is replayed
+ *                  on each port.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is out of range.
+ * \return          FM_ERR_INVALID_SWITCH if sw is not a valid switch.
+ * \return          FM_ERR_UNINITIALIZED if the state machine engine has not
+ *                  been initialized.
+ * \return          FM_ERR_NO_MEM if there was a memory allocation failure.
+ *
+ *****************************************************************************/
+fm_status fmDbgBenchmarkStateMachine( fm_int sw,
+                                      fm_int nrLanes,
+                                      fm_int nrWorkers,
+                                      fm_int iterations )
+{
+    static fm_semaphore   doneSem;
+    static fm_int         poolSize = 0;
+    fm_smTransitionEntry  table[GSME_BENCH_STATE_MAX][GSME_BENCH_EVENT_MAX];
+    fm_smTransitionEntry *stt[GSME_BENCH_STATE_MAX];
+    fm_smTransitionEntry *entry;
+    fm_smHandle          *handles = NULL;
+    fm_smBenchWorker     *worker;
+    fm_timestamp          start;
+    fm_timestamp          end;
+    fm_timestamp          elapsed;
+    fm_char               name[32];
+    fm_uint64             usec;
+    fm_uint64             baseUsec;
+    fm_uint64             nrEvents;
+    fm_uint64             nrTransitions;
+    fm_status             status;
+    fm_status             err;
+    fm_bool               registered = FALSE;
+    fm_int                nrPorts;
+    fm_int                nrInstances = 0;
+    fm_int                nrLocks = 0;
+    fm_int                workers;
+    fm_int                state;
+    fm_int                i;
+
+    FM_LOG_ENTRY( FM_LOG_CAT_STATE_MACHINE,
+                  "sw=%d nrLanes=%d nrWorkers=%d iterations=%d\n",
+                  sw,
+                  nrLanes,
+                  nrWorkers,
+                  iterations );
+
+    if ( smEngine.init != TRUE )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_UNINITIALIZED );
+    }
+
+    if ( sw < 0                                   ||
+         sw >= FM_MAX_NUM_SWITCHES                ||
+         fmRootApi == NULL                        ||
+         fmRootApi->fmSwitchLockTable[sw] == NULL ||
+         fmRootApi->fmSwitchStateTable[sw] == NULL )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_SWITCH );
+    }
+
+    nrPorts = nrLanes / GSME_BENCH_LANES_PER_PORT;
+
+    if ( nrPorts <= 0    ||
+         nrWorkers <= 0  ||
+         nrWorkers > GSME_BENCH_MAX_WORKERS ||
+         iterations <= 0 )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, FM_ERR_INVALID_ARGUMENT );
+    }
+
+    /**************************************************
+     * Register the lane state machine type: losing the
+     * signal always brings the lane down, the other
+     * events move it one step towards link up.
+     **************************************************/
+
+    FM_CLEAR( table );
+    for ( state = 0 ; state < GSME_BENCH_STATE_MAX ; state++ )
+    {
+        entry = &table[state][GSME_BENCH_EVENT_SIGNAL_LOST];
+        entry->used               = TRUE;
+        entry->nextState          = GSME_BENCH_STATE_DOWN;
+        entry->transitionCallback = BenchTransition;
+        stt[state] = table[state];
+    }
+
+    entry = &table[GSME_BENCH_STATE_DOWN][GSME_BENCH_EVENT_SIGNAL_DETECT];
+    entry->used               = TRUE;
+    entry->nextState          = GSME_BENCH_STATE_SIGNAL;
+    entry->transitionCallback = BenchTransition;
+
+    entry = &table[GSME_BENCH_STATE_SIGNAL][GSME_BENCH_EVENT_AN_COMPLETE];
+    entry->used               = TRUE;
+    entry->nextState          = GSME_BENCH_STATE_AN_DONE;
+    entry->transitionCallback = BenchTransition;
+
+    entry = &table[GSME_BENCH_STATE_AN_DONE][GSME_BENCH_EVENT_LINK_UP];
+    entry->used               = TRUE;
+    entry->nextState          = GSME_BENCH_STATE_UP;
+    entry->transitionCallback = BenchTransition;
+
+    status = fmRegisterStateTransitionTable( GSME_BENCH_SM_TYPE,
+                                             GSME_BENCH_STATE_MAX,
+                                             GSME_BENCH_EVENT_MAX,
+                                             stt,
+                                             NULL,
+                                             FALSE );
+    if ( status != FM_OK )
+    {
+        FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+    }
+    registered = TRUE;
+
+    /**************************************************
+     * Create one instance per lane, all links up.
+     **************************************************/
+
+    handles = fmAlloc( nrPorts * GSME_BENCH_LANES_PER_PORT *
+                       sizeof(fm_smHandle) );
+    if ( handles == NULL )
+    {
+        status = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    for ( i = 0 ; i < nrPorts * GSME_BENCH_LANES_PER_PORT ; i++ )
+    {
+        status = fmCreateAndStartStateMachine( i,
+                                               GSME_BENCH_HISTORY_SIZE,
+                                               sizeof(fm_int),
+                                               GSME_BENCH_SM_TYPE,
+                                               GSME_BENCH_STATE_UP,
+                                               &handles[i] );
+        if ( status != FM_OK )
+        {
+            goto ABORT;
+        }
+        nrInstances++;
+    }
+
+    /**************************************************
+     * Grow the worker pool. The workers are kept for
+     * the next runs, like any other thread.
+     **************************************************/
+
+    if ( poolSize == 0 )
+    {
+        status = fmCreateSemaphore( "GSME Bench Done",
+                                    FM_SEM_COUNTING,
+                                    &doneSem,
+                                    0 );
+        if ( status != FM_OK )
+        {
+            goto ABORT;
+        }
+    }
+
+    while ( poolSize < nrWorkers )
+    {
+        worker = &benchWorkers[poolSize];
+        worker->index   = poolSize;
+        worker->doneSem = &doneSem;
+
+        FM_SPRINTF_S( name, sizeof(name), "GSME Bench Start %d", poolSize );
+        status = fmCreateSemaphore( name,
+                                    FM_SEM_BINARY,
+                                    &worker->startSem,
+                                    0 );
+        if ( status != FM_OK )
+        {
+            goto ABORT;
+        }
+
+        FM_SPRINTF_S( name, sizeof(name), "GSME Bench Worker %d", poolSize );
+        status = fmCreateThread( name,
+                                 FM_EVENT_QUEUE_SIZE_NONE,
+                                 BenchWorkerThread,
+                                 worker,
+                                 &benchThreads[poolSize] );
+        if ( status != FM_OK )
+        {
+            fmDeleteSemaphore( &worker->startSem );
+            goto ABORT;
+        }
+
+        poolSize++;
+    }
+
+    /**************************************************
+     * One caller lock per worker, they are switch locks
+     * so they live no longer than this run.
+     **************************************************/
+
+    while ( nrLocks < nrWorkers )
+    {
+        FM_SPRINTF_S( name, sizeof(name), "GSME Bench Lock %d", nrLocks );
+        status = fmCreateLockV2( name,
+                                 sw,
+                                 FM_LOCK_PREC_SERDES_DFE,
+                                 &benchWorkers[nrLocks].lock );
+        if ( status != FM_OK )
+        {
+            goto ABORT;
+        }
+        nrLocks++;
+    }
+
+    /**************************************************
+     * Replay the trace with a growing number of workers.
+     **************************************************/
+
+    nrEvents = (fm_uint64) nrPorts * iterations *
+               FM_NENTRIES( benchLinkFlapTrace );
+    baseUsec = 0;
+
+    FM_LOG_PRINT( "State machine benchmark: %d lanes, %d events per run\n",
+                  nrPorts * GSME_BENCH_LANES_PER_PORT,
+                  (fm_int) nrEvents );
+    FM_LOG_PRINT( "\n%-8s %12s %14s %8s\n",
+                  "Workers", "usec", "events/sec", "speedup" );
+
+    for ( workers = 1 ; ; workers *= 2 )
+    {
+        if ( workers > nrWorkers )
+        {
+            workers = nrWorkers;
+        }
+
+        for ( i = 0 ; i < workers ; i++ )
+        {
+            worker = &benchWorkers[i];
+            worker->sw         = sw;
+            worker->nrWorkers  = workers;
+            worker->nrPorts    = nrPorts;
+            worker->handles    = handles;
+            worker->iterations = iterations;
+        }
+
+        fmGetTime( &start );
+
+        for ( i = 0 ; i < workers ; i++ )
+        {
+            fmSignalSemaphore( &benchWorkers[i].startSem );
+        }
+
+        for ( i = 0 ; i < workers ; i++ )
+        {
+            fmWaitSemaphore( &doneSem, FM_WAIT_FOREVER );
+        }
+
+        fmGetTime( &end );
+        fmSubTimestamps( &end, &start, &elapsed );
+
+        nrTransitions = 0;
+        for ( i = 0 ; i < workers ; i++ )
+        {
+            nrTransitions += benchWorkers[i].nrTransitions;
+            if ( benchWorkers[i].status != FM_OK && status == FM_OK )
+            {
+                status = benchWorkers[i].status;
+            }
+        }
+
+        usec = elapsed.sec * 1000000 + elapsed.usec;
+        if ( usec == 0 )
+        {
+            usec = 1;
+        }
+        if ( baseUsec == 0 )
+        {
+            baseUsec = usec;
+        }
+
+        FM_LOG_PRINT( "%-8d %12" FM_FORMAT_64 "u %14" FM_FORMAT_64 "u "
+                      "%5" FM_FORMAT_64 "u.%02" FM_FORMAT_64 "u%s\n",
+                      workers,
+                      usec,
+                      nrEvents * 1000000 / usec,
+                      baseUsec / usec,
+                      (baseUsec * 100 / usec) % 100,
+                      (nrTransitions != nrEvents) ? " (events lost)" : "" );
+
+        if ( workers == nrWorkers )
+        {
+            break;
+        }
+    }
+
+ABORT:
+    for ( i = 0 ; i < nrLocks ; i++ )
+    {
+        err = fmDeleteLock( &benchWorkers[i].lock );
+        if ( err != FM_OK && status == FM_OK )
+        {
+            status = err;
+        }
+    }
+
+    for ( i = 0 ; i < nrInstances ; i++ )
+    {
+        err = fmDeleteStateMachine( handles[i] );
+        if ( err != FM_OK && status == FM_OK )
+        {
+            status = err;
+        }
+    }
+
+    if ( handles != NULL )
+    {
+        fmFree( handles );
+    }
+
+    if ( registered )
+    {
+        err = fmUnregisterStateTransitionTable( GSME_BENCH_SM_TYPE, FALSE );
+        if ( err != FM_OK && status == FM_OK )
+        {
+            status = err;
+        }
+    }
+
+    FM_LOG_EXIT( FM_LOG_CAT_STATE_MACHINE, status );
+
+}   /* end fmDbgBenchmarkStateMachine */
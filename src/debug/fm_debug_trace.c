@@ -2068,6 +2068,9 @@ void fmDbgEventQueueCreated(fm_eventQueue *inQueue)
     inQueue->minTime           = -1;
     inQueue->maxTime           = -1;
 
+    FM_CLEAR(inQueue->depthHistogram);
+    FM_CLEAR(inQueue->latencyHistogram);
+
     fmReleaseLock(&fmRootDebug->dbgEventQueueListLock);
 
 }   /* end fmDbgEventQueueCreated */
@@ -2144,10 +2147,68 @@ void fmDbgEventQueueDump(void)
 
 
 
+void fmDbgEventQueueDumpHistograms(void)
+{
+    fm_eventQueue * eventQueue;
+    fm_treeIterator it;
+    fm_status       err;
+    fm_uint64       nextKey;
+    void *          nextValue;
+    fm_int          bucket;
+
+    fmCaptureLock(&fmRootDebug->dbgEventQueueListLock, 0);
+
+    for (fmTreeIterInit(&it, &fmRootDebug->dbgEventQueueList) ;
+         ( err = fmTreeIterNext(&it, &nextKey, &nextValue) ) == FM_OK ; )
+    {
+        eventQueue = (fm_eventQueue *) (unsigned long) nextKey;
+
+        if ( (eventQueue == NULL) || (eventQueue->name == NULL) )
+        {
+            continue;
+        }
+
+        FM_LOG_PRINT("%s (max %d)\n", eventQueue->name, eventQueue->max);
+        FM_LOG_PRINT("  Bucket      | Depth      | Latency (us)\n");
+
+        for (bucket = 0 ; bucket < FM_EVENT_QUEUE_HISTOGRAM_SIZE ; bucket++)
+        {
+            if ( (eventQueue->depthHistogram[bucket] == 0) &&
+                 (eventQueue->latencyHistogram[bucket] == 0) )
+            {
+                continue;
+            }
+
+            FM_LOG_PRINT("  %s%-9u | %10u | %10u\n",
+                         (bucket < FM_EVENT_QUEUE_HISTOGRAM_SIZE - 1) ?
+                            "< " : ">=",
+                         (bucket < FM_EVENT_QUEUE_HISTOGRAM_SIZE - 1) ?
+                            (2U << bucket) : (1U << bucket),
+                         eventQueue->depthHistogram[bucket],
+                         eventQueue->latencyHistogram[bucket]);
+        }
+    }
+
+    if (err != FM_ERR_NO_MORE)
+    {
+        FM_LOG_PRINT( "fmDbgEventQueueDumpHistograms: fmTreeIterNext failed "
+                      "with '%s'\n",
+                     fmErrorMsg(err) );
+    }
+
+    fmReleaseLock(&fmRootDebug->dbgEventQueueListLock);
+
+}   /* end fmDbgEventQueueDumpHistograms */
+
+
+
+
 void fmDbgEventQueueEventPopped(fm_eventQueue *inQueue, fm_event *event)
 {
     fm_timestamp deltaTimestamp;
     fm_float     deltaTime;
+    fm_uint64    deltaUsec;
+    fm_int       bucket;
 
     fmSubTimestamps(&event->poppedTimestamp,
                     &event->postedTimestamp,
@@ -2178,4 +2239,16 @@ void fmDbgEventQueueEventPopped(fm_eventQueue *inQueue, fm_event *event)
         inQueue->maxTime = deltaTime;
     }
 
+    /* Latency histogram in microseconds, log2 buckets */
+    deltaUsec = (deltaTimestamp.sec * 1000000) + deltaTimestamp.usec;
+
+    for (bucket = 0 ;
+         (deltaUsec > 1) && (bucket < FM_EVENT_QUEUE_HISTOGRAM_SIZE - 1) ;
+         bucket++)
+    {
+        deltaUsec >>= 1;
+    }
+
+    inQueue->latencyHistogram[bucket]++;
+
 }   /* end fmDbgEventQueueEventPopped */
@@ -54,6 +54,11 @@
  * Local Variables
  *****************************************************************************/
 
+/* Regions of external memory buffers may point into. The regions are mapped
+ * by this process only, so the table is kept out of the shared state; it is
+ * still protected by the buffer lock. */
+static fm_bufferView views[FM_MAX_BUFFER_VIEWS];
+
 
 /*****************************************************************************
  * Local function prototypes.
@@ -64,6 +69,40 @@
  * Local Functions
  *****************************************************************************/
 
+/*****************************************************************************/
+/** FindBufferView
+ * \ingroup intPlatform
+ *
+ * \desc            Finds the registered view a data pointer points into.
+ *                  Called with the buffer lock held.
+ *
+ * \param[in]       data is the data pointer of a buffer.
+ *
+ * \return          Pointer to the view, or NULL if data points into the
+ *                  buffer pool.
+ *
+ *****************************************************************************/
+static fm_bufferView *FindBufferView(fm_uint32 *data)
+{
+    fm_int i;
+
+    for (i = 0 ; i < FM_MAX_BUFFER_VIEWS ; i++)
+    {
+        if ( (views[i].base != NULL) &&
+             ( (fm_byte *) data >= views[i].base ) &&
+             ( (fm_byte *) data < views[i].base + views[i].size ) )
+        {
+            return &views[i];
+        }
+    }
+
+    return NULL;
+
+}   /* end FindBufferView */
+
+
+
+
 /*****************************************************************************/
 /** GetBufferMemory
  * \ingroup intPlatform
@@ -223,6 +262,7 @@ fm_status fmPlatformInitBuffersV2(fm_uint32 *bufferMemoryPool,
         info->table[i].index = i;
         info->table[i].bufferQueueNode = NULL;
         info->table[i].recvEvent = NULL;
+        info->table[i].shareCount = 0;
 
         /**
          * Also initialize all the data areas.  This causes the page
@@ -330,6 +370,7 @@ fm_status fmPlatformFreeBuffer(fm_buffer *buf)
     fm_switch *          switchState;
     fm_int               switchNum;
     fm_int               index;
+    fm_bufferView *      view;
 
     index = buf->index;
 
@@ -363,6 +404,18 @@ fm_status fmPlatformFreeBuffer(fm_buffer *buf)
     info->freeList[index] = info->firstFree;
     info->firstFree       = index;
 
+    /**************************************************
+     * If the buffer is a view on external memory, drop
+     * its reference on that memory.
+     **************************************************/
+
+    view = FindBufferView(buf->data);
+
+    if (view != NULL)
+    {
+        view->release(view->cookie, buf->data);
+    }
+
     /**************************************************
      * Reset its pointer to the base of the chunk
      **************************************************/
@@ -372,6 +425,7 @@ fm_status fmPlatformFreeBuffer(fm_buffer *buf)
     /* Clear existing values */
     info->table[index].bufferQueueNode = NULL;
     info->table[index].recvEvent       = NULL;
+    info->table[index].shareCount      = 0;
 
     /* The below statements were not there before. Any reason
      * not to do the following? */
@@ -597,3 +651,152 @@ fm_buffer *fmPlatformAllocateBufferV2(fm_bufferType type)
 }   /* end fmPlatformAllocateBufferV2 */
 
 
+
+
+/*****************************************************************************/
+/** fmPlatformRegisterBufferView
+ * \ingroup intPlatform
+ *
+ * \desc            Registers a region of externally owned memory that
+ *                  buffers may point into instead of their own chunk, so
+ *                  that received data can be passed up without being copied.
+ *                  When such a buffer is freed, release is called to drop
+ *                  the reference it holds on the region.
+ *
+ * \param[in]       base points to the first byte of the region.
+ *
+ * \param[in]       size is the size of the region in bytes.
+ *
+ * \param[in]       release is the function called when a buffer pointing
+ *                  into the region is freed.
+ *
+ * \param[in]       cookie is passed to the release function.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_FREE_RESOURCES if all view entries are in use.
+ *
+ *****************************************************************************/
+fm_status fmPlatformRegisterBufferView(fm_byte *                base,
+                                       fm_uint64                size,
+                                       fm_bufferViewReleaseFunc release,
+                                       void *                   cookie)
+{
+    fm_status err;
+    fm_int    i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER,
+                 "base=%p size=%" FM_FORMAT_64 "u\n",
+                 (void *) base,
+                 size);
+
+    if ( (base == NULL) || (size == 0) || (release == NULL) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_BUFFER, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    err = FM_ERR_NO_FREE_RESOURCES;
+
+    TAKE_BUFFER_LOCK();
+
+    for (i = 0 ; i < FM_MAX_BUFFER_VIEWS ; i++)
+    {
+        if (views[i].base == NULL)
+        {
+            views[i].size    = size;
+            views[i].release = release;
+            views[i].cookie  = cookie;
+            views[i].base    = base;
+            err = FM_OK;
+            break;
+        }
+    }
+
+    DROP_BUFFER_LOCK();
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, err);
+
+}   /* end fmPlatformRegisterBufferView */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformUnregisterBufferView
+ * \ingroup intPlatform
+ *
+ * \desc            Unregisters a region registered with
+ *                  ''fmPlatformRegisterBufferView''. The caller must ensure
+ *                  no buffer still points into the region.
+ *
+ * \param[in]       base points to the first byte of the region.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NOT_FOUND if the region is not registered.
+ *
+ *****************************************************************************/
+fm_status fmPlatformUnregisterBufferView(fm_byte *base)
+{
+    fm_status err;
+    fm_int    i;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_BUFFER, "base=%p\n", (void *) base);
+
+    err = FM_ERR_NOT_FOUND;
+
+    TAKE_BUFFER_LOCK();
+
+    for (i = 0 ; i < FM_MAX_BUFFER_VIEWS ; i++)
+    {
+        if ( (base != NULL) && (views[i].base == base) )
+        {
+            FM_CLEAR(views[i]);
+            err = FM_OK;
+            break;
+        }
+    }
+
+    DROP_BUFFER_LOCK();
+
+    FM_LOG_EXIT(FM_LOG_CAT_BUFFER, err);
+
+}   /* end fmPlatformUnregisterBufferView */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformBufferChainHasView
+ * \ingroup intPlatform
+ *
+ * \desc            Determines whether any buffer of a chain points into a
+ *                  region registered with ''fmPlatformRegisterBufferView''.
+ *                  Such regions are only mapped by the registering process,
+ *                  so the chain must not be handed to another process.
+ *
+ * \param[in]       chain points to the first buffer of the chain.
+ *
+ * \return          TRUE if the chain points into a registered region.
+ * \return          FALSE otherwise.
+ *
+ *****************************************************************************/
+fm_bool fmPlatformBufferChainHasView(fm_buffer *chain)
+{
+    fm_bool hasView;
+
+    hasView = FALSE;
+
+    TAKE_BUFFER_LOCK();
+
+    for ( ; (chain != NULL) && !hasView ; chain = chain->next)
+    {
+        hasView = (FindBufferView(chain->data) != NULL);
+    }
+
+    DROP_BUFFER_LOCK();
+
+    return hasView;
+
+}   /* end fmPlatformBufferChainHasView */
+
+
@@ -375,6 +375,327 @@ ABORT:
 }   /* end FilterPortList */
 
 
+
+
+/*****************************************************************************/
+/** InitQueueMutex
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Initializes the recursive, process-shared mutex of a
+ *                  packet queue.
+ *
+ * \param[out]      mutex points to the mutex to initialize.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_LOCK_INIT if the mutex could not be initialized.
+ *
+ *****************************************************************************/
+static fm_status InitQueueMutex(pthread_mutex_t *mutex)
+{
+    pthread_mutexattr_t attr;
+
+    if ( pthread_mutexattr_init(&attr) )
+    {
+        return FM_ERR_LOCK_INIT;
+    }
+
+    if ( pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) ||
+         pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
+    {
+        pthread_mutexattr_destroy(&attr);
+        return FM_ERR_LOCK_INIT;
+    }
+
+    if ( pthread_mutex_init(mutex, &attr) )
+    {
+        pthread_mutexattr_destroy(&attr);
+        return FM_ERR_LOCK_INIT;
+    }
+
+    if ( pthread_mutexattr_destroy(&attr) )
+    {
+        return FM_ERR_LOCK_INIT;
+    }
+
+    return FM_OK;
+
+}   /* end InitQueueMutex */
+
+
+
+
+/*****************************************************************************/
+/** ClassifyPacket
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Selects the TX class of a packet from its destination
+ *                  MAC address and Ethernet type.
+ *
+ * \param[in]       packet points to the first buffer of the packet.
+ *
+ * \return          The ''fm_packetTxClass'' of the packet.
+ *
+ *****************************************************************************/
+static fm_int ClassifyPacket(fm_buffer *packet)
+{
+    fm_uint32 header;
+    fm_int    etherType;
+    fm_int    offset;
+
+    if ( packet->len < (FM_PACKET_OFFSET_ETHERTYPE + 1) * 4 )
+    {
+        return FM_PACKET_TX_CLASS_BULK;
+    }
+
+    /* IEEE reserved addresses 01-80-C2-00-00-00 to 01-80-C2-00-00-0F */
+    if ( ( ntohl(packet->data[0]) == 0x0180C200 ) &&
+         ( ( ntohl(packet->data[1]) & 0xFFF00000 ) == 0 ) )
+    {
+        return FM_PACKET_TX_CLASS_CONTROL;
+    }
+
+    offset    = FM_PACKET_OFFSET_ETHERTYPE;
+    header    = ntohl(packet->data[offset]);
+    etherType = (header >> 16) & 0xFFFF;
+
+    if ( (etherType == 0x8100) && (packet->len >= (offset + 2) * 4) )
+    {
+        offset++;
+        header    = ntohl(packet->data[offset]);
+        etherType = (header >> 16) & 0xFFFF;
+    }
+
+    switch (etherType)
+    {
+        case 0x8809:    /* Slow protocols */
+        case 0x88CC:    /* LLDP */
+            return FM_PACKET_TX_CLASS_CONTROL;
+
+        case 0x0806:    /* ARP */
+            return FM_PACKET_TX_CLASS_NETWORK;
+
+        case 0x86DD:
+            /* The IPv6 next header field is in the top byte two words
+             * after the Ethernet type. 58 is ICMPv6, which carries
+             * neighbor discovery. */
+            if ( (packet->len >= (offset + 3) * 4) &&
+                 ( ( ntohl(packet->data[offset + 2]) >> 24 ) == 58 ) )
+            {
+                return FM_PACKET_TX_CLASS_NETWORK;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return FM_PACKET_TX_CLASS_BULK;
+
+}   /* end ClassifyPacket */
+
+
+
+
+/*****************************************************************************/
+/** ClassQueueDepth
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the number of packet entries in a TX class queue.
+ *
+ * \param[in]       queue points to the class queue.
+ *
+ * \return          The number of queued entries.
+ *
+ *****************************************************************************/
+static fm_int ClassQueueDepth(fm_packetClassQueue *queue)
+{
+    if (queue->numEntries == 0)
+    {
+        return 0;
+    }
+
+    return (queue->pushIndex + queue->numEntries - queue->pullIndex) %
+           queue->numEntries;
+
+}   /* end ClassQueueDepth */
+
+
+
+
+/*****************************************************************************/
+/** ClassQueueBaseSize
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the number of entries a TX class queue is
+ *                  allocated with, and shrinks back to once drained.
+ *
+ * \param[in]       queue points to the class queue.
+ *
+ * \return          The base number of entries.
+ *
+ *****************************************************************************/
+static fm_uint ClassQueueBaseSize(fm_packetClassQueue *queue)
+{
+    if (queue->maxDepth + 1 < FM_PACKET_QUEUE_SIZE)
+    {
+        return queue->maxDepth + 1;
+    }
+
+    return FM_PACKET_QUEUE_SIZE;
+
+}   /* end ClassQueueBaseSize */
+
+
+
+
+/*****************************************************************************/
+/** ResizeClassQueue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Reallocates the circular buffer of a TX class queue,
+ *                  keeping the queued entries in order.
+ *
+ * \note            The caller must hold the class queue lock.
+ *
+ * \param[in]       queue points to the class queue.
+ *
+ * \param[in]       numEntries is the new number of entries. It must exceed
+ *                  the number of queued entries.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_NO_MEM if the buffer could not be allocated. The
+ *                  queue is left unchanged.
+ *
+ *****************************************************************************/
+static fm_status ResizeClassQueue(fm_packetClassQueue *queue,
+                                  fm_uint              numEntries)
+{
+    fm_packetEntry *entries;
+    fm_int          depth;
+    fm_int          i;
+
+    entries = fmAlloc( numEntries * sizeof(fm_packetEntry) );
+
+    if (entries == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    depth = ClassQueueDepth(queue);
+
+    for (i = 0 ; i < depth ; i++)
+    {
+        entries[i] =
+            queue->entries[(queue->pullIndex + i) % queue->numEntries];
+    }
+
+    if (queue->entries != NULL)
+    {
+        fmFree(queue->entries);
+    }
+
+    queue->entries    = entries;
+    queue->numEntries = numEntries;
+    queue->pullIndex  = 0;
+    queue->pushIndex  = depth;
+
+    return FM_OK;
+
+}   /* end ResizeClassQueue */
+
+
+
+
+/*****************************************************************************/
+/** MoveClassPackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Moves packet entries from a TX class queue to the
+ *                  dispatch queue.
+ *
+ * \note            The caller must hold the packet queue lock and ensure
+ *                  that the dispatch queue has room for max entries.
+ *
+ * \param[in]       queue points to the packet queue.
+ *
+ * \param[in]       classQueue points to the class queue to take from.
+ *
+ * \param[in]       max is the maximum number of entries to move.
+ *
+ * \return          The number of entries moved.
+ *
+ *****************************************************************************/
+static fm_int MoveClassPackets(fm_packetQueue *     queue,
+                               fm_packetClassQueue *classQueue,
+                               fm_int               max)
+{
+    fm_int moved;
+
+    fmPacketClassQueueLock(classQueue);
+
+    for (moved = 0 ;
+         (moved < max) && (classQueue->pullIndex != classQueue->pushIndex) ;
+         moved++)
+    {
+        queue->packetQueueList[queue->pushIndex] =
+            classQueue->entries[classQueue->pullIndex];
+
+        queue->pushIndex = (queue->pushIndex + 1) % FM_PACKET_QUEUE_SIZE;
+        classQueue->pullIndex =
+            (classQueue->pullIndex + 1) % classQueue->numEntries;
+    }
+
+    /* Give back the memory of a grown queue once the burst has drained.
+     * This is best effort, the larger buffer is kept if allocation fails. */
+    if ( (classQueue->pullIndex == classQueue->pushIndex) &&
+         (classQueue->numEntries > ClassQueueBaseSize(classQueue)) )
+    {
+        (void) ResizeClassQueue(classQueue, ClassQueueBaseSize(classQueue));
+    }
+
+    fmPacketClassQueueUnlock(classQueue);
+
+    return moved;
+
+}   /* end MoveClassPackets */
+
+
+
+
+/*****************************************************************************/
+/** GetTxQueue
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the TX packet queue that packets sent on a
+ *                  switch go through.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          Pointer to the packet queue.
+ *
+ *****************************************************************************/
+static fm_packetQueue *GetTxQueue(fm_int sw)
+{
+    fm_int masterSw;
+
+    masterSw = sw;
+
+    if (fmRootApi->isSwitchFibmSlave[sw])
+    {
+        /* Slave switches send through their master, or through themselves
+         * in standalone NIC mode. */
+        masterSw = fmFibmSlaveGetMasterSwitch(sw);
+        if (masterSw < 0)
+        {
+            masterSw = sw;
+        }
+    }
+
+    return &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+
+}   /* end GetTxQueue */
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -429,115 +750,482 @@ void fmPacketQueueUnlock(fm_packetQueue *queue)
                       FALSE,
                       "Failed to unlock queue's mutex!\n");
     }
-#else
-    DROP_PLAT_LOCK(queue->switchNum, FM_PLAT_INFO);
-#endif
+#else
+    DROP_PLAT_LOCK(queue->switchNum, FM_PLAT_INFO);
+#endif
+
+}   /* end fmPacketQueueUnlock */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketClassQueueLock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Lock a TX class queue.
+ *
+ * \param[in]       queue is the pointer to the class queue.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketClassQueueLock(fm_packetClassQueue *queue)
+{
+    if (pthread_mutex_lock(&queue->mutex))
+    {
+        FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
+                      FALSE,
+                      "Failed to lock class queue's mutex!\n");
+    }
+
+}   /* end fmPacketClassQueueLock */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketClassQueueUnlock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Unlock a TX class queue.
+ *
+ * \param[in]       queue is the pointer to the class queue.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketClassQueueUnlock(fm_packetClassQueue *queue)
+{
+    if (pthread_mutex_unlock(&queue->mutex))
+    {
+        FM_LOG_ASSERT(FM_LOG_CAT_EVENT_PKT_TX, 
+                      FALSE,
+                      "Failed to unlock class queue's mutex!\n");
+    }
+
+}   /* end fmPacketClassQueueUnlock */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueInit
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Initialize packet queue and its TX class queues.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw)
+{
+    fm_packetClassQueue *classQueue;
+    fm_status            err;
+    fm_int               maxDepth;
+    fm_int               txClass;
+
+    if (!queue) 
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    memset(queue, 0, sizeof(*queue));
+    queue->switchNum     = sw;
+    queue->dispatchDepth = FM_PACKET_TX_DISPATCH_DEPTH;
+
+    err = InitQueueMutex(&queue->mutex);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+    maxDepth = GET_PROPERTY()->pktTxClassMaxDepth;
+
+    if (maxDepth < 1)
+    {
+        maxDepth = 1;
+    }
+    else if (maxDepth > FM_PACKET_TX_CLASS_MAX_DEPTH)
+    {
+        maxDepth = FM_PACKET_TX_CLASS_MAX_DEPTH;
+    }
+
+    for (txClass = 0 ; txClass < FM_PACKET_TX_CLASS_MAX ; txClass++)
+    {
+        classQueue = &queue->classQueue[txClass];
+
+        classQueue->txClass    = txClass;
+        classQueue->maxDepth   = maxDepth;
+        classQueue->dropPolicy = FM_PACKET_TX_DROP_REJECT;
+
+        switch (txClass)
+        {
+            case FM_PACKET_TX_CLASS_CONTROL:
+                classQueue->weight = FM_PACKET_TX_CONTROL_WEIGHT;
+                break;
+
+            case FM_PACKET_TX_CLASS_NETWORK:
+                classQueue->weight = FM_PACKET_TX_NETWORK_WEIGHT;
+                break;
+
+            default:
+                classQueue->weight = FM_PACKET_TX_BULK_WEIGHT;
+                break;
+        }
+
+        classQueue->credit = classQueue->weight;
+
+        err = InitQueueMutex(&classQueue->mutex);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+
+        err = ResizeClassQueue(classQueue, ClassQueueBaseSize(classQueue));
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+
+    return FM_OK;
+
+}   /* end fmPacketQueueInit */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueFree
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Free all buffers in packet queue and its TX class
+ *                  queues, and release the class queue memory.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPacketQueueFree(fm_int sw)
+{
+    fm_status            err       = FM_OK;
+    fm_packetQueue *     txQueue;
+    fm_packetClassQueue *classQueue;
+    fm_packetEntry *     packet;
+    fm_int               txClass;
+
+    txQueue = &GET_PLAT_PKT_STATE(sw)->txQueue;
+    fmPacketQueueLock(txQueue);
+
+    for ( ;
+          txQueue->pullIndex != txQueue->pushIndex ;
+          txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+    {
+        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+
+        if (packet && packet->freePacketBuffer)
+        {
+            fmFreeBuffer(sw, packet->packet);
+        }
+
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+
+    }
+
+    for (txClass = 0 ; txClass < FM_PACKET_TX_CLASS_MAX ; txClass++)
+    {
+        classQueue = &txQueue->classQueue[txClass];
+        fmPacketClassQueueLock(classQueue);
+
+        for ( ;
+              classQueue->pullIndex != classQueue->pushIndex ;
+              classQueue->pullIndex =
+                  (classQueue->pullIndex + 1) % classQueue->numEntries )
+        {
+            packet = &classQueue->entries[classQueue->pullIndex];
+
+            if (packet->freePacketBuffer)
+            {
+                fmFreeBuffer(sw, packet->packet);
+            }
+
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+        }
+
+        /* fmPacketQueueReserve reallocates if a sender comes late */
+        if (classQueue->entries != NULL)
+        {
+            fmFree(classQueue->entries);
+        }
+
+        classQueue->entries    = NULL;
+        classQueue->numEntries = 0;
+        classQueue->pushIndex  = 0;
+        classQueue->pullIndex  = 0;
+
+        fmPacketClassQueueUnlock(classQueue);
+    }
+
+    fmPacketQueueUnlock(txQueue);
+
+    return err;
+
+}   /* end fmPacketQueueFree */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueSchedule
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Moves packets from the TX class queues into the packet
+ *                  queue's dispatch list (packetQueueList), until it holds
+ *                  depth entries. Strict priority classes are served first,
+ *                  in class order, then the weighted classes in weighted
+ *                  round robin order.
+ *
+ * \note            The caller must hold the packet queue lock. The transmit
+ *                  function calls this before draining packetQueueList, and
+ *                  fmPacketQueueAdvance calls it again whenever the list
+ *                  runs empty.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       depth is the number of entries to keep in the dispatch
+ *                  list. Lower values let strict priority packets overtake
+ *                  queued packets sooner, higher values let the transmit
+ *                  function batch more packets.
+ *
+ * \return          The number of entries in the dispatch list.
+ *
+ *****************************************************************************/
+fm_int fmPacketQueueSchedule(fm_packetQueue *queue, fm_int depth)
+{
+    fm_packetClassQueue *classQueue;
+    fm_int               space;
+    fm_int               moved;
+    fm_int               count;
+    fm_int               idlePasses;
+    fm_int               txClass;
+
+    if (depth < 1)
+    {
+        depth = 1;
+    }
+    else if (depth > FM_PACKET_QUEUE_SIZE - 1)
+    {
+        depth = FM_PACKET_QUEUE_SIZE - 1;
+    }
+
+    queue->dispatchDepth = depth;
+
+    count = (queue->pushIndex + FM_PACKET_QUEUE_SIZE - queue->pullIndex) %
+            FM_PACKET_QUEUE_SIZE;
+    space = depth - count;
+
+    /* Strict priority classes */
+    for (txClass = 0 ;
+         (txClass < FM_PACKET_TX_CLASS_MAX) && (space > 0) ;
+         txClass++)
+    {
+        classQueue = &queue->classQueue[txClass];
+
+        if (classQueue->weight == 0)
+        {
+            space -= MoveClassPackets(queue, classQueue, space);
+        }
+    }
+
+    /**************************************************
+     * Weighted classes. Each class may send as many
+     * packets as it has credit. Once no class with
+     * credit has anything to send, all credits are
+     * reloaded from the weights; a second pass in a
+     * row without progress means they are all empty.
+     **************************************************/
+    idlePasses = 0;
+
+    while ( (space > 0) && (idlePasses < 2) )
+    {
+        moved = 0;
+
+        for (txClass = 0 ;
+             (txClass < FM_PACKET_TX_CLASS_MAX) && (space > 0) ;
+             txClass++)
+        {
+            classQueue = &queue->classQueue[txClass];
+
+            if ( (classQueue->weight == 0) || (classQueue->credit == 0) )
+            {
+                continue;
+            }
+
+            count = MoveClassPackets(queue,
+                                     classQueue,
+                                     (classQueue->credit < space) ?
+                                         classQueue->credit : space);
+
+            classQueue->credit -= count;
+            space              -= count;
+            moved              += count;
+        }
+
+        if (moved == 0)
+        {
+            for (txClass = 0 ; txClass < FM_PACKET_TX_CLASS_MAX ; txClass++)
+            {
+                classQueue         = &queue->classQueue[txClass];
+                classQueue->credit = classQueue->weight;
+            }
+
+            idlePasses++;
+        }
+        else
+        {
+            idlePasses = 0;
+        }
+    }
 
-}   /* end fmPacketQueueUnlock */
+    return depth - space;
+
+}   /* end fmPacketQueueSchedule */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketQueueInit
+/** fmPacketQueueAdvance
  * \ingroup intPlatformCommon
  *
- * \desc            Initialize packet queue.
+ * \desc            Retires the entry at the pull index of the packet queue's
+ *                  dispatch list, updating the counters of its TX class, and
+ *                  refills the list if it is now empty.
  *
- * \param[in]       queue is the pointer to the packet queue.
+ * \note            The caller must hold the packet queue lock, and remains
+ *                  responsible for freeing the packet buffer.
  *
- * \param[in]       sw is the switch number.
+ * \param[in]       queue is the pointer to the packet queue.
  *
- * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          NONE
  *
  *****************************************************************************/
-fm_status fmPacketQueueInit(fm_packetQueue *queue, fm_int sw)
+void fmPacketQueueAdvance(fm_packetQueue *queue)
 {
-    /* Initialize mutex if it is enabled */
-    pthread_mutexattr_t attr;
+    fm_packetEntry *     entry;
+    fm_packetClassQueue *classQueue;
+    fm_timestamp         now;
+    fm_timestamp         delta;
+    fm_uint64            latency;
 
-    if (!queue) 
+    entry      = &queue->packetQueueList[queue->pullIndex];
+    classQueue = &queue->classQueue[entry->txClass];
+
+    if (fmGetTime(&now) == FM_OK)
     {
-        return FM_ERR_INVALID_ARGUMENT;
-    }
+        fmSubTimestamps(&now, &entry->enqueueTime, &delta);
+        latency = delta.sec * 1000000 + delta.usec;
 
-    memset(queue, 0, sizeof(*queue));
-    queue->switchNum = sw;
+        classQueue->latencyTotal += latency;
 
-    if ( pthread_mutexattr_init(&attr) )
-    {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
+        if (latency > classQueue->latencyMax)
+        {
+            classQueue->latencyMax = latency;
+        }
     }
 
-    if ( pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE) ||
-         pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED) )
-    {
-        pthread_mutexattr_destroy(&attr);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
-    }
+    classQueue->dequeued++;
 
-    if ( pthread_mutex_init(&queue->mutex, &attr) )
-    {
-        pthread_mutexattr_destroy(&attr);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
-    }
+    queue->pullIndex = (queue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE;
 
-    if ( pthread_mutexattr_destroy(&attr) )
+    if (queue->pullIndex == queue->pushIndex)
     {
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_LOCK_INIT);
+        fmPacketQueueSchedule(queue, queue->dispatchDepth);
     }
 
-    return FM_OK;
+}   /* end fmPacketQueueAdvance */
 
-}   /* end fmPacketQueueInit */
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueSelectClass
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the TX class queue a packet is to be sent
+ *                  through.
+ *
+ * \param[in]       queue is the pointer to the packet queue.
+ *
+ * \param[in]       packet is the buffer containing the packet.
+ *
+ * \return          Pointer to the class queue.
+ *
+ *****************************************************************************/
+fm_packetClassQueue *fmPacketQueueSelectClass(fm_packetQueue *queue,
+                                              fm_buffer *     packet)
+{
+    return &queue->classQueue[ClassifyPacket(packet)];
+
+}   /* end fmPacketQueueSelectClass */
 
 
 
 
 /*****************************************************************************/
-/** fmPacketQueueFree
+/** fmPacketQueueReserve
  * \ingroup intPlatformCommon
  *
- * \desc            Free all buffers in packet queue.
+ * \desc            Returns the entry at the push index of a TX class queue,
+ *                  for the caller to fill in before calling
+ *                  ''fmPacketQueueUpdate''. The queue is grown first if it
+ *                  is full but below its maximum depth.
  *
- * \param[in]       sw is the switch number.
+ * \note            The caller must hold the class queue lock.
+ *
+ * \param[in]       queue is the pointer to the class queue.
+ *
+ * \param[out]      entry points to caller-allocated storage where the
+ *                  pointer to the entry is stored.
  *
  * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \return          FM_ERR_NO_MEM if the queue has no memory allocated and
+ *                  none could be.
  *
  *****************************************************************************/
-fm_status fmPacketQueueFree(fm_int sw)
+fm_status fmPacketQueueReserve(fm_packetClassQueue *queue,
+                               fm_packetEntry **    entry)
 {
-    fm_status       err       = FM_OK;
-    fm_packetQueue *txQueue;
-    fm_packetEntry *packet;
-
-    txQueue = &GET_PLAT_PKT_STATE(sw)->txQueue;
-    fmPacketQueueLock(txQueue);
+    fm_status err;
+    fm_uint   numEntries;
 
-    for ( ;
-          txQueue->pullIndex != txQueue->pushIndex ;
-          txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+    if (queue->numEntries == 0)
     {
-        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+        err = ResizeClassQueue(queue, ClassQueueBaseSize(queue));
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
+    else if ( ( (queue->pushIndex + 1) % queue->numEntries ==
+                queue->pullIndex ) &&
+              ( queue->numEntries <= (fm_uint) queue->maxDepth ) )
+    {
+        numEntries = queue->numEntries * 2;
 
-        if (packet && packet->freePacketBuffer)
+        if (numEntries > (fm_uint) queue->maxDepth + 1)
         {
-            fmFreeBuffer(sw, packet->packet);
+            numEntries = queue->maxDepth + 1;
         }
 
-        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
-
+        /* If this fails the queue stays full and fmPacketQueueUpdate
+         * reports it */
+        (void) ResizeClassQueue(queue, numEntries);
     }
 
-    fmPacketQueueUnlock(txQueue);
+    *entry = &queue->entries[queue->pushIndex];
 
-    return err;
+    return FM_OK;
 
-}   /* end fmPacketQueueFree */
+}   /* end fmPacketQueueReserve */
 
 
 
@@ -548,29 +1236,50 @@ fm_status fmPacketQueueFree(fm_int sw)
  *
  * \desc            Update packet queue by advancing one entry
  *
- * \param[in]       queue is the pointer to the packet queue.
+ * \note            The caller must hold the class queue lock.
+ *
+ * \param[in]       queue is the pointer to the class queue.
  *
  * \return          FM_OK if successful.
  * \return          FM_ERR_TX_PACKET_QUEUE_FULL if queue if full.
  *
  *****************************************************************************/
-fm_status fmPacketQueueUpdate(fm_packetQueue *queue)
+fm_status fmPacketQueueUpdate(fm_packetClassQueue *queue)
 {
+    fm_packetEntry *entry;
+    fm_int          depth;
+
+    depth = ClassQueueDepth(queue);
 
     /* check if the Tx queue is full */
-    if ( (queue->pushIndex + 1) % FM_PACKET_QUEUE_SIZE == queue->pullIndex )
+    if ( (queue->numEntries == 0) ||
+         ( (queue->pushIndex + 1) % queue->numEntries == queue->pullIndex ) ||
+         (depth >= queue->maxDepth) )
     {
+        queue->dropped++;
+
         FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
                      "fmPacketQueueUpdate:"
-                     "TX queue is full?: pushIndex = %d, pullIndex = %d\n",
-                     queue->pushIndex, queue->pullIndex);
+                     "TX queue is full?: class = %d, pushIndex = %d, "
+                     "pullIndex = %d\n",
+                     queue->txClass, queue->pushIndex, queue->pullIndex);
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_TX_PACKET_QUEUE_FULL);
     }
     else
     {
+        entry          = &queue->entries[queue->pushIndex];
+        entry->txClass = queue->txClass;
+        fmGetTime(&entry->enqueueTime);
+
         /* updated indices */
         ++queue->pushIndex;
-        queue->pushIndex = queue->pushIndex % FM_PACKET_QUEUE_SIZE;
+        queue->pushIndex = queue->pushIndex % queue->numEntries;
+        queue->enqueued++;
+
+        if (depth + 1 > queue->highWater)
+        {
+            queue->highWater = depth + 1;
+        }
     }
 
     return FM_OK;
@@ -580,13 +1289,101 @@ fm_status fmPacketQueueUpdate(fm_packetQueue *queue)
 
 
 
+/*****************************************************************************/
+/** fmPacketQueueRollback
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Removes the entries a sender has queued in a TX class
+ *                  queue since it read the mark, so that a send which fails
+ *                  part way leaves nothing queued.
+ *
+ * \note            The caller must have held the class queue lock since it
+ *                  read the mark.
+ *
+ * \param[in]       queue is the pointer to the class queue.
+ *
+ * \param[in]       mark is the value of the queue's enqueued counter before
+ *                  the first entry was queued.
+ *
+ * \return          NONE
+ *
+ *****************************************************************************/
+void fmPacketQueueRollback(fm_packetClassQueue *queue, fm_uint64 mark)
+{
+    fm_uint count;
+
+    if ( (queue->enqueued <= mark) || (queue->numEntries == 0) )
+    {
+        return;
+    }
+
+    /* The queue may have been resized since the mark was read, so count
+     * entries back from the push index rather than restoring it. */
+    count = (fm_uint) (queue->enqueued - mark);
+
+    queue->pushIndex = (queue->pushIndex + queue->numEntries - count) %
+                       queue->numEntries;
+    queue->enqueued  = mark;
+
+}   /* end fmPacketQueueRollback */
+
+
+
+
+/*****************************************************************************/
+/** fmPacketQueueApplyDropPolicy
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Applies the drop policy of a TX class queue to a send
+ *                  that failed because the queue was full.
+ *
+ * \note            Called after the queued entries were rolled back and the
+ *                  class queue lock released.
+ *
+ * \param[in]       sw is the switch the packet was sent on.
+ *
+ * \param[in]       queue is the pointer to the class queue.
+ *
+ * \param[in]       packet is the buffer containing the packet.
+ *
+ * \param[in]       err is the status of the send.
+ *
+ * \return          FM_OK if the packet was discarded.
+ * \return          err otherwise.
+ *
+ *****************************************************************************/
+fm_status fmPacketQueueApplyDropPolicy(fm_int               sw,
+                                       fm_packetClassQueue *queue,
+                                       fm_buffer *          packet,
+                                       fm_status            err)
+{
+    if ( (err == FM_ERR_TX_PACKET_QUEUE_FULL) &&
+         (queue->dropPolicy == FM_PACKET_TX_DROP_DISCARD) )
+    {
+        /* Ownership passed to us when we return FM_OK */
+        (void) fmFreeBufferChain(sw, packet);
+
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+
+        err = FM_OK;
+    }
+
+    return err;
+
+}   /* end fmPacketQueueApplyDropPolicy */
+
+
+
+
 /*****************************************************************************/
 /** fmPacketQueueEnqueue
  * \ingroup intPlatformCommon
  *
- * \desc            Queue packet to the tx packet queue
+ * \desc            Queue packet to a TX class queue
  *
- * \param[in]       queue is the pointer to the packet queue.
+ * \note            The caller must hold the class queue lock.
+ *
+ * \param[in]       queue is the pointer to the class queue.
  *
  * \param[in]       packet is the buffer containing the packet.
  *
@@ -607,17 +1404,19 @@ fm_status fmPacketQueueUpdate(fm_packetQueue *queue)
  *                  failure.
  *
  *****************************************************************************/
-fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
-                               fm_buffer *      packet,
-                               fm_int           packetLength,
-                               fm_islTag *      islTag,
-                               fm_islTagFormat  islTagFormat,
-                               fm_bool          suppressVlanTag,
-                               fm_bool          freeBuffer)
+fm_status fmPacketQueueEnqueue(fm_packetClassQueue *queue,
+                               fm_buffer *          packet,
+                               fm_int               packetLength,
+                               fm_islTag *          islTag,
+                               fm_islTagFormat      islTagFormat,
+                               fm_bool              suppressVlanTag,
+                               fm_bool              freeBuffer)
 {
     fm_packetEntry *entry;
+    fm_status       err;
 
-    entry = &queue->packetQueueList[queue->pushIndex];
+    err = fmPacketQueueReserve(queue, &entry);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
     entry->packet = packet;
     entry->length = packetLength;
@@ -632,29 +1431,191 @@ fm_status fmPacketQueueEnqueue(fm_packetQueue * queue,
 
     FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
                  "fm_packet_queue_enqueue: packet queued "
-                 "in slot %d, length %d bytes\n",
+                 "in class %d slot %d, length %d bytes\n",
+                 queue->txClass,
                  queue->pushIndex,
                  entry->length);
 
-    /* check if the Tx queue is full */
-    if ( (queue->pushIndex + 1) % FM_PACKET_QUEUE_SIZE == queue->pullIndex )
+    return fmPacketQueueUpdate(queue);
+
+}   /* end fmPacketQueueEnqueue */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericPacketGetTxClassAttribute
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Retrieves the configuration or counters of a TX class.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       attr is FM_SWITCH_PACKET_TX_CLASS_CONFIG or
+ *                  FM_SWITCH_PACKET_TX_CLASS_STATS.
+ *
+ * \param[in,out]   value points to an ''fm_packetTxClassConfig'' or
+ *                  ''fm_packetTxClassStats'' structure whose txClass field
+ *                  selects the class.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if the class is invalid.
+ * \return          FM_ERR_INVALID_ATTRIB if attr is not recognized.
+ *
+ *****************************************************************************/
+fm_status fmGenericPacketGetTxClassAttribute(fm_int sw,
+                                             fm_int attr,
+                                             void * value)
+{
+    fm_packetQueue *        txQueue;
+    fm_packetClassQueue *   classQueue;
+    fm_packetTxClassConfig *config;
+    fm_packetTxClassStats * stats;
+    fm_int                  txClass;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d attr=%d value=%p\n",
+                 sw,
+                 attr,
+                 value);
+
+    switch (attr)
     {
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "fm_packet_queue_enqueue:"
-                     "TX queue is full?: pushIndex = %d, pullIndex = %d\n",
-                     queue->pushIndex, queue->pullIndex);
-        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_TX_PACKET_QUEUE_FULL);
+        case FM_SWITCH_PACKET_TX_CLASS_CONFIG:
+            txClass = ( (fm_packetTxClassConfig *) value )->txClass;
+            break;
+
+        case FM_SWITCH_PACKET_TX_CLASS_STATS:
+            txClass = ( (fm_packetTxClassStats *) value )->txClass;
+            break;
+
+        default:
+            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ATTRIB);
+    }
+
+    if ( (txClass < 0) || (txClass >= FM_PACKET_TX_CLASS_MAX) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    txQueue    = GetTxQueue(sw);
+    classQueue = &txQueue->classQueue[txClass];
+
+    /* The dequeue counters are updated under the packet queue lock */
+    fmPacketQueueLock(txQueue);
+    fmPacketClassQueueLock(classQueue);
+
+    if (attr == FM_SWITCH_PACKET_TX_CLASS_CONFIG)
+    {
+        config             = (fm_packetTxClassConfig *) value;
+        config->maxDepth   = classQueue->maxDepth;
+        config->weight     = classQueue->weight;
+        config->dropPolicy = classQueue->dropPolicy;
     }
     else
     {
-        /* updated indices */
-        ++queue->pushIndex;
-        queue->pushIndex = queue->pushIndex % FM_PACKET_QUEUE_SIZE;
+        stats               = (fm_packetTxClassStats *) value;
+        stats->enqueued     = classQueue->enqueued;
+        stats->dropped      = classQueue->dropped;
+        stats->dequeued     = classQueue->dequeued;
+        stats->latencyTotal = classQueue->latencyTotal;
+        stats->latencyMax   = classQueue->latencyMax;
+        stats->depth        = ClassQueueDepth(classQueue);
+        stats->highWater    = classQueue->highWater;
     }
 
-    return FM_OK;
+    fmPacketClassQueueUnlock(classQueue);
+    fmPacketQueueUnlock(txQueue);
 
-}   /* end fmPacketQueueEnqueue */
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_OK);
+
+}   /* end fmGenericPacketGetTxClassAttribute */
+
+
+
+
+/*****************************************************************************/
+/** fmGenericPacketSetTxClassAttribute
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Sets the configuration of a TX class.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       attr is FM_SWITCH_PACKET_TX_CLASS_CONFIG.
+ *
+ * \param[in]       value points to an ''fm_packetTxClassConfig'' structure.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if a field of value is invalid.
+ * \return          FM_ERR_READONLY_ATTRIB if attr is
+ *                  FM_SWITCH_PACKET_TX_CLASS_STATS.
+ * \return          FM_ERR_INVALID_ATTRIB if attr is not recognized.
+ *
+ *****************************************************************************/
+fm_status fmGenericPacketSetTxClassAttribute(fm_int sw,
+                                             fm_int attr,
+                                             void * value)
+{
+    fm_packetQueue *        txQueue;
+    fm_packetClassQueue *   classQueue;
+    fm_packetTxClassConfig *config;
+
+    FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
+                 "sw=%d attr=%d value=%p\n",
+                 sw,
+                 attr,
+                 value);
+
+    switch (attr)
+    {
+        case FM_SWITCH_PACKET_TX_CLASS_CONFIG:
+            break;
+
+        case FM_SWITCH_PACKET_TX_CLASS_STATS:
+            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_READONLY_ATTRIB);
+
+        default:
+            FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ATTRIB);
+    }
+
+    config = (fm_packetTxClassConfig *) value;
+
+    if ( (config->txClass < 0) ||
+         (config->txClass >= FM_PACKET_TX_CLASS_MAX) ||
+         (config->maxDepth < 1) ||
+         (config->maxDepth > FM_PACKET_TX_CLASS_MAX_DEPTH) ||
+         (config->weight < 0) ||
+         (config->weight > FM_PACKET_TX_CLASS_MAX_WEIGHT) ||
+         (config->dropPolicy < 0) ||
+         (config->dropPolicy >= FM_PACKET_TX_DROP_MAX) )
+    {
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_INVALID_ARGUMENT);
+    }
+
+    txQueue    = GetTxQueue(sw);
+    classQueue = &txQueue->classQueue[config->txClass];
+
+    /* The weight and credit belong to the scheduler */
+    fmPacketQueueLock(txQueue);
+    fmPacketClassQueueLock(classQueue);
+
+    /* A lower depth applies to new packets, queued ones are kept */
+    classQueue->maxDepth   = config->maxDepth;
+    classQueue->weight     = config->weight;
+    classQueue->dropPolicy = config->dropPolicy;
+
+    if (classQueue->credit > classQueue->weight)
+    {
+        classQueue->credit = classQueue->weight;
+    }
+
+    fmPacketClassQueueUnlock(classQueue);
+    fmPacketQueueUnlock(txQueue);
+
+    FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_OK);
+
+}   /* end fmGenericPacketSetTxClassAttribute */
 
 
 
@@ -1223,7 +2184,8 @@ fm_status fmGenericPacketHandlingInitializeV2(fm_int sw, fm_bool hasFcs)
     /* clear out all state */
     memset( ps, 0, sizeof(fm_packetHandlingState) );
 
-    fmPacketQueueInit(&ps->txQueue, sw);
+    err = fmPacketQueueInit(&ps->txQueue, sw);
+    FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
     
     /* reset state here */
     ps->recvInProgress       = FALSE;
@@ -1281,16 +2243,17 @@ fm_status fmGenericSendPacketISL(fm_int          sw,
                                  fm_int          numPorts,
                                  fm_buffer *     packet)
 {
-    fm_packetQueue *txQueue;
-    fm_int          packetLength;
-    fm_int          port;
-    fm_int          cpuMaxFrameSize;
-    fm_int          oldPushIndex;
-    fm_int          cpuPort;
-    fm_int          masterSw; /* For support FIBM slave switch */
-    fm_status       err = FM_OK;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
+    fm_packetQueue *     txQueue;
+    fm_packetClassQueue *classQueue;
+    fm_int               packetLength;
+    fm_int               port;
+    fm_int               cpuMaxFrameSize;
+    fm_uint64            mark;
+    fm_int               cpuPort;
+    fm_int               masterSw; /* For support FIBM slave switch */
+    fm_status            err = FM_OK;
+    fm_bool              isRawSocket;
+    fm_int               mtu;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
                  "sw = %d, "
@@ -1353,11 +2316,12 @@ fm_status fmGenericSendPacketISL(fm_int          sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    txQueue = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+    txQueue    = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+    classQueue = fmPacketQueueSelectClass(txQueue, packet);
      
-    fmPacketQueueLock(txQueue);
+    fmPacketClassQueueLock(classQueue);
 
-    oldPushIndex = txQueue->pushIndex;
+    mark = classQueue->enqueued;
 
     for (port = 0 ; port < numPorts ; port++)
     {
@@ -1373,7 +2337,7 @@ fm_status fmGenericSendPacketISL(fm_int          sw,
              *  ports in the vlan */
             freePacketBuffer = TRUE;
         }
-        err = fmPacketQueueEnqueue(txQueue,
+        err = fmPacketQueueEnqueue(classQueue,
                                    packet,
                                    packetLength,
                                    &islTagList[port],
@@ -1383,7 +2347,7 @@ fm_status fmGenericSendPacketISL(fm_int          sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    fmPacketQueueUnlock(txQueue);
+    fmPacketClassQueueUnlock(classQueue);
 
     if (err == FM_OK)
     {
@@ -1433,8 +2397,9 @@ fm_status fmGenericSendPacketISL(fm_int          sw,
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
 ABORT:
-    txQueue->pushIndex = oldPushIndex;
-    fmPacketQueueUnlock(txQueue);
+    fmPacketQueueRollback(classQueue, mark);
+    fmPacketClassQueueUnlock(classQueue);
+    err = fmPacketQueueApplyDropPolicy(sw, classQueue, packet, err);
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
 }   /* end fmGenericSendPacketISL */
@@ -1483,20 +2448,21 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
                                       fm_int     cpuPort,
                                       fm_uint32  switchPriority)
 {
-    fm_status       err = FM_OK;
-    fm_switch      *switchPtr;
-    fm_packetQueue *txQueue;
-    fm_packetEntry *entry;
-    fm_int          packetLength;
-    fm_int          listIndex;
-    fm_int          port;
-    fm_packetInfo   tempInfo;
-    fm_int          oldPushIndex;
-    fm_int          masterSw; /* For support FIBM slave switch */
-    fm_int          newPortList[numPorts];
-    fm_bool         packetQueueLockFlag;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
+    fm_status            err = FM_OK;
+    fm_switch           *switchPtr;
+    fm_packetQueue      *txQueue;
+    fm_packetClassQueue *classQueue;
+    fm_packetEntry      *entry;
+    fm_int               packetLength;
+    fm_int               listIndex;
+    fm_int               port;
+    fm_packetInfo        tempInfo;
+    fm_uint64            mark;
+    fm_int               masterSw; /* For support FIBM slave switch */
+    fm_int               newPortList[numPorts];
+    fm_bool              packetQueueLockFlag;
+    fm_bool              isRawSocket;
+    fm_int               mtu;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
                  "sw = %d, "
@@ -1510,7 +2476,8 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
 
     switchPtr           = GET_SWITCH_PTR(sw);
     txQueue             = &GET_PLAT_PKT_STATE(sw)->txQueue;
-    oldPushIndex        = -1;
+    classQueue          = NULL;
+    mark                = 0;
     packetQueueLockFlag = FALSE;
     
     /* Validate all ports are valid */
@@ -1561,19 +2528,21 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    fmPacketQueueLock(txQueue);
+    classQueue = fmPacketQueueSelectClass(txQueue, packet);
+
+    fmPacketClassQueueLock(classQueue);
     packetQueueLockFlag = TRUE;
 
     /***********************************************************
-     * oldSendPushIndex records the current push index in the TX
-     * queue. We use it to keep tab on where we started upon
-     * entering this function, in case of the need for roll back
-     * on the push index when (1) the tx queue is full; or (2)
-     * the function calls returns an error which we return to the
-     * user application, after having enqued some entries in the
-     * tx queue.
+     * mark records the number of entries queued in the TX class
+     * queue so far. We use it to keep tab on where we started
+     * upon entering this function, in case of the need for roll
+     * back when (1) the tx queue is full; or (2) the function
+     * calls returns an error which we return to the user
+     * application, after having enqued some entries in the tx
+     * queue.
      **********************************************************/
-    oldPushIndex = txQueue->pushIndex;
+    mark = classQueue->enqueued;
 
     for (listIndex = 0 ; listIndex < numPorts ; listIndex++)
     {
@@ -1587,7 +2556,9 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
 
         /* tempInfo will be used to generate ISL tag */
         memset( &tempInfo, 0, sizeof(tempInfo) ); 
-        entry = &txQueue->packetQueueList[txQueue->pushIndex];
+
+        err = fmPacketQueueReserve(classQueue, &entry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
         /* Build the packetEntry */
         entry->packet = packet;
@@ -1631,12 +2602,13 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
 
         FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
                      "fmGenericSendPacketDirected: packet queued "
-                     "in slot %d, length %d bytes, port %d\n",
-                     txQueue->pushIndex,
+                     "in class %d slot %d, length %d bytes, port %d\n",
+                     classQueue->txClass,
+                     classQueue->pushIndex,
                      entry->length,
                      port);
 
-        err = fmPacketQueueUpdate(txQueue);
+        err = fmPacketQueueUpdate(classQueue);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
         if (listIndex < numPorts - 1)
@@ -1651,7 +2623,7 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
         }
     }
 
-    fmPacketQueueUnlock(txQueue);
+    fmPacketClassQueueUnlock(classQueue);
     packetQueueLockFlag = FALSE;
 
     if (err == FM_OK)
@@ -1700,13 +2672,11 @@ fm_status fmGenericSendPacketDirected(fm_int     sw,
 ABORT:
     if (packetQueueLockFlag)
     {
-        /* There was an error, lets restore the txQueue's push index */
-        if (oldPushIndex != -1)
-        {
-            txQueue->pushIndex = oldPushIndex;
-        }
+        /* There was an error, lets remove what we queued */
+        fmPacketQueueRollback(classQueue, mark);
+        fmPacketClassQueueUnlock(classQueue);
 
-        fmPacketQueueUnlock(txQueue);
+        err = fmPacketQueueApplyDropPolicy(sw, classQueue, packet, err);
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
@@ -1750,15 +2720,16 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
                                       fm_int     cpuPort,
                                       fm_uint32  switchPriority)
 {
-    fm_switch      *switchPtr = GET_SWITCH_PTR(sw);
-    fm_packetQueue *txQueue;
-    fm_packetEntry *entry;
-    fm_int          packetLength;
-    fm_status       err = FM_OK;
-    fm_packetInfo   tempInfo;
-    fm_int          masterSw;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
+    fm_switch           *switchPtr = GET_SWITCH_PTR(sw);
+    fm_packetQueue      *txQueue;
+    fm_packetClassQueue *classQueue;
+    fm_packetEntry      *entry;
+    fm_int               packetLength;
+    fm_status            err = FM_OK;
+    fm_packetInfo        tempInfo;
+    fm_int               masterSw;
+    fm_bool              isRawSocket;
+    fm_int               mtu;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
                  "sw = %d, "
@@ -1807,9 +2778,16 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    fmPacketQueueLock(txQueue); 
+    classQueue = fmPacketQueueSelectClass(txQueue, packet);
 
-    entry = &txQueue->packetQueueList[txQueue->pushIndex];
+    fmPacketClassQueueLock(classQueue); 
+
+    err = fmPacketQueueReserve(classQueue, &entry);
+    if (err != FM_OK)
+    {
+        fmPacketClassQueueUnlock(classQueue); 
+        FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
+    }
 
     /* Build the packetEntry */
     entry->packet           = packet;
@@ -1833,21 +2811,22 @@ fm_status fmGenericSendPacketSwitched(fm_int     sw,
                                        &entry->suppressVlanTag);
     if (err != FM_OK)
     {
-        fmPacketQueueUnlock(txQueue); 
+        fmPacketClassQueueUnlock(classQueue); 
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    err = fmPacketQueueUpdate(txQueue);
+    err = fmPacketQueueUpdate(classQueue);
 
     if (err != FM_OK)
     {
         /* Check for queue FULL */
-        fmPacketQueueUnlock(txQueue);
-    
+        fmPacketClassQueueUnlock(classQueue);
+
+        err = fmPacketQueueApplyDropPolicy(sw, classQueue, packet, err);
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    fmPacketQueueUnlock(txQueue);
+    fmPacketClassQueueUnlock(classQueue);
 
     if (!fmRootPlatform->dmaEnabled)
     {
@@ -1946,24 +2925,25 @@ fm_status fmGenericSendPacket(fm_int         sw,
                               fm_uint32      trapGlort,
                               fm_bool        suppressVlanTagAllowed)
 {
-    fm_switch      *switchPtr;
-    fm_packetQueue *txQueue;
-    fm_int          masterSw;
-    fm_packetEntry *entry;
-    fm_int          firstPort;
-    fm_int          nextPort;
-    fm_int          state;
-    fm_bool         packetSent = FALSE;
-    fm_port        *dPort;
-    fm_int          firstLAGPort;
-    fm_bool         allowDirectSendToCpu = TRUE;
-    fm_int          oldPushIndex;
-    fm_packetInfo   tempInfo;
-    fm_int          packetLength;
-    fm_int          cpuMaxFrameSize;
-    fm_status       err;
-    fm_bool         isRawSocket;
-    fm_int          mtu;
+    fm_switch           *switchPtr;
+    fm_packetQueue      *txQueue;
+    fm_packetClassQueue *classQueue;
+    fm_int               masterSw;
+    fm_packetEntry      *entry;
+    fm_int               firstPort;
+    fm_int               nextPort;
+    fm_int               state;
+    fm_bool              packetSent = FALSE;
+    fm_port             *dPort;
+    fm_int               firstLAGPort;
+    fm_bool              allowDirectSendToCpu = TRUE;
+    fm_uint64            mark;
+    fm_packetInfo        tempInfo;
+    fm_int               packetLength;
+    fm_int               cpuMaxFrameSize;
+    fm_status            err;
+    fm_bool              isRawSocket;
+    fm_int               mtu;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX,
                  "sw = %d, "
@@ -2032,19 +3012,20 @@ fm_status fmGenericSendPacket(fm_int         sw,
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_FRAME_SIZE_EXCEEDS_MTU);
     }
 
-    txQueue = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+    txQueue    = &GET_PLAT_PKT_STATE(masterSw)->txQueue;
+    classQueue = fmPacketQueueSelectClass(txQueue, packet);
 
-    fmPacketQueueLock(txQueue);
+    fmPacketClassQueueLock(classQueue);
 
     /***********************************************************
-     * oldSendPushIndex records the current push index in the TX
-     * queue. We use it to keep tab on where we started upon
-     * entering this function, in case of the need for roll back
-     * on the push index when the tx queue is full or if we
-     * encounter an error condition after having enqued some
-     * entries in the tx queue;
+     * mark records the number of entries queued in the TX class
+     * queue so far. We use it to keep tab on where we started
+     * upon entering this function, in case of the need for roll
+     * back when the tx queue is full or if we encounter an
+     * error condition after having enqued some entries in the
+     * tx queue;
      **********************************************************/
-    oldPushIndex = txQueue->pushIndex;
+    mark = classQueue->enqueued;
 
     if (info->logicalPort != FM_DIRECT_VLAN_SEND)
     {
@@ -2113,7 +3094,8 @@ fm_status fmGenericSendPacket(fm_int         sw,
             }
         }
 
-        entry = &txQueue->packetQueueList[txQueue->pushIndex];
+        err = fmPacketQueueReserve(classQueue, &entry);
+        FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
         /* copy over packet info */
         FM_MEMCPY_S( &tempInfo, sizeof(tempInfo), info, sizeof(*info) );
@@ -2148,11 +3130,12 @@ fm_status fmGenericSendPacket(fm_int         sw,
 
         FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
                      "fmGenericSendPacket: packet queued "
-                     "in slot %d, length %d bytes\n",
-                     txQueue->pushIndex,
+                     "in class %d slot %d, length %d bytes\n",
+                     classQueue->txClass,
+                     classQueue->pushIndex,
                      entry->length);
 
-        err = fmPacketQueueUpdate(txQueue);
+        err = fmPacketQueueUpdate(classQueue);
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
     }
@@ -2164,7 +3147,8 @@ fm_status fmGenericSendPacket(fm_int         sw,
 
         while (firstPort != -1)
         {
-            entry = &txQueue->packetQueueList[txQueue->pushIndex];
+            err = fmPacketQueueReserve(classQueue, &entry);
+            FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
             /* copy over packet info to tempInfo so later can build isl */
             FM_MEMCPY_S( &tempInfo, sizeof(tempInfo), info, sizeof(*info) );
@@ -2231,11 +3215,12 @@ fm_status fmGenericSendPacket(fm_int         sw,
                  ***********************************************/
                  FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
                              "fmGenericSendPacket: packet queued "
-                             "in slot %d, length %d bytes, port %d\n",
-                             txQueue->pushIndex,
+                             "in class %d slot %d, length %d bytes, port %d\n",
+                             classQueue->txClass,
+                             classQueue->pushIndex,
                              entry->length, firstPort);
 
-                err = fmPacketQueueUpdate(txQueue);
+                err = fmPacketQueueUpdate(classQueue);
                 FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_EVENT_PKT_TX, err);
 
                 packetSent = TRUE;
@@ -2292,7 +3277,7 @@ fm_status fmGenericSendPacket(fm_int         sw,
         }
     }
 
-    fmPacketQueueUnlock(txQueue);
+    fmPacketClassQueueUnlock(classQueue);
 
     if (err == FM_OK)
     {
@@ -2339,8 +3324,10 @@ fm_status fmGenericSendPacket(fm_int         sw,
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
 ABORT:
-    txQueue->pushIndex = oldPushIndex;
-    fmPacketQueueUnlock(txQueue);
+    fmPacketQueueRollback(classQueue, mark);
+    fmPacketClassQueueUnlock(classQueue);
+
+    err = fmPacketQueueApplyDropPolicy(sw, classQueue, packet, err);
 
     FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, err);
 
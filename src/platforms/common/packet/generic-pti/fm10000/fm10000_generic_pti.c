@@ -469,12 +469,13 @@ fm_status fm10000PTISendPackets(fm_int sw)
     fmPacketQueueLock(txQueue);
 
     /**************************************************
-     * Iterate through the packets in the tx queue
+     * Iterate through the packets in the tx queue, as
+     * handed out by the TX class scheduler
      **************************************************/
 
-    for ( ; 
+    for ( fmPacketQueueSchedule(txQueue, FM_PACKET_TX_DISPATCH_DEPTH) ; 
          txQueue->pullIndex != txQueue->pushIndex ;
-         txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+         fmPacketQueueAdvance(txQueue) )
     {
         pkt = &txQueue->packetQueueList[txQueue->pullIndex];
 
@@ -38,11 +38,15 @@
 
 #include <sys/socket.h>
 #include <sys/ioctl.h>
-#include <netpacket/packet.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <linux/if_packet.h>
 #include <linux/if_ether.h>
 #include <arpa/inet.h>
 #include <net/if.h>  
 #include <poll.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 
 /* Redefine some type to include ethtool.h */
 typedef __u64 u64;
@@ -85,22 +89,1798 @@ typedef __u8 u8;
 
 #define ETHTOOL_PRV_FLAG_IES        (1 << 0)
 
+/* Upper bound of the configurable recvmmsg / sendmmsg batch sizes */
+#define FM_RAW_SOCKET_MAX_BATCH     64
+
+/* Receive iovecs per frame: the timestamp plus enough buffers for the
+ * largest netdev MTU */
+#define FM_RAW_SOCKET_MAX_RX_IOV    (1 + (65536 / FM_BUFFER_SIZE_BYTES))
+
+/* Size in bytes of the netlink link event receive buffer */
+#define FM_LINK_EVENT_BUFFER_SIZE   8192
+
+/* Ethertype of the frames exchanged by fmDbgRawPacketSocketBenchmark
+ * (IEEE 802 local experimental ethertype 1) */
+#define FM_RAW_SOCKET_BENCH_ETYPE   0x88B5
+
+/* Size of a memory-mapped ring block, a multiple of the page size */
+#define FM_RAW_SOCKET_RING_BLOCK_SIZE       (1 << 18)
+
+/* Size of a transmit ring frame, enough for the largest frame with its
+ * timetag, FTAG and ring header */
+#define FM_RAW_SOCKET_RING_TX_FRAME_SIZE    (1 << 14)
+
+/* Nominal receive ring frame size, only used to size the ring */
+#define FM_RAW_SOCKET_RING_RX_FRAME_SIZE    (1 << 11)
+
+/* Headroom reserved ahead of each received frame. The kernel places the
+ * 14-byte MAC header right before a 16-byte aligned network header, so 2
+ * more bytes word-align the frame data following the 8-byte timestamp. */
+#define FM_RAW_SOCKET_RING_RESERVE          2
+
+/* Time after which the kernel hands a partially filled receive block over */
+#define FM_RAW_SOCKET_RING_BLOCK_TOV_MSEC   1
+
+/* Bounds of the configurable number of blocks per ring */
+#define FM_RAW_SOCKET_RING_MIN_BLOCKS       2
+#define FM_RAW_SOCKET_RING_MAX_BLOCKS       1024
+
+/* Offset of the frame data in a transmit ring frame */
+#define FM_RAW_SOCKET_RING_TX_DATA_OFFSET   \
+    (TPACKET3_HDRLEN - sizeof(struct sockaddr_ll))
+
+/* Memory-mapped TPACKET_V3 rings of the raw packet socket. Received frames
+ * are passed to the API as buffers pointing into the receive ring; each
+ * such buffer holds a reference on its ring block and the block is handed
+ * back to the kernel once the last reference is released. The ring state
+ * itself lives until the socket and every held block have released it. */
+typedef struct _fm_rawSocketRing
+{
+    /* References on the ring state: one for the socket plus one per
+     * receive block not owned by the kernel */
+    volatile fm_int refs;
+
+    /* Mapping holding the receive ring followed by the transmit ring */
+    fm_byte *       map;
+    size_t          mapSize;
+
+    /* Receive ring */
+    fm_byte *       rxRing;
+    fm_int          rxNumBlocks;
+
+    /* Next receive block to process */
+    fm_int          rxBlock;
+
+    /* References held on each receive block: one per buffer pointing into
+     * it plus one while the receive thread processes it. -1 while the
+     * block is being handed back to the kernel. */
+    volatile fm_int *rxBlockRefs;
+
+    /* Event signalled when a block is handed back to the kernel while the
+     * receive thread waits for it */
+    fm_int          rxWakeFd;
+    volatile fm_bool rxWaiting;
+
+    /* Transmit ring, NULL if frames are sent with sendmmsg */
+    fm_byte *       txRing;
+    fm_int          txNumFrames;
+
+    /* Next transmit frame to fill */
+    fm_int          txFrame;
+
+    /* Oldest frame handed to the kernel and not yet sent, and the number
+     * of such frames */
+    fm_int          txSentFrame;
+    fm_int          txPending;
+
+    /* Frames passed in place and frames that had to be copied */
+    fm_uint64       rxViewFrames;
+    fm_uint64       rxCopiedFrames;
+
+} fm_rawSocketRing;
+
+/* One message of a recvmmsg batch, with the buffer chain armed for it */
+typedef struct _fm_rawSocketRxSlot
+{
+    /* Buffer chain receiving the frame, NULL if the slot is not armed */
+    fm_buffer *  chain;
+
+    /* 8-byte timestamp preceding the frame */
+    fm_byte      rawTS[8];
+
+    /* Timestamp followed by the buffers of the chain */
+    struct iovec iov[FM_RAW_SOCKET_MAX_RX_IOV];
+    fm_int       numIov;
+
+#ifdef ENABLE_TIMESTAMP
+    union {
+        struct cmsghdr  cm;
+        char            control[512];
+
+    } control;
+#endif
+
+} fm_rawSocketRxSlot;
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
 
-/*****************************************************************************
- * Local Variables
+/*****************************************************************************
+ * Local Variables
+ *****************************************************************************/
+
+/* Timetag sent ahead of every frame. The value is ignored by the driver as
+ * it gets overwritten by the PEP, so all frames share it. */
+static fm_uint64 txTimeTag = 0;
+
+/*****************************************************************************
+ * Local function prototypes.
+ *****************************************************************************/
+
+
+/*****************************************************************************
+ * Local Functions
+ *****************************************************************************/
+
+/*****************************************************************************/
+/** SetIfaceState
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Updates the cached running state and MTU of the raw
+ *                  packet socket interface.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       running is the running state of the interface.
+ *
+ * \param[in]       mtu is the MTU of the interface, or -1 to leave the
+ *                  cached MTU unchanged.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void SetIfaceState(fm_int sw, fm_bool running, fm_int mtu)
+{
+    fmCaptureLock(&GET_PLAT_STATE(sw)->ifaceStateLock, FM_WAIT_FOREVER);
+
+    GET_PLAT_STATE(sw)->ifaceRunning = running;
+
+    if (mtu != -1)
+    {
+        GET_PLAT_STATE(sw)->ifaceMtu = mtu;
+    }
+
+    fmReleaseLock(&GET_PLAT_STATE(sw)->ifaceStateLock);
+
+}   /* end SetIfaceState */
+
+
+
+
+/*****************************************************************************/
+/** GetIfaceState
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Returns the cached running state and MTU of the raw
+ *                  packet socket interface.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[out]      mtu points to caller-allocated storage where the MTU
+ *                  is written. May be NULL.
+ *
+ * \return          TRUE if the interface is running.
+ *
+ *****************************************************************************/
+static fm_bool GetIfaceState(fm_int sw, fm_int *mtu)
+{
+    fm_bool running;
+
+    fmCaptureLock(&GET_PLAT_STATE(sw)->ifaceStateLock, FM_WAIT_FOREVER);
+
+    running = GET_PLAT_STATE(sw)->ifaceRunning;
+
+    if (mtu != NULL)
+    {
+        *mtu = GET_PLAT_STATE(sw)->ifaceMtu;
+    }
+
+    fmReleaseLock(&GET_PLAT_STATE(sw)->ifaceStateLock);
+
+    return running;
+
+}   /* end GetIfaceState */
+
+
+
+
+/*****************************************************************************/
+/** RefreshIfaceState
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Queries the running state and MTU of the raw packet
+ *                  socket interface and updates the cached copies.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the device could not be queried.
+ *
+ *****************************************************************************/
+static fm_status RefreshIfaceState(fm_int sw)
+{
+    struct ifreq ifr;
+    fm_bool      running;
+    char         strErrBuf[FM_STRERROR_BUF_SIZE];
+    errno_t      strErrNum;
+
+    FM_STRNCPY_S(ifr.ifr_name,
+                 IF_NAMESIZE,
+                 GET_PLAT_STATE(sw)->ifaceName,
+                 IF_NAMESIZE);
+
+    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFFLAGS, &ifr) == -1)
+    {
+        strErrNum = FM_STRERROR_S(strErrBuf, FM_STRERROR_BUF_SIZE, errno);
+        if (strErrNum == 0)
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_PLATFORM, 
+                         "Failed to get socket %d flags for device %s: %s\n",
+                         GET_PLAT_STATE(sw)->rawSocket,
+                         ifr.ifr_name,
+                         strErrBuf);
+        }
+        else
+        {
+            FM_LOG_FATAL(FM_LOG_CAT_PLATFORM, 
+                         "Failed to get socket %d flags for device %s: %d\n",
+                         GET_PLAT_STATE(sw)->rawSocket,
+                         ifr.ifr_name,
+                         errno);
+        }
+
+        SetIfaceState(sw, FALSE, -1);
+        return FM_FAIL;
+    }
+
+    running = ( (ifr.ifr_flags & IFF_RUNNING) != 0 );
+
+    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFMTU, &ifr) == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "WARNING: failed to read netdev MTU\n");
+        SetIfaceState(sw, running, -1);
+        return FM_FAIL;
+    }
+
+    SetIfaceState(sw, running, ifr.ifr_mtu);
+
+    return FM_OK;
+
+}   /* end RefreshIfaceState */
+
+
+
+
+/*****************************************************************************/
+/** OpenLinkEventSocket
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Opens a netlink socket subscribed to link events, so the
+ *                  state of the raw packet socket interface can be tracked
+ *                  without querying the device.
+ *
+ * \param           None.
+ *
+ * \return          The socket descriptor, or -1 if link events are not
+ *                  available.
+ *
+ *****************************************************************************/
+static fm_int OpenLinkEventSocket(void)
+{
+    struct sockaddr_nl sa;
+    fm_int             sock;
+
+    sock = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+    if (sock == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to open link event socket, errno %d\n",
+                       errno);
+        return -1;
+    }
+
+    FM_CLEAR(sa);
+    sa.nl_family = AF_NETLINK;
+    sa.nl_groups = RTMGRP_LINK;
+
+    if (bind(sock, (struct sockaddr *) &sa, sizeof(sa)) == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to bind link event socket, errno %d\n",
+                       errno);
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+
+}   /* end OpenLinkEventSocket */
+
+
+
+
+/*****************************************************************************/
+/** ProcessLinkEvents
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Drains the link event socket and updates the cached
+ *                  running state and MTU of the raw packet socket interface.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProcessLinkEvents(fm_int sw)
+{
+    fm_uint32         buf[FM_LINK_EVENT_BUFFER_SIZE / sizeof(fm_uint32)];
+    struct nlmsghdr * nlh;
+    struct ifinfomsg *ifi;
+    struct rtattr *   rta;
+    fm_int            len;
+    fm_int            attrLen;
+    fm_int            mtu;
+    fm_bool           running;
+
+    while (TRUE)
+    {
+        len = recv(GET_PLAT_STATE(sw)->linkEventSocket,
+                   buf,
+                   sizeof(buf),
+                   MSG_DONTWAIT);
+
+        if (len <= 0)
+        {
+            if ( (len == -1) && (errno == ENOBUFS) )
+            {
+                /* Events were dropped, resynchronize with the device */
+                RefreshIfaceState(sw);
+                continue;
+            }
+
+            break;
+        }
+
+        for (nlh = (struct nlmsghdr *) buf ;
+             NLMSG_OK(nlh, (fm_uint) len) ;
+             nlh = NLMSG_NEXT(nlh, len))
+        {
+            if ( (nlh->nlmsg_type != RTM_NEWLINK) &&
+                 (nlh->nlmsg_type != RTM_DELLINK) )
+            {
+                continue;
+            }
+
+            ifi = NLMSG_DATA(nlh);
+
+            if (ifi->ifi_index != GET_PLAT_STATE(sw)->ifaceIndex)
+            {
+                continue;
+            }
+
+            if (nlh->nlmsg_type == RTM_DELLINK)
+            {
+                SetIfaceState(sw, FALSE, -1);
+                continue;
+            }
+
+            running = ( (ifi->ifi_flags & IFF_RUNNING) != 0 );
+            mtu     = -1;
+            attrLen = IFLA_PAYLOAD(nlh);
+
+            for (rta = IFLA_RTA(ifi) ;
+                 RTA_OK(rta, attrLen) ;
+                 rta = RTA_NEXT(rta, attrLen))
+            {
+                if (rta->rta_type == IFLA_MTU)
+                {
+                    mtu = *( (fm_uint32 *) RTA_DATA(rta) );
+                }
+            }
+
+            SetIfaceState(sw, running, mtu);
+
+            FM_LOG_DEBUG(FM_LOG_CAT_PLATFORM,
+                         "Link event on %s: running=%d mtu=%d\n",
+                         GET_PLAT_STATE(sw)->ifaceName,
+                         running,
+                         mtu);
+        }
+    }
+
+}   /* end ProcessLinkEvents */
+
+
+
+
+/*****************************************************************************/
+/** BuildTxMessage
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Fills the iovecs describing one queued packet as sent
+ *                  to the driver: timetag, optional F56 tag, MAC header,
+ *                  optional F64 tag, payload and optional user FCS.
+ *
+ * \param[in]       packet is the queued packet.
+ *
+ * \param[in]       sendUserFcs is TRUE if the user-supplied FCS must be
+ *                  appended to the packet.
+ *
+ * \param[out]      iov points to the iovecs to fill.
+ *
+ * \param[in]       maxIov is the number of iovecs available at iov.
+ *
+ * \param[out]      islTag points to storage for the network order ISL tag.
+ *
+ * \param[out]      fcs points to storage for the network order FCS.
+ *
+ * \return          The number of iovecs used, or 0 if the packet needs
+ *                  more than maxIov iovecs.
+ *
+ *****************************************************************************/
+static fm_int BuildTxMessage(fm_packetEntry *packet,
+                             fm_bool         sendUserFcs,
+                             struct iovec *  iov,
+                             fm_int          maxIov,
+                             fm_islTag *     islTag,
+                             fm_uint32 *     fcs)
+{
+    fm_buffer *sendBuf;
+    fm_int     numIov;
+
+    /* timetag, MAC header and first buffer data, plus the rest of the
+     * chain and the optional ISL tag and FCS */
+    numIov = 3;
+
+    for ( sendBuf = packet->packet->next ; sendBuf ; sendBuf = sendBuf->next )
+    {
+        numIov++;
+    }
+
+    if ( (packet->islTagFormat == FM_ISL_TAG_F56) ||
+         (packet->islTagFormat == FM_ISL_TAG_F64) )
+    {
+        numIov++;
+    }
+
+    if (sendUserFcs)
+    {
+        numIov++;
+    }
+
+    if (numIov > maxIov)
+    {
+        return 0;
+    }
+
+    numIov = 0;
+
+    /* Add the 8 byte timetag iovec. */
+    iov[numIov].iov_base = &txTimeTag;
+    iov[numIov].iov_len = sizeof(txTimeTag);
+    numIov++;
+
+    if (packet->islTagFormat == FM_ISL_TAG_F56)
+    {
+        /* Add the FTAG (F56) iovec */
+        islTag->f56.tag[0] = htonl(packet->islTag.f56.tag[0]);
+        islTag->f56.tag[1] = htonl(packet->islTag.f56.tag[1]);
+        iov[numIov].iov_base = &islTag->f56.tag[0];
+        iov[numIov].iov_len = FM_F56_BYTE_LEN;
+        numIov++;
+    }
+    
+    /* iterate through all buffers */
+    for ( sendBuf = packet->packet ; sendBuf ; sendBuf = sendBuf->next )
+    {
+        /* if first buffer ... */
+        if (sendBuf == packet->packet)
+        {
+            /* Cannot modify the send buffer, since the same buffer can be
+             * used multiple times to send to multiple ports */
+
+            /* second iovec is the mac header */
+            iov[numIov].iov_base = sendBuf->data;
+            iov[numIov].iov_len = FM_MAC_HDR_BYTE_LEN;
+            numIov++;
+
+            if (packet->islTagFormat == FM_ISL_TAG_F64)
+            {
+                /* Insert the F64 ISL tag */
+                islTag->f64.tag[0] = htonl(packet->islTag.f64.tag[0]);
+                islTag->f64.tag[1] = htonl(packet->islTag.f64.tag[1]);
+                iov[numIov].iov_base = &islTag->f64.tag[0];
+                iov[numIov].iov_len = FM_F64_BYTE_LEN;
+                numIov++;
+            }
+
+            /* Third is the data in the first chain */
+            if (packet->suppressVlanTag)
+            {
+                iov[numIov].iov_base = &sendBuf->data[4];
+                iov[numIov].iov_len = sendBuf->len-16;
+                numIov++;
+            }
+            else
+            {
+                iov[numIov].iov_base = &sendBuf->data[3];
+                iov[numIov].iov_len = sendBuf->len-12;
+                numIov++;
+            }
+        }
+        else
+        {
+            /* The rest of the chain */
+            iov[numIov].iov_base = sendBuf->data;
+            iov[numIov].iov_len = sendBuf->len;
+            numIov++;
+        }
+
+    }   /* end for (...) */
+
+    /* Append user-supplied FCS value to packet. */
+    if (sendUserFcs)
+    {
+        *fcs = htonl(packet->fcsVal);
+        iov[numIov].iov_base = fcs;
+        iov[numIov].iov_len = sizeof(*fcs);
+        numIov++;
+    }
+
+    return numIov;
+
+}   /* end BuildTxMessage */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseTxPacket
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Releases a packet once it has been handed to the driver
+ *                  or dropped.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       packet is the queued packet.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseTxPacket(fm_int sw, fm_packetEntry *packet)
+{
+
+    /**************************************************
+     * free buffer only when
+     * (1) sending to a single port;
+     * or (2) this is the last packet of multiple 
+     * identical packets
+     **************************************************/
+
+    if (packet->freePacketBuffer)
+    {
+        /* ignore the error code since it's better to continue */
+        (void) fmFreeBufferChain(sw, packet->packet);
+
+        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+    }
+
+}   /* end ReleaseTxPacket */
+
+
+
+
+/*****************************************************************************/
+/** AllocRxBuffer
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Allocates a receive buffer, waiting for one to be
+ *                  returned if the pool is empty.
+ *
+ * \param           None.
+ *
+ * \return          Pointer to the buffer.
+ *
+ *****************************************************************************/
+static fm_buffer *AllocRxBuffer(void)
+{
+    fm_buffer *buffer;
+
+    do
+    {
+        buffer = fmAllocateBuffer(FM_FIRST_FOCALPOINT);
+
+        if (buffer == NULL)
+        {
+            /* Wait a little while for buffer to return */
+            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS, 1);
+            fmYield();
+        }
+    }
+    while (buffer == NULL);
+
+    return buffer;
+
+}   /* end AllocRxBuffer */
+
+
+
+
+/*****************************************************************************/
+/** ArmRxSlot
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Allocates the buffer chain of a receive slot and builds
+ *                  its iovec array, unless the slot is still armed from a
+ *                  previous batch, and points the message header at it.
+ *
+ * \param[in,out]   slot is the receive slot.
+ *
+ * \param[out]      msg is the message header using the slot.
+ *
+ * \param[in]       iovCount is the number of buffers needed for a frame
+ *                  of the interface MTU.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ArmRxSlot(fm_rawSocketRxSlot *slot,
+                      struct msghdr *     msg,
+                      fm_int              iovCount)
+{
+    fm_buffer *nextBuffer;
+    fm_status  status;
+    fm_int     iov_offset;
+
+    msg->msg_iov    = slot->iov;
+#ifdef ENABLE_TIMESTAMP
+    msg->msg_control    = &slot->control;
+    msg->msg_controllen = sizeof(slot->control);
+#endif
+
+    if (slot->chain != NULL)
+    {
+        msg->msg_iovlen = slot->numIov;
+        return;
+    }
+
+    msg->msg_iovlen = 0;
+
+    /* 8-Byte Timestamp IOV */
+    slot->iov[msg->msg_iovlen].iov_base = slot->rawTS;
+    slot->iov[msg->msg_iovlen].iov_len  = sizeof(slot->rawTS);
+    msg->msg_iovlen++;
+
+    for (iov_offset = 0 ; iov_offset < iovCount ; iov_offset++)
+    {
+        nextBuffer = AllocRxBuffer();
+
+        if (slot->chain == NULL)
+        {
+            slot->chain      = nextBuffer;
+            nextBuffer->next = NULL;
+        }
+        else
+        {
+            status = fmAddBuffer(slot->chain, nextBuffer);
+
+            if (status != FM_OK)
+            {
+                FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                             "Unable to add buffer %d (%p) to chain %p\n",
+                             iov_offset,
+                             (void *) nextBuffer,
+                             (void *) slot->chain );
+                break;
+            }
+        }
+
+        slot->iov[msg->msg_iovlen].iov_base = nextBuffer->data;
+        slot->iov[msg->msg_iovlen].iov_len  = FM_BUFFER_SIZE_BYTES;
+        msg->msg_iovlen++;
+    }
+
+    slot->numIov = msg->msg_iovlen;
+
+}   /* end ArmRxSlot */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseRxSlots
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Releases the buffer chains of all armed receive slots.
+ *
+ * \param[in,out]   slots points to the receive slots.
+ *
+ * \param[in]       numSlots is the number of receive slots.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseRxSlots(fm_rawSocketRxSlot *slots, fm_int numSlots)
+{
+    fm_status status;
+    fm_int    i;
+
+    for (i = 0 ; i < numSlots ; i++)
+    {
+        if (slots[i].chain == NULL)
+        {
+            continue;
+        }
+
+        status = fmFreeBufferChain(FM_FIRST_FOCALPOINT, slots[i].chain);
+
+        if (status != FM_OK)
+        {
+            FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                         "Unable to release prior buffer chain, "
+                         "status = %d (%s)\n",
+                         status,
+                         fmErrorMsg(status) );
+        }
+
+        slots[i].chain = NULL;
+    }
+
+}   /* end ReleaseRxSlots */
+
+
+
+
+/*****************************************************************************/
+/** DeliverRxFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Hands a received frame to the API.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       recvChainHead is the buffer chain holding the frame.
+ *
+ * \param[in]       rawTS points to the 8-byte timestamp preceding the frame.
+ *
+ * \param[in,out]   sbData points to the sideband data of the frame.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void DeliverRxFrame(fm_int              sw,
+                           fm_buffer *         recvChainHead,
+                           fm_byte *           rawTS,
+                           fm_pktSideBandData *sbData)
+{
+    fm_status status;
+
+    /* Store the raw timestamp in 64b format */
+    sbData->rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
+    sbData->rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
+
+    /* Don't provide an ISL tag pointer, let the API handle the ISL
+     * tag information (included in the fm_buffer chain). */
+    status = fmPlatformReceiveProcessV2(sw,
+                                        recvChainHead,
+                                        NULL,
+                                        sbData);
+
+    if (status != FM_OK)
+    {
+        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                     "Returned error status %d "
+                     "(%s)\n",
+                     status,
+                     fmErrorMsg(status) );
+    }
+
+}   /* end DeliverRxFrame */
+
+
+
+
+/*****************************************************************************/
+/** ProcessRxFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Trims the buffer chain of a received frame to its length
+ *                  and hands it to the API. The slot is left unarmed.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in,out]   slot is the receive slot holding the frame.
+ *
+ * \param[in]       msg is the message header of the slot.
+ *
+ * \param[in]       len is the number of bytes received.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ProcessRxFrame(fm_int              sw,
+                           fm_rawSocketRxSlot *slot,
+                           struct msghdr *     msg,
+                           fm_int              len)
+{
+    fm_buffer *        recvChainHead;
+    fm_buffer *        nextBuffer;
+    fm_status          status;
+    fm_pktSideBandData sbData;
+    fm_byte *          rawTS;
+#ifdef ENABLE_TIMESTAMP
+    struct cmsghdr *   cmsg;
+#endif
+
+    recvChainHead = slot->chain;
+    slot->chain   = NULL;
+    rawTS         = slot->rawTS;
+
+    FM_CLEAR(sbData);
+
+#ifdef ENABLE_TIMESTAMP
+    for (cmsg = CMSG_FIRSTHDR(msg);
+         cmsg;
+         cmsg = CMSG_NXTHDR(msg, cmsg)) 
+    {
+        if ( (cmsg->cmsg_level == SOL_SOCKET) &&
+             (cmsg->cmsg_type  == SO_TIMESTAMPING) &&
+             (cmsg->cmsg_len   == CMSG_LEN(sizeof(struct timespec) * 3)) )
+        {
+                struct timespec *stamp =
+                    (struct timespec *)CMSG_DATA(cmsg);
+                /* cmsg has 3 different timestamps. Timestamp we are interested is 
+                 * located in index 2 */
+                sbData.ingressTimestamp.seconds     = ( (fm_int64)(stamp[2].tv_sec) );
+                sbData.ingressTimestamp.nanoseconds = ( (fm_int64)(stamp[2].tv_nsec) );
+        }
+        else
+        {
+                FM_LOG_WARNING(FM_LOG_CAT_PLATFORM, 
+                              "Unknown control message of level %d type %d len %zu  received\n",
+                              cmsg->cmsg_level, 
+                              cmsg->cmsg_type,
+                              cmsg->cmsg_len);
+        }
+    }
+#else
+    FM_NOT_USED(msg);
+#endif
+
+    /* Remove the timestamp's length to get the length of the actual
+     * packet */
+    len -= sizeof(slot->rawTS);
+
+    /* The raw socket does not carry the FCS in either tx or rx, however
+     * the API expects it to be present. Because the API clears the 
+     * FCS value before sending the packet event to the application, don't 
+     * bother about setting the correct FCS value and just increment the 
+     * length. The FCS value is undefined (whatever is in the fm_buffer at 
+     * the FCS position). */
+    len += 4;
+
+    /* fill in the used buffer sizes */
+    nextBuffer = recvChainHead;
+
+    while (nextBuffer != NULL)
+    {
+        if (len > FM_BUFFER_SIZE_BYTES)
+        {
+            nextBuffer->len = FM_BUFFER_SIZE_BYTES;
+        }
+        else
+        {
+            nextBuffer->len = len;
+        }
+
+        len -= nextBuffer->len;
+
+        if ( (len <= 0) && (nextBuffer->next != NULL) )
+        {
+            status = fmFreeBufferChain(FM_FIRST_FOCALPOINT,
+                                       nextBuffer->next);
+
+            if (status != FM_OK)
+            {
+                FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
+                             "Unable to release unused buffer chain, "
+                             "status = %d (%s)\n",
+                             status,
+                             fmErrorMsg(status) );
+            }
+
+            nextBuffer->next = NULL;
+        }
+
+        nextBuffer = nextBuffer->next;
+    }
+
+    if (recvChainHead == NULL)
+    {
+        return;
+    }
+
+    DeliverRxFrame(sw, recvChainHead, rawTS, &sbData);
+
+}   /* end ProcessRxFrame */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseRing
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Drops a reference on the ring state, and unmaps the rings
+ *                  and releases the state when it was the last one.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseRing(fm_rawSocketRing *ring)
+{
+    if (__sync_sub_and_fetch(&ring->refs, 1) != 0)
+    {
+        return;
+    }
+
+    if (ring->map != NULL)
+    {
+        fmPlatformUnregisterBufferView(ring->rxRing);
+        munmap(ring->map, ring->mapSize);
+    }
+
+    if (ring->rxWakeFd != -1)
+    {
+        close(ring->rxWakeFd);
+    }
+
+    if (ring->rxBlockRefs != NULL)
+    {
+        fmFree( (void *) ring->rxBlockRefs );
+    }
+
+    fmFree(ring);
+
+}   /* end ReleaseRing */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseRingBlock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Drops a reference on a receive ring block and hands the
+ *                  block back to the kernel when it was the last one,
+ *                  releasing the reference the block held on the ring.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \param[in]       block is the receive block number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseRingBlock(fm_rawSocketRing *ring, fm_int block)
+{
+    struct tpacket_block_desc *desc;
+    fm_int                     refs;
+
+    desc = (struct tpacket_block_desc *)
+           (ring->rxRing + block * FM_RAW_SOCKET_RING_BLOCK_SIZE);
+
+    while (TRUE)
+    {
+        refs = ring->rxBlockRefs[block];
+
+        if (refs > 1)
+        {
+            if ( __sync_bool_compare_and_swap(&ring->rxBlockRefs[block],
+                                              refs,
+                                              refs - 1) )
+            {
+                return;
+            }
+        }
+        else if ( __sync_bool_compare_and_swap(&ring->rxBlockRefs[block],
+                                                1,
+                                                -1) )
+        {
+            /* Last reference. The block stays marked as being returned
+             * until the kernel owns it, so the receive thread can't
+             * mistake it for a newly filled block. */
+            desc->hdr.bh1.block_status = TP_STATUS_KERNEL;
+            __sync_synchronize();
+            ring->rxBlockRefs[block] = 0;
+            __sync_synchronize();
+
+            if (ring->rxWaiting)
+            {
+                (void) eventfd_write(ring->rxWakeFd, 1);
+            }
+
+            ReleaseRing(ring);
+            return;
+        }
+    }
+
+}   /* end ReleaseRingBlock */
+
+
+
+
+/*****************************************************************************/
+/** ReleaseRingView
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Buffer view release function of the receive ring, called
+ *                  when a buffer pointing into the ring is freed.
+ *
+ * \param[in]       cookie points to the ring state.
+ *
+ * \param[in]       data is the data pointer of the freed buffer.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReleaseRingView(void *cookie, fm_uint32 *data)
+{
+    fm_rawSocketRing *ring = cookie;
+
+    ReleaseRingBlock(ring,
+                     ( (fm_byte *) data - ring->rxRing ) /
+                     FM_RAW_SOCKET_RING_BLOCK_SIZE);
+
+}   /* end ReleaseRingView */
+
+
+
+
+/*****************************************************************************/
+/** TeardownRing
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Removes the rings from a raw packet socket and drops the
+ *                  socket's reference on the ring state. If the API still
+ *                  holds buffers pointing into the receive ring, the rings
+ *                  stay mapped until the last of them is freed.
+ *
+ * \param[in]       rawSock is the raw packet socket.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void TeardownRing(fm_int rawSock, fm_rawSocketRing *ring)
+{
+    struct tpacket_req3 req;
+
+    if (ring->refs > 1)
+    {
+        /* The kernel keeps the rings until they are unmapped */
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Receive ring still referenced, it will be released "
+                       "once its buffers are freed\n");
+        ReleaseRing(ring);
+        return;
+    }
+
+    ReleaseRing(ring);
+
+    /* Remove the rings from the socket */
+    FM_CLEAR(req);
+    (void) setsockopt(rawSock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req));
+    (void) setsockopt(rawSock, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req));
+
+}   /* end TeardownRing */
+
+
+
+
+/*****************************************************************************/
+/** SetupRing
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Sets up memory-mapped TPACKET_V3 receive and transmit
+ *                  rings on a raw packet socket. If the transmit ring is not
+ *                  supported, frames are still sent with sendmmsg.
+ *
+ * \param[in]       rawSock is the bound raw packet socket.
+ *
+ * \param[in]       numBlocks is the number of blocks of each ring.
+ *
+ * \return          Pointer to the ring state, or NULL if the receive ring
+ *                  could not be set up.
+ *
+ *****************************************************************************/
+static fm_rawSocketRing *SetupRing(fm_int rawSock, fm_int numBlocks)
+{
+    fm_rawSocketRing *  ring;
+    struct tpacket_req3 req;
+    fm_int              version;
+    fm_int              reserve;
+    size_t              rxSize;
+    size_t              txSize;
+    fm_status           err;
+
+    ring = fmAlloc(sizeof(fm_rawSocketRing));
+    if (ring == NULL)
+    {
+        return NULL;
+    }
+
+    FM_CLEAR(*ring);
+
+    ring->refs     = 1;
+    ring->rxWakeFd = -1;
+
+    ring->rxBlockRefs = fmAlloc(numBlocks * sizeof(fm_int));
+    if (ring->rxBlockRefs == NULL)
+    {
+        fmFree(ring);
+        return NULL;
+    }
+
+    FM_MEMSET_S( (void *) ring->rxBlockRefs,
+                numBlocks * sizeof(fm_int),
+                0,
+                numBlocks * sizeof(fm_int) );
+
+    ring->rxWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ring->rxWakeFd == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to create the receive ring event, errno %d\n",
+                       errno);
+        TeardownRing(rawSock, ring);
+        return NULL;
+    }
+
+    version = TPACKET_V3;
+    if (setsockopt(rawSock,
+                   SOL_PACKET,
+                   PACKET_VERSION,
+                   &version,
+                   sizeof(version)) == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "TPACKET_V3 not supported, errno %d\n",
+                       errno);
+        TeardownRing(rawSock, ring);
+        return NULL;
+    }
+
+    reserve = FM_RAW_SOCKET_RING_RESERVE;
+    (void) setsockopt(rawSock,
+                      SOL_PACKET,
+                      PACKET_RESERVE,
+                      &reserve,
+                      sizeof(reserve));
+
+    /* Receive ring */
+    FM_CLEAR(req);
+    req.tp_block_size       = FM_RAW_SOCKET_RING_BLOCK_SIZE;
+    req.tp_block_nr         = numBlocks;
+    req.tp_frame_size       = FM_RAW_SOCKET_RING_RX_FRAME_SIZE;
+    req.tp_frame_nr         = (FM_RAW_SOCKET_RING_BLOCK_SIZE /
+                               FM_RAW_SOCKET_RING_RX_FRAME_SIZE) * numBlocks;
+    req.tp_retire_blk_tov   = FM_RAW_SOCKET_RING_BLOCK_TOV_MSEC;
+
+    if (setsockopt(rawSock, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to set up the receive ring, errno %d\n",
+                       errno);
+        TeardownRing(rawSock, ring);
+        return NULL;
+    }
+
+    ring->rxNumBlocks = numBlocks;
+    rxSize = (size_t) FM_RAW_SOCKET_RING_BLOCK_SIZE * numBlocks;
+
+    /* Transmit ring */
+    FM_CLEAR(req);
+    req.tp_block_size       = FM_RAW_SOCKET_RING_BLOCK_SIZE;
+    req.tp_block_nr         = numBlocks;
+    req.tp_frame_size       = FM_RAW_SOCKET_RING_TX_FRAME_SIZE;
+    req.tp_frame_nr         = (FM_RAW_SOCKET_RING_BLOCK_SIZE /
+                               FM_RAW_SOCKET_RING_TX_FRAME_SIZE) * numBlocks;
+
+    txSize = 0;
+
+    if (setsockopt(rawSock, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) == -1)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to set up the transmit ring, errno %d, "
+                       "using sendmmsg\n",
+                       errno);
+    }
+    else
+    {
+        ring->txNumFrames = req.tp_frame_nr;
+        txSize = (size_t) FM_RAW_SOCKET_RING_BLOCK_SIZE * numBlocks;
+    }
+
+    /* The transmit ring follows the receive ring in the mapping */
+    ring->mapSize = rxSize + txSize;
+    ring->map     = mmap(NULL,
+                         ring->mapSize,
+                         PROT_READ | PROT_WRITE,
+                         MAP_SHARED,
+                         rawSock,
+                         0);
+
+    if (ring->map == MAP_FAILED)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to map the packet rings, errno %d\n",
+                       errno);
+        ring->map = NULL;
+        TeardownRing(rawSock, ring);
+        return NULL;
+    }
+
+    ring->rxRing = ring->map;
+    ring->txRing = (txSize != 0) ? ring->map + rxSize : NULL;
+
+    err = fmPlatformRegisterBufferView(ring->rxRing,
+                                       rxSize,
+                                       ReleaseRingView,
+                                       ring);
+    if (err != FM_OK)
+    {
+        FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                       "Unable to register the receive ring: %s\n",
+                       fmErrorMsg(err));
+        munmap(ring->map, ring->mapSize);
+        ring->map = NULL;
+        TeardownRing(rawSock, ring);
+        return NULL;
+    }
+
+    return ring;
+
+}   /* end SetupRing */
+
+
+
+
+/*****************************************************************************/
+/** ReceiveRingFrame
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Hands a frame of the receive ring to the API, as a buffer
+ *                  chain pointing into the ring when the frame is suitably
+ *                  aligned, or as a copy otherwise.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \param[in]       block is the receive block holding the frame.
+ *
+ * \param[in]       ppd points to the ring header of the frame.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void ReceiveRingFrame(fm_int               sw,
+                             fm_rawSocketRing *   ring,
+                             fm_int               block,
+                             struct tpacket3_hdr *ppd)
+{
+    fm_pktSideBandData sbData;
+    fm_buffer *        recvChainHead = NULL;
+    fm_buffer *        nextBuffer;
+    fm_byte *          rawTS;
+    fm_byte *          data;
+    fm_byte *          frameEnd;
+    fm_int             len;
+    fm_int             dataLen;
+    fm_int             offset;
+    fm_bool            inPlace;
+
+    if (ppd->tp_snaplen < sizeof(fm_uint64))
+    {
+        return;
+    }
+
+    FM_CLEAR(sbData);
+
+#ifdef ENABLE_TIMESTAMP
+    if (ppd->tp_status & TP_STATUS_TS_RAW_HARDWARE)
+    {
+        sbData.ingressTimestamp.seconds     = ppd->tp_sec;
+        sbData.ingressTimestamp.nanoseconds = ppd->tp_nsec;
+    }
+#endif
+
+    rawTS    = (fm_byte *) ppd + ppd->tp_mac;
+    data     = rawTS + sizeof(fm_uint64);
+    dataLen  = ppd->tp_snaplen - sizeof(fm_uint64);
+
+    /* The last frame of a block has no next frame */
+    if (ppd->tp_next_offset != 0)
+    {
+        frameEnd = (fm_byte *) ppd + ppd->tp_next_offset;
+    }
+    else
+    {
+        frameEnd = ring->rxRing + (block + 1) * FM_RAW_SOCKET_RING_BLOCK_SIZE;
+    }
+
+    /* The API expects the FCS to be present, see ProcessRxFrame */
+    len = dataLen + 4;
+
+    /* Buffer data must be word aligned, and the trailing FCS bytes must
+     * not run into the header of the next frame */
+    inPlace = ( ( ( (uintptr_t) data ) & 0x3 ) == 0 ) &&
+              ( data + len <= frameEnd );
+
+    for (offset = 0 ; offset < len ; offset += FM_BUFFER_SIZE_BYTES)
+    {
+        nextBuffer = AllocRxBuffer();
+
+        nextBuffer->len = len - offset;
+        if (nextBuffer->len > FM_BUFFER_SIZE_BYTES)
+        {
+            nextBuffer->len = FM_BUFFER_SIZE_BYTES;
+        }
+
+        if (inPlace)
+        {
+            __sync_fetch_and_add(&ring->rxBlockRefs[block], 1);
+            nextBuffer->data = (fm_uint32 *) (data + offset);
+        }
+        else if (offset < dataLen)
+        {
+            FM_MEMCPY_S(nextBuffer->data,
+                        FM_BUFFER_SIZE_BYTES,
+                        data + offset,
+                        (dataLen - offset < nextBuffer->len) ?
+                            (dataLen - offset) : nextBuffer->len);
+        }
+
+        if (recvChainHead == NULL)
+        {
+            recvChainHead = nextBuffer;
+        }
+        else
+        {
+            fmAddBuffer(recvChainHead, nextBuffer);
+        }
+    }
+
+    if (inPlace)
+    {
+        ring->rxViewFrames++;
+    }
+    else
+    {
+        ring->rxCopiedFrames++;
+    }
+
+    DeliverRxFrame(sw, recvChainHead, rawTS, &sbData);
+
+}   /* end ReceiveRingFrame */
+
+
+
+
+/*****************************************************************************/
+/** ReceiveRingBlock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Hands the frames of the next receive ring block to the
+ *                  API, if the kernel has filled it.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \return          TRUE if a block was processed.
+ * \return          FALSE if the next block is not ready.
+ *
+ *****************************************************************************/
+static fm_bool ReceiveRingBlock(fm_int sw, fm_rawSocketRing *ring)
+{
+    struct tpacket_block_desc *desc;
+    struct tpacket3_hdr *      ppd;
+    fm_int                     block;
+    fm_int                     numPkts;
+    fm_int                     i;
+
+    block = ring->rxBlock;
+    desc  = (struct tpacket_block_desc *)
+            (ring->rxRing + block * FM_RAW_SOCKET_RING_BLOCK_SIZE);
+
+    /* A block still referenced by the API was processed on the previous
+     * pass through the ring, it is not a new one. */
+    if ( ( (desc->hdr.bh1.block_status & TP_STATUS_USER) == 0 ) ||
+         ( ring->rxBlockRefs[block] != 0 ) )
+    {
+        return FALSE;
+    }
+
+    __sync_synchronize();
+
+    /* Hold the block while its frames are handed out */
+    ring->rxBlockRefs[block] = 1;
+    __sync_fetch_and_add(&ring->refs, 1);
+
+    numPkts = desc->hdr.bh1.num_pkts;
+    ppd     = (struct tpacket3_hdr *)
+              ( (fm_byte *) desc + desc->hdr.bh1.offset_to_first_pkt );
+
+    for (i = 0 ; i < numPkts ; i++)
+    {
+        ReceiveRingFrame(sw, ring, block, ppd);
+
+        ppd = (struct tpacket3_hdr *) ( (fm_byte *) ppd + ppd->tp_next_offset );
+    }
+
+    GET_PLAT_STATE(sw)->rawRxPackets += numPkts;
+
+    ReleaseRingBlock(ring, block);
+
+    ring->rxBlock = (block + 1) % ring->rxNumBlocks;
+
+    return TRUE;
+
+}   /* end ReceiveRingBlock */
+
+
+
+
+/*****************************************************************************/
+/** WaitRingBlock
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Waits for the API to release the next receive block. The
+ *                  socket stays readable while the block is held, so the
+ *                  receive thread blocks on the ring event instead.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void WaitRingBlock(fm_rawSocketRing *ring)
+{
+    struct pollfd pfd;
+    eventfd_t     value;
+
+    ring->rxWaiting = TRUE;
+    __sync_synchronize();
+
+    /* The block may have been released before rxWaiting was set */
+    if (ring->rxBlockRefs[ring->rxBlock] != 0)
+    {
+        pfd.fd      = ring->rxWakeFd;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+
+        (void) poll(&pfd, 1, FM_FDS_POLL_TIMEOUT_USEC);
+    }
+
+    ring->rxWaiting = FALSE;
+
+    (void) eventfd_read(ring->rxWakeFd, &value);
+
+}   /* end WaitRingBlock */
+
+
+
+
+/*****************************************************************************/
+/** KickTxRing
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Asks the kernel to send the frames queued on the
+ *                  transmit ring.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the kernel refused the request.
+ *
  *****************************************************************************/
+static fm_status KickTxRing(fm_int sw)
+{
+    GET_PLAT_STATE(sw)->rawTxSyscalls++;
 
-/*****************************************************************************
- * Local function prototypes.
+    if ( (send(GET_PLAT_STATE(sw)->rawSocket, NULL, 0, MSG_DONTWAIT) == -1) &&
+         (errno != EAGAIN) &&
+         (errno != ENOBUFS) )
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                     "Transmit ring send failed - errno %d\n",
+                     errno);
+
+        if ( (errno == ENETDOWN) || (errno == ENXIO) )
+        {
+            SetIfaceState(sw, FALSE, -1);
+        }
+
+        return FM_FAIL;
+    }
+
+    return FM_OK;
+
+}   /* end KickTxRing */
+
+
+
+
+/*****************************************************************************/
+/** CompleteRingPackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Accounts for the frames of the transmit ring the kernel
+ *                  has finished sending, in the order they were queued.
+ *                  Called with the tx queue locked.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       ring points to the ring state.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if the kernel rejected a frame.
+ *
  *****************************************************************************/
+static fm_status CompleteRingPackets(fm_int sw, fm_rawSocketRing *ring)
+{
+    fm_status            err = FM_OK;
+    struct tpacket3_hdr *hdr;
 
+    while (ring->txPending > 0)
+    {
+        hdr = (struct tpacket3_hdr *)
+              ( ring->txRing +
+                ring->txSentFrame * FM_RAW_SOCKET_RING_TX_FRAME_SIZE );
 
-/*****************************************************************************
- * Local Functions
+        if (hdr->tp_status == TP_STATUS_WRONG_FORMAT)
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                         "Transmit ring frame %d was rejected\n",
+                         ring->txSentFrame);
+            err = FM_FAIL;
+            hdr->tp_status = TP_STATUS_AVAILABLE;
+        }
+        else if (hdr->tp_status == TP_STATUS_AVAILABLE)
+        {
+            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, 1);
+            GET_PLAT_STATE(sw)->rawTxPackets++;
+        }
+        else
+        {
+            /* Still being sent */
+            break;
+        }
+
+        ring->txSentFrame = (ring->txSentFrame + 1) % ring->txNumFrames;
+        ring->txPending--;
+    }
+
+    return err;
+
+}   /* end CompleteRingPackets */
+
+
+
+
+/*****************************************************************************/
+/** SendRingPackets
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Queues the packets of the tx queue on the transmit ring,
+ *                  asking the kernel to send them every txBatchSize frames.
+ *                  Called with the tx queue locked.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_FAIL if a packet was dropped or could not be sent.
+ *
+ *****************************************************************************/
+static fm_status SendRingPackets(fm_int sw)
+{
+    fm_status               err = FM_OK;
+    fm_switch *             switchPtr;
+    fm_packetHandlingState *pktState;
+    fm_packetQueue *        txQueue;
+    fm_packetEntry *        packet;
+    fm_rawSocketRing *      ring;
+    struct tpacket3_hdr *   hdr;
+    struct iovec            iov[UIO_MAXIOV];
+    fm_islTag               islTag;
+    fm_uint32               fcs;
+    fm_byte *               dst;
+    fm_int                  numIov;
+    fm_int                  queued = 0;
+    fm_int                  len;
+    fm_int                  i;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+    pktState  = GET_PLAT_PKT_STATE(sw);
+    txQueue   = &pktState->txQueue;
+    ring      = GET_PLAT_STATE(sw)->rawRing;
+
+    switchPtr->transmitterLock = FALSE;
+
+    err = CompleteRingPackets(sw, ring);
+
+    for ( fmPacketQueueSchedule(txQueue, GET_PLAT_STATE(sw)->rawTxBatchSize) ;
+          txQueue->pullIndex != txQueue->pushIndex ;
+          fmPacketQueueAdvance(txQueue) )
+    {
+        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+        hdr    = (struct tpacket3_hdr *)
+                 ( ring->txRing +
+                   ring->txFrame * FM_RAW_SOCKET_RING_TX_FRAME_SIZE );
+
+        if (ring->txPending == ring->txNumFrames)
+        {
+            /* Ring full, retry once the kernel has caught up */
+            switchPtr->transmitterLock = TRUE;
+            break;
+        }
+
+        numIov = BuildTxMessage(packet,
+                                pktState->sendUserFcs,
+                                iov,
+                                UIO_MAXIOV,
+                                &islTag,
+                                &fcs);
+
+        len = 0;
+        for (i = 0 ; i < numIov ; i++)
+        {
+            len += iov[i].iov_len;
+        }
+
+        if ( (numIov == 0) ||
+             (len > FM_RAW_SOCKET_RING_TX_FRAME_SIZE -
+                    (fm_int) FM_RAW_SOCKET_RING_TX_DATA_OFFSET) )
+        {
+            FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                         "Packet in slot %d does not fit a transmit ring "
+                         "frame, dropped\n",
+                         txQueue->pullIndex);
+            err = FM_FAIL;
+            ReleaseTxPacket(sw, packet);
+            continue;
+        }
+
+        dst = (fm_byte *) hdr + FM_RAW_SOCKET_RING_TX_DATA_OFFSET;
+
+        for (i = 0 ; i < numIov ; i++)
+        {
+            FM_MEMCPY_S(dst, iov[i].iov_len, iov[i].iov_base, iov[i].iov_len);
+            dst += iov[i].iov_len;
+        }
+
+        hdr->tp_len         = len;
+        hdr->tp_snaplen     = len;
+        hdr->tp_next_offset = 0;
+        __sync_synchronize();
+        hdr->tp_status      = TP_STATUS_SEND_REQUEST;
+
+        ring->txFrame = (ring->txFrame + 1) % ring->txNumFrames;
+        ring->txPending++;
+
+        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                     "%d bytes were queued on the transmit ring\n",
+                     len);
+
+        /* The frame was copied to the ring, it is accounted for once the
+         * kernel has sent it */
+        ReleaseTxPacket(sw, packet);
+
+        if (++queued == GET_PLAT_STATE(sw)->rawTxBatchSize)
+        {
+            if (KickTxRing(sw) != FM_OK)
+            {
+                err = FM_FAIL;
+            }
+            queued = 0;
+        }
+    }
+
+    if ( (queued > 0) || switchPtr->transmitterLock )
+    {
+        if (KickTxRing(sw) != FM_OK)
+        {
+            err = FM_FAIL;
+        }
+    }
+
+    if (CompleteRingPackets(sw, ring) != FM_OK)
+    {
+        err = FM_FAIL;
+    }
+
+    return err;
+
+}   /* end SendRingPackets */
+
+
+
+
+/*****************************************************************************/
+/** OpenBenchmarkSocket
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Opens a raw packet socket bound to an interface for
+ *                  fmDbgRawPacketSocketBenchmark.
+ *
+ * \param[in]       iface is the interface name.
+ *
+ * \param[in]       protocol is the ethertype to receive, 0 for a send-only
+ *                  socket.
+ *
+ * \return          The socket descriptor, or -1 on failure.
+ *
  *****************************************************************************/
+static fm_int OpenBenchmarkSocket(fm_text iface, fm_int protocol)
+{
+    struct sockaddr_ll sa;
+    fm_int             sock;
+    fm_int             bufSize;
+
+    sock = socket(PF_PACKET, SOCK_RAW, htons(protocol));
+    if (sock == -1)
+    {
+        FM_LOG_PRINT("Unable to open raw packet socket, errno %d\n", errno);
+        return -1;
+    }
+
+    FM_CLEAR(sa);
+    sa.sll_family   = PF_PACKET;
+    sa.sll_protocol = htons(protocol);
+    sa.sll_ifindex  = if_nametoindex(iface);
+
+    if ( (sa.sll_ifindex == 0) ||
+         (bind(sock, (struct sockaddr *) &sa, sizeof(sa)) == -1) )
+    {
+        FM_LOG_PRINT("Unable to bind raw packet socket to %s\n", iface);
+        close(sock);
+        return -1;
+    }
+
+    bufSize = 4 * 1024 * 1024;
+    (void) setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+    (void) setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize));
+
+    return sock;
+
+}   /* end OpenBenchmarkSocket */
+
+
+
 
 
 /*****************************************************************************/
@@ -121,6 +1901,24 @@ fm_status fmRawPacketSocketDestroy(fm_int sw)
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
 
+    if (GET_PLAT_STATE(sw)->linkEventSocket != -1)
+    {
+        close(GET_PLAT_STATE(sw)->linkEventSocket);
+        GET_PLAT_STATE(sw)->linkEventSocket = -1;
+    }
+
+    if (GET_PLAT_STATE(sw)->rawRing != NULL)
+    {
+        TeardownRing(GET_PLAT_STATE(sw)->rawSocket,
+                     GET_PLAT_STATE(sw)->rawRing);
+        GET_PLAT_STATE(sw)->rawRing = NULL;
+    }
+
+    if (GET_PLAT_STATE(sw)->ifaceStateLock.handle != NULL)
+    {
+        fmDeleteLock(&GET_PLAT_STATE(sw)->ifaceStateLock);
+    }
+
     if (close(GET_PLAT_STATE(sw)->rawSocket) == -1)
     {
         FM_LOG_ERROR(FM_LOG_CAT_PLATFORM, 
@@ -184,6 +1982,7 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
     char                     strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t                  strErrNum;
     fm_switch               *switchPtr;
+    fm_int                   numBlocks;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
                  "sw=%d hasFcs=%s\n",
@@ -196,6 +1995,13 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
         FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
     }
 
+    GET_PLAT_STATE(sw)->linkEventSocket = -1;
+    GET_PLAT_STATE(sw)->rawRing         = NULL;
+
+    err = fmCreateLock("Raw Socket Iface State",
+                       &GET_PLAT_STATE(sw)->ifaceStateLock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
     err = fmGenericPacketHandlingInitializeV2(sw, hasFcs);
     FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
 
@@ -388,6 +2194,64 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
 
     GET_PLAT_STATE(sw)->rawSocket = rawSock;
     FM_STRNCPY_S(GET_PLAT_STATE(sw)->ifaceName, IF_NAMESIZE, iface, IF_NAMESIZE);
+    GET_PLAT_STATE(sw)->ifaceIndex = sa.sll_ifindex;
+
+    /* Number of frames moved per recvmmsg / sendmmsg call */
+    GET_PLAT_STATE(sw)->rawRxBatchSize = GET_PROPERTY()->rawSocketRxBatchSize;
+    GET_PLAT_STATE(sw)->rawTxBatchSize = GET_PROPERTY()->rawSocketTxBatchSize;
+
+    if (GET_PLAT_STATE(sw)->rawRxBatchSize < 1)
+    {
+        GET_PLAT_STATE(sw)->rawRxBatchSize = 1;
+    }
+    else if (GET_PLAT_STATE(sw)->rawRxBatchSize > FM_RAW_SOCKET_MAX_BATCH)
+    {
+        GET_PLAT_STATE(sw)->rawRxBatchSize = FM_RAW_SOCKET_MAX_BATCH;
+    }
+
+    if (GET_PLAT_STATE(sw)->rawTxBatchSize < 1)
+    {
+        GET_PLAT_STATE(sw)->rawTxBatchSize = 1;
+    }
+    else if (GET_PLAT_STATE(sw)->rawTxBatchSize > FM_RAW_SOCKET_MAX_BATCH)
+    {
+        GET_PLAT_STATE(sw)->rawTxBatchSize = FM_RAW_SOCKET_MAX_BATCH;
+    }
+
+    GET_PLAT_STATE(sw)->rawRxSyscalls = 0;
+    GET_PLAT_STATE(sw)->rawRxPackets  = 0;
+    GET_PLAT_STATE(sw)->rawTxSyscalls = 0;
+    GET_PLAT_STATE(sw)->rawTxPackets  = 0;
+
+    /* Cache the link state, then track it through link events */
+    err = RefreshIfaceState(sw);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, err);
+
+    GET_PLAT_STATE(sw)->linkEventSocket = OpenLinkEventSocket();
+
+    if (GET_PROPERTY()->rawSocketMmapRing)
+    {
+        numBlocks = GET_PROPERTY()->rawSocketRingBlocks;
+
+        if (numBlocks < FM_RAW_SOCKET_RING_MIN_BLOCKS)
+        {
+            numBlocks = FM_RAW_SOCKET_RING_MIN_BLOCKS;
+        }
+        else if (numBlocks > FM_RAW_SOCKET_RING_MAX_BLOCKS)
+        {
+            numBlocks = FM_RAW_SOCKET_RING_MAX_BLOCKS;
+        }
+
+        GET_PLAT_STATE(sw)->rawRing = SetupRing(rawSock, numBlocks);
+
+        if (GET_PLAT_STATE(sw)->rawRing == NULL)
+        {
+            FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
+                           "Packet rings unavailable on %s, "
+                           "using recvmmsg / sendmmsg\n",
+                           iface);
+        }
+    }
 
     /* Create the receive packet thread */
     err = fmCreateThread("raw_packet_socket receive",
@@ -403,10 +2267,28 @@ fm_status fmRawPacketSocketHandlingInitialize(fm_int  sw,
     }
 
 ABORT:
+    if ( (err != FM_OK) &&
+         (GET_PLAT_STATE(sw)->ifaceStateLock.handle != NULL) )
+    {
+        fmDeleteLock(&GET_PLAT_STATE(sw)->ifaceStateLock);
+    }
+
     if ( (err != FM_OK) &&
          (rawSock != -1) )
     {
         close(rawSock);
+
+        if (GET_PLAT_STATE(sw)->linkEventSocket != -1)
+        {
+            close(GET_PLAT_STATE(sw)->linkEventSocket);
+            GET_PLAT_STATE(sw)->linkEventSocket = -1;
+        }
+
+        if (GET_PLAT_STATE(sw)->rawRing != NULL)
+        {
+            TeardownRing(rawSock, GET_PLAT_STATE(sw)->rawRing);
+            GET_PLAT_STATE(sw)->rawRing = NULL;
+        }
     }
 
     FM_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
@@ -422,6 +2304,9 @@ ABORT:
  *
  * \desc            When called, iterates through the packet queue and
  *                  continues to send packets until either the queue empties.
+ *                  Packets are handed to the driver in batches of up to
+ *                  api.platform.rawSocket.txBatchSize frames per sendmmsg
+ *                  call.
  *
  * \param[in]       sw refers to the switch number to send packets to.
  *
@@ -436,15 +2321,18 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
     fm_packetQueue *        txQueue;
     fm_packetEntry *        packet;
     fm_int32                rc;
-    fm_buffer               *sendBuf;
-    struct msghdr           msg;
+    struct mmsghdr          msgs[FM_RAW_SOCKET_MAX_BATCH];
     struct iovec            iov[UIO_MAXIOV];
-    fm_islTag               islTag;
-    fm_uint32               fcs;
-    fm_uint64               rawTS;
+    fm_islTag               islTag[FM_RAW_SOCKET_MAX_BATCH];
+    fm_uint32               fcs[FM_RAW_SOCKET_MAX_BATCH];
+    fm_int                  batchSize;
+    fm_int                  numMsgs;
+    fm_int                  numIov;
+    fm_int                  iovUsed;
+    fm_uint                 index;
+    fm_int                  i;
     char                    strErrBuf[FM_STRERROR_BUF_SIZE];
     errno_t                 strErrNum;
-    struct ifreq            ifr;
 
     FM_LOG_ENTRY(FM_LOG_CAT_EVENT_PKT_TX, "sw = %d\n", sw);
 
@@ -458,145 +2346,112 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
         FM_LOG_EXIT(FM_LOG_CAT_EVENT_PKT_TX, FM_ERR_UNINITIALIZED);
     }
 
-    /* initialize the message header */
-    FM_CLEAR(msg);
-    msg.msg_name = NULL; /* Optional field */
-    msg.msg_namelen = 0;
-    msg.msg_iov = iov;
-    msg.msg_iovlen = 0;
-    msg.msg_flags = 0;
-
-    FM_STRNCPY_S(ifr.ifr_name, IF_NAMESIZE, GET_PLAT_STATE(sw)->ifaceName, IF_NAMESIZE);
+    batchSize = GET_PLAT_STATE(sw)->rawTxBatchSize;
 
     txQueue = &pktState->txQueue;
     fmPacketQueueLock(txQueue);
 
-    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFFLAGS, &ifr) == -1)
+    /* The link state is tracked by the receive thread, only query the
+     * device when it is believed to be down. */
+    if ( !GetIfaceState(sw, NULL) )
     {
-        strErrNum = FM_STRERROR_S(strErrBuf, FM_STRERROR_BUF_SIZE, errno);
-        if (strErrNum == 0)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
-                         "Failed to get socket %d flags for device %s: %s\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         strErrBuf);
-        }
-        else
+        if (RefreshIfaceState(sw) != FM_OK)
         {
-            FM_LOG_FATAL(FM_LOG_CAT_EVENT_PKT_TX, 
-                         "Failed to get socket %d flags for device %s: %d\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         errno);
+            switchPtr->transmitterLock = TRUE;
+            err = FM_FAIL;
+            FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
         }
-        switchPtr->transmitterLock = TRUE;
-        err = FM_FAIL;
-        FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    if ((ifr.ifr_flags & IFF_RUNNING) == 0)
+    if ( !GetIfaceState(sw, NULL) )
     {    
         FM_LOG_WARNING(FM_LOG_CAT_EVENT_PKT_TX,
                        "Network device %s resources are not allocated.\n",
-                       ifr.ifr_name);
+                       GET_PLAT_STATE(sw)->ifaceName);
         switchPtr->transmitterLock = TRUE;
         err = FM_FAIL;
         FM_LOG_ABORT(FM_LOG_CAT_EVENT_PKT_TX, err);
     }
 
-    /* Iterate through the packets in the tx queue */
-    for ( ;
-          txQueue->pullIndex != txQueue->pushIndex ;
-          txQueue->pullIndex = (txQueue->pullIndex + 1) % FM_PACKET_QUEUE_SIZE)
+    if ( (GET_PLAT_STATE(sw)->rawRing != NULL) &&
+         (GET_PLAT_STATE(sw)->rawRing->txRing != NULL) )
     {
-        packet = &txQueue->packetQueueList[txQueue->pullIndex];
+        err = SendRingPackets(sw);
+        goto ABORT;
+    }
 
-        FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
-                     "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
-                     txQueue->pullIndex, packet->length,
-                     packet->suppressVlanTag, packet->fcsVal);
-        msg.msg_iovlen = 0;
-
-        /* Add the 8 byte timetag iovec. Note that the value is ignored
-         * by the driver as it gets overwritten by the PEP. */
-        rawTS = 0;
-        iov[msg.msg_iovlen].iov_base = &rawTS;
-        iov[msg.msg_iovlen].iov_len = sizeof(rawTS);
-        msg.msg_iovlen++;
-
-        if (packet->islTagFormat == FM_ISL_TAG_F56)
-        {
-            /* Add the FTAG (F56) iovec */
-            islTag.f56.tag[0] = htonl(packet->islTag.f56.tag[0]);
-            islTag.f56.tag[1] = htonl(packet->islTag.f56.tag[1]);
-            iov[msg.msg_iovlen].iov_base = &islTag.f56.tag[0];
-            iov[msg.msg_iovlen].iov_len = FM_F56_BYTE_LEN;
-            msg.msg_iovlen++;
-        }
-        
-        /* iterate through all buffers */
-        for ( sendBuf = packet->packet ; sendBuf ; sendBuf = sendBuf->next )
-        {
-            /* if first buffer ... */
-            if (sendBuf == packet->packet)
-            {
-                /* Cannot modify the send buffer, since the same buffer can be
-                 * used multiple times to send to multiple ports */
+    /* Iterate through the packets in the tx queue, as handed out by the
+     * TX class scheduler one batch at a time */
+    fmPacketQueueSchedule(txQueue, batchSize);
 
-                /* second iovec is the mac header */
-                iov[msg.msg_iovlen].iov_base = sendBuf->data;
-                iov[msg.msg_iovlen].iov_len = FM_MAC_HDR_BYTE_LEN;
-                msg.msg_iovlen++;
+    while (txQueue->pullIndex != txQueue->pushIndex)
+    {
+        /* Gather a batch of packets */
+        numMsgs = 0;
+        iovUsed = 0;
 
-                if (packet->islTagFormat == FM_ISL_TAG_F64)
-                {
-                    /* Insert the F64 ISL tag */
-                    islTag.f64.tag[0] = htonl(packet->islTag.f64.tag[0]);
-                    islTag.f64.tag[1] = htonl(packet->islTag.f64.tag[1]);
-                    iov[msg.msg_iovlen].iov_base = &islTag.f64.tag[0];
-                    iov[msg.msg_iovlen].iov_len = FM_F64_BYTE_LEN;
-                    msg.msg_iovlen++;
-                }
+        for ( index = txQueue->pullIndex ;
+              (index != txQueue->pushIndex) && (numMsgs < batchSize) ;
+              index = (index + 1) % FM_PACKET_QUEUE_SIZE )
+        {
+            packet = &txQueue->packetQueueList[index];
 
-                /* Third is the data in the first chain */
-                if (packet->suppressVlanTag)
-                {
-                    iov[msg.msg_iovlen].iov_base = &sendBuf->data[4];
-                    iov[msg.msg_iovlen].iov_len = sendBuf->len-16;
-                    msg.msg_iovlen++;
-                }
-                else
+            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                         "sending packet in slot %d, length=%d tag=%d fcs=%08x\n",
+                         index, packet->length,
+                         packet->suppressVlanTag, packet->fcsVal);
+
+            numIov = BuildTxMessage(packet,
+                                    pktState->sendUserFcs,
+                                    &iov[iovUsed],
+                                    UIO_MAXIOV - iovUsed,
+                                    &islTag[numMsgs],
+                                    &fcs[numMsgs]);
+
+            if (numIov == 0)
+            {
+                if (numMsgs > 0)
                 {
-                    iov[msg.msg_iovlen].iov_base = &sendBuf->data[3];
-                    iov[msg.msg_iovlen].iov_len = sendBuf->len-12;
-                    msg.msg_iovlen++;
+                    /* Send what has been gathered so far */
+                    break;
                 }
-            }
-            else
-            {
-                /* The rest of the chain */
-                iov[msg.msg_iovlen].iov_base = sendBuf->data;
-                iov[msg.msg_iovlen].iov_len = sendBuf->len;
-                msg.msg_iovlen++;
+
+                /* The packet alone does not fit in a message */
+                FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
+                             "Packet in slot %d has too many buffers, "
+                             "dropped\n",
+                             index);
+                err = FM_FAIL;
+                ReleaseTxPacket(sw, packet);
+
+                /* Nothing is gathered yet, so index is the pull index */
+                fmPacketQueueAdvance(txQueue);
+                continue;
             }
 
-        }   /* end for (...) */
+            FM_CLEAR(msgs[numMsgs]);
+            msgs[numMsgs].msg_hdr.msg_iov    = &iov[iovUsed];
+            msgs[numMsgs].msg_hdr.msg_iovlen = numIov;
+            iovUsed += numIov;
+            numMsgs++;
+        }
 
-        /* Append user-supplied FCS value to packet. */
-        if (pktState->sendUserFcs)
+        if (numMsgs == 0)
         {
-            fcs = htonl(packet->fcsVal);
-            iov[msg.msg_iovlen].iov_base = &fcs;
-            iov[msg.msg_iovlen].iov_len = sizeof(fcs);
-            msg.msg_iovlen++;
+            continue;
         }
 
-        /* now send it to the driver */
+        /* now send the batch to the driver */
         errno = 0;
-        rc = sendmsg(GET_PLAT_STATE(sw)->rawSocket, &msg, MSG_DONTWAIT);
+        rc = sendmmsg(GET_PLAT_STATE(sw)->rawSocket,
+                      msgs,
+                      numMsgs,
+                      MSG_DONTWAIT);
+        GET_PLAT_STATE(sw)->rawTxSyscalls++;
+
         if (rc == -1)
         {
+            /* The first packet of the batch could not be sent */
             switchPtr->transmitterLock = TRUE;
             if (errno != EWOULDBLOCK)
             {
@@ -612,46 +2467,50 @@ fm_status fmRawPacketSocketSendPackets(fm_int sw)
                 if (strErrNum == 0)
                 {
                     FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX,
-                                 "sendmsg failed: %s - errno %d\n",
+                                 "sendmmsg failed: %s - errno %d\n",
                                  strErrBuf,
                                  errno);
                 }
                 else
                 {
                     FM_LOG_ERROR(FM_LOG_CAT_EVENT_PKT_TX, 
-                                 "sendmsg failed - errno %d\n", errno);
+                                 "sendmmsg failed - errno %d\n", errno);
                 }
             }
-            if (errno == EMSGSIZE)
+
+            if ( (errno == ENETDOWN) || (errno == ENXIO) )
             {
-                switchPtr->transmitterLock = FALSE;
+                SetIfaceState(sw, FALSE, -1);
             }
-            else
+
+            if (errno == EMSGSIZE)
             {
-                goto ABORT;
+                /* Drop the oversized packet and carry on */
+                switchPtr->transmitterLock = FALSE;
+                ReleaseTxPacket(sw,
+                                &txQueue->packetQueueList[txQueue->pullIndex]);
+                fmPacketQueueAdvance(txQueue);
+                continue;
             }
-        }
-        else
-        {
-            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX, "%d bytes were sent\n", rc);
 
-            switchPtr->transmitterLock = FALSE;
-            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, 1);
+            goto ABORT;
         }
 
-        /**************************************************
-         * free buffer only when
-         * (1) sending to a single port;
-         * or (2) this is the last packet of multiple 
-         * identical packets
-         **************************************************/
+        switchPtr->transmitterLock = FALSE;
+        GET_PLAT_STATE(sw)->rawTxPackets += rc;
 
-        if (packet->freePacketBuffer)
+        /* Release the packets that were sent. If the batch was only
+         * partially sent, the next sendmmsg reports why. */
+        for (i = 0 ; i < rc ; i++)
         {
-            /* ignore the error code since it's better to continue */
-            (void) fmFreeBufferChain(sw, packet->packet);
+            FM_LOG_DEBUG(FM_LOG_CAT_EVENT_PKT_TX,
+                         "%d bytes were sent\n",
+                         msgs[i].msg_len);
+
+            fmDbgDiagCountIncr(sw, FM_CTR_TX_PKT_COMPLETE, 1);
 
-            fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_TX_BUFFER_FREES, 1);
+            ReleaseTxPacket(sw, &txQueue->packetQueueList[txQueue->pullIndex]);
+            fmPacketQueueAdvance(txQueue);
         }
     }
 
@@ -670,6 +2529,10 @@ ABORT:
  * \ingroup intPlatformCommon
  *
  * \desc            Handles reception of packets by raw packet socket.
+ *                  Frames are received in batches of up to
+ *                  api.platform.rawSocket.rxBatchSize frames per recvmmsg
+ *                  call, and link events are processed to keep the cached
+ *                  interface state current.
  *
  * \param[in]       args is a pointer to the switch number.
  *
@@ -678,35 +2541,23 @@ ABORT:
  *****************************************************************************/
 void * fmRawPacketSocketReceivePackets(void *args)
 {
-    fm_thread *        thread;
-    fm_int             sw;
-    fm_buffer *        recvChainHead = NULL;
-    fm_buffer *        nextBuffer;
-    struct pollfd      rfds;
-    struct msghdr      msg;
-    struct iovec       iov[UIO_MAXIOV];
-    struct ifreq       ifr;
-    fm_int             retval;
-    fm_int             availableBuffers;
-    fm_int             len;
-    fm_int             iov_offset;
-    fm_int             iov_count = 0;
-    fm_int             maxMtu = 0;
-    fm_int             newMtu;
-    fm_status          status;
-    char               strErrBuf[FM_STRERROR_BUF_SIZE];
-    errno_t            strErrNum;
-    fm_byte            rawTS[8];
-    fm_pktSideBandData sbData;
-#ifdef ENABLE_TIMESTAMP
-    struct cmsghdr *   cmsg;
-    union {
-        struct cmsghdr  cm;
-        char            control[512];
-
-    } control;
-#endif
-    
+    fm_thread *         thread;
+    fm_int              sw;
+    fm_rawSocketRxSlot *slots;
+    struct mmsghdr      msgs[FM_RAW_SOCKET_MAX_BATCH];
+    struct pollfd       rfds[2];
+    fm_int              numFds;
+    fm_int              retval;
+    fm_int              availableBuffers;
+    fm_int              len;
+    fm_int              i;
+    fm_int              batchSize;
+    fm_int              numSlots;
+    fm_int              iov_count = 0;
+    fm_int              maxMtu = 0;
+    fm_int              newMtu;
+    char                strErrBuf[FM_STRERROR_BUF_SIZE];
+    errno_t             strErrNum;
 
     thread = FM_GET_THREAD_HANDLE(args);
     sw     = *(FM_GET_THREAD_PARAM(fm_int, args));
@@ -718,28 +2569,37 @@ void * fmRawPacketSocketReceivePackets(void *args)
                  thread->name,
                  sw);
 
-    /* initialize the message header */
-    FM_CLEAR(msg);
-    msg.msg_name = NULL; /* Optional field */
-    msg.msg_namelen = 0;
-    msg.msg_iov = iov;
-    msg.msg_iovlen = 0;
-    msg.msg_flags = 0;
-#ifdef ENABLE_TIMESTAMP
-    msg.msg_control = &control;
-    msg.msg_controllen = sizeof(control);
-#endif
+    batchSize = GET_PLAT_STATE(sw)->rawRxBatchSize;
 
-    /* Setup the name of the interface */
-    FM_STRNCPY_S(ifr.ifr_name, 
-                 sizeof(ifr.ifr_name), 
-                 GET_PLAT_STATE(sw)->ifaceName, 
-                 sizeof(GET_PLAT_STATE(sw)->ifaceName));
+    slots = fmAlloc(batchSize * sizeof(fm_rawSocketRxSlot));
 
-    /* Prepare the pollfd struct */
-    rfds.fd = GET_PLAT_STATE(sw)->rawSocket;
-    rfds.events = POLLIN;
-    rfds.revents = 0;
+    if (slots == NULL)
+    {
+        FM_LOG_ERROR(FM_LOG_CAT_SWITCH,
+                     "Unable to allocate %d receive slots\n",
+                     batchSize);
+        fmExitThread(thread);
+        return NULL;
+    }
+
+    FM_MEMSET_S(slots,
+                batchSize * sizeof(fm_rawSocketRxSlot),
+                0,
+                batchSize * sizeof(fm_rawSocketRxSlot));
+
+    /* Prepare the pollfd structs */
+    rfds[0].fd      = GET_PLAT_STATE(sw)->rawSocket;
+    rfds[0].events  = POLLIN;
+    rfds[0].revents = 0;
+    numFds          = 1;
+
+    if (GET_PLAT_STATE(sw)->linkEventSocket != -1)
+    {
+        rfds[1].fd      = GET_PLAT_STATE(sw)->linkEventSocket;
+        rfds[1].events  = POLLIN;
+        rfds[1].revents = 0;
+        numFds++;
+    }
 
     /**************************************************
      * Loop forever calling packet receive handler.
@@ -748,7 +2608,7 @@ void * fmRawPacketSocketReceivePackets(void *args)
     while (TRUE)
     {
         errno = 0;
-        retval = poll(&rfds, 1, FM_FDS_POLL_TIMEOUT_USEC);
+        retval = poll(rfds, numFds, FM_FDS_POLL_TIMEOUT_USEC);
 
         if (retval == -1)
         {
@@ -782,9 +2642,25 @@ void * fmRawPacketSocketReceivePackets(void *args)
                 break;
             }
 
+            /* Without link events, poll the device state while idle */
+            if (numFds == 1)
+            {
+                RefreshIfaceState(sw);
+            }
+
             continue; /* timeout */
         }
 
+        if ( (numFds > 1) && (rfds[1].revents & POLLIN) )
+        {
+            ProcessLinkEvents(sw);
+        }
+
+        if ( (rfds[0].revents & POLLIN) == 0 )
+        {
+            continue;
+        }
+
         /* get the number of available buffers from the buffer manager*/
         fmPlatformGetAvailableBuffers(&availableBuffers);
 
@@ -795,36 +2671,29 @@ void * fmRawPacketSocketReceivePackets(void *args)
             continue;
         }
 
-        if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFMTU, &ifr) == -1)
-        {
-             FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
-                            "WARNING: failed to read netdev MTU\n");
-             continue;
-        }
-        else
+        if (GET_PLAT_STATE(sw)->rawRing != NULL)
         {
-            newMtu = ifr.ifr_mtu;
+            /* Frames are read in place from the receive ring */
+            if ( !ReceiveRingBlock(sw, GET_PLAT_STATE(sw)->rawRing) )
+            {
+                WaitRingBlock(GET_PLAT_STATE(sw)->rawRing);
+                continue;
+            }
+
+            while ( ReceiveRingBlock(sw, GET_PLAT_STATE(sw)->rawRing) )
+            {
+            }
+
+            continue;
         }
 
+        GetIfaceState(sw, &newMtu);
+
         /* MTU Size change */
         if (newMtu != maxMtu)
         {
-            if (recvChainHead != NULL)
-            {
-                /* release the existing buffer chain */
-                status = fmFreeBufferChain(FM_FIRST_FOCALPOINT, recvChainHead);
-
-                if (status != FM_OK)
-                {
-                    FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                 "Unable to release prior buffer chain, "
-                                 "status = %d (%s)\n",
-                                 status,
-                                 fmErrorMsg(status) );
-                }
-
-                recvChainHead = NULL;
-            }
+            /* release the existing buffer chains */
+            ReleaseRxSlots(slots, batchSize);
 
             /* compute new buffer count */
             iov_count = newMtu / FM_BUFFER_SIZE_BYTES;
@@ -833,183 +2702,61 @@ void * fmRawPacketSocketReceivePackets(void *args)
                 iov_count++;
             }
 
-            maxMtu = newMtu;
-        }
-
-        if (recvChainHead == NULL)
-        {
-            /* allocate a new buffer chain and initialize iovec array */
-            msg.msg_iovlen = 0;
-            
-            /* 8-Byte Timestamp IOV */
-            iov[msg.msg_iovlen].iov_base = rawTS;
-            iov[msg.msg_iovlen].iov_len  = sizeof(rawTS);
-            msg.msg_iovlen++;
-
-            for (iov_offset = 0 ; iov_offset < iov_count ; iov_offset++)
+            if (iov_count >= FM_RAW_SOCKET_MAX_RX_IOV)
             {
-                do
-                {
-                    nextBuffer = fmAllocateBuffer(FM_FIRST_FOCALPOINT);
-
-                    if (nextBuffer == NULL)
-                    {
-                        /* Wait a little while for buffer to return */
-                        fmDbgGlobalDiagCountIncr(FM_GLOBAL_CTR_RX_OUT_OF_BUFFERS,
-                                                 1);
-                        fmYield();
-                    }
-                }
-                while (nextBuffer == NULL);
-
-                if (recvChainHead == NULL)
-                {
-                    recvChainHead    = nextBuffer;
-                    nextBuffer->next = NULL;
-                }
-                else
-                {
-                    status = fmAddBuffer(recvChainHead, nextBuffer);
-
-                    if (status != FM_OK)
-                    {
-                        FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                     "Unable to add buffer %d (%p) to chain %p\n",
-                                     iov_offset,
-                                     (void *) nextBuffer,
-                                     (void *) recvChainHead );
-                        break;
-                    }
-                }
-
-                iov[msg.msg_iovlen].iov_base = nextBuffer->data;
-                iov[msg.msg_iovlen].iov_len  = FM_BUFFER_SIZE_BYTES;
-                msg.msg_iovlen++;
+                iov_count = FM_RAW_SOCKET_MAX_RX_IOV - 1;
             }
+
+            maxMtu = newMtu;
         }
 
-        /* now receive from the driver */
-        len = recvmsg(GET_PLAT_STATE(sw)->rawSocket,
-                      &msg,
-                      0);
+        /* Don't arm more slots than the buffer manager can spare */
+        numSlots = (availableBuffers - FM_RECV_BUFFER_THRESHOLD) /
+                   ( (iov_count > 0) ? iov_count : 1 );
 
-        if (len == -1)
+        if (numSlots > batchSize)
         {
-            continue;
+            numSlots = batchSize;
         }
-
-#ifdef ENABLE_TIMESTAMP
-        for (cmsg = CMSG_FIRSTHDR(&msg);
-             cmsg;
-             cmsg = CMSG_NXTHDR(&msg, cmsg)) 
+        else if (numSlots < 1)
         {
-            if ( (cmsg->cmsg_level == SOL_SOCKET) &&
-                 (cmsg->cmsg_type  == SO_TIMESTAMPING) &&
-                 (cmsg->cmsg_len   == CMSG_LEN(sizeof(struct timespec) * 3)) )
-            {
-                    struct timespec *stamp =
-                        (struct timespec *)CMSG_DATA(cmsg);
-                    /* cmsg has 3 different timestamps. Timestamp we are interested is 
-                     * located in index 2 */
-                    sbData.ingressTimestamp.seconds     = ( (fm_int64)(stamp[2].tv_sec) );
-                    sbData.ingressTimestamp.nanoseconds = ( (fm_int64)(stamp[2].tv_nsec) );
-            }
-            else
-            {
-                    FM_LOG_WARNING(FM_LOG_CAT_PLATFORM, 
-                                  "Unknown control message of level %d type %d len %zu  received\n",
-                                  cmsg->cmsg_level, 
-                                  cmsg->cmsg_type,
-                                  cmsg->cmsg_len);
-            }
+            numSlots = 1;
         }
-#endif
 
-        /* Remove the timestamp's length to get the length of the actual
-         * packet */
-        len -= sizeof(rawTS);
-
-        /* The raw socket does not carry the FCS in either tx or rx, however
-         * the API expects it to be present. Because the API clears the 
-         * FCS value before sending the packet event to the application, don't 
-         * bother about setting the correct FCS value and just increment the 
-         * length. The FCS value is undefined (whatever is in the fm_buffer at 
-         * the FCS position). */
-        len += 4;
-
-        /* fill in the used buffer sizes */
-        nextBuffer = recvChainHead;
-
-        while (nextBuffer != NULL)
+        /* allocate the buffer chains and initialize the iovec arrays */
+        for (i = 0 ; i < numSlots ; i++)
         {
-            if (len > FM_BUFFER_SIZE_BYTES)
-            {
-                nextBuffer->len = FM_BUFFER_SIZE_BYTES;
-            }
-            else
-            {
-                nextBuffer->len = len;
-            }
-
-            len -= nextBuffer->len;
-
-            if ( (len <= 0) && (nextBuffer->next != NULL) )
-            {
-                status = fmFreeBufferChain(FM_FIRST_FOCALPOINT,
-                                           nextBuffer->next);
-
-                if (status != FM_OK)
-                {
-                    FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                                 "Unable to release unused buffer chain, "
-                                 "status = %d (%s)\n",
-                                 status,
-                                 fmErrorMsg(status) );
-                }
-
-                nextBuffer->next = NULL;
-            }
-
-            nextBuffer = nextBuffer->next;
+            FM_CLEAR(msgs[i]);
+            ArmRxSlot(&slots[i], &msgs[i].msg_hdr, iov_count);
         }
 
-        if (recvChainHead == NULL)
+        /* now receive from the driver */
+        len = recvmmsg(GET_PLAT_STATE(sw)->rawSocket,
+                       msgs,
+                       numSlots,
+                       MSG_DONTWAIT,
+                       NULL);
+
+        if (len == -1)
         {
             continue;
         }
 
-        /* Store the raw timestamp in 64b format */
-        sbData.rawTimeStamp  = ((fm_uint64) (rawTS[0] & 0xFF)) << 56;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[1] & 0xFF)) << 48;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[2] & 0xFF)) << 40;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[3] & 0xFF)) << 32;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[4] & 0xFF)) << 24;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[5] & 0xFF)) << 16;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[6] & 0xFF)) << 8;
-        sbData.rawTimeStamp |= ((fm_uint64) (rawTS[7] & 0xFF));
-
-        /* Don't provide an ISL tag pointer, let the API handle the ISL
-         * tag information (included in the fm_buffer chain). */
-        status = fmPlatformReceiveProcessV2(sw,
-                                            recvChainHead,
-                                            NULL,
-                                            &sbData);
+        GET_PLAT_STATE(sw)->rawRxSyscalls++;
+        GET_PLAT_STATE(sw)->rawRxPackets += len;
 
-        if (status != FM_OK)
+        /* The buffer chains of the received frames are consumed, the
+         * remaining slots stay armed for the next batch. */
+        for (i = 0 ; i < len ; i++)
         {
-            FM_LOG_ERROR( FM_LOG_CAT_SWITCH,
-                         "Returned error status %d "
-                         "(%s)\n",
-                         status,
-                         fmErrorMsg(status) );
-
-
+            ProcessRxFrame(sw, &slots[i], &msgs[i].msg_hdr, msgs[i].msg_len);
         }
-        /* Buffer chain has now been consumed */
-        recvChainHead = NULL; 
 
     }   /* end while (TRUE) */
 
+    ReleaseRxSlots(slots, batchSize);
+    fmFree(slots);
+
     fmExitThread(thread);
 
     return NULL;
@@ -1046,9 +2793,6 @@ fm_bool fmIsRawPacketSocketDeviceOperational(fm_int   sw,
                                              fm_int * mtu)
 {
     fm_switch    *switchPtr;
-    char         strErrBuf[FM_STRERROR_BUF_SIZE];
-    errno_t      strErrNum;
-    struct ifreq ifr;
 
     FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "sw=%d\n", sw);
 
@@ -1064,57 +2808,323 @@ fm_bool fmIsRawPacketSocketDeviceOperational(fm_int   sw,
         FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM, TRUE, "No raw packet socket\n");
     }
 
-    FM_STRNCPY_S(ifr.ifr_name,
-                 IF_NAMESIZE,
-                 GET_PLAT_STATE(sw)->ifaceName,
-                 IF_NAMESIZE);
-    
-    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFFLAGS, &ifr) == -1)
+    /* The cached state follows link events, only query the device when
+     * it is believed to be down. */
+    if ( !GetIfaceState(sw, NULL) )
     {
-        strErrNum = FM_STRERROR_S(strErrBuf, FM_STRERROR_BUF_SIZE, errno);
-        if (strErrNum == 0)
-        {
-            FM_LOG_FATAL(FM_LOG_CAT_PLATFORM, 
-                         "Failed to get socket %d flags for device %s: %s\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         strErrBuf);
-        }
-        else
+        if (RefreshIfaceState(sw) != FM_OK)
         {
-            FM_LOG_FATAL(FM_LOG_CAT_PLATFORM, 
-                         "Failed to get socket %d flags for device %s: %d\n",
-                         GET_PLAT_STATE(sw)->rawSocket,
-                         ifr.ifr_name,
-                         errno);
+            FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM, FALSE, "Not operational\n");
         }
-        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM, FALSE, "Not operational\n");
     }
 
-    if ((ifr.ifr_flags & IFF_RUNNING) == 0)
+    if ( !GetIfaceState(sw, NULL) )
     {    
         FM_LOG_WARNING(FM_LOG_CAT_PLATFORM,
                        "Network device %s resources are not allocated.\n",
-                       ifr.ifr_name);
+                       GET_PLAT_STATE(sw)->ifaceName);
         FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM, FALSE, "Not operational\n");
     }
 
-    if (ioctl(GET_PLAT_STATE(sw)->rawSocket, SIOCGIFMTU, &ifr) == -1)
-    {
-        FM_LOG_WARNING(FM_LOG_CAT_SWITCH,
-                       "WARNING: failed to read netdev MTU\n");
-        FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM,
-                           FALSE,
-                           "MTU could not be retrieved\n");
-    }
-
     if ( (isRawSocket != NULL) && (mtu != NULL) )
     {
         *isRawSocket = FM_ENABLED;
-        *mtu         = ifr.ifr_mtu;
+        GetIfaceState(sw, mtu);
     }
 
     FM_LOG_EXIT_CUSTOM(FM_LOG_CAT_PLATFORM, TRUE, "Operational\n");
 
 } /* fmIsRawPacketSocketDeviceOperational */
 
+
+
+
+/*****************************************************************************/
+/** fmDbgDumpRawPacketSocketStats
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Dumps the raw packet socket batching statistics.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+void fmDbgDumpRawPacketSocketStats(fm_int sw)
+{
+    fm_switch *       switchPtr;
+    fm_rawSocketRing *ring;
+    fm_uint64         rxSyscalls;
+    fm_uint64         txSyscalls;
+    fm_bool           running;
+    fm_int            mtu;
+
+    switchPtr = GET_SWITCH_PTR(sw);
+
+    if ( (switchPtr == NULL) ||
+         (switchPtr->isRawSocketInitialized == FM_DISABLED) )
+    {
+        FM_LOG_PRINT("No raw packet socket on switch %d\n", sw);
+        return;
+    }
+
+    rxSyscalls = GET_PLAT_STATE(sw)->rawRxSyscalls;
+    txSyscalls = GET_PLAT_STATE(sw)->rawTxSyscalls;
+    running    = GetIfaceState(sw, &mtu);
+
+    FM_LOG_PRINT("Raw packet socket %s (index %d): %s, MTU %d, "
+                 "link events %s\n",
+                 GET_PLAT_STATE(sw)->ifaceName,
+                 GET_PLAT_STATE(sw)->ifaceIndex,
+                 running ? "running" : "down",
+                 mtu,
+                 (GET_PLAT_STATE(sw)->linkEventSocket != -1) ? "on" : "off");
+    FM_LOG_PRINT("           Batch  Syscalls       Packets  Packets/Syscall\n");
+    FM_LOG_PRINT("RX    %10d  %8" FM_FORMAT_64 "u  %12" FM_FORMAT_64 "u  %15.2f\n",
+                 GET_PLAT_STATE(sw)->rawRxBatchSize,
+                 rxSyscalls,
+                 GET_PLAT_STATE(sw)->rawRxPackets,
+                 rxSyscalls ?
+                    (double) GET_PLAT_STATE(sw)->rawRxPackets / rxSyscalls :
+                    0.0);
+    FM_LOG_PRINT("TX    %10d  %8" FM_FORMAT_64 "u  %12" FM_FORMAT_64 "u  %15.2f\n",
+                 GET_PLAT_STATE(sw)->rawTxBatchSize,
+                 txSyscalls,
+                 GET_PLAT_STATE(sw)->rawTxPackets,
+                 txSyscalls ?
+                    (double) GET_PLAT_STATE(sw)->rawTxPackets / txSyscalls :
+                    0.0);
+
+    ring = GET_PLAT_STATE(sw)->rawRing;
+
+    if (ring != NULL)
+    {
+        FM_LOG_PRINT("Packet rings: %d blocks, transmit ring %s\n",
+                     ring->rxNumBlocks,
+                     (ring->txRing != NULL) ? "on" : "off");
+        FM_LOG_PRINT("RX frames in place %" FM_FORMAT_64 "u, "
+                     "copied %" FM_FORMAT_64 "u\n",
+                     ring->rxViewFrames,
+                     ring->rxCopiedFrames);
+        FM_LOG_PRINT("TX frames being sent %d\n", ring->txPending);
+    }
+
+}   /* end fmDbgDumpRawPacketSocketStats */
+
+
+
+
+/*****************************************************************************/
+/** fmDbgRawPacketSocketBenchmark
+ * \ingroup intPlatformCommon
+ *
+ * \desc            Measures the raw packet socket throughput achievable with
+ *                  a given recvmmsg / sendmmsg batch size. Frames are sent
+ *                  on one interface and received on another (or the same,
+ *                  e.g. lo, or the two ends of a veth pair), independently
+ *                  of any switch.
+ *
+ * \param[in]       txIface is the name of the interface to send on.
+ *
+ * \param[in]       rxIface is the name of the interface to receive on.
+ *
+ * \param[in]       numFrames is the number of frames to send.
+ *
+ * \param[in]       frameSize is the size of each frame in bytes, excluding
+ *                  the FCS.
+ *
+ * \param[in]       batchSize is the number of frames per system call.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an argument is invalid.
+ * \return          FM_ERR_NO_MEM if memory could not be allocated.
+ * \return          FM_FAIL if the sockets could not be used.
+ *
+ *****************************************************************************/
+fm_status fmDbgRawPacketSocketBenchmark(fm_text txIface,
+                                        fm_text rxIface,
+                                        fm_int  numFrames,
+                                        fm_int  frameSize,
+                                        fm_int  batchSize)
+{
+    fm_status      err = FM_OK;
+    fm_int         txSock = -1;
+    fm_int         rxSock = -1;
+    fm_byte *      txFrame = NULL;
+    fm_byte *      rxFrames = NULL;
+    struct mmsghdr txMsgs[FM_RAW_SOCKET_MAX_BATCH];
+    struct mmsghdr rxMsgs[FM_RAW_SOCKET_MAX_BATCH];
+    struct iovec   txIov;
+    struct iovec   rxIov[FM_RAW_SOCKET_MAX_BATCH];
+    struct pollfd  rfds;
+    fm_timestamp   start;
+    fm_timestamp   end;
+    fm_timestamp   diff;
+    fm_uint64      usec;
+    fm_int         sent = 0;
+    fm_int         received = 0;
+    fm_int         txCalls = 0;
+    fm_int         rxCalls = 0;
+    fm_int         rc;
+    fm_int         i;
+
+    if ( (txIface == NULL) || (rxIface == NULL) || (numFrames <= 0) ||
+         (frameSize < 60) || (frameSize > FM_MAX_JUMBO_FRAME_SIZE) ||
+         (batchSize < 1) || (batchSize > FM_RAW_SOCKET_MAX_BATCH) )
+    {
+        return FM_ERR_INVALID_ARGUMENT;
+    }
+
+    txFrame  = fmAlloc(frameSize);
+    rxFrames = fmAlloc(batchSize * frameSize);
+
+    if ( (txFrame == NULL) || (rxFrames == NULL) )
+    {
+        err = FM_ERR_NO_MEM;
+        goto ABORT;
+    }
+
+    /* Broadcast frame with a locally administered source address */
+    FM_MEMSET_S(txFrame, frameSize, 0, frameSize);
+    FM_MEMSET_S(txFrame, 6, 0xFF, 6);
+    txFrame[6]  = 0x02;
+    txFrame[11] = 0x01;
+    txFrame[12] = (FM_RAW_SOCKET_BENCH_ETYPE >> 8) & 0xFF;
+    txFrame[13] = FM_RAW_SOCKET_BENCH_ETYPE & 0xFF;
+
+    for (i = 14 ; i < frameSize ; i++)
+    {
+        txFrame[i] = (fm_byte) i;
+    }
+
+    txSock = OpenBenchmarkSocket(txIface, 0);
+    rxSock = OpenBenchmarkSocket(rxIface, FM_RAW_SOCKET_BENCH_ETYPE);
+
+    if ( (txSock == -1) || (rxSock == -1) )
+    {
+        err = FM_FAIL;
+        goto ABORT;
+    }
+
+    /* Every transmit message sends the same frame */
+    txIov.iov_base = txFrame;
+    txIov.iov_len  = frameSize;
+
+    for (i = 0 ; i < batchSize ; i++)
+    {
+        FM_CLEAR(txMsgs[i]);
+        txMsgs[i].msg_hdr.msg_iov    = &txIov;
+        txMsgs[i].msg_hdr.msg_iovlen = 1;
+
+        rxIov[i].iov_base = &rxFrames[i * frameSize];
+        rxIov[i].iov_len  = frameSize;
+        FM_CLEAR(rxMsgs[i]);
+        rxMsgs[i].msg_hdr.msg_iov    = &rxIov[i];
+        rxMsgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    rfds.fd     = rxSock;
+    rfds.events = POLLIN;
+
+    fmGetTime(&start);
+    end = start;
+
+    while (sent < numFrames)
+    {
+        rc = sendmmsg(txSock,
+                      txMsgs,
+                      ( (numFrames - sent) < batchSize ) ?
+                        (numFrames - sent) : batchSize,
+                      MSG_DONTWAIT);
+        txCalls++;
+
+        if (rc > 0)
+        {
+            sent += rc;
+        }
+        else if ( (errno != EAGAIN) && (errno != ENOBUFS) )
+        {
+            FM_LOG_PRINT("sendmmsg failed, errno %d\n", errno);
+            err = FM_FAIL;
+            break;
+        }
+
+        /* Drain the receive side so it does not overflow */
+        do
+        {
+            rc = recvmmsg(rxSock, rxMsgs, batchSize, MSG_DONTWAIT, NULL);
+
+            if (rc > 0)
+            {
+                received += rc;
+                rxCalls++;
+                fmGetTime(&end);
+            }
+        }
+        while (rc == batchSize);
+    }
+
+    /* Collect the frames still in flight */
+    while ( (received < sent) && (poll(&rfds, 1, 100) > 0) )
+    {
+        rc = recvmmsg(rxSock, rxMsgs, batchSize, MSG_DONTWAIT, NULL);
+
+        if (rc > 0)
+        {
+            received += rc;
+            rxCalls++;
+            fmGetTime(&end);
+        }
+    }
+
+    fmSubTimestamps(&end, &start, &diff);
+    usec = diff.sec * 1000000 + diff.usec;
+
+    if (usec == 0)
+    {
+        usec = 1;
+    }
+
+    FM_LOG_PRINT("Raw packet socket benchmark %s -> %s, %d byte frames, "
+                 "batch %d\n",
+                 txIface,
+                 rxIface,
+                 frameSize,
+                 batchSize);
+    FM_LOG_PRINT("  sent %d frames in %d calls (%.2f frames/call)\n",
+                 sent,
+                 txCalls,
+                 txCalls ? (double) sent / txCalls : 0.0);
+    FM_LOG_PRINT("  received %d frames in %d calls (%.2f frames/call)\n",
+                 received,
+                 rxCalls,
+                 rxCalls ? (double) received / rxCalls : 0.0);
+    FM_LOG_PRINT("  %" FM_FORMAT_64 "u usec, %.0f frames/s, %.1f Mbps\n",
+                 usec,
+                 (double) received * 1e6 / usec,
+                 (double) received * frameSize * 8 / usec);
+
+ABORT:
+    if (txSock != -1)
+    {
+        close(txSock);
+    }
+
+    if (rxSock != -1)
+    {
+        close(rxSock);
+    }
+
+    if (txFrame != NULL)
+    {
+        fmFree(txFrame);
+    }
+
+    if (rxFrames != NULL)
+    {
+        fmFree(rxFrames);
+    }
+
+    return err;
+
+}   /* end fmDbgRawPacketSocketBenchmark */
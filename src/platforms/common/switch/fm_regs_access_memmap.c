@@ -51,6 +51,10 @@
 #define CSR_LOG_EXIT(cat, status) return (status)
 #endif
 
+/* Orders the register accesses of a burst with respect to the accesses
+ * that precede and follow it, including a read that follows a write. */
+#define CSR_MEMORY_BARRIER()  __sync_synchronize()
+
 /*****************************************************************************
  * Global Variables
  *****************************************************************************/
@@ -699,3 +703,236 @@ fm_status fmPlatformWriteRawCSRSeq(fm_int     sw,
 }   /* end fmPlatformWriteRawCSRSeq */
 
 
+
+
+/*****************************************************************************/
+/** fmPlatformReadCSRScatterGather
+ * \ingroup intPlatform
+ *
+ * \desc            Read multiple discontiguous regions of CSR space, taking
+ *                  the platform lock only once.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of scatter-gather entries
+ *                  in sgList.
+ *
+ * \param[in]       sgList is an array of length nEntries, which
+ *                  describes each region to be read.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformReadCSRScatterGather(fm_int                     sw,
+                                         fm_int                     nEntries,
+                                         fm_scatterGatherListEntry *sgList)
+{
+    volatile fm_uint32 *csr;
+    fm_int              i;
+    fm_uint32           j;
+
+    CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                  "sw = %d, nEntries = %d, sgList = %p\n",
+                  sw,
+                  nEntries,
+                  (void *) sgList);
+
+    TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+
+    csr = GET_PLAT_MEMMAP_CSR(sw);
+
+    CSR_MEMORY_BARRIER();
+
+    for (i = 0 ; i < nEntries ; i++)
+    {
+        for (j = 0 ; j < sgList[i].count ; j++)
+        {
+            sgList[i].data[j] = csr[sgList[i].addr + j];
+        }
+    }
+
+    DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+
+    CSR_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmPlatformReadCSRScatterGather */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformWriteCSRScatterGather
+ * \ingroup intPlatform
+ *
+ * \desc            Write multiple discontiguous regions of CSR space,
+ *                  taking the platform lock only once.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of scatter-gather entries
+ *                  in sgList.
+ *
+ * \param[in]       sgList is an array of length nEntries, which
+ *                  describes each region to be written.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+fm_status fmPlatformWriteCSRScatterGather(fm_int                     sw,
+                                          fm_int                     nEntries,
+                                          fm_scatterGatherListEntry *sgList)
+{
+    volatile fm_uint32 *csr;
+    fm_int              i;
+    fm_uint32           j;
+
+    CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                  "sw = %d, nEntries = %d, sgList = %p\n",
+                  sw,
+                  nEntries,
+                  (void *) sgList);
+
+    if (GET_PLAT_STATE(sw)->bypassEnable)
+    {
+        CSR_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+    }
+
+    TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+
+    csr = GET_PLAT_MEMMAP_CSR(sw);
+
+    for (i = 0 ; i < nEntries ; i++)
+    {
+        for (j = 0 ; j < sgList[i].count ; j++)
+        {
+            INSTRUMENT_REG_WRITE(sw, sgList[i].addr + j, sgList[i].data[j]);
+            csr[sgList[i].addr + j] = sgList[i].data[j];
+        }
+    }
+
+    CSR_MEMORY_BARRIER();
+
+    DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+
+    CSR_LOG_EXIT(FM_LOG_CAT_PLATFORM, FM_OK);
+
+}   /* end fmPlatformWriteCSRScatterGather */
+
+
+
+
+/*****************************************************************************/
+/** fmPlatformCommitCSRTransaction
+ * \ingroup intPlatform
+ *
+ * \desc            Execute a list of CSR reads and writes, in order, as a
+ *                  single burst.
+ *                                                                      \lb\lb
+ *                  The platform lock is taken once for the whole list,
+ *                  unless FM_REG_TXN_FLAG_LOCKLESS is specified, in which
+ *                  case it is not taken at all. The lockless mode may only
+ *                  be used for registers which a single thread accesses.
+ *
+ * \param[in]       sw is the switch on which to operate.
+ *
+ * \param[in]       nEntries is the number of entries in entries.
+ *
+ * \param[in,out]   entries is an array of length nEntries, which describes
+ *                  each region to be read or written.
+ *
+ * \param[in]       flags is a bit mask of FM_REG_TXN_FLAG_* values.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_INVALID_ARGUMENT if an entry has an invalid
+ *                  operation. Entries preceding it have been executed.
+ *
+ *****************************************************************************/
+fm_status fmPlatformCommitCSRTransaction(fm_int                  sw,
+                                         fm_int                  nEntries,
+                                         fm_regTransactionEntry *entries,
+                                         fm_uint32               flags)
+{
+    volatile fm_uint32 *csr;
+    fm_bool             bypass;
+    fm_bool             lockless;
+    fm_bool             wrote;
+    fm_status           err;
+    fm_int              i;
+    fm_uint32           j;
+
+    CSR_LOG_ENTRY(FM_LOG_CAT_PLATFORM,
+                  "sw = %d, nEntries = %d, entries = %p, flags = 0x%x\n",
+                  sw,
+                  nEntries,
+                  (void *) entries,
+                  flags);
+
+    bypass   = GET_PLAT_STATE(sw)->bypassEnable;
+    lockless = (flags & FM_REG_TXN_FLAG_LOCKLESS) != 0;
+    wrote    = FALSE;
+    err      = FM_OK;
+
+    if (!lockless)
+    {
+        TAKE_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+    }
+
+    csr = GET_PLAT_MEMMAP_CSR(sw);
+
+    CSR_MEMORY_BARRIER();
+
+    for (i = 0 ; i < nEntries ; i++)
+    {
+        if (entries[i].op == FM_REG_TXN_WRITE)
+        {
+            if (bypass && BYPASS_ADDR_CHECK(entries[i].addr))
+            {
+                continue;
+            }
+
+            for (j = 0 ; j < entries[i].count ; j++)
+            {
+                INSTRUMENT_REG_WRITE(sw,
+                                     entries[i].addr + j,
+                                     entries[i].data[j]);
+                csr[entries[i].addr + j] = entries[i].data[j];
+            }
+
+            wrote = TRUE;
+        }
+        else if (entries[i].op == FM_REG_TXN_READ)
+        {
+            if (wrote)
+            {
+                /* Make sure that preceding writes have been posted
+                 * before reading back. */
+                CSR_MEMORY_BARRIER();
+                wrote = FALSE;
+            }
+
+            for (j = 0 ; j < entries[i].count ; j++)
+            {
+                entries[i].data[j] = csr[entries[i].addr + j];
+            }
+        }
+        else
+        {
+            err = FM_ERR_INVALID_ARGUMENT;
+            break;
+        }
+    }
+
+    CSR_MEMORY_BARRIER();
+
+    if (!lockless)
+    {
+        DROP_PLAT_LOCK(sw, FM_MEM_TYPE_CSR);
+    }
+
+    CSR_LOG_EXIT(FM_LOG_CAT_PLATFORM, err);
+
+}   /* end fmPlatformCommitCSRTransaction */
@@ -522,6 +522,9 @@ static fm_status SetRegAccessMode(fm_int sw, fm_int mode)
             switchPtr->ReadRawUINT32     = fmPlatformReadRawCSR;
             switchPtr->ReadEgressFid     = fmPlatformReadCSR;
             switchPtr->ReadIngressFid    = fmPlatformReadCSR64;
+            switchPtr->ReadScatterGather    = fmPlatformReadCSRScatterGather;
+            switchPtr->WriteScatterGather   = fmPlatformWriteCSRScatterGather;
+            switchPtr->CommitRegTransaction = fmPlatformCommitCSRTransaction;
             break;
 
         case FM_PLAT_REG_ACCESS_I2C:
@@ -539,6 +542,9 @@ static fm_status SetRegAccessMode(fm_int sw, fm_int mode)
             switchPtr->ReadRawUINT32     = NULL;
             switchPtr->ReadEgressFid     = fmPlatformI2cReadCSR;
             switchPtr->ReadIngressFid    = fmPlatformI2cReadCSR64;
+            switchPtr->ReadScatterGather    = NULL;
+            switchPtr->WriteScatterGather   = NULL;
+            switchPtr->CommitRegTransaction = NULL;
             break;
 
         case FM_PLAT_REG_ACCESS_EBI:
@@ -556,6 +562,9 @@ static fm_status SetRegAccessMode(fm_int sw, fm_int mode)
             switchPtr->ReadRawUINT32     = fmPlatformEbiReadRawCSR;
             switchPtr->ReadEgressFid     = fmPlatformEbiReadCSR;
             switchPtr->ReadIngressFid    = fmPlatformEbiReadCSR64;
+            switchPtr->ReadScatterGather    = NULL;
+            switchPtr->WriteScatterGather   = NULL;
+            switchPtr->CommitRegTransaction = NULL;
             break;
 
         default:
@@ -44,6 +44,71 @@
 /* Avoid calling fmAlloc for temporary variable */
 #define MAX_TEMP_PORTS         96
 
+/* Number of EEPROM reads that can be queued to the I2C worker */
+#define XCVR_I2C_QUEUE_SIZE    MAX_TEMP_PORTS
+
+/* Transceiver state read from the bus, for the ports in portIdxList */
+typedef struct
+{
+    fm_int    numPorts;
+    fm_int    portIdxList[MAX_TEMP_PORTS];
+    fm_uint32 xcvrStateValidList[MAX_TEMP_PORTS];
+    fm_uint32 xcvrStateList[MAX_TEMP_PORTS];
+
+} fm_xcvrStateSnapshot;
+
+/* Module EEPROM read queued to the I2C worker */
+typedef struct
+{
+    /* Index to the port and transceiver info structure */
+    fm_int    portIdx;
+
+    /* Tag of the read, see eepromReadTag in fm_platXcvrInfo */
+    fm_uint32 tag;
+
+    /* Whether this is a retry of a failed read */
+    fm_bool   retry;
+
+    /* Outcome of the read */
+    fm_status status;
+
+    /* EEPROM content read */
+    fm_byte   eeprom[XCVR_EEPROM_CACHE_SIZE];
+
+} fm_xcvrI2cRequest;
+
+/* EEPROM read queue between the mgmt thread and the I2C worker of a switch.
+ * The requests from doneIdx to headIdx are completed, the ones from headIdx
+ * to tailIdx are pending. The mgmt thread owns tailIdx and doneIdx, the
+ * worker owns headIdx. */
+typedef struct
+{
+    /* Protects the indexes and bus metrics */
+    fm_lock           lock;
+
+    /* Signaled when requests are queued */
+    fm_semaphore      sem;
+
+    fm_thread         thread;
+
+    fm_uint           tailIdx;
+    fm_uint           headIdx;
+    fm_uint           doneIdx;
+
+    /* Tag of the last queued read */
+    fm_uint32         lastTag;
+
+    fm_xcvrI2cRequest requests[XCVR_I2C_QUEUE_SIZE];
+
+    /* Bus metrics */
+    fm_uint64         numReads;
+    fm_uint64         numErrors;
+    fm_uint64         numBytes;
+    fm_uint64         busyUsec;
+    fm_uint64         maxUsec;
+
+} fm_xcvrI2cQueue;
+
 
 /*****************************************************************************
  * Global Variables
@@ -57,6 +122,10 @@
 static fm_semaphore mgmtSem[FM_MAX_NUM_SWITCHES];
 static fm_bool      pollingPendingTask[FM_MAX_NUM_SWITCHES] = {FALSE};
 static fm_bool      enableMgmt[FM_MAX_NUM_SWITCHES] = {FALSE};
+static fm_bool      interruptPending[FM_MAX_NUM_SWITCHES] = {FALSE};
+
+/* NULL when EEPROM reads are done inline by the caller */
+static fm_xcvrI2cQueue *i2cQueue[FM_MAX_NUM_SWITCHES] = {NULL};
 
 
 /*****************************************************************************
@@ -519,10 +588,11 @@ static void UpdateXcvrConfig(fm_int sw, fm_int portIndex, fm_int retries)
 
 
 /*****************************************************************************/
-/* XcvrReadAndValidateEeprom
+/* XcvrValidateEeprom
  * \ingroup intPlatform
  *
- * \desc            Read and validate transceiver eeprom content.
+ * \desc            Validate transceiver eeprom content once it has been read
+ *                  into the transceiver info structure.
  *
  * \param[in]       sw is the switch number.
  *
@@ -530,28 +600,22 @@ static void UpdateXcvrConfig(fm_int sw, fm_int portIndex, fm_int retries)
  *
  * \param[in]       retry indicates whether it is a retry read or not.
  * 
- * \return          FM_OK if successful.
- * \return          Other ''Status Codes'' as appropriate in case of
- *                  failure.
+ * \param[in]       status is the outcome of the eeprom read.
+ * 
+ * \return          status.
  *
  *****************************************************************************/
-static fm_status XcvrReadAndValidateEeprom(fm_int  sw,
-                                           fm_int  portIndex,
-                                           fm_bool retry)
+static fm_status XcvrValidateEeprom(fm_int    sw,
+                                    fm_int    portIndex,
+                                    fm_bool   retry,
+                                    fm_status status)
 {
     fm_platformCfgPort *portCfg;
     fm_platXcvrInfo *   xcvrInfo;
-    fm_status           status;
 
     portCfg = FM_PLAT_GET_PORT_CFG(sw, portIndex);
     xcvrInfo = &GET_PLAT_STATE(sw)->xcvrInfo[portIndex];
 
-    status = fmPlatformXcvrEepromRead(sw,
-                                      portCfg->port,
-                                      0,
-                                      0,
-                                      xcvrInfo->eeprom,
-                                      XCVR_EEPROM_CACHE_SIZE);
     if (status == FM_OK)
     {
         if (retry)
@@ -602,6 +666,48 @@ static fm_status XcvrReadAndValidateEeprom(fm_int  sw,
 
     return status;
 
+}   /* end XcvrValidateEeprom */
+
+
+
+
+/*****************************************************************************/
+/* XcvrReadAndValidateEeprom
+ * \ingroup intPlatform
+ *
+ * \desc            Read and validate transceiver eeprom content.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       portIndex is the index to the transceiver info structure.
+ *
+ * \param[in]       retry indicates whether it is a retry read or not.
+ * 
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status XcvrReadAndValidateEeprom(fm_int  sw,
+                                           fm_int  portIndex,
+                                           fm_bool retry)
+{
+    fm_platformCfgPort *portCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_status           status;
+
+    portCfg = FM_PLAT_GET_PORT_CFG(sw, portIndex);
+    xcvrInfo = &GET_PLAT_STATE(sw)->xcvrInfo[portIndex];
+
+    status = fmPlatformXcvrEepromRead(sw,
+                                      portCfg->port,
+                                      0,
+                                      0,
+                                      xcvrInfo->eeprom,
+                                      XCVR_EEPROM_CACHE_SIZE);
+
+    return XcvrValidateEeprom(sw, portIndex, retry, status);
+
 }   /* end XcvrReadAndValidateEeprom */
 
 
@@ -719,59 +825,407 @@ static fm_status NotifyXcvrDetection(fm_int sw, fm_int portIndex)
 
 
 /*****************************************************************************/
-/* XcvrUpdateState
+/* XcvrCompleteEepromRead
  * \ingroup intPlatform
  *
- * \desc            Update transceiver state, normally called when there is an
- *                  interrupt notifying state change, or polling.
+ * \desc            Apply the outcome of a module EEPROM read to the cached
+ *                  transceiver state. Called with the switch lock taken.
  *
  * \param[in]       sw is the switch number.
- * 
- * \param[in]       force is update state even without state change.
  *
- * \param[in]       interrupting indicates interrupts are pending.
+ * \param[in]       req points to the completed read.
  *
  * \return          None.
  *
  *****************************************************************************/
-static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
+static void XcvrCompleteEepromRead(fm_int sw, fm_xcvrI2cRequest *req)
+{
+    fm_platformCfgPort *portCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_status           status;
+
+    portCfg  = FM_PLAT_GET_PORT_CFG(sw, req->portIdx);
+    xcvrInfo = &GET_PLAT_STATE(sw)->xcvrInfo[req->portIdx];
+
+    if (req->tag != xcvrInfo->eepromReadTag)
+    {
+        /* The module has changed since the read was queued */
+        MOD_STATE_DEBUG("Port %d:%d Discard stale module EEPROM read\n",
+                        sw,
+                        portCfg->port);
+        return;
+    }
+
+    xcvrInfo->eepromReadTag = 0;
+
+    if (req->status == FM_OK)
+    {
+        FM_MEMCPY_S(xcvrInfo->eeprom,
+                    sizeof(xcvrInfo->eeprom),
+                    req->eeprom,
+                    sizeof(req->eeprom));
+    }
+
+    status = XcvrValidateEeprom(sw, req->portIdx, req->retry, req->status);
+
+    if (!req->retry)
+    {
+        MOD_STATE_DEBUG("Port %d:%d module reading EEPROM: %s\n",
+                        sw,
+                        portCfg->port, 
+                        fmErrorMsg(status));
+    }
+
+    if (status == FM_OK)
+    {
+        NotifyXcvrDetection(sw, req->portIdx);
+    }
+    else if (req->retry && xcvrInfo->eepromReadRetries == 0)
+    {
+        MOD_STATE_DEBUG("Port %d:%d Reading module EEPROM failed\n",
+                         sw,
+                         portCfg->port);
+    }
+
+}   /* end XcvrCompleteEepromRead */
+
+
+
+
+/*****************************************************************************/
+/* XcvrQueueEepromRead
+ * \ingroup intPlatform
+ *
+ * \desc            Queue a module EEPROM read to the I2C worker of the
+ *                  switch, or do it right away if there is no worker.
+ *                  Called with the switch lock taken. The worker is only
+ *                  started by ''XcvrKickI2cWorker'', so that the reads of
+ *                  one pass are handled as a batch.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \param[in]       portIdx is the index to the port and transceiver
+ *                  info structure.
+ *
+ * \param[in]       retry indicates whether it is a retry read or not.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrQueueEepromRead(fm_int sw, fm_int portIdx, fm_bool retry)
+{
+    fm_xcvrI2cQueue *  q;
+    fm_xcvrI2cRequest *req;
+    fm_xcvrI2cRequest  inlineReq;
+    fm_platXcvrInfo *  xcvrInfo;
+    fm_bool            full;
+
+    q        = i2cQueue[sw];
+    xcvrInfo = &GET_PLAT_STATE(sw)->xcvrInfo[portIdx];
+
+    if (xcvrInfo->eepromReadTag != 0)
+    {
+        /* Already queued */
+        return;
+    }
+
+    if (q == NULL)
+    {
+        inlineReq.portIdx = portIdx;
+        inlineReq.tag     = 1;
+        inlineReq.retry   = retry;
+        inlineReq.status  = 
+            fmPlatformXcvrEepromRead(sw,
+                                     FM_PLAT_GET_PORT_CFG(sw, portIdx)->port,
+                                     0,
+                                     0,
+                                     inlineReq.eeprom,
+                                     XCVR_EEPROM_CACHE_SIZE);
+
+        xcvrInfo->eepromReadTag = inlineReq.tag;
+        XcvrCompleteEepromRead(sw, &inlineReq);
+        return;
+    }
+
+    fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+
+    full = ( (q->tailIdx - q->doneIdx) >= XCVR_I2C_QUEUE_SIZE );
+
+    if (!full)
+    {
+        /* Tag 0 means no read is queued */
+        if (++q->lastTag == 0)
+        {
+            q->lastTag = 1;
+        }
+
+        req          = &q->requests[q->tailIdx % XCVR_I2C_QUEUE_SIZE];
+        req->portIdx = portIdx;
+        req->tag     = q->lastTag;
+        req->retry   = retry;
+        req->status  = FM_OK;
+
+        xcvrInfo->eepromReadTag = req->tag;
+        q->tailIdx++;
+    }
+
+    fmReleaseLock(&q->lock);
+
+    if (full)
+    {
+        /* Handle it as a failed read, to be retried by the polling task */
+        if (retry)
+        {
+            xcvrInfo->eepromReadRetries++;
+        }
+        else
+        {
+            xcvrInfo->eepromReadRetries = MAX_EEPROM_READ_RETRY;
+        }
+    }
+
+}   /* end XcvrQueueEepromRead */
+
+
+
+
+/*****************************************************************************/
+/* XcvrKickI2cWorker
+ * \ingroup intPlatform
+ *
+ * \desc            Start the I2C worker on the EEPROM reads queued so far.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrKickI2cWorker(fm_int sw)
+{
+    fm_xcvrI2cQueue *q;
+    fm_bool          pending;
+
+    q = i2cQueue[sw];
+
+    if (q == NULL)
+    {
+        return;
+    }
+
+    fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+    pending = (q->headIdx != q->tailIdx);
+    fmReleaseLock(&q->lock);
+
+    if (pending)
+    {
+        fmSignalSemaphore(&q->sem);
+    }
+
+}   /* end XcvrKickI2cWorker */
+
+
+
+
+/*****************************************************************************/
+/* XcvrProcessI2cCompletions
+ * \ingroup intPlatform
+ *
+ * \desc            Apply the EEPROM reads completed by the I2C worker.
+ *                  Called with the switch lock taken.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrProcessI2cCompletions(fm_int sw)
+{
+    fm_xcvrI2cQueue *  q;
+    fm_xcvrI2cRequest *req;
+
+    q = i2cQueue[sw];
+
+    if (q == NULL)
+    {
+        return;
+    }
+
+    while (1)
+    {
+        fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+        req = (q->doneIdx != q->headIdx) ?
+              &q->requests[q->doneIdx % XCVR_I2C_QUEUE_SIZE] : NULL;
+        fmReleaseLock(&q->lock);
+
+        if (req == NULL)
+        {
+            break;
+        }
+
+        /* The slot is not reused before doneIdx moves past it */
+        XcvrCompleteEepromRead(sw, req);
+
+        fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+        q->doneIdx++;
+        fmReleaseLock(&q->lock);
+    }
+
+}   /* end XcvrProcessI2cCompletions */
+
+
+
+
+/*****************************************************************************/
+/* XcvrI2cThread
+ * \ingroup intPlatform
+ *
+ * \desc            I2C worker of a switch. Performs the queued module EEPROM
+ *                  reads, without the mgmt thread holding the switch lock
+ *                  across the bus transfers, and hands the completed reads
+ *                  back to the mgmt thread.
+ *
+ * \param[in]       args contains thread-initialization parameters
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void *XcvrI2cThread(void *args)
+{
+    fm_thread *        thread;
+    fm_int             sw;
+    fm_xcvrI2cQueue *  q;
+    fm_xcvrI2cRequest *req;
+    fm_timestamp       start;
+    fm_timestamp       end;
+    fm_timestamp       diff;
+    fm_uint64          usec;
+    fm_int             numDone;
+
+    /* grab arguments */
+    thread = FM_GET_THREAD_HANDLE(args);
+    sw     = *(FM_GET_THREAD_PARAM(fm_int, args));
+    q      = i2cQueue[sw];
+
+    FM_LOG_ENTRY(FM_LOG_CAT_PLATFORM, "thread= %s, sw %d\n", thread->name, sw);
+
+    while (1)
+    {
+        fmWaitSemaphore(&q->sem, FM_WAIT_FOREVER);
+
+        numDone = 0;
+
+        while (1)
+        {
+            fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+            req = (q->headIdx != q->tailIdx) ?
+                  &q->requests[q->headIdx % XCVR_I2C_QUEUE_SIZE] : NULL;
+            fmReleaseLock(&q->lock);
+
+            if (req == NULL)
+            {
+                break;
+            }
+
+            /* Takes the I2C bus lock for the duration of the transfer */
+            fmGetTime(&start);
+            req->status = 
+                fmPlatformXcvrEepromRead(sw,
+                                         FM_PLAT_GET_PORT_CFG(sw, req->portIdx)->port,
+                                         0,
+                                         0,
+                                         req->eeprom,
+                                         XCVR_EEPROM_CACHE_SIZE);
+            fmGetTime(&end);
+
+            fmSubTimestamps(&end, &start, &diff);
+            usec = ( (fm_uint64) diff.sec * 1000000 ) + diff.usec;
+
+            fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+
+            q->numReads++;
+            q->busyUsec += usec;
+
+            if (usec > q->maxUsec)
+            {
+                q->maxUsec = usec;
+            }
+
+            if (req->status == FM_OK)
+            {
+                q->numBytes += XCVR_EEPROM_CACHE_SIZE;
+            }
+            else
+            {
+                q->numErrors++;
+            }
+
+            q->headIdx++;
+
+            fmReleaseLock(&q->lock);
+
+            numDone++;
+        }
+
+        if (numDone > 0)
+        {
+            fmSignalSemaphore(&mgmtSem[sw]);
+        }
+
+    }   /* end while (1) */
+
+    return NULL;
+
+}   /* end XcvrI2cThread */
+
+
+
+
+/*****************************************************************************/
+/* XcvrReadState
+ * \ingroup intPlatform
+ *
+ * \desc            Read the transceiver state from the bus, either for the
+ *                  ports with an interrupt pending or for all the ports.
+ *                  Does not require the switch lock.
+ *
+ * \param[in]       sw is the switch number.
+ * 
+ * \param[in]       interrupting indicates interrupts are pending.
+ *
+ * \param[out]      snapshot points to caller-allocated storage where the
+ *                  state read is placed.
+ *
+ * \return          FM_OK if successful, with snapshot->numPorts set to 0
+ *                  if there was no port to process.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status XcvrReadState(fm_int                sw,
+                               fm_bool               interrupting,
+                               fm_xcvrStateSnapshot *snapshot)
 {
     fm_status           status;
     fm_int              portIdx;
-    fm_int              lanePortIdx;
-    fm_int              hwResIdIdx;
-    fm_int              port;
-    fm_int              lane;
-    fm_int              epl;
     fm_int              swNum;
     fm_platformLib     *libFunc;
     fm_platformCfgPort *portCfg;
-    fm_platformCfgPort *pCfg;
-    fm_platXcvrInfo *   xcvrInfo;
-    fm_uint32           xcvrSignals;
-    fm_uint32           xcvrState;
-    fm_uint32           xcvrStateValid;
-    fm_uint32           oldState;
-    fm_bool             present;
-    fm_bool             notify;
     fm_int              numPorts;
     fm_uint32           hwResIdList[MAX_TEMP_PORTS];
-    fm_int              hwResIdIdxList[MAX_TEMP_PORTS];
-    fm_uint32           xcvrStateValidList[MAX_TEMP_PORTS];
-    fm_uint32           xcvrStateList[MAX_TEMP_PORTS];
     fm_int              numPortsIntr;
     fm_int              cnt;
 
     libFunc = FM_PLAT_GET_LIB_FUNCS_PTR(sw);
 
+    snapshot->numPorts = 0;
+
     if ( !libFunc->GetPortXcvrState )
     {
         /* No support */
-        return;
+        return FM_ERR_UNSUPPORTED;
     }
 
     swNum = FM_PLAT_GET_SWITCH_CFG(sw)->swNum;
-    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
 
     numPortsIntr = 0;
     numPorts     = 0;
@@ -806,7 +1260,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                             FM_LOG_PRINT(" %d", portCfg->port);
                         }
 
-                        hwResIdIdxList[cnt] = portIdx;
+                        snapshot->portIdxList[cnt] = portIdx;
                         numPorts++;
                     }
                 }
@@ -829,10 +1283,10 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                     FM_LOG_PRINT(" %d", hwResIdList[cnt]);
                 }
                 FM_LOG_PRINT("\n");
-                FM_LOG_PRINT("hwResIdIdxList: ");
+                FM_LOG_PRINT("snapshot->portIdxList: ");
                 for (cnt = 0 ; cnt < numPorts ; cnt++)
                 {
-                    FM_LOG_PRINT(" %d", hwResIdIdxList[cnt]);
+                    FM_LOG_PRINT(" %d", snapshot->portIdxList[cnt]);
                 }
                 FM_LOG_PRINT("\n");
             }
@@ -856,7 +1310,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
             }
 
             hwResIdList[numPorts]    = portCfg->hwResourceId;
-            hwResIdIdxList[numPorts] = portIdx;
+            snapshot->portIdxList[numPorts] = portIdx;
             numPorts++;
         }
     }
@@ -864,7 +1318,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     if (numPorts == 0)
     {
         MOD_STATE_DEBUG("Switch %d: No port to process\n", sw);
-        return;
+        return FM_OK;
     }
 
     /* Get transceiver state */
@@ -887,8 +1341,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
     status = libFunc->GetPortXcvrState(swNum,
                                        hwResIdList,
                                        numPorts,
-                                       xcvrStateValidList,
-                                       xcvrStateList);
+                                       snapshot->xcvrStateValidList,
+                                       snapshot->xcvrStateList);
 
     DROP_PLAT_I2C_BUS_LOCK(sw);
 
@@ -897,13 +1351,61 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
         MOD_STATE_DEBUG("Switch %d: Failed to read transceiver state. %s\n",
                         sw, 
                         fmErrorMsg(status) );
-        return;
+        return status;
     }
 
+    snapshot->numPorts = numPorts;
 
-    for (hwResIdIdx = 0 ; hwResIdIdx < numPorts ; hwResIdIdx++)
+    return FM_OK;
+
+}   /* end XcvrReadState */
+
+
+
+
+/*****************************************************************************/
+/* XcvrApplyState
+ * \ingroup intPlatform
+ *
+ * \desc            Update the cached transceiver state from a state read,
+ *                  and notify the API and application of the changes.
+ *                  Called with the switch lock taken.
+ *
+ * \param[in]       sw is the switch number.
+ * 
+ * \param[in]       force is update state even without state change.
+ *
+ * \param[in]       snapshot points to the transceiver state read.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrApplyState(fm_int                sw,
+                           fm_bool               force,
+                           fm_xcvrStateSnapshot *snapshot)
+{
+    fm_status           status = FM_OK;
+    fm_int              portIdx;
+    fm_int              lanePortIdx;
+    fm_int              hwResIdIdx;
+    fm_int              port;
+    fm_int              lane;
+    fm_int              epl;
+    fm_platformCfgPort *portCfg;
+    fm_platformCfgPort *pCfg;
+    fm_platXcvrInfo *   xcvrInfo;
+    fm_uint32           xcvrSignals;
+    fm_uint32           xcvrState;
+    fm_uint32           xcvrStateValid;
+    fm_uint32           oldState;
+    fm_bool             present;
+    fm_bool             notify;
+
+    xcvrInfo = GET_PLAT_STATE(sw)->xcvrInfo;
+
+    for (hwResIdIdx = 0 ; hwResIdIdx < snapshot->numPorts ; hwResIdIdx++)
     {
-        portIdx = hwResIdIdxList[hwResIdIdx];
+        portIdx = snapshot->portIdxList[hwResIdIdx];
 
         portCfg = FM_PLAT_GET_PORT_CFG(sw, portIdx);
 
@@ -918,8 +1420,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
         port = portCfg->port;
 
-        xcvrStateValid = xcvrStateValidList[hwResIdIdx];
-        xcvrState      = xcvrStateList[hwResIdIdx];
+        xcvrStateValid = snapshot->xcvrStateValidList[hwResIdIdx];
+        xcvrState      = snapshot->xcvrStateList[hwResIdIdx];
         oldState       = xcvrInfo[portIdx].modState;
         present        = (xcvrState & FM_PLAT_XCVR_PRESENT);
         notify         = FALSE;
@@ -945,6 +1447,7 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
                 xcvrInfo[portIdx].eepromBaseValid   = FALSE;
                 xcvrInfo[portIdx].eepromExtValid    = FALSE;
                 xcvrInfo[portIdx].eepromReadRetries = 0;
+                xcvrInfo[portIdx].eepromReadTag     = 0;
                 FM_MEMSET_S(xcvrInfo->eeprom, 
                             sizeof(xcvrInfo->eeprom),
                             0xFF, 
@@ -964,15 +1467,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
             if (notify && present && (xcvrState & FM_PLAT_XCVR_ENABLE))
             {
-                status = XcvrReadAndValidateEeprom(sw, portIdx, FALSE);
-                MOD_STATE_DEBUG("Port %d:%d module reading EEPROM: %s\n",
-                                sw,
-                                port, 
-                                fmErrorMsg(status));
-                if (status == FM_OK)
-                {
-                    NotifyXcvrDetection(sw, portIdx);
-                }
+                /* Detection is notified once the read completes */
+                XcvrQueueEepromRead(sw, portIdx, FALSE);
             }
 
             if ( (xcvrStateValid & FM_PLAT_XCVR_RXLOS) &&
@@ -1145,7 +1641,36 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
 
         }   /* end if (notify || force) */
 
-    }   /* end for (hwResIdIdx = 0 ; hwResIdIdx < numPorts ; hwResIdIdx++) */
+    }   /* end for (hwResIdIdx = 0 ; hwResIdIdx < snapshot->numPorts ; hwResIdIdx++) */
+
+}   /* end XcvrApplyState */
+
+
+
+/*****************************************************************************/
+/* XcvrUpdateState
+ * \ingroup intPlatform
+ *
+ * \desc            Update transceiver state, normally called when there is an
+ *                  interrupt notifying state change, or polling.
+ *
+ * \param[in]       sw is the switch number.
+ * 
+ * \param[in]       force is update state even without state change.
+ *
+ * \param[in]       interrupting indicates interrupts are pending.
+ *
+ * \return          None.
+ *
+ *****************************************************************************/
+static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
+{
+    fm_xcvrStateSnapshot snapshot;
+
+    if (XcvrReadState(sw, interrupting, &snapshot) == FM_OK)
+    {
+        XcvrApplyState(sw, force, &snapshot);
+    }
 
 }   /* end XcvrUpdateState */
 
@@ -1157,8 +1682,8 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
  * \ingroup intPlatformMgmt
  *
  * \desc            Check for SFP+ or QSFP module that need to retry reading
- *                  EEPROM and update SERDES settings when able to read
- *                  the module EEPROM content successfully.
+ *                  EEPROM and queue the reads. SERDES settings are updated
+ *                  when the module EEPROM content is read successfully.
  *
  * \param[in]       sw is the switch number.
  * 
@@ -1167,7 +1692,6 @@ static void XcvrUpdateState(fm_int sw, fm_bool force, fm_bool interrupting)
  *****************************************************************************/
 static void XcvrRetryEepromRead(fm_int sw)
 {
-    fm_status           status;
     fm_int              portIdx;
     fm_platformCfgPort *portCfg;
     fm_platformLib     *libFunc;
@@ -1192,24 +1716,12 @@ static void XcvrRetryEepromRead(fm_int sw)
             continue;
         }
 
-        if (xcvrInfo->eepromReadRetries > 0)
+        if (xcvrInfo->eepromReadRetries > 0 && xcvrInfo->eepromReadTag == 0)
         {
             xcvrInfo->eepromReadRetries--;
 
-            status = XcvrReadAndValidateEeprom(sw, portIdx, TRUE);
-            if (status != FM_OK)
-            {
-                if (xcvrInfo->eepromReadRetries == 0)
-                {
-                    MOD_STATE_DEBUG("Port %d:%d Reading module EEPROM failed\n",
-                                     sw,
-                                     portCfg->port);
-                }
-                continue;
-            }
-
-            xcvrInfo->eepromReadRetries = 0;
-            NotifyXcvrDetection(sw, portIdx);
+            /* Detection is notified once the read completes */
+            XcvrQueueEepromRead(sw, portIdx, TRUE);
         }
     }
 
@@ -1481,6 +1993,9 @@ static void *fmPlatformMgmtThread(void *args)
     fm_timestamp timeout;
     fm_uint      xcvrPollPeriodMsec;
     fm_bool      interrupt;
+    fm_bool      polling;
+    fm_bool      stateValid;
+    fm_xcvrStateSnapshot snapshot;
 
     /* grab arguments */
     thread = FM_GET_THREAD_HANDLE(args);
@@ -1529,7 +2044,12 @@ static void *fmPlatformMgmtThread(void *args)
         status = fmWaitSemaphore(&mgmtSem[sw], &timeout);
 
         /* Status != OK means the semaphore timeout, so do polling */
-        interrupt = (status == FM_OK) ? TRUE : FALSE;
+        polling = (status == FM_OK) ? FALSE : TRUE;
+
+        /* The semaphore is also signaled for I2C worker completions,
+         * which are not interrupts */
+        interrupt            = interruptPending[sw];
+        interruptPending[sw] = FALSE;
 
         /* Don't start before switch is brought up */
         if (!enableMgmt[sw])
@@ -1537,12 +2057,24 @@ static void *fmPlatformMgmtThread(void *args)
             continue;
         }
 
+        /* Read SFP+ and QSFP state, the switch lock is not needed
+         * for the bus transfers */
+        stateValid = FALSE;
+
+        if (interrupt || (pollXcvrStatus && polling))
+        {
+            stateValid = (XcvrReadState(sw, interrupt, &snapshot) == FM_OK);
+        }
+
         if (fmPlatformMgmtTakeSwitchLock(sw) != FM_OK)
         {
             continue;
         }
 
-        if (!interrupt || pollingPendingTask[sw])
+        /* Apply the module EEPROM reads done by the I2C worker */
+        XcvrProcessI2cCompletions(sw);
+
+        if (polling || pollingPendingTask[sw])
         {
             /* Do polling task here */
             pollingPendingTask[sw] = FALSE;
@@ -1554,14 +2086,16 @@ static void *fmPlatformMgmtThread(void *args)
             XcvrRetryConfig(sw);
         }
 
-        if (interrupt || pollXcvrStatus)
+        if (stateValid)
         {
-            /* Read SFP+ and QSFP state */
-            XcvrUpdateState( sw, FALSE, interrupt );
+            XcvrApplyState(sw, FALSE, &snapshot);
         }
 
         fmPlatformMgmtDropSwitchLock(sw);
 
+        /* Start the EEPROM reads queued by this pass */
+        XcvrKickI2cWorker(sw);
+
     }   /* end while (1) */
 
     return NULL;
@@ -1571,6 +2105,80 @@ static void *fmPlatformMgmtThread(void *args)
 
 
 
+/*****************************************************************************/
+/* XcvrI2cQueueInit
+ * \ingroup intPlatform
+ *
+ * \desc            Create the EEPROM read queue and I2C worker of a switch.
+ *                  Without them, EEPROM reads are done inline.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          Other ''Status Codes'' as appropriate in case of
+ *                  failure.
+ *
+ *****************************************************************************/
+static fm_status XcvrI2cQueueInit(fm_int sw)
+{
+    fm_xcvrI2cQueue *q;
+    fm_status        status;
+    fm_bool          lockInit;
+    fm_bool          semInit;
+
+    lockInit = FALSE;
+    semInit  = FALSE;
+
+    q = fmAlloc( sizeof(fm_xcvrI2cQueue) );
+
+    if (q == NULL)
+    {
+        return FM_ERR_NO_MEM;
+    }
+
+    FM_CLEAR(*q);
+
+    status = fmCreateLock("Xcvr I2C Queue", &q->lock);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    lockInit = TRUE;
+
+    status = fmCreateSemaphore("xcvrI2cSem", FM_SEM_BINARY, &q->sem, 0);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+    semInit = TRUE;
+
+    i2cQueue[sw] = q;
+
+    status = fmCreateThread("Xcvr I2C Thread",
+                            FM_EVENT_QUEUE_SIZE_NONE,
+                            &XcvrI2cThread,
+                            &(GET_PLAT_STATE(sw)->sw),
+                            &q->thread);
+    FM_LOG_ABORT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
+    return FM_OK;
+
+ABORT:
+    i2cQueue[sw] = NULL;
+
+    if (semInit)
+    {
+        fmDeleteSemaphore(&q->sem);
+    }
+
+    if (lockInit)
+    {
+        fmDeleteLock(&q->lock);
+    }
+
+    fmFree(q);
+
+    return status;
+
+}   /* end XcvrI2cQueueInit */
+
+
+
+
 /*****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -1665,6 +2273,9 @@ fm_status fmPlatformMgmtInit(fm_int sw)
     }
     else
     {
+        status = XcvrI2cQueueInit(sw);
+        FM_LOG_EXIT_ON_ERR(FM_LOG_CAT_PLATFORM, status);
+
         status = fmCreateThread("Mgmt Thread",
                                 FM_EVENT_QUEUE_SIZE_NONE,
                                 &fmPlatformMgmtThread,
@@ -1931,6 +2542,7 @@ void fmPlatformMgmtEnableInterrupt(fm_int sw)
 
     /* Update the start up state */
     XcvrUpdateState( sw, TRUE, FALSE );
+    XcvrKickI2cWorker(sw);
 
     enableMgmt[sw] = TRUE;
 
@@ -1960,6 +2572,7 @@ void fmPlatformMgmtSignalInterrupt(fm_int sw, fm_int gpio)
     /* Re-enable interrupt on that GPIO */
     fmPlatformGpioUnmaskIntr(sw, gpio, FM_PLAT_GPIO_INTR_FALLING);
 
+    interruptPending[sw] = TRUE;
     fmSignalSemaphore(&mgmtSem[sw]);
 
 }   /* end fmPlatformMgmtSignalInterrupt */
@@ -1981,6 +2594,7 @@ void fmPlatformMgmtSignalInterrupt(fm_int sw, fm_int gpio)
 void fmPlatformMgmtSignalPollingThread(fm_int sw)
 {
 
+    interruptPending[sw] = TRUE;
     fmSignalSemaphore(&mgmtSem[sw]);
     pollingPendingTask[sw] = TRUE;
 
@@ -2276,6 +2890,7 @@ fm_status fmPlatformMgmtDumpPort(fm_int sw, fm_int port)
     FM_LOG_PRINT("present        : %d\n", xcvrInfo->present);
     FM_LOG_PRINT("eepromBaseValid: %d\n", xcvrInfo->eepromBaseValid);
     FM_LOG_PRINT("eepromExtValid : %d\n", xcvrInfo->eepromExtValid);
+    FM_LOG_PRINT("eepromReadTag  : %u\n", xcvrInfo->eepromReadTag);
     FM_LOG_PRINT("Cached EEPROM  :\n");
     fmPlatformHexDump(0, xcvrInfo->eeprom, XCVR_EEPROM_CACHE_SIZE);
 
@@ -2286,6 +2901,69 @@ fm_status fmPlatformMgmtDumpPort(fm_int sw, fm_int port)
 
 
 
+/*****************************************************************************/
+/** fmPlatformMgmtDumpI2cStats
+ * \ingroup intPlatform
+ *
+ * \desc            Dump the latency and throughput of the module EEPROM
+ *                  reads done by the I2C worker of a switch.
+ *
+ * \param[in]       sw is the switch number.
+ *
+ * \return          FM_OK if successful.
+ * \return          FM_ERR_UNSUPPORTED if the switch has no I2C worker.
+ *
+ *****************************************************************************/
+fm_status fmPlatformMgmtDumpI2cStats(fm_int sw)
+{
+    fm_xcvrI2cQueue *q;
+    fm_uint64        numReads;
+    fm_uint64        numErrors;
+    fm_uint64        numBytes;
+    fm_uint64        busyUsec;
+    fm_uint64        maxUsec;
+    fm_uint          numPending;
+
+    if (sw < 0 || sw >= FM_MAX_NUM_SWITCHES)
+    {
+        return FM_ERR_INVALID_SWITCH;
+    }
+
+    q = i2cQueue[sw];
+
+    if (q == NULL)
+    {
+        FM_LOG_PRINT("Switch %d: No transceiver I2C worker\n", sw);
+        return FM_ERR_UNSUPPORTED;
+    }
+
+    fmCaptureLock(&q->lock, FM_WAIT_FOREVER);
+    numReads   = q->numReads;
+    numErrors  = q->numErrors;
+    numBytes   = q->numBytes;
+    busyUsec   = q->busyUsec;
+    maxUsec    = q->maxUsec;
+    numPending = q->tailIdx - q->headIdx;
+    fmReleaseLock(&q->lock);
+
+    FM_LOG_PRINT("Switch %d: Transceiver I2C bus\n", sw);
+    FM_LOG_PRINT("EEPROM reads   : %" FM_FORMAT_64 "u\n", numReads);
+    FM_LOG_PRINT("Failed reads   : %" FM_FORMAT_64 "u\n", numErrors);
+    FM_LOG_PRINT("Pending reads  : %u\n", numPending);
+    FM_LOG_PRINT("Bytes read     : %" FM_FORMAT_64 "u\n", numBytes);
+    FM_LOG_PRINT("Avg latency    : %" FM_FORMAT_64 "u usec\n",
+                 numReads ? (busyUsec / numReads) : 0);
+    FM_LOG_PRINT("Max latency    : %" FM_FORMAT_64 "u usec\n", maxUsec);
+    FM_LOG_PRINT("Throughput     : %" FM_FORMAT_64 "u bytes/sec\n",
+                 busyUsec ? ( (numBytes * 1000000) / busyUsec ) : 0);
+
+    return FM_OK;
+
+}   /* end fmPlatformMgmtDumpI2cStats */
+
+
+
+
 /*****************************************************************************/
 /** fmPlatformMgmtEnableXcvr
  * \ingroup intPlatform
@@ -698,6 +698,18 @@ static fm_utilPropMap apiProp[] = {
         PROP_BOOL, FM_TLV_API_SBMASTER_VALIDATE, 1, NULL, 0, 0},
     {"api.serdes.actionUpState",
         PROP_BOOL, FM_TVL_API_SERDES_ACTION_UP_ALLOWED, 1, NULL, 0, 0},
+    {"api.platform.rawSocket.rxBatchSize",
+        PROP_INT, FM_TLV_API_RAW_SOCKET_RX_BATCH, 2, NULL, 0, 0},
+    {"api.platform.rawSocket.txBatchSize",
+        PROP_INT, FM_TLV_API_RAW_SOCKET_TX_BATCH, 2, NULL, 0, 0},
+    {"api.platform.rawSocket.mmapRing",
+        PROP_BOOL, FM_TLV_API_RAW_SOCKET_MMAP_RING, 1, NULL, 0, 0},
+    {"api.platform.rawSocket.ringBlocks",
+        PROP_INT, FM_TLV_API_RAW_SOCKET_RING_BLOCKS, 2, NULL, 0, 0},
+    {"api.platform.pktTxClassMaxDepth",
+        PROP_INT, FM_TLV_API_PKT_TX_CLASS_DEPTH, 2, NULL, 0, 0},
+    {"api.statsCollector.period",
+        PROP_INT, FM_TLV_API_STATS_COLLECTOR_PER, 4, NULL, 0, 0},
 
 };
 
@@ -831,6 +843,8 @@ static fm_utilPropMap fm10kProp[] = {
         NULL, 0, 0},
     {"allowKrPcalOnEee", PROP_BOOL, FM_TLV_FM10K_ALLOW_KRPCAL_ON_EEE, 1,
         NULL, 0, 0},
+    {"warmRestartImage", PROP_TEXT, FM_TLV_FM10K_WARM_RESTART_IMAGE, 0,
+        NULL, 0, 0},
 };
 
 